@@ -0,0 +1,345 @@
+#include "backtest_engine.hpp"
+#include "../strategies/base_strategy/abstract_strategy.hpp"
+#include "../trader/i_order_gateway.hpp"
+#include "../utils/logging/log_helper.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+namespace backtest {
+
+namespace {
+
+// Min-heap order for std::push_heap / std::pop_heap
+template <typename Scheduled>
+bool later(const Scheduled& a, const Scheduled& b) {
+    return a.time_us != b.time_us ? a.time_us > b.time_us : a.sequence > b.sequence;
+}
+
+} // namespace
+
+/**
+ * MiniOMS's order gateway in a backtest: builds the same OrderBatchRequest
+ * ZmqOMSAdapter publishes and schedules it for the simulated exchange
+ */
+class BacktestEngine::Gateway : public IOrderGateway {
+public:
+    explicit Gateway(BacktestEngine& engine) : engine_(engine) {}
+
+    bool send_order(const std::string& cl_ord_id, const std::string& exch, const std::string& symbol,
+                    uint32_t side, uint32_t is_market, double qty, double price) override {
+        proto::OrderRequest& order = add(proto::NEW_ORDER, cl_ord_id, exch, symbol);
+        order.set_side(side == 0 ? proto::BUY : proto::SELL);
+        order.set_type(is_market ? proto::MARKET : proto::LIMIT);
+        order.set_qty(qty);
+        order.set_price(price);
+        return submit();
+    }
+
+    bool cancel_order(const std::string& cl_ord_id, const std::string& exch, const std::string& symbol) override {
+        add(proto::CANCEL_ORDER, cl_ord_id, exch, symbol);
+        return submit();
+    }
+
+    bool modify_order(const std::string& cl_ord_id, const std::string& exch, uint32_t side, double new_price,
+                      double new_qty, const std::string& symbol) override {
+        proto::OrderRequest& order = add(proto::REPLACE_ORDER, cl_ord_id, exch, symbol);
+        order.set_side(side == 0 ? proto::BUY : proto::SELL);
+        order.set_type(proto::LIMIT);
+        order.set_qty(new_qty);
+        order.set_price(new_price);
+        return submit();
+    }
+
+    void begin_batch() override { ++engine_.batch_depth_; }
+
+    bool flush_batch() override {
+        if (engine_.batch_depth_ > 0 && --engine_.batch_depth_ == 0) {
+            engine_.send_batch();
+        }
+        return true;
+    }
+
+private:
+    proto::OrderRequest& add(proto::OrderActionType type, const std::string& cl_ord_id, const std::string& exch,
+                             const std::string& symbol) {
+        proto::OrderAction* action = engine_.open_batch().add_actions();
+        action->set_action(type);
+        proto::OrderRequest* order = action->mutable_order();
+        order->set_cl_ord_id(cl_ord_id);
+        order->set_exch(exch);
+        order->set_symbol(symbol);
+        order->set_timestamp_us(engine_.now_us_);
+        return *order;
+    }
+
+    bool submit() {
+        if (engine_.batch_depth_ == 0) {
+            engine_.send_batch();
+        }
+        return true;
+    }
+
+    BacktestEngine& engine_;
+};
+
+BacktestEngine::BacktestEngine(const Config& config)
+    : config_(config),
+      exchange_(config.venue),
+      container_(std::make_unique<StrategyContainer>()),
+      gateway_(std::make_shared<Gateway>(*this)) {
+    queue_.reserve(4096);
+
+    // Before run() starts the clock (connect()) updates go straight in; after, they take event_latency_us
+    exchange_.set_order_status_callback([this](const proto::OrderEvent& event) {
+        uint32_t index = order_events_.acquire();
+        order_events_.items[index] = event;
+        schedule(config_.event_latency_us, Delivery::ORDER_EVENT, index);
+    });
+    exchange_.set_position_update_callback([this](const proto::PositionUpdate& position) {
+        if (!running_) {
+            container_->on_position_update(position);
+            return;
+        }
+        uint32_t index = positions_.acquire();
+        positions_.items[index] = position;
+        schedule(config_.event_latency_us, Delivery::POSITION, index);
+    });
+    exchange_.set_account_balance_update_callback([this](const proto::AccountBalanceUpdate& balance) {
+        if (!running_) {
+            container_->on_account_balance_update(balance);
+            return;
+        }
+        uint32_t index = balances_.acquire();
+        balances_.items[index] = balance;
+        schedule(config_.event_latency_us, Delivery::BALANCE, index);
+    });
+
+    container_->set_order_gateway(gateway_);
+    // The simulated venue starts without open orders
+    container_->mark_order_state_synced();
+}
+
+BacktestEngine::~BacktestEngine() = default;
+
+void BacktestEngine::set_strategy(std::shared_ptr<AbstractStrategy> strategy) {
+    strategy_ = strategy;
+    // Every callback runs on the caller's thread: the strategy's locks have nothing to guard
+    strategy_->set_single_threaded(true);
+    // Throttles and timers run on event time, so they fire the same way in every run
+    strategy_->set_clock([this]() { return now_us_; });
+    container_->set_strategy(strategy);
+    container_->set_symbol(config_.venue.symbol);
+    container_->set_exchange(config_.venue.exchange);
+}
+
+BacktestReport BacktestEngine::run(const RecordedFeed& feed) {
+    BacktestReport report;
+    if (!strategy_) {
+        LOG_ERROR_COMP("BACKTEST", "No strategy set");
+        return report;
+    }
+    if (used_) {
+        LOG_ERROR_COMP("BACKTEST", "An engine runs one backtest");
+        return report;
+    }
+
+    const std::vector<RecordedFeed::Event>& events = feed.events();
+    if (events.empty()) {
+        LOG_WARN_COMP("BACKTEST", "Empty recording");
+        return report;
+    }
+
+    used_ = true;
+    now_us_ = events.front().timestamp_us;
+    report.start_us = now_us_;
+    exchange_.set_time(now_us_);
+    exchange_.connect();
+    container_->start();
+    strategy_->start();
+    running_ = true;
+
+    // Deliveries still in flight after the last recorded event get this long to settle
+    const uint64_t settle_us = config_.order_latency_us + config_.event_latency_us + config_.market_data_latency_us;
+    const uint64_t last_us = events.back().timestamp_us;
+    double peak_equity = exchange_.equity();
+
+    const auto wall_start = std::chrono::steady_clock::now();
+    size_t next = 0;
+    while (next < events.size() || !queue_.empty()) {
+        const bool take_recorded = next < events.size() &&
+                                   (queue_.empty() || events[next].timestamp_us < queue_.front().time_us);
+        if (take_recorded) {
+            const RecordedFeed::Event& event = events[next++];
+            now_us_ = std::max(now_us_, event.timestamp_us);
+            exchange_.set_time(now_us_);
+            if (event.type == RecordedFeed::EventType::BOOK) {
+                exchange_.on_book(feed.book(event.index));
+                ++report.books;
+                mark_to_market(report, peak_equity);
+                schedule(config_.market_data_latency_us, Delivery::BOOK, event.index);
+            } else {
+                exchange_.on_trade(feed.trade(event.index));
+                ++report.trades;
+                schedule(config_.market_data_latency_us, Delivery::TRADE, event.index);
+            }
+            ++report.market_events;
+            continue;
+        }
+
+        if (next == events.size() && queue_.front().time_us > last_us + settle_us) {
+            break;
+        }
+        std::pop_heap(queue_.begin(), queue_.end(), later<Scheduled>);
+        const Scheduled scheduled = queue_.back();
+        queue_.pop_back();
+        now_us_ = std::max(now_us_, scheduled.time_us);
+        exchange_.set_time(now_us_);
+        deliver(scheduled, feed);
+        ++deliveries_;
+    }
+    const double wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+
+    running_ = false;
+    strategy_->stop();
+    container_->stop();
+
+    const SimulatedExchange::Statistics& statistics = exchange_.get_statistics();
+    const SimulatedExchange::Account& account = exchange_.get_account();
+    report.end_us = now_us_;
+    report.wall_seconds = wall_seconds;
+    report.events_per_second = wall_seconds > 0.0
+        ? static_cast<double>(report.market_events + deliveries_) / wall_seconds : 0.0;
+
+    report.orders_placed = statistics.orders_placed;
+    report.orders_filled = statistics.orders_filled;
+    report.orders_cancelled = statistics.orders_cancelled;
+    report.orders_rejected = statistics.orders_rejected;
+    report.replaces = statistics.replaces;
+    report.fill_rate = statistics.orders_placed
+        ? static_cast<double>(statistics.orders_filled) / static_cast<double>(statistics.orders_placed) : 0.0;
+    report.qty_fill_ratio = statistics.qty_placed > 0.0
+        ? (statistics.maker_qty + statistics.taker_qty) / statistics.qty_placed : 0.0;
+    report.maker_fills = statistics.maker_fills;
+    report.taker_fills = statistics.taker_fills;
+    report.maker_qty = statistics.maker_qty;
+    report.taker_qty = statistics.taker_qty;
+    report.notional = statistics.notional;
+
+    report.realized_pnl = account.realized_pnl;
+    report.unrealized_pnl = exchange_.unrealized_pnl();
+    report.fees = account.fees;
+    report.net_pnl = account.realized_pnl + report.unrealized_pnl - account.fees;
+
+    report.final_position = account.position;
+    report.max_abs_position = account.max_abs_position;
+    const uint64_t span_us = report.end_us - report.start_us;
+    report.mean_abs_position = span_us ? account.abs_position_time / static_cast<double>(span_us) : 0.0;
+    return report;
+}
+
+void BacktestEngine::schedule(uint64_t delay_us, Delivery kind, uint32_t index) {
+    queue_.push_back(Scheduled{now_us_ + delay_us, next_sequence_++, index, kind});
+    std::push_heap(queue_.begin(), queue_.end(), later<Scheduled>);
+}
+
+void BacktestEngine::deliver(const Scheduled& scheduled, const RecordedFeed& feed) {
+    switch (scheduled.kind) {
+        case Delivery::ORDER_BATCH:
+            exchange_.submit_batch(batches_.items[scheduled.index], batch_results_);
+            batches_.release(scheduled.index);
+            break;
+        case Delivery::ORDER_EVENT:
+            container_->on_order_event(order_events_.items[scheduled.index]);
+            order_events_.release(scheduled.index);
+            break;
+        case Delivery::POSITION:
+            container_->on_position_update(positions_.items[scheduled.index]);
+            positions_.release(scheduled.index);
+            break;
+        case Delivery::BALANCE:
+            container_->on_account_balance_update(balances_.items[scheduled.index]);
+            balances_.release(scheduled.index);
+            break;
+        case Delivery::BOOK:
+            md_binary::DefaultBookCodec::decode(feed.book(scheduled.index), config_.venue.exchange,
+                                                config_.venue.symbol, snapshot_);
+            container_->on_market_data(snapshot_);
+            break;
+        case Delivery::TRADE: {
+            const TradePrint& print = feed.trade(scheduled.index);
+            trade_.set_exch(config_.venue.exchange);
+            trade_.set_symbol(config_.venue.symbol);
+            trade_.set_timestamp_us(print.timestamp_us);
+            trade_.set_price(print.price);
+            trade_.set_qty(print.qty);
+            trade_.set_is_buyer_maker(print.is_buyer_maker);
+            container_->on_trade_execution(trade_);
+            break;
+        }
+    }
+}
+
+void BacktestEngine::mark_to_market(BacktestReport& report, double& peak_equity) {
+    const double equity = exchange_.equity();
+    peak_equity = std::max(peak_equity, equity);
+    report.max_drawdown = std::max(report.max_drawdown, peak_equity - equity);
+}
+
+proto::OrderBatchRequest& BacktestEngine::open_batch() {
+    if (open_batch_ == UINT32_MAX) {
+        open_batch_ = batches_.acquire();
+        batches_.items[open_batch_].Clear();
+    }
+    return batches_.items[open_batch_];
+}
+
+void BacktestEngine::send_batch() {
+    if (open_batch_ == UINT32_MAX) {
+        return;
+    }
+    const uint32_t index = open_batch_;
+    open_batch_ = UINT32_MAX;
+    if (batches_.items[index].actions_size() == 0) {
+        batches_.release(index);
+        return;
+    }
+    batches_.items[index].set_timestamp_us(now_us_);
+    schedule(config_.order_latency_us, Delivery::ORDER_BATCH, index);
+}
+
+std::string BacktestReport::format() const {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(4);
+    const double simulated_seconds = static_cast<double>(end_us - start_us) / 1e6;
+    out << "Replay:    " << market_events << " market events (" << books << " books, " << trades << " trades) over "
+        << simulated_seconds << " s simulated in " << wall_seconds << " s ("
+        << std::setprecision(0) << events_per_second << " events/s)\n" << std::setprecision(4);
+    out << "Orders:    " << orders_placed << " placed, " << orders_filled << " filled (fill rate "
+        << fill_rate * 100.0 << "%, size " << qty_fill_ratio * 100.0 << "%), " << orders_cancelled << " cancelled, "
+        << orders_rejected << " rejected, " << replaces << " replaced\n";
+    out << "Fills:     maker " << maker_fills << " (" << maker_qty << "), taker " << taker_fills << " ("
+        << taker_qty << "), notional " << notional << "\n";
+    out << "PnL:       realized " << realized_pnl << ", unrealized " << unrealized_pnl << ", fees " << fees
+        << ", net " << net_pnl << ", max drawdown " << max_drawdown << "\n";
+    out << "Inventory: final " << final_position << ", max |pos| " << max_abs_position << ", mean |pos| "
+        << mean_abs_position << "\n";
+    return out.str();
+}
+
+std::string BacktestReport::csv_header() {
+    return "market_events,orders_placed,orders_filled,fill_rate,qty_fill_ratio,maker_qty,taker_qty,notional,"
+           "realized_pnl,unrealized_pnl,fees,net_pnl,max_drawdown,final_position,max_abs_position,mean_abs_position";
+}
+
+std::string BacktestReport::csv_row() const {
+    std::ostringstream out;
+    out << std::setprecision(10) << market_events << ',' << orders_placed << ',' << orders_filled << ','
+        << fill_rate << ',' << qty_fill_ratio << ',' << maker_qty << ',' << taker_qty << ',' << notional << ','
+        << realized_pnl << ',' << unrealized_pnl << ',' << fees << ',' << net_pnl << ',' << max_drawdown << ','
+        << final_position << ',' << max_abs_position << ',' << mean_abs_position;
+    return out.str();
+}
+
+} // namespace backtest
@@ -0,0 +1,181 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "recorded_feed.hpp"
+#include "simulated_exchange.hpp"
+#include "../trader/strategy_container.hpp"
+#include "../proto/order.pb.h"
+#include "../proto/market_data.pb.h"
+#include "../proto/position.pb.h"
+#include "../proto/acc_balance.pb.h"
+
+class AbstractStrategy;
+
+namespace backtest {
+
+// Outcome of one run
+struct BacktestReport {
+    // Replay
+    uint64_t market_events{0};
+    uint64_t books{0};
+    uint64_t trades{0};
+    uint64_t start_us{0};
+    uint64_t end_us{0};
+    double wall_seconds{0.0};
+    double events_per_second{0.0};     // Market events and scheduled deliveries, per wall second
+
+    // Orders
+    uint64_t orders_placed{0};
+    uint64_t orders_filled{0};
+    uint64_t orders_cancelled{0};
+    uint64_t orders_rejected{0};
+    uint64_t replaces{0};
+    double fill_rate{0.0};             // Share of placed orders that traded at least once
+    double qty_fill_ratio{0.0};        // Filled size over placed size
+    uint64_t maker_fills{0};
+    uint64_t taker_fills{0};
+    double maker_qty{0.0};
+    double taker_qty{0.0};
+    double notional{0.0};
+
+    // PnL, in collateral units; unrealized is marked at the last mid
+    double realized_pnl{0.0};
+    double unrealized_pnl{0.0};
+    double fees{0.0};
+    double net_pnl{0.0};
+    double max_drawdown{0.0};          // Largest peak-to-trough equity drop, marked at every book
+
+    // Inventory, in contracts
+    double final_position{0.0};
+    double max_abs_position{0.0};
+    double mean_abs_position{0.0};     // Time-weighted
+
+    std::string format() const;
+    // One line per run, for comparing parameter sets
+    static std::string csv_header();
+    std::string csv_row() const;
+};
+
+/**
+ * Event-driven backtest of a strategy against a SimulatedExchange
+ *
+ * Runs the real strategy inside a real StrategyContainer (MiniOMS, MiniPMS
+ * and all), with the ZMQ hops replaced by scheduled deliveries on a
+ * simulated clock:
+ *
+ *   recorded book/trade  -> exchange at its timestamp
+ *                        -> container after market_data_latency_us
+ *   strategy orders      -> exchange after order_latency_us (one batch per OrderBatchScope)
+ *   order events, positions, balances -> container after event_latency_us
+ *
+ * Deliveries due at the same microsecond keep the order they were
+ * scheduled in, and all of them run before a recorded event with a later
+ * timestamp. Everything happens on the calling thread, so a run is
+ * deterministic. Scheduled messages live in pools that are reused, so a
+ * run stops allocating once the pools have grown to its peak.
+ *
+ * The strategy sees simulated timestamps in its messages, and its clock
+ * (AbstractStrategy::set_clock) is the simulated clock, so throttles such
+ * as MarketMakingStrategy's quote_update_interval_ms run on event time.
+ *
+ * One engine runs one backtest; create another for the next parameter set.
+ */
+class BacktestEngine {
+public:
+    struct Config {
+        SimulatedExchange::Config venue;
+        uint64_t order_latency_us{500};
+        uint64_t event_latency_us{500};
+        uint64_t market_data_latency_us{200};
+    };
+
+    explicit BacktestEngine(const Config& config);
+    ~BacktestEngine();
+
+    BacktestEngine(const BacktestEngine&) = delete;
+    BacktestEngine& operator=(const BacktestEngine&) = delete;
+
+    // The strategy under test; it trades config.venue.symbol on config.venue.exchange
+    void set_strategy(std::shared_ptr<AbstractStrategy> strategy);
+
+    BacktestReport run(const RecordedFeed& feed);
+
+    SimulatedExchange& get_exchange() { return exchange_; }
+    StrategyContainer& get_container() { return *container_; }
+    uint64_t now_us() const { return now_us_; }
+
+private:
+    class Gateway;
+
+    enum class Delivery : uint8_t {
+        ORDER_BATCH,       // Trader -> exchange
+        ORDER_EVENT,       // Exchange -> trader
+        POSITION,
+        BALANCE,
+        BOOK,              // Recorded market data -> trader
+        TRADE
+    };
+
+    struct Scheduled {
+        uint64_t time_us;
+        uint64_t sequence;
+        uint32_t index;    // Pool slot, or recorded book/trade index
+        Delivery kind;
+    };
+
+    // Reusable message slots
+    template <typename Message>
+    struct Pool {
+        std::vector<Message> items;
+        std::vector<uint32_t> free;
+
+        uint32_t acquire() {
+            if (!free.empty()) {
+                uint32_t index = free.back();
+                free.pop_back();
+                return index;
+            }
+            items.emplace_back();
+            return static_cast<uint32_t>(items.size() - 1);
+        }
+        void release(uint32_t index) { free.push_back(index); }
+    };
+
+    void schedule(uint64_t delay_us, Delivery kind, uint32_t index);
+    void deliver(const Scheduled& scheduled, const RecordedFeed& feed);
+    void mark_to_market(BacktestReport& report, double& peak_equity);
+
+    // Gateway side: batches the strategy's calls and hands them to the exchange
+    proto::OrderBatchRequest& open_batch();
+    void send_batch();
+
+    Config config_;
+    SimulatedExchange exchange_;
+    std::unique_ptr<StrategyContainer> container_;
+    std::shared_ptr<Gateway> gateway_;
+    std::shared_ptr<AbstractStrategy> strategy_;
+
+    uint64_t now_us_{0};
+    uint64_t next_sequence_{0};
+    bool running_{false};
+    bool used_{false};
+    std::vector<Scheduled> queue_;     // Binary min-heap on (time_us, sequence)
+
+    Pool<proto::OrderBatchRequest> batches_;
+    Pool<proto::OrderEvent> order_events_;
+    Pool<proto::PositionUpdate> positions_;
+    Pool<proto::AccountBalanceUpdate> balances_;
+    std::vector<bool> batch_results_;
+    uint32_t open_batch_{UINT32_MAX};
+    int batch_depth_{0};
+
+    // Decoded market data handed to the container
+    proto::OrderBookSnapshot snapshot_;
+    proto::Trade trade_;
+    uint64_t deliveries_{0};
+};
+
+} // namespace backtest
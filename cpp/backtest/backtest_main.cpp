@@ -0,0 +1,84 @@
+#include <iostream>
+#include <memory>
+#include <string>
+#include "backtest_engine.hpp"
+#include "recorded_feed.hpp"
+#include "../strategies/mm_strategy/market_making_strategy.hpp"
+#include "../strategies/mm_strategy/market_making_strategy_config.hpp"
+#include "../utils/config/process_config_manager.hpp"
+#include "../utils/exchange/exchange_symbol_registry.hpp"
+#include "../utils/logging/logger.hpp"
+#include "../utils/logging/log_helper.hpp"
+
+// backtest <config.ini> [recording.csv]
+//
+// Replays a recording through MarketMakingStrategy ([market_making_strategy])
+// against a SimulatedExchange ([BACKTEST]) and prints the report
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <config.ini> [recording.csv]" << std::endl;
+        return 1;
+    }
+    const std::string config_file = argv[1];
+
+    config::ProcessConfigManager config_manager;
+    if (!config_manager.load_config(config_file)) {
+        std::cerr << "Failed to load configuration from " << config_file << std::endl;
+        return 1;
+    }
+
+    // Only warnings and errors: a replay logs at market-data rate
+    logging::initialize_logging(config_manager.get_string("BACKTEST", "LOG_FILE", ""), logging::LogLevel::WARN);
+
+    backtest::BacktestEngine::Config config;
+    config.venue.exchange = config_manager.get_string("BACKTEST", "EXCHANGE", config.venue.exchange);
+    config.venue.symbol = config_manager.get_string("BACKTEST", "SYMBOL", "BTCUSDT");
+    config.venue.tick_size = config_manager.get_double("BACKTEST", "TICK_SIZE", config.venue.tick_size);
+    config.venue.maker_fee_bps = config_manager.get_double("BACKTEST", "MAKER_FEE_BPS", config.venue.maker_fee_bps);
+    config.venue.taker_fee_bps = config_manager.get_double("BACKTEST", "TAKER_FEE_BPS", config.venue.taker_fee_bps);
+    config.venue.initial_collateral =
+        config_manager.get_double("BACKTEST", "INITIAL_COLLATERAL", config.venue.initial_collateral);
+    config.venue.collateral_asset =
+        config_manager.get_string("BACKTEST", "COLLATERAL_ASSET", config.venue.collateral_asset);
+    config.venue.max_orders = static_cast<size_t>(
+        config_manager.get_int("BACKTEST", "MAX_ORDERS", static_cast<int>(config.venue.max_orders)));
+    config.order_latency_us = static_cast<uint64_t>(
+        config_manager.get_int("BACKTEST", "ORDER_LATENCY_US", static_cast<int>(config.order_latency_us)));
+    config.event_latency_us = static_cast<uint64_t>(
+        config_manager.get_int("BACKTEST", "EVENT_LATENCY_US", static_cast<int>(config.event_latency_us)));
+    config.market_data_latency_us = static_cast<uint64_t>(
+        config_manager.get_int("BACKTEST", "MARKET_DATA_LATENCY_US", static_cast<int>(config.market_data_latency_us)));
+
+    // Tick/step rounding and contract conversion, as the live trader gets them
+    const std::string symbol_config = config_manager.get_string("BACKTEST", "SYMBOL_CONFIG", "");
+    if (!symbol_config.empty() && !ExchangeSymbolRegistry::get_instance().load_from_config(symbol_config)) {
+        std::cerr << "Failed to load symbol info from " << symbol_config << std::endl;
+        logging::cleanup_logging();
+        return 1;
+    }
+
+    const std::string recording = argc > 2 ? argv[2] : config_manager.get_string("BACKTEST", "RECORDING", "");
+    backtest::RecordedFeed feed;
+    if (recording.empty() || !feed.load_csv(recording)) {
+        std::cerr << "Failed to load recording '" << recording << "'" << std::endl;
+        logging::cleanup_logging();
+        return 1;
+    }
+    feed.sort_by_time();
+
+    MarketMakingStrategyConfig strategy_config;
+    strategy_config.load_from_config(config_manager, "market_making_strategy");
+    auto strategy = std::make_shared<MarketMakingStrategy>(config.venue.symbol, strategy_config);
+
+    backtest::BacktestEngine engine(config);
+    engine.set_strategy(strategy);
+    const backtest::BacktestReport report = engine.run(feed);
+
+    std::cout << report.format();
+    if (config_manager.get_bool("BACKTEST", "CSV", false)) {
+        std::cout << backtest::BacktestReport::csv_header() << "\n" << report.csv_row() << std::endl;
+    }
+
+    logging::cleanup_logging();
+    return 0;
+}
@@ -0,0 +1,141 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "glft_sweep.hpp"
+#include "recorded_feed.hpp"
+#include "../strategies/mm_strategy/market_making_strategy_config.hpp"
+#include "../utils/app_service/thread_placement.hpp"
+#include "../utils/app_service/work_stealing_pool.hpp"
+#include "../utils/config/process_config_manager.hpp"
+#include "../utils/logging/logger.hpp"
+
+namespace {
+
+// Axis from [GLFT_SWEEP] `key`, or the single fixed value when the key is absent
+bool load_axis(const config::ProcessConfigManager& config, const std::string& key, double fixed,
+               std::vector<double>& axis) {
+    const std::string text = config.get_string("GLFT_SWEEP", key, "");
+    if (text.empty()) {
+        axis = {fixed};
+        return true;
+    }
+    axis = backtest::GlftSweepGrid::parse_axis(text);
+    if (axis.empty()) {
+        std::cerr << "Malformed [GLFT_SWEEP] " << key << ": '" << text << "'" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+// glft_calibration <config.ini> [recording.csv]
+//
+// Prices GLFT quotes for every parameter combination in [GLFT_SWEEP] over the
+// books of a recording, on all cores, and writes one row per combination and
+// inventory level; the fixed parameters come from [market_making_strategy]
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <config.ini> [recording.csv]" << std::endl;
+        return 1;
+    }
+    const std::string config_file = argv[1];
+
+    config::ProcessConfigManager config_manager;
+    if (!config_manager.load_config(config_file)) {
+        std::cerr << "Failed to load configuration from " << config_file << std::endl;
+        return 1;
+    }
+    // Before logging starts, so its worker is placed too
+    app_service::ThreadPlacement::instance().configure(config_manager);
+    logging::initialize_logging(config_manager.get_string("GLFT_SWEEP", "LOG_FILE", ""), logging::LogLevel::WARN);
+
+    MarketMakingStrategyConfig strategy_config;
+    strategy_config.load_from_config(config_manager, "market_making_strategy");
+
+    backtest::GlftSweepConfig sweep;
+    sweep.base.glft.risk_aversion = strategy_config.glft.risk_aversion;
+    sweep.base.glft.target_inventory_ratio = strategy_config.glft.target_inventory_ratio;
+    sweep.base.glft.base_spread = strategy_config.glft.base_spread;
+    sweep.base.glft.execution_cost = strategy_config.glft.execution_cost;
+    sweep.base.glft.inventory_penalty = strategy_config.glft.inventory_penalty;
+    sweep.base.glft.terminal_inventory_penalty = strategy_config.glft.terminal_inventory_penalty;
+    sweep.base.glft.max_position_size = strategy_config.glft.max_position_size;
+    sweep.base.glft.inventory_constraint_active = strategy_config.glft.inventory_constraint_active;
+    sweep.base.micro_price_skew_alpha = strategy_config.micro_price_skew_alpha;
+    sweep.base.net_inventory_skew_gamma = strategy_config.net_inventory_skew_gamma;
+    sweep.collateral = config_manager.get_double("GLFT_SWEEP", "COLLATERAL", sweep.collateral);
+    sweep.block_size = static_cast<size_t>(
+        config_manager.get_int("GLFT_SWEEP", "BLOCK_SIZE", static_cast<int>(sweep.block_size)));
+
+    const GlftQuoteParams& base = sweep.base;
+    if (!load_axis(config_manager, "RISK_AVERSION", base.glft.risk_aversion, sweep.grid.risk_aversion) ||
+        !load_axis(config_manager, "INVENTORY_PENALTY", base.glft.inventory_penalty, sweep.grid.inventory_penalty) ||
+        !load_axis(config_manager, "TERMINAL_PENALTY", base.glft.terminal_inventory_penalty,
+                   sweep.grid.terminal_penalty) ||
+        !load_axis(config_manager, "BASE_SPREAD", base.glft.base_spread, sweep.grid.base_spread) ||
+        !load_axis(config_manager, "VOLATILITY", 0.5, sweep.grid.volatility) ||
+        !load_axis(config_manager, "INVENTORY_FRACTIONS", 0.0, sweep.inventory_fractions)) {
+        logging::cleanup_logging();
+        return 1;
+    }
+
+    const std::string recording = argc > 2 ? argv[2] : config_manager.get_string("GLFT_SWEEP", "RECORDING", "");
+    auto start = std::chrono::steady_clock::now();
+    backtest::RecordedFeed feed;
+    if (recording.empty() || !feed.load_csv(recording)) {
+        std::cerr << "Failed to load recording '" << recording << "'" << std::endl;
+        logging::cleanup_logging();
+        return 1;
+    }
+    feed.sort_by_time();
+    backtest::GlftMarketSamples samples;
+    samples.load(feed,
+                 static_cast<size_t>(config_manager.get_int("GLFT_SWEEP", "HORIZON_BOOKS", 10)),
+                 static_cast<size_t>(config_manager.get_int("GLFT_SWEEP", "STRIDE", 1)));
+    const double load_seconds = seconds_since(start);
+    if (samples.size() == 0) {
+        std::cerr << "No two-sided books in '" << recording << "'" << std::endl;
+        logging::cleanup_logging();
+        return 1;
+    }
+
+    app_service::WorkStealingPool::Config pool_config;
+    pool_config.threads = static_cast<size_t>(config_manager.get_int("GLFT_SWEEP", "THREADS", 0));
+    pool_config.thread_name = "glft_sweep";
+    app_service::WorkStealingPool pool(pool_config);
+
+    start = std::chrono::steady_clock::now();
+    const backtest::GlftSweepTable table = backtest::run_glft_sweep(sweep, samples, pool);
+    const double sweep_seconds = seconds_since(start);
+
+    const double quotes = static_cast<double>(table.rows()) * static_cast<double>(samples.size());
+    std::cout << std::fixed << std::setprecision(3)
+              << "Samples:      " << samples.size() << " books (" << load_seconds << " s to load)\n"
+              << "Grid:         " << sweep.grid.size() << " points x " << sweep.inventory_fractions.size()
+              << " inventory levels = " << table.rows() << " rows\n"
+              << "Sweep:        " << sweep_seconds << " s on " << pool.size() << " threads, "
+              << std::setprecision(0) << quotes / sweep_seconds << " quotes/s ("
+              << pool.get_statistics().steals.load() << " steals)\n";
+
+    const std::string output = config_manager.get_string("GLFT_SWEEP", "OUTPUT", "glft_sweep.bin");
+    const std::string csv_output = config_manager.get_string("GLFT_SWEEP", "CSV_OUTPUT", "");
+    bool written = table.write_columnar(output);
+    if (written) {
+        std::cout << "Results:      " << output << "\n";
+    }
+    if (!csv_output.empty() && table.write_csv(csv_output)) {
+        std::cout << "CSV:          " << csv_output << "\n";
+    } else if (!csv_output.empty()) {
+        written = false;
+    }
+
+    logging::cleanup_logging();
+    return written ? 0 : 1;
+}
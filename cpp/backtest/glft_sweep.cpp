@@ -0,0 +1,390 @@
+#include "glft_sweep.hpp"
+#include "../utils/app_service/work_stealing_pool.hpp"
+#include "../utils/logging/log_helper.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace backtest {
+
+namespace {
+
+constexpr char kMagic[8] = {'G', 'L', 'F', 'T', 'S', 'W', 'P', '1'};
+constexpr size_t kSignalLevels = 5;   // As MarketMakingStrategy
+
+const char* const kColumns[] = {
+    "risk_aversion", "inventory_penalty", "terminal_penalty", "base_spread", "volatility",
+    "inventory_fraction",
+    "quote_rate", "mean_spread_bps", "mean_bid_depth_bps", "mean_ask_depth_bps", "touch_rate",
+    "mean_abs_target", "bid_fill_rate", "ask_fill_rate", "fill_edge_bps"
+};
+constexpr size_t kColumnCount = sizeof(kColumns) / sizeof(kColumns[0]);
+
+// One worker's arrays for a GlftQuoteBatch block
+struct Scratch {
+    std::vector<double> collateral;
+    std::vector<double> position;
+    std::vector<double> target_offset;
+    std::vector<double> bid;
+    std::vector<double> ask;
+
+    explicit Scratch(size_t size)
+        : collateral(size), position(size), target_offset(size), bid(size), ask(size) {}
+};
+
+struct Totals {
+    double quotes{0.0};
+    double spread_bps{0.0};
+    double bid_depth_bps{0.0};
+    double ask_depth_bps{0.0};
+    double touches{0.0};
+    double abs_target{0.0};
+    double bid_fills{0.0};
+    double ask_fills{0.0};
+    double edge_bps{0.0};
+};
+
+// Adds one priced block to the totals of its grid point and inventory level
+void accumulate(const GlftMarketSamples& samples, size_t offset, const Scratch& scratch, size_t count,
+                double collateral, Totals& totals) {
+    const double* best_bid = samples.best_bid.data() + offset;
+    const double* best_ask = samples.best_ask.data() + offset;
+    const double* future_bid = samples.future_best_bid.data() + offset;
+    const double* future_ask = samples.future_best_ask.data() + offset;
+    Totals sum;
+    for (size_t i = 0; i < count; ++i) {
+        const double mid = (best_bid[i] + best_ask[i]) / 2.0;
+        const double bps = 10000.0 / mid;
+        const double bid = scratch.bid[i];
+        const double ask = scratch.ask[i];
+        const bool quoted = bid > 0.0;    // Invalid quotes come back as 0
+        const bool bid_fill = quoted & (future_ask[i] <= bid);
+        const bool ask_fill = quoted & (future_bid[i] >= ask);
+        const double future_mid = (future_bid[i] + future_ask[i]) / 2.0;
+
+        sum.quotes += quoted ? 1.0 : 0.0;
+        sum.spread_bps += quoted ? (ask - bid) * bps : 0.0;
+        sum.bid_depth_bps += quoted ? (best_bid[i] - bid) * bps : 0.0;
+        sum.ask_depth_bps += quoted ? (ask - best_ask[i]) * bps : 0.0;
+        sum.touches += (quoted & ((bid >= best_bid[i]) | (ask <= best_ask[i]))) ? 1.0 : 0.0;
+        sum.abs_target += std::abs(scratch.target_offset[i]) * mid / collateral;
+        sum.bid_fills += bid_fill ? 1.0 : 0.0;
+        sum.ask_fills += ask_fill ? 1.0 : 0.0;
+        sum.edge_bps += (bid_fill ? (future_mid - bid) * bps : 0.0) + (ask_fill ? (ask - future_mid) * bps : 0.0);
+    }
+    totals.quotes += sum.quotes;
+    totals.spread_bps += sum.spread_bps;
+    totals.bid_depth_bps += sum.bid_depth_bps;
+    totals.ask_depth_bps += sum.ask_depth_bps;
+    totals.touches += sum.touches;
+    totals.abs_target += sum.abs_target;
+    totals.bid_fills += sum.bid_fills;
+    totals.ask_fills += sum.ask_fills;
+    totals.edge_bps += sum.edge_bps;
+}
+
+double ratio(double numerator, double denominator) {
+    return denominator > 0.0 ? numerator / denominator : 0.0;
+}
+
+} // namespace
+
+void GlftMarketSamples::load(const RecordedFeed& feed, size_t horizon, size_t stride) {
+    clear();
+    stride = std::max<size_t>(1, stride);
+
+    std::vector<uint32_t> books;
+    books.reserve(feed.book_count());
+    for (const auto& event : feed.events()) {
+        if (event.type != RecordedFeed::EventType::BOOK) {
+            continue;
+        }
+        const md_binary::DefaultBookMessage& book = feed.book(event.index);
+        if (book.bid_count > 0 && book.ask_count > 0 && book.bids[0].price > 0.0 && book.asks[0].price > 0.0) {
+            books.push_back(event.index);
+        }
+    }
+    if (books.size() <= horizon) {
+        return;
+    }
+
+    const size_t count = (books.size() - horizon + stride - 1) / stride;
+    for (auto* column : {&best_bid, &best_ask, &micro_price_skew, &orderbook_imbalance,
+                         &future_best_bid, &future_best_ask}) {
+        column->reserve(count);
+    }
+    for (size_t n = 0; n + horizon < books.size(); n += stride) {
+        const md_binary::DefaultBookMessage& book = feed.book(books[n]);
+        const md_binary::DefaultBookMessage& future = feed.book(books[n + horizon]);
+        best_bid.push_back(book.bids[0].price);
+        best_ask.push_back(book.asks[0].price);
+        micro_price_skew.push_back(micro_price_skew_of(book));
+        orderbook_imbalance.push_back(imbalance_of(book));
+        future_best_bid.push_back(future.bids[0].price);
+        future_best_ask.push_back(future.asks[0].price);
+    }
+}
+
+void GlftMarketSamples::clear() {
+    for (auto* column : {&best_bid, &best_ask, &micro_price_skew, &orderbook_imbalance,
+                         &future_best_bid, &future_best_ask}) {
+        column->clear();
+    }
+}
+
+double GlftMarketSamples::micro_price_skew_of(const md_binary::DefaultBookMessage& book) {
+    if (book.bid_count == 0 || book.ask_count == 0 || book.bids[0].price <= 0.0 || book.asks[0].price <= 0.0) {
+        return 0.0;
+    }
+    auto weighted = [](const md_binary::BookLevel* levels, size_t count, double& price) {
+        double notional = 0.0;
+        double qty = 0.0;
+        for (size_t i = 0; i < std::min(count, kSignalLevels); ++i) {
+            if (levels[i].price > 0.0 && levels[i].qty > 0.0) {
+                notional += levels[i].price * levels[i].qty;
+                qty += levels[i].qty;
+            }
+        }
+        price = qty > 0.0 ? notional / qty : 0.0;
+        return qty > 0.0;
+    };
+    double bid_price;
+    double ask_price;
+    if (!weighted(book.bids, book.bid_count, bid_price) || !weighted(book.asks, book.ask_count, ask_price)) {
+        return 0.0;
+    }
+    const double mid = (book.bids[0].price + book.asks[0].price) / 2.0;
+    const double micro_price = (bid_price + ask_price) / 2.0;
+    return micro_price > 0.0 ? (micro_price - mid) / mid : 0.0;
+}
+
+double GlftMarketSamples::imbalance_of(const md_binary::DefaultBookMessage& book) {
+    double bid_qty = 0.0;
+    double ask_qty = 0.0;
+    for (size_t i = 0; i < std::min<size_t>(book.bid_count, kSignalLevels); ++i) {
+        bid_qty += book.bids[i].qty;
+    }
+    for (size_t i = 0; i < std::min<size_t>(book.ask_count, kSignalLevels); ++i) {
+        ask_qty += book.asks[i].qty;
+    }
+    return bid_qty + ask_qty > 0.0 ? (bid_qty - ask_qty) / (bid_qty + ask_qty) : 0.0;
+}
+
+size_t GlftSweepGrid::size() const {
+    return risk_aversion.size() * inventory_penalty.size() * terminal_penalty.size() *
+           base_spread.size() * volatility.size();
+}
+
+std::vector<double> GlftSweepGrid::parse_axis(const std::string& text) {
+    std::vector<double> values;
+    auto parse = [](const std::string& item, double& value) {
+        const char* begin = item.c_str();
+        char* end = nullptr;
+        value = std::strtod(begin, &end);
+        while (end && *end == ' ') ++end;
+        return end != begin && end && *end == '\0';
+    };
+
+    if (text.find(':') != std::string::npos) {
+        std::stringstream ss(text);
+        std::string start_text, stop_text, count_text, extra;
+        double start, stop, count;
+        if (!std::getline(ss, start_text, ':') || !std::getline(ss, stop_text, ':') ||
+            !std::getline(ss, count_text, ':') || std::getline(ss, extra, ':') ||
+            !parse(start_text, start) || !parse(stop_text, stop) || !parse(count_text, count) ||
+            count < 1.0 || count != std::floor(count)) {
+            return {};
+        }
+        const size_t points = static_cast<size_t>(count);
+        for (size_t i = 0; i < points; ++i) {
+            values.push_back(points == 1 ? start : start + (stop - start) * static_cast<double>(i) /
+                                                           static_cast<double>(points - 1));
+        }
+        return values;
+    }
+
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        double value;
+        if (!parse(item, value)) {
+            return {};
+        }
+        values.push_back(value);
+    }
+    return values;
+}
+
+int GlftSweepTable::column(const std::string& name) const {
+    for (size_t i = 0; i < names.size(); ++i) {
+        if (names[i] == name) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+bool GlftSweepTable::write_columnar(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        LOG_ERROR_COMP("BACKTEST", "Cannot write sweep results: " + path);
+        return false;
+    }
+    const uint32_t column_count = static_cast<uint32_t>(columns.size());
+    const uint64_t row_count = rows();
+    out.write(kMagic, sizeof(kMagic));
+    out.write(reinterpret_cast<const char*>(&column_count), sizeof(column_count));
+    out.write(reinterpret_cast<const char*>(&row_count), sizeof(row_count));
+    for (const auto& name : names) {
+        const uint16_t length = static_cast<uint16_t>(name.size());
+        out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+        out.write(name.data(), length);
+    }
+    for (const auto& values : columns) {
+        out.write(reinterpret_cast<const char*>(values.data()),
+                  static_cast<std::streamsize>(values.size() * sizeof(double)));
+    }
+    return static_cast<bool>(out);
+}
+
+bool GlftSweepTable::read_columnar(const std::string& path) {
+    names.clear();
+    columns.clear();
+    std::ifstream in(path, std::ios::binary);
+    char magic[sizeof(kMagic)];
+    uint32_t column_count = 0;
+    uint64_t row_count = 0;
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 ||
+        !in.read(reinterpret_cast<char*>(&column_count), sizeof(column_count)) ||
+        !in.read(reinterpret_cast<char*>(&row_count), sizeof(row_count))) {
+        LOG_ERROR_COMP("BACKTEST", "Not a sweep results file: " + path);
+        return false;
+    }
+    names.resize(column_count);
+    for (auto& name : names) {
+        uint16_t length = 0;
+        if (!in.read(reinterpret_cast<char*>(&length), sizeof(length))) {
+            return false;
+        }
+        name.resize(length);
+        if (!in.read(&name[0], length)) {
+            return false;
+        }
+    }
+    columns.assign(column_count, std::vector<double>(row_count));
+    for (auto& values : columns) {
+        if (!in.read(reinterpret_cast<char*>(values.data()),
+                     static_cast<std::streamsize>(row_count * sizeof(double)))) {
+            LOG_ERROR_COMP("BACKTEST", "Truncated sweep results file: " + path);
+            names.clear();
+            columns.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+bool GlftSweepTable::write_csv(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        LOG_ERROR_COMP("BACKTEST", "Cannot write sweep results: " + path);
+        return false;
+    }
+    for (size_t c = 0; c < names.size(); ++c) {
+        out << (c ? "," : "") << names[c];
+    }
+    out << "\n" << std::setprecision(10);
+    for (size_t r = 0; r < rows(); ++r) {
+        for (size_t c = 0; c < columns.size(); ++c) {
+            out << (c ? "," : "") << columns[c][r];
+        }
+        out << "\n";
+    }
+    return static_cast<bool>(out);
+}
+
+GlftSweepTable run_glft_sweep(const GlftSweepConfig& config, const GlftMarketSamples& samples,
+                              app_service::WorkStealingPool& pool) {
+    const GlftSweepGrid& grid = config.grid;
+    const size_t points = grid.size();
+    const size_t levels = config.inventory_fractions.size();
+    const size_t block = std::max<size_t>(1, config.block_size);
+
+    GlftSweepTable table;
+    table.names.assign(kColumns, kColumns + kColumnCount);
+    table.columns.assign(kColumnCount, std::vector<double>(points * levels));
+    if (points == 0 || levels == 0) {
+        return table;
+    }
+
+    std::vector<Scratch> scratch(pool.size(), Scratch(block));
+    const double collateral = config.collateral;
+    const size_t count = samples.size();
+
+    pool.parallel_for(points, 1, [&](size_t begin, size_t end, size_t worker) {
+        Scratch& arrays = scratch[worker];
+        std::fill(arrays.collateral.begin(), arrays.collateral.end(), collateral);
+
+        for (size_t point = begin; point < end; ++point) {
+            // Volatility varies fastest, risk aversion slowest
+            size_t index = point;
+            const double volatility = grid.volatility[index % grid.volatility.size()];
+            index /= grid.volatility.size();
+            GlftQuoteParams params = config.base;
+            params.glft.base_spread = grid.base_spread[index % grid.base_spread.size()];
+            index /= grid.base_spread.size();
+            params.glft.terminal_inventory_penalty = grid.terminal_penalty[index % grid.terminal_penalty.size()];
+            index /= grid.terminal_penalty.size();
+            params.glft.inventory_penalty = grid.inventory_penalty[index % grid.inventory_penalty.size()];
+            index /= grid.inventory_penalty.size();
+            params.glft.risk_aversion = grid.risk_aversion[index];
+
+            for (size_t level = 0; level < levels; ++level) {
+                const double fraction = config.inventory_fractions[level];
+                Totals totals;
+                for (size_t offset = 0; offset < count; offset += block) {
+                    const size_t n = std::min(block, count - offset);
+                    // Position value is `fraction` of collateral at each sample's mid
+                    for (size_t i = 0; i < n; ++i) {
+                        const double mid = (samples.best_bid[offset + i] + samples.best_ask[offset + i]) / 2.0;
+                        arrays.position[i] = fraction * collateral / mid;
+                    }
+                    GlftQuoteBatch::Inputs in{arrays.collateral.data(), arrays.position.data(),
+                                              samples.best_bid.data() + offset, samples.best_ask.data() + offset,
+                                              samples.micro_price_skew.data() + offset,
+                                              samples.orderbook_imbalance.data() + offset};
+                    GlftQuoteBatch::Outputs out{arrays.target_offset.data(), arrays.bid.data(), arrays.ask.data()};
+                    GlftQuoteBatch::evaluate(params, volatility, in, out, n);
+                    accumulate(samples, offset, arrays, n, collateral, totals);
+                }
+
+                const double quoted = totals.quotes;
+                const double fills = totals.bid_fills + totals.ask_fills;
+                const double row[kColumnCount] = {
+                    params.glft.risk_aversion, params.glft.inventory_penalty,
+                    params.glft.terminal_inventory_penalty, params.glft.base_spread, volatility,
+                    fraction,
+                    ratio(quoted, static_cast<double>(count)),
+                    ratio(totals.spread_bps, quoted),
+                    ratio(totals.bid_depth_bps, quoted),
+                    ratio(totals.ask_depth_bps, quoted),
+                    ratio(totals.touches, quoted),
+                    ratio(totals.abs_target, static_cast<double>(count)),
+                    ratio(totals.bid_fills, quoted),
+                    ratio(totals.ask_fills, quoted),
+                    ratio(totals.edge_bps, fills)
+                };
+                for (size_t c = 0; c < kColumnCount; ++c) {
+                    table.columns[c][point * levels + level] = row[c];
+                }
+            }
+        }
+    });
+    return table;
+}
+
+} // namespace backtest
@@ -0,0 +1,106 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "recorded_feed.hpp"
+#include "../strategies/mm_strategy/models/glft_quote.hpp"
+#include "../utils/mds/orderbook_binary.hpp"
+
+namespace app_service {
+class WorkStealingPool;
+}
+
+namespace backtest {
+
+/**
+ * Market states a GLFT parameter sweep prices quotes against, one array per field
+ *
+ * Built from recorded books the way MarketMakingStrategy sees them: mid,
+ * touch, micro price skew and imbalance over the top five levels. Each
+ * sample also keeps the touch `horizon` books later, which the sweep uses
+ * as a passive-fill and markout proxy. Books without both sides are skipped.
+ */
+struct GlftMarketSamples {
+    std::vector<double> best_bid;
+    std::vector<double> best_ask;
+    std::vector<double> micro_price_skew;
+    std::vector<double> orderbook_imbalance;
+    std::vector<double> future_best_bid;
+    std::vector<double> future_best_ask;
+
+    // Every `stride`-th book of the feed; the last `horizon` books have no future and are dropped
+    void load(const RecordedFeed& feed, size_t horizon, size_t stride = 1);
+    void clear();
+    size_t size() const { return best_bid.size(); }
+
+    // (micro price - mid) / mid and (bid qty - ask qty) / (bid qty + ask qty), as the strategy computes them
+    static double micro_price_skew_of(const md_binary::DefaultBookMessage& book);
+    static double imbalance_of(const md_binary::DefaultBookMessage& book);
+};
+
+// Values each swept parameter takes; the grid is their cartesian product
+struct GlftSweepGrid {
+    std::vector<double> risk_aversion;
+    std::vector<double> inventory_penalty;
+    std::vector<double> terminal_penalty;
+    std::vector<double> base_spread;
+    std::vector<double> volatility;
+
+    size_t size() const;
+
+    // "start:stop:count" (inclusive, evenly spaced) or "a,b,c"; empty on a malformed axis
+    static std::vector<double> parse_axis(const std::string& text);
+};
+
+struct GlftSweepConfig {
+    GlftQuoteParams base;                  // Fixed parameters; the swept ones are overwritten per grid point
+    GlftSweepGrid grid;
+    std::vector<double> inventory_fractions{-0.5, -0.25, 0.0, 0.25, 0.5};   // Position value / collateral
+    double collateral{100000.0};
+    size_t block_size{1024};               // Samples priced per GlftQuoteBatch call
+};
+
+/**
+ * Named columns of doubles, stored column by column
+ *
+ * Binary layout (little endian, as written by the host):
+ *   "GLFTSWP1", uint32 column count, uint64 row count,
+ *   per column: uint16 name length and the name,
+ *   then each column's rows as contiguous doubles
+ */
+struct GlftSweepTable {
+    std::vector<std::string> names;
+    std::vector<std::vector<double>> columns;
+
+    size_t rows() const { return columns.empty() ? 0 : columns[0].size(); }
+    // Index of `name`, or -1
+    int column(const std::string& name) const;
+
+    bool write_columnar(const std::string& path) const;
+    bool read_columnar(const std::string& path);
+    bool write_csv(const std::string& path) const;
+};
+
+/**
+ * Prices every grid point at every inventory level over every sample
+ *
+ * One row per (grid point, inventory level), grid points in the order of
+ * the axes (risk aversion outermost, volatility innermost). Columns are the
+ * parameters, then:
+ *   quote_rate         share of samples with a valid quote
+ *   mean_spread_bps    quoted ask - bid, over quoted samples
+ *   mean_bid_depth_bps, mean_ask_depth_bps   distance behind the touch (negative = inside)
+ *   touch_rate         share of quotes at or inside the touch on either side
+ *   mean_abs_target    |GLFT target offset| as a fraction of collateral
+ *   bid_fill_rate, ask_fill_rate   share of quotes the opposite touch reached `horizon` books later
+ *   fill_edge_bps      mean edge of those fills against the mid `horizon` books later
+ *
+ * Grid points are work-stealing tasks; each one is priced block by block
+ * with GlftQuoteBatch on its worker's scratch arrays, so the sweep does
+ * not allocate per point and its results do not depend on the thread count.
+ */
+GlftSweepTable run_glft_sweep(const GlftSweepConfig& config, const GlftMarketSamples& samples,
+                              app_service::WorkStealingPool& pool);
+
+} // namespace backtest
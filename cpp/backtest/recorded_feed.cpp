@@ -0,0 +1,125 @@
+#include "recorded_feed.hpp"
+#include "../utils/logging/log_helper.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace backtest {
+
+void RecordedFeed::add_book(const proto::OrderBookSnapshot& snapshot) {
+    books_.emplace_back();
+    md_binary::DefaultBookCodec::encode(snapshot, 0, books_.size(), &books_.back(),
+                                        md_binary::DefaultBookCodec::kSize);
+    events_.push_back(Event{snapshot.timestamp_us(), static_cast<uint32_t>(books_.size() - 1), EventType::BOOK});
+}
+
+void RecordedFeed::add_book(uint64_t timestamp_us,
+                            const md_binary::BookLevel* bids, size_t bid_count,
+                            const md_binary::BookLevel* asks, size_t ask_count) {
+    books_.emplace_back();
+    md_binary::DefaultBookMessage& book = books_.back();
+    std::memset(&book, 0, sizeof(book));
+    book.magic = md_binary::kBookMagic;
+    book.version = md_binary::kBookVersion;
+    book.depth = static_cast<uint16_t>(md_binary::kDefaultBookDepth);
+    book.sequence = books_.size();
+    book.timestamp_us = timestamp_us;
+    book.bid_count = static_cast<uint16_t>(std::min(bid_count, md_binary::kDefaultBookDepth));
+    book.ask_count = static_cast<uint16_t>(std::min(ask_count, md_binary::kDefaultBookDepth));
+    std::copy(bids, bids + book.bid_count, book.bids);
+    std::copy(asks, asks + book.ask_count, book.asks);
+    events_.push_back(Event{timestamp_us, static_cast<uint32_t>(books_.size() - 1), EventType::BOOK});
+}
+
+void RecordedFeed::add_trade(const proto::Trade& trade) {
+    add_trade(TradePrint{trade.timestamp_us(), trade.price(), trade.qty(), trade.is_buyer_maker()});
+}
+
+void RecordedFeed::add_trade(const TradePrint& trade) {
+    trades_.push_back(trade);
+    events_.push_back(Event{trade.timestamp_us, static_cast<uint32_t>(trades_.size() - 1), EventType::TRADE});
+}
+
+bool RecordedFeed::load_csv(const std::string& path) {
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        LOG_ERROR_COMP("BACKTEST", "Cannot open recording: " + path);
+        return false;
+    }
+
+    std::string line;
+    std::vector<std::string> fields;
+    md_binary::BookLevel bids[md_binary::kDefaultBookDepth];
+    md_binary::BookLevel asks[md_binary::kDefaultBookDepth];
+    size_t line_number = 0;
+    while (std::getline(in, line)) {
+        ++line_number;
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        fields.clear();
+        std::stringstream ss(line);
+        std::string field;
+        while (std::getline(ss, field, ',')) {
+            fields.push_back(field);
+        }
+
+        bool ok = fields.size() >= 2;
+        if (ok && fields[1] == "B" && fields.size() >= 4) {
+            const uint64_t timestamp_us = std::strtoull(fields[0].c_str(), nullptr, 10);
+            const size_t bid_count = std::strtoul(fields[2].c_str(), nullptr, 10);
+            const size_t ask_count = std::strtoul(fields[3].c_str(), nullptr, 10);
+            ok = fields.size() == 4 + 2 * (bid_count + ask_count);
+            if (ok) {
+                size_t f = 4;
+                for (size_t i = 0; i < bid_count; ++i, f += 2) {
+                    if (i < md_binary::kDefaultBookDepth) {
+                        bids[i] = {std::strtod(fields[f].c_str(), nullptr), std::strtod(fields[f + 1].c_str(), nullptr)};
+                    }
+                }
+                for (size_t i = 0; i < ask_count; ++i, f += 2) {
+                    if (i < md_binary::kDefaultBookDepth) {
+                        asks[i] = {std::strtod(fields[f].c_str(), nullptr), std::strtod(fields[f + 1].c_str(), nullptr)};
+                    }
+                }
+                add_book(timestamp_us, bids, bid_count, asks, ask_count);
+            }
+        } else if (ok && fields[1] == "T" && fields.size() == 5) {
+            TradePrint trade;
+            trade.timestamp_us = std::strtoull(fields[0].c_str(), nullptr, 10);
+            trade.price = std::strtod(fields[2].c_str(), nullptr);
+            trade.qty = std::strtod(fields[3].c_str(), nullptr);
+            trade.is_buyer_maker = fields[4] == "S";
+            add_trade(trade);
+        } else {
+            ok = false;
+        }
+
+        if (!ok) {
+            LOG_ERROR_COMP("BACKTEST", path + ":" + std::to_string(line_number) + ": malformed event: " + line);
+            return false;
+        }
+    }
+    return true;
+}
+
+void RecordedFeed::sort_by_time() {
+    std::stable_sort(events_.begin(), events_.end(),
+                     [](const Event& a, const Event& b) { return a.timestamp_us < b.timestamp_us; });
+}
+
+void RecordedFeed::reserve(size_t books, size_t trades) {
+    books_.reserve(books);
+    trades_.reserve(trades);
+    events_.reserve(books + trades);
+}
+
+void RecordedFeed::clear() {
+    books_.clear();
+    trades_.clear();
+    events_.clear();
+}
+
+} // namespace backtest
@@ -0,0 +1,71 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../utils/mds/orderbook_binary.hpp"
+#include "../proto/market_data.pb.h"
+
+namespace backtest {
+
+// One recorded public trade
+struct TradePrint {
+    uint64_t timestamp_us{0};
+    double price{0.0};
+    double qty{0.0};
+    bool is_buyer_maker{false};   // true: a seller took the bid; false: a buyer lifted the ask
+};
+
+/**
+ * Recorded market data for one instrument, in time order
+ *
+ * Books are kept as fixed-layout md_binary::DefaultBookMessage structs
+ * (the same layout market_server publishes on the binary path) in one
+ * contiguous array, trades in another, and the event list indexes into
+ * them; replaying a feed touches no allocator.
+ *
+ * CSV format, one event per line ('#' starts a comment):
+ *   <timestamp_us>,B,<bid_count>,<ask_count>,<px>,<qty>,...   bids best first, then asks
+ *   <timestamp_us>,T,<price>,<qty>,<aggressor B|S>
+ */
+class RecordedFeed {
+public:
+    enum class EventType : uint8_t { BOOK, TRADE };
+
+    struct Event {
+        uint64_t timestamp_us;
+        uint32_t index;   // Into books() or trades()
+        EventType type;
+    };
+
+    void add_book(const proto::OrderBookSnapshot& snapshot);
+    void add_book(uint64_t timestamp_us,
+                  const md_binary::BookLevel* bids, size_t bid_count,
+                  const md_binary::BookLevel* asks, size_t ask_count);
+    void add_trade(const proto::Trade& trade);
+    void add_trade(const TradePrint& trade);
+
+    // Appends the events of a CSV recording; false (and logs the line) on a malformed line
+    bool load_csv(const std::string& path);
+
+    // Stable sort by timestamp; needed only if events were added out of order
+    void sort_by_time();
+
+    void reserve(size_t books, size_t trades);
+    void clear();
+
+    const std::vector<Event>& events() const { return events_; }
+    const md_binary::DefaultBookMessage& book(uint32_t index) const { return books_[index]; }
+    const TradePrint& trade(uint32_t index) const { return trades_[index]; }
+    size_t book_count() const { return books_.size(); }
+    size_t trade_count() const { return trades_.size(); }
+    size_t size() const { return events_.size(); }
+    bool empty() const { return events_.empty(); }
+
+private:
+    std::vector<md_binary::DefaultBookMessage> books_;
+    std::vector<TradePrint> trades_;
+    std::vector<Event> events_;
+};
+
+} // namespace backtest
@@ -0,0 +1,500 @@
+#include "simulated_exchange.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace backtest {
+
+namespace {
+
+constexpr double kQtyEpsilon = 1e-12;
+
+} // namespace
+
+SimulatedExchange::SimulatedExchange(const Config& config)
+    : config_(config), inv_tick_(config.tick_size > 0.0 ? 1.0 / config.tick_size : 1e8) {
+    const size_t max_orders = std::max<size_t>(config_.max_orders, 1);
+    orders_.resize(max_orders);
+    free_.reserve(max_orders);
+    active_.reserve(max_orders);
+    for (size_t i = max_orders; i > 0; --i) {
+        free_.push_back(static_cast<uint32_t>(i - 1));
+    }
+    balance_update_.add_balances();
+}
+
+void SimulatedExchange::set_time(uint64_t now_us) {
+    if (now_us > now_us_) {
+        account_.abs_position_time += std::abs(account_.position) * static_cast<double>(now_us - now_us_);
+        now_us_ = now_us;
+    }
+}
+
+void SimulatedExchange::on_book(const md_binary::DefaultBookMessage& book) {
+    bid_count_ = std::min<size_t>(book.bid_count, kDepth);
+    ask_count_ = std::min<size_t>(book.ask_count, kDepth);
+    for (size_t i = 0; i < bid_count_; ++i) {
+        bid_px_[i] = book.bids[i].price;
+        bid_ticks_[i] = to_ticks(book.bids[i].price);
+        bid_qty_[i] = book.bids[i].qty;
+    }
+    for (size_t i = 0; i < ask_count_; ++i) {
+        ask_px_[i] = book.asks[i].price;
+        ask_ticks_[i] = to_ticks(book.asks[i].price);
+        ask_qty_[i] = book.asks[i].qty;
+    }
+
+    size_t i = 0;
+    while (i < active_.size()) {
+        const uint32_t slot = active_[i];
+        Order& order = orders_[slot];
+
+        // The market trades at or through our price: we were in the way
+        const bool crossed = order.buy ? (ask_count_ > 0 && ask_ticks_[0] <= order.price_ticks)
+                                       : (bid_count_ > 0 && bid_ticks_[0] >= order.price_ticks);
+        if (crossed) {
+            fill(order, order.qty, order.price, true);
+            release(slot);
+            continue;
+        }
+
+        double visible = 0.0;
+        if (visible_qty(order.buy, order.price_ticks, visible)) {
+            if (visible < order.level_qty && order.level_qty > 0.0) {
+                order.market_ahead *= visible / order.level_qty;
+            }
+            order.market_ahead = std::min(order.market_ahead, visible);
+            order.level_qty = visible;
+        }
+        ++i;
+    }
+}
+
+void SimulatedExchange::on_trade(const TradePrint& trade) {
+    const int64_t trade_ticks = to_ticks(trade.price);
+    const bool bids_hit = trade.is_buyer_maker;
+    double left = trade.qty;
+    double consumed_market = 0.0;   // Recorded size this trade took from the front of the level
+
+    size_t i = 0;
+    while (i < active_.size()) {
+        const uint32_t slot = active_[i];
+        Order& order = orders_[slot];
+        if (order.buy != bids_hit) {
+            ++i;
+            continue;
+        }
+
+        const bool through = order.buy ? trade_ticks < order.price_ticks : trade_ticks > order.price_ticks;
+        if (through) {
+            fill(order, order.qty, order.price, true);
+            release(slot);
+            continue;
+        }
+        if (trade_ticks != order.price_ticks) {
+            ++i;
+            continue;
+        }
+
+        // Our orders at this price come in time priority: each sees what the
+        // trade left after the queue in front of it and our earlier orders
+        const double gap = std::max(0.0, order.market_ahead - consumed_market);
+        const double taken = std::min(left, gap);
+        left -= taken;
+        consumed_market += taken;
+        order.market_ahead = std::max(0.0, order.market_ahead - consumed_market);
+        order.level_qty = std::max(0.0, order.level_qty - trade.qty);
+
+        if (left > kQtyEpsilon) {
+            const double qty = std::min(left, order.qty);
+            left -= qty;
+            fill(order, qty, order.price, true);
+            if (order.qty <= kQtyEpsilon) {
+                release(slot);
+                continue;
+            }
+        }
+        ++i;
+    }
+}
+
+bool SimulatedExchange::connect() {
+    connected_ = true;
+    publish_account();
+    return true;
+}
+
+void SimulatedExchange::disconnect() {
+    connected_ = false;
+}
+
+void SimulatedExchange::set_auth_credentials(const std::string&, const std::string&) {
+    // Nothing to authenticate against
+}
+
+void SimulatedExchange::set_websocket_transport(std::shared_ptr<websocket_transport::IWebSocketTransport>) {
+    // No network: orders and updates stay in process
+}
+
+bool SimulatedExchange::cancel_order(const std::string& cl_ord_id, const std::string&, const std::string&) {
+    return cancel(cl_ord_id);
+}
+
+bool SimulatedExchange::replace_order(const std::string& cl_ord_id, const proto::OrderRequest& new_order) {
+    return replace(cl_ord_id, new_order.qty(), new_order.price());
+}
+
+proto::OrderEvent SimulatedExchange::get_order_status(const std::string& cl_ord_id, const std::string&) {
+    proto::OrderEvent status;
+    status.set_cl_ord_id(cl_ord_id);
+    status.set_exch(config_.exchange);
+    status.set_symbol(config_.symbol);
+    status.set_timestamp_us(now_us_);
+    const uint32_t slot = find(cl_ord_id);
+    if (slot == kNoOrder) {
+        status.set_event_type(proto::REJECT);
+        status.set_text("Unknown order");
+    } else {
+        status.set_event_type(proto::ACK);
+        status.set_exch_order_id(std::to_string(orders_[slot].exch_id));
+    }
+    return status;
+}
+
+bool SimulatedExchange::place_market_order(const std::string& symbol, const std::string& side, double quantity,
+                                           const std::string& cl_ord_id) {
+    if (!config_.symbol.empty() && symbol != config_.symbol) {
+        return false;
+    }
+    return place(cl_ord_id, side == "BUY", true, quantity, 0.0);
+}
+
+bool SimulatedExchange::place_limit_order(const std::string& symbol, const std::string& side, double quantity,
+                                          double price, const std::string& cl_ord_id) {
+    if (!config_.symbol.empty() && symbol != config_.symbol) {
+        return false;
+    }
+    return place(cl_ord_id, side == "BUY", false, quantity, price);
+}
+
+void SimulatedExchange::submit_batch(const proto::OrderBatchRequest& batch, std::vector<bool>& results) {
+    results.assign(static_cast<size_t>(batch.actions_size()), false);
+    for (int i = 0; i < batch.actions_size(); ++i) {
+        const proto::OrderAction& action = batch.actions(i);
+        const proto::OrderRequest& order = action.order();
+        if (!config_.symbol.empty() && !order.symbol().empty() && order.symbol() != config_.symbol) {
+            emit_reject(order.cl_ord_id(), "Unknown symbol");
+            continue;
+        }
+        switch (action.action()) {
+            case proto::NEW_ORDER:
+                results[i] = place(order.cl_ord_id(), order.side() == proto::BUY, order.type() == proto::MARKET,
+                                   order.qty(), order.price());
+                break;
+            case proto::CANCEL_ORDER:
+                results[i] = cancel(order.cl_ord_id());
+                break;
+            case proto::REPLACE_ORDER:
+                results[i] = replace(order.cl_ord_id(), order.qty(), order.price());
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+double SimulatedExchange::mid_price() const {
+    if (bid_count_ && ask_count_) {
+        return (bid_px_[0] + ask_px_[0]) / 2.0;
+    }
+    return bid_count_ ? bid_px_[0] : (ask_count_ ? ask_px_[0] : 0.0);
+}
+
+double SimulatedExchange::unrealized_pnl() const {
+    const double mark = mid_price();
+    if (account_.position == 0.0 || mark <= 0.0) {
+        return 0.0;
+    }
+    return account_.position * (mark - account_.avg_price);
+}
+
+double SimulatedExchange::equity() const {
+    return config_.initial_collateral + account_.realized_pnl + unrealized_pnl() - account_.fees;
+}
+
+bool SimulatedExchange::place(const std::string& cl_ord_id, bool buy, bool is_market, double qty, double price) {
+    if (qty <= 0.0 || (!is_market && price <= 0.0)) {
+        emit_reject(cl_ord_id, "Invalid quantity or price");
+        return false;
+    }
+    if (!cl_ord_id.empty() && find(cl_ord_id) != kNoOrder) {
+        emit_reject(cl_ord_id, "Duplicate cl_ord_id");
+        return false;
+    }
+    if (free_.empty()) {
+        emit_reject(cl_ord_id, "Too many open orders");
+        return false;
+    }
+
+    const uint32_t slot = free_.back();
+    free_.pop_back();
+    Order& order = orders_[slot];
+    if (cl_ord_id.empty()) {
+        order.cl_ord_id = "SIM-" + std::to_string(next_anonymous_id_++);
+    } else {
+        order.cl_ord_id.assign(cl_ord_id);
+    }
+    order.exch_id = next_exch_id_++;
+    order.buy = buy;
+    order.price = price;
+    order.price_ticks = to_ticks(price);
+    order.qty = qty;
+    order.filled_qty = 0.0;
+    order.market_ahead = 0.0;
+    order.level_qty = 0.0;
+    order.filled_once = false;
+
+    ++statistics_.orders_placed;
+    statistics_.qty_placed += qty;
+    emit_order_event(order, proto::ACK);
+
+    take_liquidity(order, is_market);
+    if (order.qty <= kQtyEpsilon) {
+        release(slot);
+    } else if (is_market) {
+        // Nothing left to take: the rest of a market order is not kept
+        ++statistics_.orders_cancelled;
+        emit_order_event(order, proto::CANCEL, 0.0, 0.0, "Market order remainder cancelled");
+        release(slot);
+    } else {
+        rest(slot);
+    }
+    return true;
+}
+
+bool SimulatedExchange::cancel(const std::string& cl_ord_id) {
+    const uint32_t slot = find(cl_ord_id);
+    if (slot == kNoOrder) {
+        emit_reject(cl_ord_id, "Unknown order");
+        return false;
+    }
+    ++statistics_.orders_cancelled;
+    emit_order_event(orders_[slot], proto::CANCEL);
+    release(slot);
+    return true;
+}
+
+bool SimulatedExchange::replace(const std::string& cl_ord_id, double qty, double price) {
+    const uint32_t slot = find(cl_ord_id);
+    if (slot == kNoOrder) {
+        emit_reject(cl_ord_id, "Unknown order");
+        return false;
+    }
+    Order& order = orders_[slot];
+    qty -= order.filled_qty;   // Total to open size
+    if (qty <= kQtyEpsilon) {
+        return cancel(cl_ord_id);
+    }
+
+    const int64_t price_ticks = price > 0.0 ? to_ticks(price) : order.price_ticks;
+    const bool keeps_priority = price_ticks == order.price_ticks && qty <= order.qty;
+    ++statistics_.replaces;
+    order.qty = qty;
+    emit_order_event(order, proto::ACK, 0.0, 0.0, "Replaced");
+    if (keeps_priority) {
+        return true;
+    }
+
+    // New price or more size: to the back of the queue, taking liquidity first if it now crosses
+    active_.erase(std::find(active_.begin(), active_.end(), slot));
+    if (price > 0.0) {
+        order.price = price;
+        order.price_ticks = price_ticks;
+    }
+    take_liquidity(order, false);
+    if (order.qty <= kQtyEpsilon) {
+        release(slot);
+    } else {
+        rest(slot);
+    }
+    return true;
+}
+
+void SimulatedExchange::take_liquidity(Order& order, bool is_market) {
+    const int64_t* ticks = order.buy ? ask_ticks_ : bid_ticks_;
+    const double* prices = order.buy ? ask_px_ : bid_px_;
+    double* sizes = order.buy ? ask_qty_ : bid_qty_;
+    const size_t count = order.buy ? ask_count_ : bid_count_;
+
+    for (size_t i = 0; i < count && order.qty > kQtyEpsilon; ++i) {
+        if (!is_market && (order.buy ? ticks[i] > order.price_ticks : ticks[i] < order.price_ticks)) {
+            break;
+        }
+        if (sizes[i] <= 0.0) {
+            continue;
+        }
+        const double qty = std::min(order.qty, sizes[i]);
+        sizes[i] -= qty;
+        fill(order, qty, prices[i], false);
+    }
+}
+
+void SimulatedExchange::rest(uint32_t slot) {
+    Order& order = orders_[slot];
+    double visible = 0.0;
+    if (!visible_qty(order.buy, order.price_ticks, visible)) {
+        // Beyond the recorded depth: assume a queue like the deepest level we can see
+        const size_t count = order.buy ? bid_count_ : ask_count_;
+        visible = count ? (order.buy ? bid_qty_ : ask_qty_)[count - 1] : 0.0;
+    }
+    order.market_ahead = visible;
+    order.level_qty = visible;
+    active_.push_back(slot);
+}
+
+void SimulatedExchange::fill(Order& order, double qty, double price, bool maker) {
+    order.qty -= qty;
+    order.filled_qty += qty;
+    if (order.qty < kQtyEpsilon) {
+        order.qty = 0.0;
+    }
+
+    const double notional = qty * price;
+    account_.fees += notional * (maker ? config_.maker_fee_bps : config_.taker_fee_bps) / 10000.0;
+    statistics_.notional += notional;
+    if (maker) {
+        ++statistics_.maker_fills;
+        statistics_.maker_qty += qty;
+    } else {
+        ++statistics_.taker_fills;
+        statistics_.taker_qty += qty;
+    }
+    if (!order.filled_once) {
+        order.filled_once = true;
+        ++statistics_.orders_filled;
+    }
+
+    update_position(order.buy, qty, price);
+    emit_order_event(order, proto::FILL, qty, price);
+    publish_account();
+}
+
+void SimulatedExchange::update_position(bool buy, double qty, double price) {
+    const double position = account_.position;
+    const double signed_qty = buy ? qty : -qty;
+    double new_position = position + signed_qty;
+
+    if (position == 0.0 || (position > 0.0) == buy) {
+        account_.avg_price = (account_.avg_price * std::abs(position) + price * qty) / std::abs(new_position);
+    } else {
+        const double closed = std::min(qty, std::abs(position));
+        account_.realized_pnl += closed * (price - account_.avg_price) * (position > 0.0 ? 1.0 : -1.0);
+        if (std::abs(new_position) <= kQtyEpsilon) {
+            new_position = 0.0;
+            account_.avg_price = 0.0;
+        } else if ((new_position > 0.0) != (position > 0.0)) {
+            account_.avg_price = price;   // Flipped: the rest opened at this price
+        }
+    }
+    account_.position = new_position;
+    account_.max_abs_position = std::max(account_.max_abs_position, std::abs(new_position));
+}
+
+bool SimulatedExchange::visible_qty(bool buy_side, int64_t price_ticks, double& qty) const {
+    const int64_t* ticks = buy_side ? bid_ticks_ : ask_ticks_;
+    const double* sizes = buy_side ? bid_qty_ : ask_qty_;
+    const size_t count = buy_side ? bid_count_ : ask_count_;
+
+    qty = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        if (ticks[i] == price_ticks) {
+            qty = sizes[i];
+            return true;
+        }
+        // Levels are best first: passing our price means there is no level at it
+        if (buy_side ? ticks[i] < price_ticks : ticks[i] > price_ticks) {
+            return true;
+        }
+    }
+    return count < kDepth;
+}
+
+uint32_t SimulatedExchange::find(const std::string& cl_ord_id) const {
+    for (uint32_t slot : active_) {
+        if (orders_[slot].cl_ord_id == cl_ord_id) {
+            return slot;
+        }
+    }
+    return kNoOrder;
+}
+
+void SimulatedExchange::release(uint32_t slot) {
+    auto it = std::find(active_.begin(), active_.end(), slot);
+    if (it != active_.end()) {
+        active_.erase(it);
+    }
+    orders_[slot].cl_ord_id.clear();   // Keeps its capacity for the next order in this slot
+    free_.push_back(slot);
+}
+
+void SimulatedExchange::emit_order_event(const Order& order, proto::OrderEventType type, double fill_qty,
+                                         double fill_price, const char* text) {
+    if (!order_status_callback_) {
+        return;
+    }
+    order_event_.set_cl_ord_id(order.cl_ord_id);
+    order_event_.set_exch(config_.exchange);
+    order_event_.set_symbol(config_.symbol);
+    order_event_.set_event_type(type);
+    order_event_.set_fill_qty(fill_qty);
+    order_event_.set_fill_price(fill_price);
+    order_event_.mutable_text()->assign(text);   // Reuses the string; set_text(const char*) builds a new one
+    order_event_.set_timestamp_us(now_us_);
+    order_event_.set_exch_order_id(std::to_string(order.exch_id));
+    order_status_callback_(order_event_);
+}
+
+void SimulatedExchange::emit_reject(const std::string& cl_ord_id, const char* text) {
+    ++statistics_.orders_rejected;
+    if (!order_status_callback_) {
+        return;
+    }
+    order_event_.set_cl_ord_id(cl_ord_id);
+    order_event_.set_exch(config_.exchange);
+    order_event_.set_symbol(config_.symbol);
+    order_event_.set_event_type(proto::REJECT);
+    order_event_.set_fill_qty(0.0);
+    order_event_.set_fill_price(0.0);
+    order_event_.mutable_text()->assign(text);
+    order_event_.set_timestamp_us(now_us_);
+    order_event_.clear_exch_order_id();
+    order_status_callback_(order_event_);
+}
+
+void SimulatedExchange::publish_account() {
+    if (position_callback_) {
+        position_update_.set_exch(config_.exchange);
+        position_update_.set_symbol(config_.symbol);
+        position_update_.set_qty(account_.position);
+        position_update_.set_avg_price(account_.avg_price);
+        position_update_.set_timestamp_us(now_us_);
+        position_callback_(position_update_);
+    }
+    if (balance_callback_) {
+        const double collateral = config_.initial_collateral + account_.realized_pnl - account_.fees;
+        proto::AccountBalance* balance = balance_update_.mutable_balances(0);
+        balance->set_exch(config_.exchange);
+        balance->set_instrument(config_.collateral_asset);
+        balance->set_balance(collateral);
+        balance->set_available(collateral);
+        balance->set_locked(0.0);
+        balance->set_timestamp_us(now_us_);
+        balance_update_.set_timestamp_us(now_us_);
+        balance_callback_(balance_update_);
+    }
+}
+
+int64_t SimulatedExchange::to_ticks(double price) const {
+    return std::llround(price * inv_tick_);
+}
+
+} // namespace backtest
@@ -0,0 +1,199 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../exchanges/i_exchange_oms.hpp"
+#include "../exchanges/i_exchange_pms.hpp"
+#include "../utils/mds/orderbook_binary.hpp"
+#include "recorded_feed.hpp"
+
+namespace backtest {
+
+/**
+ * Simulated venue for one instrument, matching against recorded market data
+ *
+ * Implements IExchangeOMS and IExchangePMS, so it stands where a trading
+ * engine's and a position server's exchange connections stand: orders
+ * arrive through submit_batch() (keeping the strategy's cl_ord_ids) and
+ * leave as ACK / FILL / CANCEL / REJECT order events, fills move the
+ * position and the collateral balance, which leave as position and balance
+ * updates. The backtest clock drives it through set_time(), on_book() and
+ * on_trade().
+ *
+ * Matching model (the recorded market does not see our orders):
+ *   - A limit order joins the back of its price level: the visible size
+ *     there is the queue ahead of it. Our own orders at one price keep
+ *     price-time priority among themselves.
+ *   - A level that shrinks between books loses size proportionally ahead of
+ *     and behind us; size that grows joins behind us.
+ *   - A trade at our price consumes the queue ahead first, then fills us;
+ *     a trade through our price, or a book crossing it, fills us entirely.
+ *     These are maker fills at our price.
+ *   - Market orders and limits that cross take the opposite side's visible
+ *     levels (taker fills), and the size they take is gone until the next
+ *     book. A market order's unfilled rest is cancelled.
+ *   - A replace carries the order's new total size (filled included) and
+ *     keeps priority only if it reduces the open size at the same price.
+ *
+ * The book is a fixed array of levels in price ticks and orders live in a
+ * preallocated pool, so books and trades are matched without allocating.
+ * Fees are in basis points of notional per side; negative is a rebate.
+ * Position is linear: one contract is one unit of the symbol's price.
+ */
+class SimulatedExchange : public IExchangeOMS, public IExchangePMS {
+public:
+    struct Config {
+        std::string exchange{"SIM"};
+        std::string symbol;
+        double tick_size{0.01};
+        double maker_fee_bps{0.0};
+        double taker_fee_bps{0.0};
+        double initial_collateral{10000.0};
+        std::string collateral_asset{"USDT"};
+        size_t max_orders{1024};             // Resting orders at once
+    };
+
+    struct Account {
+        double position{0.0};
+        double avg_price{0.0};
+        double realized_pnl{0.0};
+        double fees{0.0};                    // Paid; negative if rebates outweigh them
+        double max_abs_position{0.0};
+        double abs_position_time{0.0};       // Integral of |position| over time, in contract-microseconds
+    };
+
+    struct Statistics {
+        uint64_t orders_placed{0};           // NEW orders accepted
+        uint64_t orders_rejected{0};
+        uint64_t orders_filled{0};           // Accepted orders with at least one fill
+        uint64_t orders_cancelled{0};
+        uint64_t replaces{0};
+        uint64_t maker_fills{0};
+        uint64_t taker_fills{0};
+        double qty_placed{0.0};
+        double maker_qty{0.0};
+        double taker_qty{0.0};
+        double notional{0.0};
+    };
+
+    explicit SimulatedExchange(const Config& config);
+
+    // Backtest clock: timestamps events and accrues inventory time
+    void set_time(uint64_t now_us);
+    uint64_t get_time() const { return now_us_; }
+
+    // Recorded market data, in time order
+    void on_book(const md_binary::DefaultBookMessage& book);
+    void on_trade(const TradePrint& trade);
+
+    // IExchangeOMS / IExchangePMS: connect() publishes the opening position and balance
+    bool connect() override;
+    void disconnect() override;
+    bool is_connected() const override { return connected_; }
+    void set_auth_credentials(const std::string& api_key, const std::string& secret) override;
+    bool is_authenticated() const override { return connected_; }
+
+    bool cancel_order(const std::string& cl_ord_id, const std::string& exch_ord_id,
+                      const std::string& symbol = "") override;
+    bool replace_order(const std::string& cl_ord_id, const proto::OrderRequest& new_order) override;
+    proto::OrderEvent get_order_status(const std::string& cl_ord_id, const std::string& exch_ord_id) override;
+    bool place_market_order(const std::string& symbol, const std::string& side, double quantity,
+                            const std::string& cl_ord_id = "") override;
+    bool place_limit_order(const std::string& symbol, const std::string& side, double quantity, double price,
+                           const std::string& cl_ord_id = "") override;
+    void submit_batch(const proto::OrderBatchRequest& batch, std::vector<bool>& results) override;
+
+    void set_order_status_callback(OrderStatusCallback callback) override { order_status_callback_ = std::move(callback); }
+    void set_position_update_callback(PositionUpdateCallback callback) override { position_callback_ = std::move(callback); }
+    void set_account_balance_update_callback(AccountBalanceUpdateCallback callback) override {
+        balance_callback_ = std::move(callback);
+    }
+    void set_websocket_transport(std::shared_ptr<websocket_transport::IWebSocketTransport> transport) override;
+
+    // Inspection
+    const Config& get_config() const { return config_; }
+    const Account& get_account() const { return account_; }
+    const Statistics& get_statistics() const { return statistics_; }
+    size_t open_order_count() const { return active_.size(); }
+    double best_bid() const { return bid_count_ ? bid_px_[0] : 0.0; }
+    double best_ask() const { return ask_count_ ? ask_px_[0] : 0.0; }
+    double mid_price() const;
+    double unrealized_pnl() const;
+    // Collateral plus realized and unrealized PnL, less fees
+    double equity() const;
+
+private:
+    static constexpr size_t kDepth = md_binary::kDefaultBookDepth;
+    static constexpr uint32_t kNoOrder = UINT32_MAX;
+
+    struct Order {
+        std::string cl_ord_id;
+        uint64_t exch_id{0};
+        bool buy{false};
+        int64_t price_ticks{0};
+        double price{0.0};
+        double qty{0.0};                     // Open size
+        double filled_qty{0.0};              // A replace's qty is the new total, so open = total - filled
+        double market_ahead{0.0};            // Recorded size queued in front of us
+        double level_qty{0.0};               // Visible size at our price when last seen
+        bool filled_once{false};
+    };
+
+    bool place(const std::string& cl_ord_id, bool buy, bool is_market, double qty, double price);
+    bool cancel(const std::string& cl_ord_id);
+    bool replace(const std::string& cl_ord_id, double qty, double price);
+
+    // Takes the opposite side's levels up to the order's price (any price for market orders)
+    void take_liquidity(Order& order, bool is_market);
+    void rest(uint32_t slot);
+    void fill(Order& order, double qty, double price, bool maker);
+    void update_position(bool buy, double qty, double price);
+    // Visible size at a price on one side; false if the price lies beyond the recorded depth
+    bool visible_qty(bool buy_side, int64_t price_ticks, double& qty) const;
+
+    uint32_t find(const std::string& cl_ord_id) const;
+    void release(uint32_t slot);
+
+    void emit_order_event(const Order& order, proto::OrderEventType type, double fill_qty = 0.0,
+                          double fill_price = 0.0, const char* text = "");
+    void emit_reject(const std::string& cl_ord_id, const char* text);
+    void publish_account();
+
+    int64_t to_ticks(double price) const;
+
+    Config config_;
+    double inv_tick_;
+    bool connected_{false};
+    uint64_t now_us_{0};
+    uint64_t next_exch_id_{1};
+    uint64_t next_anonymous_id_{1};
+
+    // Recorded book, best first; sizes drop as our aggressive orders take them
+    double bid_px_[kDepth]{};
+    double ask_px_[kDepth]{};
+    int64_t bid_ticks_[kDepth]{};
+    int64_t ask_ticks_[kDepth]{};
+    double bid_qty_[kDepth]{};
+    double ask_qty_[kDepth]{};
+    size_t bid_count_{0};
+    size_t ask_count_{0};
+
+    std::vector<Order> orders_;              // Pool, sized once
+    std::vector<uint32_t> free_;
+    std::vector<uint32_t> active_;           // Resting orders in time priority
+
+    Account account_;
+    Statistics statistics_;
+
+    // Reused for every emitted message
+    proto::OrderEvent order_event_;
+    proto::PositionUpdate position_update_;
+    proto::AccountBalanceUpdate balance_update_;
+
+    OrderStatusCallback order_status_callback_;
+    PositionUpdateCallback position_callback_;
+    AccountBalanceUpdateCallback balance_callback_;
+};
+
+} // namespace backtest
@@ -0,0 +1,187 @@
+#include "../backtest/backtest_engine.hpp"
+#include "../backtest/recorded_feed.hpp"
+#include "../backtest/simulated_exchange.hpp"
+#include "../strategies/mm_strategy/market_making_strategy.hpp"
+#include "exchange/exchange_symbol_registry.hpp"
+#include "logging/logger.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+/**
+ * Backtest throughput: SimulatedExchange matching alone, then the whole
+ * BacktestEngine driving MarketMakingStrategy through StrategyContainer
+ *
+ * Replays a synthetic recording (20-level books on a random walk, one trade
+ * per book) and reports events per second and heap allocations per event.
+ * The matching run keeps ten orders resting around the touch, re-placing
+ * them as trades fill them.
+ *
+ * Usage: bench_backtest_sim [books]
+ */
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void __libc_free(void* ptr);
+}
+
+namespace {
+std::atomic<uint64_t> g_allocations{0};
+}
+
+extern "C" {
+void* malloc(size_t size) { g_allocations.fetch_add(1, std::memory_order_relaxed); return __libc_malloc(size); }
+void* calloc(size_t count, size_t size) { g_allocations.fetch_add(1, std::memory_order_relaxed); return __libc_calloc(count, size); }
+void* realloc(void* ptr, size_t size) { g_allocations.fetch_add(1, std::memory_order_relaxed); return __libc_realloc(ptr, size); }
+void free(void* ptr) { __libc_free(ptr); }
+}
+
+namespace {
+
+constexpr double kTick = 0.1;
+constexpr int kRestingPerSide = 5;
+
+void build_feed(backtest::RecordedFeed& feed, int books) {
+    feed.reserve(books, books);
+    md_binary::BookLevel bids[md_binary::kDefaultBookDepth];
+    md_binary::BookLevel asks[md_binary::kDefaultBookDepth];
+    uint64_t state = 88172645463325252ull;
+    double mid = 50000.0;
+    uint64_t t = 1000000;
+    for (int i = 0; i < books; ++i, t += 1000) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        mid += static_cast<double>(static_cast<int>(state % 3) - 1) * kTick;
+        for (size_t l = 0; l < md_binary::kDefaultBookDepth; ++l) {
+            const double qty = 1.0 + static_cast<double>((state >> (l * 2)) % 8);
+            bids[l] = {mid - kTick * static_cast<double>(l + 1), qty};
+            asks[l] = {mid + kTick * static_cast<double>(l + 1), qty};
+        }
+        feed.add_book(t, bids, md_binary::kDefaultBookDepth, asks, md_binary::kDefaultBookDepth);
+        const bool sell = (state >> 40) & 1;
+        feed.add_trade(backtest::TradePrint{t + 500, sell ? bids[0].price : asks[0].price,
+                                            1.0 + static_cast<double>((state >> 20) % 6), sell});
+    }
+}
+
+void print(const std::string& name, uint64_t events, double seconds, uint64_t allocations) {
+    std::cout << std::left << std::setw(30) << name << std::right
+              << std::setw(12) << events
+              << std::setw(14) << std::fixed << std::setprecision(0) << static_cast<double>(events) / seconds
+              << std::setw(10) << std::setprecision(1) << seconds * 1e9 / static_cast<double>(events)
+              << std::setw(12) << std::setprecision(4) << static_cast<double>(allocations) / static_cast<double>(events)
+              << "\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int books = argc > 1 ? std::atoi(argv[1]) : 500000;
+    logging::LogManager::get_instance().initialize("", logging::LogLevel::ERROR);
+
+    backtest::RecordedFeed feed;
+    build_feed(feed, books);
+
+    std::cout << books << " books, " << books << " trades\n\n";
+    std::cout << std::left << std::setw(30) << "run" << std::right
+              << std::setw(12) << "events" << std::setw(14) << "events/s"
+              << std::setw(10) << "ns/evt" << std::setw(12) << "allocs/evt" << "\n";
+
+    // Matching alone: ten resting orders, topped up with one NEW batch whenever fills took some
+    {
+        backtest::SimulatedExchange::Config config;
+        config.symbol = "BTCUSDT";
+        config.tick_size = kTick;
+        backtest::SimulatedExchange exchange(config);
+        uint64_t fills = 0;
+        exchange.set_order_status_callback([&fills](const proto::OrderEvent& event) {
+            fills += event.event_type() == proto::FILL;
+        });
+
+        proto::OrderBatchRequest top_up;
+        for (int i = 0; i < 2 * kRestingPerSide; ++i) {
+            proto::OrderRequest* order = top_up.add_actions()->mutable_order();
+            top_up.mutable_actions(i)->set_action(proto::NEW_ORDER);
+            order->set_cl_ord_id("bench-" + std::to_string(i));
+            order->set_symbol(config.symbol);
+            order->set_type(proto::LIMIT);
+            order->set_qty(1.0);
+        }
+        std::vector<bool> results;
+        results.reserve(top_up.actions_size());
+
+        auto replay = [&](size_t from, size_t to) {
+            for (size_t n = from; n < to; ++n) {
+                const backtest::RecordedFeed::Event& event = feed.events()[n];
+                exchange.set_time(event.timestamp_us);
+                if (event.type == backtest::RecordedFeed::EventType::BOOK) {
+                    exchange.on_book(feed.book(event.index));
+                    if (exchange.open_order_count() < 2 * kRestingPerSide) {
+                        for (int i = 0; i < 2 * kRestingPerSide; ++i) {
+                            proto::OrderRequest* order = top_up.mutable_actions(i)->mutable_order();
+                            const bool buy = i < kRestingPerSide;
+                            const int level = i % kRestingPerSide;
+                            order->set_side(buy ? proto::BUY : proto::SELL);
+                            order->set_price(buy ? exchange.best_bid() - kTick * level
+                                                 : exchange.best_ask() + kTick * level);
+                        }
+                        exchange.submit_batch(top_up, results);
+                    }
+                } else {
+                    exchange.on_trade(feed.trade(event.index));
+                }
+            }
+        };
+
+        const size_t warm_up = std::min<size_t>(feed.size(), 10000);
+        replay(0, warm_up);
+        const uint64_t allocations = g_allocations.load();
+        const auto start = std::chrono::steady_clock::now();
+        replay(warm_up, feed.size());
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        print("SimulatedExchange", feed.size() - warm_up, seconds, g_allocations.load() - allocations);
+        std::cout << "  (" << fills << " fills, " << exchange.get_statistics().orders_placed << " orders)\n";
+    }
+
+    // Whole engine with the real strategy; its allocations are mostly the strategy's own
+    {
+        // Linear contracts of one BTC, so the strategy can size quotes and convert inventory
+        const std::string symbol_config = "/tmp/bench_backtest_sim_symbols.ini";
+        {
+            std::ofstream out(symbol_config);
+            out << "[SIM:BTCUSDT]\ntick_size=" << kTick << "\nstep_size=0.001\nmin_order_size=0.001\n"
+                << "max_order_size=1000\ncontract_size=1\ncontract_size_denomination=BTC\n";
+        }
+        ExchangeSymbolRegistry::get_instance().load_from_config(symbol_config);
+        std::remove(symbol_config.c_str());
+
+        MarketMakingStrategyConfig strategy_config;
+        strategy_config.quote_update_interval_ms = 0;
+        auto strategy = std::make_shared<MarketMakingStrategy>("BTCUSDT", strategy_config);
+
+        backtest::BacktestEngine::Config config;
+        config.venue.symbol = "BTCUSDT";
+        config.venue.tick_size = kTick;
+        config.venue.initial_collateral = 100000.0;
+        backtest::BacktestEngine engine(config);
+        engine.set_strategy(strategy);
+
+        const uint64_t allocations = g_allocations.load();
+        const backtest::BacktestReport report = engine.run(feed);
+        print("BacktestEngine + MM strategy", report.market_events, report.wall_seconds,
+              g_allocations.load() - allocations);
+        std::cout << "  (" << std::setprecision(0) << report.events_per_second
+                  << " events/s counting scheduled deliveries)\n\n" << report.format();
+    }
+
+    logging::LogManager::get_instance().shutdown();
+    return 0;
+}
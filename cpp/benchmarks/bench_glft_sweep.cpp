@@ -0,0 +1,136 @@
+#include "../backtest/glft_sweep.hpp"
+#include "../backtest/recorded_feed.hpp"
+#include "../strategies/mm_strategy/models/glft_quote.hpp"
+#include "app_service/work_stealing_pool.hpp"
+#include "logging/logger.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * GLFT calibration throughput
+ *
+ * Quote pricing over synthetic books, first one state at a time through
+ * price_glft_quote() and then in GlftQuoteBatch blocks (the vectorised
+ * path), then whole sweeps on 1 thread and on every core.
+ *
+ * Usage: bench_glft_sweep [books] [threads]
+ */
+
+namespace {
+
+backtest::RecordedFeed build_feed(int books) {
+    backtest::RecordedFeed feed;
+    feed.reserve(books, 0);
+    md_binary::BookLevel bids[5];
+    md_binary::BookLevel asks[5];
+    uint64_t state = 88172645463325252ull;
+    double mid = 50000.0;
+    for (int i = 0; i < books; ++i) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        mid += static_cast<double>(static_cast<int>(state % 3) - 1) * 0.1;
+        for (int l = 0; l < 5; ++l) {
+            bids[l] = {mid - 0.1 * (l + 1), 1.0 + static_cast<double>((state >> (l * 3)) % 8)};
+            asks[l] = {mid + 0.1 * (l + 1), 1.0 + static_cast<double>((state >> (l * 3 + 20)) % 8)};
+        }
+        feed.add_book(1000 + static_cast<uint64_t>(i), bids, 5, asks, 5);
+    }
+    return feed;
+}
+
+void print(const std::string& name, double quotes, double seconds) {
+    std::cout << std::left << std::setw(28) << name << std::right
+              << std::setw(14) << std::fixed << std::setprecision(0) << quotes / seconds
+              << std::setw(10) << std::setprecision(2) << seconds * 1e9 / quotes << "\n";
+}
+
+template <typename Fn>
+double time_it(Fn&& fn) {
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int books = argc > 1 ? std::atoi(argv[1]) : 200000;
+    const size_t threads = argc > 2 ? static_cast<size_t>(std::atoi(argv[2])) : std::thread::hardware_concurrency();
+    logging::LogManager::get_instance().initialize("", logging::LogLevel::ERROR);
+
+    backtest::GlftMarketSamples samples;
+    samples.load(build_feed(books), 10);
+    const size_t n = samples.size();
+
+    std::cout << n << " samples\n\n" << std::left << std::setw(28) << "run" << std::right
+              << std::setw(14) << "quotes/s" << std::setw(10) << "ns/quote" << "\n";
+
+    // One parameter set, 20 passes over every sample
+    GlftQuoteParams params;
+    const double volatility = 0.5;
+    const int passes = 20;
+    std::vector<double> collateral(n, 100000.0), position(n), target(n), bid(n), ask(n);
+    for (size_t i = 0; i < n; ++i) {
+        position[i] = (static_cast<double>(i % 11) - 5.0) * 0.1;
+    }
+    double checksum = 0.0;
+
+    const double scalar = time_it([&] {
+        for (int pass = 0; pass < passes; ++pass) {
+            for (size_t i = 0; i < n; ++i) {
+                const double mid = (samples.best_bid[i] + samples.best_ask[i]) / 2.0;
+                const GlftQuote quote = price_glft_quote(params, collateral[i], position[i], position[i], position[i],
+                                                         mid, samples.best_bid[i], samples.best_ask[i],
+                                                         samples.micro_price_skew[i], samples.orderbook_imbalance[i],
+                                                         volatility);
+                bid[i] = quote.valid ? quote.bid : 0.0;
+            }
+            checksum += bid[n / 2];
+        }
+    });
+    print("price_glft_quote (scalar)", static_cast<double>(n) * passes, scalar);
+
+    const double batch = time_it([&] {
+        for (int pass = 0; pass < passes; ++pass) {
+            GlftQuoteBatch::evaluate(params, volatility,
+                                     {collateral.data(), position.data(), samples.best_bid.data(),
+                                      samples.best_ask.data(), samples.micro_price_skew.data(),
+                                      samples.orderbook_imbalance.data()},
+                                     {target.data(), bid.data(), ask.data()}, n);
+            checksum += bid[n / 2];
+        }
+    });
+    print("GlftQuoteBatch", static_cast<double>(n) * passes, batch);
+
+    // Whole sweeps: 4 x 4 x 3 x 3 x 3 grid at 5 inventory levels
+    backtest::GlftSweepConfig config;
+    config.grid.risk_aversion = backtest::GlftSweepGrid::parse_axis("0.01:1:4");
+    config.grid.inventory_penalty = backtest::GlftSweepGrid::parse_axis("0:0.1:4");
+    config.grid.terminal_penalty = backtest::GlftSweepGrid::parse_axis("0:0.2:3");
+    config.grid.base_spread = backtest::GlftSweepGrid::parse_axis("0.0001,0.0003,0.001");
+    config.grid.volatility = backtest::GlftSweepGrid::parse_axis("0.3,0.5,0.8");
+    const double sweep_quotes = static_cast<double>(config.grid.size() * config.inventory_fractions.size() * n);
+
+    for (size_t count : {size_t(1), threads}) {
+        app_service::WorkStealingPool::Config pool_config;
+        pool_config.threads = count;
+        app_service::WorkStealingPool pool(pool_config);
+        backtest::GlftSweepTable table;
+        const double seconds = time_it([&] { table = backtest::run_glft_sweep(config, samples, pool); });
+        checksum += table.columns[0].back();
+        print("sweep, " + std::to_string(pool.size()) + " thread(s)", sweep_quotes, seconds);
+        if (count == threads) {
+            std::cout << "  (" << table.rows() << " rows, " << pool.get_statistics().steals.load() << " steals)\n";
+        }
+    }
+
+    std::cout << "\nchecksum " << std::setprecision(6) << checksum << "\n";
+    logging::LogManager::get_instance().shutdown();
+    return 0;
+}
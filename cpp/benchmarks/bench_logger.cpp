@@ -0,0 +1,153 @@
+#include "logging/log_helper.hpp"
+#include "logging/binary_logger.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+/**
+ * Log call microbenchmark: LOG_*_COMP (LogManager) vs FAST_LOG_* (BinaryLogger)
+ *
+ * Logs a typical book-update line (symbol, two counts, a price) from the
+ * calling thread and reports the cost of the call itself, both with the
+ * level disabled (argument evaluation and level check) and enabled
+ * (hand-off to the background writer). Output goes to /dev/null so only
+ * the caller's side is measured.
+ *
+ * Usage: bench_logger [calls]
+ */
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void __libc_free(void* ptr);
+}
+
+namespace {
+std::atomic<uint64_t> g_allocations{0};
+}
+
+extern "C" {
+void* malloc(size_t size) { g_allocations.fetch_add(1, std::memory_order_relaxed); return __libc_malloc(size); }
+void* calloc(size_t count, size_t size) { g_allocations.fetch_add(1, std::memory_order_relaxed); return __libc_calloc(count, size); }
+void* realloc(void* ptr, size_t size) { g_allocations.fetch_add(1, std::memory_order_relaxed); return __libc_realloc(ptr, size); }
+void free(void* ptr) { __libc_free(ptr); }
+}
+
+namespace {
+
+constexpr int kBurst = 64;
+
+// Discards everything LogManager writes to std::cout
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+struct Result {
+    std::vector<uint64_t> latencies_ns;
+    double allocs_per_call;
+};
+
+uint64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void pace() {
+    // Gap between bursts so the background writer keeps up, as in production
+    auto until = std::chrono::steady_clock::now() + std::chrono::microseconds(50);
+    while (std::chrono::steady_clock::now() < until) {}
+}
+
+template <typename LogCall>
+Result run(int calls, LogCall&& log_call) {
+    Result result;
+    result.latencies_ns.reserve(calls);
+
+    uint64_t allocs_before = g_allocations.load();
+    for (int i = 0; i < calls; ++i) {
+        uint64_t start = now_ns();
+        log_call(i);
+        result.latencies_ns.push_back(now_ns() - start);
+        if (i % kBurst == kBurst - 1) pace();
+    }
+    // Latency vector was reserved up front, so every allocation here is the logger's
+    result.allocs_per_call = static_cast<double>(g_allocations.load() - allocs_before) / calls;
+    return result;
+}
+
+void print(const std::string& name, Result& result) {
+    auto& v = result.latencies_ns;
+    std::sort(v.begin(), v.end());
+    auto pct = [&v](double p) { return v[std::min(v.size() - 1, static_cast<size_t>(p * v.size()))]; };
+    std::cout << std::left << std::setw(28) << name << std::right
+              << std::setw(9) << pct(0.50) << std::setw(9) << pct(0.99)
+              << std::setw(10) << pct(0.999) << std::setw(10) << v.back()
+              << std::setw(10) << std::fixed << std::setprecision(2) << result.allocs_per_call << "\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int calls = argc > 1 ? std::atoi(argv[1]) : 100000;
+    const std::string symbol = "BTCUSDT";
+    const int bids = 20;
+    const int asks = 20;
+    const double price = 50000.5;
+
+    NullBuffer null_buffer;
+    std::streambuf* console = std::cout.rdbuf(&null_buffer);
+
+    // LOG_*_COMP through LogManager (level INFO)
+    logging::LogManager::get_instance().initialize("", logging::LogLevel::INFO);
+    auto comp_debug = [&](int) {
+        LOG_DEBUG_COMP("MARKET_SERVER_LIB", "Orderbook update: " + symbol + " bids: " + std::to_string(bids) +
+                       " asks: " + std::to_string(asks) + " mid: " + std::to_string(price));
+    };
+    auto comp_info = [&](int) {
+        LOG_INFO_COMP("MARKET_SERVER_LIB", "Orderbook update: " + symbol + " bids: " + std::to_string(bids) +
+                      " asks: " + std::to_string(asks) + " mid: " + std::to_string(price));
+    };
+    run(10000, comp_info);   // Warm up
+    Result comp_disabled = run(calls, comp_debug);
+    Result comp_enabled = run(calls, comp_info);
+    logging::LogManager::get_instance().shutdown();
+
+    // FAST_LOG_* through BinaryLogger (level INFO)
+    logging::BinaryLoggerConfig config;
+    config.log_file = "/dev/null";
+    config.console = false;
+    logging::BinaryLogger::get_instance().start(config);
+    auto fast_debug = [&](int) {
+        FAST_LOG_DEBUG("MARKET_SERVER_LIB", "Orderbook update: {} bids: {} asks: {} mid: {}", symbol, bids, asks, price);
+    };
+    auto fast_info = [&](int) {
+        FAST_LOG_INFO("MARKET_SERVER_LIB", "Orderbook update: {} bids: {} asks: {} mid: {}", symbol, bids, asks, price);
+    };
+    run(10000, fast_info);   // Warm up (registers the thread's ring)
+    Result fast_disabled = run(calls, fast_debug);
+    Result fast_enabled = run(calls, fast_info);
+    logging::BinaryLogger::get_instance().flush();
+    uint64_t dropped = logging::BinaryLogger::get_instance().get_dropped_count();
+    logging::BinaryLogger::get_instance().stop();
+
+    std::cout.rdbuf(console);
+    std::cout << calls << " calls, bursts of " << kBurst << "\n\n";
+    std::cout << std::left << std::setw(28) << "log call (ns)" << std::right
+              << std::setw(9) << "p50" << std::setw(9) << "p99" << std::setw(10) << "p99.9"
+              << std::setw(10) << "max" << std::setw(10) << "allocs" << "\n";
+    print("LOG_DEBUG_COMP (disabled)", comp_disabled);
+    print("FAST_LOG_DEBUG (disabled)", fast_disabled);
+    print("LOG_INFO_COMP (enabled)", comp_enabled);
+    print("FAST_LOG_INFO (enabled)", fast_enabled);
+    std::cout << "\nFAST_LOG records dropped (ring full): " << dropped << "\n";
+    return 0;
+}
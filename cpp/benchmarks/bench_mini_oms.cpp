@@ -0,0 +1,126 @@
+#include "../trader/mini_oms.hpp"
+#include "logging/logger.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+
+/**
+ * MiniOMS order lifecycle cost, gateway excluded
+ *
+ * Each cycle places an order, acknowledges it, cancels it and confirms the
+ * cancel, with a fixed number of other orders resting on the book. Runs
+ * once with strategy-supplied cl_ord_ids and once with place_order() ids,
+ * then times walking the resting bids through visit_active_orders()
+ * against copying them out with get_orders_by_symbol().
+ *
+ * Usage: bench_mini_oms [cycles] [resting]
+ */
+
+namespace {
+
+// Accepts everything and does nothing, so only MiniOMS is measured
+class NullGateway : public IOrderGateway {
+public:
+    bool send_order(const std::string&, const std::string&, const std::string&, uint32_t, uint32_t, double,
+                    double) override { return true; }
+    bool cancel_order(const std::string&, const std::string&, const std::string&) override { return true; }
+    bool modify_order(const std::string&, const std::string&, uint32_t, double, double, const std::string&) override {
+        return true;
+    }
+    void begin_batch() override {}
+    bool flush_batch() override { return true; }
+};
+
+void print(const std::string& name, double ops, double seconds) {
+    std::cout << std::left << std::setw(24) << name << std::right
+              << std::setw(14) << std::fixed << std::setprecision(0) << ops / seconds
+              << std::setw(10) << std::setprecision(1) << seconds * 1e9 / ops << "\n";
+}
+
+template <typename Fn>
+double time_it(Fn&& fn) {
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+proto::OrderEvent event(const std::string& cl_ord_id, proto::OrderEventType type) {
+    proto::OrderEvent order_event;
+    order_event.set_cl_ord_id(cl_ord_id);
+    order_event.set_event_type(type);
+    return order_event;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int cycles = argc > 1 ? std::atoi(argv[1]) : 200000;
+    const int resting = argc > 2 ? std::atoi(argv[2]) : 200;
+    logging::LogManager::get_instance().initialize("", logging::LogLevel::ERROR);
+
+    MiniOMS oms;
+    oms.set_exchange_name("BENCH");
+    oms.set_oms_adapter(std::make_shared<NullGateway>());
+    oms.start();
+    for (int i = 0; i < resting; ++i) {
+        const std::string id = "rest-" + std::to_string(i);
+        oms.send_order(id, "BTC-PERP", i % 2 ? proto::SELL : proto::BUY, proto::LIMIT, 1.0, 100.0 + i);
+        oms.on_order_event(event(id, proto::ACK));
+    }
+
+    std::cout << std::left << std::setw(24) << "run" << std::right
+              << std::setw(14) << "ops/s" << std::setw(10) << "ns/op" << "\n";
+
+    // The strategy path: ids built by the caller, events keyed by them
+    const double by_name = time_it([&] {
+        for (int i = 0; i < cycles; ++i) {
+            const std::string id = "q-" + std::to_string(i);
+            oms.send_order(id, "BTC-PERP", proto::BUY, proto::LIMIT, 1.0, 99.0);
+            oms.on_order_event(event(id, proto::ACK));
+            oms.cancel_order(id);
+            oms.on_order_event(event(id, proto::CANCEL));
+        }
+    });
+    print("cl_ord_id lifecycle", cycles, by_name);
+
+    // Generated ids; events still arrive keyed by the wire string
+    const double by_id = time_it([&] {
+        for (int i = 0; i < cycles; ++i) {
+            const MiniOMS::OrderId id = oms.place_order("BTC-PERP", proto::BUY, proto::LIMIT, 1.0, 99.0);
+            std::string wire_id;
+            oms.visit_order(id, [&](const OrderRecord& order) { wire_id.assign(order.cl_ord_id()); });
+            oms.on_order_event(event(wire_id, proto::ACK));
+            oms.cancel_order(id);
+            oms.on_order_event(event(wire_id, proto::CANCEL));
+        }
+    });
+    print("OrderId lifecycle", cycles, by_id);
+
+    double checksum = 0.0;
+    const int scans = cycles / 10 > 0 ? cycles / 10 : 1;
+    const double visited = time_it([&] {
+        for (int i = 0; i < scans; ++i) {
+            oms.visit_active_orders("BTC-PERP", proto::BUY, [&](const OrderRecord& order) { checksum += order.price; });
+        }
+    });
+    print("visit resting bids", scans, visited);
+
+    const double copied = time_it([&] {
+        for (int i = 0; i < scans; ++i) {
+            for (const auto& order : oms.get_orders_by_symbol("BTC-PERP")) {
+                if (order.side == Side::Buy && order.state == OrderState::ACKNOWLEDGED) {
+                    checksum += order.price;
+                }
+            }
+        }
+    });
+    print("copy resting orders", scans, copied);
+
+    std::cout << "\nchecksum " << std::setprecision(1) << checksum << "\n";
+    oms.stop();
+    logging::LogManager::get_instance().shutdown();
+    return 0;
+}
@@ -0,0 +1,179 @@
+#include "lockfree/spsc_ring.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Thread hop microbenchmark: std::queue + mutex + condvar vs SpscRing
+ *
+ * A producer thread hands 512-byte string payloads to a consumer thread in
+ * bursts, the way websocket frames and ZMQ order requests arrive. Reports
+ * hop latency percentiles (publish to consumer pickup) and heap
+ * allocations per message across both threads.
+ *
+ * Usage: bench_spsc_ring [messages]
+ */
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void __libc_free(void* ptr);
+}
+
+namespace {
+std::atomic<uint64_t> g_allocations{0};
+}
+
+extern "C" {
+void* malloc(size_t size) { g_allocations.fetch_add(1, std::memory_order_relaxed); return __libc_malloc(size); }
+void* calloc(size_t count, size_t size) { g_allocations.fetch_add(1, std::memory_order_relaxed); return __libc_calloc(count, size); }
+void* realloc(void* ptr, size_t size) { g_allocations.fetch_add(1, std::memory_order_relaxed); return __libc_realloc(ptr, size); }
+void free(void* ptr) { __libc_free(ptr); }
+}
+
+namespace {
+
+constexpr size_t kPayloadSize = 512;
+constexpr int kBurst = 32;
+
+uint64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Payload carries its publish time in the first 8 bytes
+void stamp(std::string& payload, const std::string& body) {
+    payload.assign(body);
+    uint64_t ts = now_ns();
+    payload.replace(0, sizeof(ts), reinterpret_cast<const char*>(&ts), sizeof(ts));
+}
+
+uint64_t read_stamp(const std::string& payload) {
+    uint64_t ts = 0;
+    payload.copy(reinterpret_cast<char*>(&ts), sizeof(ts));
+    return ts;
+}
+
+struct Result {
+    std::vector<uint64_t> latencies_ns;
+    double allocs_per_msg;
+};
+
+void pace() {
+    // Gap between bursts so the consumer goes idle and has to be woken
+    auto until = std::chrono::steady_clock::now() + std::chrono::microseconds(20);
+    while (std::chrono::steady_clock::now() < until) {}
+}
+
+Result run_mutex_queue(int messages, const std::string& body) {
+    std::queue<std::string> queue;
+    std::mutex mutex;
+    std::condition_variable cv;
+    Result result;
+    result.latencies_ns.reserve(messages);
+
+    uint64_t allocs_before = g_allocations.load();
+    std::thread consumer([&]() {
+        for (int received = 0; received < messages;) {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [&] { return !queue.empty(); });
+            while (!queue.empty()) {
+                std::string message = std::move(queue.front());
+                queue.pop();
+                result.latencies_ns.push_back(now_ns() - read_stamp(message));
+                ++received;
+            }
+        }
+    });
+
+    for (int i = 0; i < messages; ++i) {
+        std::string message;
+        stamp(message, body);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.push(std::move(message));
+        }
+        cv.notify_one();
+        if (i % kBurst == kBurst - 1) pace();
+    }
+    consumer.join();
+
+    result.allocs_per_msg = static_cast<double>(g_allocations.load() - allocs_before) / messages;
+    return result;
+}
+
+Result run_ring(int messages, const std::string& body, WaitStrategy strategy) {
+    SpscRing<std::string> ring(4096, strategy, [](std::string& slot) { slot.reserve(kPayloadSize); });
+    Result result;
+    result.latencies_ns.reserve(messages);
+
+    uint64_t allocs_before = g_allocations.load();
+    std::thread consumer([&]() {
+        for (int received = 0; received < messages;) {
+            std::string* message = ring.wait_front(std::chrono::milliseconds(100));
+            if (!message) continue;
+            result.latencies_ns.push_back(now_ns() - read_stamp(*message));
+            ring.pop();
+            ++received;
+        }
+    });
+
+    for (int i = 0; i < messages; ++i) {
+        std::string* slot;
+        while (!(slot = ring.claim())) RingWaiter::cpu_relax();
+        stamp(*slot, body);
+        ring.publish();
+        if (i % kBurst == kBurst - 1) pace();
+    }
+    consumer.join();
+
+    result.allocs_per_msg = static_cast<double>(g_allocations.load() - allocs_before) / messages;
+    return result;
+}
+
+void print(const std::string& name, Result& result) {
+    auto& v = result.latencies_ns;
+    std::sort(v.begin(), v.end());
+    auto pct = [&v](double p) { return v[std::min(v.size() - 1, static_cast<size_t>(p * v.size()))]; };
+    std::cout << std::left << std::setw(26) << name << std::right
+              << std::setw(9) << pct(0.50) << std::setw(9) << pct(0.99)
+              << std::setw(10) << pct(0.999) << std::setw(10) << v.back()
+              << std::setw(10) << std::fixed << std::setprecision(2) << result.allocs_per_msg << "\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int messages = argc > 1 ? std::atoi(argv[1]) : 200000;
+    const std::string body(kPayloadSize, 'x');
+
+    std::cout << "Payload: " << kPayloadSize << " bytes, " << messages << " messages, bursts of " << kBurst << "\n\n";
+    std::cout << std::left << std::setw(26) << "hop latency (ns)" << std::right
+              << std::setw(9) << "p50" << std::setw(9) << "p99" << std::setw(10) << "p99.9"
+              << std::setw(10) << "max" << std::setw(10) << "allocs" << "\n";
+
+    // Warm up
+    run_mutex_queue(10000, body);
+    run_ring(10000, body, WaitStrategy::FUTEX);
+
+    Result mutex_queue = run_mutex_queue(messages, body);
+    Result spin = run_ring(messages, body, WaitStrategy::BUSY_SPIN);
+    Result yield = run_ring(messages, body, WaitStrategy::YIELD);
+    Result futex = run_ring(messages, body, WaitStrategy::FUTEX);
+
+    print("queue+mutex+condvar", mutex_queue);
+    print("SpscRing busy_spin", spin);
+    print("SpscRing yield", yield);
+    print("SpscRing futex", futex);
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include "exchange/exchange_symbol_registry.hpp"
+#include "logging/logger.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+/**
+ * Symbol registry lookups as one quote update makes them
+ *
+ * Two contracts -> tokens conversions and a validate_and_round per side,
+ * first through the "exchange:symbol" string API and then through a
+ * handle resolved once. Inputs move every iteration so rounding is real.
+ *
+ * Usage: bench_symbol_registry [updates]
+ */
+
+namespace {
+
+void print(const std::string& name, double updates, double seconds) {
+    std::cout << std::left << std::setw(24) << name << std::right
+              << std::setw(14) << std::fixed << std::setprecision(0) << updates / seconds
+              << std::setw(10) << std::setprecision(1) << seconds * 1e9 / updates << "\n";
+}
+
+template <typename Fn>
+double time_it(Fn&& fn) {
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int updates = argc > 1 ? std::atoi(argv[1]) : 2000000;
+    logging::LogManager::get_instance().initialize("", logging::LogLevel::ERROR);
+
+    // A registry the size of a real instrument config, benchmarked symbol last
+    const std::string path = "bench_symbol_registry.ini";
+    {
+        std::ofstream file(path);
+        for (int i = 0; i < 200; ++i) {
+            file << "[GRVT:SYM" << i << "-PERP]\ntick_size = 0.01\nstep_size = 0.01\n";
+        }
+        file << "[GRVT:BTC_USDT_Perp]\ntick_size = 0.1\nstep_size = 0.001\nmin_order_size = 0.001\n"
+             << "price_precision = 1\nqty_precision = 3\n"
+             << "contract_size = 0.001\ncontract_size_denomination = BTC\n";
+    }
+    auto& registry = ExchangeSymbolRegistry::get_instance();
+    if (!registry.load_from_config(path)) {
+        std::cerr << "Failed to load " << path << std::endl;
+        return 1;
+    }
+    std::remove(path.c_str());
+
+    const std::string exchange = "GRVT";
+    const std::string symbol = "BTC_USDT_Perp";
+    std::cout << std::left << std::setw(24) << "run" << std::right
+              << std::setw(14) << "updates/s" << std::setw(10) << "ns/upd" << "\n";
+
+    double checksum = 0.0;
+    const double by_name = time_it([&] {
+        for (int i = 0; i < updates; ++i) {
+            const double spot = 50000.0 + (i % 1000) * 0.037;
+            checksum += registry.contracts_to_token_qty(exchange, symbol, 120.0 + (i % 7), spot);
+            checksum += registry.contracts_to_token_qty(exchange, symbol, 95.0 + (i % 5), spot);
+            double bid_size = 0.0123 + (i % 11) * 0.0001, bid = spot - 3.21;
+            double ask_size = 0.0119 + (i % 13) * 0.0001, ask = spot + 3.27;
+            registry.validate_and_round(exchange, symbol, bid_size, bid);
+            registry.validate_and_round(exchange, symbol, ask_size, ask);
+            checksum += bid + ask + bid_size + ask_size;
+        }
+    });
+    print("string key", updates, by_name);
+
+    const auto handle = registry.find_instrument(exchange, symbol);
+    const double by_handle = time_it([&] {
+        for (int i = 0; i < updates; ++i) {
+            const double spot = 50000.0 + (i % 1000) * 0.037;
+            checksum += registry.contracts_to_token_qty(handle, 120.0 + (i % 7), spot);
+            checksum += registry.contracts_to_token_qty(handle, 95.0 + (i % 5), spot);
+            double bid_size = 0.0123 + (i % 11) * 0.0001, bid = spot - 3.21;
+            double ask_size = 0.0119 + (i % 13) * 0.0001, ask = spot + 3.27;
+            registry.validate_and_round(handle, bid_size, bid);
+            registry.validate_and_round(handle, ask_size, ask);
+            checksum += bid + ask + bid_size + ask_size;
+        }
+    });
+    print("handle", updates, by_handle);
+
+    std::cout << "\nchecksum " << std::setprecision(3) << checksum << "\n";
+    logging::LogManager::get_instance().shutdown();
+    return 0;
+}
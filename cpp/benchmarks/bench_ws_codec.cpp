@@ -0,0 +1,139 @@
+#include "websocket/websocket_frame_codec.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * Websocket frame codec microbenchmark
+ *
+ * Encodes a client frame and decodes a server frame of a typical depth-update
+ * size, comparing the previous per-frame approach (byte-wise masking into a
+ * fresh std::vector, decoded payload copied into a std::string) with
+ * websocket_codec (vector masking into a reused buffer, zero-copy decode).
+ *
+ * Usage: bench_ws_codec [iterations] [payload_bytes]
+ */
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void __libc_free(void* ptr);
+}
+
+namespace {
+std::atomic<uint64_t> g_allocations{0};
+}
+
+extern "C" {
+void* malloc(size_t size) { g_allocations.fetch_add(1, std::memory_order_relaxed); return __libc_malloc(size); }
+void* calloc(size_t count, size_t size) { g_allocations.fetch_add(1, std::memory_order_relaxed); return __libc_calloc(count, size); }
+void* realloc(void* ptr, size_t size) { g_allocations.fetch_add(1, std::memory_order_relaxed); return __libc_realloc(ptr, size); }
+void free(void* ptr) { __libc_free(ptr); }
+}
+
+namespace {
+
+struct Result {
+    std::vector<uint64_t> latencies_ns;
+    double allocs_per_op;
+};
+
+uint64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+template <typename Op>
+Result run(int iterations, Op&& op) {
+    Result result;
+    result.latencies_ns.reserve(iterations);
+    uint64_t allocs_before = g_allocations.load();
+    for (int i = 0; i < iterations; ++i) {
+        uint64_t start = now_ns();
+        op();
+        result.latencies_ns.push_back(now_ns() - start);
+    }
+    result.allocs_per_op = static_cast<double>(g_allocations.load() - allocs_before) / iterations;
+    return result;
+}
+
+void print(const std::string& name, Result& result) {
+    auto& v = result.latencies_ns;
+    std::sort(v.begin(), v.end());
+    auto pct = [&v](double p) { return v[std::min(v.size() - 1, static_cast<size_t>(p * v.size()))]; };
+    std::cout << std::left << std::setw(28) << name << std::right
+              << std::setw(9) << pct(0.50) << std::setw(9) << pct(0.99)
+              << std::setw(10) << pct(0.999) << std::setw(10) << v.back()
+              << std::setw(10) << std::fixed << std::setprecision(2) << result.allocs_per_op << "\n";
+}
+
+// Previous encoder: fresh vector, byte-wise mask
+std::vector<uint8_t> legacy_encode(const std::string& payload, const uint8_t key[4]) {
+    std::vector<uint8_t> frame;
+    uint8_t header[websocket_codec::kMaxHeaderSize];
+    size_t header_size = websocket_codec::encode_header(header, WebSocketFrame::OPCODE_TEXT, true, payload.size(), key);
+    frame.insert(frame.end(), header, header + header_size);
+    for (size_t i = 0; i < payload.size(); ++i) {
+        frame.push_back(static_cast<uint8_t>(payload[i]) ^ key[i % 4]);
+    }
+    return frame;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int iterations = argc > 1 ? std::atoi(argv[1]) : 100000;
+    const size_t payload_bytes = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 512;
+    const std::string payload(payload_bytes, 'x');
+
+    websocket_codec::WebSocketMaskKeyGenerator keys;
+    uint8_t key[4];
+    volatile size_t sink = 0;
+
+    Result legacy_encoder = run(iterations, [&]() {
+        keys.next(key);
+        sink = sink + legacy_encode(payload, key).size();
+    });
+
+    std::string frame_buffer;
+    Result codec_encoder = run(iterations, [&]() {
+        keys.next(key);
+        websocket_codec::encode_frame(frame_buffer, WebSocketFrame::OPCODE_TEXT, payload.data(), payload.size(), key);
+        sink = sink + frame_buffer.size();
+    });
+
+    // Server frames are unmasked
+    std::string server_frame;
+    websocket_codec::encode_frame(server_frame, WebSocketFrame::OPCODE_TEXT, payload.data(), payload.size(), nullptr);
+
+    websocket_codec::WebSocketFrameDecoder copying_decoder;
+    copying_decoder.set_frame_callback([&sink](uint8_t, std::string_view data) {
+        std::string message(data);   // What the WebSocketMessage callback does
+        sink = sink + message.size();
+    });
+    Result copy_decoder = run(iterations, [&]() {
+        copying_decoder.feed(server_frame.data(), server_frame.size());
+    });
+
+    websocket_codec::WebSocketFrameDecoder view_decoder;
+    view_decoder.set_frame_callback([&sink](uint8_t, std::string_view data) { sink = sink + data.size(); });
+    Result zero_copy_decoder = run(iterations, [&]() {
+        view_decoder.feed(server_frame.data(), server_frame.size());
+    });
+
+    std::cout << iterations << " frames, " << payload_bytes << " byte payload\n\n";
+    std::cout << std::left << std::setw(28) << "per frame (ns)" << std::right
+              << std::setw(9) << "p50" << std::setw(9) << "p99" << std::setw(10) << "p99.9"
+              << std::setw(10) << "max" << std::setw(10) << "allocs" << "\n";
+    print("encode (vector, byte mask)", legacy_encoder);
+    print("encode (codec)", codec_encoder);
+    print("decode (string copy)", copy_decoder);
+    print("decode (string_view)", zero_copy_decoder);
+    return 0;
+}
@@ -0,0 +1,141 @@
+#include "zmq/zmq_publisher.hpp"
+#include "../proto/market_data.pb.h"
+#include <zmq.h>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+
+/**
+ * ZmqPublisher microbenchmark: legacy send_string() vs zero-copy send_message()
+ *
+ * Publishes a 20-level proto::OrderBookSnapshot to a live subscriber and
+ * reports ns/msg and heap allocations per message on the publishing thread.
+ * Allocations are counted by interposing glibc malloc for this executable.
+ *
+ * Usage: bench_zmq_publisher [messages]
+ */
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void __libc_free(void* ptr);
+}
+
+namespace {
+thread_local uint64_t t_allocations = 0;
+}
+
+extern "C" {
+void* malloc(size_t size) { ++t_allocations; return __libc_malloc(size); }
+void* calloc(size_t count, size_t size) { ++t_allocations; return __libc_calloc(count, size); }
+void* realloc(void* ptr, size_t size) { ++t_allocations; return __libc_realloc(ptr, size); }
+void free(void* ptr) { __libc_free(ptr); }
+}
+
+namespace {
+
+constexpr const char* kEndpoint = "tcp://127.0.0.1:5599";
+constexpr const char* kTopic = "market_data";
+
+proto::OrderBookSnapshot make_book() {
+    proto::OrderBookSnapshot book;
+    book.set_exch("BINANCE");
+    book.set_symbol("BTCUSDT");
+    book.set_timestamp_us(1700000000000000ULL);
+    for (int i = 0; i < 20; ++i) {
+        auto* bid = book.add_bids();
+        bid->set_price(100000.0 - i * 0.1);
+        bid->set_qty(1.0 + i);
+        auto* ask = book.add_asks();
+        ask->set_price(100000.1 + i * 0.1);
+        ask->set_qty(1.0 + i);
+    }
+    return book;
+}
+
+struct Result {
+    double ns_per_msg;
+    double allocs_per_msg;
+    uint64_t dropped;
+};
+
+template <typename SendFn>
+Result run(ZmqPublisher& publisher, int messages, SendFn&& send_fn) {
+    uint64_t dropped_before = publisher.get_messages_dropped();
+    uint64_t allocs_before = t_allocations;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < messages; ++i) {
+        send_fn(i);
+    }
+    auto end = std::chrono::steady_clock::now();
+    uint64_t allocs = t_allocations - allocs_before;
+
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    return {ns / messages, static_cast<double>(allocs) / messages,
+            publisher.get_messages_dropped() - dropped_before};
+}
+
+void print(const std::string& name, const Result& result) {
+    std::cout << std::left << std::setw(28) << name
+              << std::right << std::setw(10) << std::fixed << std::setprecision(1) << result.ns_per_msg << " ns/msg"
+              << std::setw(10) << std::setprecision(2) << result.allocs_per_msg << " allocs/msg"
+              << std::setw(10) << result.dropped << " dropped\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int messages = argc > 1 ? std::atoi(argv[1]) : 200000;
+
+    // High HWM so the benchmark measures the send path, not drops
+    ZmqPublisher publisher(kEndpoint, 1000000, false, ZmqPublisher::MARKET_DATA_FRAME_POOL_SIZE);
+
+    // Drain on a real subscriber so frames travel through a pipe and are released by the I/O thread
+    std::atomic<bool> running{true};
+    std::thread drain([&running]() {
+        void* ctx = zmq_ctx_new();
+        void* sub = zmq_socket(ctx, ZMQ_SUB);
+        int rcvhwm = 1000000;
+        int timeout_ms = 100;
+        zmq_setsockopt(sub, ZMQ_RCVHWM, &rcvhwm, sizeof(rcvhwm));
+        zmq_setsockopt(sub, ZMQ_RCVTIMEO, &timeout_ms, sizeof(timeout_ms));
+        zmq_setsockopt(sub, ZMQ_SUBSCRIBE, "", 0);
+        zmq_connect(sub, kEndpoint);
+        zmq_msg_t msg;
+        zmq_msg_init(&msg);
+        while (running.load()) {
+            zmq_msg_recv(&msg, sub, 0);
+        }
+        zmq_msg_close(&msg);
+        zmq_close(sub);
+        zmq_ctx_term(ctx);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+    const proto::OrderBookSnapshot book = make_book();
+    std::cout << "Payload: " << book.ByteSizeLong() << " bytes, " << messages << " messages\n\n";
+
+    // Warm up both paths (topic cache, pool, socket pipes)
+    run(publisher, 1000, [&](int) { publisher.send_string(kTopic, book.SerializeAsString()); });
+    run(publisher, 1000, [&](int) { publisher.send_message(kTopic, book); });
+
+    Result legacy = run(publisher, messages, [&](int) {
+        publisher.send_string(kTopic, book.SerializeAsString());
+    });
+    Result zero_copy = run(publisher, messages, [&](int) {
+        publisher.send_message(kTopic, book);
+    });
+
+    print("send_string(SerializeAsString)", legacy);
+    print("send_message (zero-copy)", zero_copy);
+    std::cout << "\nFrame pool exhausted: " << publisher.get_frame_pool_exhausted() << "\n";
+
+    running.store(false);
+    drain.join();
+    return 0;
+}
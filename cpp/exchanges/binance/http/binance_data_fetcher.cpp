@@ -6,11 +6,13 @@
 #include <openssl/hmac.h>
 #include <openssl/sha.h>
 #include <string>
+#include <algorithm>
 
 namespace binance {
 
 BinanceDataFetcher::BinanceDataFetcher(const std::string& api_key, const std::string& api_secret)
-    : api_key_(api_key), api_secret_(api_secret), curl_(nullptr), authenticated_(false) {
+    : api_key_(api_key), api_secret_(api_secret), base_url_("https://fapi.binance.com"),
+      curl_(nullptr), authenticated_(false) {
     curl_ = curl_easy_init();
     if (!curl_) {
         std::cerr << "[BINANCE_DATA_FETCHER] Failed to initialize CURL" << std::endl;
@@ -84,7 +86,25 @@ std::vector<proto::AccountBalance> BinanceDataFetcher::get_balances() {
     return parse_balances(response);
 }
 
-std::string BinanceDataFetcher::make_request(const std::string& endpoint, const std::string& params) {
+bool BinanceDataFetcher::get_orderbook_snapshot(const std::string& symbol, int depth,
+                                                proto::OrderBookSnapshot& snapshot,
+                                                uint64_t& last_update_id) {
+    std::string binance_symbol = symbol;
+    std::transform(binance_symbol.begin(), binance_symbol.end(), binance_symbol.begin(), ::toupper);
+    
+    // Market data endpoint: no signature even when credentials are set
+    std::string params = "symbol=" + binance_symbol + "&limit=" + std::to_string(depth);
+    std::string response = make_request("/fapi/v1/depth", params, false);
+    
+    if (response.empty()) {
+        std::cerr << "[BINANCE_DATA_FETCHER] Empty response for depth snapshot: " << binance_symbol << std::endl;
+        return false;
+    }
+    
+    return parse_orderbook_snapshot(response, binance_symbol, snapshot, last_update_id);
+}
+
+std::string BinanceDataFetcher::make_request(const std::string& endpoint, const std::string& params, bool signed_request) {
     if (!curl_) {
         std::cerr << "[BINANCE_DATA_FETCHER] CURL not initialized" << std::endl;
         return "";
@@ -96,7 +116,7 @@ std::string BinanceDataFetcher::make_request(const std::string& endpoint, const
     }
     
     // Add timestamp and signature for authenticated requests
-    if (is_authenticated()) {
+    if (signed_request && is_authenticated()) {
         std::string timestamp = get_timestamp();
         std::string query_string = params.empty() ? "" : params + "&";
         query_string += "timestamp=" + timestamp;
@@ -113,11 +133,14 @@ std::string BinanceDataFetcher::make_request(const std::string& endpoint, const
     std::string response_data;
     curl_easy_setopt(curl_, CURLOPT_WRITEDATA, &response_data);
     
-    if (is_authenticated()) {
+    if (signed_request && is_authenticated()) {
         struct curl_slist* headers = nullptr;
         std::string api_key_header = "X-MBX-APIKEY: " + api_key_;
         headers = curl_slist_append(headers, api_key_header.c_str());
         curl_easy_setopt(curl_, CURLOPT_HTTPHEADER, headers);
+    } else {
+        // The handle is reused; drop headers left over from a signed request
+        curl_easy_setopt(curl_, CURLOPT_HTTPHEADER, nullptr);
     }
     
     CURLcode res = curl_easy_perform(curl_);
@@ -295,6 +318,43 @@ std::vector<proto::AccountBalance> BinanceDataFetcher::parse_balances(const std:
     return balances;
 }
 
+bool BinanceDataFetcher::parse_orderbook_snapshot(const std::string& json_response, const std::string& symbol,
+                                                  proto::OrderBookSnapshot& snapshot, uint64_t& last_update_id) {
+    Json::Value root;
+    Json::Reader reader;
+    
+    if (!reader.parse(json_response, root)) {
+        std::cerr << "[BINANCE_DATA_FETCHER] Failed to parse JSON: " << reader.getFormattedErrorMessages() << std::endl;
+        return false;
+    }
+    
+    if (!root.isMember("lastUpdateId")) {
+        std::cerr << "[BINANCE_DATA_FETCHER] Depth snapshot missing lastUpdateId" << std::endl;
+        return false;
+    }
+    
+    last_update_id = root["lastUpdateId"].asUInt64();
+    snapshot.Clear();
+    snapshot.set_exch("binance");
+    snapshot.set_symbol(symbol);
+    snapshot.set_timestamp_us(root.isMember("E") ? root["E"].asUInt64() * 1000 :
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+    
+    for (const auto& bid : root["bids"]) {
+        proto::OrderBookLevel* level = snapshot.add_bids();
+        level->set_price(std::stod(bid[0].asString()));
+        level->set_qty(std::stod(bid[1].asString()));
+    }
+    for (const auto& ask : root["asks"]) {
+        proto::OrderBookLevel* level = snapshot.add_asks();
+        level->set_price(std::stod(ask[0].asString()));
+        level->set_qty(std::stod(ask[1].asString()));
+    }
+    
+    return true;
+}
+
 size_t BinanceDataFetcher::DataFetcherWriteCallback(void* contents, size_t size, size_t nmemb, std::string* data) {
     size_t total_size = size * nmemb;
     data->append((char*)contents, total_size);
@@ -24,6 +24,11 @@ public:
     std::vector<proto::OrderEvent> get_open_orders() override;
     std::vector<proto::PositionUpdate> get_positions() override;
     std::vector<proto::AccountBalance> get_balances() override;
+    
+    // Public depth snapshot (GET /fapi/v1/depth) for local order book resync
+    bool get_orderbook_snapshot(const std::string& symbol, int depth,
+                                proto::OrderBookSnapshot& snapshot,
+                                uint64_t& last_update_id) override;
 
 private:
     std::string api_key_;
@@ -33,7 +38,7 @@ private:
     std::atomic<bool> authenticated_;
     
     // Helper methods
-    std::string make_request(const std::string& endpoint, const std::string& params = "");
+    std::string make_request(const std::string& endpoint, const std::string& params = "", bool signed_request = true);
     std::string create_signature(const std::string& query_string);
     std::string get_timestamp();
     
@@ -41,6 +46,8 @@ private:
     std::vector<proto::OrderEvent> parse_orders(const std::string& json_response);
     std::vector<proto::PositionUpdate> parse_positions(const std::string& json_response);
     std::vector<proto::AccountBalance> parse_balances(const std::string& json_response);
+    bool parse_orderbook_snapshot(const std::string& json_response, const std::string& symbol,
+                                  proto::OrderBookSnapshot& snapshot, uint64_t& last_update_id);
     
     // CURL callback
     static size_t DataFetcherWriteCallback(void* contents, size_t size, size_t nmemb, std::string* data);
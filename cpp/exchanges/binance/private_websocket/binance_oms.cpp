@@ -11,55 +11,56 @@
 #include <memory>
 #include <thread>
 #include <ctime>
-#include <cstdio>
-#include <curl/curl.h>
+#include <cctype>
+#include <charconv>
 #include <json/json.h>
 
 namespace binance {
 
-// CURL global state management with reference counting
 namespace {
-    std::mutex curl_init_mutex;
-    std::atomic<int> curl_ref_count{0};
-    
-    void ensure_curl_initialized() {
-        std::lock_guard<std::mutex> lock(curl_init_mutex);
-        if (curl_ref_count.fetch_add(1) == 0) {
-            curl_global_init(CURL_GLOBAL_DEFAULT);
-        }
-    }
-    
-    void ensure_curl_cleanup() {
-        std::lock_guard<std::mutex> lock(curl_init_mutex);
-        if (curl_ref_count.fetch_sub(1) == 1) {
-            curl_global_cleanup();
+
+// Binance limits per batchOrders request
+constexpr size_t kMaxBatchPlace = 5;
+constexpr size_t kMaxBatchCancel = 10;
+
+std::string url_encode(const std::string& value) {
+    static const char hex[] = "0123456789ABCDEF";
+    std::string encoded;
+    encoded.reserve(value.size() * 3);
+    for (unsigned char c : value) {
+        if (std::isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~') {
+            encoded.push_back(static_cast<char>(c));
+        } else {
+            encoded.push_back('%');
+            encoded.push_back(hex[c >> 4]);
+            encoded.push_back(hex[c & 0x0F]);
         }
     }
+    return encoded;
 }
 
-// HTTP response callback for CURL
-static size_t OMSWriteCallback(void* contents, size_t size, size_t nmemb, std::string* s) {
-    size_t newLength = size * nmemb;
-    try {
-        s->append((char*)contents, newLength);
-        return newLength;
-    } catch (std::bad_alloc& e) {
-        return 0;
-    }
+std::string compact_json(const Json::Value& value) {
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "";
+    return Json::writeString(builder, value);
+}
+
+// Batch responses hold one entry per request, either the order or {"code","msg"}
+bool batch_entry_accepted(const Json::Value& entry) {
+    return entry.isObject() && !entry.isMember("code") && entry.isMember("orderId");
 }
 
+} // namespace
+
 BinanceOMS::BinanceOMS(const BinanceConfig& config) 
-    : config_(config), connected_(false), authenticated_(false) {
+    : config_(config), connected_(false), authenticated_(false),
+      http_pool_(HttpConnectionPool::shared()), signer_(config.api_secret) {
     LOG_INFO_COMP("BINANCE", "Initializing Binance OMS");
-    
-    // Initialize CURL with reference counting
-    ensure_curl_initialized();
+    rebuild_rest_template();
 }
 
 BinanceOMS::~BinanceOMS() {
     LOG_INFO_COMP("BINANCE", "Destroying Binance OMS");
-    // Cleanup CURL with reference counting
-    ensure_curl_cleanup();
 }
 
 bool BinanceOMS::connect() {
@@ -76,6 +77,9 @@ bool BinanceOMS::connect() {
         return false;
     }
     
+    // Open the keep-alive connection now so the first order skips the TCP + TLS handshake
+    http_pool_->warm_up(config_.base_url + "/fapi/v1/ping");
+    
     connected_.store(true);
     LOG_INFO_COMP("BINANCE", "Connected to Binance");
     return true;
@@ -93,21 +97,40 @@ bool BinanceOMS::is_connected() const {
 void BinanceOMS::set_auth_credentials(const std::string& api_key, const std::string& secret) {
     config_.api_key = api_key;
     config_.api_secret = secret;
+    signer_.set_secret(secret);
+    rebuild_rest_template();
     authenticated_.store(!api_key.empty() && !secret.empty());
 }
 
+void BinanceOMS::rebuild_rest_template() {
+    std::atomic_store(&rest_template_, std::shared_ptr<const HttpRequestTemplate>(
+        std::make_shared<HttpRequestTemplate>(config_.base_url, std::map<std::string, std::string>{
+            {"X-MBX-APIKEY", config_.api_key}})));
+}
+
 bool BinanceOMS::is_authenticated() const {
     return authenticated_.load();
 }
 
-bool BinanceOMS::cancel_order(const std::string& cl_ord_id, const std::string& exch_ord_id) {
+bool BinanceOMS::cancel_order(const std::string& cl_ord_id, const std::string& exch_ord_id,
+                              const std::string& symbol) {
     if (!is_connected() || !is_authenticated()) {
         LOG_ERROR_COMP("BINANCE", "Not connected or authenticated");
         return false;
     }
+    // Binance looks orders up per symbol
+    if (symbol.empty()) {
+        LOG_ERROR_COMP("BINANCE", "Cannot cancel " + cl_ord_id + " without its symbol");
+        return false;
+    }
     
     std::string endpoint = "/fapi/v1/order";
-    std::string params = "symbol=BTCUSDT&orderId=" + exch_ord_id;
+    std::string params = "symbol=" + symbol;
+    if (!exch_ord_id.empty()) {
+        params += "&orderId=" + exch_ord_id;
+    } else {
+        params += "&origClientOrderId=" + url_encode(cl_ord_id);
+    }
     
     std::string response = make_request(endpoint, "DELETE", params, true);
     if (response.empty()) {
@@ -132,24 +155,31 @@ bool BinanceOMS::replace_order(const std::string& cl_ord_id, const proto::OrderR
         return false;
     }
     
-    // First cancel the existing order
-    if (!cancel_order(cl_ord_id, "")) {  // We don't have exch_order_id in OrderRequest
-        LOG_ERROR_COMP("BINANCE", "Failed to cancel existing order for replace");
+    // Modified in place, so the order keeps its clientOrderId and its events still match
+    if (new_order.type() == proto::OrderType::MARKET) {
+        LOG_ERROR_COMP("BINANCE", "Only limit orders can be modified: " + cl_ord_id);
         return false;
     }
     
-    // Then place the new order
-    if (new_order.type() == proto::OrderType::MARKET) {
-        return place_market_order(new_order.symbol(), 
-                                 new_order.side() == proto::Side::BUY ? "BUY" : "SELL", 
-                                 new_order.qty());
-    } else if (new_order.type() == proto::OrderType::LIMIT) {
-        return place_limit_order(new_order.symbol(), 
-                                new_order.side() == proto::Side::BUY ? "BUY" : "SELL", 
-                                new_order.qty(), 
-                                new_order.price());
+    std::string endpoint = "/fapi/v1/order";
+    std::string params = "symbol=" + new_order.symbol() +
+                        "&side=" + (new_order.side() == proto::Side::BUY ? "BUY" : "SELL") +
+                        "&origClientOrderId=" + url_encode(cl_ord_id) +
+                        "&quantity=" + std::to_string(new_order.qty()) +
+                        "&price=" + std::to_string(new_order.price());
+    
+    std::string response = make_request(endpoint, "PUT", params, true);
+    if (response.empty()) {
+        LOG_ERROR_COMP("BINANCE", "Failed to modify order");
+        return false;
     }
     
+    Json::Value root;
+    Json::Reader reader;
+    if (reader.parse(response, root) && batch_entry_accepted(root)) {
+        return true;
+    }
+    LOG_ERROR_COMP("BINANCE", "Modify rejected: " + get_error_message(response));
     return false;
 }
 
@@ -175,7 +205,8 @@ proto::OrderEvent BinanceOMS::get_order_status(const std::string& cl_ord_id, con
     return parse_order_from_json(response);
 }
 
-bool BinanceOMS::place_market_order(const std::string& symbol, const std::string& side, double quantity) {
+bool BinanceOMS::place_market_order(const std::string& symbol, const std::string& side, double quantity,
+                                    const std::string& cl_ord_id) {
     if (!is_connected() || !is_authenticated()) {
         LOG_ERROR_COMP("BINANCE", "Not connected or authenticated");
         return false;
@@ -186,6 +217,9 @@ bool BinanceOMS::place_market_order(const std::string& symbol, const std::string
                         "&side=" + side + 
                         "&type=MARKET" + 
                         "&quantity=" + std::to_string(quantity);
+    if (!cl_ord_id.empty()) {
+        params += "&newClientOrderId=" + url_encode(cl_ord_id);
+    }
     
     std::string response = make_request(endpoint, "POST", params, true);
     if (response.empty()) {
@@ -204,7 +238,8 @@ bool BinanceOMS::place_market_order(const std::string& symbol, const std::string
     return false;
 }
 
-bool BinanceOMS::place_limit_order(const std::string& symbol, const std::string& side, double quantity, double price) {
+bool BinanceOMS::place_limit_order(const std::string& symbol, const std::string& side, double quantity, double price,
+                                   const std::string& cl_ord_id) {
     if (!is_connected() || !is_authenticated()) {
         LOG_ERROR_COMP("BINANCE", "Not connected or authenticated");
         return false;
@@ -217,6 +252,9 @@ bool BinanceOMS::place_limit_order(const std::string& symbol, const std::string&
                         "&quantity=" + std::to_string(quantity) +
                         "&price=" + std::to_string(price) +
                         "&timeInForce=GTC";
+    if (!cl_ord_id.empty()) {
+        params += "&newClientOrderId=" + url_encode(cl_ord_id);
+    }
     
     std::string response = make_request(endpoint, "POST", params, true);
     if (response.empty()) {
@@ -235,79 +273,165 @@ bool BinanceOMS::place_limit_order(const std::string& symbol, const std::string&
     return false;
 }
 
+void BinanceOMS::submit_batch(const proto::OrderBatchRequest& batch, std::vector<bool>& results) {
+    results.assign(static_cast<size_t>(batch.actions_size()), false);
+    if (!is_connected() || !is_authenticated()) {
+        LOG_ERROR_COMP("BINANCE", "Not connected or authenticated");
+        return;
+    }
+    
+    // Cancels first so margin they free is available to the new orders of the same requote
+    std::vector<int> cancels;
+    std::vector<int> new_orders;
+    for (int i = 0; i < batch.actions_size(); ++i) {
+        const proto::OrderAction& action = batch.actions(i);
+        if (action.action() == proto::CANCEL_ORDER) {
+            if (action.order().symbol().empty()) {
+                LOG_ERROR_COMP("BINANCE", "Rejecting cancel of " + action.order().cl_ord_id() + " without a symbol");
+            } else {
+                cancels.push_back(i);
+            }
+        } else if (action.action() == proto::NEW_ORDER) {
+            new_orders.push_back(i);
+        }
+    }
+    submit_cancels(batch, cancels, results);
+    
+    for (int i = 0; i < batch.actions_size(); ++i) {
+        const proto::OrderAction& action = batch.actions(i);
+        if (action.action() == proto::REPLACE_ORDER) {
+            results[i] = replace_order(action.order().cl_ord_id(), action.order());
+        }
+    }
+    submit_new_orders(batch, new_orders, results);
+}
+
+void BinanceOMS::submit_new_orders(const proto::OrderBatchRequest& batch, const std::vector<int>& indices,
+                                   std::vector<bool>& results) {
+    for (size_t start = 0; start < indices.size(); start += kMaxBatchPlace) {
+        size_t end = std::min(indices.size(), start + kMaxBatchPlace);
+        
+        Json::Value orders(Json::arrayValue);
+        for (size_t k = start; k < end; ++k) {
+            const proto::OrderRequest& order = batch.actions(indices[k]).order();
+            Json::Value entry;
+            entry["symbol"] = order.symbol();
+            entry["side"] = order.side() == proto::Side::BUY ? "BUY" : "SELL";
+            entry["quantity"] = std::to_string(order.qty());
+            if (!order.cl_ord_id().empty()) {
+                entry["newClientOrderId"] = order.cl_ord_id();
+            }
+            if (order.type() == proto::OrderType::MARKET) {
+                entry["type"] = "MARKET";
+            } else {
+                entry["type"] = "LIMIT";
+                entry["price"] = std::to_string(order.price());
+                entry["timeInForce"] = "GTC";
+            }
+            orders.append(entry);
+        }
+        
+        std::string response = make_request("/fapi/v1/batchOrders", "POST",
+                                             "batchOrders=" + url_encode(compact_json(orders)), true);
+        Json::Value root;
+        Json::Reader reader;
+        if (response.empty() || !reader.parse(response, root) || !root.isArray()) {
+            LOG_ERROR_COMP("BINANCE", "Batch place failed: " + (response.empty() ? "no response" : get_error_message(response)));
+            continue;
+        }
+        for (size_t k = start; k < end; ++k) {
+            Json::ArrayIndex entry = static_cast<Json::ArrayIndex>(k - start);
+            results[indices[k]] = entry < root.size() && batch_entry_accepted(root[entry]);
+        }
+    }
+}
+
+void BinanceOMS::submit_cancels(const proto::OrderBatchRequest& batch, const std::vector<int>& indices,
+                                std::vector<bool>& results) {
+    // Batch cancels are per symbol
+    std::map<std::string, std::vector<int>> by_symbol;
+    for (int index : indices) {
+        by_symbol[batch.actions(index).order().symbol()].push_back(index);
+    }
+    
+    for (const auto& [symbol, symbol_indices] : by_symbol) {
+        for (size_t start = 0; start < symbol_indices.size(); start += kMaxBatchCancel) {
+            size_t end = std::min(symbol_indices.size(), start + kMaxBatchCancel);
+            
+            Json::Value ids(Json::arrayValue);
+            for (size_t k = start; k < end; ++k) {
+                ids.append(batch.actions(symbol_indices[k]).order().cl_ord_id());
+            }
+            
+            std::string params = "symbol=" + symbol + "&origClientOrderIdList=" + url_encode(compact_json(ids));
+            std::string response = make_request("/fapi/v1/batchOrders", "DELETE", params, true);
+            Json::Value root;
+            Json::Reader reader;
+            if (response.empty() || !reader.parse(response, root) || !root.isArray()) {
+                LOG_ERROR_COMP("BINANCE", "Batch cancel failed: " + (response.empty() ? "no response" : get_error_message(response)));
+                continue;
+            }
+            for (size_t k = start; k < end; ++k) {
+                Json::ArrayIndex entry = static_cast<Json::ArrayIndex>(k - start);
+                results[symbol_indices[k]] = entry < root.size() && batch_entry_accepted(root[entry]);
+            }
+        }
+    }
+}
+
 void BinanceOMS::set_order_status_callback(OrderStatusCallback callback) {
     order_callback_ = callback;
 }
 
 std::string BinanceOMS::make_request(const std::string& endpoint, const std::string& method, 
                                    const std::string& body, bool is_signed) {
-    CURL* curl = curl_easy_init();
-    if (!curl) {
-        LOG_ERROR_COMP("BINANCE", "Failed to initialize CURL");
-        return "";
-    }
+    HttpRequest request;
+    request.method = method;
+    request.timeout_ms = config_.timeout_ms;
     
-    std::string url = config_.base_url + endpoint;
-    if (!body.empty()) {
-        url += "?" + body;
-    }
+    // Path and query only; base URL and API key header come from the template
+    std::string& path = request.url;
+    path.reserve(endpoint.size() + body.size() + 128);
+    path.append(endpoint);
     
-    // Add timestamp and signature for signed requests
     if (is_signed) {
-        std::string timestamp = std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::system_clock::now().time_since_epoch()).count());
+        char timestamp[24];
+        auto now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        char* timestamp_end = std::to_chars(timestamp, timestamp + sizeof(timestamp), now_ms).ptr;
         
-        std::string query_string = body.empty() ? "" : body + "&";
-        query_string += "timestamp=" + timestamp;
-        
-        std::string signature = generate_signature(query_string);
-        query_string += "&signature=" + signature;
+        path += '?';
+        size_t query_start = path.size();
+        if (!body.empty()) {
+            path.append(body).append(1, '&');
+        }
+        path.append("timestamp=").append(timestamp, timestamp_end);
         
-        url = config_.base_url + endpoint + "?" + query_string;
-    }
-    
-    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, OMSWriteCallback);
-    
-    std::string response_data;
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response_data);
-    
-    if (method == "POST") {
-        curl_easy_setopt(curl, CURLOPT_POST, 1L);
-    } else if (method == "DELETE") {
-        curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "DELETE");
+        char signature[HmacSha256Signer::kHexLength];
+        if (!signer_.sign_hex(std::string_view(path).substr(query_start), signature)) {
+            LOG_ERROR_COMP("BINANCE", "Failed to sign request");
+            return "";
+        }
+        path.append("&signature=").append(signature, sizeof(signature));
+    } else if (!body.empty()) {
+        path.append(1, '?').append(body);
     }
     
-    // Add API key header
-    struct curl_slist* headers = nullptr;
-    std::string api_key_header = "X-MBX-APIKEY: " + config_.api_key;
-    headers = curl_slist_append(headers, api_key_header.c_str());
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-    
-    CURLcode res = curl_easy_perform(curl);
-    curl_slist_free_all(headers);
-    curl_easy_cleanup(curl);
-    
-    if (res != CURLE_OK) {
-        LOG_ERROR_COMP("BINANCE", "CURL error: " + std::string(curl_easy_strerror(res)));
+    HttpResponse response = http_pool_->perform(std::move(request), std::atomic_load(&rest_template_));
+    if (!response.error_message.empty()) {
+        LOG_ERROR_COMP("BINANCE", response.error_message);
         return "";
     }
     
-    return response_data;
+    return response.body;
 }
 
 std::string BinanceOMS::generate_signature(const std::string& data) {
-    unsigned char* digest = HMAC(EVP_sha256(), 
-                                 config_.api_secret.c_str(), config_.api_secret.length(),
-                                 (unsigned char*)data.c_str(), data.length(),
-                                 nullptr, nullptr);
-    
-    char md_string[65];
-    for (int i = 0; i < 32; i++) {
-        sprintf(&md_string[i*2], "%02x", (unsigned int)digest[i]);
+    char signature[HmacSha256Signer::kHexLength];
+    if (!signer_.sign_hex(data, signature)) {
+        return "";
     }
-    
-    return std::string(md_string);
+    return std::string(signature, sizeof(signature));
 }
 
 std::string BinanceOMS::create_auth_headers(const std::string& method, const std::string& endpoint, const std::string& body) {
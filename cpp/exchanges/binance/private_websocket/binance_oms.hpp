@@ -1,5 +1,7 @@
 #pragma once
 #include "../../i_exchange_oms.hpp"
+#include "../../../utils/http/hmac_signer.hpp"
+#include "../../../utils/http/http_connection_pool.hpp"
 #include <string>
 #include <vector>
 #include <map>
@@ -12,8 +14,6 @@
 #include <chrono>
 #include <functional>
 #include <cstdint>
-#include <openssl/hmac.h>
-#include <openssl/evp.h>
 
 namespace binance {
 
@@ -44,13 +44,19 @@ public:
     bool is_authenticated() const override;
 
     // Order management
-    bool cancel_order(const std::string& cl_ord_id, const std::string& exch_ord_id) override;
+    bool cancel_order(const std::string& cl_ord_id, const std::string& exch_ord_id,
+                      const std::string& symbol = "") override;
     bool replace_order(const std::string& cl_ord_id, const proto::OrderRequest& new_order) override;
     proto::OrderEvent get_order_status(const std::string& cl_ord_id, const std::string& exch_ord_id) override;
     
     // Specific order types
-    bool place_market_order(const std::string& symbol, const std::string& side, double quantity) override;
-    bool place_limit_order(const std::string& symbol, const std::string& side, double quantity, double price) override;
+    bool place_market_order(const std::string& symbol, const std::string& side, double quantity,
+                            const std::string& cl_ord_id = "") override;
+    bool place_limit_order(const std::string& symbol, const std::string& side, double quantity, double price,
+                           const std::string& cl_ord_id = "") override;
+    
+    // New orders and cancels go through /fapi/v1/batchOrders; replaces stay single
+    void submit_batch(const proto::OrderBatchRequest& batch, std::vector<bool>& results) override;
 
     // Real-time callbacks
     void set_order_status_callback(OrderStatusCallback callback) override;
@@ -65,6 +71,13 @@ private:
     OrderStatusCallback order_callback_;
     std::shared_ptr<websocket_transport::IWebSocketTransport> custom_transport_;
     
+    // Keep-alive REST client: shared connection pool, API-key header formatted once
+    std::shared_ptr<HttpConnectionPool> http_pool_;
+    std::shared_ptr<const HttpRequestTemplate> rest_template_;
+    HmacSha256Signer signer_;
+    
+    void rebuild_rest_template();
+    
     // HTTP client for API calls
     std::string make_request(const std::string& endpoint, const std::string& method = "GET", 
                             const std::string& body = "", bool is_signed = false);
@@ -80,6 +93,12 @@ private:
     // JSON parsing helpers
     proto::OrderEvent parse_order_from_json(const std::string& json_str);
     
+    // Batch helpers: one request per chunk, results written back by action index
+    void submit_new_orders(const proto::OrderBatchRequest& batch, const std::vector<int>& indices,
+                           std::vector<bool>& results);
+    void submit_cancels(const proto::OrderBatchRequest& batch, const std::vector<int>& indices,
+                        std::vector<bool>& results);
+    
     // Error handling
     std::string get_error_message(const std::string& response);
 };
@@ -1,5 +1,10 @@
 #include "binance_subscriber.hpp"
+#include "../http/binance_data_fetcher.hpp"
 #include "../../../utils/logging/logger.hpp"
+#include "../../../utils/logging/binary_logger.hpp"
+#include "../../../utils/app_service/thread_placement.hpp"
+#include "../../../utils/mds/parser_factory.hpp"
+#include "../../../utils/metrics/latency_trace.hpp"
 #include <sstream>
 #include <chrono>
 #include <thread>
@@ -7,13 +12,15 @@
 
 namespace binance {
 
-BinanceSubscriber::BinanceSubscriber(const BinanceSubscriberConfig& config) : config_(config) {
+BinanceSubscriber::BinanceSubscriber(const BinanceSubscriberConfig& config)
+    : config_(config), md_parser_(create_market_data_parser("BINANCE")) {
     logging::Logger logger("BINANCE_SUBSCRIBER");
     logger.info("Initializing Binance Subscriber");
 }
 
 BinanceSubscriber::~BinanceSubscriber() {
     disconnect();
+    stop_resync_worker();
 }
 
 bool BinanceSubscriber::connect() {
@@ -76,6 +83,10 @@ bool BinanceSubscriber::subscribe_orderbook(const std::string& symbol, int top_n
                " top_n: " + std::to_string(top_n) + 
                " frequency: " + std::to_string(frequency_ms) + "ms");
     
+    if (top_n > 0) {
+        publish_depth_.store(top_n);
+    }
+    
     // Add to subscribed symbols
     {
         std::lock_guard<std::mutex> lock(symbols_mutex_);
@@ -185,91 +196,135 @@ void BinanceSubscriber::websocket_loop() {
 }
 
 void BinanceSubscriber::handle_websocket_message(const std::string& message) {
-    logging::Logger logger("BINANCE_SUBSCRIBER");
+    uint64_t recv_ns = metrics::LatencyTrace::enabled() ? metrics::LatencyTrace::now_ns() : 0;
+    // Runs per message: Logger objects are only built on the error paths
+    std::lock_guard<std::mutex> lock(parse_mutex_);
     try {
-        Json::Value root;
-        Json::Reader reader;
-        
-        if (!reader.parse(message, root)) {
-            logger.error("Failed to parse WebSocket message");
+        if (!md_parser_->parse(message, parsed_)) {
+            logging::Logger("BINANCE_SUBSCRIBER").error("Failed to parse WebSocket message");
             return;
         }
+        trace_recv_ns_ = recv_ns;
+        trace_parsed_ns_ = recv_ns ? metrics::LatencyTrace::now_ns() : 0;
         
-        // Handle different message types
-        if (root.isMember("stream") && root.isMember("data")) {
-            std::string stream = root["stream"].asString();
-            Json::Value data = root["data"];
-            
-            if (stream.find("@depth") != std::string::npos) {
-                handle_orderbook_update(data);
-            } else if (stream.find("@trade") != std::string::npos) {
-                handle_trade_update(data);
-            }
-        } else if (root.isMember("method")) {
-            // Handle subscription responses
-            logger.debug("Subscription response: " + message);
+        switch (parsed_.type) {
+            case MdMessageType::BOOK_SNAPSHOT:
+                handle_depth_snapshot(parsed_);
+                break;
+            case MdMessageType::BOOK_DELTA:
+                handle_orderbook_update(parsed_);
+                break;
+            case MdMessageType::TRADE:
+                handle_trade_update(parsed_);
+                break;
+            case MdMessageType::CONTROL:
+                // Handle subscription responses
+                FAST_LOG_DEBUG("BINANCE_SUBSCRIBER", "Subscription response: {}", message);
+                break;
+            case MdMessageType::UNKNOWN:
+                break;
         }
         
     } catch (const std::exception& e) {
-        logger.error("Error handling WebSocket message: " + std::string(e.what()));
+        logging::Logger("BINANCE_SUBSCRIBER").error("Error handling WebSocket message: " + std::string(e.what()));
     }
 }
 
-void BinanceSubscriber::handle_orderbook_update(const Json::Value& orderbook_data) {
-    proto::OrderBookSnapshot orderbook;
-    orderbook.set_exch("binance");
-    orderbook.set_symbol(orderbook_data["s"].asString());
-    orderbook.set_timestamp_us(orderbook_data["E"].asUInt64()); // Keep as milliseconds
-    
-    // Parse bids
-    const Json::Value& bids = orderbook_data["b"];
-    if (bids.isArray()) {
-        for (const auto& bid : bids) {
-            proto::OrderBookLevel* level = orderbook.add_bids();
-            level->set_price(std::stod(bid[0].asString()));
-            level->set_qty(std::stod(bid[1].asString()));
+void BinanceSubscriber::handle_orderbook_update(const ParsedMarketData& update) {
+    // Diff depth stream: U/u bracket the update ids in this event, pu is the
+    // previous event's u (futures only). Levels carry absolute quantities.
+    LocalOrderBook& book = get_local_book(std::string(update.symbol));
+    
+    auto result = book.begin_update(update.first_id, update.last_id, update.prev_id);
+    
+    if (result != LocalOrderBook::UpdateResult::STALE) {
+        for (const auto& bid : update.bids) {
+            book.apply_level(LocalOrderBook::Side::BID, bid.price, bid.qty);
+        }
+        for (const auto& ask : update.asks) {
+            book.apply_level(LocalOrderBook::Side::ASK, ask.price, ask.qty);
         }
     }
+    book.end_update();
     
-    // Parse asks
-    const Json::Value& asks = orderbook_data["a"];
-    if (asks.isArray()) {
-        for (const auto& ask : asks) {
-            proto::OrderBookLevel* level = orderbook.add_asks();
-            level->set_price(std::stod(ask[0].asString()));
-            level->set_qty(std::stod(ask[1].asString()));
-        }
+    if (result == LocalOrderBook::UpdateResult::GAP) {
+        logging::Logger("BINANCE_SUBSCRIBER").warn("Sequence gap on " + book.symbol() + " at U=" +
+                                                   std::to_string(update.first_id) + " (last u=" +
+                                                   std::to_string(book.last_update_id()) + "), resyncing");
+    }
+    if (book.needs_resync()) {
+        book.resync();   // Throttled; diffs keep buffering until it bridges
     }
+    if (!book.is_synced() || result == LocalOrderBook::UpdateResult::STALE) {
+        return;
+    }
+    
+    proto::OrderBookSnapshot& orderbook = orderbook_msg_;
+    orderbook.Clear();
+    orderbook.set_exch("binance");
+    orderbook.set_symbol(book.symbol());
+    orderbook.set_timestamp_us(update.exchange_time); // Keep as milliseconds
+    book.write_snapshot(orderbook, static_cast<size_t>(publish_depth_.load()));
+    
+    metrics::LatencyTrace::stamp_market_data(orderbook, trace_recv_ns_, trace_parsed_ns_);
     
     if (orderbook_callback_) {
         orderbook_callback_(orderbook);
     }
     
-    logging::Logger logger("BINANCE_SUBSCRIBER");
-    logger.debug("Orderbook update: " + orderbook.symbol() + 
-                " bids: " + std::to_string(orderbook.bids_size()) + 
-                " asks: " + std::to_string(orderbook.asks_size()));
+    FAST_LOG_DEBUG("BINANCE_SUBSCRIBER", "Orderbook update: {} bids: {} asks: {}",
+                   orderbook.symbol(), orderbook.bids_size(), orderbook.asks_size());
 }
 
-void BinanceSubscriber::handle_trade_update(const Json::Value& trade_data) {
-    proto::Trade trade;
-    trade.set_exch("BINANCE");
-    trade.set_symbol(trade_data["s"].asString());
-    trade.set_price(std::stod(trade_data["p"].asString()));
-    trade.set_qty(std::stod(trade_data["q"].asString()));
-    trade.set_is_buyer_maker(trade_data["m"].asBool());
-    trade.set_trade_id(trade_data["t"].asString());
-    trade.set_timestamp_us(trade_data["T"].asUInt64() * 1000); // Convert to microseconds
+void BinanceSubscriber::handle_depth_snapshot(const ParsedMarketData& snapshot) {
+    // Partial depth stream (<symbol>@depth<N>): every event is a full top-N book
+    proto::OrderBookSnapshot& orderbook = orderbook_msg_;
+    orderbook.Clear();
+    orderbook.set_exch("binance");
+    orderbook.set_symbol(snapshot.symbol.data(), snapshot.symbol.size());
+    orderbook.set_timestamp_us(snapshot.exchange_time); // Keep as milliseconds
     
-    if (trade_callback_) {
-        trade_callback_(trade);
+    for (const auto& bid : snapshot.bids) {
+        proto::OrderBookLevel* level = orderbook.add_bids();
+        level->set_price(bid.price);
+        level->set_qty(bid.qty);
+    }
+    for (const auto& ask : snapshot.asks) {
+        proto::OrderBookLevel* level = orderbook.add_asks();
+        level->set_price(ask.price);
+        level->set_qty(ask.qty);
     }
     
-    logging::Logger logger("BINANCE_SUBSCRIBER");
-    std::stringstream ss;
-    ss << "Trade update: " << trade.symbol() << " " << trade.qty() << "@" << trade.price() 
-       << " side: " << (trade.is_buyer_maker() ? "SELL" : "BUY");
-    logger.debug(ss.str());
+    metrics::LatencyTrace::stamp_market_data(orderbook, trace_recv_ns_, trace_parsed_ns_);
+    
+    if (orderbook_callback_) {
+        orderbook_callback_(orderbook);
+    }
+    
+    FAST_LOG_DEBUG("BINANCE_SUBSCRIBER", "Orderbook snapshot: {} bids: {} asks: {}",
+                   orderbook.symbol(), orderbook.bids_size(), orderbook.asks_size());
+}
+
+void BinanceSubscriber::handle_trade_update(const ParsedMarketData& trades) {
+    for (const auto& parsed : trades.trades) {
+        proto::Trade& trade = trade_msg_;
+        trade.Clear();
+        trade.set_exch("BINANCE");
+        trade.set_symbol(trades.symbol.data(), trades.symbol.size());
+        trade.set_price(parsed.price);
+        trade.set_qty(parsed.qty);
+        trade.set_is_buyer_maker(parsed.is_buyer_maker);
+        trade.set_trade_id(std::to_string(parsed.trade_seq));
+        trade.set_timestamp_us(parsed.exchange_time * 1000); // Convert to microseconds
+        
+        if (trade_callback_) {
+            metrics::LatencyTrace::stamp_market_data(trade, trace_recv_ns_, trace_parsed_ns_);
+            trade_callback_(trade);
+        }
+        
+        FAST_LOG_DEBUG("BINANCE_SUBSCRIBER", "Trade update: {} {}@{} side: {}",
+                       trade.symbol(), trade.qty(), trade.price(), trade.is_buyer_maker() ? "SELL" : "BUY");
+    }
 }
 
 std::string BinanceSubscriber::create_subscription_message(const std::string& symbol, const std::string& channel) {
@@ -320,6 +375,95 @@ std::string BinanceSubscriber::convert_symbol_to_binance(const std::string& symb
     return binance_symbol;
 }
 
+LocalOrderBook& BinanceSubscriber::get_local_book(const std::string& symbol) {
+    auto it = local_books_.find(symbol);
+    if (it != local_books_.end()) {
+        return *it->second;
+    }
+    
+    auto book = std::make_unique<LocalOrderBook>(symbol);
+    book->set_resync_handler([this](LocalOrderBook& target) { return resync_local_book(target); });
+    return *local_books_.emplace(symbol, std::move(book)).first->second;
+}
+
+bool BinanceSubscriber::resync_local_book(LocalOrderBook& book) {
+    // Called on the message thread: queue the REST request instead of stalling
+    // the stream on it. The book buffers diffs until the snapshot is installed.
+    if (!data_fetcher_) {
+        // Depth snapshots are public; no credentials needed
+        data_fetcher_ = std::make_shared<BinanceDataFetcher>("", "");
+    }
+    
+    std::lock_guard<std::mutex> lock(resync_mutex_);
+    if (!resync_pending_.insert(book.symbol()).second) {
+        return true;   // Already on its way
+    }
+    resync_queue_.push_back(book.symbol());
+    if (!resync_running_) {
+        resync_running_ = true;
+        resync_thread_ = std::thread(&BinanceSubscriber::resync_worker, this);
+    }
+    resync_cv_.notify_one();
+    return true;
+}
+
+void BinanceSubscriber::resync_worker() {
+    // Spawned from the market data thread; placed on its own so the REST round trip stays off that core
+    app_service::ThreadPlacement::instance().place_current_thread("binance_resync");
+    logging::Logger logger("BINANCE_SUBSCRIBER");
+    std::unique_lock<std::mutex> lock(resync_mutex_);
+    while (true) {
+        resync_cv_.wait(lock, [this] { return !resync_running_ || !resync_queue_.empty(); });
+        if (!resync_running_) {
+            break;
+        }
+        std::string symbol = std::move(resync_queue_.front());
+        resync_queue_.pop_front();
+        lock.unlock();
+        
+        proto::OrderBookSnapshot snapshot;
+        uint64_t last_update_id = 0;
+        if (!data_fetcher_->get_orderbook_snapshot(symbol, config_.snapshot_depth, snapshot, last_update_id)) {
+            // The next diff on an unsynced book asks again, rate-limited by the book
+            logger.error("Depth snapshot request failed for " + symbol);
+        } else {
+            std::lock_guard<std::mutex> parse_lock(parse_mutex_);
+            auto it = local_books_.find(symbol);
+            if (it != local_books_.end()) {
+                LocalOrderBook& book = *it->second;
+                book.begin_snapshot(last_update_id);
+                for (const auto& level : snapshot.bids()) {
+                    book.add_snapshot_level(LocalOrderBook::Side::BID, level.price(), level.qty());
+                }
+                for (const auto& level : snapshot.asks()) {
+                    book.add_snapshot_level(LocalOrderBook::Side::ASK, level.price(), level.qty());
+                }
+                bool synced = book.end_snapshot();
+                logger.info("Local book " + symbol + (synced ? " synced" : " not bridged") +
+                            " at lastUpdateId=" + std::to_string(last_update_id));
+            }
+        }
+        
+        lock.lock();
+        resync_pending_.erase(symbol);
+    }
+}
+
+void BinanceSubscriber::stop_resync_worker() {
+    std::thread worker;
+    {
+        std::lock_guard<std::mutex> lock(resync_mutex_);
+        resync_running_ = false;
+        resync_queue_.clear();
+        resync_pending_.clear();
+        worker = std::move(resync_thread_);
+    }
+    resync_cv_.notify_all();
+    if (worker.joinable()) {
+        worker.join();   // Waits out a request already in flight
+    }
+}
+
 void BinanceSubscriber::set_websocket_transport(std::unique_ptr<websocket_transport::IWebSocketTransport> transport) {
     logging::Logger logger("BINANCE_SUBSCRIBER");
     logger.debug("Setting custom WebSocket transport for testing");
@@ -337,27 +481,9 @@ void BinanceSubscriber::start() {
     
     // Set up message callback to handle incoming messages
     custom_transport_->set_message_callback([this](const websocket_transport::WebSocketMessage& message) {
-        logging::Logger callback_logger("BINANCE_SUBSCRIBER");
-        callback_logger.debug("Received message: " + message.data);
+        FAST_LOG_DEBUG("BINANCE_SUBSCRIBER", "Received message: {}", message.data);
         
-        // Parse the message and call appropriate handlers
-        Json::Value root;
-        Json::Reader reader;
-        
-        if (reader.parse(message.data, root)) {
-            if (root.isMember("stream") && root.isMember("data")) {
-                // This is a stream message
-                const Json::Value& data = root["data"];
-                if (data.isMember("e")) {
-                    std::string event_type = data["e"].asString();
-                    if (event_type == "depthUpdate") {
-                        handle_orderbook_update(data);
-                    } else if (event_type == "trade") {
-                        handle_trade_update(data);
-                    }
-                }
-            }
-        }
+        handle_websocket_message(message.data);
     });
     
     // Connect if not already connected
@@ -370,6 +496,7 @@ void BinanceSubscriber::stop() {
     logging::Logger logger("BINANCE_SUBSCRIBER");
     logger.info("Stopping subscriber");
     disconnect();
+    stop_resync_worker();
 }
 
 void BinanceSubscriber::set_error_callback(std::function<void(const std::string&)> callback) {
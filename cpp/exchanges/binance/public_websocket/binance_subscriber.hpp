@@ -1,12 +1,19 @@
 #pragma once
 #include "../../i_exchange_subscriber.hpp"
+#include "../../i_exchange_data_fetcher.hpp"
 #include "../../../proto/market_data.pb.h"
+#include "../../../utils/mds/local_order_book.hpp"
+#include "../../../utils/mds/market_data_parser.hpp"
 #include <string>
 #include <memory>
 #include <atomic>
 #include <thread>
 #include <mutex>
+#include <condition_variable>
+#include <deque>
 #include <functional>
+#include <unordered_map>
+#include <unordered_set>
 #include <json/json.h>
 
 namespace binance {
@@ -17,6 +24,7 @@ struct BinanceSubscriberConfig {
     std::string asset_type{"futures"};
     int timeout_ms{30000};
     int max_retries{3};
+    int snapshot_depth{1000};  // REST depth used to (re)build local books from the diff stream
 };
 
 class BinanceSubscriber : public IExchangeSubscriber {
@@ -43,6 +51,9 @@ public:
     
     // Testing interface - inject custom WebSocket transport
     void set_websocket_transport(std::unique_ptr<websocket_transport::IWebSocketTransport> transport) override;
+    
+    // REST source for local book resyncs (defaults to a public BinanceDataFetcher)
+    void set_data_fetcher(std::shared_ptr<IExchangeDataFetcher> fetcher) { data_fetcher_ = std::move(fetcher); }
 
 private:
     BinanceSubscriberConfig config_;
@@ -66,11 +77,37 @@ private:
     std::vector<std::string> subscribed_symbols_;
     std::mutex symbols_mutex_;
     
+    // Local books rebuilt from the diff depth stream; guarded by parse_mutex_
+    // (the message thread and the resync worker)
+    std::unordered_map<std::string, std::unique_ptr<LocalOrderBook>> local_books_;
+    std::shared_ptr<IExchangeDataFetcher> data_fetcher_;
+    std::atomic<int> publish_depth_{20};
+    
+    // REST depth snapshots are fetched off the message thread; diffs keep
+    // buffering in the book until the worker installs the snapshot
+    std::thread resync_thread_;
+    std::mutex resync_mutex_;
+    std::condition_variable resync_cv_;
+    std::deque<std::string> resync_queue_;
+    std::unordered_set<std::string> resync_pending_;   // Queued or being fetched
+    bool resync_running_{false};                      // Under resync_mutex_
+    
+    // Zero-allocation parse path; the parser, its output and the outgoing
+    // messages are reused for every message under parse_mutex_
+    std::unique_ptr<IMarketDataParser> md_parser_;
+    ParsedMarketData parsed_;
+    proto::OrderBookSnapshot orderbook_msg_;
+    proto::Trade trade_msg_;
+    std::mutex parse_mutex_;
+    uint64_t trace_recv_ns_{0};     // Latency trace stamps for the message in hand (0 when tracing is off)
+    uint64_t trace_parsed_ns_{0};
+    
     // Message handling
     void websocket_loop();
     void handle_websocket_message(const std::string& message);
-    void handle_orderbook_update(const Json::Value& orderbook_data);
-    void handle_trade_update(const Json::Value& trade_data);
+    void handle_orderbook_update(const ParsedMarketData& update);
+    void handle_depth_snapshot(const ParsedMarketData& snapshot);
+    void handle_trade_update(const ParsedMarketData& trades);
     
     // Subscription management
     std::string create_subscription_message(const std::string& symbol, const std::string& channel);
@@ -79,6 +116,12 @@ private:
     // Utility methods
     std::string generate_request_id();
     std::string convert_symbol_to_binance(const std::string& symbol);
+    
+    // Local order book maintenance
+    LocalOrderBook& get_local_book(const std::string& symbol);
+    bool resync_local_book(LocalOrderBook& book);
+    void resync_worker();
+    void stop_resync_worker();
 };
 
 } // namespace binance
@@ -124,7 +124,7 @@ bool DeribitOMS::is_authenticated() const {
     return authenticated_.load();
 }
 
-bool DeribitOMS::cancel_order(const std::string& cl_ord_id, const std::string& exch_ord_id) {
+bool DeribitOMS::cancel_order(const std::string& cl_ord_id, const std::string& exch_ord_id, const std::string&) {
     if (!is_connected() || !is_authenticated()) {
         LOG_ERROR_COMP("DERIBIT_OMS", "Not connected or authenticated");
         return false;
@@ -166,13 +166,14 @@ proto::OrderEvent DeribitOMS::get_order_status(const std::string& cl_ord_id, con
     return order_event;
 }
 
-bool DeribitOMS::place_market_order(const std::string& symbol, const std::string& side, double quantity) {
+bool DeribitOMS::place_market_order(const std::string& symbol, const std::string& side, double quantity,
+                                 const std::string& cl_ord_id) {
     if (!is_connected() || !is_authenticated()) {
         LOG_ERROR_COMP("DERIBIT_OMS", "Not connected or authenticated");
         return false;
     }
     
-    std::string order_msg = create_order_message(symbol, side, quantity, 0.0, "MARKET");
+    std::string order_msg = create_order_message(symbol, side, quantity, 0.0, "MARKET", cl_ord_id);
     LOG_DEBUG_COMP("DERIBIT_OMS", "Sending market order: " + order_msg);
     
     // Note: Order messages are handled by the mock transport's automatic replay
@@ -181,13 +182,14 @@ bool DeribitOMS::place_market_order(const std::string& symbol, const std::string
     return true;
 }
 
-bool DeribitOMS::place_limit_order(const std::string& symbol, const std::string& side, double quantity, double price) {
+bool DeribitOMS::place_limit_order(const std::string& symbol, const std::string& side, double quantity, double price,
+                                const std::string& cl_ord_id) {
     if (!is_connected() || !is_authenticated()) {
         LOG_ERROR_COMP("DERIBIT_OMS", "Not connected or authenticated");
         return false;
     }
     
-    std::string order_msg = create_order_message(symbol, side, quantity, price, "LIMIT");
+    std::string order_msg = create_order_message(symbol, side, quantity, price, "LIMIT", cl_ord_id);
     LOG_DEBUG_COMP("DERIBIT_OMS", "Sending limit order: " + order_msg);
     
     // Note: Order messages are handled by the mock transport's automatic replay
@@ -323,6 +325,9 @@ void DeribitOMS::handle_order_update(const Json::Value& order_data) {
         order_event.set_exch_order_id(order_data["order_id"].asString());
         order_event.set_cl_ord_id(order_data["order_id"].asString()); // Use exchange order ID as client order ID if not provided
     }
+    if (order_data.isMember("label") && !order_data["label"].asString().empty()) {
+        order_event.set_cl_ord_id(order_data["label"].asString());
+    }
     
     order_event.set_exch("DERIBIT");
     
@@ -362,7 +367,8 @@ void DeribitOMS::handle_trade_update(const Json::Value& trade_data) {
 }
 
 std::string DeribitOMS::create_order_message(const std::string& symbol, const std::string& side, 
-                                            double quantity, double price, const std::string& order_type) {
+                                            double quantity, double price, const std::string& order_type,
+                                            const std::string& cl_ord_id) {
     Json::Value root;
     root["jsonrpc"] = "2.0";
     root["id"] = static_cast<int>(request_id_++);
@@ -385,6 +391,9 @@ std::string DeribitOMS::create_order_message(const std::string& symbol, const st
     }
     
     params["time_in_force"] = "good_til_cancelled";
+    if (!cl_ord_id.empty()) {
+        params["label"] = cl_ord_id;  // Deribit's client order id
+    }
     
     root["params"] = params;
     
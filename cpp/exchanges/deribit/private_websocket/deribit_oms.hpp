@@ -45,13 +45,16 @@ public:
     bool is_authenticated() const override;
     
     // Order management (via WebSocket)
-    bool cancel_order(const std::string& cl_ord_id, const std::string& exch_ord_id) override;
+    bool cancel_order(const std::string& cl_ord_id, const std::string& exch_ord_id,
+                      const std::string& symbol = "") override;
     bool replace_order(const std::string& cl_ord_id, const proto::OrderRequest& new_order) override;
     proto::OrderEvent get_order_status(const std::string& cl_ord_id, const std::string& exch_ord_id) override;
     
     // Specific order types (via WebSocket)
-    bool place_market_order(const std::string& symbol, const std::string& side, double quantity) override;
-    bool place_limit_order(const std::string& symbol, const std::string& side, double quantity, double price) override;
+    bool place_market_order(const std::string& symbol, const std::string& side, double quantity,
+                            const std::string& cl_ord_id = "") override;
+    bool place_limit_order(const std::string& symbol, const std::string& side, double quantity, double price,
+                           const std::string& cl_ord_id = "") override;
     
     // Real-time callbacks
     void set_order_status_callback(OrderStatusCallback callback) override;
@@ -62,7 +65,8 @@ public:
     // Testing helpers (exposed for integration tests)
     void handle_websocket_message(const std::string& message);  // Made public for testing
     std::string create_order_message(const std::string& symbol, const std::string& side, 
-                                   double quantity, double price, const std::string& order_type);  // Made public for testing
+                                   double quantity, double price, const std::string& order_type,
+                                     const std::string& cl_ord_id = "");  // Made public for testing
     std::string create_cancel_message(const std::string& cl_ord_id, const std::string& exch_ord_id);  // Made public for testing
 
 private:
@@ -1,5 +1,8 @@
 #include "deribit_subscriber.hpp"
 #include "../../../utils/logging/log_helper.hpp"
+#include "../../../utils/logging/binary_logger.hpp"
+#include "../../../utils/mds/parser_factory.hpp"
+#include "../../../utils/metrics/latency_trace.hpp"
 #include <sstream>
 #include <chrono>
 #include <thread>
@@ -8,7 +11,8 @@
 
 namespace deribit {
 
-DeribitSubscriber::DeribitSubscriber(const DeribitSubscriberConfig& config) : config_(config) {
+DeribitSubscriber::DeribitSubscriber(const DeribitSubscriberConfig& config)
+    : config_(config), md_parser_(create_market_data_parser("DERIBIT")) {
     LOG_INFO_COMP("DERIBIT_SUBSCRIBER", "Initializing Deribit Subscriber");
 }
 
@@ -228,47 +232,41 @@ void DeribitSubscriber::websocket_loop() {
 }
 
 void DeribitSubscriber::handle_websocket_message(const std::string& message) {
+    uint64_t recv_ns = metrics::LatencyTrace::enabled() ? metrics::LatencyTrace::now_ns() : 0;
+    std::lock_guard<std::mutex> lock(parse_mutex_);
     try {
-        Json::Value root;
-        Json::Reader reader;
-        
-        if (!reader.parse(message, root)) {
+        if (!md_parser_->parse(message, parsed_)) {
             LOG_ERROR_COMP("DERIBIT_SUBSCRIBER", "Failed to parse WebSocket message");
             return;
         }
+        trace_recv_ns_ = recv_ns;
+        trace_parsed_ns_ = recv_ns ? metrics::LatencyTrace::now_ns() : 0;
         
-        // Handle different message types
-        if (root.isMember("method")) {
-            std::string method = root["method"].asString();
-            
-            if (method == "subscription" && root.isMember("params")) {
-                Json::Value params = root["params"];
-                std::string channel = params["channel"].asString();
-                
-                // Extract symbol from channel (e.g., "book.BTC-PERPETUAL.raw" -> "BTC-PERPETUAL")
-                std::string symbol;
-                size_t first_dot = channel.find('.');
-                size_t second_dot = channel.find('.', first_dot + 1);
-                if (first_dot != std::string::npos && second_dot != std::string::npos) {
-                    symbol = channel.substr(first_dot + 1, second_dot - first_dot - 1);
-                }
-                
-                if (channel.find("book.") == 0 && params.isMember("data")) {
-                    handle_orderbook_update(params["data"], symbol);
-                } else if (channel.find("trades.") == 0 && params.isMember("data")) {
-                    handle_trade_update(params["data"], symbol);
+        // Subscription notifications: symbol comes from the channel
+        // (e.g., "book.BTC-PERPETUAL.raw" -> "BTC-PERPETUAL")
+        switch (parsed_.type) {
+            case MdMessageType::BOOK_SNAPSHOT:
+            case MdMessageType::BOOK_DELTA:
+                handle_orderbook_update(parsed_);
+                break;
+            case MdMessageType::TRADE:
+                handle_trade_update(parsed_);
+                break;
+            case MdMessageType::CONTROL:
+                if (parsed_.is_error) {
+                    // Handle errors
+                    std::string error_msg = "Deribit API error: " + message;
+                    LOG_ERROR_COMP("DERIBIT_SUBSCRIBER", error_msg);
+                    if (error_callback_) {
+                        error_callback_(error_msg);
+                    }
+                } else {
+                    // Handle subscription responses
+                    LOG_INFO_COMP("DERIBIT_SUBSCRIBER", "Subscription response: " + message);
                 }
-            }
-        } else if (root.isMember("result")) {
-            // Handle subscription responses
-            LOG_INFO_COMP("DERIBIT_SUBSCRIBER", "Subscription response: " + message);
-        } else if (root.isMember("error")) {
-            // Handle errors
-            std::string error_msg = "Deribit API error: " + root["error"].toStyledString();
-            LOG_ERROR_COMP("DERIBIT_SUBSCRIBER", error_msg);
-            if (error_callback_) {
-                error_callback_(error_msg);
-            }
+                break;
+            case MdMessageType::UNKNOWN:
+                break;
         }
         
     } catch (const std::exception& e) {
@@ -279,130 +277,82 @@ void DeribitSubscriber::handle_websocket_message(const std::string& message) {
     }
 }
 
-void DeribitSubscriber::handle_orderbook_update(const Json::Value& orderbook_data, const std::string& symbol) {
-    proto::OrderBookSnapshot orderbook;
+void DeribitSubscriber::handle_orderbook_update(const ParsedMarketData& book) {
+    proto::OrderBookSnapshot& orderbook = orderbook_msg_;
+    orderbook.Clear();
     orderbook.set_exch("DERIBIT");
-    orderbook.set_symbol(symbol.empty() ? "BTC-PERPETUAL" : symbol);
+    if (book.symbol.empty()) {
+        orderbook.set_symbol("BTC-PERPETUAL");
+    } else {
+        orderbook.set_symbol(book.symbol.data(), book.symbol.size());
+    }
     
     // Deribit orderbook format: {"bids":[[price,qty],...],"asks":[[price,qty],...],"timestamp":...,"change_id":...}
-    if (orderbook_data.isMember("timestamp")) {
+    if (book.exchange_time != 0) {
         // Deribit timestamp is in milliseconds
-        orderbook.set_timestamp_us(orderbook_data["timestamp"].asUInt64() * 1000); // Convert to microseconds
+        orderbook.set_timestamp_us(book.exchange_time * 1000); // Convert to microseconds
     } else {
         orderbook.set_timestamp_us(std::chrono::duration_cast<std::chrono::microseconds>(
             std::chrono::system_clock::now().time_since_epoch()).count());
     }
     
-    // Parse bids
-    if (orderbook_data.isMember("bids") && orderbook_data["bids"].isArray()) {
-        const Json::Value& bids = orderbook_data["bids"];
-        for (const auto& bid : bids) {
-            if (bid.isArray() && bid.size() >= 2) {
-                proto::OrderBookLevel* level = orderbook.add_bids();
-                // Handle both string and numeric values
-                if (bid[0].isString()) {
-                    level->set_price(std::stod(bid[0].asString()));
-                } else {
-                    level->set_price(bid[0].asDouble());
-                }
-                if (bid[1].isString()) {
-                    level->set_qty(std::stod(bid[1].asString()));
-                } else {
-                    level->set_qty(bid[1].asDouble());
-                }
-            }
-        }
+    for (const auto& bid : book.bids) {
+        proto::OrderBookLevel* level = orderbook.add_bids();
+        level->set_price(bid.price);
+        level->set_qty(bid.qty);
     }
-    
-    // Parse asks
-    if (orderbook_data.isMember("asks") && orderbook_data["asks"].isArray()) {
-        const Json::Value& asks = orderbook_data["asks"];
-        for (const auto& ask : asks) {
-            if (ask.isArray() && ask.size() >= 2) {
-                proto::OrderBookLevel* level = orderbook.add_asks();
-                // Handle both string and numeric values
-                if (ask[0].isString()) {
-                    level->set_price(std::stod(ask[0].asString()));
-                } else {
-                    level->set_price(ask[0].asDouble());
-                }
-                if (ask[1].isString()) {
-                    level->set_qty(std::stod(ask[1].asString()));
-                } else {
-                    level->set_qty(ask[1].asDouble());
-                }
-            }
-        }
+    for (const auto& ask : book.asks) {
+        proto::OrderBookLevel* level = orderbook.add_asks();
+        level->set_price(ask.price);
+        level->set_qty(ask.qty);
     }
     
+    metrics::LatencyTrace::stamp_market_data(orderbook, trace_recv_ns_, trace_parsed_ns_);
+    
     if (orderbook_callback_) {
         orderbook_callback_(orderbook);
     }
     
-    std::string log_msg = "Orderbook update: " + orderbook.symbol() + 
-                          " bids: " + std::to_string(orderbook.bids_size()) + 
-                          " asks: " + std::to_string(orderbook.asks_size());
-    LOG_INFO_COMP("DERIBIT_SUBSCRIBER", log_msg);
+    FAST_LOG_DEBUG("DERIBIT_SUBSCRIBER", "Orderbook update: {} bids: {} asks: {}",
+                   orderbook.symbol(), orderbook.bids_size(), orderbook.asks_size());
 }
 
-void DeribitSubscriber::handle_trade_update(const Json::Value& trade_data, const std::string& symbol) {
+void DeribitSubscriber::handle_trade_update(const ParsedMarketData& trades) {
     // Deribit trades format: array of trade objects or single trade object
-    Json::Value trades_array;
-    if (trade_data.isArray()) {
-        trades_array = trade_data;
-    } else {
-        trades_array.append(trade_data);
-    }
-    
-    for (const auto& trade_obj : trades_array) {
-        proto::Trade trade;
+    for (const auto& parsed : trades.trades) {
+        proto::Trade& trade = trade_msg_;
+        trade.Clear();
         trade.set_exch("DERIBIT");
-        trade.set_symbol(symbol.empty() ? "BTC-PERPETUAL" : symbol);
-        
-        // Handle both string and numeric values
-        if (trade_obj.isMember("price")) {
-            if (trade_obj["price"].isString()) {
-                trade.set_price(std::stod(trade_obj["price"].asString()));
-            } else {
-                trade.set_price(trade_obj["price"].asDouble());
-            }
-        }
-        
-        if (trade_obj.isMember("amount")) {
-            if (trade_obj["amount"].isString()) {
-                trade.set_qty(std::stod(trade_obj["amount"].asString()));
-            } else {
-                trade.set_qty(trade_obj["amount"].asDouble());
-            }
-        }
-        
-        if (trade_obj.isMember("direction")) {
-            std::string direction = trade_obj["direction"].asString();
-            trade.set_is_buyer_maker(direction == "sell"); // If direction is "sell", buyer is maker
+        if (trades.symbol.empty()) {
+            trade.set_symbol("BTC-PERPETUAL");
+        } else {
+            trade.set_symbol(trades.symbol.data(), trades.symbol.size());
         }
+        trade.set_price(parsed.price);
+        trade.set_qty(parsed.qty);
+        trade.set_is_buyer_maker(parsed.is_buyer_maker); // If direction is "sell", buyer is maker
         
-        if (trade_obj.isMember("trade_id")) {
-            trade.set_trade_id(trade_obj["trade_id"].asString());
-        } else if (trade_obj.isMember("trade_seq")) {
-            trade.set_trade_id("trade_" + std::to_string(trade_obj["trade_seq"].asUInt64()));
+        if (!parsed.trade_id.empty()) {
+            trade.set_trade_id(parsed.trade_id.data(), parsed.trade_id.size());
+        } else if (parsed.trade_seq != 0) {
+            trade.set_trade_id("trade_" + std::to_string(parsed.trade_seq));
         }
         
-        if (trade_obj.isMember("timestamp")) {
+        if (parsed.exchange_time != 0) {
             // Deribit timestamp is in milliseconds
-            trade.set_timestamp_us(trade_obj["timestamp"].asUInt64() * 1000); // Convert to microseconds
+            trade.set_timestamp_us(parsed.exchange_time * 1000); // Convert to microseconds
         } else {
             trade.set_timestamp_us(std::chrono::duration_cast<std::chrono::microseconds>(
                 std::chrono::system_clock::now().time_since_epoch()).count());
         }
         
         if (trade_callback_) {
+            metrics::LatencyTrace::stamp_market_data(trade, trace_recv_ns_, trace_parsed_ns_);
             trade_callback_(trade);
         }
         
-        std::string log_msg = "Trade update: " + trade.symbol() + 
-                              " " + std::to_string(trade.qty()) + "@" + std::to_string(trade.price()) + 
-                              " side: " + (trade.is_buyer_maker() ? "SELL" : "BUY");
-        LOG_INFO_COMP("DERIBIT_SUBSCRIBER", log_msg);
+        FAST_LOG_DEBUG("DERIBIT_SUBSCRIBER", "Trade update: {} {}@{} side: {}",
+                       trade.symbol(), trade.qty(), trade.price(), trade.is_buyer_maker() ? "SELL" : "BUY");
     }
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 #include "../../i_exchange_subscriber.hpp"
 #include "../../../proto/market_data.pb.h"
+#include "../../../utils/mds/market_data_parser.hpp"
 #include <string>
 #include <memory>
 #include <atomic>
@@ -76,10 +77,20 @@ private:
     TradeCallback trade_callback_;
     std::function<void(const std::string&)> error_callback_;
     
+    // Zero-allocation parse path; the parser, its output and the outgoing
+    // messages are reused for every message under parse_mutex_
+    std::unique_ptr<IMarketDataParser> md_parser_;
+    ParsedMarketData parsed_;
+    proto::OrderBookSnapshot orderbook_msg_;
+    proto::Trade trade_msg_;
+    std::mutex parse_mutex_;
+    uint64_t trace_recv_ns_{0};     // Latency trace stamps for the message in hand (0 when tracing is off)
+    uint64_t trace_parsed_ns_{0};
+    
     // Message handling
     void websocket_loop();
-    void handle_orderbook_update(const Json::Value& orderbook_data, const std::string& symbol);
-    void handle_trade_update(const Json::Value& trade_data, const std::string& symbol);
+    void handle_orderbook_update(const ParsedMarketData& book);
+    void handle_trade_update(const ParsedMarketData& trades);
     
     // Utility methods
     std::string generate_request_id();
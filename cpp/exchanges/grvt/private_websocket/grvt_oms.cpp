@@ -106,7 +106,7 @@ bool GrvtOMS::is_authenticated() const {
     return authenticated_.load();
 }
 
-bool GrvtOMS::cancel_order(const std::string& cl_ord_id, const std::string& exch_ord_id) {
+bool GrvtOMS::cancel_order(const std::string& cl_ord_id, const std::string& exch_ord_id, const std::string&) {
     if (!is_connected() || !is_authenticated()) {
         LOG_ERROR_COMP("GRVT_OMS", "Not connected or authenticated");
         return false;
@@ -148,13 +148,14 @@ proto::OrderEvent GrvtOMS::get_order_status(const std::string& cl_ord_id, const
     return order_event;
 }
 
-bool GrvtOMS::place_market_order(const std::string& symbol, const std::string& side, double quantity) {
+bool GrvtOMS::place_market_order(const std::string& symbol, const std::string& side, double quantity,
+                                 const std::string& cl_ord_id) {
     if (!is_connected() || !is_authenticated()) {
         LOG_ERROR_COMP("GRVT_OMS", "Not connected or authenticated");
         return false;
     }
     
-    std::string order_msg = create_order_message(symbol, side, quantity, 0.0, "MARKET");
+    std::string order_msg = create_order_message(symbol, side, quantity, 0.0, "MARKET", cl_ord_id);
     LOG_DEBUG_COMP("GRVT_OMS", "Sending market order: " + order_msg);
     
     // Mock WebSocket send
@@ -164,13 +165,14 @@ bool GrvtOMS::place_market_order(const std::string& symbol, const std::string& s
     return true;
 }
 
-bool GrvtOMS::place_limit_order(const std::string& symbol, const std::string& side, double quantity, double price) {
+bool GrvtOMS::place_limit_order(const std::string& symbol, const std::string& side, double quantity, double price,
+                                const std::string& cl_ord_id) {
     if (!is_connected() || !is_authenticated()) {
         LOG_ERROR_COMP("GRVT_OMS", "Not connected or authenticated");
         return false;
     }
     
-    std::string order_msg = create_order_message(symbol, side, quantity, price, "LIMIT");
+    std::string order_msg = create_order_message(symbol, side, quantity, price, "LIMIT", cl_ord_id);
     LOG_DEBUG_COMP("GRVT_OMS", "Sending limit order: " + order_msg);
     
     // Mock WebSocket send
@@ -239,7 +241,9 @@ void GrvtOMS::handle_websocket_message(const std::string& message) {
 
 void GrvtOMS::handle_order_update(const Json::Value& order_data) {
     proto::OrderEvent order_event;
-    order_event.set_cl_ord_id(order_data["orderId"].asString());
+    // Orders placed with a client id report it back; older ones only carry the venue id
+    order_event.set_cl_ord_id(order_data.isMember("clientOrderId") ? order_data["clientOrderId"].asString()
+                                                                   : order_data["orderId"].asString());
     order_event.set_exch("GRVT");
     order_event.set_symbol(order_data["symbol"].asString());
     order_event.set_exch_order_id(order_data["orderId"].asString());
@@ -262,7 +266,8 @@ void GrvtOMS::handle_trade_update(const Json::Value& trade_data) {
 }
 
 std::string GrvtOMS::create_order_message(const std::string& symbol, const std::string& side, 
-                                        double quantity, double price, const std::string& order_type) {
+                                        double quantity, double price, const std::string& order_type,
+                                        const std::string& cl_ord_id) {
     Json::Value root;
     root["jsonrpc"] = "2.0";
     root["id"] = generate_request_id();
@@ -277,6 +282,9 @@ std::string GrvtOMS::create_order_message(const std::string& symbol, const std::
         params["price"] = price;
     }
     params["timeInForce"] = "GTC";
+    if (!cl_ord_id.empty()) {
+        params["clientOrderId"] = cl_ord_id;
+    }
     
     root["params"] = params;
     
@@ -38,13 +38,16 @@ public:
     bool is_authenticated() const override;
     
     // Order management (via WebSocket)
-    bool cancel_order(const std::string& cl_ord_id, const std::string& exch_ord_id) override;
+    bool cancel_order(const std::string& cl_ord_id, const std::string& exch_ord_id,
+                      const std::string& symbol = "") override;
     bool replace_order(const std::string& cl_ord_id, const proto::OrderRequest& new_order) override;
     proto::OrderEvent get_order_status(const std::string& cl_ord_id, const std::string& exch_ord_id) override;
     
     // Specific order types (via WebSocket)
-    bool place_market_order(const std::string& symbol, const std::string& side, double quantity) override;
-    bool place_limit_order(const std::string& symbol, const std::string& side, double quantity, double price) override;
+    bool place_market_order(const std::string& symbol, const std::string& side, double quantity,
+                            const std::string& cl_ord_id = "") override;
+    bool place_limit_order(const std::string& symbol, const std::string& side, double quantity, double price,
+                           const std::string& cl_ord_id = "") override;
     
     // Real-time callbacks
     void set_order_status_callback(OrderStatusCallback callback) override;
@@ -74,7 +77,8 @@ private:
     
     // Order management
     std::string create_order_message(const std::string& symbol, const std::string& side, 
-                                   double quantity, double price, const std::string& order_type);
+                                   double quantity, double price, const std::string& order_type,
+                                     const std::string& cl_ord_id = "");
     std::string create_cancel_message(const std::string& cl_ord_id, const std::string& exch_ord_id);
     std::string create_replace_message(const std::string& cl_ord_id, const proto::OrderRequest& new_order);
     
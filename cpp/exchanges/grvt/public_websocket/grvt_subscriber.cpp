@@ -1,5 +1,7 @@
 #include "grvt_subscriber.hpp"
 #include "../../../utils/logging/log_helper.hpp"
+#include "../../../utils/mds/parser_factory.hpp"
+#include "../../../utils/metrics/latency_trace.hpp"
 #include <sstream>
 #include <chrono>
 #include <thread>
@@ -8,7 +10,21 @@
 
 namespace grvt {
 
-GrvtSubscriber::GrvtSubscriber(const GrvtSubscriberConfig& config) : config_(config) {
+namespace {
+
+// GRVT timestamps arrive in ms or ns; anything past year 2100 in ms is ns
+uint64_t to_timestamp_us(uint64_t timestamp) {
+    if (timestamp == 0) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+    return timestamp > 4102444800000ULL ? timestamp / 1000 : timestamp * 1000;
+}
+
+} // namespace
+
+GrvtSubscriber::GrvtSubscriber(const GrvtSubscriberConfig& config)
+    : config_(config), md_parser_(create_market_data_parser("GRVT")) {
     LOG_INFO_COMP("GRVT_SUBSCRIBER", "Initializing GRVT Subscriber");
 }
 
@@ -100,6 +116,10 @@ bool GrvtSubscriber::subscribe_orderbook(const std::string& symbol, int top_n, i
                           " top_n: " + std::to_string(top_n) + " frequency: " + std::to_string(frequency_ms) + "ms";
     LOG_INFO_COMP("GRVT_SUBSCRIBER", log_msg);
     
+    if (top_n > 0) {
+        publish_depth_.store(top_n);
+    }
+    
     // Add to subscribed symbols
     {
         std::lock_guard<std::mutex> lock(symbols_mutex_);
@@ -254,91 +274,43 @@ void GrvtSubscriber::websocket_loop() {
 }
 
 void GrvtSubscriber::handle_websocket_message(const std::string& message) {
+    uint64_t recv_ns = metrics::LatencyTrace::enabled() ? metrics::LatencyTrace::now_ns() : 0;
+    std::lock_guard<std::mutex> lock(parse_mutex_);
     try {
-        Json::Value root;
-        Json::Reader reader;
-        
-        if (!reader.parse(message, root)) {
+        // Full and lite field names are both handled by the parser
+        if (!md_parser_->parse(message, parsed_)) {
             LOG_ERROR_COMP("GRVT_SUBSCRIBER", "Failed to parse WebSocket message");
             return;
         }
+        trace_recv_ns_ = recv_ns;
+        trace_parsed_ns_ = recv_ns ? metrics::LatencyTrace::now_ns() : 0;
         
-        // Handle both full and lite variants
-        bool is_lite = root.isMember("m") || root.isMember("j");
-        std::string method_key = is_lite ? "m" : "method";
-        std::string params_key = is_lite ? "p" : "params";
-        std::string result_key = is_lite ? "r" : "result";
-        std::string error_key = is_lite ? "e" : "error";
-        
-        // Handle different message types
-        if (root.isMember(method_key)) {
-            std::string method = root[method_key].asString();
-            
-            // GRVT API: Method names match channel names (e.g., "orderbook.s", "ticker.d", "trades")
-            if (root.isMember(params_key)) {
-                const Json::Value& params = root[params_key];
-                
-                if (method.find("orderbook") != std::string::npos) {
-                    // Params format: [channel, instrument, data]
-                    // Data contains bids/asks arrays
-                    if (params.isArray() && params.size() >= 3) {
-                        Json::Value orderbook_data;
-                        orderbook_data["symbol"] = params[1];  // instrument
-                        
-                        // Parse orderbook data (format depends on full/lite variant)
-                        const Json::Value& data = params[2];
-                        
-                        // Extract timestamp from data if present, otherwise use current time
-                        if (data.isMember("timestamp")) {
-                            orderbook_data["timestamp"] = data["timestamp"];
-                        } else if (data.isMember("t")) {
-                            orderbook_data["timestamp"] = data["t"];
-                        } else {
-                            orderbook_data["timestamp"] = std::chrono::duration_cast<std::chrono::milliseconds>(
-                                std::chrono::system_clock::now().time_since_epoch()).count();
-                        }
-                        
-                        // Copy bids/asks arrays (check each separately for full/lite variants)
-                        if (data.isMember("bids")) {
-                            orderbook_data["bids"] = data["bids"];
-                        } else if (data.isMember("b")) {
-                            orderbook_data["bids"] = data["b"];
-                        }
-                        if (data.isMember("asks")) {
-                            orderbook_data["asks"] = data["asks"];
-                        } else if (data.isMember("a")) {
-                            orderbook_data["asks"] = data["a"];
-                        }
-                        
-                        handle_orderbook_update(orderbook_data);
-                    }
-                } else if (method.find("trades") != std::string::npos || method.find("trade") != std::string::npos) {
-                    // Params format: [channel, instrument, trade_data]
-                    if (params.isArray() && params.size() >= 3) {
-                        const Json::Value& trade_data = params[2];
-                        Json::Value trade_json;
-                        trade_json["symbol"] = params[1];
-                        trade_json["price"] = trade_data.isMember("price") ? trade_data["price"] : trade_data["p"];
-                        trade_json["quantity"] = trade_data.isMember("quantity") ? trade_data["quantity"] : trade_data["q"];
-                        trade_json["side"] = trade_data.isMember("side") ? trade_data["side"] : trade_data["s"];
-                        trade_json["tradeId"] = trade_data.isMember("tradeId") ? trade_data["tradeId"] : trade_data["ti"];
-                        trade_json["timestamp"] = trade_data.isMember("timestamp") ? trade_data["timestamp"] : trade_data["t"];
-                        
-                        handle_trade_update(trade_json);
-                    }
-                } else if (method.find("ticker") != std::string::npos) {
+        // GRVT API: Method names match channel names (e.g., "orderbook.s", "ticker.d", "trades")
+        switch (parsed_.type) {
+            case MdMessageType::BOOK_DELTA:
+                // Delta channel: maintain the book locally
+                handle_orderbook_delta(parsed_);
+                break;
+            case MdMessageType::BOOK_SNAPSHOT:
+                handle_orderbook_update(parsed_);
+                break;
+            case MdMessageType::TRADE:
+                handle_trade_update(parsed_);
+                break;
+            case MdMessageType::CONTROL:
+                if (parsed_.is_error) {
+                    LOG_ERROR_COMP("GRVT_SUBSCRIBER", "Error response: " + message);
+                } else {
+                    // Handle subscription/unsubscription responses
+                    LOG_INFO_COMP("GRVT_SUBSCRIBER", "Subscription response: " + message);
+                }
+                break;
+            case MdMessageType::UNKNOWN:
+                if (parsed_.channel.find("ticker") != std::string_view::npos) {
                     // Handle ticker updates if needed
                     LOG_INFO_COMP("GRVT_SUBSCRIBER", "Ticker update received: " + message);
                 }
-            }
-        } else if (root.isMember(result_key)) {
-            // Handle subscription/unsubscription responses
-            LOG_INFO_COMP("GRVT_SUBSCRIBER", "Subscription response: " + message);
-        } else if (root.isMember(error_key)) {
-            // Handle error responses
-            std::string error_msg = root[error_key].isString() ? 
-                root[error_key].asString() : root[error_key].toStyledString();
-            LOG_ERROR_COMP("GRVT_SUBSCRIBER", "Error response: " + error_msg);
+                break;
         }
         
     } catch (const std::exception& e) {
@@ -346,74 +318,27 @@ void GrvtSubscriber::handle_websocket_message(const std::string& message) {
     }
 }
 
-void GrvtSubscriber::handle_orderbook_update(const Json::Value& orderbook_data) {
-    proto::OrderBookSnapshot orderbook;
-    orderbook.set_exch("GRVT");
-    
-    if (!orderbook_data.isMember("symbol")) {
+void GrvtSubscriber::handle_orderbook_update(const ParsedMarketData& snapshot) {
+    if (snapshot.symbol.empty()) {
         LOG_ERROR_COMP("GRVT_SUBSCRIBER", "Orderbook data missing symbol");
         return;
     }
-    orderbook.set_symbol(orderbook_data["symbol"].asString());
-    
-    // Handle timestamp (could be in milliseconds or nanoseconds)
-    if (orderbook_data.isMember("timestamp")) {
-        uint64_t timestamp = orderbook_data["timestamp"].asUInt64();
-        // If timestamp is very large (> year 2100 in ms), assume it's nanoseconds
-        if (timestamp > 4102444800000ULL) {
-            orderbook.set_timestamp_us(timestamp / 1000); // Convert nanoseconds to microseconds
-        } else {
-            orderbook.set_timestamp_us(timestamp * 1000); // Convert milliseconds to microseconds
-        }
-    } else {
-        orderbook.set_timestamp_us(std::chrono::duration_cast<std::chrono::microseconds>(
-            std::chrono::system_clock::now().time_since_epoch()).count());
-    }
     
-    // Parse bids
-    if (orderbook_data.isMember("bids")) {
-        const Json::Value& bids = orderbook_data["bids"];
-        if (bids.isArray()) {
-            for (const auto& bid : bids) {
-                if (bid.isArray() && bid.size() >= 2) {
-                    proto::OrderBookLevel* level = orderbook.add_bids();
-                    // Handle string or numeric values
-                    if (bid[0].isString()) {
-                        level->set_price(std::stod(bid[0].asString()));
-                    } else {
-                        level->set_price(bid[0].asDouble());
-                    }
-                    if (bid[1].isString()) {
-                        level->set_qty(std::stod(bid[1].asString()));
-                    } else {
-                        level->set_qty(bid[1].asDouble());
-                    }
-                }
-            }
-        }
-    }
+    proto::OrderBookSnapshot& orderbook = orderbook_msg_;
+    orderbook.Clear();
+    orderbook.set_exch("GRVT");
+    orderbook.set_symbol(snapshot.symbol.data(), snapshot.symbol.size());
+    orderbook.set_timestamp_us(to_timestamp_us(snapshot.exchange_time));
     
-    // Parse asks
-    if (orderbook_data.isMember("asks")) {
-        const Json::Value& asks = orderbook_data["asks"];
-        if (asks.isArray()) {
-            for (const auto& ask : asks) {
-                if (ask.isArray() && ask.size() >= 2) {
-                    proto::OrderBookLevel* level = orderbook.add_asks();
-                    // Handle string or numeric values
-                    if (ask[0].isString()) {
-                        level->set_price(std::stod(ask[0].asString()));
-                    } else {
-                        level->set_price(ask[0].asDouble());
-                    }
-                    if (ask[1].isString()) {
-                        level->set_qty(std::stod(ask[1].asString()));
-                    } else {
-                        level->set_qty(ask[1].asDouble());
-                    }
-                }
-            }
-        }
+    for (const auto& bid : snapshot.bids) {
+        proto::OrderBookLevel* level = orderbook.add_bids();
+        level->set_price(bid.price);
+        level->set_qty(bid.qty);
+    }
+    for (const auto& ask : snapshot.asks) {
+        proto::OrderBookLevel* level = orderbook.add_asks();
+        level->set_price(ask.price);
+        level->set_qty(ask.qty);
     }
     
     std::string orderbook_log_msg = "Orderbook update: " + orderbook.symbol() + 
@@ -421,94 +346,136 @@ void GrvtSubscriber::handle_orderbook_update(const Json::Value& orderbook_data)
                                      " asks: " + std::to_string(orderbook.asks_size());
     LOG_DEBUG_COMP("GRVT_SUBSCRIBER", orderbook_log_msg);
     
+    metrics::LatencyTrace::stamp_market_data(orderbook, trace_recv_ns_, trace_parsed_ns_);
+    
     if (orderbook_callback_) {
         orderbook_callback_(orderbook);
     }
 }
 
-void GrvtSubscriber::handle_trade_update(const Json::Value& trade_data) {
-    proto::Trade trade;
-    trade.set_exch("GRVT");
-    
-    if (!trade_data.isMember("symbol")) {
-        LOG_ERROR_COMP("GRVT_SUBSCRIBER", "Trade data missing symbol");
+void GrvtSubscriber::handle_orderbook_delta(const ParsedMarketData& delta) {
+    // The delta channel opens with a full snapshot after every (re)subscribe,
+    // marked by sequence_number 0; later messages carry absolute level sizes
+    // (0 removes) and are checked against sequence_number / prev_sequence_number.
+    // Only that snapshot (re)builds the book: a delta arriving while the book is
+    // out of sync is dropped, never installed as the book.
+    if (delta.symbol.empty()) {
+        LOG_ERROR_COMP("GRVT_SUBSCRIBER", "Orderbook data missing symbol");
         return;
     }
-    trade.set_symbol(trade_data["symbol"].asString());
-    
-    // Handle price (could be string or numeric)
-    if (trade_data.isMember("price")) {
-        if (trade_data["price"].isString()) {
-            trade.set_price(std::stod(trade_data["price"].asString()));
-        } else {
-            trade.set_price(trade_data["price"].asDouble());
+    LocalOrderBook& book = get_local_book(std::string(delta.symbol));
+    uint64_t sequence = delta.first_id;
+    
+    if (sequence == 0) {
+        // Older buffered deltas belong to the previous subscription's numbering
+        book.invalidate();
+        book.begin_snapshot(0);
+        for (const auto& level : delta.bids) {
+            book.add_snapshot_level(LocalOrderBook::Side::BID, level.price, level.qty);
         }
-    } else if (trade_data.isMember("p")) {
-        if (trade_data["p"].isString()) {
-            trade.set_price(std::stod(trade_data["p"].asString()));
-        } else {
-            trade.set_price(trade_data["p"].asDouble());
+        for (const auto& level : delta.asks) {
+            book.add_snapshot_level(LocalOrderBook::Side::ASK, level.price, level.qty);
         }
-    }
-    
-    // Handle quantity (could be string or numeric)
-    if (trade_data.isMember("quantity")) {
-        if (trade_data["quantity"].isString()) {
-            trade.set_qty(std::stod(trade_data["quantity"].asString()));
-        } else {
-            trade.set_qty(trade_data["quantity"].asDouble());
+        book.end_snapshot();
+    } else if (!book.is_synced()) {
+        // Still waiting for the snapshot; retries a resync the book's rate limit held back
+        book.resync();
+        return;
+    } else {
+        auto result = book.begin_update(sequence, sequence, delta.prev_id);
+        for (const auto& level : delta.bids) {
+            book.apply_level(LocalOrderBook::Side::BID, level.price, level.qty);
+        }
+        for (const auto& level : delta.asks) {
+            book.apply_level(LocalOrderBook::Side::ASK, level.price, level.qty);
         }
-    } else if (trade_data.isMember("q")) {
-        if (trade_data["q"].isString()) {
-            trade.set_qty(std::stod(trade_data["q"].asString()));
-        } else {
-            trade.set_qty(trade_data["q"].asDouble());
+        book.end_update();
+        
+        if (result == LocalOrderBook::UpdateResult::GAP) {
+            LOG_WARN_COMP("GRVT_SUBSCRIBER", "Sequence gap on " + book.symbol() + " at " + std::to_string(sequence) +
+                          " (last " + std::to_string(book.last_update_id()) + "), resyncing");
+            book.resync();
+        }
+        if (result != LocalOrderBook::UpdateResult::APPLIED) {
+            return;
         }
     }
     
-    // Handle side
-    std::string side_str;
-    if (trade_data.isMember("side")) {
-        side_str = trade_data["side"].asString();
-    } else if (trade_data.isMember("s")) {
-        side_str = trade_data["s"].asString();
-    }
-    trade.set_is_buyer_maker(side_str == "sell" || side_str == "SELL");
+    proto::OrderBookSnapshot& orderbook = orderbook_msg_;
+    orderbook.Clear();
+    orderbook.set_exch("GRVT");
+    orderbook.set_symbol(book.symbol());
+    orderbook.set_timestamp_us(to_timestamp_us(delta.exchange_time));
+    book.write_snapshot(orderbook, static_cast<size_t>(publish_depth_.load()));
+    
+    LOG_DEBUG_COMP("GRVT_SUBSCRIBER", "Orderbook delta applied: " + book.symbol() +
+                   " bids: " + std::to_string(book.bid_depth()) + " asks: " + std::to_string(book.ask_depth()));
     
-    // Handle trade ID
-    if (trade_data.isMember("tradeId")) {
-        trade.set_trade_id(trade_data["tradeId"].asString());
-    } else if (trade_data.isMember("ti")) {
-        trade.set_trade_id(trade_data["ti"].asString());
+    metrics::LatencyTrace::stamp_market_data(orderbook, trace_recv_ns_, trace_parsed_ns_);
+    
+    if (orderbook_callback_) {
+        orderbook_callback_(orderbook);
+    }
+}
+
+LocalOrderBook& GrvtSubscriber::get_local_book(const std::string& symbol) {
+    auto it = local_books_.find(symbol);
+    if (it != local_books_.end()) {
+        return *it->second;
     }
     
-    // Handle timestamp
-    if (trade_data.isMember("timestamp")) {
-        uint64_t timestamp = trade_data["timestamp"].asUInt64();
-        if (timestamp > 4102444800000ULL) {
-            trade.set_timestamp_us(timestamp / 1000);
-        } else {
-            trade.set_timestamp_us(timestamp * 1000);
-        }
-    } else if (trade_data.isMember("t")) {
-        uint64_t timestamp = trade_data["t"].asUInt64();
-        if (timestamp > 4102444800000ULL) {
-            trade.set_timestamp_us(timestamp / 1000);
-        } else {
-            trade.set_timestamp_us(timestamp * 1000);
-        }
-    } else {
-        trade.set_timestamp_us(std::chrono::duration_cast<std::chrono::microseconds>(
-            std::chrono::system_clock::now().time_since_epoch()).count());
+    auto book = std::make_unique<LocalOrderBook>(symbol);
+    book->set_resync_handler([this](LocalOrderBook& target) { return resync_local_book(target); });
+    return *local_books_.emplace(symbol, std::move(book)).first->second;
+}
+
+bool GrvtSubscriber::resync_local_book(LocalOrderBook& book) {
+    // GRVT's REST book carries no stream sequence number to bridge from, but the
+    // delta channel restarts with a full snapshot, so re-subscribing rebuilds the book.
+    if (!custom_transport_ || !custom_transport_->is_connected()) {
+        LOG_ERROR_COMP("GRVT_SUBSCRIBER", "Cannot resync " + book.symbol() + ": transport not connected");
+        return false;
     }
     
-    std::string trade_log_msg = "Trade update: " + trade.symbol() + 
-                                 " " + std::to_string(trade.qty()) + "@" + std::to_string(trade.price()) + 
-                                 " side: " + (trade.is_buyer_maker() ? "SELL" : "BUY");
-    LOG_DEBUG_COMP("GRVT_SUBSCRIBER", trade_log_msg);
+    bool sent = custom_transport_->send_message(create_unsubscription_message(book.symbol(), "orderbook", false)) &&
+                custom_transport_->send_message(create_subscription_message(book.symbol(), "orderbook", false));
+    LOG_INFO_COMP("GRVT_SUBSCRIBER", "Re-subscribed to " + get_channel_name("orderbook", false) + " for " +
+                  book.symbol() + (sent ? "" : " (send failed)"));
+    return sent;
+}
+
+void GrvtSubscriber::handle_trade_update(const ParsedMarketData& trades) {
+    if (trades.symbol.empty()) {
+        LOG_ERROR_COMP("GRVT_SUBSCRIBER", "Trade data missing symbol");
+        return;
+    }
     
-    if (trade_callback_) {
-        trade_callback_(trade);
+    for (const auto& parsed : trades.trades) {
+        proto::Trade& trade = trade_msg_;
+        trade.Clear();
+        trade.set_exch("GRVT");
+        trade.set_symbol(trades.symbol.data(), trades.symbol.size());
+        trade.set_price(parsed.price);
+        trade.set_qty(parsed.qty);
+        trade.set_is_buyer_maker(parsed.is_buyer_maker);
+        
+        // Trade ID may be a string or a number
+        if (!parsed.trade_id.empty()) {
+            trade.set_trade_id(parsed.trade_id.data(), parsed.trade_id.size());
+        } else if (parsed.trade_seq != 0) {
+            trade.set_trade_id(std::to_string(parsed.trade_seq));
+        }
+        trade.set_timestamp_us(to_timestamp_us(parsed.exchange_time));
+        
+        std::string trade_log_msg = "Trade update: " + trade.symbol() + 
+                                     " " + std::to_string(trade.qty()) + "@" + std::to_string(trade.price()) + 
+                                     " side: " + (trade.is_buyer_maker() ? "SELL" : "BUY");
+        LOG_DEBUG_COMP("GRVT_SUBSCRIBER", trade_log_msg);
+        
+        if (trade_callback_) {
+            metrics::LatencyTrace::stamp_market_data(trade, trace_recv_ns_, trace_parsed_ns_);
+            trade_callback_(trade);
+        }
     }
 }
 
@@ -1,12 +1,15 @@
 #pragma once
 #include "../../i_exchange_subscriber.hpp"
 #include "../../../proto/market_data.pb.h"
+#include "../../../utils/mds/local_order_book.hpp"
+#include "../../../utils/mds/market_data_parser.hpp"
 #include <string>
 #include <memory>
 #include <atomic>
 #include <thread>
 #include <mutex>
 #include <functional>
+#include <unordered_map>
 #include <json/json.h>
 
 namespace grvt {
@@ -72,14 +75,33 @@ private:
     OrderbookCallback orderbook_callback_;
     TradeCallback trade_callback_;
     
+    // Local books rebuilt from orderbook.d deltas; only touched from the message thread
+    std::unordered_map<std::string, std::unique_ptr<LocalOrderBook>> local_books_;
+    std::atomic<int> publish_depth_{20};
+    
+    // Zero-allocation parse path; the parser, its output and the outgoing
+    // messages are reused for every message under parse_mutex_
+    std::unique_ptr<IMarketDataParser> md_parser_;
+    ParsedMarketData parsed_;
+    proto::OrderBookSnapshot orderbook_msg_;
+    proto::Trade trade_msg_;
+    std::mutex parse_mutex_;
+    uint64_t trace_recv_ns_{0};     // Latency trace stamps for the message in hand (0 when tracing is off)
+    uint64_t trace_parsed_ns_{0};
+    
     // Message handling
     void websocket_loop();
-    void handle_orderbook_update(const Json::Value& orderbook_data);
-    void handle_trade_update(const Json::Value& trade_data);
+    void handle_orderbook_update(const ParsedMarketData& snapshot);
+    void handle_orderbook_delta(const ParsedMarketData& delta);
+    void handle_trade_update(const ParsedMarketData& trades);
     
     // Subscription management (private)
     std::string create_unsubscription_message(const std::string& symbol, const std::string& channel, bool use_snapshot = true);
     
+    // Local order book maintenance
+    LocalOrderBook& get_local_book(const std::string& symbol);
+    bool resync_local_book(LocalOrderBook& book);
+    
     // Utility methods
     std::string generate_request_id();
 };
@@ -2,6 +2,8 @@
 #include "../proto/order.pb.h"
 #include "../proto/position.pb.h"
 #include "../proto/acc_balance.pb.h"
+#include "../proto/market_data.pb.h"
+#include <cstdint>
 
 /**
  * IExchangeDataFetcher - HTTP Data Fetcher Interface
@@ -16,6 +18,7 @@
  * - Used for getting current state after startup/crash
  * - Authentication via API keys
  * - Exchange-specific implementations: BinanceDataFetcher, GrvtDataFetcher, DeribitDataFetcher
+ * - Also serves public order book snapshots to resync books maintained from diff streams
  */
 class IExchangeDataFetcher {
 public:
@@ -29,4 +32,19 @@ public:
     virtual std::vector<proto::OrderEvent> get_open_orders() = 0;
     virtual std::vector<proto::PositionUpdate> get_positions() = 0;
     virtual std::vector<proto::AccountBalance> get_balances() = 0;
+    
+    /**
+     * Order book recovery (HTTP, public): fetch a depth snapshot together with
+     * the venue's book update id so it can be bridged to the diff stream.
+     * @return false if the request failed or the venue does not support it
+     */
+    virtual bool get_orderbook_snapshot(const std::string& symbol, int depth,
+                                        proto::OrderBookSnapshot& snapshot,
+                                        uint64_t& last_update_id) {
+        (void)symbol;
+        (void)depth;
+        (void)snapshot;
+        (void)last_update_id;
+        return false;
+    }
 };
\ No newline at end of file
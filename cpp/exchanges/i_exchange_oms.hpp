@@ -3,6 +3,7 @@
 #include "websocket/i_websocket_transport.hpp"
 #include <functional>
 #include <memory>
+#include <vector>
 
 // Callback types for real-time updates
 using OrderStatusCallback = std::function<void(const proto::OrderEvent& order_event)>;
@@ -34,14 +35,49 @@ public:
     virtual void set_auth_credentials(const std::string& api_key, const std::string& secret) = 0;
     virtual bool is_authenticated() const = 0;
     
-    // Order management (via WebSocket)
-    virtual bool cancel_order(const std::string& cl_ord_id, const std::string& exch_ord_id) = 0;
+    // Order management (via WebSocket); venues that key orders by symbol (Binance) need the symbol to cancel
+    virtual bool cancel_order(const std::string& cl_ord_id, const std::string& exch_ord_id,
+                              const std::string& symbol = "") = 0;
     virtual bool replace_order(const std::string& cl_ord_id, const proto::OrderRequest& new_order) = 0;
     virtual proto::OrderEvent get_order_status(const std::string& cl_ord_id, const std::string& exch_ord_id) = 0;
     
-    // Specific order types (via WebSocket)
-    virtual bool place_market_order(const std::string& symbol, const std::string& side, double quantity) = 0;
-    virtual bool place_limit_order(const std::string& symbol, const std::string& side, double quantity, double price) = 0;
+    // Specific order types (via WebSocket); cl_ord_id, when given, is sent as the venue's client order id
+    virtual bool place_market_order(const std::string& symbol, const std::string& side, double quantity,
+                                    const std::string& cl_ord_id = "") = 0;
+    virtual bool place_limit_order(const std::string& symbol, const std::string& side, double quantity, double price,
+                                   const std::string& cl_ord_id = "") = 0;
+    
+    /**
+     * Batch order entry: results[i] is set to whether batch.actions(i) was accepted.
+     * 
+     * Exchanges with batch endpoints override this to cover the batch in as few
+     * round-trips as possible. The default pipelines the single-order calls in
+     * batch order.
+     */
+    virtual void submit_batch(const proto::OrderBatchRequest& batch, std::vector<bool>& results) {
+        results.assign(static_cast<size_t>(batch.actions_size()), false);
+        for (int i = 0; i < batch.actions_size(); ++i) {
+            const proto::OrderAction& action = batch.actions(i);
+            const proto::OrderRequest& order = action.order();
+            switch (action.action()) {
+                case proto::NEW_ORDER:
+                    results[i] = order.type() == proto::OrderType::MARKET
+                        ? place_market_order(order.symbol(), order.side() == proto::Side::BUY ? "BUY" : "SELL",
+                                             order.qty(), order.cl_ord_id())
+                        : place_limit_order(order.symbol(), order.side() == proto::Side::BUY ? "BUY" : "SELL",
+                                            order.qty(), order.price(), order.cl_ord_id());
+                    break;
+                case proto::CANCEL_ORDER:
+                    results[i] = cancel_order(order.cl_ord_id(), "", order.symbol());
+                    break;
+                case proto::REPLACE_ORDER:
+                    results[i] = replace_order(order.cl_ord_id(), order);
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
     
     // Real-time callbacks
     virtual void set_order_status_callback(OrderStatusCallback callback) = 0;
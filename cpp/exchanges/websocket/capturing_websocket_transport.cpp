@@ -0,0 +1,107 @@
+#include "capturing_websocket_transport.hpp"
+#include "../../utils/logging/log_helper.hpp"
+#include <chrono>
+
+namespace websocket_transport {
+
+CapturingWebSocketTransport::CapturingWebSocketTransport(std::unique_ptr<IWebSocketTransport> transport,
+                                                         const FrameJournalWriter::Config& journal_config)
+    : journal_(journal_config), transport_(std::move(transport)) {
+}
+
+CapturingWebSocketTransport::~CapturingWebSocketTransport() {
+    transport_.reset();
+    journal_.close();
+}
+
+bool CapturingWebSocketTransport::connect(const std::string& url) {
+    if (!journal_.is_open() && !journal_.open()) {
+        LOG_WARN_COMP("CAPTURING_TRANSPORT", "Journal unavailable; connecting without capture");
+    }
+    return transport_->connect(url);
+}
+
+void CapturingWebSocketTransport::disconnect() {
+    transport_->disconnect();
+}
+
+bool CapturingWebSocketTransport::is_connected() const {
+    return transport_->is_connected();
+}
+
+WebSocketState CapturingWebSocketTransport::get_state() const {
+    return transport_->get_state();
+}
+
+bool CapturingWebSocketTransport::send_message(const std::string& message, bool binary) {
+    return transport_->send_message(message, binary);
+}
+
+bool CapturingWebSocketTransport::send_binary(const std::vector<uint8_t>& data) {
+    return transport_->send_binary(data);
+}
+
+bool CapturingWebSocketTransport::send_ping() {
+    return transport_->send_ping();
+}
+
+void CapturingWebSocketTransport::set_message_callback(WebSocketMessageCallback callback) {
+    // Journal first, so the stamp is taken before the subscriber's parsing
+    transport_->set_message_callback([this, callback = std::move(callback)](const WebSocketMessage& message) {
+        journal_.append(message, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count()));
+        if (callback) {
+            callback(message);
+        }
+    });
+}
+
+void CapturingWebSocketTransport::set_error_callback(WebSocketErrorCallback callback) {
+    transport_->set_error_callback(std::move(callback));
+}
+
+void CapturingWebSocketTransport::set_connect_callback(WebSocketConnectCallback callback) {
+    transport_->set_connect_callback(std::move(callback));
+}
+
+void CapturingWebSocketTransport::set_ping_interval(int seconds) {
+    transport_->set_ping_interval(seconds);
+}
+
+void CapturingWebSocketTransport::set_timeout(int seconds) {
+    transport_->set_timeout(seconds);
+}
+
+void CapturingWebSocketTransport::set_reconnect_attempts(int attempts) {
+    transport_->set_reconnect_attempts(attempts);
+}
+
+void CapturingWebSocketTransport::set_reconnect_delay(int seconds) {
+    transport_->set_reconnect_delay(seconds);
+}
+
+bool CapturingWebSocketTransport::initialize() {
+    if (!journal_.is_open() && !journal_.open()) {
+        LOG_WARN_COMP("CAPTURING_TRANSPORT", "Journal unavailable; running without capture");
+    }
+    return transport_->initialize();
+}
+
+void CapturingWebSocketTransport::shutdown() {
+    // The journal stays open: reopening would truncate it if the transport is reused
+    transport_->shutdown();
+}
+
+void CapturingWebSocketTransport::start_event_loop() {
+    transport_->start_event_loop();
+}
+
+void CapturingWebSocketTransport::stop_event_loop() {
+    transport_->stop_event_loop();
+}
+
+bool CapturingWebSocketTransport::is_event_loop_running() const {
+    return transport_->is_event_loop_running();
+}
+
+} // namespace websocket_transport
@@ -0,0 +1,64 @@
+#pragma once
+#include "i_websocket_transport.hpp"
+#include "frame_journal.hpp"
+#include <memory>
+
+namespace websocket_transport {
+
+/**
+ * Capture mode for any IWebSocketTransport
+ *
+ * Wraps a transport and forwards every call to it unchanged. Inbound frames
+ * are stamped with steady_clock on arrival and appended to a FrameJournal
+ * before the subscriber's callback runs; the append is a copy into a
+ * lock-free ring, so the I/O thread never waits on disk. Frames the journal
+ * cannot keep up with are dropped from the journal only, never from the feed.
+ *
+ * The journal opens on initialize() or connect(), whichever comes first,
+ * and closes on destruction, after the wrapped transport has stopped.
+ */
+class CapturingWebSocketTransport : public IWebSocketTransport {
+public:
+    CapturingWebSocketTransport(std::unique_ptr<IWebSocketTransport> transport,
+                                const FrameJournalWriter::Config& journal_config);
+    ~CapturingWebSocketTransport() override;
+
+    // Connection management
+    bool connect(const std::string& url) override;
+    void disconnect() override;
+    bool is_connected() const override;
+    WebSocketState get_state() const override;
+
+    // Message handling
+    bool send_message(const std::string& message, bool binary = false) override;
+    bool send_binary(const std::vector<uint8_t>& data) override;
+    bool send_ping() override;
+
+    // Callbacks
+    void set_message_callback(WebSocketMessageCallback callback) override;
+    void set_error_callback(WebSocketErrorCallback callback) override;
+    void set_connect_callback(WebSocketConnectCallback callback) override;
+
+    // Configuration
+    void set_ping_interval(int seconds) override;
+    void set_timeout(int seconds) override;
+    void set_reconnect_attempts(int attempts) override;
+    void set_reconnect_delay(int seconds) override;
+
+    // Lifecycle
+    bool initialize() override;
+    void shutdown() override;
+
+    // Event loop management
+    void start_event_loop() override;
+    void stop_event_loop() override;
+    bool is_event_loop_running() const override;
+
+    const FrameJournalWriter& get_journal() const { return journal_; }
+
+private:
+    FrameJournalWriter journal_;
+    std::unique_ptr<IWebSocketTransport> transport_;   // Declared last so it stops before the journal closes
+};
+
+} // namespace websocket_transport
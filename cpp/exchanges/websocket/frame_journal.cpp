@@ -0,0 +1,383 @@
+#include "frame_journal.hpp"
+#include "../../utils/logging/log_helper.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+
+namespace websocket_transport {
+
+namespace {
+
+template <typename T>
+void put(uint8_t* out, T value) {
+    std::memcpy(out, &value, sizeof(T));
+}
+
+template <typename T>
+T get(const uint8_t* in) {
+    T value;
+    std::memcpy(&value, in, sizeof(T));
+    return value;
+}
+
+uint64_t wall_clock_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+uint64_t steady_clock_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+} // namespace
+
+// ---- FrameJournalWriter ---------------------------------------------------
+
+FrameJournalWriter::FrameJournalWriter(const Config& config)
+    : config_(config),
+      // The writer polls on its own schedule, so the I/O thread never pays for a wake-up
+      queue_(std::make_unique<SpscRing<JournalFrame>>(config.queue_capacity, WaitStrategy::BUSY_SPIN)) {
+    block_.reserve(config_.block_size + 64 * 1024);
+}
+
+FrameJournalWriter::~FrameJournalWriter() {
+    close();
+}
+
+bool FrameJournalWriter::open() {
+    if (open_.load()) {
+        return true;
+    }
+
+    fd_ = ::open(config_.path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        LOG_ERROR_COMP("FRAME_JOURNAL", "Failed to create " + config_.path + ": " + std::strerror(errno));
+        return false;
+    }
+    size_ = 0;
+    if (!reserve(journal_format::kFileHeaderSize)) {
+        unmap();
+        return false;
+    }
+
+    uint8_t* header = map_;
+    put<uint32_t>(header, journal_format::kFileMagic);
+    put<uint16_t>(header + 4, journal_format::kVersion);
+    put<uint16_t>(header + 6, static_cast<uint16_t>(journal_format::kFileHeaderSize));
+    put<uint64_t>(header + 8, wall_clock_ns());
+    put<uint64_t>(header + 16, steady_clock_ns());
+    put<uint64_t>(header + 24, 0);
+    size_ = journal_format::kFileHeaderSize;
+
+    running_.store(true);
+    thread_ = std::thread(&FrameJournalWriter::run, this);
+    open_.store(true, std::memory_order_release);
+    LOG_INFO_COMP("FRAME_JOURNAL", "Capturing frames to " + config_.path);
+    return true;
+}
+
+void FrameJournalWriter::close() {
+    if (!open_.exchange(false)) {
+        return;
+    }
+    running_.store(false);
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    unmap();
+    LOG_INFO_COMP("FRAME_JOURNAL", "Closed " + config_.path + ": " +
+                  std::to_string(statistics_.frames_written.load()) + " frames, " +
+                  std::to_string(statistics_.frames_dropped.load()) + " dropped, " +
+                  std::to_string(statistics_.raw_bytes.load()) + " -> " +
+                  std::to_string(statistics_.compressed_bytes.load()) + " bytes");
+}
+
+bool FrameJournalWriter::append(const WebSocketMessage& message, uint64_t receive_ns) {
+    if (!open_.load(std::memory_order_acquire)) {
+        return false;
+    }
+    JournalFrame* slot = queue_->claim();
+    if (!slot) {
+        statistics_.frames_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    // assign() reuses the slot's capacity, so a warmed-up ring does not allocate
+    slot->receive_ns = receive_ns;
+    slot->is_binary = message.is_binary;
+    slot->channel.assign(message.channel);
+    slot->data.assign(message.data);
+    queue_->publish();
+    return true;
+}
+
+void FrameJournalWriter::run() {
+    const auto flush_interval = std::chrono::milliseconds(config_.flush_interval_ms);
+    auto last_flush = std::chrono::steady_clock::now();
+
+    while (true) {
+        JournalFrame* frame = queue_->front();
+        if (!frame) {
+            if (!running_.load()) {
+                break;
+            }
+            auto now = std::chrono::steady_clock::now();
+            if (block_frames_ > 0 && now - last_flush >= flush_interval) {
+                flush_block();
+                last_flush = now;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+
+        add_to_block(*frame);
+        queue_->pop();
+        if (block_.size() >= config_.block_size) {
+            flush_block();
+            last_flush = std::chrono::steady_clock::now();
+        }
+    }
+    flush_block();
+}
+
+void FrameJournalWriter::add_to_block(const JournalFrame& frame) {
+    if (block_frames_ == 0) {
+        block_first_ns_ = frame.receive_ns;
+    }
+    const size_t channel_size = std::min<size_t>(frame.channel.size(), UINT16_MAX);
+    const size_t offset = block_.size();
+    block_.resize(offset + journal_format::kFrameHeaderSize + channel_size + frame.data.size());
+
+    uint8_t* out = block_.data() + offset;
+    put<uint64_t>(out, frame.receive_ns);
+    put<uint32_t>(out + 8, static_cast<uint32_t>(frame.data.size()));
+    put<uint16_t>(out + 12, static_cast<uint16_t>(channel_size));
+    out[14] = frame.is_binary ? journal_format::kFlagBinary : 0;
+    out[15] = 0;
+    out += journal_format::kFrameHeaderSize;
+    std::memcpy(out, frame.channel.data(), channel_size);
+    std::memcpy(out + channel_size, frame.data.data(), frame.data.size());
+    ++block_frames_;
+}
+
+bool FrameJournalWriter::flush_block() {
+    if (block_frames_ == 0) {
+        return true;
+    }
+
+    // Deflate straight into the mapping, then stamp the header in front of it
+    uLongf compressed_size = compressBound(static_cast<uLong>(block_.size()));
+    bool written = false;
+    if (reserve(journal_format::kBlockHeaderSize + compressed_size)) {
+        uint8_t* header = map_ + size_;
+        uint8_t* payload = header + journal_format::kBlockHeaderSize;
+        int rc = compress2(payload, &compressed_size, block_.data(), static_cast<uLong>(block_.size()),
+                           config_.compression_level);
+        if (rc == Z_OK) {
+            put<uint32_t>(header, journal_format::kBlockMagic);
+            put<uint32_t>(header + 4, static_cast<uint32_t>(compressed_size));
+            put<uint32_t>(header + 8, static_cast<uint32_t>(block_.size()));
+            put<uint32_t>(header + 12, block_frames_);
+            put<uint64_t>(header + 16, block_first_ns_);
+            put<uint32_t>(header + 24, static_cast<uint32_t>(crc32(0L, payload, static_cast<uInt>(compressed_size))));
+            put<uint32_t>(header + 28, 0);
+            size_ += journal_format::kBlockHeaderSize + compressed_size;
+
+            statistics_.frames_written.fetch_add(block_frames_, std::memory_order_relaxed);
+            statistics_.blocks_written.fetch_add(1, std::memory_order_relaxed);
+            statistics_.raw_bytes.fetch_add(block_.size(), std::memory_order_relaxed);
+            statistics_.compressed_bytes.fetch_add(journal_format::kBlockHeaderSize + compressed_size,
+                                                   std::memory_order_relaxed);
+            written = true;
+        } else {
+            LOG_ERROR_COMP("FRAME_JOURNAL", "Block compression failed: " + std::to_string(rc));
+        }
+    }
+    if (!written) {
+        statistics_.frames_dropped.fetch_add(block_frames_, std::memory_order_relaxed);
+    }
+
+    block_.clear();
+    block_frames_ = 0;
+    return written;
+}
+
+bool FrameJournalWriter::reserve(size_t bytes) {
+    if (size_ + bytes <= mapped_) {
+        return true;
+    }
+    const size_t grow = std::max<size_t>(config_.grow_bytes, 4096);
+    size_t target = mapped_ + grow;
+    while (target < size_ + bytes) {
+        target += grow;
+    }
+
+    if (ftruncate(fd_, static_cast<off_t>(target)) != 0) {
+        LOG_ERROR_COMP("FRAME_JOURNAL", "Failed to grow " + config_.path + ": " + std::strerror(errno));
+        return false;
+    }
+    void* mapped = map_ ? mremap(map_, mapped_, target, MREMAP_MAYMOVE)
+                        : mmap(nullptr, target, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (mapped == MAP_FAILED) {
+        LOG_ERROR_COMP("FRAME_JOURNAL", "Failed to map " + config_.path + ": " + std::strerror(errno));
+        return false;
+    }
+    map_ = static_cast<uint8_t*>(mapped);
+    mapped_ = target;
+    return true;
+}
+
+void FrameJournalWriter::unmap() {
+    if (map_) {
+        munmap(map_, mapped_);
+        map_ = nullptr;
+    }
+    mapped_ = 0;
+    if (fd_ >= 0) {
+        // Drop the unused tail of the last growth step
+        if (ftruncate(fd_, static_cast<off_t>(size_)) != 0) {
+            LOG_WARN_COMP("FRAME_JOURNAL", "Failed to trim " + config_.path + ": " + std::strerror(errno));
+        }
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+// ---- FrameJournalReader ---------------------------------------------------
+
+FrameJournalReader::FrameJournalReader(const std::string& path) : path_(path) {
+}
+
+FrameJournalReader::~FrameJournalReader() {
+    close();
+}
+
+bool FrameJournalReader::open() {
+    close();
+    fd_ = ::open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd_ < 0) {
+        LOG_ERROR_COMP("FRAME_JOURNAL", "Failed to open " + path_ + ": " + std::strerror(errno));
+        return false;
+    }
+    struct stat st {};
+    if (fstat(fd_, &st) != 0 || static_cast<size_t>(st.st_size) < journal_format::kFileHeaderSize) {
+        LOG_ERROR_COMP("FRAME_JOURNAL", path_ + " is not a frame journal");
+        close();
+        return false;
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    void* mapped = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd_, 0);
+    if (mapped == MAP_FAILED) {
+        LOG_ERROR_COMP("FRAME_JOURNAL", "Failed to map " + path_ + ": " + std::strerror(errno));
+        close();
+        return false;
+    }
+    map_ = static_cast<const uint8_t*>(mapped);
+
+    if (get<uint32_t>(map_) != journal_format::kFileMagic || get<uint16_t>(map_ + 4) != journal_format::kVersion) {
+        LOG_ERROR_COMP("FRAME_JOURNAL", path_ + " is not a version " + std::to_string(journal_format::kVersion) +
+                       " frame journal");
+        close();
+        return false;
+    }
+    created_wall_ns_ = get<uint64_t>(map_ + 8);
+    created_steady_ns_ = get<uint64_t>(map_ + 16);
+    rewind();
+    return true;
+}
+
+void FrameJournalReader::close() {
+    if (map_) {
+        munmap(const_cast<uint8_t*>(map_), size_);
+        map_ = nullptr;
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+    size_ = 0;
+}
+
+void FrameJournalReader::rewind() {
+    offset_ = map_ ? get<uint16_t>(map_ + 6) : 0;
+    block_.clear();
+    block_offset_ = 0;
+    frames_read_ = 0;
+    truncated_ = false;
+}
+
+bool FrameJournalReader::next(JournalFrame& frame) {
+    if (!map_ || truncated_) {
+        return false;
+    }
+    while (block_offset_ >= block_.size()) {
+        if (!load_block()) {
+            return false;
+        }
+    }
+
+    const uint8_t* in = block_.data() + block_offset_;
+    const size_t remaining = block_.size() - block_offset_;
+    if (remaining < journal_format::kFrameHeaderSize) {
+        truncated_ = true;
+        block_.clear();
+        return false;
+    }
+    const uint32_t data_size = get<uint32_t>(in + 8);
+    const uint16_t channel_size = get<uint16_t>(in + 12);
+    if (remaining < journal_format::kFrameHeaderSize + channel_size + data_size) {
+        truncated_ = true;
+        block_.clear();
+        return false;
+    }
+
+    frame.receive_ns = get<uint64_t>(in);
+    frame.is_binary = (in[14] & journal_format::kFlagBinary) != 0;
+    in += journal_format::kFrameHeaderSize;
+    frame.channel.assign(reinterpret_cast<const char*>(in), channel_size);
+    frame.data.assign(reinterpret_cast<const char*>(in) + channel_size, data_size);
+    block_offset_ += journal_format::kFrameHeaderSize + channel_size + data_size;
+    ++frames_read_;
+    return true;
+}
+
+bool FrameJournalReader::load_block() {
+    block_.clear();
+    block_offset_ = 0;
+    if (offset_ + journal_format::kBlockHeaderSize > size_) {
+        return false;
+    }
+
+    const uint8_t* header = map_ + offset_;
+    const uint32_t magic = get<uint32_t>(header);
+    if (magic == 0) {
+        return false;   // Zeroed tail of a journal still being written
+    }
+    const uint32_t compressed_size = get<uint32_t>(header + 4);
+    const uint32_t raw_size = get<uint32_t>(header + 8);
+    const uint8_t* payload = header + journal_format::kBlockHeaderSize;
+    if (magic != journal_format::kBlockMagic ||
+        offset_ + journal_format::kBlockHeaderSize + compressed_size > size_ ||
+        crc32(0L, payload, compressed_size) != get<uint32_t>(header + 24)) {
+        truncated_ = true;
+        return false;
+    }
+
+    block_.resize(raw_size);
+    uLongf inflated = raw_size;
+    if (uncompress(block_.data(), &inflated, payload, compressed_size) != Z_OK || inflated != raw_size) {
+        truncated_ = true;
+        block_.clear();
+        return false;
+    }
+    offset_ += journal_format::kBlockHeaderSize + compressed_size;
+    return true;
+}
+
+} // namespace websocket_transport
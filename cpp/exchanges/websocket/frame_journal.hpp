@@ -0,0 +1,166 @@
+#pragma once
+#include "i_websocket_transport.hpp"
+#include "../../utils/lockfree/spsc_ring.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace websocket_transport {
+
+// One inbound frame as captured
+struct JournalFrame {
+    uint64_t receive_ns{0};   // steady_clock when the transport delivered it
+    bool is_binary{false};
+    std::string channel;
+    std::string data;
+};
+
+/**
+ * Append-only journal of inbound websocket frames
+ *
+ * File layout (host byte order):
+ *   header: u32 magic 'WSJ1' | u16 version | u16 header size |
+ *           u64 wall clock ns | u64 steady clock ns (both at creation) | u64 reserved
+ *   block:  u32 magic 'WJBK' | u32 compressed size | u32 raw size | u32 frame count |
+ *           u64 first receive ns | u32 crc32 of compressed bytes | u32 reserved |
+ *           zlib-compressed frames
+ *   frame:  u64 receive ns | u32 data size | u16 channel size | u8 flags (1 = binary) |
+ *           u8 reserved | channel | data
+ *
+ * Readers stop at the first block that is incomplete or fails its CRC, so
+ * a journal cut short by a crash stays readable up to its last full block.
+ */
+namespace journal_format {
+constexpr uint32_t kFileMagic = 0x314A5357;    // "WSJ1"
+constexpr uint32_t kBlockMagic = 0x4B424A57;   // "WJBK"
+constexpr uint16_t kVersion = 1;
+constexpr size_t kFileHeaderSize = 32;
+constexpr size_t kBlockHeaderSize = 32;
+constexpr size_t kFrameHeaderSize = 16;
+constexpr uint8_t kFlagBinary = 0x01;
+} // namespace journal_format
+
+/**
+ * Writes a frame journal from a background thread
+ *
+ * append() runs on the transport's I/O thread: it copies the frame into a
+ * preallocated SPSC ring slot and returns; it never waits, takes a lock or
+ * makes a syscall, and a full ring drops the frame (counted). The writer
+ * thread polls the ring, packs frames into blocks, deflates each block
+ * straight into a memory-mapped region of the file and grows the mapping
+ * in large steps. Partial blocks are flushed every flush_interval_ms so a
+ * quiet feed still reaches disk promptly.
+ *
+ * @note One producer thread, as with a transport's single I/O thread.
+ */
+class FrameJournalWriter {
+public:
+    struct Config {
+        std::string path;
+        size_t queue_capacity{16384};       // Frames in flight between the I/O and writer threads
+        size_t block_size{256 * 1024};      // Uncompressed bytes per block
+        int compression_level{1};           // zlib level; 1 keeps the writer cheap
+        size_t grow_bytes{64 * 1024 * 1024};
+        int flush_interval_ms{100};
+    };
+
+    struct Statistics {
+        std::atomic<uint64_t> frames_written{0};
+        std::atomic<uint64_t> frames_dropped{0};
+        std::atomic<uint64_t> blocks_written{0};
+        std::atomic<uint64_t> raw_bytes{0};
+        std::atomic<uint64_t> compressed_bytes{0};
+    };
+
+    explicit FrameJournalWriter(const Config& config);
+    ~FrameJournalWriter();
+
+    FrameJournalWriter(const FrameJournalWriter&) = delete;
+    FrameJournalWriter& operator=(const FrameJournalWriter&) = delete;
+
+    // Create (truncate) the file and start the writer thread
+    bool open();
+    // Drain queued frames, write the last block and trim the file to size
+    void close();
+    bool is_open() const { return open_.load(std::memory_order_acquire); }
+
+    // Queue a frame; false if the journal is closed or the queue is full
+    bool append(const WebSocketMessage& message, uint64_t receive_ns);
+
+    const Statistics& get_statistics() const { return statistics_; }
+    const std::string& path() const { return config_.path; }
+
+private:
+    void run();
+    void add_to_block(const JournalFrame& frame);
+    bool flush_block();
+    bool reserve(size_t bytes);
+    void unmap();
+
+    Config config_;
+    std::unique_ptr<SpscRing<JournalFrame>> queue_;
+    std::atomic<bool> open_{false};
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+
+    // Writer thread only
+    int fd_{-1};
+    uint8_t* map_{nullptr};
+    size_t mapped_{0};
+    size_t size_{0};
+    std::vector<uint8_t> block_;
+    uint32_t block_frames_{0};
+    uint64_t block_first_ns_{0};
+
+    Statistics statistics_;
+};
+
+/**
+ * Reads a frame journal sequentially
+ *
+ * The file is mapped read-only; each block is inflated into a reused
+ * buffer and frames are handed out one at a time.
+ */
+class FrameJournalReader {
+public:
+    explicit FrameJournalReader(const std::string& path);
+    ~FrameJournalReader();
+
+    FrameJournalReader(const FrameJournalReader&) = delete;
+    FrameJournalReader& operator=(const FrameJournalReader&) = delete;
+
+    bool open();
+    void close();
+
+    // Next frame, or false at the end of the journal (or its last intact block)
+    bool next(JournalFrame& frame);
+    // Back to the first frame
+    void rewind();
+
+    uint64_t created_wall_ns() const { return created_wall_ns_; }
+    uint64_t created_steady_ns() const { return created_steady_ns_; }
+    uint64_t get_frames_read() const { return frames_read_; }
+    // True if reading stopped at a damaged or partially written block
+    bool is_truncated() const { return truncated_; }
+
+private:
+    bool load_block();
+
+    std::string path_;
+    int fd_{-1};
+    const uint8_t* map_{nullptr};
+    size_t size_{0};
+    size_t offset_{0};
+    std::vector<uint8_t> block_;
+    size_t block_offset_{0};
+    uint64_t created_wall_ns_{0};
+    uint64_t created_steady_ns_{0};
+    uint64_t frames_read_{0};
+    bool truncated_{false};
+};
+
+} // namespace websocket_transport
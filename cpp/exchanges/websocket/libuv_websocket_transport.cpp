@@ -1,53 +1,83 @@
 #include "libuv_websocket_transport.hpp"
 #include <iostream>
 #include <chrono>
+#include <cstring>
 #include <thread>
+#include <netdb.h>
 
 namespace websocket_transport {
 
+namespace {
+
+constexpr size_t kReadBufferSize = 64 * 1024;
+
+} // namespace
+
 // LibuvWebSocketTransport implementation
-LibuvWebSocketTransport::LibuvWebSocketTransport() {
+LibuvWebSocketTransport::LibuvWebSocketTransport()
+    : read_buffer_(std::make_unique<char[]>(kReadBufferSize)),
+      // The loop thread is woken through async_handle_, not the ring's waiter
+      send_queue_(std::make_unique<MpscRing<OutboundMessage>>(
+          1024, WaitStrategy::BUSY_SPIN, [](OutboundMessage& slot) { slot.data.reserve(1024); })) {
     std::cout << "[LIBUV_TRANSPORT] Initializing real libuv WebSocket transport" << std::endl;
     
-    // Initialize libuv loop
-    loop_ = uv_default_loop();
-    if (!loop_) {
-        std::cerr << "[LIBUV_TRANSPORT] Failed to initialize libuv loop" << std::endl;
+    // Each transport owns its loop, so connections never share an I/O thread
+    int rc = uv_loop_init(&loop_);
+    if (rc != 0) {
+        std::cerr << "[LIBUV_TRANSPORT] Failed to initialize libuv loop: " << uv_strerror(rc) << std::endl;
         return;
     }
+    loop_initialized_ = true;
     
-    // Initialize async handle for thread-safe communication
-    uv_async_init(loop_, async_handle_, on_async_callback);
-    async_handle_->data = this;
+    // Async handle for cross-thread wakeups (sends and stop requests)
+    uv_async_init(&loop_, &async_handle_, on_async_callback);
+    async_handle_.data = this;
     
     // Initialize ping timer
-    uv_timer_init(loop_, ping_timer_);
-    ping_timer_->data = this;
+    uv_timer_init(&loop_, &ping_timer_);
+    ping_timer_.data = this;
     
     // Initialize reconnect timer
-    uv_timer_init(loop_, reconnect_timer_);
-    reconnect_timer_->data = this;
+    uv_timer_init(&loop_, &reconnect_timer_);
+    reconnect_timer_.data = this;
+    
+    uv_tcp_init(&loop_, &tcp_handle_);
+    tcp_handle_.data = this;
+    tcp_initialized_ = true;
     
     std::cout << "[LIBUV_TRANSPORT] libuv initialization complete" << std::endl;
 }
 
 LibuvWebSocketTransport::~LibuvWebSocketTransport() {
     shutdown();
+    close_handles();
 }
 
 bool LibuvWebSocketTransport::connect(const std::string& url) {
     std::cout << "[LIBUV_TRANSPORT] Connecting to: " << url << std::endl;
     
+    if (is_connected()) {
+        return true;
+    }
     websocket_url_ = url;
+    if (!resolve_endpoint(url)) {
+        state_.store(WebSocketState::ERROR);
+        handle_connection_error("Cannot resolve " + url);
+        return false;
+    }
     state_.store(WebSocketState::CONNECTING);
     
-    // Start event loop thread
-    should_stop_.store(false);
-    loop_running_.store(true);
-    event_loop_thread_ = std::thread(&LibuvWebSocketTransport::event_loop_thread_func, this);
+    // Start dispatch and event loop threads; the loop thread opens the connection
+    connect_requested_.store(true);
+    start_dispatcher();
+    start_loop_thread();
+    uv_async_send(&async_handle_);
     
     // Wait for connection to establish
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(timeout_.load());
+    while (state_.load() == WebSocketState::CONNECTING && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
     
     return state_.load() == WebSocketState::CONNECTED;
 }
@@ -56,12 +86,10 @@ void LibuvWebSocketTransport::disconnect() {
     std::cout << "[LIBUV_TRANSPORT] Disconnecting" << std::endl;
     
     state_.store(WebSocketState::DISCONNECTING);
-    should_stop_.store(true);
-    
-    if (event_loop_thread_.joinable()) {
-        event_loop_thread_.join();
-    }
+    stop_loop_thread();
+    stop_dispatcher();
     
+    connected_.store(false);
     state_.store(WebSocketState::DISCONNECTED);
 }
 
@@ -79,12 +107,22 @@ bool LibuvWebSocketTransport::send_message(const std::string& message, bool bina
         return false;
     }
     
-    // Queue message for thread-safe sending
-    {
-        std::lock_guard<std::mutex> lock(message_queue_mutex_);
-        message_queue_.push(message);
+    // Fill a preallocated slot in place; no lock and, once warm, no allocation
+    uint64_t ticket = 0;
+    OutboundMessage* slot = send_queue_->claim(ticket);
+    if (!slot) {
+        std::cerr << "[LIBUV_TRANSPORT] Cannot send message: send queue full" << std::endl;
+        return false;
+    }
+    slot->data.assign(message);
+    slot->is_binary = binary;
+    send_queue_->publish(ticket);
+    
+    // A busy-polling loop drains the ring on its own; otherwise wake it.
+    // uv_async_send coalesces, so a burst costs one wakeup.
+    if (!busy_poll_.load(std::memory_order_relaxed)) {
+        uv_async_send(&async_handle_);
     }
-    message_cv_.notify_one();
     
     return true;
 }
@@ -128,7 +166,7 @@ void LibuvWebSocketTransport::set_reconnect_delay(int seconds) {
 }
 
 bool LibuvWebSocketTransport::initialize() {
-    return true; // Already initialized in constructor
+    return loop_initialized_; // Loop and handles are set up in the constructor
 }
 
 void LibuvWebSocketTransport::shutdown() {
@@ -136,33 +174,55 @@ void LibuvWebSocketTransport::shutdown() {
 }
 
 void LibuvWebSocketTransport::start_event_loop() {
-    if (!loop_running_.load()) {
-        should_stop_.store(false);
-        loop_running_.store(true);
-        event_loop_thread_ = std::thread(&LibuvWebSocketTransport::event_loop_thread_func, this);
-    }
+    start_dispatcher();
+    start_loop_thread();
 }
 
 void LibuvWebSocketTransport::stop_event_loop() {
-    should_stop_.store(true);
-    if (event_loop_thread_.joinable()) {
-        event_loop_thread_.join();
-    }
-    loop_running_.store(false);
+    stop_loop_thread();
+    stop_dispatcher();
 }
 
 bool LibuvWebSocketTransport::is_event_loop_running() const {
     return loop_running_.load();
 }
 
+void LibuvWebSocketTransport::set_dispatch_queue(size_t capacity, WaitStrategy strategy) {
+    if (dispatch_running_.load()) {
+        std::cerr << "[LIBUV_TRANSPORT] Dispatch queue must be configured before connecting" << std::endl;
+        return;
+    }
+    dispatch_capacity_ = capacity;
+    dispatch_wait_ = strategy;
+}
+
+void LibuvWebSocketTransport::set_busy_poll(bool enabled) {
+    if (loop_running_.load()) {
+        std::cerr << "[LIBUV_TRANSPORT] Busy-poll mode must be configured before connecting" << std::endl;
+        return;
+    }
+    busy_poll_.store(enabled);
+}
+
 // Static callback functions
+void LibuvWebSocketTransport::on_alloc(uv_handle_t* handle, size_t, uv_buf_t* buf) {
+    LibuvWebSocketTransport* transport = static_cast<LibuvWebSocketTransport*>(handle->data);
+    *buf = uv_buf_init(transport->read_buffer_.get(), static_cast<unsigned int>(kReadBufferSize));
+}
+
 void LibuvWebSocketTransport::on_tcp_connect(uv_connect_t* req, int status) {
     LibuvWebSocketTransport* transport = static_cast<LibuvWebSocketTransport*>(req->data);
     
+    if (status == UV_ECANCELED) {
+        return;   // Closed by disconnect() before it completed
+    }
+    if (status == 0) {
+        status = uv_read_start(req->handle, on_alloc, on_tcp_read);
+    }
     if (status < 0) {
+        transport->close_connection();
         transport->state_.store(WebSocketState::ERROR);
-        transport->connected_.store(false);
-        transport->handle_connection_error("TCP connection failed: " + std::to_string(status));
+        transport->handle_connection_error(std::string("TCP connection failed: ") + uv_strerror(status));
         return;
     }
     
@@ -180,25 +240,30 @@ void LibuvWebSocketTransport::on_tcp_read(uv_stream_t* stream, ssize_t nread, co
     LibuvWebSocketTransport* transport = static_cast<LibuvWebSocketTransport*>(stream->data);
     
     if (nread < 0) {
-        if (nread != UV_EOF) {
-            transport->handle_connection_error("TCP read error: " + std::to_string(nread));
+        transport->close_connection();
+        if (nread == UV_EOF) {
+            std::cout << "[LIBUV_TRANSPORT] Connection closed by peer" << std::endl;
+            transport->state_.store(WebSocketState::DISCONNECTED);
+        } else {
+            transport->state_.store(WebSocketState::ERROR);
+            transport->handle_connection_error(std::string("TCP read error: ") + uv_strerror(static_cast<int>(nread)));
         }
         return;
     }
     
+    // buf is read_buffer_, reused for the next read
     if (nread > 0) {
-        std::string message(buf->base, nread);
-        transport->handle_websocket_message(message);
+        transport->handle_websocket_message(buf->base, static_cast<size_t>(nread));
     }
-    
-    free(buf->base);
 }
 
 void LibuvWebSocketTransport::on_tcp_write(uv_write_t* req, int status) {
-    if (status < 0) {
-        std::cerr << "[LIBUV_TRANSPORT] TCP write error: " << status << std::endl;
+    WriteRequest* write = static_cast<WriteRequest*>(req->data);
+    if (status < 0 && status != UV_ECANCELED) {
+        std::cerr << "[LIBUV_TRANSPORT] TCP write error: " << uv_strerror(status) << std::endl;
     }
-    free(req);
+    // Payload keeps its capacity for the next write
+    write->transport->write_pool_.push_back(write);
 }
 
 void LibuvWebSocketTransport::on_ping_timer(uv_timer_t* timer) {
@@ -214,30 +279,193 @@ void LibuvWebSocketTransport::on_reconnect_timer(uv_timer_t* timer) {
 void LibuvWebSocketTransport::on_async_callback(uv_async_t* handle) {
     LibuvWebSocketTransport* transport = static_cast<LibuvWebSocketTransport*>(handle->data);
     transport->process_message_queue();
+    
+    if (transport->should_stop_.load()) {
+        uv_stop(&transport->loop_);
+        return;
+    }
+    if (transport->connect_requested_.exchange(false)) {
+        transport->open_connection();
+    }
 }
 
 // Internal methods
+void LibuvWebSocketTransport::start_loop_thread() {
+    if (!loop_initialized_ || loop_running_.load()) {
+        return;
+    }
+    
+    should_stop_.store(false);
+    loop_running_.store(true);
+    event_loop_thread_ = std::thread(&LibuvWebSocketTransport::event_loop_thread_func, this);
+}
+
+void LibuvWebSocketTransport::stop_loop_thread() {
+    if (!loop_running_.load()) {
+        return;
+    }
+    
+    // The async callback sees should_stop_ and breaks out of uv_run
+    should_stop_.store(true);
+    uv_async_send(&async_handle_);
+    
+    if (event_loop_thread_.joinable()) {
+        event_loop_thread_.join();
+    }
+    loop_running_.store(false);
+}
+
 void LibuvWebSocketTransport::event_loop_thread_func() {
-    std::cout << "[LIBUV_TRANSPORT] Starting event loop thread" << std::endl;
+    bool busy_poll = busy_poll_.load();
+    std::cout << "[LIBUV_TRANSPORT] Starting event loop thread ("
+              << (busy_poll ? "busy-poll" : "blocking") << ")" << std::endl;
     
-    while (!should_stop_.load()) {
-        uv_run(loop_, UV_RUN_NOWAIT);
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    if (busy_poll) {
+        while (!should_stop_.load(std::memory_order_relaxed)) {
+            uv_run(&loop_, UV_RUN_NOWAIT);
+            process_message_queue();
+        }
+    } else {
+        // Blocks in epoll until I/O, a timer or uv_async_send; returns on uv_stop
+        uv_run(&loop_, UV_RUN_DEFAULT);
     }
     
+    // The connection does not outlive the loop; one more pass runs the close and cancelled write callbacks
+    close_connection();
+    uv_run(&loop_, UV_RUN_NOWAIT);
+    
     std::cout << "[LIBUV_TRANSPORT] Event loop thread stopped" << std::endl;
 }
 
-void LibuvWebSocketTransport::handle_websocket_message(const std::string& message) {
-    if (message_callback_) {
-        WebSocketMessage ws_message;
-        ws_message.data = message;
-        ws_message.is_binary = false;
-        ws_message.timestamp_us = std::chrono::duration_cast<std::chrono::microseconds>(
-            std::chrono::system_clock::now().time_since_epoch()).count();
-        ws_message.channel = "";
+void LibuvWebSocketTransport::handle_websocket_message(const char* data, size_t size) {
+    uint64_t now_us = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    
+    if (!inbound_queue_) {
+        if (message_callback_) {
+            WebSocketMessage ws_message;
+            ws_message.data.assign(data, size);
+            ws_message.is_binary = false;
+            ws_message.timestamp_us = now_us;
+            message_callback_(ws_message);
+        }
+        return;
+    }
+    
+    WebSocketMessage* slot = inbound_queue_->claim();
+    if (!slot) {
+        // Dispatcher is behind: wait rather than drop, so book sequencing stays intact
+        dispatch_full_.fetch_add(1, std::memory_order_relaxed);
+        while (!(slot = inbound_queue_->wait_claim(std::chrono::milliseconds(100)))) {
+            if (!dispatch_running_.load(std::memory_order_relaxed)) return;
+        }
+    }
+    slot->data.assign(data, size);
+    slot->is_binary = false;
+    slot->timestamp_us = now_us;
+    inbound_queue_->publish();
+}
+
+void LibuvWebSocketTransport::start_dispatcher() {
+    if (dispatch_capacity_ == 0 || dispatch_running_.load()) {
+        return;
+    }
+    
+    inbound_queue_ = std::make_unique<SpscRing<WebSocketMessage>>(
+        dispatch_capacity_, dispatch_wait_, [](WebSocketMessage& slot) { slot.data.reserve(4096); });
+    dispatch_running_.store(true);
+    dispatch_thread_ = std::thread(&LibuvWebSocketTransport::dispatch_thread_func, this);
+}
+
+void LibuvWebSocketTransport::stop_dispatcher() {
+    if (!dispatch_running_.exchange(false)) {
+        return;
+    }
+    
+    inbound_queue_->wake_consumer();
+    if (dispatch_thread_.joinable()) {
+        dispatch_thread_.join();
+    }
+    inbound_queue_.reset();
+}
+
+void LibuvWebSocketTransport::dispatch_thread_func() {
+    while (dispatch_running_.load(std::memory_order_relaxed)) {
+        WebSocketMessage* message = inbound_queue_->wait_front(std::chrono::milliseconds(100));
+        if (!message) {
+            continue;
+        }
         
-        message_callback_(ws_message);
+        if (message_callback_) {
+            try {
+                message_callback_(*message);
+            } catch (const std::exception& e) {
+                std::cerr << "[LIBUV_TRANSPORT] Message callback error: " << e.what() << std::endl;
+            }
+        }
+        inbound_queue_->pop();
+    }
+}
+
+bool LibuvWebSocketTransport::resolve_endpoint(const std::string& url) {
+    // scheme://host[:port][/path]; the port defaults from the scheme
+    std::string rest = url;
+    std::string port = "80";
+    size_t scheme_end = rest.find("://");
+    if (scheme_end != std::string::npos) {
+        std::string scheme = rest.substr(0, scheme_end);
+        if (scheme == "wss" || scheme == "https") {
+            port = "443";
+        }
+        rest = rest.substr(scheme_end + 3);
+    }
+    std::string host = rest.substr(0, rest.find('/'));
+    size_t colon = host.rfind(':');
+    if (colon != std::string::npos) {
+        port = host.substr(colon + 1);
+        host = host.substr(0, colon);
+    }
+    if (host.empty()) {
+        return false;
+    }
+    
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* result = nullptr;
+    if (getaddrinfo(host.c_str(), port.c_str(), &hints, &result) != 0 || !result) {
+        return false;
+    }
+    std::memcpy(&peer_addr_, result->ai_addr, result->ai_addrlen);
+    freeaddrinfo(result);
+    return true;
+}
+
+void LibuvWebSocketTransport::open_connection() {
+    // The handle is closed with each connection and set up again for the next
+    if (!tcp_initialized_) {
+        uv_tcp_init(&loop_, &tcp_handle_);
+        tcp_handle_.data = this;
+        tcp_initialized_ = true;
+    }
+    uv_tcp_nodelay(&tcp_handle_, 1);
+    
+    connect_req_.data = this;
+    int rc = uv_tcp_connect(&connect_req_, &tcp_handle_, reinterpret_cast<const sockaddr*>(&peer_addr_),
+                            on_tcp_connect);
+    if (rc < 0) {
+        close_connection();
+        state_.store(WebSocketState::ERROR);
+        handle_connection_error(std::string("TCP connect failed: ") + uv_strerror(rc));
+    }
+}
+
+void LibuvWebSocketTransport::close_connection() {
+    connected_.store(false);
+    if (tcp_initialized_) {
+        // Pending writes and a pending connect complete with UV_ECANCELED
+        uv_close(reinterpret_cast<uv_handle_t*>(&tcp_handle_), nullptr);
+        tcp_initialized_ = false;
     }
 }
 
@@ -255,16 +483,65 @@ void LibuvWebSocketTransport::schedule_reconnect() {
 }
 
 void LibuvWebSocketTransport::process_message_queue() {
-    std::lock_guard<std::mutex> lock(message_queue_mutex_);
+    // Loop thread is the ring's only consumer
+    while (OutboundMessage* message = send_queue_->front()) {
+        write_message(*message);
+        send_queue_->pop();
+    }
+}
+
+void LibuvWebSocketTransport::write_message(OutboundMessage& message) {
+    if (!connected_.load()) {
+        std::cerr << "[LIBUV_TRANSPORT] Dropping message: not connected" << std::endl;
+        return;
+    }
     
-    while (!message_queue_.empty()) {
-        std::string message = message_queue_.front();
-        message_queue_.pop();
-        
-        // Send message via WebSocket
-        // This would need actual WebSocket sending implementation
-        std::cout << "[LIBUV_TRANSPORT] Sending message: " << message << std::endl;
+    WriteRequest* write;
+    if (write_pool_.empty()) {
+        write = new WriteRequest();
+        write->req.data = write;
+        write->transport = this;
+    } else {
+        write = write_pool_.back();
+        write_pool_.pop_back();
+    }
+    
+    // Swap rather than copy: the ring slot takes the pooled buffer back for reuse.
+    // Payload goes out as-is; websocket framing belongs to the handshake layer,
+    // which this transport does not implement yet.
+    std::swap(write->payload, message.data);
+    uv_buf_t buf = uv_buf_init(write->payload.data(), static_cast<unsigned int>(write->payload.size()));
+    int rc = uv_write(&write->req, reinterpret_cast<uv_stream_t*>(&tcp_handle_), &buf, 1, on_tcp_write);
+    if (rc < 0) {
+        std::cerr << "[LIBUV_TRANSPORT] TCP write failed: " << uv_strerror(rc) << std::endl;
+        write_pool_.push_back(write);
+    }
+}
+
+void LibuvWebSocketTransport::close_handles() {
+    if (!loop_initialized_) {
+        return;
+    }
+    
+    uv_close(reinterpret_cast<uv_handle_t*>(&async_handle_), nullptr);
+    uv_close(reinterpret_cast<uv_handle_t*>(&ping_timer_), nullptr);
+    uv_close(reinterpret_cast<uv_handle_t*>(&reconnect_timer_), nullptr);
+    if (tcp_initialized_) {
+        uv_close(reinterpret_cast<uv_handle_t*>(&tcp_handle_), nullptr);
+        tcp_initialized_ = false;
+    }
+    
+    // Let the close callbacks (and any write callbacks) run, then release the loop
+    uv_run(&loop_, UV_RUN_DEFAULT);
+    if (uv_loop_close(&loop_) != 0) {
+        std::cerr << "[LIBUV_TRANSPORT] Loop closed with active handles" << std::endl;
+    }
+    loop_initialized_ = false;
+    
+    for (WriteRequest* write : write_pool_) {
+        delete write;
     }
+    write_pool_.clear();
 }
 
 } // namespace websocket_transport
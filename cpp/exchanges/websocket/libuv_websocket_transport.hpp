@@ -1,17 +1,27 @@
 #pragma once
 #include "i_websocket_transport.hpp"
+#include "../../utils/lockfree/spsc_ring.hpp"
+#include "../../utils/lockfree/mpsc_ring.hpp"
 #include <atomic>
+#include <memory>
 #include <thread>
-#include <mutex>
-#include <queue>
-#include <condition_variable>
+#include <vector>
+#include <sys/socket.h>
 
 // Include libuv headers directly
 #include <uv.h>
 
 namespace websocket_transport {
 
-// Real libuv implementation
+/**
+ * Real libuv implementation
+ *
+ * connect() resolves the URL's host and port on the calling thread; the
+ * loop thread then opens the TCP connection and reads from it. Stopping
+ * the loop (disconnect(), stop_event_loop(), shutdown()) closes the
+ * connection, and a later connect() opens a new one. TLS and websocket
+ * framing are not implemented yet: payloads go over plain TCP as-is.
+ */
 class LibuvWebSocketTransport : public IWebSocketTransport {
 public:
     LibuvWebSocketTransport();
@@ -42,19 +52,67 @@ public:
     void start_event_loop() override;
     void stop_event_loop() override;
     bool is_event_loop_running() const override;
+    
+    /**
+     * Hand received messages to a dispatch thread through a lock-free ring
+     * instead of running the message callback (and its parsing) on the I/O
+     * thread. Slots are reused, so delivery does not allocate once warm.
+     *
+     * @param capacity Ring slots; 0 delivers inline on the I/O thread
+     * @param strategy How the dispatch thread waits for messages
+     * @note Call before connect() / start_event_loop().
+     */
+    void set_dispatch_queue(size_t capacity, WaitStrategy strategy = WaitStrategy::FUTEX);
+    
+    // Times the I/O thread found the dispatch ring full and had to wait
+    uint64_t get_dispatch_full_count() const { return dispatch_full_.load(std::memory_order_relaxed); }
+    
+    /**
+     * Spin the event loop (UV_RUN_NOWAIT back to back) instead of blocking
+     * in epoll, and drain sends on every pass instead of waking the loop
+     * through the async handle. Burns a core; meant for latency-critical
+     * private (order entry) channels, ideally paired with a BUSY_SPIN
+     * dispatch queue.
+     *
+     * @note Call before connect() / start_event_loop().
+     */
+    void set_busy_poll(bool enabled);
+    bool is_busy_poll() const { return busy_poll_.load(std::memory_order_relaxed); }
+    
+    // Sends rejected because the outbound ring was full
+    uint64_t get_send_full_count() const { return send_queue_->get_full_count(); }
 
 private:
-    // libuv components
-    uv_loop_t* loop_;
-    uv_async_t* async_handle_;
-    uv_timer_t* ping_timer_;
-    uv_timer_t* reconnect_timer_;
-    uv_tcp_t* tcp_handle_;
+    // Outbound message as queued by send_message() on any thread
+    struct OutboundMessage {
+        std::string data;
+        bool is_binary{false};
+    };
+    
+    // Write request and the buffer it points at, kept alive until on_tcp_write
+    struct WriteRequest {
+        uv_write_t req;
+        std::string payload;
+        LibuvWebSocketTransport* transport;
+    };
+    
+    // libuv components, owned by this transport (never uv_default_loop())
+    uv_loop_t loop_;
+    uv_async_t async_handle_;
+    uv_timer_t ping_timer_;
+    uv_timer_t reconnect_timer_;
+    uv_tcp_t tcp_handle_;
+    uv_connect_t connect_req_;
+    bool loop_initialized_{false};
+    bool tcp_initialized_{false};   // Loop thread once it runs
     
     // WebSocket connection
     std::string websocket_url_;
-    std::atomic<bool> connected_;
-    std::atomic<WebSocketState> state_;
+    sockaddr_storage peer_addr_{};                  // Resolved by connect(), used on the loop thread
+    std::atomic<bool> connect_requested_{false};
+    std::unique_ptr<char[]> read_buffer_;           // Reused for every read; messages are copied out
+    std::atomic<bool> connected_{false};
+    std::atomic<WebSocketState> state_{WebSocketState::DISCONNECTED};
     
     // Callbacks
     WebSocketMessageCallback message_callback_;
@@ -62,23 +120,32 @@ private:
     WebSocketConnectCallback connect_callback_;
     
     // Configuration
-    std::atomic<int> ping_interval_;
-    std::atomic<int> timeout_;
-    std::atomic<int> reconnect_attempts_;
-    std::atomic<int> reconnect_delay_;
-    std::atomic<int> current_reconnect_attempts_;
+    std::atomic<int> ping_interval_{30};
+    std::atomic<int> timeout_{10};
+    std::atomic<int> reconnect_attempts_{5};
+    std::atomic<int> reconnect_delay_{5};
+    std::atomic<int> current_reconnect_attempts_{0};
     
     // Event loop management
     std::thread event_loop_thread_;
-    std::atomic<bool> should_stop_;
-    std::atomic<bool> loop_running_;
+    std::atomic<bool> should_stop_{false};
+    std::atomic<bool> loop_running_{false};
+    std::atomic<bool> busy_poll_{false};
+    
+    // Inbound dispatch: I/O thread -> SPSC ring -> dispatch thread -> message_callback_
+    std::unique_ptr<SpscRing<WebSocketMessage>> inbound_queue_;
+    std::thread dispatch_thread_;
+    std::atomic<bool> dispatch_running_{false};
+    size_t dispatch_capacity_{4096};
+    WaitStrategy dispatch_wait_{WaitStrategy::FUTEX};
+    std::atomic<uint64_t> dispatch_full_{0};
     
-    // Message queue for thread-safe communication
-    std::queue<std::string> message_queue_;
-    std::mutex message_queue_mutex_;
-    std::condition_variable message_cv_;
+    // Outbound: any thread -> MPSC ring -> uv_async_t wakeup -> uv_write on the loop thread
+    std::unique_ptr<MpscRing<OutboundMessage>> send_queue_;
+    std::vector<WriteRequest*> write_pool_;   // Loop thread only
     
     // libuv callbacks
+    static void on_alloc(uv_handle_t* handle, size_t suggested_size, uv_buf_t* buf);
     static void on_tcp_connect(uv_connect_t* req, int status);
     static void on_tcp_read(uv_stream_t* stream, ssize_t nread, const uv_buf_t* buf);
     static void on_tcp_write(uv_write_t* req, int status);
@@ -87,11 +154,21 @@ private:
     static void on_async_callback(uv_async_t* handle);
     
     // Internal methods
+    bool resolve_endpoint(const std::string& url);
+    void open_connection();    // Loop thread
+    void close_connection();   // Loop thread
+    void start_loop_thread();
+    void stop_loop_thread();
     void event_loop_thread_func();
-    void handle_websocket_message(const std::string& message);
+    void handle_websocket_message(const char* data, size_t size);
+    void start_dispatcher();
+    void stop_dispatcher();
+    void dispatch_thread_func();
     void handle_connection_error(const std::string& error);
     void schedule_reconnect();
     void process_message_queue();
+    void write_message(OutboundMessage& message);
+    void close_handles();
 };
 
 } // namespace websocket_transport
@@ -1,13 +1,44 @@
 #include "market_server_lib.hpp"
 #include "../exchanges/subscriber_factory.hpp"
+#include "../exchanges/websocket/websocket_transport.hpp"
+#include "../exchanges/websocket/capturing_websocket_transport.hpp"
 #include "../utils/zmq/zmq_publisher.hpp"
 #include "../utils/config/process_config_manager.hpp"
 #include "../utils/logging/logger.hpp"
+#include "../utils/logging/binary_logger.hpp"
+#include "../utils/metrics/latency_trace.hpp"
+#include "../utils/mds/market_data_topics.hpp"
+#include "../utils/mds/orderbook_binary.hpp"
+#include "../utils/app_service/thread_placement.hpp"
+#include <algorithm>
+#include <sstream>
 #include <thread>
 #include <stdexcept>
 
 namespace market_server {
 
+namespace {
+
+std::vector<std::string> split_list(const std::string& value) {
+    std::vector<std::string> items;
+    std::stringstream ss(value);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        size_t first = item.find_first_not_of(" \t");
+        if (first == std::string::npos) continue;
+        size_t last = item.find_last_not_of(" \t");
+        items.push_back(item.substr(first, last - first + 1));
+    }
+    return items;
+}
+
+std::string to_upper(std::string value) {
+    std::transform(value.begin(), value.end(), value.begin(), ::toupper);
+    return value;
+}
+
+} // namespace
+
 MarketServerLib::MarketServerLib() 
     : running_(false), exchange_name_(""), symbol_("") {
 }
@@ -28,36 +59,140 @@ bool MarketServerLib::initialize(const std::string& config_file) {
             return false;
         }
         
-        // Load configuration values (only override if not explicitly set)
+        max_depth_ = config_manager_->get_int("GLOBAL", "MAX_DEPTH", max_depth_);
+        publish_endpoint_ = config_manager_->get_string("GLOBAL", "MD_PUB_ENDPOINT", publish_endpoint_);
+        frame_pool_size_ = static_cast<size_t>(std::max(0, config_manager_->get_int(
+            "GLOBAL", "MD_FRAME_POOL_SIZE", static_cast<int>(frame_pool_size_))));
+        
+        std::string wire_format = config_manager_->get_string("GLOBAL", "MD_WIRE_FORMAT", "protobuf");
+        if (wire_format == "binary") {
+            wire_format_ = WireFormat::BINARY;
+        } else if (wire_format == "both") {
+            wire_format_ = WireFormat::BOTH;
+        } else if (wire_format != "protobuf") {
+            logger.warn("Unknown MD_WIRE_FORMAT '" + wire_format + "', using protobuf");
+        }
+        
+        std::string transport = config_manager_->get_string("GLOBAL", "MD_TRANSPORT", "zmq");
+        if (transport == "shm") {
+            transport_ = Transport::SHM;
+        } else if (transport == "both") {
+            transport_ = Transport::BOTH;
+        } else if (transport != "zmq") {
+            logger.warn("Unknown MD_TRANSPORT '" + transport + "', using zmq");
+        }
+        shm_name_ = config_manager_->get_string("GLOBAL", "MD_SHM_NAME", shm_name_);
+    }
+    
+    if (wire_format_ != WireFormat::PROTOBUF && max_depth_ > static_cast<int>(md_binary::kDefaultBookDepth)) {
+        logger.warn("MAX_DEPTH " + std::to_string(max_depth_) + " exceeds the binary book depth of " +
+                    std::to_string(md_binary::kDefaultBookDepth) + "; binary books are truncated");
+    }
+    
+    // Explicit set_exchange()/set_symbol() take precedence over the config file
+    if (!exchange_name_.empty() || !symbol_.empty()) {
         if (exchange_name_.empty()) {
-            exchange_name_ = config_manager_->get_string("market_server.exchange", "");
+            logger.error("ERROR: Exchange name not configured. Set it via set_exchange() or config file ([GLOBAL] EXCHANGES)");
+            throw std::runtime_error("Exchange name not configured");
         }
         if (symbol_.empty()) {
-            symbol_ = config_manager_->get_string("market_server.symbol", "");
+            logger.error("ERROR: Symbol not configured. Set it via set_symbol() or config file ([<EXCHANGE>] SYMBOLS)");
+            throw std::runtime_error("Symbol not configured");
         }
+        add_subscription(exchange_name_, symbol_);
+    } else if (venues_.empty() && config_manager_) {
+        load_venue_configs();
     }
     
     // Validate required configuration
-    if (exchange_name_.empty()) {
-        logger.error("ERROR: Exchange name not configured. Set it via set_exchange() or config file (market_server.exchange)");
+    if (venues_.empty()) {
+        logger.error("ERROR: No subscriptions configured. Use set_exchange()/set_symbol(), add_subscription() or [GLOBAL] EXCHANGES");
         throw std::runtime_error("Exchange name not configured");
     }
     
-    if (symbol_.empty()) {
-        logger.error("ERROR: Symbol not configured. Set it via set_symbol() or config file (market_server.symbol)");
-        throw std::runtime_error("Symbol not configured");
+    // Initialize ZMQ publisher unless one was injected
+    if (!publisher_ && transport_ != Transport::SHM) {
+        publisher_ = std::make_shared<ZmqPublisher>(publish_endpoint_, 1000, false, frame_pool_size_);
     }
     
-    // Initialize ZMQ publisher
-    publisher_ = std::make_shared<ZmqPublisher>("tcp://127.0.0.1:5555");
+    // Shared-memory bus for same-host consumers unless one was injected
+    if (!shm_publisher_ && transport_ != Transport::ZMQ) {
+        shm_publisher_ = std::make_shared<shm_md::ShmMdPublisher>(shm_name_);
+        logger.info("Publishing market data to shared memory: " + shm_name_);
+    }
     
-    // Setup exchange subscriber
-    setup_exchange_subscriber();
+    // Setup one exchange subscriber per venue
+    for (auto& venue : venues_) {
+        setup_exchange_subscriber(*venue);
+        
+        std::string symbols;
+        for (const auto& symbol : venue->config.symbols) {
+            symbols += (symbols.empty() ? "" : ",") + symbol;
+        }
+        logger.info("Initialized venue: " + venue->config.exchange + ", symbols: " + symbols +
+                    ", cpu_core: " + std::to_string(venue->config.cpu_core));
+    }
     
-    logger.info("Initialized with exchange: " + exchange_name_ + ", symbol: " + symbol_);
     return true;
 }
 
+void MarketServerLib::load_venue_configs() {
+    // [GLOBAL] EXCHANGES=BINANCE,DERIBIT selects venues; each [<EXCHANGE>]
+    // section lists SYMBOLS (or the legacy single SYMBOL), CPU_CORE and CAPTURE_FILE
+    std::string global_symbol = config_manager_->get_string("GLOBAL", "SYMBOL", "");
+    for (const auto& exchange : split_list(config_manager_->get_string("GLOBAL", "EXCHANGES", ""))) {
+        std::string section = to_upper(exchange);
+        std::string symbols = config_manager_->get_string(section, "SYMBOLS",
+                                  config_manager_->get_string(section, "SYMBOL", global_symbol));
+        int cpu_core = config_manager_->get_int(section, "CPU_CORE", -1);
+        for (const auto& symbol : split_list(symbols)) {
+            add_subscription(exchange, symbol, cpu_core);
+        }
+        std::string capture_file = config_manager_->get_string(section, "CAPTURE_FILE", "");
+        Venue* venue = find_venue(exchange);
+        if (venue && !capture_file.empty()) {
+            venue->config.capture_file = capture_file;
+        }
+    }
+}
+
+void MarketServerLib::add_subscription(const std::string& exchange, const std::string& symbol, int cpu_core) {
+    Venue* venue = find_venue(exchange);
+    if (!venue) {
+        auto created = std::make_unique<Venue>();
+        created->config.exchange = exchange;
+        created->config.cpu_core = cpu_core;
+        venue = created.get();
+        venues_.push_back(std::move(created));
+    } else if (cpu_core >= 0) {
+        venue->config.cpu_core = cpu_core;
+    }
+    
+    auto& symbols = venue->config.symbols;
+    if (std::find(symbols.begin(), symbols.end(), symbol) == symbols.end()) {
+        symbols.push_back(symbol);
+    }
+}
+
+std::vector<MarketServerLib::VenueConfig> MarketServerLib::get_venue_configs() const {
+    std::vector<VenueConfig> configs;
+    configs.reserve(venues_.size());
+    for (const auto& venue : venues_) {
+        configs.push_back(venue->config);
+    }
+    return configs;
+}
+
+MarketServerLib::Venue* MarketServerLib::find_venue(const std::string& exchange) {
+    std::string wanted = to_upper(exchange);
+    for (auto& venue : venues_) {
+        if (to_upper(venue->config.exchange) == wanted) {
+            return venue.get();
+        }
+    }
+    return nullptr;
+}
+
 void MarketServerLib::start() {
     logging::Logger logger("MARKET_SERVER_LIB");
     if (running_.load()) {
@@ -67,26 +202,22 @@ void MarketServerLib::start() {
     
     running_.store(true);
     
-    if (exchange_subscriber_) {
-        logger.info("Starting exchange subscriber...");
-        
-        // Connect and subscribe to orderbook
-        if (exchange_subscriber_->connect()) {
-            logger.info("Connected to exchange");
-            
-            // Subscribe to orderbook for the configured symbol
-            if (!symbol_.empty()) {
-                exchange_subscriber_->subscribe_orderbook(symbol_, 20, 100);
-                logger.info("Subscribed to orderbook for: " + symbol_);
-            }
-        } else {
-            logger.error("Failed to connect to exchange");
-        }
-        
-        exchange_subscriber_->start();
+    // Each venue connects and subscribes on its own thread; wait until all
+    // of them are up so callers observe the same state as before
+    {
+        std::lock_guard<std::mutex> lock(venue_mutex_);
+        venues_started_ = 0;
+    }
+    for (auto& venue : venues_) {
+        Venue* v = venue.get();
+        v->thread = std::thread([this, v]() { venue_thread_func(*v); });
+    }
+    {
+        std::unique_lock<std::mutex> lock(venue_mutex_);
+        venue_cv_.wait(lock, [this] { return venues_started_ == venues_.size(); });
     }
     
-    logger.info("Started successfully");
+    logger.info("Started successfully with " + std::to_string(venues_.size()) + " venue(s)");
 }
 
 void MarketServerLib::stop() {
@@ -95,96 +226,215 @@ void MarketServerLib::stop() {
         return;
     }
     
-    running_.store(false);
+    {
+        std::lock_guard<std::mutex> lock(venue_mutex_);
+        running_.store(false);
+    }
+    venue_cv_.notify_all();
     
-    if (exchange_subscriber_) {
-        logger.info("Stopping exchange subscriber...");
-        exchange_subscriber_->stop();
+    for (auto& venue : venues_) {
+        if (venue->thread.joinable()) {
+            venue->thread.join();
+        }
     }
     
     logger.info("Stopped");
 }
 
+void MarketServerLib::venue_thread_func(Venue& venue) {
+    logging::Logger logger("MARKET_SERVER_LIB");
+    // Threads the subscriber spawns from here (e.g. the transport event loop) inherit the placement
+    app_service::ThreadPlacement::instance().place_current_thread("md_" + venue.config.exchange, venue.config.cpu_core);
+    
+    if (venue.subscriber) {
+        logger.info("Starting exchange subscriber for " + venue.config.exchange + "...");
+        
+        // Connect and subscribe to orderbook
+        if (venue.subscriber->connect()) {
+            logger.info("Connected to " + venue.config.exchange);
+            
+            for (const auto& symbol : venue.config.symbols) {
+                venue.subscriber->subscribe_orderbook(symbol, max_depth_, 100);
+                logger.info("Subscribed to orderbook for: " + venue.config.exchange + ":" + symbol);
+            }
+        } else {
+            logger.error("Failed to connect to " + venue.config.exchange);
+        }
+        
+        venue.subscriber->start();
+    }
+    
+    // Report started, then park until stop(); the subscriber's own I/O runs
+    // on threads spawned above and inherits this thread's placement
+    std::unique_lock<std::mutex> lock(venue_mutex_);
+    ++venues_started_;
+    venue_cv_.notify_all();
+    venue_cv_.wait(lock, [this] { return !running_.load(); });
+    lock.unlock();
+    
+    if (venue.subscriber) {
+        logger.info("Stopping exchange subscriber for " + venue.config.exchange + "...");
+        venue.subscriber->stop();
+    }
+}
+
 bool MarketServerLib::is_connected_to_exchange() const {
-    return exchange_subscriber_ && exchange_subscriber_->is_connected();
+    if (venues_.empty()) {
+        return false;
+    }
+    for (const auto& venue : venues_) {
+        if (!venue->subscriber || !venue->subscriber->is_connected()) {
+            return false;
+        }
+    }
+    return true;
 }
 
 void MarketServerLib::set_websocket_transport(std::unique_ptr<websocket_transport::IWebSocketTransport> transport) {
+    std::string exchange = exchange_name_;
+    if (exchange.empty() && !venues_.empty()) {
+        exchange = venues_.front()->config.exchange;
+    }
+    set_websocket_transport(exchange, std::move(transport));
+}
+
+void MarketServerLib::set_websocket_transport(const std::string& exchange,
+                                              std::unique_ptr<websocket_transport::IWebSocketTransport> transport) {
     logging::Logger logger("MARKET_SERVER_LIB");
-    logger.debug("Setting custom WebSocket transport for testing");
+    logger.debug("Setting custom WebSocket transport for testing: " + exchange);
+    
+    Venue* venue = find_venue(exchange);
+    if (!venue) {
+        // Not initialized yet - keep the transport until the venue is created
+        auto created = std::make_unique<Venue>();
+        created->config.exchange = exchange;
+        venue = created.get();
+        venues_.push_back(std::move(created));
+    }
     
     // Store the transport for later use when creating the exchange subscriber
-    custom_transport_ = std::move(transport);
+    venue->custom_transport = std::move(transport);
     
     // Recreate the exchange subscriber with the custom transport
-    setup_exchange_subscriber();
+    if (venue->subscriber || !venue->config.symbols.empty()) {
+        setup_exchange_subscriber(*venue);
+    }
 }
 
-void MarketServerLib::setup_exchange_subscriber() {
+void MarketServerLib::setup_exchange_subscriber(Venue& venue) {
     logging::Logger logger("MARKET_SERVER_LIB");
-    logger.info("Setting up exchange subscriber for: " + exchange_name_);
+    logger.info("Setting up exchange subscriber for: " + venue.config.exchange);
     
     // Create exchange subscriber using factory
-    exchange_subscriber_ = SubscriberFactory::create_subscriber(exchange_name_);
-    if (!exchange_subscriber_) {
-        logger.error("Failed to create exchange subscriber for: " + exchange_name_);
+    venue.subscriber = SubscriberFactory::create_subscriber(venue.config.exchange);
+    if (!venue.subscriber) {
+        logger.error("Failed to create exchange subscriber for: " + venue.config.exchange);
         return;
     }
     
     // Set up callbacks
-    exchange_subscriber_->set_orderbook_callback([this](const proto::OrderBookSnapshot& orderbook) {
-        handle_orderbook_update(orderbook);
+    Venue* v = &venue;
+    venue.subscriber->set_orderbook_callback([this, v](const proto::OrderBookSnapshot& orderbook) {
+        handle_orderbook_update(*v, orderbook);
     });
     
-    exchange_subscriber_->set_trade_callback([this](const proto::Trade& trade) {
-        handle_trade_update(trade);
+    venue.subscriber->set_trade_callback([this, v](const proto::Trade& trade) {
+        handle_trade_update(*v, trade);
     });
     
-    exchange_subscriber_->set_error_callback([this](const std::string& error) {
+    venue.subscriber->set_error_callback([this](const std::string& error) {
         handle_error(error);
     });
     
+    // Capture mode: journal the venue's raw frames on the way in
+    if (!venue.config.capture_file.empty()) {
+        auto transport = venue.custom_transport ? std::move(venue.custom_transport)
+                                                : websocket_transport::WebSocketTransportFactory::create();
+        websocket_transport::FrameJournalWriter::Config journal_config;
+        journal_config.path = venue.config.capture_file;
+        venue.custom_transport = std::make_unique<websocket_transport::CapturingWebSocketTransport>(
+            std::move(transport), journal_config);
+        logger.info("Capturing " + venue.config.exchange + " frames to " + venue.config.capture_file);
+    }
+    
     // If we have a custom transport, inject it into the exchange subscriber
-    if (custom_transport_) {
+    if (venue.custom_transport) {
         logger.debug("Injecting custom WebSocket transport");
-        exchange_subscriber_->set_websocket_transport(std::move(custom_transport_));
+        venue.subscriber->set_websocket_transport(std::move(venue.custom_transport));
     }
     
     logger.debug("Exchange subscriber setup complete");
 }
 
-void MarketServerLib::handle_orderbook_update(const proto::OrderBookSnapshot& orderbook) {
+MarketServerLib::SymbolRoute& MarketServerLib::route(Venue& venue, const std::string& symbol) {
+    auto it = venue.routes.find(symbol);
+    if (it == venue.routes.end()) {
+        SymbolRoute route;
+        route.book_topic = md_topics::make_topic(md_topics::ORDERBOOK, venue.config.exchange, symbol);
+        route.binary_book_topic = md_topics::make_topic(md_topics::ORDERBOOK_BINARY, venue.config.exchange, symbol);
+        route.trade_topic = md_topics::make_topic(md_topics::TRADES, venue.config.exchange, symbol);
+        route.instrument_id = md_binary::InstrumentRegistry::instance().intern(venue.config.exchange, symbol);
+        it = venue.routes.emplace(symbol, std::move(route)).first;
+    }
+    return it->second;
+}
+
+void MarketServerLib::handle_orderbook_update(Venue& venue, const proto::OrderBookSnapshot& orderbook) {
     statistics_.orderbook_updates++;
     
-    logging::Logger logger("MARKET_SERVER_LIB");
-    logger.debug("Orderbook update: " + orderbook.symbol() + 
-                " bids: " + std::to_string(orderbook.bids_size()) + 
-                " asks: " + std::to_string(orderbook.asks_size()));
+    FAST_LOG_DEBUG("MARKET_SERVER_LIB", "Orderbook update: {} bids: {} asks: {}",
+                   orderbook.symbol(), orderbook.bids_size(), orderbook.asks_size());
     
     // Call the testing callback if set
     if (market_data_callback_) {
         market_data_callback_(orderbook);
     }
     
+    SymbolRoute& symbol_route = route(venue, orderbook.symbol());
+    const uint64_t sequence = ++symbol_route.book_sequence;
+    
+    // Same-host consumers: latest book into the shared-memory slot
+    if (shm_publisher_) {
+        shm_publisher_->publish_book(orderbook, symbol_route.instrument_id, sequence);
+    }
+    
     // Publish to ZMQ
-    publish_to_zmq("market_data", orderbook.SerializeAsString());
+    if (transport_ != Transport::SHM) {
+        if (wire_format_ != WireFormat::BINARY) {
+            publish_to_zmq(symbol_route.book_topic, orderbook);
+        }
+        if (wire_format_ != WireFormat::PROTOBUF) {
+            publish_binary_book(symbol_route, sequence, orderbook);
+        }
+    }
+    
+    if (orderbook.has_trace()) {
+        const proto::TraceContext& trace = orderbook.trace();
+        metrics::LatencyTrace::record(metrics::LatencyTrace::MD_PARSE, trace.md_recv_ns(), trace.md_parsed_ns());
+        metrics::LatencyTrace::record(metrics::LatencyTrace::MD_PUBLISH, trace.md_parsed_ns(), trace.md_publish_ns());
+    }
 }
 
-void MarketServerLib::handle_trade_update(const proto::Trade& trade) {
+void MarketServerLib::handle_trade_update(Venue& venue, const proto::Trade& trade) {
     statistics_.trade_updates++;
     
-    logging::Logger logger("MARKET_SERVER_LIB");
-    std::stringstream ss;
-    ss << "Trade update: " << trade.symbol() << " @ " << trade.price() << " qty: " << trade.qty();
-    logger.debug(ss.str());
+    FAST_LOG_DEBUG("MARKET_SERVER_LIB", "Trade update: {} @ {} qty: {}",
+                   trade.symbol(), trade.price(), trade.qty());
     
     // Call the testing callback if set
     if (trade_callback_) {
         trade_callback_(trade);
     }
     
+    SymbolRoute& symbol_route = route(venue, trade.symbol());
+    if (shm_publisher_) {
+        shm_publisher_->publish_trade(trade, symbol_route.instrument_id);
+    }
+    
     // Publish to ZMQ
-    publish_to_zmq("trades", trade.SerializeAsString());
+    if (transport_ != Transport::SHM) {
+        publish_to_zmq(symbol_route.trade_topic, trade);
+    }
 }
 
 void MarketServerLib::handle_error(const std::string& error_message) {
@@ -199,11 +449,15 @@ void MarketServerLib::handle_error(const std::string& error_message) {
     }
 }
 
-void MarketServerLib::publish_to_zmq(const std::string& topic, const std::string& message) {
-    logging::Logger logger("MARKET_SERVER_LIB");
+template <typename Message>
+void MarketServerLib::publish_to_zmq(const std::string& topic, const Message& message) {
     if (publisher_) {
-        logger.debug("Publishing to 0MQ topic: " + topic + " size: " + std::to_string(message.size()) + " bytes");
-        bool success = publisher_->publish(topic, message);
+        // Serialized straight into a pooled frame and handed to ZMQ without a copy
+        bool success;
+        {
+            std::lock_guard<std::mutex> lock(publish_mutex_);
+            success = publisher_->send_message(topic, message);
+        }
         if (success) {
             statistics_.zmq_messages_sent++;
         } else {
@@ -211,7 +465,32 @@ void MarketServerLib::publish_to_zmq(const std::string& topic, const std::string
             // Warning already logged by ZmqPublisher
         }
     } else {
+        // Only built here: the component name outgrows the short-string buffer and would allocate per message
+        logging::Logger logger("MARKET_SERVER_LIB");
+        logger.error("No publisher available!");
+    }
+}
+
+void MarketServerLib::publish_binary_book(const SymbolRoute& route, uint64_t sequence,
+                                          const proto::OrderBookSnapshot& orderbook) {
+    if (!publisher_) {
+        logging::Logger logger("MARKET_SERVER_LIB");
         logger.error("No publisher available!");
+        return;
+    }
+    // Encoded in place into a pooled (cache-line-aligned) frame
+    bool success;
+    {
+        std::lock_guard<std::mutex> lock(publish_mutex_);
+        success = publisher_->send_serialized(route.binary_book_topic, [&](char* buffer, size_t capacity) {
+            size_t size = md_binary::DefaultBookCodec::encode(orderbook, route.instrument_id, sequence, buffer, capacity);
+            return size != 0 ? size : ZmqPublisher::WRITE_FAILED;
+        });
+    }
+    if (success) {
+        statistics_.zmq_messages_sent++;
+    } else {
+        statistics_.zmq_messages_dropped++;
     }
 }
 
@@ -1,6 +1,8 @@
 #pragma once
 #include <memory>
 #include <string>
+#include <vector>
+#include <unordered_map>
 #include <atomic>
 #include <functional>
 #include <thread>
@@ -10,22 +12,37 @@
 #include "../exchanges/subscriber_factory.hpp"
 #include "../exchanges/websocket/i_websocket_transport.hpp"
 #include "../utils/zmq/zmq_publisher.hpp"
+#include "../utils/shm/shm_md_bus.hpp"
 #include "../utils/config/process_config_manager.hpp"
 
 namespace market_server {
 
 /**
  * Market Server Library
- * 
+ *
  * Core market data processing logic that can be used as:
  * 1. Library for testing and integration
  * 2. Standalone process for production deployment
- * 
+ *
  * Responsibilities:
  * - Connect to exchange WebSocket streams
  * - Process market data (orderbook, trades)
  * - Normalize data across exchanges
  * - Publish to ZMQ for downstream consumers
+ *
+ * A single instance hosts any number of venues. Each venue owns one
+ * exchange subscriber (covering all of its symbols) driven from its own,
+ * optionally CPU-pinned, thread; all venues feed one shared publisher.
+ * Topics follow md_topics::make_topic(), e.g. "market_data.BINANCE.BTCUSDT|".
+ *
+ * Books go out as protobuf, as fixed-layout md_binary books on the
+ * "book_bin" channel, or both ([GLOBAL] MD_WIRE_FORMAT). Binary-capable
+ * consumers subscribe to both channels and switch once binary books
+ * arrive; "both" keeps protobuf-only consumers working meanwhile.
+ *
+ * Consumers on the same host can instead read the shared-memory bus
+ * (shm_md, [GLOBAL] MD_TRANSPORT=shm|both): latest book per instrument and
+ * a trade ring, with no socket on the path.
  */
 class MarketServerLib {
 public:
@@ -38,10 +55,32 @@ public:
     void stop();
     bool is_running() const { return running_.load(); }
 
-    // Configuration
+    // Per-venue subscription settings
+    struct VenueConfig {
+        std::string exchange;
+        std::vector<std::string> symbols;
+        int cpu_core{-1};   // Core to pin the venue thread to (-1 = unpinned)
+        std::string capture_file;   // Journal every inbound frame here (empty = no capture)
+    };
+
+    // Wire format for order books; trades are always protobuf
+    enum class WireFormat { PROTOBUF, BINARY, BOTH };
+    // Where market data goes: ZMQ, the same-host shared-memory bus, or both
+    enum class Transport { ZMQ, SHM, BOTH };
+
+    // Configuration (single venue, backward compatible)
     void set_exchange(const std::string& exchange) { exchange_name_ = exchange; }
     void set_symbol(const std::string& symbol) { symbol_ = symbol; }
     void set_zmq_publisher(std::shared_ptr<ZmqPublisher> publisher) { publisher_ = publisher; }
+    void set_wire_format(WireFormat format) { wire_format_ = format; }
+    WireFormat get_wire_format() const { return wire_format_; }
+    void set_transport(Transport transport) { transport_ = transport; }
+    Transport get_transport() const { return transport_; }
+    void set_shm_publisher(std::shared_ptr<shm_md::ShmMdPublisher> publisher) { shm_publisher_ = publisher; }
+
+    // Configuration (multi venue); repeated calls for one exchange merge symbols
+    void add_subscription(const std::string& exchange, const std::string& symbol, int cpu_core = -1);
+    std::vector<VenueConfig> get_venue_configs() const;
 
     // Event callbacks for testing
     using MarketDataCallback = std::function<void(const proto::OrderBookSnapshot&)>;
@@ -60,7 +99,7 @@ public:
         std::atomic<uint64_t> zmq_messages_dropped{0};
         std::atomic<uint64_t> connection_errors{0};
         std::atomic<uint64_t> parse_errors{0};
-        
+
         void reset() {
             orderbook_updates.store(0);
             trade_updates.store(0);
@@ -77,32 +116,71 @@ public:
     // Testing interface
     bool is_connected_to_exchange() const;
     void set_websocket_transport(std::unique_ptr<websocket_transport::IWebSocketTransport> transport);
+    void set_websocket_transport(const std::string& exchange,
+                                 std::unique_ptr<websocket_transport::IWebSocketTransport> transport);
 
 private:
+    // Per-symbol publishing state: topics, interned id and book sequence
+    struct SymbolRoute {
+        std::string book_topic;
+        std::string binary_book_topic;
+        std::string trade_topic;
+        uint32_t instrument_id{0};
+        uint64_t book_sequence{0};
+    };
+
+    // Runtime state of one venue. Topic strings are cached per symbol and
+    // only touched from the venue's own callback thread.
+    struct Venue {
+        VenueConfig config;
+        std::unique_ptr<IExchangeSubscriber> subscriber;
+        std::unique_ptr<websocket_transport::IWebSocketTransport> custom_transport;
+        std::thread thread;
+        std::unordered_map<std::string, SymbolRoute> routes;
+    };
+
     std::atomic<bool> running_;
     std::string exchange_name_;
     std::string symbol_;
-    
+    int max_depth_{20};
+    WireFormat wire_format_{WireFormat::PROTOBUF};
+    Transport transport_{Transport::ZMQ};
+    std::string shm_name_{shm_md::kDefaultBusName};
+    std::string publish_endpoint_{"tcp://127.0.0.1:5555"};
+    size_t frame_pool_size_{ZmqPublisher::MARKET_DATA_FRAME_POOL_SIZE};
+
     // Core components
-    std::unique_ptr<IExchangeSubscriber> exchange_subscriber_;
+    std::vector<std::unique_ptr<Venue>> venues_;
     std::shared_ptr<ZmqPublisher> publisher_;
+    std::shared_ptr<shm_md::ShmMdPublisher> shm_publisher_;
+    std::mutex publish_mutex_;   // ZMQ sockets are not thread-safe; venues publish concurrently
     std::unique_ptr<config::ProcessConfigManager> config_manager_;
-    std::unique_ptr<websocket_transport::IWebSocketTransport> custom_transport_;
-    
+
+    // Venue thread lifecycle
+    std::mutex venue_mutex_;
+    std::condition_variable venue_cv_;
+    size_t venues_started_{0};
+
     // Callbacks
     MarketDataCallback market_data_callback_;
     TradeCallback trade_callback_;
     ErrorCallback error_callback_;
-    
+
     // Statistics
     Statistics statistics_;
-    
+
     // Internal methods
-    void setup_exchange_subscriber();
-    void handle_orderbook_update(const proto::OrderBookSnapshot& orderbook);
-    void handle_trade_update(const proto::Trade& trade);
+    void load_venue_configs();
+    Venue* find_venue(const std::string& exchange);
+    void setup_exchange_subscriber(Venue& venue);
+    void venue_thread_func(Venue& venue);
+    SymbolRoute& route(Venue& venue, const std::string& symbol);
+    void handle_orderbook_update(Venue& venue, const proto::OrderBookSnapshot& orderbook);
+    void handle_trade_update(Venue& venue, const proto::Trade& trade);
     void handle_error(const std::string& error_message);
-    void publish_to_zmq(const std::string& topic, const std::string& message);
+    template <typename Message>
+    void publish_to_zmq(const std::string& topic, const Message& message);
+    void publish_binary_book(const SymbolRoute& route, uint64_t sequence, const proto::OrderBookSnapshot& orderbook);
 };
 
 } // namespace market_server
@@ -1,5 +1,6 @@
 #include "market_server_service.hpp"
 #include "../utils/logging/log_helper.hpp"
+#include <algorithm>
 
 namespace market_server {
 
@@ -8,19 +9,20 @@ MarketServerService::MarketServerService()
 }
 
 bool MarketServerService::configure_service() {
-    // Get configuration values
-    exchange_ = get_config_manager()->get_string("market.exchange", "BINANCE");
-    symbol_ = get_config_manager()->get_string("market.symbol", "BTCUSDT");
-    zmq_publish_endpoint_ = get_config_manager()->get_string("zmq.publish_endpoint", "tcp://*:5555");
+    // Get configuration values; venues and symbols are read by MarketServerLib
+    // from [GLOBAL] EXCHANGES and the per-exchange sections
+    zmq_publish_endpoint_ = get_config_manager()->get_string("GLOBAL", "MD_PUB_ENDPOINT", "tcp://*:5555");
     
-    LOG_INFO_COMP("MARKET_SERVER", "Exchange: " + exchange_);
-    LOG_INFO_COMP("MARKET_SERVER", "Symbol: " + symbol_);
     LOG_INFO_COMP("MARKET_SERVER", "ZMQ publish endpoint: " + zmq_publish_endpoint_);
     
-    // Initialize ZMQ publisher with CONFLATE enabled for market data
-    // CONFLATE keeps only the latest message - perfect for orderbook snapshots
-    // This provides true "fire-and-forget" behavior where only current state matters
-    publisher_ = std::make_shared<ZmqPublisher>(zmq_publish_endpoint_, 1000, true);
+    // One publisher shared by every venue. CONFLATE stays off: it is
+    // socket-wide, so with several instruments on one socket it would drop
+    // the latest book of every topic but one.
+    // Market data is the one high-rate publisher, so it alone preallocates zero-copy frames
+    int frame_pool_size = get_config_manager()->get_int("GLOBAL", "MD_FRAME_POOL_SIZE",
+                                                        static_cast<int>(ZmqPublisher::MARKET_DATA_FRAME_POOL_SIZE));
+    publisher_ = std::make_shared<ZmqPublisher>(zmq_publish_endpoint_, 1000, false,
+                                                static_cast<size_t>(std::max(0, frame_pool_size)));
     if (!publisher_->bind()) {
         LOG_ERROR_COMP("MARKET_SERVER", "Failed to bind ZMQ publisher");
         return false;
@@ -28,8 +30,6 @@ bool MarketServerService::configure_service() {
     
     // Initialize market server library
     market_server_lib_ = std::make_unique<MarketServerLib>();
-    market_server_lib_->set_exchange(exchange_);
-    market_server_lib_->set_symbol(symbol_);
     market_server_lib_->set_zmq_publisher(publisher_);
     
     // Initialize the library
@@ -48,7 +48,13 @@ bool MarketServerService::start_service() {
     
     market_server_lib_->start();
     
-    LOG_INFO_COMP("MARKET_SERVER", "Processing market data for " + exchange_ + ":" + symbol_);
+    for (const auto& venue : market_server_lib_->get_venue_configs()) {
+        std::string symbols;
+        for (const auto& symbol : venue.symbols) {
+            symbols += (symbols.empty() ? "" : ",") + symbol;
+        }
+        LOG_INFO_COMP("MARKET_SERVER", "Processing market data for " + venue.exchange + ": " + symbols);
+    }
     return true;
 }
 
@@ -27,8 +27,6 @@ private:
     std::unique_ptr<MarketServerLib> market_server_lib_;
     std::shared_ptr<ZmqPublisher> publisher_;
     
-    std::string exchange_;
-    std::string symbol_;
     std::string zmq_publish_endpoint_;
 };
 
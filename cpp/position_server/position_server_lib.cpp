@@ -3,6 +3,7 @@
 #include "../utils/zmq/zmq_publisher.hpp"
 #include "../utils/config/process_config_manager.hpp"
 #include "../utils/logging/logger.hpp"
+#include "../utils/app_service/thread_placement.hpp"
 #include <thread>
 
 namespace position_server {
@@ -116,7 +117,17 @@ void PositionServerLib::setup_exchange_pms() {
     logger.debug("Exchange PMS setup complete");
 }
 
+void PositionServerLib::place_update_thread() {
+    // Updates arrive on threads the exchange PMS owns; place them on first use
+    thread_local bool placed = false;
+    if (!placed) {
+        placed = true;
+        app_service::ThreadPlacement::instance().place_current_thread("pms_" + exchange_name_);
+    }
+}
+
 void PositionServerLib::handle_position_update(const proto::PositionUpdate& position) {
+    place_update_thread();
     statistics_.position_updates++;
     
     logging::Logger logger("POSITION_SERVER_LIB");
@@ -129,6 +140,7 @@ void PositionServerLib::handle_position_update(const proto::PositionUpdate& posi
 }
 
 void PositionServerLib::handle_balance_update(const proto::AccountBalanceUpdate& balance) {
+    place_update_thread();
     statistics_.balance_updates++;
     
     logging::Logger logger("POSITION_SERVER_LIB");
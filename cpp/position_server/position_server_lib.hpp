@@ -84,6 +84,8 @@ private:
     
     // Internal methods
     void setup_exchange_pms();
+    // Places the exchange thread delivering updates as pms_<exchange>, once per thread
+    void place_update_thread();
     void handle_position_update(const proto::PositionUpdate& position);
     void handle_balance_update(const proto::AccountBalanceUpdate& balance);
     void handle_error(const std::string& error_message);
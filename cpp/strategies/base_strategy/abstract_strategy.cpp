@@ -28,7 +28,7 @@ void AbstractStrategy::stop() {
     // Cancel all pending orders via order canceller callback
     std::vector<std::string> orders_to_cancel;
     {
-        std::lock_guard<std::mutex> lock(orders_mutex_);
+        std::lock_guard<StrategyMutex> lock(orders_mutex_);
         for (const auto& [cl_ord_id, order] : pending_orders_) {
             orders_to_cancel.push_back(cl_ord_id);
         }
@@ -45,7 +45,7 @@ void AbstractStrategy::stop() {
     
     // Clear pending orders
     {
-        std::lock_guard<std::mutex> lock(orders_mutex_);
+        std::lock_guard<StrategyMutex> lock(orders_mutex_);
         pending_orders_.clear();
     }
     
@@ -66,6 +66,14 @@ std::string AbstractStrategy::generate_order_id() const {
     return oss.str();
 }
 
+uint64_t AbstractStrategy::now_us() const {
+    if (clock_) {
+        return clock_();
+    }
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
 bool AbstractStrategy::is_valid_order_size(double qty) const {
     return qty > 0.0 && qty <= max_order_size_;
 }
@@ -8,6 +8,7 @@
 #include <chrono>
 #include <mutex>
 #include <optional>
+#include "strategy_mutex.hpp"
 #include "../trader/mini_pms.hpp"  // Contains full PositionInfo and AccountBalanceInfo definitions
 #include "../proto/order.pb.h"
 #include "../proto/market_data.pb.h"
@@ -51,6 +52,14 @@ public:
     virtual void set_exchange(const std::string& exchange) { exchange_ = exchange; }
     virtual void set_enabled(bool enabled) { enabled_.store(enabled); }
     
+    // Single-threaded execution (StrategyContainer's executor runs every callback on one
+    // thread): switches the strategy's state locks off. Call before events flow.
+    virtual void set_single_threaded(bool single_threaded) {
+        single_threaded_ = single_threaded;
+        orders_mutex_.set_enabled(!single_threaded);
+    }
+    bool is_single_threaded() const { return single_threaded_; }
+    
     // Getters
     const std::string& get_symbol() const { return symbol_; }
     const std::string& get_exchange() const { return exchange_; }
@@ -124,6 +133,18 @@ public:
     void set_order_canceller(OrderCanceller canceller) { order_canceller_ = canceller; }
     void set_order_modifier(OrderModifier modifier) { order_modifier_ = modifier; }
     
+    // Time source for throttles and timers, in microseconds since the epoch.
+    // Defaults to the wall clock; a backtest installs its simulated clock.
+    using Clock = std::function<uint64_t()>;
+    void set_clock(Clock clock) { clock_ = std::move(clock); }
+    
+    // Batch boundaries: order calls between begin and flush leave the process as one message
+    using OrderBatchHook = std::function<void()>;
+    void set_order_batch_hooks(OrderBatchHook begin, OrderBatchHook flush) {
+        order_batch_begin_ = std::move(begin);
+        order_batch_flush_ = std::move(flush);
+    }
+    
     // Order placement methods (use callbacks if set, otherwise return false)
     bool send_order(const std::string& cl_ord_id,
                    const std::string& symbol,
@@ -145,10 +166,27 @@ protected:
     
     // Common utility methods
     std::string generate_order_id() const;
+    uint64_t now_us() const;
     bool is_valid_order_size(double qty) const;
     bool is_valid_price(double price) const;
     bool is_within_risk_limits(double order_value) const;
     
+    // Groups the order calls of one decision (e.g. a requote) into a single batch;
+    // flushes when it goes out of scope, also if an exception unwinds it
+    class OrderBatchScope {
+    public:
+        explicit OrderBatchScope(AbstractStrategy& strategy) : strategy_(strategy) {
+            if (strategy_.order_batch_begin_) strategy_.order_batch_begin_();
+        }
+        ~OrderBatchScope() {
+            if (strategy_.order_batch_flush_) strategy_.order_batch_flush_();
+        }
+        OrderBatchScope(const OrderBatchScope&) = delete;
+        OrderBatchScope& operator=(const OrderBatchScope&) = delete;
+    private:
+        AbstractStrategy& strategy_;
+    };
+    
     // Order tracking
     struct PendingOrder {
         std::string cl_ord_id;
@@ -161,7 +199,7 @@ protected:
     };
     
     std::map<std::string, PendingOrder> pending_orders_;
-    std::mutex orders_mutex_;
+    StrategyMutex orders_mutex_;
     
     // Risk management
     double max_position_size_{1000.0};
@@ -174,6 +212,7 @@ protected:
     std::string exchange_;
     std::atomic<bool> enabled_;
     std::atomic<bool> running_;
+    bool single_threaded_{false};
     
     // Performance metrics
     mutable StrategyMetrics metrics_;
@@ -187,4 +226,7 @@ protected:
     OrderSender order_sender_;
     OrderCanceller order_canceller_;
     OrderModifier order_modifier_;
+    OrderBatchHook order_batch_begin_;
+    OrderBatchHook order_batch_flush_;
+    Clock clock_;
 };
@@ -0,0 +1,31 @@
+#pragma once
+#include <atomic>
+#include <mutex>
+
+/**
+ * Mutex for strategy state that can be switched off
+ *
+ * Strategies guard state shared between the adapter threads that deliver
+ * their events. Under StrategyContainer's executor every callback runs on
+ * the one strategy thread, so the strategy disables these locks
+ * (AbstractStrategy::set_single_threaded) and lock()/unlock() reduce to a
+ * relaxed load.
+ *
+ * @note Toggle only while no events are being delivered.
+ */
+class StrategyMutex {
+public:
+    void lock() {
+        if (enabled_.load(std::memory_order_relaxed)) mutex_.lock();
+    }
+    void unlock() {
+        if (enabled_.load(std::memory_order_relaxed)) mutex_.unlock();
+    }
+
+    void set_enabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+    bool is_enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+private:
+    std::mutex mutex_;
+    std::atomic<bool> enabled_{true};
+};
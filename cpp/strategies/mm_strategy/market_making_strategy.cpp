@@ -1,6 +1,8 @@
 #include "market_making_strategy.hpp"
 #include "../../utils/logging/logger.hpp"
+#include "../../utils/logging/binary_logger.hpp"
 #include "../../utils/exchange/exchange_symbol_registry.hpp"
+#include "models/glft_quote.hpp"
 #include <random>
 #include <sstream>
 #include <iomanip>
@@ -22,14 +24,14 @@ MarketMakingStrategy::MarketMakingStrategy(const std::string& symbol,
                                           std::shared_ptr<GlftTarget> glft_model)
     : AbstractStrategy("MarketMakingStrategy"), symbol_(symbol), glft_model_(glft_model) {
     statistics_.reset();
-    last_quote_update_time_ = std::chrono::system_clock::now() - std::chrono::seconds(10); // Initialize to allow first update
+    init_quote_manager();
 }
 
 MarketMakingStrategy::MarketMakingStrategy(const std::string& symbol,
                                           const MarketMakingStrategyConfig& config)
     : AbstractStrategy("MarketMakingStrategy"), symbol_(symbol) {
     statistics_.reset();
-    last_quote_update_time_ = std::chrono::system_clock::now() - std::chrono::seconds(10);
+    init_quote_manager();
     
     // Create GLFT model from config
     GlftTarget::Config glft_config;
@@ -87,6 +89,14 @@ void MarketMakingStrategy::apply_config(const MarketMakingStrategyConfig& config
     set_min_inventory_change_pct(config.min_inventory_change_pct);
     set_quote_update_interval_ms(config.quote_update_interval_ms);
     set_min_quote_price_change_bps(config.min_quote_price_change_bps);
+    set_amend_quotes(config.amend_quotes);
+    
+    // Apply quote ladder
+    QuoteLadder::Config ladder_config;
+    ladder_config.levels = config.quote_levels;
+    ladder_config.min_level_spacing_ticks = config.level_spacing_min_ticks;
+    ladder_config.level_size_multiplier = config.level_size_multiplier;
+    set_ladder_config(ladder_config);
     
     // Apply risk management
     set_min_spread_bps(config.min_spread_bps);
@@ -107,6 +117,33 @@ void MarketMakingStrategy::apply_config(const MarketMakingStrategyConfig& config
     flow_5m_weight_ = config.defi_flow_5m_weight;
 }
 
+void MarketMakingStrategy::init_quote_manager() {
+    // Orders go through the container callbacks, exactly as if sent directly
+    quote_manager_ = std::make_unique<QuoteManager>(
+        symbol_,
+        [this](const std::string& cl_ord_id, const std::string& symbol, proto::Side side,
+               proto::OrderType type, double qty, double price) {
+            return send_order(cl_ord_id, symbol, side, type, qty, price);
+        },
+        [this](const std::string& cl_ord_id) { return cancel_order(cl_ord_id); },
+        [this](const std::string& cl_ord_id, double new_price, double new_qty) {
+            return modify_order(cl_ord_id, new_price, new_qty);
+        },
+        [this]() { return generate_order_id(); });
+    configure_quote_manager();
+}
+
+void MarketMakingStrategy::configure_quote_manager() {
+    if (!quote_manager_) {
+        return;
+    }
+    // A side that moved less than the requote threshold keeps its order (and queue position)
+    QuoteManager::Config config = quote_manager_->get_config();
+    config.price_tolerance_bps = min_quote_price_change_bps_;
+    config.amend_enabled = amend_quotes_;
+    quote_manager_->set_config(config);
+}
+
 void MarketMakingStrategy::start() {
     if (running_.load()) {
         return;
@@ -127,6 +164,15 @@ void MarketMakingStrategy::stop() {
     // Note: Order cancellation is handled by Mini OMS
 }
 
+void MarketMakingStrategy::set_single_threaded(bool single_threaded) {
+    AbstractStrategy::set_single_threaded(single_threaded);
+    // All callbacks on the executor's thread: the book, volatility, requote and DeFi state need no locks
+    orderbook_mutex_.set_enabled(!single_threaded);
+    volatility_mutex_.set_enabled(!single_threaded);
+    quote_update_mutex_.set_enabled(!single_threaded);
+    defi_positions_mutex_.set_enabled(!single_threaded);
+}
+
 void MarketMakingStrategy::on_market_data(const proto::OrderBookSnapshot& orderbook) {
     if (!running_.load() || orderbook.symbol() != symbol_) {
         return;
@@ -141,6 +187,7 @@ void MarketMakingStrategy::on_order_event(const proto::OrderEvent& order_event)
     }
     
     std::string cl_ord_id = order_event.cl_ord_id();
+    quote_manager_->on_order_event(order_event);
     
     // Update statistics based on event
     switch (order_event.event_type()) {
@@ -336,182 +383,90 @@ void MarketMakingStrategy::update_quotes() {
     auto& symbol_registry = ExchangeSymbolRegistry::get_instance();
     double cefi_token1_tokens = 0.0;
     if (cefi.token1 != 0.0 && spot_price > 0.0) {
-        cefi_token1_tokens = symbol_registry.contracts_to_token_qty(
-            exchange_, symbol_, cefi.token1, spot_price);
+        cefi_token1_tokens = symbol_registry.contracts_to_token_qty(instrument(), cefi.token1, spot_price);
     }
     
-    // Calculate target inventory using GLFT model (CeFi-only)
-    // GLFT expects: token0 (collateral in USD), token1 (position in tokens/BTC)
-    double target_offset = glft_model_->compute_target(
+    // Net inventory for the skew: CeFi position + DeFi flow (both in contracts)
+    double defi_flow_contracts = cached_defi_flow_contracts_.load();
+    double net_inventory_contracts = cefi.token1 + defi_flow_contracts;
+    double net_inventory_tokens = 0.0;
+    if (std::abs(net_inventory_contracts) > 0.0001 && spot_price > 0.0) {
+        net_inventory_tokens = symbol_registry.contracts_to_token_qty(
+            instrument(), net_inventory_contracts, spot_price);
+    }
+    
+    double micro_price_skew = get_micro_price_skew();
+    double orderbook_imbalance = get_orderbook_imbalance();
+    double best_bid = 0.0;
+    double best_ask = 0.0;
+    {
+        std::lock_guard<StrategyMutex> lock(orderbook_mutex_);
+        best_bid = best_bid_;
+        best_ask = best_ask_;
+    }
+    
+    // GLFT target offset and bid/ask (CeFi-only), with micro price widening, net inventory
+    // skew and anti-cross applied; see models/glft_quote.hpp
+    GlftQuoteParams quote_params;
+    quote_params.glft = glft_model_->get_config();
+    quote_params.micro_price_skew_alpha = micro_price_skew_alpha_;
+    quote_params.net_inventory_skew_gamma = net_inventory_skew_gamma_;
+    GlftQuote quote = price_glft_quote(
+        quote_params,
         cefi.token0,           // Collateral in USD (CeFi only)
-        cefi_token1_tokens,   // Position in tokens (BTC), converted from contracts (CeFi only)
+        cefi_token1_tokens,    // Position in tokens (BTC), converted from contracts (CeFi only)
+        net_inventory_contracts,
+        net_inventory_tokens,
         spot_price,
+        best_bid,
+        best_ask,
+        micro_price_skew,
+        orderbook_imbalance,
         volatility
     );
+    double target_offset = quote.target_offset;
     
-    std::stringstream ss;
-    ss << "GLFT target calculation (CeFi-only):" << std::endl
-       << "  CeFi inventory - Token0 (collateral): " << cefi.token0 << " USD" << std::endl
-       << "  CeFi inventory - Token1: " << cefi.token1 << " contracts = " << cefi_token1_tokens << " tokens" << std::endl
-       << "  Spot price: " << spot_price << std::endl
-       << "  Volatility: " << volatility << std::endl
-       << "  Target offset: " << target_offset;
-    get_logger().debug(ss.str());
+    // update_quotes() runs on every book: FAST_LOG keeps formatting off the strategy thread
+    FAST_LOG_DEBUG("MARKET_MAKING",
+                   "GLFT target calculation (CeFi-only): token0 (collateral) {} USD, token1 {} contracts = {} tokens, "
+                   "spot {}, volatility {}, target offset {}",
+                   cefi.token0, cefi.token1, cefi_token1_tokens, spot_price, volatility, target_offset);
     
     // Update current inventory delta with target offset
     current_inventory_delta_.store(target_offset);
     
-    // Calculate bid/ask prices based on GLFT model (CeFi-only)
-    // The GLFT model gives us a target offset, but we need to convert this to actual bid/ask prices
-    // For market making, we place limit orders around the mid price with a spread
-    
-    // Calculate effective spread from GLFT components
-    // Use CeFi token1 in tokens (not contracts) for skew calculation
-    double normalized_skew = (cefi_token1_tokens * spot_price) / std::max(cefi.token0, 1.0);
-    double base_spread = glft_model_->get_config().base_spread;
-    double risk_aversion = glft_model_->get_config().risk_aversion;
-    double inventory_penalty = glft_model_->get_config().inventory_penalty;
-    double terminal_penalty = glft_model_->get_config().terminal_inventory_penalty;
-    
-    // Calculate spread components (matching GLFT logic)
-    double inventory_risk = risk_aversion * volatility * volatility * std::abs(normalized_skew) + 
-                           inventory_penalty * std::abs(normalized_skew);
-    double terminal_risk = terminal_penalty * (normalized_skew * normalized_skew);
-    double total_spread = base_spread + inventory_risk + terminal_risk;
-    
-    // Calculate base bid/ask prices from GLFT (CeFi-only)
-    // Mid price is the current spot price
-    double mid_price = spot_price;
-    double half_spread = total_spread * mid_price / 2.0;  // Half spread in price units
-    
-    // Adjust quotes based on GLFT target offset (CeFi-only)
-    // Negative target_offset means we want to reduce position -> widen ask (discourage buying), narrow bid (encourage selling)
-    // Positive target_offset means we want to increase position -> narrow ask (encourage buying), widen bid (discourage selling)
-    double offset_adjustment = target_offset * spot_price / std::max(cefi.token0, 1.0);  // Normalize adjustment
-    
-    double bid_price = mid_price - half_spread - offset_adjustment;  // Base bid from GLFT
-    double ask_price = mid_price + half_spread - offset_adjustment;  // Base ask from GLFT
-    
-    // Apply micro price skew signal (order flow imbalance)
-    // Widen spread based on micro price deviation from mid and orderbook imbalance
-    // This is a risk management measure - wider spread when there's order flow imbalance
-    double micro_price_skew = get_micro_price_skew();
-    double orderbook_imbalance = get_orderbook_imbalance();
-    
-    if (std::abs(micro_price_skew) > 0.0001 || std::abs(orderbook_imbalance) > 0.1) {
-        // Combine micro price deviation and orderbook imbalance
-        // Micro price deviation: |micro_price - mid_price| / mid_price
-        // Orderbook imbalance: |bid_qty - ask_qty| / (bid_qty + ask_qty)
-        double micro_deviation = std::abs(micro_price_skew);
-        double imbalance_magnitude = std::abs(orderbook_imbalance);
-        
-        // Combined signal: use max of micro price deviation and imbalance
-        // Clamp to reasonable range (max 0.5% = 50 bps)
-        double combined_signal = std::max(micro_deviation, imbalance_magnitude);
-        double clamped_signal = std::clamp(combined_signal, 0.0, 0.005);
-        
-        // Apply alpha parameter to control sensitivity
-        double adjusted_signal = clamped_signal * micro_price_skew_alpha_;
-        
-        // Widen spread symmetrically: both bid and ask move away from mid
-        // This reduces risk when there's order flow imbalance
-        double spread_widening = adjusted_signal * mid_price;
-        bid_price -= spread_widening;  // Move bid down (away from mid)
-        ask_price += spread_widening;  // Move ask up (away from mid)
-        
-        std::stringstream micro_ss;
-        micro_ss << "Applied micro price spread widening: "
-                 << "micro_dev=" << (micro_deviation * 10000) << " bps, "
-                 << "imbalance=" << (imbalance_magnitude * 100) << "%, "
-                 << "combined=" << (combined_signal * 10000) << " bps, "
-                 << "alpha=" << micro_price_skew_alpha_ 
-                 << ", final widening=" << (adjusted_signal * 10000) << " bps";
-        get_logger().debug(micro_ss.str());
+    if (quote.micro_widening != 0.0) {
+        FAST_LOG_DEBUG("MARKET_MAKING",
+                       "Applied micro price spread widening: micro_dev={} bps, imbalance={}%, alpha={}, "
+                       "final widening={} bps",
+                       std::abs(micro_price_skew) * 10000, std::abs(orderbook_imbalance) * 100,
+                       micro_price_skew_alpha_, quote.micro_widening / spot_price * 10000);
     }
     
-    // Apply net inventory skew (CeFi inventory + DeFi flow combined)
-    // Calculate net inventory: CeFi position + DeFi flow (both in contracts)
-    // Normalize as % of collateral and apply single asymmetric skew
-    double defi_flow_contracts = cached_defi_flow_contracts_.load();
-    double net_inventory_contracts = cefi.token1 + defi_flow_contracts;  // Net position in contracts
-    
-    if (std::abs(net_inventory_contracts) > 0.0001 && cefi.token0 > 0.0 && spot_price > 0.0) {
-        // Convert net inventory from contracts to tokens
-        double net_inventory_tokens = symbol_registry.contracts_to_token_qty(
-            exchange_, symbol_, net_inventory_contracts, spot_price);
-        
-        // Normalize net inventory: convert to USD value, then divide by collateral
-        // Result is unitless percentage (e.g., 0.1 = 10% of collateral)
-        double net_skew_normalized = (net_inventory_tokens * spot_price) / cefi.token0;
-        
-        // Apply gamma parameter to control sensitivity
-        double adjusted_skew_normalized = net_skew_normalized * net_inventory_skew_gamma_;
-        
-        // Calculate skew factor (max 10% skew)
-        double net_skew_factor = std::clamp(std::abs(adjusted_skew_normalized), 0.0, 0.1);
-        
-        // Calculate skew adjustment in price units
-        double skew_adjustment = net_skew_factor * mid_price;
-        
-        if (net_inventory_contracts > 0.0) {
-            // Net long position: encourage selling to bring inventory to zero
-            // Bring ask closer (narrow) = ask_price DOWN (toward mid)
-            // Widen bid = bid_price DOWN (away from mid)
-            bid_price -= skew_adjustment;  // Move bid down (wider, away from mid)
-            ask_price -= skew_adjustment;  // Move ask down (closer/narrow, toward mid)
-        } else {
-            // Net short position: encourage buying to bring inventory to zero
-            // Bring bid closer (narrow) = bid_price UP (toward mid)
-            // Widen ask = ask_price UP (away from mid)
-            bid_price += skew_adjustment;  // Move bid up (closer/narrow, toward mid)
-            ask_price += skew_adjustment;  // Move ask up (wider, away from mid)
-        }
-        
-        std::stringstream skew_ss;
-        skew_ss << "Applied net inventory skew: "
-                << "CeFi=" << cefi.token1 << " contracts, "
-                << "DeFi_flow=" << defi_flow_contracts << " contracts, "
-                << "Net=" << net_inventory_contracts << " contracts (" 
-                << net_inventory_tokens << " tokens), "
-                << "normalized: " << (net_skew_normalized * 100) << "% of collateral, "
-                << "gamma=" << net_inventory_skew_gamma_ 
-                << ", adjusted: " << (adjusted_skew_normalized * 100) << "%, "
-                << "skew factor: " << (net_skew_factor * 100) << "%";
-        get_logger().debug(skew_ss.str());
+    if (quote.inventory_skew != 0.0) {
+        FAST_LOG_DEBUG("MARKET_MAKING",
+                       "Applied net inventory skew: CeFi={} contracts, DeFi_flow={} contracts, "
+                       "Net={} contracts ({} tokens), gamma={}, skew: {}%",
+                       cefi.token1, defi_flow_contracts, net_inventory_contracts, net_inventory_tokens,
+                       net_inventory_skew_gamma_, quote.inventory_skew / spot_price * 100);
     }
     
-    // CRITICAL: Ensure quotes never cross the best bid/ask
-    // Strategy: If GLFT calculates aggressive quotes that would cross, match best bid/ask on our side
-    // This keeps us passive (not taking liquidity) while respecting GLFT's intent to be closer to market
-    {
-        std::lock_guard<std::mutex> lock(orderbook_mutex_);
-        if (best_bid_ > 0.0 && best_ask_ > 0.0) {
-            // If bid would cross best ask, set it to best bid (stay passive on bid side)
-            // GLFT wants to buy aggressively, but we match best bid to stay passive
-            if (bid_price >= best_ask_) {
-                std::stringstream ss;
-                ss << "Calculated bid (" << bid_price << ") would cross best ask (" << best_ask_ 
-                   << "). Setting to best bid (" << best_bid_ << ") to stay passive.";
-                get_logger().warn(ss.str());
-                bid_price = best_bid_; // Match best bid (passive)
-            }
-            
-            // If ask would cross best bid, set it to best ask (stay passive on ask side)
-            // GLFT wants to sell aggressively, but we match best ask to stay passive
-            if (ask_price <= best_bid_) {
-                std::stringstream ss;
-                ss << "Calculated ask (" << ask_price << ") would cross best bid (" << best_bid_ 
-                   << "). Setting to best ask (" << best_ask_ << ") to stay passive.";
-                get_logger().warn(ss.str());
-                ask_price = best_ask_; // Match best ask (passive)
-            }
-            
-            // Ensure bid < ask after adjustments
-            if (bid_price >= ask_price) {
-                get_logger().error("After anti-cross adjustments, bid >= ask. Skipping quote update to avoid invalid order.");
-                return;
-            }
-        }
+    // Quotes never cross the best bid/ask: a side that would matches its own best price (stays passive)
+    if (quote.bid_capped) {
+        FAST_LOG_WARN("MARKET_MAKING", "Calculated bid would cross best ask ({}). Setting to best bid ({}) to stay passive.",
+                      best_ask, best_bid);
+    }
+    if (quote.ask_capped) {
+        FAST_LOG_WARN("MARKET_MAKING", "Calculated ask would cross best bid ({}). Setting to best ask ({}) to stay passive.",
+                      best_bid, best_ask);
+    }
+    double mid_price = spot_price;
+    double total_spread = quote.spread;
+    double bid_price = quote.bid;
+    double ask_price = quote.ask;
+    if (best_bid > 0.0 && best_ask > 0.0 && bid_price >= ask_price) {
+        get_logger().error("After anti-cross adjustments, bid >= ask. Skipping quote update to avoid invalid order.");
+        return;
     }
     
     // Ensure prices are valid
@@ -519,7 +474,7 @@ void MarketMakingStrategy::update_quotes() {
         // Check if quotes actually need to change (avoid unnecessary flickering)
         bool quotes_changed = false;
         {
-            std::lock_guard<std::mutex> lock(quote_update_mutex_);
+            std::lock_guard<StrategyMutex> lock(quote_update_mutex_);
             
             // Check if bid/ask prices changed significantly
             if (last_quote_bid_price_ > 0.0 && last_quote_ask_price_ > 0.0) {
@@ -540,8 +495,8 @@ void MarketMakingStrategy::update_quotes() {
         
         // Only update quotes if they actually changed
         if (!quotes_changed) {
-            get_logger().debug("Quotes unchanged, skipping update (bid/ask change < " + 
-                              std::to_string(min_quote_price_change_bps_) + " bps)");
+            FAST_LOG_DEBUG("MARKET_MAKING", "Quotes unchanged, skipping update (bid/ask change < {} bps)",
+                           min_quote_price_change_bps_);
             return;
         }
         
@@ -585,6 +540,7 @@ void MarketMakingStrategy::update_quotes() {
         // CRITICAL: Round prices and sizes to exchange tick/step sizes BEFORE validation
         // This ensures the strategy knows exactly what prices/sizes will be sent
         auto& symbol_registry = ExchangeSymbolRegistry::get_instance();
+        const ExchangeSymbolRegistry::InstrumentHandle handle = instrument();
         double original_bid_price = bid_price;
         double original_ask_price = ask_price;
         double original_bid_size = bid_size;
@@ -595,12 +551,12 @@ void MarketMakingStrategy::update_quotes() {
         bool quote_ask = true;
         
         // Round prices and sizes to exchange requirements
-        if (!symbol_registry.validate_and_round(exchange_, symbol_, bid_size, bid_price)) {
+        if (!symbol_registry.validate_and_round(handle, bid_size, bid_price)) {
             get_logger().error("Failed to validate/round bid quote - skipping bid order");
             quote_bid = false;
         }
         
-        if (!symbol_registry.validate_and_round(exchange_, symbol_, ask_size, ask_price)) {
+        if (!symbol_registry.validate_and_round(handle, ask_size, ask_price)) {
             get_logger().error("Failed to validate/round ask quote - skipping ask order");
             quote_ask = false;
         }
@@ -625,95 +581,71 @@ void MarketMakingStrategy::update_quotes() {
             return;
         }
         
-        std::stringstream ss;
-        ss << "Calculated quotes:" << std::endl
-           << "  Mid price: " << mid_price << std::endl
-           << "  Total spread: " << (total_spread * 10000) << " bps" << std::endl
-           << "  Actual collateral: " << actual_collateral_balance << std::endl
-           << "  Leverage: " << leverage_ << "x" << std::endl
-           << "  Leveraged balance: " << leveraged_balance << " (used for sizing)" << std::endl
-           << "  Bid price: " << original_bid_price;
-        if (original_bid_price != bid_price) {
-            ss << " -> " << bid_price << " (rounded)";
-        }
-        ss << " | Bid size: " << original_bid_size;
-        if (original_bid_size != bid_size) {
-            ss << " -> " << bid_size << " (rounded)";
-        }
-        if (!quote_bid_after_rounding) {
-            ss << " (SKIPPED - below min " << min_size_absolute << " after rounding)";
-        }
-        ss << std::endl << "  Ask price: " << original_ask_price;
-        if (original_ask_price != ask_price) {
-            ss << " -> " << ask_price << " (rounded)";
-        }
-        ss << " | Ask size: " << original_ask_size;
-        if (original_ask_size != ask_size) {
-            ss << " -> " << ask_size << " (rounded)";
-        }
-        if (!quote_ask_after_rounding) {
-            ss << " (SKIPPED - below min " << min_size_absolute << " after rounding)";
-        }
-        ss << std::endl << "  Inventory skew: " << normalized_skew << " (affects size asymmetry)" << std::endl
-           << "  Min size threshold: " << min_size_absolute << " (" << (min_quote_size_pct_ * 100) << "% of leveraged balance)";
-        get_logger().debug(ss.str());
+        FAST_LOG_DEBUG("MARKET_MAKING",
+                       "Calculated quotes: mid {}, spread {} bps, collateral {}, leverage {}x, leveraged balance {} | "
+                       "bid {} -> {} size {} -> {}{} | ask {} -> {} size {} -> {}{} | "
+                       "inventory skew {}, min size {} ({}% of leveraged balance)",
+                       mid_price, total_spread * 10000, actual_collateral_balance, leverage_, leveraged_balance,
+                       original_bid_price, bid_price, original_bid_size, bid_size,
+                       quote_bid_after_rounding ? "" : " (SKIPPED - below min size after rounding)",
+                       original_ask_price, ask_price, original_ask_size, ask_size,
+                       quote_ask_after_rounding ? "" : " (SKIPPED - below min size after rounding)",
+                       normalized_skew, min_size_absolute, min_quote_size_pct_ * 100);
         
-        // Cancel existing orders before placing new ones
-        {
-            std::lock_guard<std::mutex> lock(quote_update_mutex_);
-            for (const auto& order_id : active_order_ids_) {
-                cancel_order(order_id);
-            }
-            active_order_ids_.clear();
-        }
+        // Ladder each side from the top quote, then diff against working orders:
+        // untouched levels keep queue position, moved levels are amended
+        QuoteLadder::Inputs ladder_inputs;
+        ladder_inputs.mid_price = mid_price;
+        ladder_inputs.collateral = actual_collateral_balance;
+        ladder_inputs.volatility = volatility;
+        ladder_inputs.min_size = min_size_absolute;
+        ladder_inputs.max_size = max_size_absolute;
+        const ExchangeSymbolInfo& symbol_info = symbol_registry.symbol_info(handle);
+        const GlftTarget::Config& glft_config = glft_model_->get_config();
         
-        // Place bid order (buy limit order) only if size is above minimum after rounding
-        std::string bid_order_id;
+        bid_ladder_.clear();
+        ask_ladder_.clear();
         if (quote_bid_after_rounding) {
-            bid_order_id = generate_order_id() + "_BID";
-            // Prices/sizes are already rounded, so send_order will pass them through
-            // (MiniOMS will validate but not re-round since they're already aligned)
-            if (send_order(bid_order_id, symbol_, proto::BUY, proto::LIMIT, bid_size, bid_price)) {
-                std::stringstream ss;
-                ss << "Placed bid order: " << bid_order_id << " " << bid_size << " @ " << bid_price;
-                get_logger().info(ss.str());
-                std::lock_guard<std::mutex> lock(quote_update_mutex_);
-                active_order_ids_.push_back(bid_order_id);
-            } else {
-                get_logger().error("Failed to place bid order");
-            }
+            ladder_inputs.top_price = bid_price;
+            ladder_inputs.top_size = bid_size;
+            quote_ladder_.build(proto::BUY, ladder_inputs, glft_config, symbol_info, bid_ladder_);
         } else {
-            std::stringstream bid_ss;
-            bid_ss << "Skipping bid order - size (" << bid_size 
-                   << ") below minimum (" << min_size_absolute << ") after rounding";
-            get_logger().debug(bid_ss.str());
+            FAST_LOG_DEBUG("MARKET_MAKING", "Skipping bid order - size ({}) below minimum ({}) after rounding",
+                           bid_size, min_size_absolute);
         }
-        
-        // Place ask order (sell limit order) only if size is above minimum after rounding
-        std::string ask_order_id;
         if (quote_ask_after_rounding) {
-            ask_order_id = generate_order_id() + "_ASK";
-            // Prices/sizes are already rounded, so send_order will pass them through
-            // (MiniOMS will validate but not re-round since they're already aligned)
-            if (send_order(ask_order_id, symbol_, proto::SELL, proto::LIMIT, ask_size, ask_price)) {
-                std::stringstream ss;
-                ss << "Placed ask order: " << ask_order_id << " " << ask_size << " @ " << ask_price;
-                get_logger().info(ss.str());
-                std::lock_guard<std::mutex> lock(quote_update_mutex_);
-                active_order_ids_.push_back(ask_order_id);
-            } else {
-                get_logger().error("Failed to place ask order");
-            }
+            ladder_inputs.top_price = ask_price;
+            ladder_inputs.top_size = ask_size;
+            quote_ladder_.build(proto::SELL, ladder_inputs, glft_config, symbol_info, ask_ladder_);
         } else {
-            std::stringstream ask_ss;
-            ask_ss << "Skipping ask order - size (" << ask_size 
-                   << ") below minimum (" << min_size_absolute << ") after rounding";
-            get_logger().debug(ask_ss.str());
+            FAST_LOG_DEBUG("MARKET_MAKING", "Skipping ask order - size ({}) below minimum ({}) after rounding",
+                           ask_size, min_size_absolute);
+        }
+        
+        // Both sides' changes leave as one order batch
+        QuoteManager::Actions bid_actions;
+        QuoteManager::Actions ask_actions;
+        {
+            OrderBatchScope batch(*this);
+            bid_actions = quote_manager_->reconcile(proto::BUY, bid_ladder_);
+            ask_actions = quote_manager_->reconcile(proto::SELL, ask_ladder_);
+        }
+        statistics_.total_orders.fetch_add(bid_actions.placed + ask_actions.placed);
+        FAST_LOG_INFO("MARKET_MAKING",
+                      "Quote update: bid {} @ {} x{} (placed={} amended={} cancelled={} unchanged={}), "
+                      "ask {} @ {} x{} (placed={} amended={} cancelled={} unchanged={})",
+                      bid_size, bid_price, bid_ladder_.count, bid_actions.placed, bid_actions.amended,
+                      bid_actions.cancelled, bid_actions.unchanged,
+                      ask_size, ask_price, ask_ladder_.count, ask_actions.placed, ask_actions.amended,
+                      ask_actions.cancelled, ask_actions.unchanged);
+        if (bid_actions.failed + ask_actions.failed > 0) {
+            get_logger().error("Failed to update " + std::to_string(bid_actions.failed + ask_actions.failed) +
+                               " quote order(s)");
         }
         
-        // Track active order IDs and prices for cancellation on next update
+        // Track quoted prices for the next change check
         {
-            std::lock_guard<std::mutex> lock(quote_update_mutex_);
+            std::lock_guard<StrategyMutex> lock(quote_update_mutex_);
             // Only update prices for sides that were actually quoted (use rounded prices)
             if (quote_bid_after_rounding) {
                 last_quote_bid_price_ = bid_price;
@@ -722,20 +654,18 @@ void MarketMakingStrategy::update_quotes() {
                 last_quote_ask_price_ = ask_price;
             }
             last_mid_price_ = mid_price;
-            last_quote_update_time_ = std::chrono::system_clock::now();
+            last_quote_update_us_ = now_us();
         }
     }
 }
 
 bool MarketMakingStrategy::should_update_quotes(double current_mid_price) const {
-    std::lock_guard<std::mutex> lock(quote_update_mutex_);
+    std::lock_guard<StrategyMutex> lock(quote_update_mutex_);
     
-    auto now = std::chrono::system_clock::now();
-    auto time_since_last_update = std::chrono::duration_cast<std::chrono::milliseconds>(
-        now - last_quote_update_time_).count();
-    
-    // Always update if enough time has passed (time-based refresh)
-    if (time_since_last_update >= quote_update_interval_ms_) {
+    // Always update if enough time has passed (time-based refresh). Timed on the
+    // strategy clock, so a backtest throttles on event time rather than replay speed.
+    const uint64_t interval_us = static_cast<uint64_t>(std::max(quote_update_interval_ms_, 0)) * 1000;
+    if (last_quote_update_us_ == 0 || now_us() >= last_quote_update_us_ + interval_us) {
         return true;
     }
     
@@ -766,8 +696,7 @@ void MarketMakingStrategy::manage_inventory() {
     double cefi_token1_tokens = 0.0;
     if (cefi.token1 != 0.0 && spot_price > 0.0) {
         auto& symbol_registry = ExchangeSymbolRegistry::get_instance();
-        cefi_token1_tokens = symbol_registry.contracts_to_token_qty(
-            exchange_, symbol_, cefi.token1, spot_price);
+        cefi_token1_tokens = symbol_registry.contracts_to_token_qty(instrument(), cefi.token1, spot_price);
     }
     
     // Calculate total position value (CeFi only)
@@ -789,7 +718,7 @@ void MarketMakingStrategy::manage_inventory() {
 
 // DeFi position management
 void MarketMakingStrategy::update_defi_position(const DefiPosition& position) {
-    std::lock_guard<std::mutex> lock(defi_positions_mutex_);
+    std::lock_guard<StrategyMutex> lock(defi_positions_mutex_);
     defi_positions_[position.pool_address] = position;
     
     std::stringstream ss;
@@ -800,14 +729,14 @@ void MarketMakingStrategy::update_defi_position(const DefiPosition& position) {
 }
 
 void MarketMakingStrategy::remove_defi_position(const std::string& pool_address) {
-    std::lock_guard<std::mutex> lock(defi_positions_mutex_);
+    std::lock_guard<StrategyMutex> lock(defi_positions_mutex_);
     defi_positions_.erase(pool_address);
     
     get_logger().info("Removed DeFi position: " + pool_address);
 }
 
 std::vector<MarketMakingStrategy::DefiPosition> MarketMakingStrategy::get_defi_positions() const {
-    std::lock_guard<std::mutex> lock(defi_positions_mutex_);
+    std::lock_guard<StrategyMutex> lock(defi_positions_mutex_);
     std::vector<DefiPosition> positions;
     positions.reserve(defi_positions_.size());
     
@@ -887,7 +816,7 @@ MarketMakingStrategy::CombinedInventory MarketMakingStrategy::calculate_combined
     // Note: DeFi positions stored in defi_positions_ are in CONTRACTS
     // So we can directly add them to CeFi contracts
     {
-        std::lock_guard<std::mutex> lock(defi_positions_mutex_);
+        std::lock_guard<StrategyMutex> lock(defi_positions_mutex_);
         for (const auto& [pool_address, position] : defi_positions_) {
             inventory.token0_defi += position.token0_amount;
             inventory.token1_defi += position.token1_amount;  // Already in contracts
@@ -965,7 +894,7 @@ double MarketMakingStrategy::get_micro_price_skew() const {
     // Positive = buying pressure (micro_price > mid_price)
     // Negative = selling pressure (micro_price < mid_price)
     
-    std::lock_guard<std::mutex> lock(orderbook_mutex_);
+    std::lock_guard<StrategyMutex> lock(orderbook_mutex_);
     
     if (!orderbook_cached_ || best_bid_ <= 0.0 || best_ask_ <= 0.0) {
         return 0.0;  // No skew if no orderbook data
@@ -993,7 +922,7 @@ double MarketMakingStrategy::get_orderbook_imbalance() const {
     // Positive = more bid liquidity (selling pressure)
     // Negative = more ask liquidity (buying pressure)
     
-    std::lock_guard<std::mutex> lock(orderbook_mutex_);
+    std::lock_guard<StrategyMutex> lock(orderbook_mutex_);
     
     if (!orderbook_cached_) {
         return 0.0;
@@ -1057,7 +986,7 @@ void MarketMakingStrategy::update_ewma_volatility(double current_price) {
         return;
     }
     
-    std::lock_guard<std::mutex> lock(volatility_mutex_);
+    std::lock_guard<StrategyMutex> lock(volatility_mutex_);
     
     if (!volatility_initialized_) {
         // Initialize EWMA variance with a default value
@@ -1108,7 +1037,7 @@ void MarketMakingStrategy::update_spot_price_from_orderbook(const proto::OrderBo
         
         // Store best bid/ask for quote validation and cache orderbook for micro price calculation
         {
-            std::lock_guard<std::mutex> lock(orderbook_mutex_);
+            std::lock_guard<StrategyMutex> lock(orderbook_mutex_);
             best_bid_ = best_bid;
             best_ask_ = best_ask;
             
@@ -1132,6 +1061,16 @@ std::string MarketMakingStrategy::generate_order_id() const {
     return oss.str();
 }
 
+ExchangeSymbolRegistry::InstrumentHandle MarketMakingStrategy::instrument() const {
+    // The string lookup runs until the symbol is loaded, then never again
+    ExchangeSymbolRegistry::InstrumentHandle handle = instrument_.load(std::memory_order_relaxed);
+    if (handle == ExchangeSymbolRegistry::kInvalidInstrument) {
+        handle = ExchangeSymbolRegistry::get_instance().find_instrument(exchange_, symbol_);
+        instrument_.store(handle, std::memory_order_relaxed);
+    }
+    return handle;
+}
+
 MarketMakingStrategyConfig MarketMakingStrategy::get_config() const {
     MarketMakingStrategyConfig config;
     
@@ -1159,6 +1098,10 @@ MarketMakingStrategyConfig MarketMakingStrategy::get_config() const {
     config.min_inventory_change_pct = min_inventory_change_pct_;
     config.quote_update_interval_ms = quote_update_interval_ms_;
     config.min_quote_price_change_bps = min_quote_price_change_bps_;
+    config.amend_quotes = amend_quotes_;
+    config.quote_levels = quote_ladder_.get_config().levels;
+    config.level_spacing_min_ticks = quote_ladder_.get_config().min_level_spacing_ticks;
+    config.level_size_multiplier = quote_ladder_.get_config().level_size_multiplier;
     
     // Get risk management
     config.min_spread_bps = min_spread_bps_;
@@ -9,8 +9,11 @@
 #include <map>
 #include "../base_strategy/abstract_strategy.hpp"
 #include "../../utils/oms/order_state.hpp"
+#include "../../utils/exchange/exchange_symbol_registry.hpp"
 #include "models/glft_target.hpp"
 #include "market_making_strategy_config.hpp"
+#include "quote_manager.hpp"
+#include "quote_ladder.hpp"
 
 // Market Making Strategy that inherits from AbstractStrategy
 class MarketMakingStrategy : public AbstractStrategy {
@@ -44,8 +47,15 @@ public:
   bool is_running() const override { return running_.load(); }
   
   
-  void set_symbol(const std::string& symbol) override { symbol_ = symbol; }
-  void set_exchange(const std::string& exchange) override { exchange_ = exchange; }
+  void set_symbol(const std::string& symbol) override {
+    symbol_ = symbol;
+    instrument_.store(ExchangeSymbolRegistry::kInvalidInstrument);
+  }
+  void set_exchange(const std::string& exchange) override {
+    exchange_ = exchange;
+    instrument_.store(ExchangeSymbolRegistry::kInvalidInstrument);
+  }
+  void set_single_threaded(bool single_threaded) override;
   
       // Event handlers
       void on_market_data(const proto::OrderBookSnapshot& orderbook) override;
@@ -77,7 +87,9 @@ public:
   void set_min_price_change_bps(double bps) { min_price_change_bps_ = bps; }
   void set_min_inventory_change_pct(double pct) { min_inventory_change_pct_ = pct; }
   void set_quote_update_interval_ms(int ms) { quote_update_interval_ms_ = ms; }
-  void set_min_quote_price_change_bps(double bps) { min_quote_price_change_bps_ = bps; }
+  void set_min_quote_price_change_bps(double bps) { min_quote_price_change_bps_ = bps; configure_quote_manager(); }
+  void set_amend_quotes(bool enabled) { amend_quotes_ = enabled; configure_quote_manager(); }  // Venue supports in-place replace
+  void set_ladder_config(const QuoteLadder::Config& config) { quote_ladder_.set_config(config); }  // Levels per side, spacing, sizing
   
   // DeFi position management (Uniswap V3 LP positions)
   struct DefiPosition {
@@ -156,6 +168,7 @@ public:
   };
   
   const Statistics& get_statistics() const { return statistics_; }
+  const QuoteManager& get_quote_manager() const { return *quote_manager_; }
   
   // Callbacks
   void set_order_state_callback(OrderStateCallback callback) { order_state_callback_ = callback; }
@@ -164,6 +177,9 @@ private:
   // Core components
   std::string symbol_;
   std::string exchange_;
+  // Registry handle for exchange_:symbol_, resolved on first use after the
+  // symbol info is loaded
+  mutable std::atomic<ExchangeSymbolRegistry::InstrumentHandle> instrument_{ExchangeSymbolRegistry::kInvalidInstrument};
   std::shared_ptr<GlftTarget> glft_model_;
   std::atomic<bool> running_{false};
   
@@ -181,7 +197,7 @@ private:
                                            // Normalized to % of collateral for skew calculation
   
   // DeFi position tracking
-  mutable std::mutex defi_positions_mutex_;
+  mutable StrategyMutex defi_positions_mutex_;
   std::map<std::string, DefiPosition> defi_positions_;  // pool_address -> DefiPosition
   
   // Cached DeFi inventory flow (in contracts) - used to skew bid/ask quotes
@@ -200,7 +216,7 @@ private:
   std::atomic<double> current_volatility_{0.02};  // Default 2% volatility
   
   // Best bid/ask from orderbook (for quote validation)
-  mutable std::mutex orderbook_mutex_;
+  mutable StrategyMutex orderbook_mutex_;
   double best_bid_{0.0};
   double best_ask_{0.0};
   
@@ -209,25 +225,31 @@ private:
   bool orderbook_cached_{false};
   
   // EWMA volatility calculation
-  mutable std::mutex volatility_mutex_;
+  mutable StrategyMutex volatility_mutex_;
   double ewma_variance_{0.0};  // EWMA variance estimate
   double last_price_{0.0};     // Last price for return calculation
   bool volatility_initialized_{false};
   double ewma_decay_factor_{0.94};  // λ (lambda) - typically 0.94-0.97 for daily data
   
   // Quote update throttling (to avoid excessive order cancellations)
-  mutable std::mutex quote_update_mutex_;
-  std::chrono::system_clock::time_point last_quote_update_time_;
+  mutable StrategyMutex quote_update_mutex_;
+  uint64_t last_quote_update_us_{0};     // now_us() of the last requote, 0 = never
   double last_quote_bid_price_{0.0};
   double last_quote_ask_price_{0.0};
   double last_mid_price_{0.0};
-  std::vector<std::string> active_order_ids_;  // Track active order IDs for cancellation
+  
+  // Working quotes: diffs desired bid/ask against live orders, amending in place where possible
+  std::unique_ptr<QuoteManager> quote_manager_;
+  QuoteLadder quote_ladder_;
+  QuoteManager::LevelSet bid_ladder_;   // Desired levels, rebuilt in place on each update
+  QuoteManager::LevelSet ask_ladder_;
   
   // Quote update thresholds
   double min_price_change_bps_{5.0};      // Minimum price change (5 bps) to trigger update
   double min_inventory_change_pct_{1.0};  // Minimum inventory change (1%) to trigger update
   int quote_update_interval_ms_{5000};   // Minimum time between updates (5 seconds - reduces flickering)
   double min_quote_price_change_bps_{2.0}; // Minimum bid/ask price change (2 bps) to actually update quotes
+  bool amend_quotes_{false};                // Amend working quotes in place instead of cancel + new
   
   // Statistics
   Statistics statistics_;
@@ -239,7 +261,10 @@ private:
   void process_orderbook(const proto::OrderBookSnapshot& orderbook);
   void update_quotes();
   void manage_inventory();
+  void init_quote_manager();
+  void configure_quote_manager();
   std::string generate_order_id() const;
+  ExchangeSymbolRegistry::InstrumentHandle instrument() const;
   
   // Micro price calculation (weighted mid price from top N levels)
   double calculate_micro_price(const proto::OrderBookSnapshot& orderbook, int num_levels = 5) const;
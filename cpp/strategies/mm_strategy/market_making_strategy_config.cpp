@@ -27,6 +27,12 @@ void MarketMakingStrategyConfig::load_from_config(
     min_inventory_change_pct = config_manager.get_double(section, "min_inventory_change_pct", min_inventory_change_pct);
     quote_update_interval_ms = config_manager.get_int(section, "quote_update_interval_ms", quote_update_interval_ms);
     min_quote_price_change_bps = config_manager.get_double(section, "min_quote_price_change_bps", min_quote_price_change_bps);
+    amend_quotes = config_manager.get_bool(section, "amend_quotes", amend_quotes);
+    
+    // Quote Ladder
+    quote_levels = config_manager.get_int(section, "quote_levels", quote_levels);
+    level_spacing_min_ticks = config_manager.get_int(section, "level_spacing_min_ticks", level_spacing_min_ticks);
+    level_size_multiplier = config_manager.get_double(section, "level_size_multiplier", level_size_multiplier);
     
     // Risk Management
     min_spread_bps = config_manager.get_double(section, "min_spread_bps", min_spread_bps);
@@ -86,6 +92,11 @@ void MarketMakingStrategyConfig::print() const {
        << "  Min Inventory Change: " << min_inventory_change_pct << "%" << std::endl
        << "  Update Interval: " << quote_update_interval_ms << " ms" << std::endl
        << "  Min Quote Price Change: " << min_quote_price_change_bps << " bps" << std::endl
+       << "  Amend Quotes: " << (amend_quotes ? "true" : "false") << std::endl
+       << "\n[Quote Ladder]" << std::endl
+       << "  Levels Per Side: " << quote_levels << std::endl
+       << "  Min Level Spacing: " << level_spacing_min_ticks << " ticks" << std::endl
+       << "  Level Size Multiplier: " << level_size_multiplier << std::endl
        << "\n[Risk Management]" << std::endl
        << "  Min Spread: " << min_spread_bps << " bps" << std::endl
        << "  Max Position Size: " << max_position_size << std::endl
@@ -32,6 +32,12 @@ struct MarketMakingStrategyConfig {
     double min_inventory_change_pct{1.0};  // 1%
     int quote_update_interval_ms{5000};     // 5 seconds
     double min_quote_price_change_bps{2.0}; // 2 basis points
+    bool amend_quotes{false};               // Amend working quotes in place (venue replace) instead of cancel + new
+    
+    // Quote Ladder (levels per side; 1 = top of book only)
+    int quote_levels{1};
+    int level_spacing_min_ticks{1};         // Minimum distance between levels
+    double level_size_multiplier{1.0};      // Each deeper level is this multiple of the one above
     
     // Risk Management
     double min_spread_bps{5.0};            // 5 basis points minimum spread
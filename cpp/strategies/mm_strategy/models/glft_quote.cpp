@@ -0,0 +1,29 @@
+#include "glft_quote.hpp"
+
+namespace {
+
+// Arrays as restrict parameters, so the loop needs no runtime alias checks between them
+void evaluate_arrays(const GlftQuoteParams params, double volatility,
+                     const double* __restrict collateral, const double* __restrict position,
+                     const double* __restrict best_bid, const double* __restrict best_ask,
+                     const double* __restrict micro_price_skew, const double* __restrict orderbook_imbalance,
+                     double* __restrict target_offset, double* __restrict bid, double* __restrict ask,
+                     size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const double mid = (best_bid[i] + best_ask[i]) / 2.0;
+        const GlftQuote quote = price_glft_quote(params, collateral[i], position[i], position[i], position[i], mid,
+                                                 best_bid[i], best_ask[i], micro_price_skew[i],
+                                                 orderbook_imbalance[i], volatility);
+        target_offset[i] = quote.target_offset;
+        bid[i] = quote.valid ? quote.bid : 0.0;
+        ask[i] = quote.valid ? quote.ask : 0.0;
+    }
+}
+
+} // namespace
+
+void GlftQuoteBatch::evaluate(const GlftQuoteParams& params, double volatility,
+                              const Inputs& in, const Outputs& out, size_t count) {
+    evaluate_arrays(params, volatility, in.collateral, in.position, in.best_bid, in.best_ask,
+                    in.micro_price_skew, in.orderbook_imbalance, out.target_offset, out.bid, out.ask, count);
+}
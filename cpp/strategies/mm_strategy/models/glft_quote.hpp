@@ -0,0 +1,145 @@
+#pragma once
+#include <cstddef>
+#include "glft_target.hpp"
+
+/**
+ * GLFT quote pricing: the bid/ask MarketMakingStrategy::update_quotes()
+ * derives from the GLFT model, before ladder building and rounding
+ *
+ *   spread      base + inventory risk + terminal penalty around mid,
+ *               shifted by the GLFT target offset
+ *   micro price widened symmetrically by alpha * max(|micro skew|, |imbalance|)
+ *               (capped at 50 bps) when either signal is significant
+ *   net skew    both sides moved by gamma * net inventory (capped at 10%)
+ *               toward reducing it
+ *   anti-cross  a side that would cross the touch joins its own best price
+ *
+ * price_glft_quote() is the single definition; it is inline and written
+ * with selects and non-short-circuit & / | rather than branches, so
+ * GlftQuoteBatch vectorises it.
+ */
+struct GlftQuoteParams {
+    GlftTarget::Config glft;
+    double micro_price_skew_alpha{1.0};
+    double net_inventory_skew_gamma{0.5};
+};
+
+struct GlftQuote {
+    double target_offset{0.0};      // GlftTarget::compute_target(), token1 units
+    double spread{0.0};             // GLFT spread as a fraction of mid, before the adjustments below
+    double bid{0.0};
+    double ask{0.0};
+    double micro_widening{0.0};     // Price units added to each side by the micro price signal
+    double inventory_skew{0.0};     // Price units both sides moved by the net inventory skew (+ = up)
+    bool bid_capped{false};         // Bid would have crossed the best ask: set to the best bid
+    bool ask_capped{false};         // Ask would have crossed the best bid: set to the best ask
+    bool valid{false};              // 0 < bid < ask; otherwise no quote is placed
+};
+
+/**
+ * @param collateral               Collateral (token0) in USD
+ * @param position                 Position (token1) in tokens, for the GLFT model
+ * @param net_inventory_contracts  Net inventory in contracts (position plus DeFi flow), for the skew's sign and threshold
+ * @param net_inventory_tokens     The same in tokens
+ * @param spot_price               Mid price
+ * @param best_bid, best_ask       Touch, 0 if unknown (no anti-cross then)
+ * @param micro_price_skew         (micro price - mid) / mid
+ * @param orderbook_imbalance      (bid qty - ask qty) / (bid qty + ask qty), top 5 levels
+ * @param volatility               Annualized
+ */
+inline GlftQuote price_glft_quote(
+    const GlftQuoteParams& params,
+    double collateral,
+    double position,
+    double net_inventory_contracts,
+    double net_inventory_tokens,
+    double spot_price,
+    double best_bid,
+    double best_ask,
+    double micro_price_skew,
+    double orderbook_imbalance,
+    double volatility
+) {
+    const GlftTarget::Config& config = params.glft;
+    GlftQuote quote;
+    quote.target_offset = GlftTarget::target_offset(config, collateral, position, spot_price, volatility);
+
+    // Spread components (as GlftTarget, without execution cost)
+    double reference_value = std::max(collateral, 1.0);
+    double normalized_skew = (position * spot_price) / reference_value;
+    double inventory_risk = config.risk_aversion * volatility * volatility * std::abs(normalized_skew) +
+                            config.inventory_penalty * std::abs(normalized_skew);
+    double terminal_risk = config.terminal_inventory_penalty * (normalized_skew * normalized_skew);
+    double total_spread = config.base_spread + inventory_risk + terminal_risk;
+    quote.spread = total_spread;
+
+    double mid_price = spot_price;
+    double half_spread = total_spread * mid_price / 2.0;
+
+    // Negative target offset (reduce position) lifts both sides: cheaper to sell, dearer to buy
+    double offset_adjustment = quote.target_offset * spot_price / reference_value;
+    double bid_price = mid_price - half_spread - offset_adjustment;
+    double ask_price = mid_price + half_spread - offset_adjustment;
+
+    // Micro price / order flow imbalance: widen both sides
+    double micro_deviation = std::abs(micro_price_skew);
+    double imbalance_magnitude = std::abs(orderbook_imbalance);
+    bool flow_signal = (micro_deviation > 0.0001) | (imbalance_magnitude > 0.1);
+    double combined_signal = std::max(micro_deviation, imbalance_magnitude);
+    double clamped_signal = std::min(std::max(combined_signal, 0.0), 0.005);
+    double spread_widening = clamped_signal * params.micro_price_skew_alpha * mid_price;
+    quote.micro_widening = flow_signal ? spread_widening : 0.0;
+    bid_price = flow_signal ? bid_price - spread_widening : bid_price;
+    ask_price = flow_signal ? ask_price + spread_widening : ask_price;
+
+    // Net inventory skew: long moves both sides down, short moves them up
+    bool skew_active = (std::abs(net_inventory_contracts) > 0.0001) & (collateral > 0.0) & (spot_price > 0.0);
+    double net_skew_normalized = (net_inventory_tokens * spot_price) / collateral;
+    double adjusted_skew_normalized = net_skew_normalized * params.net_inventory_skew_gamma;
+    double net_skew_factor = std::min(std::max(std::abs(adjusted_skew_normalized), 0.0), 0.1);
+    double skew_adjustment = net_skew_factor * mid_price;
+    double signed_skew = net_inventory_contracts > 0.0 ? -skew_adjustment : skew_adjustment;
+    quote.inventory_skew = skew_active ? signed_skew : 0.0;
+    bid_price = skew_active ? bid_price + signed_skew : bid_price;
+    ask_price = skew_active ? ask_price + signed_skew : ask_price;
+
+    // Never cross the touch: a side that would joins its own best price
+    bool have_touch = (best_bid > 0.0) & (best_ask > 0.0);
+    quote.bid_capped = have_touch & (bid_price >= best_ask);
+    quote.ask_capped = have_touch & (ask_price <= best_bid);
+    bid_price = quote.bid_capped ? best_bid : bid_price;
+    ask_price = quote.ask_capped ? best_ask : ask_price;
+
+    quote.bid = bid_price;
+    quote.ask = ask_price;
+    // 0 < bid < ask as one comparison (NaN in either fails it), which keeps the loop in GlftQuoteBatch vectorisable
+    quote.valid = std::min(ask_price - bid_price, bid_price) > 0.0;
+    return quote;
+}
+
+/**
+ * price_glft_quote() over structure-of-arrays market states, one parameter set
+ *
+ * Every input and output is its own contiguous array, so the loop runs on
+ * vector registers. Position is in tokens with linear contracts (net
+ * inventory = position, no DeFi flow), as a calibration sweeps it. Outputs
+ * are 0 where no quote would be placed (not valid).
+ */
+struct GlftQuoteBatch {
+    struct Inputs {
+        const double* collateral;
+        const double* position;
+        const double* best_bid;
+        const double* best_ask;
+        const double* micro_price_skew;
+        const double* orderbook_imbalance;
+    };
+    struct Outputs {
+        double* target_offset;
+        double* bid;
+        double* ask;
+    };
+
+    static void evaluate(const GlftQuoteParams& params, double volatility,
+                         const Inputs& in, const Outputs& out, size_t count);
+};
@@ -58,6 +58,21 @@ public:
      */
     double compute_target(double desired_offset) const;
     
+    /**
+     * compute_target() under an explicit config
+     * 
+     * Inline and free of branches (conditions combine with & and |, results
+     * are selected) so loops over many market states (GlftQuoteBatch)
+     * vectorise; compute_target() calls it.
+     */
+    static inline double target_offset(
+        const Config& config,
+        double combined_inventory_0,
+        double combined_inventory_1,
+        double spot_price,
+        double volatility
+    );
+    
     // Configuration setters
     void set_risk_aversion(double risk_aversion) { config_.risk_aversion = risk_aversion; }
     void set_target_inventory_ratio(double ratio) { config_.target_inventory_ratio = ratio; }
@@ -70,15 +85,50 @@ public:
 
 private:
     Config config_;
-    
-    /**
-     * Apply finite inventory constraint to target offset
-     * 
-     * When inventory is close to limits, adjust target to prevent over-leveraging
-     */
-    double apply_finite_inventory_constraint(
-        double target_offset,
-        double normalized_inventory_0,
-        double normalized_inventory_1
-    ) const;
 };
+
+inline double GlftTarget::target_offset(
+    const Config& config,
+    double combined_inventory_0,
+    double combined_inventory_1,
+    double spot_price,
+    double volatility
+) {
+    // For perpetual futures: token0 = collateral, token1 = perpetual position (the inventory);
+    // delta-neutral target, so the skew is the position itself
+    double inventory_skew = combined_inventory_1;
+    
+    // Position value as a fraction of collateral
+    double reference_value = std::max(combined_inventory_0, 1.0);
+    double position_value_usd = inventory_skew * spot_price;
+    double normalized_inventory_skew = position_value_usd / reference_value;
+    
+    double base_spread_component = config.base_spread + config.execution_cost;
+    double inventory_risk_component = (
+        config.risk_aversion * (volatility * volatility) * std::abs(normalized_inventory_skew) +
+        config.inventory_penalty * std::abs(normalized_inventory_skew)
+    );
+    double terminal_penalty_component = (
+        config.terminal_inventory_penalty * (normalized_inventory_skew * normalized_inventory_skew)
+    );
+    double total_adjustment = base_spread_component + inventory_risk_component + terminal_penalty_component;
+    
+    // Negative = reduce position (move toward zero)
+    double offset = -normalized_inventory_skew * total_adjustment;
+    
+    // Finite inventory constraint: at a limit, no offset further toward it
+    double normalized_inventory_0 = combined_inventory_0 / reference_value;
+    double normalized_inventory_1 = std::abs(combined_inventory_1) / reference_value;
+    bool token0_limit = config.inventory_constraint_active & (normalized_inventory_0 > (1.0 - config.max_position_size));
+    bool token1_limit = config.inventory_constraint_active & (normalized_inventory_1 > (1.0 - config.max_position_size));
+    offset = token0_limit ? std::min(offset, 0.0) : offset;
+    offset = token1_limit ? std::max(offset, 0.0) : offset;
+    
+    offset = std::min(std::max(offset, -config.max_position_size), config.max_position_size);
+    
+    // Fraction of collateral -> position quantity (token1 units)
+    double position_offset = offset * reference_value / spot_price;
+    
+    // Invalid inputs: no offset
+    return ((spot_price <= 0.0) | (volatility < 0.0)) ? 0.0 : position_offset;
+}
@@ -0,0 +1,88 @@
+#include "quote_ladder.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Same rounding as ExchangeSymbolRegistry: down to the increment, then to precision
+double round_down(double value, double increment, int precision) {
+    if (increment <= 0.0) {
+        return value;
+    }
+    double rounded = std::floor(value / increment + 1e-9) * increment;
+    double multiplier = std::pow(10.0, precision);
+    return std::round(rounded * multiplier) / multiplier;
+}
+
+double round_to_precision(double value, int precision) {
+    double multiplier = std::pow(10.0, precision);
+    return std::round(value * multiplier) / multiplier;
+}
+
+} // namespace
+
+double QuoteLadder::level_spacing(const Inputs& inputs, const GlftTarget::Config& glft,
+                                  const ExchangeSymbolInfo& info) const {
+    if (inputs.mid_price <= 0.0) {
+        return 0.0;
+    }
+    double level_inventory = inputs.collateral > 0.0 ? inputs.top_size / inputs.collateral : 0.0;
+    double inventory_slope = glft.risk_aversion * inputs.volatility * inputs.volatility + glft.inventory_penalty;
+    double spacing = inputs.mid_price * 0.5 * (glft.base_spread + inventory_slope * level_inventory);
+
+    double tick = info.is_valid ? info.tick_size : 0.0;
+    if (tick <= 0.0) {
+        return std::max(spacing, 0.0);
+    }
+    double ticks = std::ceil(spacing / tick - 1e-9);
+    ticks = std::max(ticks, static_cast<double>(std::max(config_.min_level_spacing_ticks, 1)));
+    return round_to_precision(ticks * tick, info.price_precision);
+}
+
+void QuoteLadder::build(proto::Side side, const Inputs& inputs, const GlftTarget::Config& glft,
+                        const ExchangeSymbolInfo& info, QuoteManager::LevelSet& out) const {
+    out.clear();
+    if (inputs.top_price <= 0.0 || inputs.top_size <= 0.0) {
+        return;
+    }
+    out.push({inputs.top_price, inputs.top_size});
+
+    const int levels = std::clamp(config_.levels, 1, static_cast<int>(QuoteManager::kMaxLevels));
+    const double spacing = level_spacing(inputs, glft, info);
+    if (levels == 1 || spacing <= 0.0) {
+        return;
+    }
+
+    // Grid index of the first level strictly behind the top, in units of spacing
+    const bool buy = side == proto::BUY;
+    const double tick = info.is_valid ? info.tick_size : 0.0;
+    long long index;
+    if (tick > 0.0) {
+        long long top_ticks = std::llround(inputs.top_price / tick);
+        long long spacing_ticks = std::max(1LL, std::llround(spacing / tick));
+        index = buy ? (top_ticks - 1) / spacing_ticks : top_ticks / spacing_ticks + 1;
+    } else {
+        double position = inputs.top_price / spacing;
+        index = buy ? static_cast<long long>(std::ceil(position - 1e-9)) - 1
+                    : static_cast<long long>(std::floor(position + 1e-9)) + 1;
+    }
+
+    const double step = info.is_valid ? info.step_size : 0.0;
+    const double min_size = std::max(inputs.min_size, info.is_valid ? info.min_order_size : 0.0);
+    double size = inputs.top_size;
+    for (int level = 1; level < levels; ++level, index += buy ? -1 : 1) {
+        if (index <= 0) {
+            break;
+        }
+        double price = static_cast<double>(index) * spacing;
+        price = tick > 0.0 ? round_to_precision(price, info.price_precision) : price;
+
+        size *= config_.level_size_multiplier;
+        double level_size = inputs.max_size > 0.0 ? std::min(size, inputs.max_size) : size;
+        level_size = round_down(level_size, step, info.qty_precision);
+        if (level_size <= 0.0 || level_size < min_size) {
+            break;
+        }
+        out.push({price, level_size});
+    }
+}
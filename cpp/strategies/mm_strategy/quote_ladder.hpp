@@ -0,0 +1,62 @@
+#pragma once
+#include "quote_manager.hpp"
+#include "models/glft_target.hpp"
+#include "../../utils/exchange/exchange_symbol_info.hpp"
+
+/**
+ * Multi-level quote ladder
+ *
+ * Extends the strategy's top-of-book quote on each side with deeper levels:
+ *
+ * - Spacing comes from the GLFT spread: each deeper level sits where the model
+ *   would quote after the level above it had filled, i.e. half the base spread
+ *   plus the half-spread increase from the extra inventory,
+ *     spacing = mid * (base_spread + (risk_aversion * vol^2 + inventory_penalty) * top_size / collateral) / 2
+ *   with sizes in the strategy's balance-based units.
+ *   Spacing is a whole number of ticks, at least min_level_spacing_ticks.
+ * - Deeper levels sit on a fixed grid of multiples of the spacing, starting
+ *   at the first grid point strictly behind the top level. A top-of-book move
+ *   smaller than the spacing therefore moves only the top level; the rest of
+ *   the ladder keeps its prices (and, through QuoteManager, its orders).
+ * - Level k is sized top_size * level_size_multiplier^k, rounded down to the
+ *   step size and capped at max_size; the ladder stops at the first level
+ *   below min_size or the venue minimum.
+ *
+ * State is a flat QuoteManager::LevelSet per side, so building the ladder
+ * does not allocate.
+ */
+class QuoteLadder {
+public:
+    struct Config {
+        int levels{1};                    // Levels per side, including the top (1 = top of book only)
+        int min_level_spacing_ticks{1};
+        double level_size_multiplier{1.0};
+    };
+
+    // Top-of-book quote and the state the GLFT spacing depends on
+    struct Inputs {
+        double top_price{0.0};            // Already rounded to tick
+        double top_size{0.0};             // Already rounded to step
+        double mid_price{0.0};
+        double collateral{0.0};           // Sizing collateral (USD)
+        double volatility{0.0};
+        double min_size{0.0};
+        double max_size{0.0};             // 0 = no cap
+    };
+
+    QuoteLadder() = default;
+    explicit QuoteLadder(const Config& config) : config_(config) {}
+
+    void set_config(const Config& config) { config_ = config; }
+    const Config& get_config() const { return config_; }
+
+    // Distance between levels in price units, a whole number of ticks
+    double level_spacing(const Inputs& inputs, const GlftTarget::Config& glft, const ExchangeSymbolInfo& info) const;
+
+    // Replaces out with the top level followed by the deeper levels, best first
+    void build(proto::Side side, const Inputs& inputs, const GlftTarget::Config& glft, const ExchangeSymbolInfo& info,
+               QuoteManager::LevelSet& out) const;
+
+private:
+    Config config_;
+};
@@ -0,0 +1,324 @@
+#include "quote_manager.hpp"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace {
+
+constexpr double kFillEpsilon = 1e-12;
+
+bool occupied(const QuoteManager::WorkingOrder& order) {
+    return !order.cl_ord_id.empty();
+}
+
+// Occupied and still quoted: candidates for matching, amending and cancelling
+bool quoting(const QuoteManager::WorkingOrder& order) {
+    return occupied(order) && !order.cancel_pending;
+}
+
+double remaining_qty(const QuoteManager::WorkingOrder& order) {
+    return order.qty - order.filled_qty;
+}
+
+} // namespace
+
+QuoteManager::QuoteManager(std::string symbol, OrderSender sender, OrderCanceller canceller, OrderModifier modifier,
+                           OrderIdGenerator id_generator)
+    : symbol_(std::move(symbol)), sender_(std::move(sender)), canceller_(std::move(canceller)),
+      modifier_(std::move(modifier)), id_generator_(std::move(id_generator)) {
+    // Room for a few requotes' worth of unconfirmed cancels before the lists allocate
+    bid_cancels_.reserve(4 * kMaxLevels);
+    ask_cancels_.reserve(4 * kMaxLevels);
+}
+
+void QuoteManager::set_config(const Config& config) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    config_ = config;
+}
+
+QuoteManager::Config QuoteManager::get_config() const {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    return config_;
+}
+
+QuoteManager::Actions QuoteManager::reconcile(proto::Side side, const QuoteLevel* levels, size_t count) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    Actions actions;
+    Slots& working = slots(side);
+    const size_t level_count = std::min(count, kMaxLevels);
+
+    std::array<bool, kMaxLevels> level_done{};
+    std::array<bool, kMaxLevels> slot_done{};
+    for (size_t i = 0; i < level_count; ++i) {
+        level_done[i] = levels[i].qty <= 0.0 || levels[i].price <= 0.0;
+    }
+
+    // 1. Working orders already at a desired price keep their queue position
+    for (size_t i = 0; i < level_count; ++i) {
+        if (level_done[i]) continue;
+        for (size_t j = 0; j < kMaxLevels; ++j) {
+            WorkingOrder& order = working[j];
+            if (slot_done[j] || !quoting(order) || !price_matches(order.price, levels[i].price)) continue;
+            level_done[i] = slot_done[j] = true;
+
+            if (size_matches(remaining_qty(order), levels[i].qty)) {
+                ++actions.unchanged;
+            } else if (!order.acknowledged) {
+                ++actions.deferred;
+            } else if (config_.amend_enabled &&
+                       modifier_(order.cl_ord_id, order.price, order.filled_qty + levels[i].qty)) {
+                order.qty = order.filled_qty + levels[i].qty;
+                ++actions.amended;
+            } else {
+                // A size change alone is not worth losing priority for if it cannot be amended
+                ++actions.unchanged;
+            }
+            break;
+        }
+    }
+
+    // 2. Pair the rest best-first: amend in place, or cancel + new where amends are unavailable
+    std::array<size_t, kMaxLevels> spare{};
+    size_t spare_count = 0;
+    for (size_t j = 0; j < kMaxLevels; ++j) {
+        if (!slot_done[j] && quoting(working[j])) {
+            spare[spare_count++] = j;
+        }
+    }
+    std::sort(spare.begin(), spare.begin() + spare_count, [&working, side](size_t a, size_t b) {
+        return side == proto::BUY ? working[a].price > working[b].price : working[a].price < working[b].price;
+    });
+
+    size_t next_spare = 0;
+    for (size_t i = 0; i < level_count; ++i) {
+        if (level_done[i]) continue;
+        const QuoteLevel& level = levels[i];
+
+        if (next_spare < spare_count) {
+            const size_t j = spare[next_spare++];
+            WorkingOrder& order = working[j];
+            slot_done[j] = true;
+            if (!order.acknowledged) {
+                ++actions.deferred;
+                continue;
+            }
+            if (config_.amend_enabled && modifier_(order.cl_ord_id, level.price, order.filled_qty + level.qty)) {
+                order.price = level.price;
+                order.qty = order.filled_qty + level.qty;
+                ++actions.amended;
+                continue;
+            }
+            if (!cancel(side, order)) {
+                ++actions.failed;
+                continue;
+            }
+            ++actions.cancelled;
+            if (config_.amend_enabled) {
+                statistics_.replaced.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        // The cancelled order moved to the pending-cancel list, so a slot is free for the replacement
+        if (place_in_free_slot(side, working, slot_done, level)) {
+            ++actions.placed;
+        } else {
+            ++actions.failed;
+        }
+    }
+
+    // 3. Whatever is still unmatched is obsolete
+    for (size_t j = 0; j < kMaxLevels; ++j) {
+        WorkingOrder& order = working[j];
+        if (slot_done[j] || !quoting(order)) continue;
+        if (!order.acknowledged) {
+            ++actions.deferred;   // Cannot be cancelled until the exchange has it
+        } else if (cancel(side, order)) {
+            ++actions.cancelled;
+        } else {
+            ++actions.failed;
+        }
+    }
+
+    statistics_.placed.fetch_add(actions.placed, std::memory_order_relaxed);
+    statistics_.amended.fetch_add(actions.amended, std::memory_order_relaxed);
+    statistics_.cancelled.fetch_add(actions.cancelled, std::memory_order_relaxed);
+    statistics_.unchanged.fetch_add(actions.unchanged, std::memory_order_relaxed);
+    return actions;
+}
+
+QuoteManager::Actions QuoteManager::cancel_all() {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    Actions actions;
+    for (proto::Side side : {proto::BUY, proto::SELL}) {
+        // Backwards: a synchronous CANCEL event swaps the last pending entry into the one it removes
+        PendingCancels& pending = pending_cancels(side);
+        for (size_t i = pending.size(); i-- > 0;) {
+            if (i >= pending.size()) continue;
+            if (resend_cancel(pending[i].cl_ord_id)) {
+                ++actions.cancelled;
+            } else {
+                ++actions.failed;
+            }
+        }
+        for (WorkingOrder& order : slots(side)) {
+            if (!occupied(order)) continue;
+            if (cancel(side, order)) {
+                ++actions.cancelled;
+            } else {
+                ++actions.failed;
+            }
+        }
+    }
+    statistics_.cancelled.fetch_add(actions.cancelled, std::memory_order_relaxed);
+    return actions;
+}
+
+void QuoteManager::on_order_event(const proto::OrderEvent& order_event) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    WorkingOrder* order = find(order_event.cl_ord_id());
+    if (!order) {
+        return;
+    }
+
+    switch (order_event.event_type()) {
+        case proto::ACK:
+            order->acknowledged = true;
+            break;
+        case proto::FILL:
+            order->acknowledged = true;
+            order->filled_qty += order_event.fill_qty();
+            if (remaining_qty(*order) <= kFillEpsilon) {
+                release(order_event.cl_ord_id());
+            }
+            break;
+        case proto::CANCEL:
+        case proto::REJECT:
+            // The order is gone either way; a pending cancel is settled
+            release(order_event.cl_ord_id());
+            break;
+        default:
+            break;
+    }
+}
+
+std::vector<QuoteManager::WorkingOrder> QuoteManager::get_working_orders(proto::Side side) const {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    const Slots& working = side == proto::BUY ? bids_ : asks_;
+    std::vector<WorkingOrder> result;
+    for (const WorkingOrder& order : working) {
+        if (quoting(order)) {
+            result.push_back(order);
+        }
+    }
+    return result;
+}
+
+size_t QuoteManager::pending_cancel_count(proto::Side side) const {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    return side == proto::BUY ? bid_cancels_.size() : ask_cancels_.size();
+}
+
+bool QuoteManager::price_matches(double working, double desired) const {
+    // Relative epsilon absorbs the last-bit differences of tick arithmetic
+    double tolerance = std::max(desired * 1e-12, desired * config_.price_tolerance_bps / 10000.0);
+    return std::abs(working - desired) <= tolerance;
+}
+
+bool QuoteManager::size_matches(double working, double desired) const {
+    if (std::abs(working - desired) <= kFillEpsilon) {
+        return true;
+    }
+    return std::abs(working - desired) <= desired * config_.size_tolerance_pct / 100.0;
+}
+
+bool QuoteManager::place(proto::Side side, WorkingOrder& slot, const QuoteLevel& level) {
+    // Fill the slot first so events raised synchronously by the sender find it
+    slot = WorkingOrder{};
+    slot.cl_ord_id = id_generator_() + (side == proto::BUY ? "_BID" : "_ASK");
+    slot.price = level.price;
+    slot.qty = level.qty;
+    std::string cl_ord_id = slot.cl_ord_id;
+    if (!sender_(cl_ord_id, symbol_, side, proto::LIMIT, level.qty, level.price)) {
+        if (slot.cl_ord_id == cl_ord_id) {
+            slot = WorkingOrder{};
+        }
+        return false;
+    }
+    return true;
+}
+
+bool QuoteManager::place_in_free_slot(proto::Side side, Slots& working, std::array<bool, kMaxLevels>& slot_done,
+                                      const QuoteLevel& level) {
+    auto free_slot = std::find_if(working.begin(), working.end(),
+                                  [](const WorkingOrder& order) { return !occupied(order); });
+    if (free_slot == working.end()) {
+        return false;
+    }
+    slot_done[static_cast<size_t>(free_slot - working.begin())] = true;
+    return place(side, *free_slot, level);
+}
+
+bool QuoteManager::cancel(proto::Side side, WorkingOrder& slot) {
+    // Copy: a synchronous CANCEL event may clear the slot inside the callback
+    const std::string cl_ord_id = slot.cl_ord_id;
+    if (!canceller_(cl_ord_id)) {
+        return false;
+    }
+    // The order waits in the pending-cancel list until the venue confirms; on_order_event() drops it
+    if (slot.cl_ord_id == cl_ord_id) {
+        slot.cancel_pending = true;
+        pending_cancels(side).push_back(std::move(slot));
+        slot = WorkingOrder{};
+    }
+    return true;
+}
+
+bool QuoteManager::resend_cancel(const std::string& cl_ord_id) {
+    // Copy: a synchronous CANCEL event may remove the entry inside the callback
+    const std::string id = cl_ord_id;
+    return canceller_(id);
+}
+
+QuoteManager::WorkingOrder* QuoteManager::find(const std::string& cl_ord_id) {
+    if (cl_ord_id.empty()) {
+        return nullptr;
+    }
+    for (Slots* side : {&bids_, &asks_}) {
+        for (WorkingOrder& order : *side) {
+            if (order.cl_ord_id == cl_ord_id) {
+                return &order;
+            }
+        }
+    }
+    for (PendingCancels* pending : {&bid_cancels_, &ask_cancels_}) {
+        for (WorkingOrder& order : *pending) {
+            if (order.cl_ord_id == cl_ord_id) {
+                return &order;
+            }
+        }
+    }
+    return nullptr;
+}
+
+void QuoteManager::release(const std::string& cl_ord_id) {
+    for (Slots* side : {&bids_, &asks_}) {
+        for (WorkingOrder& order : *side) {
+            if (order.cl_ord_id == cl_ord_id) {
+                order = WorkingOrder{};
+                return;
+            }
+        }
+    }
+    for (PendingCancels* pending : {&bid_cancels_, &ask_cancels_}) {
+        auto it = std::find_if(pending->begin(), pending->end(),
+                               [&cl_ord_id](const WorkingOrder& order) { return order.cl_ord_id == cl_ord_id; });
+        if (it != pending->end()) {
+            // Order within the list does not matter: swap the last entry in
+            if (it != pending->end() - 1) {
+                *it = std::move(pending->back());
+            }
+            pending->pop_back();
+            return;
+        }
+    }
+}
@@ -0,0 +1,164 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "../../proto/order.pb.h"
+
+/**
+ * Quote Manager
+ *
+ * Keeps the strategy's working quotes in line with the quotes it wants,
+ * sending as few order messages as possible. Each reconcile() diffs the
+ * desired levels of one side against the live working orders on that side:
+ * - a working order already within tolerance of a desired level is left alone
+ *   (keeps its queue position)
+ * - remaining desired levels are paired with remaining working orders and the
+ *   price/size is amended in place (one message instead of cancel + new)
+ * - working orders with no desired level left are cancelled
+ * - desired levels with no working order left are placed as new orders
+ *
+ * Orders are only amended once the exchange has acknowledged them; an
+ * unacknowledged order is left until the next reconcile. If the venue does
+ * not support amends (or an amend is refused) the order is cancelled and
+ * replaced instead. An amend asks for the order's new total quantity: what
+ * has already filled plus the desired open size.
+ *
+ * Working orders are tracked from the manager's own actions and the order
+ * events passed to on_order_event(); fills, cancels and rejects free a slot.
+ * A cancelled order leaves its slot for the side's pending-cancel list,
+ * marked cancel_pending, where it stays until the CANCEL (or a final FILL or
+ * REJECT) arrives. Its replacement can take the slot at once, and a cancel
+ * the venue never carries out is not forgotten while the order still rests.
+ */
+class QuoteManager {
+public:
+    static constexpr size_t kMaxLevels = 8;
+
+    // Same signatures as AbstractStrategy's order callbacks
+    using OrderSender = std::function<bool(const std::string& cl_ord_id, const std::string& symbol, proto::Side side,
+                                           proto::OrderType type, double qty, double price)>;
+    using OrderCanceller = std::function<bool(const std::string& cl_ord_id)>;
+    using OrderModifier = std::function<bool(const std::string& cl_ord_id, double new_price, double new_qty)>;
+    using OrderIdGenerator = std::function<std::string()>;
+
+    struct Config {
+        double price_tolerance_bps{0.0};  // Working price this close to the desired price counts as unchanged
+        double size_tolerance_pct{0.0};   // Working size this close (% of desired) counts as unchanged
+        bool amend_enabled{false};        // Venue supports in-place replace (IExchangeOMS::replace_order)
+    };
+
+    // One desired price level; qty <= 0 means no quote at this level
+    struct QuoteLevel {
+        double price{0.0};
+        double qty{0.0};
+    };
+
+    // Flat, fixed-capacity set of levels for one side, best first
+    struct LevelSet {
+        std::array<QuoteLevel, kMaxLevels> levels{};
+        size_t count{0};
+
+        bool push(const QuoteLevel& level) {
+            if (count == kMaxLevels) return false;
+            levels[count++] = level;
+            return true;
+        }
+        void clear() { count = 0; }
+        const QuoteLevel& operator[](size_t i) const { return levels[i]; }
+    };
+
+    struct WorkingOrder {
+        std::string cl_ord_id;            // Empty when the slot is free
+        double price{0.0};
+        double qty{0.0};
+        double filled_qty{0.0};
+        bool acknowledged{false};
+        bool cancel_pending{false};       // Cancel sent; no longer quoted, held until the venue confirms
+    };
+
+    // What one reconcile() did
+    struct Actions {
+        uint32_t placed{0};
+        uint32_t amended{0};
+        uint32_t cancelled{0};
+        uint32_t unchanged{0};
+        uint32_t deferred{0};             // Needed an amend/cancel but the order is not acknowledged yet
+        uint32_t failed{0};
+
+        uint32_t messages() const { return placed + amended + cancelled; }
+    };
+
+    struct Statistics {
+        std::atomic<uint64_t> placed{0};
+        std::atomic<uint64_t> amended{0};
+        std::atomic<uint64_t> cancelled{0};
+        std::atomic<uint64_t> unchanged{0};
+        std::atomic<uint64_t> replaced{0};  // Amend fell back to cancel + new
+    };
+
+    QuoteManager(std::string symbol, OrderSender sender, OrderCanceller canceller, OrderModifier modifier,
+                 OrderIdGenerator id_generator);
+
+    void set_config(const Config& config);
+    Config get_config() const;
+
+    /**
+     * Brings one side's working orders in line with levels (best level first).
+     * At most kMaxLevels levels are quoted; an empty list cancels the side.
+     */
+    Actions reconcile(proto::Side side, const QuoteLevel* levels, size_t count);
+    Actions reconcile(proto::Side side, const LevelSet& levels) { return reconcile(side, levels.levels.data(), levels.count); }
+    Actions reconcile(proto::Side side, std::initializer_list<QuoteLevel> levels) {
+        return reconcile(side, levels.begin(), levels.size());
+    }
+
+    // Cancels every working order on both sides, re-sending cancels still pending
+    Actions cancel_all();
+
+    // Tracks ACK / FILL / CANCEL / REJECT for orders this manager placed; others are ignored
+    void on_order_event(const proto::OrderEvent& order_event);
+
+    // Orders still quoted (cancel-pending ones excluded)
+    std::vector<WorkingOrder> get_working_orders(proto::Side side) const;
+    size_t pending_cancel_count(proto::Side side) const;
+    const Statistics& get_statistics() const { return statistics_; }
+
+private:
+    using Slots = std::array<WorkingOrder, kMaxLevels>;
+    using PendingCancels = std::vector<WorkingOrder>;
+
+    Slots& slots(proto::Side side) { return side == proto::BUY ? bids_ : asks_; }
+    PendingCancels& pending_cancels(proto::Side side) { return side == proto::BUY ? bid_cancels_ : ask_cancels_; }
+    bool price_matches(double working, double desired) const;
+    bool size_matches(double working, double desired) const;
+    bool place(proto::Side side, WorkingOrder& slot, const QuoteLevel& level);
+    bool place_in_free_slot(proto::Side side, Slots& working, std::array<bool, kMaxLevels>& slot_done,
+                            const QuoteLevel& level);
+    bool cancel(proto::Side side, WorkingOrder& slot);
+    bool resend_cancel(const std::string& cl_ord_id);
+    WorkingOrder* find(const std::string& cl_ord_id);
+    void release(const std::string& cl_ord_id);
+
+    std::string symbol_;
+    OrderSender sender_;
+    OrderCanceller canceller_;
+    OrderModifier modifier_;
+    OrderIdGenerator id_generator_;
+
+    // Recursive: the order callbacks may deliver an event (e.g. a local reject) synchronously
+    mutable std::recursive_mutex mutex_;
+    Config config_;
+    Slots bids_;
+    Slots asks_;
+    // Cancelled orders awaiting confirmation; a few fast requotes can leave more than kMaxLevels per side
+    PendingCancels bid_cancels_;
+    PendingCancels ask_cancels_;
+
+    Statistics statistics_;
+};
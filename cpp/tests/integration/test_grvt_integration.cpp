@@ -293,6 +293,42 @@ TEST_CASE("GRVT Subscriber - Orderbook Delta Parsing") {
     std::cout << "[TEST] ✅ Orderbook delta parsing successful" << std::endl;
 }
 
+TEST_CASE("GRVT Subscriber - Delta Book Resyncs Only From A Snapshot") {
+    grvt::GrvtSubscriberConfig config;
+    config.websocket_url = "wss://market-data.testnet.grvt.io/ws/full";
+    
+    grvt::GrvtSubscriber subscriber(config);
+    grvt_test::GrvtTestStrategy strategy;
+    subscriber.set_orderbook_callback([&strategy](const proto::OrderBookSnapshot& orderbook) {
+        strategy.on_orderbook(orderbook);
+    });
+    
+    auto delta = [](int sequence, int prev, const std::string& bids) {
+        return R"({"jsonrpc":"2.0","method":"orderbook.d","params":["orderbook.d","ETH_USDT_Perp",{"bids":)" + bids +
+               R"(,"asks":[["2534.25","8.0"]],"sequence_number":")" + std::to_string(sequence) +
+               R"(","prev_sequence_number":")" + std::to_string(prev) + R"("}]})";
+    };
+    
+    // A delta before any snapshot is not taken for the book
+    subscriber.handle_websocket_message(delta(7, 6, R"([["2533.00","1.0"]])"));
+    CHECK(strategy.orderbook_count.load() == 0);
+    
+    subscriber.handle_websocket_message(delta(0, 0, R"([["2533.75","5.0"]])"));
+    subscriber.handle_websocket_message(delta(1, 0, R"([["2533.50","2.0"]])"));
+    REQUIRE(strategy.orderbook_count.load() == 2);
+    CHECK(strategy.last_orderbook.bids_size() == 2);
+    
+    // After a gap the book waits for the next snapshot, whatever else arrives
+    subscriber.handle_websocket_message(delta(3, 2, R"([["2533.25","1.0"]])"));
+    subscriber.handle_websocket_message(delta(4, 3, R"([["2533.10","1.0"]])"));
+    CHECK(strategy.orderbook_count.load() == 2);
+    
+    subscriber.handle_websocket_message(delta(0, 0, R"([["2533.90","3.0"]])"));
+    CHECK(strategy.orderbook_count.load() == 3);
+    REQUIRE(strategy.last_orderbook.bids_size() == 1);
+    CHECK(strategy.last_orderbook.bids(0).price() == doctest::Approx(2533.90));
+}
+
 TEST_CASE("GRVT DataFetcher - JSON Response Parsing") {
     std::cout << "\n=== GRVT DataFetcher JSON Parsing Test ===" << std::endl;
     
@@ -0,0 +1,237 @@
+#include "replay_websocket_transport.hpp"
+#include <iostream>
+
+namespace test_utils {
+
+namespace {
+
+// Sleep until shortly before the deadline, then spin for the rest
+void wait_until(std::chrono::steady_clock::time_point deadline) {
+    constexpr auto kSpinWindow = std::chrono::microseconds(100);
+    auto now = std::chrono::steady_clock::now();
+    if (deadline - now > kSpinWindow) {
+        std::this_thread::sleep_until(deadline - kSpinWindow);
+    }
+    while (std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+}
+
+} // namespace
+
+ReplayWebSocketTransport::ReplayWebSocketTransport(const std::string& journal_path, double speed)
+    : journal_path_(journal_path), speed_(speed) {
+}
+
+ReplayWebSocketTransport::~ReplayWebSocketTransport() {
+    shutdown();
+}
+
+bool ReplayWebSocketTransport::connect(const std::string& url) {
+    std::cout << "[REPLAY_TRANSPORT] Replaying " << journal_path_ << " for " << url << std::endl;
+    state_.store(websocket_transport::WebSocketState::CONNECTING);
+
+    websocket_transport::FrameJournalReader probe(journal_path_);
+    if (!probe.open()) {
+        state_.store(websocket_transport::WebSocketState::ERROR);
+        std::lock_guard<std::mutex> lock(callback_mutex_);
+        if (error_callback_) {
+            error_callback_(-1, "Cannot open journal " + journal_path_);
+        }
+        return false;
+    }
+
+    state_.store(websocket_transport::WebSocketState::CONNECTED);
+    connected_.store(true);
+    {
+        std::lock_guard<std::mutex> lock(callback_mutex_);
+        if (connect_callback_) {
+            connect_callback_(true);
+        }
+    }
+    start_event_loop();
+    return true;
+}
+
+void ReplayWebSocketTransport::disconnect() {
+    stop_event_loop();
+    if (!connected_.exchange(false)) {
+        return;
+    }
+    state_.store(websocket_transport::WebSocketState::DISCONNECTED);
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    if (connect_callback_) {
+        connect_callback_(false);
+    }
+}
+
+bool ReplayWebSocketTransport::is_connected() const {
+    return connected_.load();
+}
+
+websocket_transport::WebSocketState ReplayWebSocketTransport::get_state() const {
+    return state_.load();
+}
+
+bool ReplayWebSocketTransport::send_message(const std::string& message, bool /*binary*/) {
+    if (!is_connected()) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(sent_mutex_);
+    sent_messages_.push_back(message);
+    return true;
+}
+
+bool ReplayWebSocketTransport::send_binary(const std::vector<uint8_t>& data) {
+    return send_message(std::string(data.begin(), data.end()), true);
+}
+
+bool ReplayWebSocketTransport::send_ping() {
+    return is_connected();
+}
+
+void ReplayWebSocketTransport::set_message_callback(websocket_transport::WebSocketMessageCallback callback) {
+    {
+        std::lock_guard<std::mutex> lock(callback_mutex_);
+        message_callback_ = std::move(callback);
+        callback_generation_.fetch_add(1);
+    }
+    callback_cv_.notify_all();
+}
+
+void ReplayWebSocketTransport::set_error_callback(websocket_transport::WebSocketErrorCallback callback) {
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    error_callback_ = std::move(callback);
+}
+
+void ReplayWebSocketTransport::set_connect_callback(websocket_transport::WebSocketConnectCallback callback) {
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    connect_callback_ = std::move(callback);
+}
+
+void ReplayWebSocketTransport::set_ping_interval(int) {}
+void ReplayWebSocketTransport::set_timeout(int) {}
+void ReplayWebSocketTransport::set_reconnect_attempts(int) {}
+void ReplayWebSocketTransport::set_reconnect_delay(int) {}
+
+bool ReplayWebSocketTransport::initialize() {
+    return true;
+}
+
+void ReplayWebSocketTransport::shutdown() {
+    disconnect();
+}
+
+void ReplayWebSocketTransport::start_event_loop() {
+    if (loop_running_.exchange(true)) {
+        return;
+    }
+    if (replay_thread_.joinable()) {
+        replay_thread_.join();
+    }
+    finished_.store(false);
+    replay_thread_ = std::thread(&ReplayWebSocketTransport::replay_loop, this);
+}
+
+void ReplayWebSocketTransport::stop_event_loop() {
+    {
+        std::lock_guard<std::mutex> lock(callback_mutex_);
+        loop_running_.store(false);
+    }
+    callback_cv_.notify_all();
+    if (replay_thread_.joinable()) {
+        replay_thread_.join();
+    }
+}
+
+bool ReplayWebSocketTransport::is_event_loop_running() const {
+    return loop_running_.load();
+}
+
+bool ReplayWebSocketTransport::wait_until_finished(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(finished_mutex_);
+    return finished_cv_.wait_for(lock, timeout, [this] { return finished_.load(); });
+}
+
+std::vector<std::string> ReplayWebSocketTransport::get_sent_messages() const {
+    std::lock_guard<std::mutex> lock(sent_mutex_);
+    return sent_messages_;
+}
+
+void ReplayWebSocketTransport::replay_loop() {
+    websocket_transport::FrameJournalReader reader(journal_path_);
+    if (!reader.open()) {
+        loop_running_.store(false);
+        return;
+    }
+
+    // Hold frames until someone is listening
+    websocket_transport::WebSocketMessageCallback callback;
+    uint64_t generation = 0;
+    {
+        std::unique_lock<std::mutex> lock(callback_mutex_);
+        callback_cv_.wait(lock, [this] { return message_callback_ || !loop_running_.load(); });
+        callback = message_callback_;
+        generation = callback_generation_.load();
+    }
+
+    const double speed = speed_;
+    websocket_transport::JournalFrame frame;
+    websocket_transport::WebSocketMessage message;
+    while (loop_running_.load()) {
+        auto start = std::chrono::steady_clock::now();
+        uint64_t first_ns = 0;
+        bool first = true;
+
+        while (loop_running_.load() && reader.next(frame)) {
+            if (first) {
+                first_ns = frame.receive_ns;
+                first = false;
+            }
+            if (speed > 0.0) {
+                auto offset = std::chrono::nanoseconds(
+                    static_cast<int64_t>(static_cast<double>(frame.receive_ns - first_ns) / speed));
+                auto due = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(offset);
+                wait_until(due);
+                auto lag = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - due).count();
+                if (lag > 0 && static_cast<uint64_t>(lag) > max_lag_ns_.load(std::memory_order_relaxed)) {
+                    max_lag_ns_.store(static_cast<uint64_t>(lag), std::memory_order_relaxed);
+                }
+            }
+
+            if (callback_generation_.load() != generation) {
+                std::lock_guard<std::mutex> lock(callback_mutex_);
+                callback = message_callback_;
+                generation = callback_generation_.load();
+            }
+            message.data.swap(frame.data);
+            message.is_binary = frame.is_binary;
+            message.channel.swap(frame.channel);
+            message.timestamp_us = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count());
+            if (callback) {
+                callback(message);
+            }
+            frames_replayed_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        if (!loop_ || !loop_running_.load()) {
+            break;
+        }
+        reader.rewind();
+    }
+
+    if (reader.is_truncated()) {
+        std::cerr << "[REPLAY_TRANSPORT] Journal ends in a damaged block after "
+                  << reader.get_frames_read() << " frames" << std::endl;
+    }
+    {
+        std::lock_guard<std::mutex> lock(finished_mutex_);
+        finished_.store(true);
+    }
+    finished_cv_.notify_all();
+    loop_running_.store(false);
+}
+
+} // namespace test_utils
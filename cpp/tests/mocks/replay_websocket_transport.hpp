@@ -0,0 +1,104 @@
+#pragma once
+#include "../../exchanges/websocket/i_websocket_transport.hpp"
+#include "../../exchanges/websocket/frame_journal.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace test_utils {
+
+/**
+ * Replays a captured frame journal through the IWebSocketTransport interface
+ *
+ * Hand it to an unchanged subscriber (BinanceSubscriber, DeribitSubscriber,
+ * GrvtSubscriber, or MarketServerLib::set_websocket_transport) in place of
+ * the network transport. connect() opens the journal and starts the replay
+ * thread; frames are held until a message callback is set, then delivered
+ * with their captured spacing divided by the speed:
+ *   1.0  real time, as captured
+ *   N    N times faster
+ *   0    as fast as the subscriber consumes them
+ *
+ * Outgoing messages (subscriptions, pings) are recorded and otherwise
+ * ignored; the journal already holds whatever the venue sent back.
+ */
+class ReplayWebSocketTransport : public websocket_transport::IWebSocketTransport {
+public:
+    explicit ReplayWebSocketTransport(const std::string& journal_path, double speed = 1.0);
+    ~ReplayWebSocketTransport();
+
+    // IWebSocketTransport interface
+    bool connect(const std::string& url) override;
+    void disconnect() override;
+    bool is_connected() const override;
+    websocket_transport::WebSocketState get_state() const override;
+
+    bool send_message(const std::string& message, bool binary = false) override;
+    bool send_binary(const std::vector<uint8_t>& data) override;
+    bool send_ping() override;
+
+    void set_message_callback(websocket_transport::WebSocketMessageCallback callback) override;
+    void set_error_callback(websocket_transport::WebSocketErrorCallback callback) override;
+    void set_connect_callback(websocket_transport::WebSocketConnectCallback callback) override;
+
+    void set_ping_interval(int seconds) override;
+    void set_timeout(int seconds) override;
+    void set_reconnect_attempts(int attempts) override;
+    void set_reconnect_delay(int seconds) override;
+
+    bool initialize() override;
+    void shutdown() override;
+
+    void start_event_loop() override;
+    void stop_event_loop() override;
+    bool is_event_loop_running() const override;
+
+    // Replay control; set before connect()
+    void set_speed(double speed) { speed_ = speed; }
+    void set_loop(bool loop) { loop_ = loop; }   // Start over at the end instead of finishing
+
+    // Block until the whole journal has been delivered (false on timeout)
+    bool wait_until_finished(std::chrono::milliseconds timeout);
+    bool is_finished() const { return finished_.load(); }
+
+    uint64_t get_frames_replayed() const { return frames_replayed_.load(); }
+    // Largest lag behind the scheduled delivery time, in nanoseconds
+    uint64_t get_max_lag_ns() const { return max_lag_ns_.load(); }
+    std::vector<std::string> get_sent_messages() const;
+
+private:
+    void replay_loop();
+
+    std::string journal_path_;
+    double speed_;
+    bool loop_{false};
+
+    std::atomic<bool> connected_{false};
+    std::atomic<websocket_transport::WebSocketState> state_{websocket_transport::WebSocketState::DISCONNECTED};
+    std::atomic<bool> loop_running_{false};
+    std::atomic<bool> finished_{false};
+    std::atomic<uint64_t> frames_replayed_{0};
+    std::atomic<uint64_t> max_lag_ns_{0};
+    std::thread replay_thread_;
+
+    // Callbacks may be set while replaying; the replay thread takes a copy when the generation changes
+    mutable std::mutex callback_mutex_;
+    std::condition_variable callback_cv_;
+    websocket_transport::WebSocketMessageCallback message_callback_;
+    websocket_transport::WebSocketErrorCallback error_callback_;
+    websocket_transport::WebSocketConnectCallback connect_callback_;
+    std::atomic<uint64_t> callback_generation_{0};
+
+    mutable std::mutex sent_mutex_;
+    std::vector<std::string> sent_messages_;
+
+    std::mutex finished_mutex_;
+    std::condition_variable finished_cv_;
+};
+
+} // namespace test_utils
@@ -8,11 +8,45 @@
 // Unit tests - Core utilities (working tests)
 #include "unit/utils/test_zmq_publisher.cpp"
 #include "unit/utils/test_zmq_subscriber.cpp"
+#include "unit/utils/test_zmq_reactor.cpp"
+#include "unit/utils/test_local_order_book.cpp"
+#include "unit/utils/test_market_data_parser.cpp"
+#include "unit/utils/test_lockfree_ring.cpp"
+#include "unit/utils/test_http_connection_pool.cpp"
+#include "unit/utils/test_binary_logger.cpp"
+#include "unit/utils/test_metrics_collector.cpp"
+#include "unit/utils/test_websocket_frame_codec.cpp"
+#include "unit/utils/test_orderbook_binary.cpp"
+#include "unit/utils/test_shm_md_bus.cpp"
+#include "unit/utils/test_thread_placement.cpp"
+#include "unit/utils/test_work_stealing_pool.cpp"
+#include "unit/utils/test_exchange_symbol_registry.cpp"
 #include "unit/config/test_process_config_manager.cpp"
 
+// Unit tests - Market server
+#include "unit/market_server/test_market_server_lib.cpp"
+
+// Unit tests - Strategies
+#include "unit/strategies/test_quote_manager.cpp"
+#include "unit/strategies/test_quote_ladder.cpp"
+
+// Unit tests - Trader
+#include "unit/trader/test_strategy_executor.cpp"
+#include "unit/trader/test_order_store.cpp"
+#include "unit/trader/test_mini_oms.cpp"
+#include "unit/trader/test_trader_lib.cpp"
+
+// Unit tests - Backtest
+#include "unit/backtest/test_backtest_engine.cpp"
+#include "unit/backtest/test_glft_sweep.cpp"
+
 // Unit tests - Exchange implementations
 #include "unit/exchanges/test_grvt_oms.cpp"
 #include "unit/exchanges/test_deribit_oms.cpp"
+#include "unit/exchanges/test_order_batch.cpp"
+#include "unit/exchanges/test_binance_subscriber.cpp"
+#include "unit/exchanges/test_frame_journal.cpp"
+#include "unit/exchanges/test_libuv_websocket_transport.cpp"
 
 // Integration tests
 #include "integration/test_full_chain_integration.cpp"
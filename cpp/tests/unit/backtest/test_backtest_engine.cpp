@@ -0,0 +1,348 @@
+#include "doctest.h"
+#include "../../../backtest/backtest_engine.hpp"
+#include "../../../backtest/recorded_feed.hpp"
+#include "../../../backtest/simulated_exchange.hpp"
+#include "../../../strategies/base_strategy/abstract_strategy.hpp"
+#include "../../../strategies/mm_strategy/market_making_strategy.hpp"
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+namespace {
+
+md_binary::DefaultBookMessage make_sim_book(uint64_t timestamp_us, double bid, double bid_qty, double ask,
+                                            double ask_qty) {
+    backtest::RecordedFeed feed;
+    md_binary::BookLevel bids[2] = {{bid, bid_qty}, {bid - 1.0, 10.0}};
+    md_binary::BookLevel asks[2] = {{ask, ask_qty}, {ask + 1.0, 10.0}};
+    feed.add_book(timestamp_us, bids, 2, asks, 2);
+    return feed.book(0);
+}
+
+proto::OrderBatchRequest make_sim_batch(proto::OrderActionType type, const std::string& cl_ord_id, proto::Side side,
+                                        double qty, double price, proto::OrderType order_type = proto::LIMIT) {
+    proto::OrderBatchRequest batch;
+    proto::OrderAction* action = batch.add_actions();
+    action->set_action(type);
+    proto::OrderRequest* order = action->mutable_order();
+    order->set_cl_ord_id(cl_ord_id);
+    order->set_symbol("BTCUSDT");
+    order->set_side(side);
+    order->set_type(order_type);
+    order->set_qty(qty);
+    order->set_price(price);
+    return batch;
+}
+
+backtest::SimulatedExchange::Config sim_venue() {
+    backtest::SimulatedExchange::Config config;
+    config.symbol = "BTCUSDT";
+    config.tick_size = 0.5;
+    config.maker_fee_bps = -1.0;
+    config.taker_fee_bps = 5.0;
+    config.initial_collateral = 100000.0;
+    return config;
+}
+
+// Bids once on the first book it sees and records what comes back
+class ProbeStrategy : public AbstractStrategy {
+public:
+    ProbeStrategy() : AbstractStrategy("probe") {}
+
+    void on_market_data(const proto::OrderBookSnapshot& orderbook) override {
+        book_timestamps.push_back(orderbook.timestamp_us());
+        if (!sent && orderbook.bids_size() > 0) {
+            sent = true;
+            OrderBatchScope batch(*this);
+            send_order("probe-1", get_symbol(), proto::BUY, proto::LIMIT, 2.0, orderbook.bids(0).price());
+        }
+    }
+    void on_order_event(const proto::OrderEvent& order_event) override { events.push_back(order_event); }
+    void on_position_update(const proto::PositionUpdate& position) override { position_qty = position.qty(); }
+    void on_trade_execution(const proto::Trade&) override { ++trades; }
+    void on_account_balance_update(const proto::AccountBalanceUpdate&) override {}
+
+    void start() override { running_.store(true); }
+    void stop() override { running_.store(false); }
+
+    std::optional<trader::PositionInfo> get_position(const std::string&, const std::string&) const override {
+        return std::nullopt;
+    }
+    std::vector<trader::PositionInfo> get_all_positions() const override { return {}; }
+    std::vector<trader::PositionInfo> get_positions_by_exchange(const std::string&) const override { return {}; }
+    std::vector<trader::PositionInfo> get_positions_by_symbol(const std::string&) const override { return {}; }
+    std::optional<trader::AccountBalanceInfo> get_account_balance(const std::string&,
+                                                                  const std::string&) const override {
+        return std::nullopt;
+    }
+    std::vector<trader::AccountBalanceInfo> get_all_account_balances() const override { return {}; }
+    std::vector<trader::AccountBalanceInfo> get_account_balances_by_exchange(const std::string&) const override {
+        return {};
+    }
+    std::vector<trader::AccountBalanceInfo> get_account_balances_by_instrument(const std::string&) const override {
+        return {};
+    }
+
+    bool sent{false};
+    std::vector<uint64_t> book_timestamps;
+    std::vector<proto::OrderEvent> events;
+    double position_qty{0.0};
+    int trades{0};
+};
+
+} // namespace
+
+TEST_CASE("SimulatedExchange - Trades Consume The Queue Ahead Before Filling") {
+    backtest::SimulatedExchange exchange(sim_venue());
+    std::vector<proto::OrderEvent> events;
+    exchange.set_order_status_callback([&](const proto::OrderEvent& event) { events.push_back(event); });
+    std::vector<bool> results;
+
+    exchange.on_book(make_sim_book(1, 100.0, 5.0, 101.0, 5.0));
+    exchange.submit_batch(make_sim_batch(proto::NEW_ORDER, "b1", proto::BUY, 2.0, 100.0), results);
+    REQUIRE(results.size() == 1);
+    CHECK(results[0]);
+    REQUIRE(events.size() == 1);
+    CHECK(events[0].event_type() == proto::ACK);
+    CHECK(exchange.open_order_count() == 1);
+
+    // 3 of the 5 ahead of us
+    exchange.on_trade(backtest::TradePrint{2, 100.0, 3.0, true});
+    CHECK(events.size() == 1);
+
+    // The level shrinks from 2 to 1 visible: half of what was ahead of us is gone
+    exchange.on_book(make_sim_book(3, 100.0, 1.0, 101.0, 5.0));
+    exchange.on_trade(backtest::TradePrint{4, 100.0, 1.5, true});
+    REQUIRE(events.size() == 2);
+    CHECK(events[1].event_type() == proto::FILL);
+    CHECK(events[1].fill_qty() == doctest::Approx(0.5));
+
+    // A trade through our price fills the rest
+    exchange.on_trade(backtest::TradePrint{5, 99.5, 0.1, true});
+    REQUIRE(events.size() == 3);
+    CHECK(events[2].fill_qty() == doctest::Approx(1.5));
+    CHECK(exchange.open_order_count() == 0);
+
+    const auto& account = exchange.get_account();
+    CHECK(account.position == doctest::Approx(2.0));
+    CHECK(account.avg_price == doctest::Approx(100.0));
+    CHECK(account.fees == doctest::Approx(-200.0 * 1.0 / 10000.0));   // Maker rebate
+    CHECK(exchange.get_statistics().maker_fills == 2);
+    CHECK(exchange.get_statistics().orders_filled == 1);
+}
+
+TEST_CASE("SimulatedExchange - Crossing Orders Take Visible Liquidity") {
+    backtest::SimulatedExchange exchange(sim_venue());
+    std::vector<proto::OrderEvent> events;
+    exchange.set_order_status_callback([&](const proto::OrderEvent& event) { events.push_back(event); });
+    std::vector<bool> results;
+    exchange.on_book(make_sim_book(1, 100.0, 5.0, 101.0, 1.0));
+
+    // Takes 1 at 101 and 10 at 102, the rest of the market order is cancelled
+    exchange.submit_batch(make_sim_batch(proto::NEW_ORDER, "m1", proto::BUY, 12.0, 0.0, proto::MARKET), results);
+    REQUIRE(events.size() == 4);
+    CHECK(events[0].event_type() == proto::ACK);
+    CHECK(events[1].fill_price() == doctest::Approx(101.0));
+    CHECK(events[1].fill_qty() == doctest::Approx(1.0));
+    CHECK(events[2].fill_price() == doctest::Approx(102.0));
+    CHECK(events[2].fill_qty() == doctest::Approx(10.0));
+    CHECK(events[3].event_type() == proto::CANCEL);
+
+    const auto& account = exchange.get_account();
+    CHECK(account.position == doctest::Approx(11.0));
+    CHECK(account.fees == doctest::Approx((101.0 + 1020.0) * 5.0 / 10000.0));
+    CHECK(exchange.get_statistics().taker_qty == doctest::Approx(11.0));
+
+    // Sell back through a limit that crosses the bid: realized PnL against the average entry
+    events.clear();
+    exchange.submit_batch(make_sim_batch(proto::NEW_ORDER, "s1", proto::SELL, 5.0, 100.0), results);
+    REQUIRE(events.size() == 2);
+    CHECK(events[1].fill_price() == doctest::Approx(100.0));
+    const double avg = (101.0 + 1020.0) / 11.0;
+    CHECK(account.realized_pnl == doctest::Approx(5.0 * (100.0 - avg)));
+    CHECK(account.position == doctest::Approx(6.0));
+    CHECK(account.avg_price == doctest::Approx(avg));
+}
+
+TEST_CASE("SimulatedExchange - Replace Keeps Priority Only When Reducing In Place") {
+    backtest::SimulatedExchange exchange(sim_venue());
+    std::vector<proto::OrderEvent> events;
+    exchange.set_order_status_callback([&](const proto::OrderEvent& event) { events.push_back(event); });
+    std::vector<bool> results;
+    exchange.on_book(make_sim_book(1, 100.0, 5.0, 101.0, 5.0));
+
+    exchange.submit_batch(make_sim_batch(proto::NEW_ORDER, "a", proto::SELL, 2.0, 101.0), results);
+    exchange.on_trade(backtest::TradePrint{2, 101.0, 4.0, false});
+    // Smaller, same price: still 1 ahead
+    exchange.submit_batch(make_sim_batch(proto::REPLACE_ORDER, "a", proto::SELL, 1.0, 101.0), results);
+    events.clear();
+    exchange.on_trade(backtest::TradePrint{3, 101.0, 1.5, false});
+    REQUIRE(events.size() == 1);
+    CHECK(events[0].fill_qty() == doctest::Approx(0.5));
+
+    // Bigger: back of the queue behind the 5 visible
+    exchange.on_book(make_sim_book(4, 100.0, 5.0, 101.0, 5.0));
+    exchange.submit_batch(make_sim_batch(proto::REPLACE_ORDER, "a", proto::SELL, 3.0, 101.0), results);
+    events.clear();
+    exchange.on_trade(backtest::TradePrint{5, 101.0, 4.0, false});
+    CHECK(events.empty());
+
+    // Unknown orders are rejected
+    exchange.submit_batch(make_sim_batch(proto::CANCEL_ORDER, "missing", proto::SELL, 0.0, 0.0), results);
+    REQUIRE(events.size() == 1);
+    CHECK(events[0].event_type() == proto::REJECT);
+    CHECK_FALSE(results[0]);
+    CHECK(exchange.get_statistics().replaces == 2);
+}
+
+TEST_CASE("RecordedFeed - Loads CSV Books And Trades") {
+    const std::string path = "/tmp/test_backtest_feed.csv";
+    {
+        std::ofstream out(path);
+        out << "# timestamp,type,...\n"
+            << "2000,T,100.5,0.3,B\n"
+            << "1000,B,2,1,100,1.5,99.5,2,101,3\n";
+    }
+    backtest::RecordedFeed feed;
+    REQUIRE(feed.load_csv(path));
+    feed.sort_by_time();
+    REQUIRE(feed.size() == 2);
+    CHECK(feed.events()[0].type == backtest::RecordedFeed::EventType::BOOK);
+    const md_binary::DefaultBookMessage& book = feed.book(feed.events()[0].index);
+    CHECK(book.timestamp_us == 1000);
+    CHECK(book.bid_count == 2);
+    CHECK(book.ask_count == 1);
+    CHECK(book.bids[1].price == doctest::Approx(99.5));
+    CHECK(book.asks[0].qty == doctest::Approx(3.0));
+    const backtest::TradePrint& trade = feed.trade(feed.events()[1].index);
+    CHECK(trade.price == doctest::Approx(100.5));
+    CHECK_FALSE(trade.is_buyer_maker);
+
+    {
+        std::ofstream out(path);
+        out << "1000,B,2,1,100,1.5\n";
+    }
+    backtest::RecordedFeed malformed;
+    CHECK_FALSE(malformed.load_csv(path));
+    std::remove(path.c_str());
+}
+
+TEST_CASE("BacktestEngine - Delivers Orders And Fills With Latency") {
+    backtest::BacktestEngine::Config config;
+    config.venue = sim_venue();
+    config.market_data_latency_us = 100;
+    config.order_latency_us = 300;
+    config.event_latency_us = 50;
+    backtest::BacktestEngine engine(config);
+    auto strategy = std::make_shared<ProbeStrategy>();
+    engine.set_strategy(strategy);
+
+    backtest::RecordedFeed feed;
+    md_binary::BookLevel bids[1] = {{100.0, 1.0}};
+    md_binary::BookLevel asks[1] = {{101.0, 1.0}};
+    feed.add_book(1000, bids, 1, asks, 1);
+    // Before our order reaches the venue (1000 + 100 + 300): does not touch it
+    feed.add_trade(backtest::TradePrint{1200, 99.0, 5.0, true});
+    // After: 1 ahead of us, then 2 for us
+    feed.add_trade(backtest::TradePrint{2000, 100.0, 3.0, true});
+    feed.add_book(3000, bids, 1, asks, 1);
+
+    const backtest::BacktestReport report = engine.run(feed);
+    CHECK(report.market_events == 4);
+    CHECK(report.books == 2);
+    CHECK(report.trades == 2);
+    CHECK(strategy->trades == 2);
+    REQUIRE(strategy->book_timestamps.size() == 2);
+    CHECK(strategy->book_timestamps[0] == 1000);
+
+    REQUIRE(strategy->events.size() == 2);
+    CHECK(strategy->events[0].event_type() == proto::ACK);
+    CHECK(strategy->events[0].timestamp_us() == 1400);
+    CHECK(strategy->events[1].event_type() == proto::FILL);
+    CHECK(strategy->events[1].fill_qty() == doctest::Approx(2.0));
+    CHECK(strategy->events[1].timestamp_us() == 2000);
+    CHECK(strategy->position_qty == doctest::Approx(2.0));
+
+    CHECK(report.orders_placed == 1);
+    CHECK(report.orders_filled == 1);
+    CHECK(report.fill_rate == doctest::Approx(1.0));
+    CHECK(report.final_position == doctest::Approx(2.0));
+    CHECK(report.realized_pnl == doctest::Approx(0.0));
+    CHECK(report.unrealized_pnl == doctest::Approx(1.0));   // 2 @ 100 marked at 100.5
+    CHECK(report.fees == doctest::Approx(-0.02));
+    CHECK(report.net_pnl == doctest::Approx(1.02));
+    CHECK(engine.get_exchange().get_account().position == doctest::Approx(2.0));
+
+    // One run per engine
+    const backtest::BacktestReport again = engine.run(feed);
+    CHECK(again.market_events == 0);
+}
+
+TEST_CASE("BacktestEngine - Market Making Strategy Runs Deterministically") {
+    backtest::RecordedFeed feed;
+    uint64_t t = 1000000;
+    double mid = 30000.0;
+    for (int i = 0; i < 400; ++i, t += 50000) {
+        mid += (i % 7 < 3 ? 1.0 : -0.5) * (i % 2 ? 1.0 : 2.0);
+        md_binary::BookLevel bids[3] = {{mid - 0.5, 2.0}, {mid - 1.0, 4.0}, {mid - 1.5, 6.0}};
+        md_binary::BookLevel asks[3] = {{mid + 0.5, 2.0}, {mid + 1.0, 4.0}, {mid + 1.5, 6.0}};
+        feed.add_book(t, bids, 3, asks, 3);
+        feed.add_trade(backtest::TradePrint{t + 20000, i % 3 ? mid - 2.0 : mid + 2.0, 1.0, i % 3 != 0});
+    }
+
+    auto run_once = [&feed]() {
+        MarketMakingStrategyConfig strategy_config;
+        strategy_config.quote_update_interval_ms = 0;
+        strategy_config.min_price_change_bps = 0.0;
+        auto strategy = std::make_shared<MarketMakingStrategy>("BTCUSDT", strategy_config);
+
+        backtest::BacktestEngine::Config config;
+        config.venue = sim_venue();
+        backtest::BacktestEngine engine(config);
+        engine.set_strategy(strategy);
+        return engine.run(feed);
+    };
+
+    const backtest::BacktestReport first = run_once();
+    const backtest::BacktestReport second = run_once();
+    CHECK(first.market_events == 800);
+    CHECK(first.orders_placed > 0);
+    CHECK(first.csv_row() == second.csv_row());
+    CHECK(first.format().find("Orders:") != std::string::npos);
+}
+
+TEST_CASE("BacktestEngine - Strategy Throttle Runs On Event Time") {
+    // 20 simulated seconds of books only, replayed in far less wall time
+    backtest::RecordedFeed feed;
+    uint64_t t = 1000000;
+    double mid = 30000.0;
+    for (int i = 0; i < 400; ++i, t += 50000) {
+        mid += i % 2 ? 1.0 : -0.5;
+        md_binary::BookLevel bids[1] = {{mid - 0.5, 2.0}};
+        md_binary::BookLevel asks[1] = {{mid + 0.5, 2.0}};
+        feed.add_book(t, bids, 1, asks, 1);
+    }
+
+    auto requotes = [&feed](int interval_ms) {
+        MarketMakingStrategyConfig strategy_config;
+        strategy_config.quote_update_interval_ms = interval_ms;
+        strategy_config.min_price_change_bps = 1e9;   // Time is the only trigger
+        auto strategy = std::make_shared<MarketMakingStrategy>("BTCUSDT", strategy_config);
+
+        backtest::BacktestEngine::Config config;
+        config.venue = sim_venue();
+        backtest::BacktestEngine engine(config);
+        engine.set_strategy(strategy);
+        engine.run(feed);
+        const QuoteManager::Statistics& stats = strategy->get_quote_manager().get_statistics();
+        return stats.placed.load() + stats.amended.load() + stats.unchanged.load();
+    };
+
+    // About one requote per simulated second, against one for the whole run
+    const uint64_t once = requotes(60000);
+    const uint64_t per_second = requotes(1000);
+    CHECK(once > 0);
+    CHECK(per_second >= 10 * once);
+    CHECK(per_second <= 21 * once);
+}
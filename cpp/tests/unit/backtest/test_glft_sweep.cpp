@@ -0,0 +1,236 @@
+#include "doctest.h"
+#include "../../../backtest/glft_sweep.hpp"
+#include "../../../backtest/recorded_feed.hpp"
+#include "../../../strategies/mm_strategy/models/glft_quote.hpp"
+#include "../../../strategies/mm_strategy/models/glft_target.hpp"
+#include "../../../utils/app_service/work_stealing_pool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+// GlftTarget::compute_target() as written before it became branch-free
+double branchy_glft_target(const GlftTarget::Config& config, double collateral, double position, double spot,
+                           double volatility) {
+    if (spot <= 0.0 || volatility < 0.0) {
+        return 0.0;
+    }
+    double reference = std::max(collateral, 1.0);
+    double normalized = position * spot / reference;
+    double total = (config.base_spread + config.execution_cost) +
+                   (config.risk_aversion * (volatility * volatility) * std::abs(normalized) +
+                    config.inventory_penalty * std::abs(normalized)) +
+                   config.terminal_inventory_penalty * (normalized * normalized);
+    double offset = -normalized * total;
+    if (config.inventory_constraint_active) {
+        if (collateral / reference > 1.0 - config.max_position_size) offset = std::min(offset, 0.0);
+        if (std::abs(position) / reference > 1.0 - config.max_position_size) offset = std::max(offset, 0.0);
+    }
+    offset = std::clamp(offset, -config.max_position_size, config.max_position_size);
+    return offset * reference / spot;
+}
+
+// Random walk books with uneven depth, so micro price and imbalance vary
+backtest::RecordedFeed make_sweep_feed(int books) {
+    backtest::RecordedFeed feed;
+    md_binary::BookLevel bids[5];
+    md_binary::BookLevel asks[5];
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+    double mid = 30000.0;
+    for (int i = 0; i < books; ++i) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        mid += static_cast<double>(static_cast<int>(state % 5) - 2) * 0.5;
+        for (int l = 0; l < 5; ++l) {
+            bids[l] = {mid - 0.5 - l, 0.1 + static_cast<double>((state >> (4 * l)) % 16)};
+            asks[l] = {mid + 0.5 + l, 0.1 + static_cast<double>((state >> (4 * l + 20)) % 16)};
+        }
+        feed.add_book(1000 + static_cast<uint64_t>(i), bids, 5, asks, 5);
+    }
+    return feed;
+}
+
+} // namespace
+
+TEST_CASE("GlftQuoteBatch - Matches The Scalar Model And Pricing") {
+    backtest::GlftMarketSamples samples;
+    samples.load(make_sweep_feed(300), 0);
+    REQUIRE(samples.size() == 300);
+
+    for (bool constrained : {false, true}) {
+        GlftQuoteParams params;
+        params.glft.risk_aversion = 0.4;
+        params.glft.inventory_penalty = 0.05;
+        params.glft.terminal_inventory_penalty = 0.2;
+        params.glft.base_spread = 0.0003;
+        params.glft.execution_cost = 0.0001;
+        params.glft.max_position_size = 0.3;
+        params.glft.inventory_constraint_active = constrained;
+        params.micro_price_skew_alpha = 0.8;
+        params.net_inventory_skew_gamma = 0.7;
+        const double volatility = 0.6;
+
+        // Collateral and position cover flat, both signs, the constraint limits and tiny collateral
+        const size_t n = samples.size();
+        std::vector<double> collateral(n), position(n), target(n), bid(n), ask(n);
+        for (size_t i = 0; i < n; ++i) {
+            collateral[i] = i % 7 == 0 ? 0.5 : 50000.0 + 1000.0 * static_cast<double>(i % 13);
+            position[i] = (static_cast<double>(i % 21) - 10.0) * 0.4;
+        }
+        GlftQuoteBatch::evaluate(params, volatility,
+                                 {collateral.data(), position.data(), samples.best_bid.data(), samples.best_ask.data(),
+                                  samples.micro_price_skew.data(), samples.orderbook_imbalance.data()},
+                                 {target.data(), bid.data(), ask.data()}, n);
+
+        GlftTarget model(params.glft);
+        size_t target_matches = 0;
+        size_t quote_matches = 0;
+        size_t valid = 0;
+        for (size_t i = 0; i < n; ++i) {
+            const double mid = (samples.best_bid[i] + samples.best_ask[i]) / 2.0;
+            const double scalar_target = model.compute_target(collateral[i], position[i], mid, volatility);
+            target_matches += target[i] == scalar_target &&
+                              scalar_target == branchy_glft_target(params.glft, collateral[i], position[i], mid,
+                                                                   volatility);
+            const GlftQuote quote = price_glft_quote(params, collateral[i], position[i], position[i], position[i],
+                                                     mid, samples.best_bid[i], samples.best_ask[i],
+                                                     samples.micro_price_skew[i], samples.orderbook_imbalance[i],
+                                                     volatility);
+            valid += quote.valid;
+            quote_matches += quote.valid ? bid[i] == quote.bid && ask[i] == quote.ask : bid[i] == 0.0 && ask[i] == 0.0;
+        }
+        CHECK(target_matches == n);
+        CHECK(quote_matches == n);
+        CHECK(valid > 0);
+    }
+}
+
+TEST_CASE("GlftQuote - Skews Against Net Inventory And Never Crosses") {
+    GlftQuoteParams params;
+    params.glft.base_spread = 0.001;
+    params.glft.risk_aversion = 0.0;
+    params.glft.inventory_penalty = 0.0;
+    params.glft.terminal_inventory_penalty = 0.0;
+    params.net_inventory_skew_gamma = 0.5;
+
+    // Flat, calm book: symmetric around mid
+    GlftQuote flat = price_glft_quote(params, 100000.0, 0.0, 0.0, 0.0, 100.0, 99.9, 100.1, 0.0, 0.0, 0.5);
+    CHECK(flat.valid);
+    CHECK(flat.bid == doctest::Approx(99.95));
+    CHECK(flat.ask == doctest::Approx(100.05));
+    CHECK(flat.micro_widening == 0.0);
+    CHECK(flat.inventory_skew == 0.0);
+
+    // Net long: both sides move down by gamma * value / collateral * mid
+    GlftQuote long_quote = price_glft_quote(params, 100000.0, 0.0, 1.0, 1.0, 100.0, 0.0, 0.0, 0.0, 0.0, 0.5);
+    CHECK(long_quote.inventory_skew == doctest::Approx(-0.05));
+    CHECK(long_quote.bid == doctest::Approx(99.90));
+    CHECK(long_quote.ask == doctest::Approx(100.00));
+
+    // Imbalance widens both sides, capped at 50 bps
+    GlftQuote imbalanced = price_glft_quote(params, 100000.0, 0.0, 0.0, 0.0, 100.0, 0.0, 0.0, 0.0, 0.6, 0.5);
+    CHECK(imbalanced.micro_widening == doctest::Approx(0.5));
+    CHECK(imbalanced.bid == doctest::Approx(99.45));
+
+    // Short enough that the bid would cross the ask: it joins the best bid
+    GlftQuote capped = price_glft_quote(params, 100000.0, 0.0, -10000.0, -10000.0, 100.0, 99.99, 100.01, 0.0, 0.0, 0.5);
+    CHECK(capped.bid_capped);
+    CHECK(capped.bid == 99.99);
+    CHECK_FALSE(capped.ask_capped);
+}
+
+TEST_CASE("GlftSweep - Results Do Not Depend On The Thread Count") {
+    const backtest::RecordedFeed feed = make_sweep_feed(2000);
+    backtest::GlftMarketSamples every_book;
+    every_book.load(feed, 0);
+    backtest::GlftMarketSamples samples;
+    samples.load(feed, 5, 2);
+    REQUIRE(samples.size() == (2000 - 5 + 1) / 2);
+    // Sample k is book 2k; its future touch is book 2k + 5's
+    CHECK(samples.best_bid[10] == every_book.best_bid[20]);
+    CHECK(samples.future_best_bid[10] == every_book.best_bid[25]);
+    CHECK(samples.future_best_ask[10] == every_book.best_ask[25]);
+
+    backtest::GlftSweepConfig config;
+    config.grid.risk_aversion = {0.05, 0.5};
+    config.grid.inventory_penalty = {0.0, 0.05, 0.1};
+    config.grid.terminal_penalty = {0.1};
+    config.grid.base_spread = {0.0001, 0.0005};
+    config.grid.volatility = {0.3, 0.9};
+    config.inventory_fractions = {-0.4, 0.0, 0.4};
+    config.block_size = 100;   // Several blocks and a short last one
+
+    app_service::WorkStealingPool::Config one_thread;
+    one_thread.threads = 1;
+    app_service::WorkStealingPool serial(one_thread);
+    app_service::WorkStealingPool::Config four_threads;
+    four_threads.threads = 4;
+    app_service::WorkStealingPool parallel(four_threads);
+
+    const backtest::GlftSweepTable a = backtest::run_glft_sweep(config, samples, serial);
+    const backtest::GlftSweepTable b = backtest::run_glft_sweep(config, samples, parallel);
+    REQUIRE(a.rows() == config.grid.size() * 3);
+    CHECK(a.rows() == 24 * 3);
+    CHECK(a.names == b.names);
+    CHECK(a.columns == b.columns);
+
+    // Row layout: volatility fastest, then inventory level within a grid point
+    const int volatility = a.column("volatility");
+    const int fraction = a.column("inventory_fraction");
+    const int risk = a.column("risk_aversion");
+    REQUIRE(volatility >= 0);
+    REQUIRE(fraction >= 0);
+    CHECK(a.columns[fraction][0] == -0.4);
+    CHECK(a.columns[fraction][2] == 0.4);
+    CHECK(a.columns[volatility][2] == 0.3);
+    CHECK(a.columns[volatility][3] == 0.9);
+    CHECK(a.columns[risk][a.rows() - 1] == 0.5);
+
+    // Flat rows quote every sample; a wider base spread quotes wider
+    const int quote_rate = a.column("quote_rate");
+    const int spread = a.column("mean_spread_bps");
+    CHECK(a.columns[quote_rate][1] == 1.0);
+    CHECK(a.columns[spread][1 + 2 * 3] > a.columns[spread][1]);   // Grid point 2: next base spread
+    CHECK(a.columns[a.column("mean_abs_target")][1] == 0.0);
+}
+
+TEST_CASE("GlftSweep - Columnar Results Round Trip") {
+    backtest::GlftSweepTable table;
+    table.names = {"a", "longer_name"};
+    table.columns = {{1.0, 2.5, -3.0}, {0.0, 1e-9, 42.0}};
+    const std::string path = "test_glft_sweep.bin";
+    REQUIRE(table.write_columnar(path));
+
+    backtest::GlftSweepTable read;
+    REQUIRE(read.read_columnar(path));
+    CHECK(read.names == table.names);
+    CHECK(read.columns == table.columns);
+    CHECK(read.column("longer_name") == 1);
+    CHECK(read.column("missing") == -1);
+    std::remove(path.c_str());
+
+    CHECK_FALSE(read.read_columnar("does_not_exist.bin"));
+}
+
+TEST_CASE("GlftSweepGrid - Parses Axes") {
+    using backtest::GlftSweepGrid;
+    CHECK(GlftSweepGrid::parse_axis("0.1,0.2, 0.5") == std::vector<double>{0.1, 0.2, 0.5});
+    CHECK(GlftSweepGrid::parse_axis("0:1:5") == std::vector<double>{0.0, 0.25, 0.5, 0.75, 1.0});
+    CHECK(GlftSweepGrid::parse_axis("2:9:1") == std::vector<double>{2.0});
+    CHECK(GlftSweepGrid::parse_axis("7") == std::vector<double>{7.0});
+    CHECK(GlftSweepGrid::parse_axis("0:1").empty());
+    CHECK(GlftSweepGrid::parse_axis("0:1:0").empty());
+    CHECK(GlftSweepGrid::parse_axis("0:1:2.5").empty());
+    CHECK(GlftSweepGrid::parse_axis("0.1,x").empty());
+
+    GlftSweepGrid grid;
+    grid.risk_aversion = {1, 2};
+    grid.inventory_penalty = {1, 2, 3};
+    grid.terminal_penalty = {1};
+    grid.base_spread = {1, 2};
+    grid.volatility = {1, 2, 3, 4};
+    CHECK(grid.size() == 48);
+}
@@ -0,0 +1,105 @@
+#include "doctest.h"
+#include "../../../exchanges/binance/public_websocket/binance_subscriber.hpp"
+#include "../../mocks/mock_websocket_transport.hpp"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace {
+
+// Depth snapshot source that holds every request until released
+class BlockingSnapshotFetcher : public IExchangeDataFetcher {
+public:
+    void set_auth_credentials(const std::string&, const std::string&) override {}
+    bool is_authenticated() const override { return false; }
+    std::vector<proto::OrderEvent> get_open_orders() override { return {}; }
+    std::vector<proto::PositionUpdate> get_positions() override { return {}; }
+    std::vector<proto::AccountBalance> get_balances() override { return {}; }
+
+    bool get_orderbook_snapshot(const std::string&, int, proto::OrderBookSnapshot& snapshot,
+                                uint64_t& last_update_id) override {
+        requests.fetch_add(1);
+        while (!released.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        auto* bid = snapshot.add_bids();
+        bid->set_price(100.0);
+        bid->set_qty(1.0);
+        auto* ask = snapshot.add_asks();
+        ask->set_price(101.0);
+        ask->set_qty(1.0);
+        last_update_id = 100;
+        return true;
+    }
+
+    std::atomic<int> requests{0};
+    std::atomic<bool> released{false};
+};
+
+std::string depth_update(uint64_t first, uint64_t last, uint64_t prev, const std::string& bids) {
+    return R"({"stream":"btcusdt@depth@100ms","data":{"e":"depthUpdate","E":1700000000000,"s":"BTCUSDT","U":)" +
+           std::to_string(first) + R"(,"u":)" + std::to_string(last) + R"(,"pu":)" + std::to_string(prev) +
+           R"(,"b":)" + bids + R"(,"a":[]}})";
+}
+
+template <typename Predicate>
+bool wait_for(Predicate predicate) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (!predicate() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    return predicate();
+}
+
+} // namespace
+
+TEST_CASE("BinanceSubscriber - Depth Snapshot Fetched Off The Message Thread") {
+    auto fetcher = std::make_shared<BlockingSnapshotFetcher>();
+    auto transport = std::make_unique<test_utils::MockWebSocketTransport>();
+    auto* feed = transport.get();
+    feed->set_connection_delay_ms(0);
+    feed->set_simulation_delay_ms(1);
+
+    binance::BinanceSubscriber subscriber(binance::BinanceSubscriberConfig{});
+    subscriber.set_websocket_transport(std::move(transport));
+    subscriber.set_data_fetcher(fetcher);
+
+    std::atomic<int> books{0};
+    std::atomic<int> trades{0};
+    std::atomic<size_t> bid_levels{0};
+    subscriber.set_orderbook_callback([&](const proto::OrderBookSnapshot& orderbook) {
+        bid_levels.store(static_cast<size_t>(orderbook.bids_size()));
+        books.fetch_add(1);
+    });
+    subscriber.set_trade_callback([&](const proto::Trade&) { trades.fetch_add(1); });
+    subscriber.start();
+    feed->start_event_loop();
+
+    // The first diff finds no book and requests a snapshot; the stream keeps flowing meanwhile
+    feed->simulate_custom_message(depth_update(90, 95, 89, R"([["99.0","1.0"]])"));
+    REQUIRE(wait_for([&] { return fetcher->requests.load() == 1; }));
+    feed->simulate_custom_message(depth_update(96, 101, 95, R"([["99.5","2.0"]])"));
+    feed->simulate_custom_message(depth_update(102, 105, 101, R"([["98.5","1.0"]])"));
+    feed->simulate_custom_message(
+        R"({"stream":"btcusdt@trade","data":{"e":"trade","E":1700000000000,"s":"BTCUSDT","t":1,"p":"100.5","q":"0.1","T":1700000000000,"m":true}})");
+    CHECK(wait_for([&] { return trades.load() == 1; }));
+    CHECK(books.load() == 0);
+    CHECK(fetcher->requests.load() == 1);
+
+    // Diffs buffered while the request was out are replayed on top of the snapshot
+    fetcher->released.store(true);
+    uint64_t last = 105;
+    REQUIRE(wait_for([&] {
+        // Until the snapshot lands these are buffered too
+        feed->simulate_custom_message(depth_update(last + 1, last + 5, last, R"([["97.0","1.0"]])"));
+        last += 5;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        return books.load() > 0;
+    }));
+    CHECK(bid_levels.load() == 4);   // 100 from the snapshot, 99.5 and 98.5 buffered, 97 live
+
+    feed->stop_event_loop();
+    subscriber.stop();
+}
@@ -0,0 +1,165 @@
+#include "doctest.h"
+#include "../../../exchanges/websocket/frame_journal.hpp"
+#include "../../../exchanges/websocket/capturing_websocket_transport.hpp"
+#include "../../mocks/mock_websocket_transport.hpp"
+#include "../../mocks/replay_websocket_transport.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("FrameJournal - Captured Frames Read Back In Order") {
+    const std::string path = "test_capture.wsj";
+    websocket_transport::JournalFrame frame;
+
+    // Capture mode around a transport: frames reach the subscriber and the journal
+    {
+        std::atomic<int> delivered{0};
+        websocket_transport::FrameJournalWriter::Config config;
+        config.path = path;
+        auto mock = std::make_unique<test_utils::MockWebSocketTransport>();
+        auto* feed = mock.get();
+        {
+            websocket_transport::CapturingWebSocketTransport transport(std::move(mock), config);
+            transport.set_message_callback([&](const websocket_transport::WebSocketMessage&) { delivered.fetch_add(1); });
+            REQUIRE(transport.connect("wss://example.invalid/ws"));
+            transport.start_event_loop();
+            feed->simulate_custom_message("{\"seq\":1}");
+            feed->simulate_custom_message("{\"seq\":2}");
+            feed->simulate_custom_message("{\"seq\":3}");
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+            while (delivered.load() < 3 && std::chrono::steady_clock::now() < deadline) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            }
+            CHECK(delivered.load() == 3);
+        }
+
+        websocket_transport::FrameJournalReader captured(path);
+        REQUIRE(captured.open());
+        std::vector<websocket_transport::JournalFrame> frames;
+        while (captured.next(frame)) frames.push_back(frame);
+        REQUIRE(frames.size() == 3);
+        CHECK(frames[0].data == "{\"seq\":1}");
+        CHECK(frames[2].data == "{\"seq\":3}");
+        CHECK(frames[0].receive_ns >= captured.created_steady_ns());
+        CHECK(frames[1].receive_ns >= frames[0].receive_ns);
+    }
+
+    // Frames appended directly, spanning several blocks
+    {
+        websocket_transport::FrameJournalWriter::Config config;
+        config.path = path;
+        config.block_size = 1024;
+        websocket_transport::FrameJournalWriter writer(config);
+        REQUIRE(writer.open());
+        for (int i = 0; i < 500; ++i) {
+            websocket_transport::WebSocketMessage message;
+            message.data = "{\"u\":" + std::to_string(i) + ",\"b\":[[\"100.5\",\"1.25\"]]}";
+            message.is_binary = (i % 100 == 0);
+            message.channel = i % 2 ? "depth" : "";
+            REQUIRE(writer.append(message, 1000 + static_cast<uint64_t>(i)));
+        }
+        writer.close();
+        CHECK(writer.get_statistics().frames_written.load() == 500);
+        CHECK(writer.get_statistics().blocks_written.load() > 1);
+        CHECK(writer.get_statistics().compressed_bytes.load() < writer.get_statistics().raw_bytes.load());
+        CHECK_FALSE(writer.append(websocket_transport::WebSocketMessage{}, 0));
+    }
+
+    websocket_transport::FrameJournalReader reader(path);
+    REQUIRE(reader.open());
+    CHECK(reader.created_wall_ns() > 0);
+    int count = 0;
+    while (reader.next(frame)) {
+        CHECK(frame.receive_ns == 1000 + static_cast<uint64_t>(count));
+        CHECK(frame.data == "{\"u\":" + std::to_string(count) + ",\"b\":[[\"100.5\",\"1.25\"]]}");
+        CHECK(frame.is_binary == (count % 100 == 0));
+        CHECK(frame.channel == (count % 2 ? "depth" : ""));
+        ++count;
+    }
+    CHECK(count == 500);
+    CHECK_FALSE(reader.is_truncated());
+
+    reader.rewind();
+    REQUIRE(reader.next(frame));
+    CHECK(frame.receive_ns == 1000);
+    reader.close();
+
+    // A torn last block is skipped, everything before it survives
+    {
+        std::ifstream in(path, std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        in.close();
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 7));
+    }
+    websocket_transport::FrameJournalReader torn(path);
+    REQUIRE(torn.open());
+    int survived = 0;
+    while (torn.next(frame)) ++survived;
+    CHECK(survived > 0);
+    CHECK(survived < 500);
+    CHECK(torn.is_truncated());
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("ReplayWebSocketTransport - Replays Journal At Max And Scaled Speed") {
+    const std::string path = "test_replay.wsj";
+    {
+        websocket_transport::FrameJournalWriter::Config config;
+        config.path = path;
+        websocket_transport::FrameJournalWriter writer(config);
+        REQUIRE(writer.open());
+        // 20 frames captured 5 ms apart: 95 ms of traffic
+        for (int i = 0; i < 20; ++i) {
+            websocket_transport::WebSocketMessage message;
+            message.data = "frame-" + std::to_string(i);
+            REQUIRE(writer.append(message, 1'000'000'000ULL + static_cast<uint64_t>(i) * 5'000'000ULL));
+        }
+        writer.close();
+    }
+
+    SUBCASE("Max speed, frames held until a callback is set") {
+        test_utils::ReplayWebSocketTransport replay(path, 0.0);
+        REQUIRE(replay.connect("wss://replay"));
+        CHECK(replay.send_message("{\"method\":\"SUBSCRIBE\"}"));
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        CHECK(replay.get_frames_replayed() == 0);
+
+        std::vector<std::string> received;
+        std::mutex received_mutex;
+        replay.set_message_callback([&](const websocket_transport::WebSocketMessage& message) {
+            std::lock_guard<std::mutex> lock(received_mutex);
+            received.push_back(message.data);
+        });
+        REQUIRE(replay.wait_until_finished(std::chrono::milliseconds(2000)));
+        std::lock_guard<std::mutex> lock(received_mutex);
+        REQUIRE(received.size() == 20);
+        CHECK(received.front() == "frame-0");
+        CHECK(received.back() == "frame-19");
+        CHECK(replay.get_sent_messages().size() == 1);
+    }
+
+    SUBCASE("Scaled speed keeps the captured spacing") {
+        test_utils::ReplayWebSocketTransport replay(path, 2.0);
+        std::atomic<int> received{0};
+        replay.set_message_callback([&](const websocket_transport::WebSocketMessage&) { received.fetch_add(1); });
+        auto start = std::chrono::steady_clock::now();
+        REQUIRE(replay.connect("wss://replay"));
+        REQUIRE(replay.wait_until_finished(std::chrono::milliseconds(2000)));
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        CHECK(received.load() == 20);
+        CHECK(elapsed >= std::chrono::milliseconds(45));   // 95 ms at 2x
+    }
+
+    test_utils::ReplayWebSocketTransport missing("no_such_journal.wsj", 0.0);
+    CHECK_FALSE(missing.connect("wss://replay"));
+    CHECK(missing.get_state() == websocket_transport::WebSocketState::ERROR);
+
+    std::remove(path.c_str());
+}
@@ -0,0 +1,254 @@
+#include "doctest.h"
+#include "../../../exchanges/websocket/libuv_websocket_transport.hpp"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Loopback TCP peer: accepts one connection at a time and records what it reads
+class LoopbackPeer {
+public:
+    LoopbackPeer() {
+        listen_fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        ::bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        ::listen(listen_fd_, 4);
+        socklen_t len = sizeof(addr);
+        ::getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&addr), &len);
+        port_ = ntohs(addr.sin_port);
+        thread_ = std::thread([this]() { run(); });
+    }
+
+    ~LoopbackPeer() {
+        stopping_.store(true);
+        ::shutdown(listen_fd_, SHUT_RDWR);
+        ::close(listen_fd_);
+        close_client();
+        thread_.join();
+    }
+
+    std::string url() const { return "ws://127.0.0.1:" + std::to_string(port_) + "/ws"; }
+
+    std::string received() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return received_;
+    }
+    int connections() const { return connections_.load(); }
+    bool client_closed() const { return client_closed_.load(); }
+
+    void send(const std::string& data) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (client_fd_ >= 0) {
+            ::send(client_fd_, data.data(), data.size(), MSG_NOSIGNAL);
+        }
+    }
+
+    void close_client() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (client_fd_ >= 0) {
+            ::shutdown(client_fd_, SHUT_RDWR);
+        }
+    }
+
+private:
+    void run() {
+        while (!stopping_.load()) {
+            int fd = ::accept(listen_fd_, nullptr, nullptr);
+            if (fd < 0) {
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                client_fd_ = fd;
+                client_closed_.store(false);
+            }
+            connections_.fetch_add(1);
+            char buffer[4096];
+            ssize_t n;
+            while ((n = ::recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                received_.append(buffer, static_cast<size_t>(n));
+            }
+            std::lock_guard<std::mutex> lock(mutex_);
+            ::close(fd);
+            client_fd_ = -1;
+            client_closed_.store(true);
+        }
+    }
+
+    int listen_fd_{-1};
+    int client_fd_{-1};
+    uint16_t port_{0};
+    std::atomic<bool> stopping_{false};
+    std::atomic<int> connections_{0};
+    std::atomic<bool> client_closed_{false};
+    mutable std::mutex mutex_;
+    std::string received_;
+    std::thread thread_;
+};
+
+template <typename Predicate>
+bool wait_for(Predicate predicate) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!predicate() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    return predicate();
+}
+
+} // namespace
+
+TEST_CASE("LibuvWebSocketTransport - Sends From Many Threads Arrive Whole And In Order") {
+    LoopbackPeer peer;
+    websocket_transport::LibuvWebSocketTransport transport;
+    REQUIRE(transport.connect(peer.url()));
+    CHECK(transport.is_connected());
+
+    // Each line is one send; the ring keeps every producer's sends in order
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 2000;
+    std::vector<std::thread> senders;
+    for (int t = 0; t < kThreads; ++t) {
+        senders.emplace_back([&transport, t]() {
+            for (int i = 0; i < kPerThread; ++i) {
+                std::string line = std::to_string(t) + ":" + std::to_string(i) + "\n";
+                while (!transport.send_message(line)) {
+                    std::this_thread::yield();   // Outbound ring full
+                }
+            }
+        });
+    }
+    for (auto& sender : senders) {
+        sender.join();
+    }
+
+    const size_t expected_lines = kThreads * kPerThread;
+    REQUIRE(wait_for([&] {
+        std::string data = peer.received();
+        return static_cast<size_t>(std::count(data.begin(), data.end(), '\n')) >= expected_lines;
+    }));
+
+    std::map<int, int> next;
+    bool ordered = true;
+    size_t lines = 0;
+    std::istringstream stream(peer.received());
+    for (std::string line; std::getline(stream, line); ++lines) {
+        size_t colon = line.find(':');
+        REQUIRE(colon != std::string::npos);
+        int thread = std::stoi(line.substr(0, colon));
+        ordered = ordered && std::stoi(line.substr(colon + 1)) == next[thread];
+        ++next[thread];
+    }
+    CHECK(ordered);
+    CHECK(lines == expected_lines);
+
+    transport.disconnect();
+}
+
+TEST_CASE("LibuvWebSocketTransport - Receives Through The Dispatch Thread") {
+    LoopbackPeer peer;
+    websocket_transport::LibuvWebSocketTransport transport;
+    std::mutex mutex;
+    std::string received;
+    std::atomic<bool> on_io_thread{false};
+    std::thread::id caller = std::this_thread::get_id();
+    transport.set_message_callback([&](const websocket_transport::WebSocketMessage& message) {
+        std::lock_guard<std::mutex> lock(mutex);
+        received += message.data;
+        on_io_thread.store(std::this_thread::get_id() == caller);
+    });
+    REQUIRE(transport.connect(peer.url()));
+    REQUIRE(wait_for([&] { return peer.connections() == 1; }));
+
+    peer.send("hello");
+    CHECK(wait_for([&] {
+        std::lock_guard<std::mutex> lock(mutex);
+        return received == "hello";
+    }));
+    CHECK_FALSE(on_io_thread.load());
+    transport.disconnect();
+}
+
+TEST_CASE("LibuvWebSocketTransport - Close And Reconnect") {
+    LoopbackPeer peer;
+    websocket_transport::LibuvWebSocketTransport transport;
+    std::atomic<int> connects{0};
+    transport.set_connect_callback([&](bool connected) {
+        if (connected) connects.fetch_add(1);
+    });
+
+    REQUIRE(transport.connect(peer.url()));
+    REQUIRE(transport.send_message("first\n"));
+    REQUIRE(wait_for([&] { return peer.received() == "first\n"; }));
+
+    // disconnect() closes the socket with the loop
+    transport.disconnect();
+    CHECK(transport.get_state() == websocket_transport::WebSocketState::DISCONNECTED);
+    CHECK(wait_for([&] { return peer.client_closed(); }));
+    CHECK_FALSE(transport.send_message("dropped\n"));
+
+    // A new connection on the same transport
+    REQUIRE(transport.connect(peer.url()));
+    CHECK(wait_for([&] { return peer.connections() == 2; }));
+    REQUIRE(transport.send_message("second\n"));
+    CHECK(wait_for([&] { return peer.received() == "first\nsecond\n"; }));
+    CHECK(connects.load() == 2);
+
+    // The peer going away is noticed, and connect() works again afterwards
+    peer.close_client();
+    CHECK(wait_for([&] { return !transport.is_connected(); }));
+    CHECK_FALSE(transport.send_message("lost\n"));
+    REQUIRE(transport.connect(peer.url()));
+    CHECK(wait_for([&] { return peer.connections() == 3; }));
+    transport.disconnect();
+}
+
+TEST_CASE("LibuvWebSocketTransport - Shutdown With Traffic In Flight") {
+    LoopbackPeer peer;
+    {
+        websocket_transport::LibuvWebSocketTransport transport;
+        transport.set_message_callback([](const websocket_transport::WebSocketMessage&) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        });
+        REQUIRE(transport.connect(peer.url()));
+        REQUIRE(wait_for([&] { return peer.connections() == 1; }));
+
+        // Senders and inbound traffic still running when shutdown() is called
+        std::atomic<bool> sending{true};
+        std::thread sender([&]() {
+            while (sending.load()) {
+                transport.send_message("x");
+            }
+        });
+        for (int i = 0; i < 50; ++i) {
+            peer.send("tick");
+        }
+        transport.shutdown();
+        CHECK_FALSE(transport.is_connected());
+        CHECK_FALSE(transport.is_event_loop_running());
+        sending.store(false);
+        sender.join();
+        CHECK_FALSE(transport.send_message("late"));
+    }
+    // Destroyed after shutdown: the peer sees the connection close
+    CHECK(wait_for([&] { return peer.client_closed(); }));
+
+    // A URL without a host fails without starting anything
+    websocket_transport::LibuvWebSocketTransport transport;
+    CHECK_FALSE(transport.connect("ws://:1/ws"));
+    CHECK_FALSE(transport.is_event_loop_running());
+}
@@ -0,0 +1,107 @@
+#include "doctest.h"
+#include "../../../exchanges/i_exchange_oms.hpp"
+#include <string>
+#include <vector>
+
+namespace {
+
+// Venue without batch endpoints: records the single calls the default submit_batch makes
+class SingleOrderOMS : public IExchangeOMS {
+public:
+    std::vector<std::string> calls;
+    bool accept{true};
+
+    bool connect() override { return true; }
+    void disconnect() override {}
+    bool is_connected() const override { return true; }
+    void set_auth_credentials(const std::string&, const std::string&) override {}
+    bool is_authenticated() const override { return true; }
+
+    bool cancel_order(const std::string& cl_ord_id, const std::string&, const std::string& symbol) override {
+        calls.push_back("cancel " + cl_ord_id + " " + symbol);
+        return accept;
+    }
+    bool replace_order(const std::string& cl_ord_id, const proto::OrderRequest& new_order) override {
+        calls.push_back("replace " + cl_ord_id + " " + (new_order.side() == proto::BUY ? "BUY " : "SELL ") +
+                        std::to_string(static_cast<int>(new_order.price())));
+        return accept;
+    }
+    proto::OrderEvent get_order_status(const std::string&, const std::string&) override { return {}; }
+
+    bool place_market_order(const std::string& symbol, const std::string& side, double,
+                            const std::string& cl_ord_id) override {
+        calls.push_back("market " + cl_ord_id + " " + symbol + " " + side);
+        return accept;
+    }
+    bool place_limit_order(const std::string& symbol, const std::string& side, double, double price,
+                           const std::string& cl_ord_id) override {
+        calls.push_back("limit " + cl_ord_id + " " + symbol + " " + side + " " + std::to_string(static_cast<int>(price)));
+        return accept;
+    }
+
+    void set_order_status_callback(OrderStatusCallback) override {}
+    void set_websocket_transport(std::shared_ptr<websocket_transport::IWebSocketTransport>) override {}
+};
+
+void add_action(proto::OrderBatchRequest& batch, proto::OrderActionType type, const std::string& cl_ord_id,
+                proto::Side side = proto::BUY, double price = 0.0, proto::OrderType order_type = proto::LIMIT) {
+    proto::OrderAction* action = batch.add_actions();
+    action->set_action(type);
+    proto::OrderRequest* order = action->mutable_order();
+    order->set_cl_ord_id(cl_ord_id);
+    order->set_symbol("BTCUSDT");
+    order->set_side(side);
+    order->set_type(order_type);
+    order->set_qty(0.1);
+    order->set_price(price);
+}
+
+} // namespace
+
+TEST_CASE("IExchangeOMS - Batch Falls Back To Pipelined Singles") {
+    SingleOrderOMS oms;
+    proto::OrderBatchRequest batch;
+    add_action(batch, proto::CANCEL_ORDER, "A");
+    add_action(batch, proto::REPLACE_ORDER, "B", proto::SELL, 50020.0);
+    add_action(batch, proto::NEW_ORDER, "C", proto::SELL, 50010.0);
+    add_action(batch, proto::NEW_ORDER, "D", proto::BUY, 0.0, proto::MARKET);
+
+    std::vector<bool> results;
+    oms.submit_batch(batch, results);
+
+    REQUIRE(results.size() == 4);
+    CHECK(results == std::vector<bool>{true, true, true, true});
+    // Every action becomes one single call, in batch order
+    REQUIRE(oms.calls.size() == 4);
+    // Cancels carry the order's symbol
+    CHECK(oms.calls[0] == "cancel A BTCUSDT");
+    // New orders keep the trader's cl_ord_id; replaces keep the order's side
+    CHECK(oms.calls[1] == "replace B SELL 50020");
+    CHECK(oms.calls[2] == "limit C BTCUSDT SELL 50010");
+    CHECK(oms.calls[3] == "market D BTCUSDT BUY");
+
+    // Failures are reported per action; the batch keeps going
+    oms.accept = false;
+    oms.submit_batch(batch, results);
+    REQUIRE(results.size() == 4);
+    CHECK(results == std::vector<bool>{false, false, false, false});
+    CHECK(oms.calls.size() == 8);
+}
+
+TEST_CASE("OrderBatchRequest - Round Trip Keeps Action Order") {
+    proto::OrderBatchRequest batch;
+    add_action(batch, proto::NEW_ORDER, "Q1_BID", proto::BUY, 49990.0);
+    add_action(batch, proto::CANCEL_ORDER, "Q0_ASK");
+    batch.set_timestamp_us(123);
+
+    std::string payload;
+    REQUIRE(batch.SerializeToString(&payload));
+    proto::OrderBatchRequest parsed;
+    REQUIRE(parsed.ParseFromString(payload));
+    REQUIRE(parsed.actions_size() == 2);
+    CHECK(parsed.actions(0).action() == proto::NEW_ORDER);
+    CHECK(parsed.actions(0).order().cl_ord_id() == "Q1_BID");
+    CHECK(parsed.actions(1).action() == proto::CANCEL_ORDER);
+    CHECK(parsed.actions(1).order().cl_ord_id() == "Q0_ASK");
+    CHECK(parsed.timestamp_us() == 123);
+}
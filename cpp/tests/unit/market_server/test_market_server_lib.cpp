@@ -1,6 +1,7 @@
 #include "doctest.h"
 #include "../../../market_server/market_server_lib.hpp"
 #include "../../../utils/zmq/zmq_publisher.hpp"
+#include "../../../utils/mds/market_data_topics.hpp"
 #include <memory>
 
 TEST_CASE("MarketServerLib - Initialization") {
@@ -30,9 +31,9 @@ TEST_CASE("MarketServerLib - Set ZMQ Publisher") {
 TEST_CASE("MarketServerLib - Set WebSocket Transport") {
     market_server::MarketServerLib server;
     
-    // Create a mock transport (we'll use nullptr for this test)
-    auto transport = std::shared_ptr<websocket_transport::IWebSocketTransport>(nullptr);
-    server.set_websocket_transport(transport);
+    // No transport; the venue keeps the slot until one is set
+    server.set_exchange("binance");
+    server.set_websocket_transport(std::unique_ptr<websocket_transport::IWebSocketTransport>());
     
     CHECK(true); // Should not crash
 }
@@ -51,15 +52,15 @@ TEST_CASE("MarketServerLib - Start and Stop") {
 TEST_CASE("MarketServerLib - Statistics") {
     market_server::MarketServerLib server;
     
-    auto stats = server.get_statistics();
+    const auto& stats = server.get_statistics();
     
     // Test initial statistics
-    CHECK(stats.market_data_received.load() == 0);
+    CHECK(stats.orderbook_updates.load() == 0);
     CHECK(stats.zmq_messages_sent.load() == 0);
     
     // Test reset statistics
     server.reset_statistics();
-    CHECK(stats.market_data_received.load() == 0);
+    CHECK(stats.orderbook_updates.load() == 0);
 }
 
 TEST_CASE("MarketServerLib - Error Handling") {
@@ -67,9 +68,41 @@ TEST_CASE("MarketServerLib - Error Handling") {
     
     // Test error callback
     bool error_called = false;
-    server.set_error_callback([&error_called](const std::string& error) {
+    server.set_error_callback([&error_called](const std::string&) {
         error_called = true;
     });
     
     CHECK(true); // Callback should be set
 }
+
+TEST_CASE("MarketServerLib - Multi-Venue Subscriptions") {
+    market_server::MarketServerLib server;
+    
+    server.add_subscription("BINANCE", "BTCUSDT", 2);
+    server.add_subscription("BINANCE", "ETHUSDT");
+    server.add_subscription("binance", "BTCUSDT");  // duplicate, case-insensitive venue
+    server.add_subscription("DERIBIT", "BTC-PERPETUAL");
+    
+    auto venues = server.get_venue_configs();
+    REQUIRE(venues.size() == 2);
+    CHECK(venues[0].exchange == "BINANCE");
+    CHECK(venues[0].symbols == std::vector<std::string>{"BTCUSDT", "ETHUSDT"});
+    CHECK(venues[0].cpu_core == 2);
+    CHECK(venues[1].exchange == "DERIBIT");
+    CHECK(venues[1].symbols == std::vector<std::string>{"BTC-PERPETUAL"});
+    CHECK(venues[1].cpu_core == -1);
+}
+
+TEST_CASE("MarketServerLib - Topic Layout") {
+    CHECK(md_topics::make_topic(md_topics::ORDERBOOK, "binance", "BTCUSDT") == "market_data.BINANCE.BTCUSDT|");
+    CHECK(md_topics::make_topic(md_topics::TRADES, "DERIBIT", "BTC-PERPETUAL") == "trades.DERIBIT.BTC-PERPETUAL|");
+    
+    // Channel and venue prefixes match every instrument below them
+    std::string topic = md_topics::make_topic(md_topics::ORDERBOOK, "GRVT", "ETH_USDT_Perp");
+    CHECK(topic.rfind(md_topics::ORDERBOOK, 0) == 0);
+    CHECK(topic.rfind(md_topics::venue_prefix(md_topics::ORDERBOOK, "grvt"), 0) == 0);
+    
+    // An instrument's topic is not a prefix of a longer symbol's
+    std::string longer = md_topics::make_topic(md_topics::ORDERBOOK, "GRVT", "ETH_USDT_Perp2");
+    CHECK(longer.rfind(topic, 0) == std::string::npos);
+}
@@ -0,0 +1,140 @@
+#include "doctest.h"
+#include "../../../strategies/mm_strategy/quote_ladder.hpp"
+#include "../../../strategies/mm_strategy/quote_manager.hpp"
+#include <string>
+#include <vector>
+
+namespace {
+
+ExchangeSymbolInfo ladder_symbol() {
+    // 0.5 tick, 0.001 step, 0.002 minimum
+    return ExchangeSymbolInfo("BTCUSDT", "BINANCE", 0.5, 0.001, 0.002, 0.0, 1, 3);
+}
+
+QuoteLadder::Inputs ladder_inputs(double top_price) {
+    QuoteLadder::Inputs inputs;
+    inputs.top_price = top_price;
+    inputs.top_size = 0.01;
+    inputs.mid_price = 50000.0;
+    inputs.collateral = 1.0;
+    inputs.volatility = 0.0;
+    inputs.min_size = 0.002;
+    return inputs;
+}
+
+GlftTarget::Config ladder_glft() {
+    GlftTarget::Config glft;
+    glft.base_spread = 0.0001;      // 2.5 half-spread at 50000
+    glft.inventory_penalty = 0.0;
+    glft.risk_aversion = 0.0;
+    return glft;
+}
+
+} // namespace
+
+TEST_CASE("QuoteLadder - Spacing In Whole Ticks") {
+    QuoteLadder ladder;
+    ExchangeSymbolInfo info = ladder_symbol();
+    GlftTarget::Config glft = ladder_glft();
+
+    // 2.5 is exactly 5 ticks
+    CHECK(ladder.level_spacing(ladder_inputs(49990.0), glft, info) == doctest::Approx(2.5));
+
+    // Inventory term widens it: 0.01 of collateral * 0.1 slope adds 25, rounded up to ticks
+    glft.inventory_penalty = 0.1;
+    CHECK(ladder.level_spacing(ladder_inputs(49990.0), glft, info) == doctest::Approx(27.5));
+
+    // Never tighter than the configured minimum
+    glft = ladder_glft();
+    glft.base_spread = 0.0;
+    QuoteLadder::Config config;
+    config.min_level_spacing_ticks = 3;
+    ladder.set_config(config);
+    CHECK(ladder.level_spacing(ladder_inputs(49990.0), glft, info) == doctest::Approx(1.5));
+}
+
+TEST_CASE("QuoteLadder - Levels On Fixed Grid") {
+    QuoteLadder::Config config;
+    config.levels = 4;
+    config.level_size_multiplier = 1.5;
+    QuoteLadder ladder(config);
+    ExchangeSymbolInfo info = ladder_symbol();
+    GlftTarget::Config glft = ladder_glft();
+
+    QuoteManager::LevelSet bids;
+    ladder.build(proto::BUY, ladder_inputs(49991.0), glft, info, bids);
+    REQUIRE(bids.count == 4);
+    CHECK(bids[0].price == doctest::Approx(49991.0));
+    CHECK(bids[1].price == doctest::Approx(49990.0));
+    CHECK(bids[2].price == doctest::Approx(49987.5));
+    CHECK(bids[3].price == doctest::Approx(49985.0));
+    // 0.01 * 1.5^k rounded down to the step
+    CHECK(bids[1].qty == doctest::Approx(0.015));
+    CHECK(bids[2].qty == doctest::Approx(0.022));
+    CHECK(bids[3].qty == doctest::Approx(0.033));
+
+    // A top on the grid is not repeated: deeper levels start strictly behind it
+    QuoteManager::LevelSet asks;
+    ladder.build(proto::SELL, ladder_inputs(50010.0), glft, info, asks);
+    REQUIRE(asks.count == 4);
+    CHECK(asks[1].price == doctest::Approx(50012.5));
+    CHECK(asks[3].price == doctest::Approx(50017.5));
+
+    // Shrinking sizes stop at the minimum
+    config.level_size_multiplier = 0.5;
+    ladder.set_config(config);
+    ladder.build(proto::BUY, ladder_inputs(49991.0), glft, info, bids);
+    CHECK(bids.count == 3);   // 0.01, 0.005, 0.0025 -> 0.002, then 0.00125 < min
+    CHECK(bids[2].qty == doctest::Approx(0.002));
+
+    // Single level is just the top quote
+    config.levels = 1;
+    ladder.set_config(config);
+    ladder.build(proto::BUY, ladder_inputs(49991.0), glft, info, bids);
+    CHECK(bids.count == 1);
+}
+
+TEST_CASE("QuoteLadder - Small Top Move Touches One Order") {
+    QuoteLadder::Config config;
+    config.levels = 4;
+    QuoteLadder ladder(config);
+    ExchangeSymbolInfo info = ladder_symbol();
+    GlftTarget::Config glft = ladder_glft();
+
+    std::vector<std::string> sent;
+    int modified = 0;
+    int cancelled = 0;
+    int next_id = 0;
+    QuoteManager manager(
+        "BTCUSDT",
+        [&sent](const std::string& id, const std::string&, proto::Side, proto::OrderType, double, double) {
+            sent.push_back(id);
+            return true;
+        },
+        [&cancelled](const std::string&) { ++cancelled; return true; },
+        [&modified](const std::string&, double, double) { ++modified; return true; },
+        [&next_id]() { return "L" + std::to_string(next_id++); });
+    QuoteManager::Config amend;
+    amend.amend_enabled = true;
+    manager.set_config(amend);
+
+    QuoteManager::LevelSet bids;
+    ladder.build(proto::BUY, ladder_inputs(49991.0), glft, info, bids);
+    CHECK(manager.reconcile(proto::BUY, bids).placed == 4);
+    for (const std::string& id : sent) {
+        proto::OrderEvent ack;
+        ack.set_cl_ord_id(id);
+        ack.set_event_type(proto::ACK);
+        manager.on_order_event(ack);
+    }
+
+    // Top moves by less than the spacing: the grid below is unchanged
+    ladder.build(proto::BUY, ladder_inputs(49991.5), glft, info, bids);
+    QuoteManager::Actions actions = manager.reconcile(proto::BUY, bids);
+    CHECK(actions.messages() == 1);
+    CHECK(actions.amended == 1);
+    CHECK(actions.unchanged == 3);
+    CHECK(modified == 1);
+    CHECK(cancelled == 0);
+    CHECK(sent.size() == 4);
+}
@@ -0,0 +1,276 @@
+#include "doctest.h"
+#include "../../../strategies/mm_strategy/quote_manager.hpp"
+#include "../../../proto/order.pb.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Records every order message the quote manager sends
+struct FakeVenue {
+    std::vector<std::string> sent;
+    std::vector<std::string> cancelled;
+    std::vector<std::string> modified;
+    std::vector<double> modified_qty;
+    bool accept_modify{true};
+    bool accept_cancel{true};
+    int next_id{0};
+
+    QuoteManager make() {
+        return QuoteManager(
+            "BTCUSDT",
+            [this](const std::string& id, const std::string&, proto::Side, proto::OrderType, double, double) {
+                sent.push_back(id);
+                return true;
+            },
+            [this](const std::string& id) {
+                if (accept_cancel) cancelled.push_back(id);
+                return accept_cancel;
+            },
+            [this](const std::string& id, double, double qty) {
+                if (accept_modify) {
+                    modified.push_back(id);
+                    modified_qty.push_back(qty);
+                }
+                return accept_modify;
+            },
+            [this]() { return "Q" + std::to_string(next_id++); });
+    }
+
+    size_t messages() const { return sent.size() + cancelled.size() + modified.size(); }
+};
+
+QuoteManager::Config amending() {
+    QuoteManager::Config config;
+    config.amend_enabled = true;
+    return config;
+}
+
+proto::OrderEvent event(const std::string& id, proto::OrderEventType type, double fill_qty = 0.0) {
+    proto::OrderEvent order_event;
+    order_event.set_cl_ord_id(id);
+    order_event.set_event_type(type);
+    order_event.set_fill_qty(fill_qty);
+    return order_event;
+}
+
+void ack_all(QuoteManager& manager) {
+    for (proto::Side side : {proto::BUY, proto::SELL}) {
+        for (const auto& order : manager.get_working_orders(side)) {
+            manager.on_order_event(event(order.cl_ord_id, proto::ACK));
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("QuoteManager - Only Changed Sides Generate Messages") {
+    FakeVenue venue;
+    QuoteManager manager = venue.make();
+    manager.set_config(amending());
+
+    // First quote: one new order per side
+    CHECK(manager.reconcile(proto::BUY, {{100.0, 1.0}}).placed == 1);
+    CHECK(manager.reconcile(proto::SELL, {{101.0, 1.0}}).placed == 1);
+    CHECK(venue.sent.size() == 2);
+
+    // Unacknowledged orders are not touched even if the quote moved
+    QuoteManager::Actions pending = manager.reconcile(proto::BUY, {{99.5, 1.0}});
+    CHECK(pending.deferred == 1);
+    CHECK(pending.messages() == 0);
+    ack_all(manager);
+
+    // Same quotes: nothing is sent
+    CHECK(manager.reconcile(proto::BUY, {{100.0, 1.0}}).unchanged == 1);
+    CHECK(manager.reconcile(proto::SELL, {{101.0, 1.0}}).unchanged == 1);
+    CHECK(venue.messages() == 2);
+
+    // Only the bid moved: one amend, the ask keeps its queue position
+    QuoteManager::Actions bid = manager.reconcile(proto::BUY, {{99.5, 1.0}});
+    QuoteManager::Actions ask = manager.reconcile(proto::SELL, {{101.0, 1.0}});
+    CHECK(bid.amended == 1);
+    CHECK(bid.messages() == 1);
+    CHECK(ask.unchanged == 1);
+    CHECK(venue.modified.size() == 1);
+    REQUIRE(manager.get_working_orders(proto::BUY).size() == 1);
+    CHECK(manager.get_working_orders(proto::BUY)[0].price == doctest::Approx(99.5));
+
+    // Moves within the price tolerance are ignored
+    QuoteManager::Config config = amending();
+    config.price_tolerance_bps = 2.0;
+    manager.set_config(config);
+    CHECK(manager.reconcile(proto::SELL, {{101.01, 1.0}}).unchanged == 1);
+
+    // Dropping a side cancels only that side
+    QuoteManager::Actions dropped = manager.reconcile(proto::SELL, {});
+    CHECK(dropped.cancelled == 1);
+    CHECK(manager.get_working_orders(proto::SELL).empty());
+    CHECK(manager.get_working_orders(proto::BUY).size() == 1);
+    CHECK(manager.pending_cancel_count(proto::SELL) == 1);
+}
+
+TEST_CASE("QuoteManager - Ladder Shift Keeps Matching Levels") {
+    FakeVenue venue;
+    QuoteManager manager = venue.make();
+    manager.set_config(amending());
+
+    manager.reconcile(proto::BUY, {{100.0, 1.0}, {99.0, 2.0}, {98.0, 3.0}});
+    ack_all(manager);
+    venue.sent.clear();
+
+    // Ladder moves down a level: 99 and 98 stay, 100 is amended to 97
+    QuoteManager::Actions actions = manager.reconcile(proto::BUY, {{99.0, 2.0}, {98.0, 3.0}, {97.0, 4.0}});
+    CHECK(actions.unchanged == 2);
+    CHECK(actions.amended == 1);
+    CHECK(actions.messages() == 1);
+    CHECK(venue.sent.empty());
+    CHECK(venue.cancelled.empty());
+
+    // Without amend support the moved level is cancelled and replaced
+    venue.accept_modify = false;
+    actions = manager.reconcile(proto::BUY, {{98.0, 3.0}, {97.0, 4.0}, {96.0, 5.0}});
+    CHECK(actions.unchanged == 2);
+    CHECK(actions.cancelled == 1);
+    CHECK(actions.placed == 1);
+    CHECK(manager.get_statistics().replaced.load() == 1);
+}
+
+TEST_CASE("QuoteManager - Order Events Free Slots") {
+    FakeVenue venue;
+    QuoteManager manager = venue.make();
+
+    manager.reconcile(proto::BUY, {{100.0, 2.0}});
+    manager.reconcile(proto::SELL, {{101.0, 1.0}});
+    std::string bid_id = manager.get_working_orders(proto::BUY)[0].cl_ord_id;
+    std::string ask_id = manager.get_working_orders(proto::SELL)[0].cl_ord_id;
+    CHECK(bid_id.find("_BID") != std::string::npos);
+    ack_all(manager);
+
+    // Partial fill keeps the order working, full fill frees the slot
+    manager.on_order_event(event(bid_id, proto::FILL, 0.5));
+    REQUIRE(manager.get_working_orders(proto::BUY).size() == 1);
+    CHECK(manager.get_working_orders(proto::BUY)[0].filled_qty == doctest::Approx(0.5));
+    manager.on_order_event(event(bid_id, proto::FILL, 1.5));
+    CHECK(manager.get_working_orders(proto::BUY).empty());
+
+    // Reject frees the slot; unknown ids are ignored
+    manager.on_order_event(event("someone_else", proto::CANCEL));
+    manager.on_order_event(event(ask_id, proto::REJECT));
+    CHECK(manager.get_working_orders(proto::SELL).empty());
+
+    // Next reconcile replaces what was filled
+    CHECK(manager.reconcile(proto::BUY, {{100.0, 2.0}}).placed == 1);
+    ack_all(manager);
+    CHECK(manager.cancel_all().cancelled == 1);
+    CHECK(manager.get_working_orders(proto::BUY).empty());
+}
+
+TEST_CASE("QuoteManager - Amends Off By Default And Sent As Total Quantity") {
+    FakeVenue venue;
+    QuoteManager manager = venue.make();
+    CHECK_FALSE(manager.get_config().amend_enabled);
+
+    manager.reconcile(proto::BUY, {{100.0, 2.0}});
+    ack_all(manager);
+    const std::string first = manager.get_working_orders(proto::BUY)[0].cl_ord_id;
+
+    // Without amends a move is cancel + new
+    QuoteManager::Actions moved = manager.reconcile(proto::BUY, {{99.0, 2.0}});
+    CHECK(moved.cancelled == 1);
+    CHECK(moved.placed == 1);
+    CHECK(venue.modified.empty());
+    manager.on_order_event(event(first, proto::CANCEL));
+
+    // With amends, the quantity asked for includes what already filled
+    manager.set_config(amending());
+    ack_all(manager);
+    const std::string second = manager.get_working_orders(proto::BUY)[0].cl_ord_id;
+    manager.on_order_event(event(second, proto::FILL, 0.5));
+    CHECK(manager.reconcile(proto::BUY, {{98.0, 3.0}}).amended == 1);
+    REQUIRE(venue.modified_qty.size() == 1);
+    CHECK(venue.modified_qty[0] == doctest::Approx(3.5));
+    const QuoteManager::WorkingOrder amended = manager.get_working_orders(proto::BUY)[0];
+    CHECK(amended.qty == doctest::Approx(3.5));
+    CHECK(amended.filled_qty == doctest::Approx(0.5));
+
+    // Open size unchanged after the amend: nothing more to send
+    CHECK(manager.reconcile(proto::BUY, {{98.0, 3.0}}).unchanged == 1);
+    manager.on_order_event(event(second, proto::FILL, 3.0));
+    CHECK(manager.get_working_orders(proto::BUY).empty());
+}
+
+TEST_CASE("QuoteManager - Cancelled Orders Are Held Until Confirmed") {
+    FakeVenue venue;
+    QuoteManager manager = venue.make();
+
+    manager.reconcile(proto::SELL, {{101.0, 1.0}});
+    ack_all(manager);
+    const std::string id = manager.get_working_orders(proto::SELL)[0].cl_ord_id;
+
+    CHECK(manager.reconcile(proto::SELL, {}).cancelled == 1);
+    CHECK(manager.get_working_orders(proto::SELL).empty());
+    CHECK(manager.pending_cancel_count(proto::SELL) == 1);
+
+    // Not re-cancelled by reconcile, but cancel_all retries it
+    CHECK(manager.reconcile(proto::SELL, {}).messages() == 0);
+    CHECK(manager.cancel_all().cancelled == 1);
+    CHECK(venue.cancelled.size() == 2);
+
+    // A fill racing the cancel still counts against the order
+    manager.on_order_event(event(id, proto::FILL, 0.4));
+    CHECK(manager.pending_cancel_count(proto::SELL) == 1);
+    manager.on_order_event(event(id, proto::CANCEL));
+    CHECK(manager.pending_cancel_count(proto::SELL) == 0);
+
+    // A refused cancel leaves the order quoted, to be cancelled again
+    manager.reconcile(proto::SELL, {{102.0, 1.0}});
+    ack_all(manager);
+    venue.accept_cancel = false;
+    CHECK(manager.reconcile(proto::SELL, {}).failed == 1);
+    CHECK(manager.get_working_orders(proto::SELL).size() == 1);
+    venue.accept_cancel = true;
+    CHECK(manager.reconcile(proto::SELL, {}).cancelled == 1);
+    CHECK(manager.pending_cancel_count(proto::SELL) == 1);
+}
+
+TEST_CASE("QuoteManager - Full Ladder Stays Quoted While Cancels Are Pending") {
+    FakeVenue venue;
+    QuoteManager manager = venue.make();
+
+    auto ladder = [](double best) {
+        QuoteManager::LevelSet levels;
+        for (size_t i = 0; i < QuoteManager::kMaxLevels; ++i) {
+            levels.push({best - static_cast<double>(i), 1.0});
+        }
+        return levels;
+    };
+
+    CHECK(manager.reconcile(proto::BUY, ladder(100.0)).placed == QuoteManager::kMaxLevels);
+    ack_all(manager);
+
+    // Two whole-ladder shifts with amends off (cancel + new) and no CANCEL confirmed in between
+    for (double best : {90.0, 80.0}) {
+        QuoteManager::Actions actions = manager.reconcile(proto::BUY, ladder(best));
+        CHECK(actions.cancelled == QuoteManager::kMaxLevels);
+        CHECK(actions.placed == QuoteManager::kMaxLevels);
+        CHECK(actions.failed == 0);
+        ack_all(manager);
+    }
+
+    std::vector<QuoteManager::WorkingOrder> working = manager.get_working_orders(proto::BUY);
+    REQUIRE(working.size() == QuoteManager::kMaxLevels);
+    for (size_t i = 0; i < QuoteManager::kMaxLevels; ++i) {
+        const double price = 80.0 - static_cast<double>(i);
+        CHECK(std::count_if(working.begin(), working.end(),
+                            [price](const QuoteManager::WorkingOrder& order) { return order.price == price; }) == 1);
+    }
+    CHECK(manager.pending_cancel_count(proto::BUY) == 2 * QuoteManager::kMaxLevels);
+
+    // Late confirmations clear the pending list without touching the live ladder
+    for (const std::string& id : venue.cancelled) {
+        manager.on_order_event(event(id, proto::CANCEL));
+    }
+    CHECK(manager.pending_cancel_count(proto::BUY) == 0);
+    CHECK(manager.get_working_orders(proto::BUY).size() == QuoteManager::kMaxLevels);
+}
@@ -0,0 +1,233 @@
+#include "doctest.h"
+#include "../../../trader/mini_oms.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Records what MiniOMS hands to the wire
+class RecordingGateway : public IOrderGateway {
+public:
+    struct Call {
+        std::string action;
+        std::string cl_ord_id;
+        std::string exch;
+        std::string symbol;
+        double qty{0.0};
+        double price{0.0};
+        uint32_t side{0};
+    };
+
+    bool send_order(const std::string& cl_ord_id, const std::string& exch, const std::string& symbol,
+                    uint32_t side, uint32_t, double qty, double price) override {
+        calls.push_back({"send", cl_ord_id, exch, symbol, qty, price, side});
+        return accept;
+    }
+    bool cancel_order(const std::string& cl_ord_id, const std::string& exch, const std::string& symbol) override {
+        calls.push_back({"cancel", cl_ord_id, exch, symbol});
+        return accept;
+    }
+    bool modify_order(const std::string& cl_ord_id, const std::string& exch, uint32_t side, double new_price,
+                      double new_qty, const std::string& symbol) override {
+        calls.push_back({"modify", cl_ord_id, exch, symbol, new_qty, new_price, side});
+        return accept;
+    }
+    void begin_batch() override {}
+    bool flush_batch() override { return true; }
+
+    std::vector<Call> calls;
+    bool accept{true};
+};
+
+proto::OrderEvent order_event(const std::string& cl_ord_id, proto::OrderEventType type, double fill_qty = 0.0,
+                              double fill_price = 0.0) {
+    proto::OrderEvent event;
+    event.set_cl_ord_id(cl_ord_id);
+    event.set_event_type(type);
+    event.set_fill_qty(fill_qty);
+    event.set_fill_price(fill_price);
+    event.set_exch_order_id("X-" + cl_ord_id);
+    return event;
+}
+
+} // namespace
+
+TEST_CASE("MiniOMS - Order Lifecycle By OrderId") {
+    auto gateway = std::make_shared<RecordingGateway>();
+    MiniOMS oms(64);
+    oms.set_exchange_name("MINIOMS_TEST");
+    oms.set_oms_adapter(gateway);
+    oms.start();
+
+    const MiniOMS::OrderId id = oms.place_order("BTC-PERP", proto::BUY, proto::LIMIT, 2.0, 100.0);
+    REQUIRE(id != MiniOMS::kInvalidOrderId);
+    REQUIRE(gateway->calls.size() == 1);
+    const std::string wire_id = gateway->calls[0].cl_ord_id;
+    CHECK_FALSE(wire_id.empty());
+    CHECK(gateway->calls[0].exch == "MINIOMS_TEST");
+    CHECK(oms.find_order_id(wire_id) == id);
+    CHECK(oms.active_order_count() == 1);
+
+    oms.on_order_event(order_event(wire_id, proto::ACK));
+    CHECK(oms.get_order_state(wire_id).state == OrderState::ACKNOWLEDGED);
+    CHECK(oms.get_order_state(wire_id).exchange_order_id == "X-" + wire_id);
+
+    // A replace acknowledgement is not an error and changes nothing
+    REQUIRE(oms.modify_order(id, 101.0, 2.0));
+    CHECK(gateway->calls.back().action == "modify");
+    CHECK(gateway->calls.back().cl_ord_id == wire_id);
+    CHECK(gateway->calls.back().side == 0);
+    oms.on_order_event(order_event(wire_id, proto::ACK));
+    CHECK(oms.get_order_state(wire_id).price == 101.0);
+    CHECK(oms.get_order_state(wire_id).state == OrderState::ACKNOWLEDGED);
+
+    // Fills accumulate and complete the order
+    oms.on_order_event(order_event(wire_id, proto::FILL, 0.5, 101.0));
+    oms.on_order_event(order_event(wire_id, proto::FILL, 0.5, 103.0));
+    OrderStateInfo partial = oms.get_order_state(wire_id);
+    CHECK(partial.state == OrderState::PARTIALLY_FILLED);
+    CHECK(partial.filled_qty == 1.0);
+    CHECK(partial.avg_fill_price == doctest::Approx(102.0));
+    oms.on_order_event(order_event(wire_id, proto::FILL, 1.0, 101.0));
+    CHECK(oms.get_order_state(wire_id).state == OrderState::FILLED);
+    CHECK(oms.active_order_count() == 0);
+    CHECK(oms.get_statistics().filled_orders.load() == 1);
+    CHECK(oms.get_statistics().active_orders.load() == 0);
+
+    // Nothing left to cancel
+    CHECK_FALSE(oms.cancel_order(id));
+    oms.stop();
+}
+
+TEST_CASE("MiniOMS - Modify Sets The Total Size Including Fills") {
+    auto gateway = std::make_shared<RecordingGateway>();
+    MiniOMS oms(64);
+    oms.set_exchange_name("MINIOMS_TEST");
+    oms.set_oms_adapter(gateway);
+    oms.start();
+
+    const MiniOMS::OrderId id = oms.place_order("BTC-PERP", proto::SELL, proto::LIMIT, 1.0, 100.0);
+    const std::string wire_id = gateway->calls[0].cl_ord_id;
+    oms.on_order_event(order_event(wire_id, proto::ACK));
+    oms.on_order_event(order_event(wire_id, proto::FILL, 0.5, 100.0));
+
+    // 2.0 total leaves 1.5 open: a further fill keeps the order live
+    REQUIRE(oms.modify_order(id, 100.5, 2.0));
+    CHECK(gateway->calls.back().qty == doctest::Approx(2.0));
+    CHECK(gateway->calls.back().side == 1);
+    oms.on_order_event(order_event(wire_id, proto::FILL, 0.5, 100.5));
+    CHECK(oms.get_order_state(wire_id).state == OrderState::PARTIALLY_FILLED);
+    CHECK(oms.active_order_count() == 1);
+
+    // A size at or below what has filled is refused rather than completing the order
+    const size_t sent = gateway->calls.size();
+    CHECK_FALSE(oms.modify_order(id, 100.5, 1.0));
+    CHECK_FALSE(oms.modify_order(id, 100.5, 0.4));
+    CHECK(gateway->calls.size() == sent);
+    CHECK(oms.get_order_state(wire_id).qty == doctest::Approx(2.0));
+
+    oms.on_order_event(order_event(wire_id, proto::FILL, 1.0, 100.5));
+    CHECK(oms.get_order_state(wire_id).state == OrderState::FILLED);
+    oms.stop();
+}
+
+TEST_CASE("MiniOMS - Caller Ids, Views And Cancels") {
+    auto gateway = std::make_shared<RecordingGateway>();
+    MiniOMS oms(64);
+    oms.set_exchange_name("MINIOMS_TEST");
+    oms.set_oms_adapter(gateway);
+    oms.start();
+
+    REQUIRE(oms.send_order("bid-1", "BTC-PERP", proto::BUY, proto::LIMIT, 1.0, 99.0));
+    REQUIRE(oms.send_order("bid-2", "BTC-PERP", proto::BUY, proto::LIMIT, 1.0, 98.0));
+    REQUIRE(oms.send_order("ask-1", "BTC-PERP", proto::SELL, proto::LIMIT, 1.0, 101.0));
+    REQUIRE(oms.send_order("eth-1", "ETH-PERP", proto::BUY, proto::LIMIT, 1.0, 10.0));
+    CHECK(gateway->calls[1].cl_ord_id == "bid-2");
+    // Duplicate of a live order
+    CHECK_FALSE(oms.send_order("bid-1", "BTC-PERP", proto::BUY, proto::LIMIT, 1.0, 97.0));
+
+    std::vector<std::string> bids;
+    oms.visit_active_orders("BTC-PERP", proto::BUY, [&](const OrderRecord& order) {
+        bids.emplace_back(order.cl_ord_id());
+    });
+    CHECK(bids == std::vector<std::string>{"bid-1", "bid-2"});
+    size_t unknown = 0;
+    oms.visit_active_orders("SOL-PERP", proto::BUY, [&](const OrderRecord&) { ++unknown; });
+    CHECK(unknown == 0);
+    CHECK(oms.get_orders_by_symbol("BTC-PERP").size() == 3);
+
+    // Cancel needs an acknowledged order, and completes on the exchange's event
+    CHECK_FALSE(oms.cancel_order("bid-1"));
+    oms.on_order_event(order_event("bid-1", proto::ACK));
+    REQUIRE(oms.cancel_order("bid-1"));
+    CHECK(gateway->calls.back().action == "cancel");
+    CHECK(gateway->calls.back().symbol == "BTC-PERP");
+    CHECK(oms.get_order_state("bid-1").state == OrderState::ACKNOWLEDGED);
+    oms.on_order_event(order_event("bid-1", proto::CANCEL));
+    CHECK(oms.get_order_state("bid-1").state == OrderState::CANCELLED);
+
+    bool visited = oms.visit_order(oms.find_order_id("bid-2"), [&](const OrderRecord& order) {
+        CHECK(order.price == 98.0);
+    });
+    CHECK(visited);
+    CHECK(oms.get_active_orders().size() == 3);
+    CHECK(oms.get_orders_by_state(OrderState::CANCELLED).size() == 1);
+
+    // A refused send leaves the order rejected
+    gateway->accept = false;
+    CHECK(oms.place_order("BTC-PERP", proto::SELL, proto::LIMIT, 1.0, 102.0) == MiniOMS::kInvalidOrderId);
+    CHECK(oms.get_orders_by_state(OrderState::REJECTED).size() == 1);
+    CHECK(oms.get_statistics().rejected_orders.load() == 1);
+    CHECK(oms.get_statistics().pending_orders.load() == 3);
+
+    // Stop cancels what is still live
+    gateway->accept = true;
+    const size_t before = gateway->calls.size();
+    oms.stop();
+    CHECK(gateway->calls.size() == before + 3);
+}
+
+TEST_CASE("MiniOMS - Statistics Follow Applied Transitions Only") {
+    auto gateway = std::make_shared<RecordingGateway>();
+    MiniOMS oms(64);
+    oms.set_exchange_name("MINIOMS_TEST");
+    oms.set_oms_adapter(gateway);
+    oms.start();
+    const auto& stats = oms.get_statistics();
+
+    // A fill that overtakes the ACK acknowledges the order: it leaves pending, not active
+    REQUIRE(oms.send_order("fast", "BTC-PERP", proto::BUY, proto::LIMIT, 1.0, 100.0));
+    CHECK(stats.pending_orders.load() == 1);
+    oms.on_order_event(order_event("fast", proto::FILL, 1.0, 100.0));
+    CHECK(oms.get_order_state("fast").state == OrderState::FILLED);
+    CHECK(oms.get_order_state("fast").filled_qty == 1.0);
+    CHECK(stats.pending_orders.load() == 0);
+    CHECK(stats.active_orders.load() == 0);
+    CHECK(stats.filled_orders.load() == 1);
+
+    // A repeated ACK on a partially filled order changes neither state nor counts
+    REQUIRE(oms.send_order("slow", "BTC-PERP", proto::SELL, proto::LIMIT, 2.0, 101.0));
+    oms.on_order_event(order_event("slow", proto::ACK));
+    oms.on_order_event(order_event("slow", proto::FILL, 0.5, 101.0));
+    CHECK(stats.active_orders.load() == 1);
+    oms.on_order_event(order_event("slow", proto::ACK));
+    CHECK(oms.get_order_state("slow").state == OrderState::PARTIALLY_FILLED);
+    CHECK(stats.pending_orders.load() == 0);
+    CHECK(stats.active_orders.load() == 1);
+
+    // Events for a finished order are refused and leave fills and counts alone
+    oms.on_order_event(order_event("slow", proto::CANCEL));
+    CHECK(stats.active_orders.load() == 0);
+    CHECK(stats.cancelled_orders.load() == 1);
+    oms.on_order_event(order_event("slow", proto::FILL, 0.5, 101.0));
+    oms.on_order_event(order_event("slow", proto::CANCEL));
+    oms.on_order_event(order_event("fast", proto::FILL, 1.0, 100.0));
+    CHECK(oms.get_order_state("slow").state == OrderState::CANCELLED);
+    CHECK(oms.get_order_state("slow").filled_qty == 0.5);
+    CHECK(oms.get_order_state("fast").filled_qty == 1.0);
+    CHECK(stats.active_orders.load() == 0);
+    CHECK(stats.cancelled_orders.load() == 1);
+    CHECK(stats.filled_orders.load() == 1);
+    oms.stop();
+}
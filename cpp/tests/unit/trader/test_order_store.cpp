@@ -0,0 +1,114 @@
+#include "doctest.h"
+#include "../../../trader/order_store.hpp"
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<std::string> live_ids(const OrderStore& store, uint32_t instrument, Side side) {
+    std::vector<std::string> ids;
+    store.for_each_live(instrument, side, [&](const OrderRecord& order) { ids.emplace_back(order.cl_ord_id()); });
+    return ids;
+}
+
+} // namespace
+
+TEST_CASE("OrderStore - Ids Carry A Generation And Go Stale") {
+    OrderStore store(2);
+    const uint32_t btc = store.intern_instrument("SIM", "BTC");
+    CHECK(store.intern_instrument("SIM", "BTC") == btc);
+    CHECK(store.find_instrument("SIM", "ETH") == OrderStore::kNoInstrument);
+
+    OrderRecord* a = store.insert("a", btc, Side::Buy, false, 1.0, 100.0, 1);
+    REQUIRE(a);
+    const OrderStore::OrderId a_id = a->id;
+    CHECK(a_id != OrderStore::kInvalidOrderId);
+    CHECK(store.find(a_id) == a);
+    CHECK(store.find(std::string_view("a")) == a);
+
+    // A live id cannot be reused; a second order fills the store
+    CHECK(store.insert("a", btc, Side::Buy, false, 1.0, 100.0, 2) == nullptr);
+    OrderRecord* b = store.insert("b", btc, Side::Sell, false, 1.0, 101.0, 2);
+    REQUIRE(b);
+    CHECK(store.insert("c", btc, Side::Buy, false, 1.0, 99.0, 3) == nullptr);
+    CHECK(store.live_count() == 2);
+
+    // Once terminal, a's slot is the one recycled, under a new generation
+    REQUIRE(store.transition(*a, OrderState::REJECTED, 4));
+    CHECK(store.live_count() == 1);
+    CHECK(store.find(a_id) == a);
+    OrderRecord* c = store.insert("c", btc, Side::Buy, false, 1.0, 99.0, 5);
+    REQUIRE(c);
+    CHECK(c == a);
+    CHECK(c->id != a_id);
+    CHECK(store.find(a_id) == nullptr);
+    CHECK(store.find(std::string_view("a")) == nullptr);
+    CHECK(store.find(std::string_view("c")) == c);
+    CHECK(c->filled_qty == 0.0);
+    CHECK(c->reason().empty());
+
+    // Invalid transitions change nothing
+    CHECK_FALSE(store.transition(*c, OrderState::FILLED, 6));
+    CHECK(c->state == OrderState::PENDING);
+
+    // Over-long ids are refused, not truncated
+    CHECK(store.insert(std::string(OrderRecord::kMaxClOrdIdLength + 1, 'x'), btc, Side::Buy, false, 1, 1, 7) == nullptr);
+}
+
+TEST_CASE("OrderStore - Live Lists Per Instrument And Side") {
+    OrderStore store(16);
+    const uint32_t btc = store.intern_instrument("SIM", "BTC");
+    const uint32_t eth = store.intern_instrument("SIM", "ETH");
+
+    std::vector<OrderRecord*> orders;
+    for (const char* id : {"b1", "b2", "s1", "e1", "b3"}) {
+        const bool sell = id[0] == 's';
+        orders.push_back(store.insert(id, id[0] == 'e' ? eth : btc, sell ? Side::Sell : Side::Buy, false, 1.0, 1.0, 0));
+        REQUIRE(orders.back());
+    }
+    CHECK(live_ids(store, btc, Side::Buy) == std::vector<std::string>{"b1", "b2", "b3"});
+    CHECK(live_ids(store, btc, Side::Sell) == std::vector<std::string>{"s1"});
+    CHECK(live_ids(store, eth, Side::Buy) == std::vector<std::string>{"e1"});
+    CHECK(live_ids(store, OrderStore::kNoInstrument, Side::Buy).empty());
+
+    // Leaving from the middle, the head and the tail
+    REQUIRE(store.transition(*orders[1], OrderState::ACKNOWLEDGED, 1));
+    CHECK(live_ids(store, btc, Side::Buy).size() == 3);
+    REQUIRE(store.transition(*orders[1], OrderState::CANCELLED, 2));
+    CHECK(live_ids(store, btc, Side::Buy) == std::vector<std::string>{"b1", "b3"});
+    REQUIRE(store.transition(*orders[0], OrderState::REJECTED, 3));
+    REQUIRE(store.transition(*orders[4], OrderState::REJECTED, 3));
+    CHECK(live_ids(store, btc, Side::Buy).empty());
+    CHECK(store.live_count() == 2);
+    CHECK(store.size() == 5);
+
+    // Terminal orders stay readable
+    size_t held = 0;
+    store.for_each([&](const OrderRecord&) { ++held; });
+    CHECK(held == 5);
+    CHECK(store.find(std::string_view("b2"))->state == OrderState::CANCELLED);
+}
+
+TEST_CASE("OrderStore - Generated Ids And Index Churn") {
+    OrderStore store(8);
+    const uint32_t btc = store.intern_instrument("SIM", "BTC");
+
+    // Many more orders than slots: every one is found by its own id until recycled
+    std::string previous;
+    for (int i = 0; i < 5000; ++i) {
+        OrderRecord* order = store.insert("", btc, i % 2 ? Side::Sell : Side::Buy, false, 1.0, 1.0, i);
+        REQUIRE(order);
+        const std::string id(order->cl_ord_id());
+        CHECK(id.size() <= 15);   // Fits std::string's small buffer
+        CHECK(id != previous);
+        char formatted[OrderRecord::kMaxClOrdIdLength + 1];
+        CHECK(std::string_view(formatted, store.format_cl_ord_id(order->id, formatted, sizeof(formatted))) == id);
+        CHECK(store.find(std::string_view(id)) == order);
+        REQUIRE(store.transition(*order, OrderState::ACKNOWLEDGED, i));
+        REQUIRE(store.transition(*order, OrderState::CANCELLED, i));
+        previous = id;
+    }
+    CHECK(store.size() == 8);
+    CHECK(store.live_count() == 0);
+    CHECK(store.find(std::string_view(previous)) != nullptr);
+}
@@ -0,0 +1,143 @@
+#include "doctest.h"
+#include "../../../trader/strategy_executor.hpp"
+#include "../../../strategies/base_strategy/strategy_mutex.hpp"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace {
+
+template <typename Predicate>
+bool wait_until(Predicate predicate, std::chrono::milliseconds timeout = std::chrono::milliseconds(2000)) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!predicate()) {
+        if (std::chrono::steady_clock::now() > deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+} // namespace
+
+TEST_CASE("StrategyExecutor - Runs Events In Arrival Order On One Thread") {
+    std::vector<uint64_t> sequences;
+    std::vector<std::string> symbols;
+    std::set<std::thread::id> threads;
+    std::atomic<int> handled{0};
+
+    StrategyExecutor::Config config;
+    config.queue_capacity = 1024;
+    StrategyExecutor executor(config, [&](StrategyEvent& event) {
+        // Only the strategy thread touches these, so no locking
+        sequences.push_back(event.sequence);
+        threads.insert(std::this_thread::get_id());
+        if (event.type == StrategyEvent::Type::POSITION_UPDATE) symbols.push_back(event.position.symbol());
+        handled.fetch_add(1);
+    });
+
+    // Events queued before start() are delivered once it runs
+    proto::PositionUpdate position;
+    position.set_symbol("FIRST");
+    REQUIRE(executor.post_position_update(position));
+    executor.start();
+
+    // Two producers, as from the market data and order event threads
+    auto produce = [&executor](const std::string& prefix) {
+        for (int i = 0; i < 200; ++i) {
+            proto::OrderBookSnapshot book;
+            book.set_symbol(prefix + std::to_string(i));
+            executor.post_market_data(book);
+        }
+    };
+    std::thread first(produce, "a");
+    std::thread second(produce, "b");
+    first.join();
+    second.join();
+
+    bool task_on_executor = false;
+    REQUIRE(executor.post_task([&]() {
+        task_on_executor = executor.on_executor_thread();
+        handled.fetch_add(1);
+    }));
+    REQUIRE(wait_until([&]() { return handled.load() == 402; }));
+    executor.stop();
+
+    CHECK(task_on_executor);
+    CHECK_FALSE(executor.on_executor_thread());
+    CHECK(threads.size() == 1);
+    REQUIRE(symbols.size() == 1);
+    CHECK(symbols[0] == "FIRST");
+    for (size_t i = 1; i < sequences.size(); ++i) {
+        CHECK(sequences[i] == sequences[i - 1] + 1);
+    }
+    CHECK(executor.get_statistics().processed.load() == 402);
+    CHECK(executor.get_statistics().dropped.load() == 0);
+}
+
+TEST_CASE("StrategyExecutor - Full Queue Drops Books But Holds Order Events") {
+    std::atomic<bool> release{false};
+    std::atomic<int> order_events{0};
+    std::atomic<int> books{0};
+
+    StrategyExecutor::Config config;
+    config.queue_capacity = 2;
+    StrategyExecutor executor(config, [&](StrategyEvent& event) {
+        while (!release.load()) std::this_thread::yield();
+        if (event.type == StrategyEvent::Type::ORDER_EVENT) order_events.fetch_add(1);
+        if (event.type == StrategyEvent::Type::MARKET_DATA) books.fetch_add(1);
+    });
+    executor.start();
+
+    // The strategy thread is stuck on the first book (its slot stays taken); the second fills the queue
+    proto::OrderBookSnapshot book;
+    REQUIRE(executor.post_market_data(book));
+    REQUIRE(wait_until([&]() { return executor.get_statistics().last_queue_delay_ns.load() > 0; }));
+    REQUIRE(executor.post_market_data(book));
+    CHECK_FALSE(executor.post_market_data(book));
+    CHECK(executor.get_statistics().dropped.load() == 1);
+
+    // An order event waits for room instead of being lost
+    std::atomic<bool> posted{false};
+    std::thread producer([&]() {
+        proto::OrderEvent fill;
+        fill.set_cl_ord_id("ORDER_1");
+        posted.store(executor.post_order_event(fill));
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    CHECK_FALSE(posted.load());
+    release.store(true);
+    producer.join();
+    CHECK(posted.load());
+    REQUIRE(wait_until([&]() { return order_events.load() == 1; }));
+    CHECK(books.load() == 2);
+    CHECK(executor.get_statistics().waited.load() == 1);
+    executor.stop();
+}
+
+TEST_CASE("StrategyMutex - Locks Only While Enabled") {
+    StrategyMutex mutex;
+    CHECK(mutex.is_enabled());
+    {
+        std::lock_guard<StrategyMutex> lock(mutex);
+        std::atomic<bool> acquired{false};
+        std::thread other([&]() {
+            std::lock_guard<StrategyMutex> inner(mutex);
+            acquired.store(true);
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        CHECK_FALSE(acquired.load());   // Held by this thread
+        mutex.unlock();
+        other.join();
+        CHECK(acquired.load());
+        mutex.lock();                   // Rebalance for the guard
+    }
+
+    // Disabled: lock() never blocks, even when "held"
+    mutex.set_enabled(false);
+    std::lock_guard<StrategyMutex> lock(mutex);
+    std::lock_guard<StrategyMutex> again(mutex);
+    CHECK_FALSE(mutex.is_enabled());
+}
@@ -7,8 +7,12 @@
 #include "../../../proto/order.pb.h"
 #include "../../../proto/market_data.pb.h"
 #include "../../../proto/position.pb.h"
+#include "../../../utils/zmq/zmq_publisher.hpp"
 #include <memory>
 #include <atomic>
+#include <chrono>
+#include <fstream>
+#include <thread>
 
 // Mock strategy for testing
 class MockStrategy : public AbstractStrategy {
@@ -88,6 +92,71 @@ TEST_CASE("TraderLib - Start and Stop") {
     CHECK(!trader_lib.is_running());
 }
 
+TEST_CASE("TraderLib - Restart Needs Initialize") {
+    trader::TraderLib trader_lib;
+    REQUIRE(trader_lib.initialize());
+    auto strategy = std::make_shared<MockStrategy>();
+    trader_lib.set_strategy(strategy);
+    
+    trader_lib.start();
+    REQUIRE(trader_lib.is_running());
+    trader_lib.stop();
+    
+    // stop() closed the adapters, so a bare start() is refused
+    trader_lib.start();
+    CHECK(!trader_lib.is_running());
+    
+    // initialize() builds new adapters and keeps the strategy
+    REQUIRE(trader_lib.initialize());
+    CHECK(trader_lib.get_strategy() == strategy);
+    trader_lib.start();
+    CHECK(trader_lib.is_running());
+    CHECK_FALSE(trader_lib.initialize());
+    
+    trader_lib.stop();
+}
+
+TEST_CASE("TraderLib - Reactor Event Loop Start and Stop") {
+    // Own endpoints so the adapters do not meet the other TraderLib cases' sockets
+    {
+        std::ofstream config_file("test_trader_reactor.ini");
+        config_file << "[SUBSCRIBERS]\n";
+        config_file << "EVENT_LOOP = reactor\n";
+        config_file << "MARKET_SERVER_SUB_ENDPOINT = tcp://127.0.0.1:5592\n";
+        config_file << "POSITION_SERVER_SUB_ENDPOINT = tcp://127.0.0.1:5593\n";
+        config_file << "TRADING_ENGINE_SUB_ENDPOINT = tcp://127.0.0.1:5594\n";
+        config_file << "[PUBLISHERS]\n";
+        config_file << "ORDER_EVENTS_PUB_ENDPOINT = tcp://127.0.0.1:5595\n";
+    }
+    ZmqPublisher position_server("tcp://127.0.0.1:5593");
+    
+    trader::TraderLib trader_lib;
+    REQUIRE(trader_lib.initialize("test_trader_reactor.ini"));
+    trader_lib.set_strategy(std::make_shared<MockStrategy>());
+    trader_lib.start();
+    REQUIRE(trader_lib.is_running());
+    
+    // A position published by the "position server" reaches MiniPMS through the reactor thread
+    proto::PositionUpdate position;
+    position.set_exch("binance");
+    position.set_symbol("BTCUSDT");
+    position.set_qty(0.25);
+    const std::string payload = position.SerializeAsString();
+    for (int i = 0; i < 50 && !trader_lib.get_position("binance", "BTCUSDT"); ++i) {
+        position_server.send_string("position_updates", payload);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    auto received = trader_lib.get_position("binance", "BTCUSDT");
+    REQUIRE(received.has_value());
+    CHECK(received->qty == doctest::Approx(0.25));
+    
+    // stop() ends and joins the reactor thread before the adapters close its sockets
+    trader_lib.stop();
+    CHECK(!trader_lib.is_running());
+    trader_lib.stop();
+    CHECK(!trader_lib.is_running());
+}
+
 TEST_CASE("TraderLib - Order Management") {
     trader::TraderLib trader_lib;
     
@@ -158,7 +227,7 @@ TEST_CASE("TraderLib - Balance Queries") {
 TEST_CASE("TraderLib - Statistics") {
     trader::TraderLib trader_lib;
     
-    auto stats = trader_lib.get_statistics();
+    const auto& stats = trader_lib.get_statistics();
     
     // Test initial statistics
     CHECK(stats.orders_sent.load() == 0);
@@ -178,7 +247,7 @@ TEST_CASE("TraderLib - Simulation Methods") {
     // Test simulation methods (for testing)
     proto::OrderBookSnapshot orderbook;
     orderbook.set_symbol("BTCUSDT");
-    orderbook.set_exchange("binance");
+    orderbook.set_exch("binance");
     
     trader_lib.simulate_market_data(orderbook);
     
@@ -191,7 +260,7 @@ TEST_CASE("TraderLib - Simulation Methods") {
     
     proto::PositionUpdate position;
     position.set_symbol("BTCUSDT");
-    position.set_exchange("binance");
+    position.set_exch("binance");
     position.set_qty(0.1);
     
     trader_lib.simulate_position_update(position);
@@ -0,0 +1,151 @@
+#include "doctest.h"
+#include "../../../utils/logging/binary_logger.hpp"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::string read_file(const std::string& path) {
+    std::ifstream in(path);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+int count_lines(const std::string& text, const std::string& needle) {
+    int count = 0;
+    for (size_t pos = text.find(needle); pos != std::string::npos; pos = text.find(needle, pos + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+} // namespace
+
+TEST_CASE("BinaryLogger - Deferred Formatting") {
+    static constexpr logging::LogSite site{logging::LogLevel::WARN, "MDS", "Book {} bid {} x {} stale={} side={}"};
+
+    logging::LogRecord record;
+    logging::LogArgEncoder encoder(record.args, logging::LogRecord::kArgBytes);
+    encoder.put(std::string("BTCUSDT"));
+    encoder.put(50000.5);
+    encoder.put(uint64_t{12});
+    encoder.put(false);
+    encoder.put('B');
+    encoder.put(-7);   // no placeholder left: appended
+    record.site = &site;
+    record.timestamp_ns = 1640995200123456789ULL;
+    record.arg_bytes = static_cast<uint16_t>(encoder.size());
+
+    std::string line;
+    logging::BinaryLogger::format_record(record, 3, line);
+    CHECK(line.find(".123456 [WARN] [MDS] [T3] Book BTCUSDT bid 50000.5 x 12 stale=false side=B -7\n") !=
+          std::string::npos);
+
+    // Strings are cut to the record, never overrun it
+    logging::LogRecord big;
+    logging::LogArgEncoder big_encoder(big.args, logging::LogRecord::kArgBytes);
+    big_encoder.put(std::string(1000, 'x'));
+    CHECK(big_encoder.truncated());
+    CHECK(big_encoder.size() == logging::LogRecord::kArgBytes);
+}
+
+TEST_CASE("BinaryLogger - Level Filtering And Multi-Thread Delivery") {
+    const std::string path = "/tmp/binary_logger_test.log";
+    std::remove(path.c_str());
+
+    logging::BinaryLoggerConfig config;
+    config.log_file = path;
+    config.console = false;
+    config.min_level = logging::LogLevel::INFO;
+    logging::BinaryLogger::get_instance().start(config);
+
+    // Disabled levels do not evaluate their arguments
+    int evaluated = 0;
+    auto expensive = [&evaluated]() { ++evaluated; return 1; };
+    FAST_LOG_DEBUG("TEST", "debug {}", expensive());
+    CHECK(evaluated == 0);
+    FAST_LOG_INFO("TEST", "info {}", expensive());
+    CHECK(evaluated == 1);
+
+    constexpr int kThreads = 3;
+    constexpr int kPerThread = 500;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([t]() {
+            for (int i = 0; i < kPerThread; ++i) {
+                FAST_LOG_INFO("TEST", "thread {} seq {}", t, i);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    logging::BinaryLogger::get_instance().flush();
+    std::string text = read_file(path);
+    CHECK(count_lines(text, "[INFO] [TEST]") == 1 + kThreads * kPerThread - static_cast<int>(
+        logging::BinaryLogger::get_instance().get_dropped_count()));
+    CHECK(text.find("info 1\n") != std::string::npos);
+    CHECK(text.find("debug") == std::string::npos);
+
+    // Per-thread order is preserved
+    size_t first = text.find("thread 0 seq 0\n");
+    size_t last = text.find("thread 0 seq 499\n");
+    REQUIRE(first != std::string::npos);
+    REQUIRE(last != std::string::npos);
+    CHECK(first < last);
+
+    logging::BinaryLogger::get_instance().stop();
+    CHECK_FALSE(logging::BinaryLogger::is_enabled(logging::LogLevel::ERROR));
+    std::remove(path.c_str());
+}
+
+TEST_CASE("BinaryLogger - Shares LogManager's File") {
+    const std::string path = "/tmp/binary_logger_shared_test.log";
+    std::remove(path.c_str());
+
+    auto sink = std::make_shared<logging::LogFileSink>(path);
+    REQUIRE(sink->is_open());
+
+    logging::BinaryLoggerConfig config;
+    config.file_sink = sink;
+    config.console = false;
+    logging::BinaryLogger::get_instance().start(config);
+
+    // Another writer (LogManager) appends whole lines through the same sink meanwhile
+    std::thread other([&sink]() {
+        for (int i = 0; i < 200; ++i) {
+            std::string line = "[OTHER] line " + std::to_string(i) + "\n";
+            sink->write(line.data(), line.size(), true);
+        }
+    });
+    for (int i = 0; i < 200; ++i) {
+        FAST_LOG_INFO("TEST", "fast line {}", i);
+    }
+    other.join();
+
+    logging::BinaryLogger::get_instance().flush();
+    logging::BinaryLogger::get_instance().stop();
+    // The logger let go of the sink; the owner still holds it open
+    config.file_sink.reset();
+    CHECK(sink.use_count() == 1);
+    sink.reset();
+
+    std::string text = read_file(path);
+    CHECK(count_lines(text, "[OTHER] line ") == 200);
+    CHECK(count_lines(text, "fast line ") == 200 - static_cast<int>(
+        logging::BinaryLogger::get_instance().get_dropped_count()));
+
+    // Lines never split: each one starts a line of its own
+    std::istringstream lines(text);
+    std::string line;
+    while (std::getline(lines, line)) {
+        bool other_line = line.rfind("[OTHER] line ", 0) == 0;
+        bool fast_line = line.find("[INFO] [TEST]") != std::string::npos && line.find("fast line ") != std::string::npos;
+        CHECK((other_line || fast_line));
+    }
+    std::remove(path.c_str());
+}
@@ -0,0 +1,189 @@
+#include "doctest.h"
+#include "../../../utils/exchange/exchange_symbol_registry.hpp"
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// The registry is a process-wide singleton, so these tests use their own
+// exchange names and never depend on what other tests loaded
+void write_symbol_config(const std::string& path, double btc_tick, bool with_eth) {
+    std::ofstream file(path);
+    file << "[REGTEST:BTC-PERP]\n"
+         << "tick_size = " << btc_tick << "\n"
+         << "step_size = 0.001\n"
+         << "min_order_size = 0.002\n"
+         << "max_order_size = 10\n"
+         << "price_precision = 2\n"
+         << "qty_precision = 3\n"
+         << "contract_size = 0.001\n"
+         << "contract_size_denomination = BTC\n";
+    file << "[REGTEST:USD-PERP]\n"
+         << "tick_size = 0.01\n"
+         << "step_size = 1\n"
+         << "contract_size = 10\n"
+         << "contract_size_denomination = USD\n";
+    if (with_eth) {
+        file << "[REGTEST:ETH-PERP]\n"
+             << "tick_size = 0.05\n"
+             << "step_size = 0.01\n";
+    }
+}
+
+} // namespace
+
+TEST_CASE("ExchangeSymbolRegistry - Handles Survive Reloads") {
+    auto& registry = ExchangeSymbolRegistry::get_instance();
+    const std::string path = "test_symbol_registry.ini";
+    write_symbol_config(path, 0.1, false);
+    REQUIRE(registry.load_from_config(path));
+
+    const auto btc = registry.find_instrument("REGTEST", "BTC-PERP");
+    const auto usd = registry.find_instrument("REGTEST", "USD-PERP");
+    REQUIRE(btc != ExchangeSymbolRegistry::kInvalidInstrument);
+    REQUIRE(usd != ExchangeSymbolRegistry::kInvalidInstrument);
+    CHECK(btc != usd);
+    CHECK(registry.find_instrument("REGTEST", "ETH-PERP") == ExchangeSymbolRegistry::kInvalidInstrument);
+    CHECK(registry.symbol_info(btc).symbol == "BTC-PERP");
+    CHECK(registry.instrument_spec(btc).inv_tick_size == doctest::Approx(10.0));
+    const InstrumentSpec& before = registry.instrument_spec(btc);
+
+    // A reload changes the tick, adds a symbol and keeps existing handles
+    const size_t count = registry.instrument_count();
+    write_symbol_config(path, 0.5, true);
+    REQUIRE(registry.load_from_config(path));
+    std::remove(path.c_str());
+
+    CHECK(registry.find_instrument("REGTEST", "BTC-PERP") == btc);
+    CHECK(registry.find_instrument("REGTEST", "USD-PERP") == usd);
+    const auto eth = registry.find_instrument("REGTEST", "ETH-PERP");
+    CHECK(eth == count);
+    CHECK(registry.instrument_count() == count + 1);
+    CHECK(registry.instrument_spec(btc).tick_size == 0.5);
+    CHECK(registry.get_symbol_info("REGTEST", "BTC-PERP").tick_size == 0.5);
+    // The old snapshot is still readable
+    CHECK(before.tick_size == doctest::Approx(0.1));
+
+    // Unknown handles read as invalid rather than out of bounds
+    CHECK_FALSE(registry.instrument_spec(ExchangeSymbolRegistry::kInvalidInstrument).is_valid);
+    CHECK_FALSE(registry.symbol_info(static_cast<ExchangeSymbolRegistry::InstrumentHandle>(count + 100)).is_valid);
+}
+
+TEST_CASE("ExchangeSymbolRegistry - Rounds And Validates By Handle") {
+    auto& registry = ExchangeSymbolRegistry::get_instance();
+    const std::string path = "test_symbol_registry.ini";
+    write_symbol_config(path, 0.1, false);
+    REQUIRE(registry.load_from_config(path));
+    std::remove(path.c_str());
+    const auto btc = registry.find_instrument("REGTEST", "BTC-PERP");
+
+    double qty = 0.12345;
+    double price = 50000.07;
+    REQUIRE(registry.validate_and_round(btc, qty, price));
+    CHECK(qty == 0.123);
+    CHECK(price == 50000.0);
+
+    // On-tick values stay put even when value / tick is just under an integer
+    qty = 0.3;
+    price = 0.3;
+    REQUIRE(registry.validate_and_round(btc, qty, price));
+    CHECK(price == 0.3);
+    CHECK(qty == 0.3);
+
+    // Below the minimum after rounding
+    qty = 0.0019;
+    price = 100.0;
+    CHECK_FALSE(registry.validate_and_round(btc, qty, price));
+    CHECK(qty == 0.001);
+
+    CHECK(registry.validate_only(btc, 1.0, 50000.1));
+    CHECK_FALSE(registry.validate_only(btc, 1.0, 50000.15));
+    CHECK_FALSE(registry.validate_only(btc, 1.0005, 50000.1));
+    CHECK_FALSE(registry.validate_only(btc, 11.0, 50000.1));
+
+    // The string API agrees with the handle API
+    for (double raw : {0.0123, 1.98765, 5.5}) {
+        double q1 = raw, p1 = 40000.0 + raw * 37.0;
+        double q2 = q1, p2 = p1;
+        CHECK(registry.validate_and_round(btc, q1, p1) == registry.validate_and_round("REGTEST", "BTC-PERP", q2, p2));
+        CHECK(q1 == q2);
+        CHECK(p1 == p2);
+    }
+
+    // No symbol info: allowed unchanged, as before
+    qty = 0.12345;
+    price = 1.2345;
+    CHECK(registry.validate_and_round(ExchangeSymbolRegistry::kInvalidInstrument, qty, price));
+    CHECK(qty == 0.12345);
+    CHECK(price == 1.2345);
+}
+
+TEST_CASE("ExchangeSymbolRegistry - Converts Contracts With Precomputed Multipliers") {
+    auto& registry = ExchangeSymbolRegistry::get_instance();
+    const std::string path = "test_symbol_registry.ini";
+    write_symbol_config(path, 0.1, true);
+    REQUIRE(registry.load_from_config(path));
+    std::remove(path.c_str());
+    const auto btc = registry.find_instrument("REGTEST", "BTC-PERP");
+    const auto usd = registry.find_instrument("REGTEST", "USD-PERP");
+    const auto eth = registry.find_instrument("REGTEST", "ETH-PERP");
+
+    // Base-denominated: 0.001 BTC per contract whatever the price
+    CHECK(registry.contracts_to_token_qty(btc, 500.0, 50000.0) == doctest::Approx(0.5));
+    CHECK(registry.token_qty_to_contracts(btc, 0.5, 30000.0) == doctest::Approx(500.0));
+    CHECK(registry.contracts_to_token_qty(btc, -250.0, 50000.0) ==
+          doctest::Approx(registry.contracts_to_token_qty("REGTEST", "BTC-PERP", -250.0, 50000.0)));
+
+    // Quote-denominated: 10 USD per contract
+    CHECK(registry.contracts_to_token_qty(usd, 5.0, 100.0) == doctest::Approx(0.5));
+    CHECK(registry.token_qty_to_contracts(usd, 0.5, 100.0) == doctest::Approx(5.0));
+
+    // No contract size, bad price or unknown handle: 0
+    CHECK(registry.contracts_to_token_qty(eth, 5.0, 100.0) == 0.0);
+    CHECK(registry.contracts_to_token_qty(btc, 5.0, 0.0) == 0.0);
+    CHECK(registry.contracts_to_token_qty(ExchangeSymbolRegistry::kInvalidInstrument, 5.0, 100.0) == 0.0);
+}
+
+TEST_CASE("ExchangeSymbolRegistry - Readers Run Through Reloads") {
+    auto& registry = ExchangeSymbolRegistry::get_instance();
+    const std::string path = "test_symbol_registry.ini";
+    write_symbol_config(path, 0.1, false);
+    REQUIRE(registry.load_from_config(path));
+    const auto btc = registry.find_instrument("REGTEST", "BTC-PERP");
+
+    // Readers only ever see a whole snapshot: the tick is 0.1 or 0.5, never a mix
+    std::atomic<bool> done{false};
+    std::atomic<size_t> bad{0};
+    std::atomic<size_t> reads{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 3; ++t) {
+        readers.emplace_back([&] {
+            while (!done.load()) {
+                double qty = 1.0;
+                double price = 50000.37;
+                registry.validate_and_round(btc, qty, price);
+                const double tokens = registry.contracts_to_token_qty(btc, 1000.0, 50000.0);
+                bad += (price != 50000.3 && price != 50000.0) || tokens != 1.0;
+                reads.fetch_add(1);
+            }
+        });
+    }
+    for (int i = 0; i < 20; ++i) {
+        write_symbol_config(path, i % 2 ? 0.1 : 0.5, false);
+        registry.load_from_config(path);
+    }
+    while (reads.load() < 1000) {
+        std::this_thread::yield();
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    std::remove(path.c_str());
+
+    CHECK(bad.load() == 0);
+    CHECK(registry.find_instrument("REGTEST", "BTC-PERP") == btc);
+}
@@ -0,0 +1,135 @@
+#include "doctest.h"
+#include "../../../utils/mds/local_order_book.hpp"
+#include "../../../proto/market_data.pb.h"
+
+namespace {
+
+void load_snapshot(LocalOrderBook& book, uint64_t last_update_id) {
+    book.begin_snapshot(last_update_id);
+    book.add_snapshot_level(LocalOrderBook::Side::BID, 99.0, 2.0);
+    book.add_snapshot_level(LocalOrderBook::Side::BID, 100.0, 1.0);
+    book.add_snapshot_level(LocalOrderBook::Side::ASK, 102.0, 2.0);
+    book.add_snapshot_level(LocalOrderBook::Side::ASK, 101.0, 1.0);
+    book.end_snapshot();
+}
+
+} // namespace
+
+TEST_CASE("LocalOrderBook - Snapshot And In-Place Diffs") {
+    LocalOrderBook book("BTCUSDT");
+    load_snapshot(book, 100);
+
+    REQUIRE(book.is_synced());
+    CHECK(book.best_bid()->price == 100.0);
+    CHECK(book.best_ask()->price == 101.0);
+
+    // Bridging diff (U <= lastUpdateId + 1 <= u): insert, update and remove levels
+    CHECK(book.begin_update(95, 105) == LocalOrderBook::UpdateResult::APPLIED);
+    book.apply_level(LocalOrderBook::Side::BID, 100.5, 3.0);
+    book.apply_level(LocalOrderBook::Side::BID, 99.0, 0.0);
+    book.apply_level(LocalOrderBook::Side::ASK, 101.0, 4.0);
+    book.end_update();
+
+    CHECK(book.last_update_id() == 105);
+    CHECK(book.bid_depth() == 2);
+    CHECK(book.bid(0).price == 100.5);
+    CHECK(book.bid(1).price == 100.0);
+    CHECK(book.ask(0).qty == 4.0);
+
+    proto::OrderBookSnapshot snapshot;
+    book.write_snapshot(snapshot, 1);
+    CHECK(snapshot.bids_size() == 1);
+    CHECK(snapshot.asks_size() == 1);
+    CHECK(snapshot.bids(0).price() == 100.5);
+    CHECK(snapshot.asks(0).price() == 101.0);
+}
+
+TEST_CASE("LocalOrderBook - Stale And Contiguous Updates") {
+    LocalOrderBook book("BTCUSDT");
+    load_snapshot(book, 100);
+
+    // Entirely before the snapshot
+    CHECK(book.begin_update(90, 99) == LocalOrderBook::UpdateResult::STALE);
+    book.apply_level(LocalOrderBook::Side::BID, 100.0, 9.0);
+    book.end_update();
+    CHECK(book.best_bid()->qty == 1.0);
+
+    CHECK(book.begin_update(101, 101) == LocalOrderBook::UpdateResult::APPLIED);
+    book.end_update();
+
+    // With a prev id (Binance futures pu) continuity is prev == last applied id
+    CHECK(book.begin_update(102, 110, 101) == LocalOrderBook::UpdateResult::APPLIED);
+    book.end_update();
+    CHECK(book.last_update_id() == 110);
+    CHECK(book.get_stale_count() == 1);
+}
+
+TEST_CASE("LocalOrderBook - Gap Triggers Resync And Replay") {
+    LocalOrderBook book("BTCUSDT");
+    book.set_min_resync_interval_ms(0);
+
+    int resyncs = 0;
+    book.set_resync_handler([&resyncs](LocalOrderBook& target) {
+        ++resyncs;
+        target.begin_snapshot(205);
+        target.add_snapshot_level(LocalOrderBook::Side::BID, 100.0, 1.0);
+        target.add_snapshot_level(LocalOrderBook::Side::ASK, 101.0, 1.0);
+        return target.end_snapshot();
+    });
+
+    load_snapshot(book, 100);
+    CHECK(book.begin_update(101, 101) == LocalOrderBook::UpdateResult::APPLIED);
+    book.end_update();
+
+    // 102..199 missing
+    CHECK(book.begin_update(200, 210) == LocalOrderBook::UpdateResult::GAP);
+    book.apply_level(LocalOrderBook::Side::BID, 100.0, 5.0);
+    book.end_update();
+    CHECK_FALSE(book.is_synced());
+    CHECK(book.get_gap_count() == 1);
+
+    // Buffered while unsynced
+    CHECK(book.begin_update(211, 215) == LocalOrderBook::UpdateResult::BUFFERED);
+    book.apply_level(LocalOrderBook::Side::ASK, 101.0, 0.0);
+    book.apply_level(LocalOrderBook::Side::ASK, 101.5, 2.0);
+    book.end_update();
+
+    // Snapshot at 205 is bridged by the first buffered diff, then the rest replays
+    CHECK(book.resync());
+    CHECK(resyncs == 1);
+    REQUIRE(book.is_synced());
+    CHECK(book.last_update_id() == 215);
+    CHECK(book.best_bid()->qty == 5.0);
+    CHECK(book.best_ask()->price == 101.5);
+}
+
+TEST_CASE("LocalOrderBook - Snapshot Older Than Buffer") {
+    LocalOrderBook book("BTCUSDT");
+
+    CHECK(book.begin_update(300, 310) == LocalOrderBook::UpdateResult::BUFFERED);
+    book.apply_level(LocalOrderBook::Side::BID, 100.0, 5.0);
+    book.end_update();
+
+    // Too old to bridge: book stays unsynced and keeps the buffer
+    load_snapshot(book, 250);
+    CHECK_FALSE(book.is_synced());
+
+    load_snapshot(book, 305);
+    REQUIRE(book.is_synced());
+    CHECK(book.last_update_id() == 310);
+    CHECK(book.best_bid()->qty == 5.0);
+}
+
+TEST_CASE("LocalOrderBook - Level Capacity") {
+    LocalOrderBook book("BTCUSDT", 2);
+    load_snapshot(book, 1);
+
+    CHECK(book.begin_update(2, 2) == LocalOrderBook::UpdateResult::APPLIED);
+    book.apply_level(LocalOrderBook::Side::BID, 98.0, 1.0);    // worse than every kept level
+    book.apply_level(LocalOrderBook::Side::BID, 100.5, 1.0);   // displaces 99.0
+    book.end_update();
+
+    CHECK(book.bid_depth() == 2);
+    CHECK(book.bid(0).price == 100.5);
+    CHECK(book.bid(1).price == 100.0);
+}
@@ -0,0 +1,208 @@
+#include "doctest.h"
+#include "../../../utils/lockfree/spsc_ring.hpp"
+#include "../../../utils/lockfree/mpsc_ring.hpp"
+#include "../../../utils/lockfree/latest_value_slot.hpp"
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("SpscRing - Capacity And In-Place Slots") {
+    SpscRing<std::string> ring(3, WaitStrategy::BUSY_SPIN, [](std::string& slot) { slot.reserve(64); });
+    CHECK(ring.capacity() == 4);
+    CHECK(ring.front() == nullptr);
+
+    for (int i = 0; i < 4; ++i) {
+        std::string* slot = ring.claim();
+        REQUIRE(slot != nullptr);
+        CHECK(slot->capacity() >= 64);
+        slot->assign("msg" + std::to_string(i));
+        ring.publish();
+    }
+    CHECK(ring.claim() == nullptr);
+    CHECK_FALSE(ring.try_push(std::string("overflow")));
+    CHECK(ring.get_full_count() == 1);
+    CHECK(ring.size() == 4);
+
+    REQUIRE(ring.front() != nullptr);
+    CHECK(*ring.front() == "msg0");
+    ring.pop();
+
+    std::string out;
+    CHECK(ring.try_pop(out));
+    CHECK(out == "msg1");
+
+    // Freed slots are reused in order
+    CHECK(ring.try_push(std::string("msg4")));
+    for (const char* expected : {"msg2", "msg3", "msg4"}) {
+        REQUIRE(ring.try_pop(out));
+        CHECK(out == expected);
+    }
+    CHECK(ring.empty());
+}
+
+TEST_CASE("SpscRing - Cross-Thread Ordering") {
+    for (WaitStrategy strategy : {WaitStrategy::BUSY_SPIN, WaitStrategy::YIELD, WaitStrategy::FUTEX}) {
+        SpscRing<uint64_t> ring(64, strategy);
+        constexpr uint64_t kCount = 200000;
+
+        std::thread producer([&ring]() {
+            for (uint64_t i = 0; i < kCount; ++i) {
+                while (!ring.try_push(i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        uint64_t expected = 0;
+        bool ordered = true;
+        while (expected < kCount) {
+            uint64_t* value = ring.wait_front(std::chrono::milliseconds(100));
+            if (!value) continue;
+            ordered = ordered && *value == expected;
+            ring.pop();
+            ++expected;
+        }
+        producer.join();
+
+        CHECK(ordered);
+        CHECK(ring.empty());
+    }
+}
+
+TEST_CASE("SpscRing - Wait Times Out And Wakes") {
+    SpscRing<int> ring(8, WaitStrategy::FUTEX);
+    auto start = std::chrono::steady_clock::now();
+    CHECK(ring.wait_front(std::chrono::milliseconds(20)) == nullptr);
+    CHECK(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(20));
+
+    // A parked consumer is woken by publish()
+    std::thread producer([&ring]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        ring.try_push(42);
+    });
+    int* value = ring.wait_front(std::chrono::seconds(5));
+    producer.join();
+    REQUIRE(value != nullptr);
+    CHECK(*value == 42);
+}
+
+TEST_CASE("SpscRing - Full Producer Waits For A Slot") {
+    SpscRing<int> ring(2, WaitStrategy::FUTEX);
+    REQUIRE(ring.try_push(1));
+    REQUIRE(ring.try_push(2));
+    auto start = std::chrono::steady_clock::now();
+    CHECK(ring.wait_claim(std::chrono::milliseconds(20)) == nullptr);
+    CHECK(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(20));
+
+    // A parked producer is woken by pop()
+    std::thread consumer([&ring]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        ring.pop();
+    });
+    int* slot = ring.wait_claim(std::chrono::seconds(5));
+    consumer.join();
+    REQUIRE(slot != nullptr);
+    *slot = 3;
+    ring.publish();
+    int value = 0;
+    REQUIRE(ring.try_pop(value));
+    CHECK(value == 2);
+}
+
+TEST_CASE("MpscRing - Multiple Producers") {
+    MpscRing<uint64_t> ring(128, WaitStrategy::FUTEX);
+    constexpr int kProducers = 4;
+    constexpr uint64_t kPerProducer = 50000;
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&ring, p]() {
+            for (uint64_t i = 0; i < kPerProducer; ++i) {
+                // Producer id in the top bits, per-producer sequence below
+                uint64_t value = (static_cast<uint64_t>(p) << 32) | i;
+                while (!ring.try_push(value)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::vector<uint64_t> next(kProducers, 0);
+    bool ordered = true;
+    for (uint64_t received = 0; received < kProducers * kPerProducer;) {
+        uint64_t* value = ring.wait_front(std::chrono::milliseconds(100));
+        if (!value) continue;
+        size_t producer = static_cast<size_t>(*value >> 32);
+        ordered = ordered && (*value & 0xFFFFFFFFu) == next[producer];
+        ++next[producer];
+        ring.pop();
+        ++received;
+    }
+    for (auto& producer : producers) producer.join();
+
+    CHECK(ordered);
+    for (uint64_t count : next) CHECK(count == kPerProducer);
+    CHECK(ring.front() == nullptr);
+}
+
+TEST_CASE("WaitStrategy - Parse From Config") {
+    CHECK(parse_wait_strategy("busy_spin") == WaitStrategy::BUSY_SPIN);
+    CHECK(parse_wait_strategy("SPIN") == WaitStrategy::BUSY_SPIN);
+    CHECK(parse_wait_strategy("Yield") == WaitStrategy::YIELD);
+    CHECK(parse_wait_strategy("futex") == WaitStrategy::FUTEX);
+    CHECK(parse_wait_strategy("unknown") == WaitStrategy::FUTEX);
+    CHECK(std::string(wait_strategy_name(WaitStrategy::YIELD)) == "yield");
+}
+
+TEST_CASE("LatestValueSlot - Keeps Only The Newest Value") {
+    LatestValueSlot<std::string> slot([](std::string& buffer) { buffer.reserve(64); });
+    CHECK(slot.consume() == nullptr);
+
+    slot.back().assign("first");
+    CHECK_FALSE(slot.publish());
+    slot.back().assign("second");
+    CHECK(slot.publish());   // "first" was never consumed
+
+    std::string* value = slot.consume();
+    REQUIRE(value != nullptr);
+    CHECK(*value == "second");
+    CHECK(value->capacity() >= 64);
+    CHECK(slot.consume() == nullptr);
+
+    // Buffers rotate: the consumed value stays intact while the producer writes twice more
+    slot.back().assign("third");
+    CHECK_FALSE(slot.publish());
+    slot.back().assign("fourth");
+    CHECK(slot.publish());
+    CHECK(*value == "second");
+    value = slot.consume();
+    REQUIRE(value != nullptr);
+    CHECK(*value == "fourth");
+}
+
+TEST_CASE("LatestValueSlot - Cross-Thread Freshness") {
+    LatestValueSlot<std::vector<int>> slot;
+    constexpr int kUpdates = 100000;
+
+    std::thread producer([&slot]() {
+        for (int i = 1; i <= kUpdates; ++i) {
+            std::vector<int>& back = slot.back();
+            back.assign(4, i);   // Every element equal: a torn read would show mixed values
+            slot.publish();
+        }
+    });
+
+    int last = 0;
+    int consumed = 0;
+    while (last < kUpdates) {
+        const std::vector<int>* value = slot.consume();
+        if (!value) continue;
+        REQUIRE(value->size() == 4);
+        CHECK((*value)[0] == (*value)[3]);
+        CHECK((*value)[0] > last);   // Never an older value than one already seen
+        last = (*value)[0];
+        ++consumed;
+    }
+    producer.join();
+    CHECK(consumed <= kUpdates);
+}
@@ -0,0 +1,137 @@
+#include "doctest.h"
+#include "../../../utils/mds/parser_factory.hpp"
+
+TEST_CASE("MarketDataParser - Binance Diff Depth") {
+    auto parser = create_market_data_parser("binance");
+    REQUIRE(parser != nullptr);
+    ParsedMarketData parsed;
+
+    std::string message = R"({"stream":"btcusdt@depth@100ms","data":{"e":"depthUpdate","E":1640995200000,)"
+                          R"("T":1640995200000,"s":"BTCUSDT","U":157,"u":160,"pu":149,)"
+                          R"("b":[["50000.10","0.250"],["49999.5","0"]],"a":[["50001.00","1.5"]]}})";
+    REQUIRE(parser->parse(message, parsed));
+
+    CHECK(parsed.type == MdMessageType::BOOK_DELTA);
+    CHECK(parsed.channel == "btcusdt@depth@100ms");
+    CHECK(parsed.symbol == "BTCUSDT");
+    CHECK(parsed.exchange_time == 1640995200000ULL);
+    CHECK(parsed.first_id == 157);
+    CHECK(parsed.last_id == 160);
+    CHECK(parsed.prev_id == 149);
+    REQUIRE(parsed.bids.size() == 2);
+    CHECK(parsed.bids[0].price == 50000.10);
+    CHECK(parsed.bids[0].qty == 0.25);
+    CHECK(parsed.bids[1].qty == 0.0);
+    REQUIRE(parsed.asks.size() == 1);
+    CHECK(parsed.asks[0].price == 50001.0);
+}
+
+TEST_CASE("MarketDataParser - Binance Partial Depth And Trades") {
+    auto parser = create_market_data_parser("BINANCE");
+    ParsedMarketData parsed;
+
+    REQUIRE(parser->parse(R"({"stream":"btcusdt@depth20@100ms","data":{"e":"depthUpdate","E":1,"s":"BTCUSDT",)"
+                          R"("U":1,"u":2,"b":[["1.0","2.0"]],"a":[]}})", parsed));
+    CHECK(parsed.type == MdMessageType::BOOK_SNAPSHOT);
+    CHECK(parsed.bids.size() == 1);
+    CHECK(parsed.asks.empty());
+
+    // Trade events reuse "b"/"a" for order ids; they must not become levels
+    REQUIRE(parser->parse(R"({"stream":"btcusdt@trade","data":{"e":"trade","E":2,"s":"BTCUSDT","t":12345,)"
+                          R"("p":"50000.50","q":"0.1","b":88,"a":89,"T":1640995200123,"m":true,"M":true}})", parsed));
+    CHECK(parsed.type == MdMessageType::TRADE);
+    CHECK(parsed.bids.empty());
+    REQUIRE(parsed.trades.size() == 1);
+    CHECK(parsed.trades[0].price == 50000.5);
+    CHECK(parsed.trades[0].qty == 0.1);
+    CHECK(parsed.trades[0].trade_seq == 12345);
+    CHECK(parsed.trades[0].exchange_time == 1640995200123ULL);
+    CHECK(parsed.trades[0].is_buyer_maker);
+
+    REQUIRE(parser->parse(R"({"result":null,"id":1})", parsed));
+    CHECK(parsed.type == MdMessageType::CONTROL);
+    CHECK_FALSE(parsed.is_error);
+
+    CHECK_FALSE(parser->parse("{\"stream\":", parsed));
+    CHECK_FALSE(parser->parse(R"({"data":{"e":"depthUpdate","b":[["abc","1"]]}})", parsed));
+}
+
+TEST_CASE("MarketDataParser - GRVT Full And Lite") {
+    auto parser = create_market_data_parser("GRVT");
+    REQUIRE(parser != nullptr);
+    ParsedMarketData parsed;
+
+    REQUIRE(parser->parse(R"({"method":"orderbook.s","params":["orderbook.s","BTC_USDT_Perp",)"
+                          R"({"timestamp":1700000000000,"bids":[["2533.5","10.5"]],"asks":[["2534.0","8.0"]]}]})", parsed));
+    CHECK(parsed.type == MdMessageType::BOOK_SNAPSHOT);
+    CHECK(parsed.symbol == "BTC_USDT_Perp");
+    CHECK(parsed.exchange_time == 1700000000000ULL);
+    REQUIRE(parsed.bids.size() == 1);
+    CHECK(parsed.bids[0].price == 2533.5);
+    CHECK(parsed.bids[0].qty == 10.5);
+
+    // Lite field names, object levels and sequence numbers
+    REQUIRE(parser->parse(R"({"m":"orderbook.d","p":["orderbook.d","ETH_USDT_Perp",)"
+                          R"({"t":"1700000000000000000","sn":"42","psn":"41","b":[{"p":"100.5","s":"0"}],"a":[]}]})", parsed));
+    CHECK(parsed.type == MdMessageType::BOOK_DELTA);
+    CHECK(parsed.exchange_time == 1700000000000000000ULL);
+    CHECK(parsed.first_id == 42);
+    CHECK(parsed.last_id == 42);
+    CHECK(parsed.prev_id == 41);
+    REQUIRE(parsed.bids.size() == 1);
+    CHECK(parsed.bids[0].price == 100.5);
+    CHECK(parsed.bids[0].qty == 0.0);
+
+    REQUIRE(parser->parse(R"({"method":"trades","params":["trades","BTC_USDT_Perp",)"
+                          R"({"price":"2533.75","quantity":"2.5","side":"SELL","tradeId":"T1","timestamp":1700000000001}]})", parsed));
+    CHECK(parsed.type == MdMessageType::TRADE);
+    REQUIRE(parsed.trades.size() == 1);
+    CHECK(parsed.trades[0].price == 2533.75);
+    CHECK(parsed.trades[0].qty == 2.5);
+    CHECK(parsed.trades[0].is_buyer_maker);
+    CHECK(parsed.trades[0].trade_id == "T1");
+    CHECK(parsed.trades[0].exchange_time == 1700000000001ULL);
+
+    REQUIRE(parser->parse(R"({"jsonrpc":"2.0","id":3,"error":{"code":1001,"message":"bad"}})", parsed));
+    CHECK(parsed.type == MdMessageType::CONTROL);
+    CHECK(parsed.is_error);
+}
+
+TEST_CASE("MarketDataParser - Deribit Book And Trades") {
+    auto parser = create_market_data_parser("deribit");
+    REQUIRE(parser != nullptr);
+    ParsedMarketData parsed;
+
+    REQUIRE(parser->parse(R"({"jsonrpc":"2.0","method":"subscription","params":{"channel":"book.BTC-PERPETUAL.raw",)"
+                          R"("data":{"timestamp":1640995200000,"change_id":7,"bids":[[50000.0,0.1]],"asks":[[50001.0,0.2]]}}})", parsed));
+    CHECK(parsed.type == MdMessageType::BOOK_SNAPSHOT);
+    CHECK(parsed.symbol == "BTC-PERPETUAL");
+    CHECK(parsed.last_id == 7);
+    REQUIRE(parsed.bids.size() == 1);
+    CHECK(parsed.bids[0].price == 50000.0);
+
+    // Incremental book: action triplets, "delete" clears the level
+    REQUIRE(parser->parse(R"({"method":"subscription","params":{"channel":"book.ETH-PERPETUAL.100ms",)"
+                          R"("data":{"change_id":9,"prev_change_id":8,"bids":[["delete",3000.0,0.0],["new",2999.5,4.0]],)"
+                          R"("asks":[["change",3001.0,1.0]]}}})", parsed));
+    CHECK(parsed.type == MdMessageType::BOOK_DELTA);
+    CHECK(parsed.symbol == "ETH-PERPETUAL");
+    CHECK(parsed.first_id == 9);
+    CHECK(parsed.prev_id == 8);
+    REQUIRE(parsed.bids.size() == 2);
+    CHECK(parsed.bids[0].qty == 0.0);
+    CHECK(parsed.bids[1].qty == 4.0);
+
+    REQUIRE(parser->parse(R"({"method":"subscription","params":{"channel":"trades.BTC-PERPETUAL.raw","data":[)"
+                          R"({"trade_seq":11,"price":50000.5,"amount":0.1,"direction":"buy","timestamp":1640995200001},)"
+                          R"({"trade_id":"T2","price":50000.0,"amount":0.3,"direction":"sell","timestamp":1640995200002}]}})", parsed));
+    CHECK(parsed.type == MdMessageType::TRADE);
+    REQUIRE(parsed.trades.size() == 2);
+    CHECK(parsed.trades[0].trade_id.empty());
+    CHECK(parsed.trades[0].trade_seq == 11);
+    CHECK_FALSE(parsed.trades[0].is_buyer_maker);
+    CHECK(parsed.trades[1].trade_id == "T2");
+    CHECK(parsed.trades[1].is_buyer_maker);
+
+    CHECK(create_market_data_parser("unknown") == nullptr);
+}
@@ -0,0 +1,149 @@
+#include "doctest.h"
+#include "../../../utils/metrics/metrics_exporter.hpp"
+#include "../../../utils/metrics/latency_trace.hpp"
+#include "../../../proto/market_data.pb.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Metrics - Log-Linear Histogram Buckets And Percentiles") {
+    using metrics::Histogram;
+
+    // Exact below 32, then within 1/32 of the value
+    CHECK(Histogram::bucket_index(31) == 31);
+    CHECK(Histogram::bucket_upper_bound(Histogram::bucket_index(31)) == 31);
+    for (uint64_t value : {32ULL, 1000ULL, 123456789ULL, 1ULL << 40, ~0ULL}) {
+        size_t index = Histogram::bucket_index(value);
+        REQUIRE(index < Histogram::kBucketCount);
+        uint64_t upper = Histogram::bucket_upper_bound(index);
+        CHECK(upper >= value);
+        CHECK(static_cast<double>(upper - value) <= static_cast<double>(value) / 32.0);
+    }
+
+    Histogram histogram("test.latency_ns");
+    for (uint64_t v = 1; v <= 10000; ++v) {
+        histogram.record(v);
+    }
+    metrics::HistogramSnapshot snap = histogram.snapshot();
+    CHECK(snap.count == 10000);
+    CHECK(snap.sum == 10000ULL * 10001ULL / 2);
+    CHECK(snap.max == 10000);
+    CHECK(snap.p50 >= 5000);
+    CHECK(snap.p50 <= 5000 + 5000 / 32);
+    CHECK(snap.p99 >= 9900);
+    CHECK(snap.p99 <= 9900 + 9900 / 32);
+    CHECK(snap.p999 <= snap.max);
+
+    histogram.reset();
+    CHECK(histogram.snapshot().count == 0);
+}
+
+TEST_CASE("Metrics - Concurrent Recording And Atomic Gauges") {
+    metrics::Histogram histogram("test.concurrent");
+    metrics::Gauge gauge("test.gauge");
+
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 20000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&histogram, &gauge, t]() {
+            for (int i = 0; i < kPerThread; ++i) {
+                histogram.record(static_cast<uint64_t>(t * 1000 + i % 1000));
+                gauge.increment(0.5);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    CHECK(histogram.get_count() == kThreads * kPerThread);
+    CHECK(histogram.snapshot().count == kThreads * kPerThread);
+    CHECK(histogram.snapshot().max == (kThreads - 1) * 1000 + 999);
+    CHECK(gauge.get() == doctest::Approx(kThreads * kPerThread * 0.5));
+}
+
+TEST_CASE("Metrics - Prometheus And Binary Export") {
+    auto& collector = metrics::MetricsCollector::instance();
+    collector.counter("test_export.orders").increment(3);
+    collector.gauge("test_export.position").set(-1.5);
+    auto& timer = collector.timer("test_export.tick_to_trade_us");
+    timer.record_ns(2000);
+    timer.record_ns(4000);
+
+    std::vector<metrics::MetricSample> samples = collector.collect();
+    std::string text = metrics::MetricsExporter::to_prometheus(samples);
+    CHECK(text.find("# TYPE test_export_orders counter\ntest_export_orders 3\n") != std::string::npos);
+    CHECK(text.find("test_export_position -1.5\n") != std::string::npos);
+    CHECK(text.find("# TYPE test_export_tick_to_trade_us summary\n") != std::string::npos);
+    // 2000ns falls in a 32ns-wide bucket, reported by its upper bound
+    CHECK(text.find("test_export_tick_to_trade_us{quantile=\"0.5\"} 2.015\n") != std::string::npos);
+    CHECK(text.find("test_export_tick_to_trade_us_count 2\n") != std::string::npos);
+    CHECK(text.find("test_export_tick_to_trade_us_max 4\n") != std::string::npos);
+
+    std::string payload;
+    metrics::MetricsExporter::encode_binary(samples, 42, payload);
+    std::vector<metrics::MetricSample> decoded;
+    uint64_t timestamp = 0;
+    REQUIRE(metrics::MetricsExporter::decode_binary(payload.data(), payload.size(), decoded, &timestamp));
+    CHECK(timestamp == 42);
+    REQUIRE(decoded.size() == samples.size());
+    for (size_t i = 0; i < samples.size(); ++i) {
+        CHECK(decoded[i].name == samples[i].name);
+        CHECK(decoded[i].type == samples[i].type);
+        CHECK(decoded[i].value == samples[i].value);
+        CHECK(decoded[i].histogram.p99 == samples[i].histogram.p99);
+    }
+    CHECK_FALSE(metrics::MetricsExporter::decode_binary(payload.data(), payload.size() - 1, decoded));
+
+    // Periodic file sink
+    const std::string path = "/tmp/metrics_exporter_test.prom";
+    std::remove(path.c_str());
+    metrics::MetricsExporter exporter(collector);
+    metrics::MetricsExporterConfig config;
+    config.prometheus_file = path;
+    config.interval_ms = 10;
+    REQUIRE(exporter.start(config));
+    while (exporter.get_export_count() < 2) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    exporter.stop();
+    CHECK(exporter.get_export_failures() == 0);
+
+    std::ifstream in(path);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    CHECK(ss.str().find("test_export_orders 3\n") != std::string::npos);
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Metrics - Latency Trace Stamps And Hops") {
+    using metrics::LatencyTrace;
+
+    proto::OrderBookSnapshot book;
+    LatencyTrace::stamp_market_data(book, 0, 0);
+    CHECK_FALSE(book.has_trace());   // Not stamped when tracing was off at receive
+
+    LatencyTrace::stamp_market_data(book, 1000, 1500);
+    REQUIRE(book.has_trace());
+    CHECK(book.trace().md_recv_ns() == 1000);
+    CHECK(book.trace().md_parsed_ns() == 1500);
+    CHECK(book.trace().md_publish_ns() >= 1500);
+
+    // Orders built inside the scope can see the triggering snapshot's trace
+    CHECK(LatencyTrace::current() == nullptr);
+    {
+        LatencyTrace::Scope scope(&book.trace());
+        CHECK(LatencyTrace::current() == &book.trace());
+    }
+    CHECK(LatencyTrace::current() == nullptr);
+
+    metrics::Histogram& hop = LatencyTrace::histogram(LatencyTrace::TICK_TO_TRADE);
+    CHECK(&hop == &metrics::MetricsCollector::instance().histogram("trace.tick_to_trade_ns"));
+    size_t before = hop.get_count();
+    LatencyTrace::record(LatencyTrace::TICK_TO_TRADE, 1000, 26000);
+    LatencyTrace::record(LatencyTrace::TICK_TO_TRADE, 0, 26000);      // Stage not stamped
+    LatencyTrace::record(LatencyTrace::TICK_TO_TRADE, 26000, 1000);   // Out of order
+    CHECK(hop.get_count() == before + 1);
+}
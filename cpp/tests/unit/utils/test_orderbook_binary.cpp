@@ -0,0 +1,121 @@
+#include "doctest.h"
+#include "../../../utils/mds/orderbook_binary.hpp"
+#include "../../../proto/market_data.pb.h"
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+struct alignas(md_binary::kCacheLineSize) AlignedBookBuffer {
+    unsigned char data[md_binary::DefaultBookCodec::kSize + md_binary::kCacheLineSize];
+};
+
+proto::OrderBookSnapshot make_book_snapshot(int bid_levels, int ask_levels) {
+    proto::OrderBookSnapshot snapshot;
+    snapshot.set_exch("BINANCE");
+    snapshot.set_symbol("BTCUSDT");
+    snapshot.set_timestamp_us(1700000000000000ULL);
+    for (int i = 0; i < bid_levels; ++i) {
+        auto* level = snapshot.add_bids();
+        level->set_price(50000.0 - i);
+        level->set_qty(1.0 + i);
+    }
+    for (int i = 0; i < ask_levels; ++i) {
+        auto* level = snapshot.add_asks();
+        level->set_price(50001.0 + i);
+        level->set_qty(0.5 + i);
+    }
+    return snapshot;
+}
+
+} // namespace
+
+TEST_CASE("OrderBookBinary - Encode, View And Decode Round Trip") {
+    using Codec = md_binary::DefaultBookCodec;
+    auto buffer = std::make_unique<AlignedBookBuffer>();
+    proto::OrderBookSnapshot snapshot = make_book_snapshot(3, 25);
+    snapshot.mutable_trace()->set_md_recv_ns(100);
+    snapshot.mutable_trace()->set_md_parsed_ns(200);
+    snapshot.mutable_trace()->set_md_publish_ns(300);
+
+    size_t size = Codec::encode(snapshot, 42, 7, buffer->data, sizeof(buffer->data));
+    REQUIRE(size == Codec::kSize);
+
+    const md_binary::DefaultBookMessage* message = Codec::view(buffer->data, size);
+    REQUIRE(message != nullptr);
+    CHECK(message->instrument_id == 42);
+    CHECK(message->sequence == 7);
+    CHECK(message->bid_count == 3);
+    CHECK(message->ask_count == md_binary::kDefaultBookDepth);   // Truncated to the layout depth
+    CHECK(message->bids[0].price == 50000.0);
+    CHECK(message->asks[1].qty == 1.5);
+    CHECK(message->bids[3].price == 0.0);                         // Unused levels are zeroed
+
+    // Decoding into a snapshot that already holds a deeper book trims it
+    proto::OrderBookSnapshot decoded = make_book_snapshot(10, 30);
+    Codec::decode(*message, "BINANCE", "BTCUSDT", decoded);
+    CHECK(decoded.symbol() == "BTCUSDT");
+    CHECK(decoded.timestamp_us() == snapshot.timestamp_us());
+    REQUIRE(decoded.bids_size() == 3);
+    REQUIRE(decoded.asks_size() == static_cast<int>(md_binary::kDefaultBookDepth));
+    CHECK(decoded.bids(2).price() == 49998.0);
+    CHECK(decoded.asks(19).qty() == 19.5);
+    CHECK(decoded.trace().md_publish_ns() == 300);
+
+    // Untraced books clear a trace left over from the previous tick
+    snapshot.clear_trace();
+    REQUIRE(Codec::encode(snapshot, 42, 8, buffer->data, sizeof(buffer->data)) == Codec::kSize);
+    Codec::decode(*Codec::view(buffer->data, Codec::kSize), "BINANCE", "BTCUSDT", decoded);
+    CHECK_FALSE(decoded.has_trace());
+}
+
+TEST_CASE("OrderBookBinary - View Rejects Foreign Payloads") {
+    using Codec = md_binary::DefaultBookCodec;
+    auto buffer = std::make_unique<AlignedBookBuffer>();
+    proto::OrderBookSnapshot snapshot = make_book_snapshot(5, 5);
+
+    // Encode refuses small or misaligned buffers
+    CHECK(Codec::encode(snapshot, 1, 1, buffer->data, Codec::kSize - 1) == 0);
+    CHECK(Codec::encode(snapshot, 1, 1, buffer->data + 8, Codec::kSize) == 0);
+
+    REQUIRE(Codec::encode(snapshot, 1, 1, buffer->data, sizeof(buffer->data)) == Codec::kSize);
+    CHECK(Codec::view(buffer->data, Codec::kSize - 1) == nullptr);
+    CHECK(Codec::view(buffer->data, Codec::kSize) != nullptr);
+
+    auto* message = reinterpret_cast<md_binary::DefaultBookMessage*>(buffer->data);
+    message->version = md_binary::kBookVersion + 1;
+    CHECK(Codec::view(buffer->data, Codec::kSize) == nullptr);
+    message->version = md_binary::kBookVersion;
+    message->bid_count = md_binary::kDefaultBookDepth + 1;
+    CHECK(Codec::view(buffer->data, Codec::kSize) == nullptr);
+
+    // A protobuf snapshot never starts with the binary magic
+    std::string serialized = snapshot.SerializeAsString();
+    REQUIRE(serialized.size() <= sizeof(buffer->data));
+    std::memcpy(buffer->data, serialized.data(), serialized.size());
+    CHECK(Codec::view(buffer->data, serialized.size()) == nullptr);
+    CHECK(static_cast<unsigned char>(serialized[0]) != 0);
+}
+
+TEST_CASE("OrderBookBinary - Instrument Registry") {
+    auto& registry = md_binary::InstrumentRegistry::instance();
+
+    uint32_t id = registry.intern("binance", "ORDERBOOK_BINARY_TEST");
+    CHECK(id == md_binary::InstrumentRegistry::make_id("BINANCE", "ORDERBOOK_BINARY_TEST"));
+    CHECK(registry.intern("BINANCE", "ORDERBOOK_BINARY_TEST") == id);   // Exchange case does not matter
+    CHECK(id != md_binary::InstrumentRegistry::make_id("BINANCE", "orderbook_binary_test"));
+
+    const auto* instrument = registry.find(id);
+    REQUIRE(instrument != nullptr);
+    CHECK(instrument->exchange == "binance");
+    CHECK(instrument->symbol == "ORDERBOOK_BINARY_TEST");
+    CHECK(registry.find(id + 1) != instrument);
+
+    // "TEST:SYM32898" and "TEST:SYM518282" hash to the same 32-bit id
+    REQUIRE(md_binary::InstrumentRegistry::make_id("TEST", "SYM32898") ==
+            md_binary::InstrumentRegistry::make_id("TEST", "SYM518282"));
+    registry.intern("TEST", "SYM32898");
+    CHECK_THROWS_AS(registry.intern("TEST", "SYM518282"), std::runtime_error);
+}
@@ -0,0 +1,248 @@
+#include "doctest.h"
+#include "../../../utils/shm/shm_md_bus.hpp"
+#include "../../../proto/market_data.pb.h"
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace {
+
+// Unlinks the segment so repeated test runs start clean
+struct ShmBusName {
+    std::string name = "/mm_test_bus_" + std::to_string(::getpid());
+    ShmBusName() { shm_unlink(name.c_str()); }
+    ~ShmBusName() { shm_unlink(name.c_str()); }
+};
+
+proto::OrderBookSnapshot make_shm_book(double best_bid) {
+    proto::OrderBookSnapshot snapshot;
+    snapshot.set_timestamp_us(1700000000000000ULL);
+    auto* bid = snapshot.add_bids();
+    bid->set_price(best_bid);
+    bid->set_qty(1.0);
+    auto* ask = snapshot.add_asks();
+    ask->set_price(best_bid + 1.0);
+    ask->set_qty(2.0);
+    return snapshot;
+}
+
+proto::Trade make_shm_trade(double price, const std::string& trade_id) {
+    proto::Trade trade;
+    trade.set_timestamp_us(1700000000000001ULL);
+    trade.set_price(price);
+    trade.set_qty(0.1);
+    trade.set_is_buyer_maker(true);
+    trade.set_trade_id(trade_id);
+    return trade;
+}
+
+} // namespace
+
+TEST_CASE("ShmMdBus - Latest Book Per Instrument") {
+    ShmBusName bus;
+    CHECK_THROWS_AS(shm_md::ShmMdSubscriber(bus.name), std::runtime_error);
+
+    shm_md::ShmMdPublisher publisher(bus.name, 8, 16);
+    shm_md::ShmMdSubscriber subscriber(bus.name);
+    auto book = std::make_unique<shm_md::BookMessage>();
+    uint64_t version = 0;
+
+    CHECK_FALSE(subscriber.read_book(11, *book, version));   // Nothing published yet
+
+    REQUIRE(publisher.publish_book(make_shm_book(100.0), 11, 1));
+    REQUIRE(publisher.publish_book(make_shm_book(200.0), 19, 1));   // Same start slot as 11 (mask 7)
+    REQUIRE(publisher.publish_book(make_shm_book(101.0), 11, 2));
+
+    // Only the newest book is visible; reading again without an update yields nothing
+    REQUIRE(subscriber.read_book(11, *book, version));
+    CHECK(book->sequence == 2);
+    CHECK(book->bids[0].price == 101.0);
+    CHECK_FALSE(subscriber.read_book(11, *book, version));
+
+    uint64_t other_version = 0;
+    REQUIRE(subscriber.read_book(19, *book, other_version));
+    CHECK(book->instrument_id == 19);
+    CHECK(book->asks[0].price == 201.0);
+
+    publisher.publish_book(make_shm_book(102.0), 11, 3);
+    REQUIRE(subscriber.read_book(11, *book, version));
+    CHECK(book->bids[0].price == 102.0);
+
+    // A full slot table drops books for new instruments
+    for (uint32_t id = 100; id < 106; ++id) {
+        CHECK(publisher.publish_book(make_shm_book(1.0), id, 1));
+    }
+    CHECK_FALSE(publisher.publish_book(make_shm_book(1.0), 200, 1));
+    CHECK(publisher.get_books_dropped() == 1);
+}
+
+TEST_CASE("ShmMdBus - Trade Ring Broadcast And Overrun") {
+    ShmBusName bus;
+    shm_md::ShmMdPublisher publisher(bus.name, 8, 8);
+    shm_md::ShmMdSubscriber first(bus.name);
+    shm_md::ShmMdSubscriber second(bus.name);
+    shm_md::TradeRecord record;
+
+    publisher.publish_trade(make_shm_trade(10.0, "t1"), 5);
+    publisher.publish_trade(make_shm_trade(11.0, "a-trade-id-longer-than-24-bytes"), 6);
+
+    // Every reader sees every trade
+    for (shm_md::ShmMdSubscriber* reader : {&first, &second}) {
+        REQUIRE(reader->next_trade(record));
+        CHECK(record.instrument_id == 5);
+        CHECK(record.price == 10.0);
+        CHECK(record.is_buyer_maker == 1);
+        CHECK(std::string(record.trade_id, record.trade_id_size) == "t1");
+        REQUIRE(reader->next_trade(record));
+        CHECK(record.trade_id_size == sizeof(record.trade_id));
+        CHECK_FALSE(reader->next_trade(record));
+    }
+
+    // Twenty more trades lap an 8-slot ring: the reader skips ahead and counts the loss
+    for (int i = 0; i < 20; ++i) {
+        publisher.publish_trade(make_shm_trade(100.0 + i, "x"), 5);
+    }
+    int received = 0;
+    double last_price = 0.0;
+    while (first.next_trade(record)) {
+        CHECK(record.price > last_price);
+        last_price = record.price;
+        ++received;
+    }
+    CHECK(last_price == 119.0);
+    CHECK(first.get_trades_overrun() + received == 20);
+    CHECK(first.get_trades_overrun() > 0);
+}
+
+TEST_CASE("ShmMdBus - Reopen And Wake") {
+    ShmBusName bus;
+    auto publisher = std::make_unique<shm_md::ShmMdPublisher>(bus.name, 8, 8);
+    publisher->publish_book(make_shm_book(100.0), 3, 1);
+
+    shm_md::ShmMdSubscriber subscriber(bus.name);
+    auto book = std::make_unique<shm_md::BookMessage>();
+    uint64_t version = 0;
+    REQUIRE(subscriber.read_book(3, *book, version));
+
+    // A restarted publisher keeps the segment, so the mapped reader carries on
+    publisher = std::make_unique<shm_md::ShmMdPublisher>(bus.name, 8, 8);
+    publisher->publish_book(make_shm_book(101.0), 3, 2);
+    REQUIRE(subscriber.read_book(3, *book, version));
+    CHECK(book->bids[0].price == 101.0);
+
+    uint32_t epoch = subscriber.current_epoch();
+    CHECK_FALSE(subscriber.wait(epoch, WaitStrategy::FUTEX, std::chrono::milliseconds(1)));
+
+    std::thread writer([&publisher]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        publisher->publish_book(make_shm_book(102.0), 3, 3);
+    });
+    CHECK(subscriber.wait(epoch, WaitStrategy::FUTEX, std::chrono::seconds(5)));
+    writer.join();
+    REQUIRE(subscriber.read_book(3, *book, version));
+    CHECK(book->bids[0].price == 102.0);
+}
+
+TEST_CASE("ShmMdBus - Reopen Recovers A Slot Left Mid-Write") {
+    ShmBusName bus;
+    auto publisher = std::make_unique<shm_md::ShmMdPublisher>(bus.name, 8, 8);
+    publisher->publish_book(make_shm_book(100.0), 3, 1);
+
+    // Simulate a writer killed between its two sequence stores: slot 3 stays odd
+    const size_t size = shm_md::segment_size(8, 8);
+    int fd = shm_open(bus.name.c_str(), O_RDWR, 0);
+    REQUIRE(fd >= 0);
+    void* base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    REQUIRE(base != MAP_FAILED);
+    const size_t books_offset = (sizeof(shm_md::BusHeader) + md_binary::kCacheLineSize - 1) &
+                                ~(md_binary::kCacheLineSize - 1);
+    auto* slot = reinterpret_cast<shm_md::BookSlot*>(static_cast<char*>(base) + books_offset) + 3;
+    slot->sequence.fetch_add(1);
+    publisher.reset();
+
+    shm_md::ShmMdSubscriber subscriber(bus.name);
+    auto book = std::make_unique<shm_md::BookMessage>();
+    uint64_t version = 0;
+
+    // The restarted publisher evens the slot out; the torn book does not decode
+    publisher = std::make_unique<shm_md::ShmMdPublisher>(bus.name, 8, 8);
+    CHECK(slot->sequence.load() % 2 == 0);
+    REQUIRE(subscriber.read_book(3, *book, version));
+    CHECK(book->magic != md_binary::kBookMagic);
+
+    publisher->publish_book(make_shm_book(101.0), 3, 2);
+    REQUIRE(subscriber.read_book(3, *book, version));
+    CHECK(version % 2 == 0);
+    CHECK(book->magic == md_binary::kBookMagic);
+    CHECK(book->bids[0].price == 101.0);
+    munmap(base, size);
+}
+
+TEST_CASE("ShmMdBus - Reopen Skips A Trade Left Mid-Write") {
+    ShmBusName bus;
+    auto publisher = std::make_unique<shm_md::ShmMdPublisher>(bus.name, 8, 8);
+    shm_md::ShmMdSubscriber subscriber(bus.name);
+    publisher->publish_trade(make_shm_trade(10.0, "t1"), 5);
+
+    // Simulate a writer killed after claiming index 1: its slot's sequence stays odd
+    const size_t size = shm_md::segment_size(8, 8);
+    int fd = shm_open(bus.name.c_str(), O_RDWR, 0);
+    REQUIRE(fd >= 0);
+    void* base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    REQUIRE(base != MAP_FAILED);
+    auto* header = static_cast<shm_md::BusHeader*>(base);
+    const size_t trades_offset = size - 8 * sizeof(shm_md::TradeSlot);
+    auto* trades = reinterpret_cast<shm_md::TradeSlot*>(static_cast<char*>(base) + trades_offset);
+    const uint64_t torn = header->trade_cursor.fetch_add(1);
+    trades[torn & 7].sequence.store(2 * torn + 1);
+    publisher.reset();
+
+    // The restarted publisher completes the torn record as one readers skip
+    publisher = std::make_unique<shm_md::ShmMdPublisher>(bus.name, 8, 8);
+    CHECK(trades[torn & 7].sequence.load() == 2 * torn + 2);
+    publisher->publish_trade(make_shm_trade(12.0, "t3"), 5);
+
+    shm_md::TradeRecord record;
+    REQUIRE(subscriber.next_trade(record));
+    CHECK(record.price == 10.0);
+    REQUIRE(subscriber.next_trade(record));
+    CHECK(record.price == 12.0);
+    CHECK(record.flags == 0);
+    CHECK_FALSE(subscriber.next_trade(record));
+    CHECK(subscriber.get_trades_overrun() == 1);
+    munmap(base, size);
+}
+
+TEST_CASE("ShmMdBus - Different Layout Gets A Fresh Segment") {
+    ShmBusName bus;
+    auto publisher = std::make_unique<shm_md::ShmMdPublisher>(bus.name, 8, 8);
+    publisher->publish_book(make_shm_book(100.0), 3, 1);
+
+    shm_md::ShmMdSubscriber old_reader(bus.name);
+    CHECK_FALSE(old_reader.is_replaced());
+    publisher.reset();
+
+    // Another layout: the old segment is left as it is for readers still mapping it
+    publisher = std::make_unique<shm_md::ShmMdPublisher>(bus.name, 16, 8);
+    publisher->publish_book(make_shm_book(101.0), 3, 2);
+
+    auto book = std::make_unique<shm_md::BookMessage>();
+    uint64_t old_version = 0;
+    REQUIRE(old_reader.read_book(3, *book, old_version));
+    CHECK(book->bids[0].price == 100.0);
+    CHECK(old_reader.is_replaced());
+
+    // Reopening follows the name to the new segment
+    shm_md::ShmMdSubscriber new_reader(bus.name);
+    CHECK_FALSE(new_reader.is_replaced());
+    uint64_t new_version = 0;
+    REQUIRE(new_reader.read_book(3, *book, new_version));
+    CHECK(book->bids[0].price == 101.0);
+}
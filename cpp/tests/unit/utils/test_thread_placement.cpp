@@ -0,0 +1,54 @@
+#include "doctest.h"
+#include "../../../utils/app_service/thread_placement.hpp"
+#include "../../../utils/config/process_config_manager.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
+TEST_CASE("ThreadPlacement - Parses Core Lists") {
+    using app_service::ThreadPlacement;
+    CHECK(ThreadPlacement::parse_cpu_list("3") == std::vector<int>{3});
+    CHECK(ThreadPlacement::parse_cpu_list(" 2, 4-6 ") == std::vector<int>{2, 4, 5, 6});
+    CHECK(ThreadPlacement::parse_cpu_list("5,1,5") == std::vector<int>{1, 5});
+    CHECK(ThreadPlacement::parse_cpu_list("-1").empty());
+    CHECK(ThreadPlacement::parse_cpu_list("").empty());
+    CHECK(ThreadPlacement::parse_cpu_list("x,7") == std::vector<int>{7});
+}
+
+TEST_CASE("ThreadPlacement - Config Overrides Defaults And Records Threads") {
+    std::ofstream config_file("test_thread_placement.ini");
+    config_file << "[THREADS]\n";
+    config_file << "MD_BINANCE_CPU=0\n";
+    config_file << "STRATEGY_CPU=-1\n";
+    config_file << "STRATEGY_PRIORITY=0\n";
+    config_file << "ZMQ_REACTOR_PRIORITY=40\n";
+    config_file.close();
+
+    config::ProcessConfigManager manager;
+    REQUIRE(manager.load_config("test_thread_placement.ini"));
+    auto& placement = app_service::ThreadPlacement::instance();
+    placement.configure(manager);
+
+    // Keyed by upper-cased name; configured values win over the caller's defaults
+    CHECK(placement.placement_for("md_binance").cpus == std::vector<int>{0});
+    CHECK(placement.placement_for("strategy", 3, 50).cpus.empty());
+    CHECK(placement.placement_for("strategy", 3, 50).priority == 0);
+    CHECK(placement.placement_for("zmq_reactor").priority == 40);
+    CHECK(placement.placement_for("md_deribit", 2).cpus == std::vector<int>{2});
+
+    std::thread worker([&placement]() { placement.place_current_thread("placement_test"); });
+    worker.join();
+    auto records = placement.records();
+    auto record = std::find_if(records.begin(), records.end(),
+                               [](const auto& r) { return r.name == "placement_test"; });
+    REQUIRE(record != records.end());
+    CHECK(record->tid > 0);
+    CHECK_FALSE(record->pinned);
+    CHECK_FALSE(record->realtime);
+
+    // Leave the process-wide settings empty for later tests
+    config::ProcessConfigManager empty;
+    placement.configure(empty);
+    std::remove("test_thread_placement.ini");
+}
@@ -0,0 +1,151 @@
+#include "doctest.h"
+#include "../../../utils/websocket/websocket_frame_codec.hpp"
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct DecodedFrame {
+    uint8_t opcode;
+    std::string payload;
+};
+
+std::string server_frame(uint8_t opcode, const std::string& payload, bool fin = true) {
+    std::string frame;
+    websocket_codec::encode_frame(frame, opcode, payload.data(), payload.size(), nullptr, fin);
+    return frame;
+}
+
+} // namespace
+
+TEST_CASE("WebSocketFrameCodec - Masking Matches Scalar Reference") {
+    const uint8_t key[4] = {0x37, 0xFA, 0x21, 0x3D};
+    std::vector<uint8_t> input(301);
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = static_cast<uint8_t>(i * 7 + 3);
+    }
+
+    // Every length and starting offset exercises the vector, word and tail loops
+    for (size_t length : {0, 1, 3, 4, 7, 8, 15, 16, 17, 31, 32, 33, 63, 64, 100, 301}) {
+        for (size_t offset = 0; offset < 4; ++offset) {
+            std::vector<uint8_t> out(length);
+            websocket_codec::mask_copy(out.data(), input.data(), length, key, offset);
+            bool matches = true;
+            for (size_t i = 0; i < length; ++i) {
+                matches = matches && out[i] == (input[i] ^ key[(offset + i) % 4]);
+            }
+            CHECK_MESSAGE(matches, "length " << length << " offset " << offset);
+
+            websocket_codec::mask_payload(out.data(), length, key, offset);
+            CHECK(std::equal(out.begin(), out.end(), input.begin()));
+        }
+    }
+
+    // Masking in pieces equals masking in one pass
+    std::vector<uint8_t> whole(input), pieces(input);
+    websocket_codec::mask_payload(whole.data(), whole.size(), key);
+    websocket_codec::mask_payload(pieces.data(), 45, key, 0);
+    websocket_codec::mask_payload(pieces.data() + 45, pieces.size() - 45, key, 45);
+    CHECK(whole == pieces);
+}
+
+TEST_CASE("WebSocketFrameCodec - Header Encoding") {
+    uint8_t header[websocket_codec::kMaxHeaderSize];
+    const uint8_t key[4] = {1, 2, 3, 4};
+
+    CHECK(websocket_codec::encode_header(header, WebSocketFrame::OPCODE_TEXT, true, 125, nullptr) == 2);
+    CHECK(header[0] == 0x81);
+    CHECK(header[1] == 125);
+
+    CHECK(websocket_codec::encode_header(header, WebSocketFrame::OPCODE_BINARY, true, 126, key) == 8);
+    CHECK(header[0] == 0x82);
+    CHECK(header[1] == (0x80 | 126));
+    CHECK(header[2] == 0x00);
+    CHECK(header[3] == 126);
+    CHECK(header[4] == 1);
+    CHECK(header[7] == 4);
+
+    CHECK(websocket_codec::encode_header(header, WebSocketFrame::OPCODE_TEXT, false, 70000, key) == 14);
+    CHECK(header[0] == 0x01);
+    CHECK(header[1] == (0x80 | 127));
+    CHECK(header[7] == 0x01);
+    CHECK(header[8] == 0x11);
+    CHECK(header[9] == 0x70);
+
+    // Masked client frame round-trips through the decoder, which unmasks in place
+    websocket_codec::WebSocketMaskKeyGenerator keys;
+    uint8_t mask_key[4];
+    keys.next(mask_key);
+    std::string payload(300, 'x');
+    payload[0] = '{';
+    std::string frame;
+    websocket_codec::encode_frame(frame, WebSocketFrame::OPCODE_TEXT, payload.data(), payload.size(), mask_key);
+    CHECK(frame.size() == 4 + 4 + payload.size());
+
+    std::vector<DecodedFrame> frames;
+    websocket_codec::WebSocketFrameDecoder decoder;
+    decoder.set_frame_callback([&frames](uint8_t opcode, std::string_view data) {
+        frames.push_back({opcode, std::string(data)});
+    });
+    CHECK(decoder.feed(frame.data(), frame.size()) == websocket_codec::WebSocketFrameDecoder::Status::OK);
+    REQUIRE(frames.size() == 1);
+    CHECK(frames[0].payload == payload);
+}
+
+TEST_CASE("WebSocketFrameCodec - Incremental And Fragmented Decoding") {
+    using Status = websocket_codec::WebSocketFrameDecoder::Status;
+    std::vector<DecodedFrame> frames;
+    websocket_codec::WebSocketFrameDecoder decoder(64, 1024);
+    decoder.set_frame_callback([&frames](uint8_t opcode, std::string_view data) {
+        frames.push_back({opcode, std::string(data)});
+    });
+
+    // A stream of frames delivered one byte at a time, through prepare/commit
+    std::string stream = server_frame(WebSocketFrame::OPCODE_TEXT, "{\"e\":\"trade\"}") +
+                         server_frame(WebSocketFrame::OPCODE_BINARY, std::string(200, 'b')) +
+                         server_frame(WebSocketFrame::OPCODE_TEXT, "part1-", false) +
+                         server_frame(WebSocketFrame::OPCODE_PING, "hb") +
+                         server_frame(WebSocketFrame::OPCODE_CONTINUATION, "part2-", false) +
+                         server_frame(WebSocketFrame::OPCODE_CONTINUATION, "part3", true);
+    for (char c : stream) {
+        auto space = decoder.prepare(1);
+        space.first[0] = c;
+        decoder.commit(1);
+        REQUIRE(decoder.process() == Status::OK);
+    }
+
+    REQUIRE(frames.size() == 4);
+    CHECK(frames[0].opcode == WebSocketFrame::OPCODE_TEXT);
+    CHECK(frames[0].payload == "{\"e\":\"trade\"}");
+    CHECK(frames[1].opcode == WebSocketFrame::OPCODE_BINARY);
+    CHECK(frames[1].payload == std::string(200, 'b'));
+    CHECK(frames[2].opcode == WebSocketFrame::OPCODE_PING);   // Control frame between fragments
+    CHECK(frames[2].payload == "hb");
+    CHECK(frames[3].opcode == WebSocketFrame::OPCODE_TEXT);
+    CHECK(frames[3].payload == "part1-part2-part3");
+    CHECK(decoder.buffered().empty());
+
+    // Leading non-frame bytes (the HTTP upgrade response) can be consumed first
+    frames.clear();
+    std::string upgrade = "HTTP/1.1 101 Switching Protocols\r\n\r\n";
+    std::string with_upgrade = upgrade + server_frame(WebSocketFrame::OPCODE_TEXT, "hello");
+    auto space = decoder.prepare(with_upgrade.size());
+    std::copy(with_upgrade.begin(), with_upgrade.end(), space.first);
+    decoder.commit(with_upgrade.size());
+    CHECK(decoder.buffered().substr(0, 12) == "HTTP/1.1 101");
+    decoder.consume(upgrade.size());
+    CHECK(decoder.process() == Status::OK);
+    REQUIRE(frames.size() == 1);
+    CHECK(frames[0].payload == "hello");
+
+    // Protocol violations and size limit
+    std::string orphan = server_frame(WebSocketFrame::OPCODE_CONTINUATION, "x");
+    CHECK(decoder.feed(orphan.data(), orphan.size()) == Status::PROTOCOL_ERROR);
+    decoder.reset();
+    std::string fragmented_ping = server_frame(WebSocketFrame::OPCODE_PING, "x", false);
+    CHECK(decoder.feed(fragmented_ping.data(), fragmented_ping.size()) == Status::PROTOCOL_ERROR);
+    decoder.reset();
+    std::string too_big = server_frame(WebSocketFrame::OPCODE_BINARY, std::string(2000, 'z'));
+    CHECK(decoder.feed(too_big.data(), 16) == Status::MESSAGE_TOO_BIG);
+}
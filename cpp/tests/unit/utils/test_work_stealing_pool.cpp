@@ -0,0 +1,97 @@
+#include "doctest.h"
+#include "../../../utils/app_service/work_stealing_pool.hpp"
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+TEST_CASE("WorkStealingPool - Runs Every Item Exactly Once") {
+    app_service::WorkStealingPool::Config config;
+    config.threads = 4;
+    app_service::WorkStealingPool pool(config);
+    REQUIRE(pool.size() == 4);
+
+    for (size_t count : {size_t(1), size_t(3), size_t(1000), size_t(100003)}) {
+        std::vector<std::atomic<int>> runs(count);
+        std::atomic<bool> bad_worker{false};
+        pool.parallel_for(count, 7, [&](size_t begin, size_t end, size_t worker) {
+            bad_worker = bad_worker || worker >= pool.size() || end - begin > 7;
+            for (size_t i = begin; i < end; ++i) {
+                runs[i].fetch_add(1);
+            }
+        });
+        CHECK_FALSE(bad_worker.load());
+        size_t once = 0;
+        for (const auto& run : runs) {
+            once += run.load() == 1;
+        }
+        CHECK(once == count);
+    }
+
+    // Nothing to do: the body is not called
+    bool called = false;
+    pool.parallel_for(0, 1, [&](size_t, size_t, size_t) { called = true; });
+    CHECK_FALSE(called);
+}
+
+TEST_CASE("WorkStealingPool - Idle Workers Steal From A Slow One") {
+    app_service::WorkStealingPool::Config config;
+    config.threads = 4;
+    app_service::WorkStealingPool pool(config);
+
+    // Worker 0 starts with items 0-63, each slow; the others finish theirs at once
+    std::vector<size_t> ran_on(256);
+    pool.parallel_for(ran_on.size(), 1, [&](size_t begin, size_t end, size_t worker) {
+        for (size_t i = begin; i < end; ++i) {
+            if (i < 64) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            ran_on[i] = worker;
+        }
+    });
+
+    CHECK(pool.get_statistics().steals.load() > 0);
+    size_t moved = 0;
+    for (size_t i = 0; i < 64; ++i) {
+        moved += ran_on[i] != 0;
+    }
+    CHECK(moved > 0);
+    CHECK(pool.get_statistics().chunks.load() == ran_on.size());
+}
+
+TEST_CASE("WorkStealingPool - Rethrows The Body's Exception And Stays Usable") {
+    app_service::WorkStealingPool::Config config;
+    config.threads = 3;
+    app_service::WorkStealingPool pool(config);
+
+    std::atomic<size_t> ran{0};
+    CHECK_THROWS_AS(pool.parallel_for(10000, 10, [&](size_t begin, size_t end, size_t) {
+        if (begin <= 5000 && 5000 < end) {
+            throw std::runtime_error("item 5000");
+        }
+        ran += end - begin;
+    }), std::runtime_error);
+    CHECK(ran.load() < 10000);
+
+    std::atomic<size_t> total{0};
+    pool.parallel_for(500, 16, [&](size_t begin, size_t end, size_t) { total += end - begin; });
+    CHECK(total.load() == 500);
+}
+
+TEST_CASE("WorkStealingPool - Single Thread Runs On The Caller") {
+    app_service::WorkStealingPool::Config config;
+    config.threads = 1;
+    app_service::WorkStealingPool pool(config);
+
+    const auto caller = std::this_thread::get_id();
+    bool other_thread = false;
+    size_t items = 0;
+    pool.parallel_for(100, 8, [&](size_t begin, size_t end, size_t worker) {
+        other_thread = other_thread || std::this_thread::get_id() != caller || worker != 0;
+        items += end - begin;
+    });
+    CHECK_FALSE(other_thread);
+    CHECK(items == 100);
+    CHECK(pool.get_statistics().steals.load() == 0);
+}
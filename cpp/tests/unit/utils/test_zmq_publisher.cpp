@@ -2,6 +2,7 @@
 #include "../../../utils/zmq/zmq_publisher.hpp"
 #include <thread>
 #include <chrono>
+#include <cstring>
 
 TEST_CASE("ZmqPublisher - Basic Functionality") {
     // Test publisher creation and binding
@@ -44,3 +45,91 @@ TEST_CASE("ZmqPublisher - Large Message") {
     bool result = publisher.send_string("test_topic", large_message);
     CHECK(result == true);
 }
+
+TEST_CASE("ZmqFramePool - Acquire And Recycle") {
+    ZmqFramePool pool(4, 100);
+    
+    // Frame size is rounded up to a cache line
+    CHECK(pool.frame_size() == 128);
+    CHECK(pool.available() == 4);
+    
+    ZmqFrame* frames[4];
+    for (auto& frame : frames) {
+        frame = pool.acquire();
+        REQUIRE(frame != nullptr);
+        CHECK(frame->size() == 0);
+        CHECK(frame->capacity() == 128);
+    }
+    CHECK(pool.available() == 0);
+    CHECK(pool.acquire() == nullptr);
+    CHECK(pool.get_exhausted_count() == 1);
+    
+    // Extra reference keeps the frame out of the pool until both are dropped
+    frames[0]->add_ref();
+    frames[0]->release();
+    CHECK(pool.available() == 0);
+    frames[0]->release();
+    CHECK(pool.available() == 1);
+    
+    for (int i = 1; i < 4; ++i) {
+        frames[i]->release();
+    }
+    CHECK(pool.available() == 4);
+}
+
+TEST_CASE("ZmqPublisher - Zero-Copy Send") {
+    ZmqPublisher publisher("tcp://127.0.0.1:5562", 1000, false, 8, 256);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    
+    std::string payload = "zero-copy payload";
+    bool result = publisher.send_serialized("test_topic", [&payload](char* buffer, size_t capacity) {
+        if (payload.size() > capacity) return ZmqPublisher::WRITE_FAILED;
+        std::memcpy(buffer, payload.data(), payload.size());
+        return payload.size();
+    });
+    CHECK(result == true);
+    
+    // Oversized payloads are rejected without leaking the frame
+    result = publisher.send_serialized("test_topic", [](char*, size_t) {
+        return ZmqPublisher::WRITE_FAILED;
+    });
+    CHECK(result == false);
+    
+    // Every frame is back in the pool once ZMQ has released it
+    for (int i = 0; i < 20 && publisher.get_frames_available() != 8; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    CHECK(publisher.get_frames_available() == 8);
+}
+
+TEST_CASE("ZmqPublisher - Zero-Copy Send Unbound") {
+    ZmqPublisher publisher("invalid://endpoint", 1000, false, 2, 64);
+    
+    ZmqFrame* frame = publisher.acquire_frame();
+    REQUIRE(frame != nullptr);
+    frame->set_size(0);
+    
+    // Failed sends still return the frame to the pool
+    CHECK(publisher.send_frame("test_topic", frame) == false);
+    CHECK(publisher.get_frames_available() == 2);
+}
+
+TEST_CASE("ZmqPublisher - No Frame Pool By Default") {
+    ZmqPublisher publisher("tcp://127.0.0.1:5567");
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    
+    // Nothing preallocated: the zero-copy entry points fall back to copying sends
+    CHECK(publisher.get_frames_available() == 0);
+    CHECK(publisher.acquire_frame() == nullptr);
+    
+    std::string payload = "copied payload";
+    CHECK(publisher.send_serialized("test_topic", [&payload](char* buffer, size_t capacity) {
+        if (payload.size() > capacity) return ZmqPublisher::WRITE_FAILED;
+        std::memcpy(buffer, payload.data(), payload.size());
+        return payload.size();
+    }));
+    CHECK_FALSE(publisher.send_serialized("test_topic", [](char*, size_t) {
+        return ZmqPublisher::WRITE_FAILED;
+    }));
+    CHECK(publisher.get_frame_pool_exhausted() == 0);
+}
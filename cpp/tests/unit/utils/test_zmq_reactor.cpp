@@ -0,0 +1,79 @@
+#include "doctest.h"
+#include "../../../utils/zmq/zmq_reactor.hpp"
+#include "../../../utils/zmq/zmq_subscriber.hpp"
+#include "../../../utils/zmq/zmq_publisher.hpp"
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+TEST_CASE("ZmqReactor - Dispatches Readable Sockets") {
+    ZmqPublisher publisher("tcp://127.0.0.1:5566");
+    ZmqSubscriber first("tcp://127.0.0.1:5566", "reactor_a");
+    ZmqSubscriber second("tcp://127.0.0.1:5566", "reactor_b");
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    ZmqReactor reactor;
+    std::vector<std::string> received;
+    std::string payload;
+    REQUIRE(reactor.add_socket(first.socket_handle(), [&]() {
+        while (first.receive_into(payload, 0)) received.push_back("a:" + payload);
+    }));
+    REQUIRE(reactor.add_socket(second.socket_handle(), [&]() {
+        while (second.receive_into(payload, 0)) received.push_back("b:" + payload);
+    }));
+    CHECK(reactor.source_count() == 2);
+
+    // Nothing queued: the poll times out without dispatching
+    CHECK(reactor.poll_once(10) == 0);
+
+    publisher.send_string("reactor_a", "one");
+    publisher.send_string("reactor_b", "two");
+    publisher.send_string("reactor_a", "three");
+    for (int i = 0; i < 20 && received.size() < 3; ++i) {
+        reactor.poll_once(100);
+    }
+    REQUIRE(received.size() == 3);
+    CHECK(received[0] == "a:one");
+    CHECK(received[1] == "a:three");
+    CHECK(received[2] == "b:two");
+    CHECK(reactor.get_dispatch_count() >= 2);
+}
+
+TEST_CASE("ZmqReactor - File Descriptors And Stop") {
+    int fds[2];
+    REQUIRE(pipe(fds) == 0);
+
+    ZmqReactor reactor;
+    std::atomic<int> pipe_events{0};
+    REQUIRE(reactor.add_fd(fds[0], [&]() {
+        char byte;
+        if (read(fds[0], &byte, 1) == 1) ++pipe_events;
+    }));
+    CHECK_FALSE(reactor.add_fd(-1, []() {}));
+    CHECK_FALSE(reactor.add_socket(nullptr, []() {}));
+
+    std::thread loop([&reactor]() { reactor.run(); });
+    for (int i = 0; i < 100 && !reactor.is_running(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    // Sources are fixed once the loop runs
+    CHECK_FALSE(reactor.add_fd(fds[1], []() {}));
+
+    REQUIRE(write(fds[1], "x", 1) == 1);
+    for (int i = 0; i < 100 && pipe_events == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // stop() wakes the loop blocked in zmq_poll with no timeout
+    reactor.stop();
+    loop.join();
+    CHECK(pipe_events == 1);
+    CHECK_FALSE(reactor.is_running());
+    CHECK(reactor.get_wakeup_count() >= 1);
+
+    close(fds[0]);
+    close(fds[1]);
+}
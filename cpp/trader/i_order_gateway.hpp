@@ -0,0 +1,42 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+/**
+ * Outbound order path of the trader process
+ *
+ * MiniOMS hands the strategy's orders, cancels and modifies to a gateway.
+ * In production that is ZmqOMSAdapter, which publishes them to the trading
+ * engine; the backtester plugs in a gateway that delivers them to a
+ * simulated exchange instead. Order events come back through
+ * StrategyContainer::on_order_event() either way.
+ */
+class IOrderGateway {
+public:
+    virtual ~IOrderGateway() = default;
+
+    virtual bool send_order(const std::string& cl_ord_id,
+                            const std::string& exch,
+                            const std::string& symbol,
+                            uint32_t side,       // 0=Buy, 1=Sell
+                            uint32_t is_market,  // 0=Limit, 1=Market
+                            double qty,
+                            double price) = 0;
+
+    virtual bool cancel_order(const std::string& cl_ord_id,
+                              const std::string& exch,
+                              const std::string& symbol = "") = 0;
+
+    // new_qty is the order's new total size, filled quantity included. Side and
+    // symbol are the order's own; venues that amend by cancel/replace need them
+    virtual bool modify_order(const std::string& cl_ord_id,
+                              const std::string& exch,
+                              uint32_t side,       // 0=Buy, 1=Sell
+                              double new_price,
+                              double new_qty,
+                              const std::string& symbol = "") = 0;
+
+    // Calls between begin_batch() and the matching flush_batch() leave as one batch
+    virtual void begin_batch() = 0;
+    virtual bool flush_batch() = 0;
+};
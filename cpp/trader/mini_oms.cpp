@@ -1,20 +1,38 @@
 #include "mini_oms.hpp"
-#include "zmq_oms_adapter.hpp"
 #include "../utils/logging/logger.hpp"
-#include "../utils/exchange/exchange_symbol_registry.hpp"
-#include <random>
+#include "../utils/logging/binary_logger.hpp"
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
 
-MiniOMS::MiniOMS() : running_(false) {
+namespace {
+
+int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+MiniOMS::MiniOMS(size_t capacity) : orders_(capacity), running_(false) {
+    std::fill(std::begin(registry_handles_), std::end(registry_handles_), ExchangeSymbolRegistry::kInvalidInstrument);
     statistics_.reset();
 }
 
-void MiniOMS::set_oms_adapter(std::shared_ptr<ZmqOMSAdapter> adapter) {
+void MiniOMS::set_oms_adapter(std::shared_ptr<IOrderGateway> adapter) {
     oms_adapter_ = adapter;
 }
 
+void MiniOMS::begin_batch() {
+    if (oms_adapter_) {
+        oms_adapter_->begin_batch();
+    }
+}
+
+bool MiniOMS::flush_batch() {
+    return oms_adapter_ ? oms_adapter_->flush_batch() : true;
+}
+
 void MiniOMS::set_mds_adapter(std::shared_ptr<ZmqMDSAdapter> adapter) {
     mds_adapter_ = adapter;
 }
@@ -43,34 +61,31 @@ void MiniOMS::stop() {
     running_.store(false);
     
     // Collect orders to cancel (release lock before cancelling to avoid deadlock)
-    std::vector<std::string> orders_to_cancel;
+    struct PendingCancel {
+        std::string cl_ord_id;
+        std::string exchange;
+        std::string symbol;
+    };
+    std::vector<PendingCancel> orders_to_cancel;
     {
         std::lock_guard<std::mutex> lock(orders_mutex_);
-        for (const auto& [cl_ord_id, order_info] : orders_) {
-            if (order_info.state == OrderState::PENDING || 
-                order_info.state == OrderState::ACKNOWLEDGED ||
-                order_info.state == OrderState::PARTIALLY_FILLED) {
-                orders_to_cancel.push_back(cl_ord_id);
+        orders_.for_each([&](const OrderRecord& order) {
+            if (order.is_live()) {
+                orders_to_cancel.push_back({std::string(order.cl_ord_id()), orders_.exchange_of(order.instrument),
+                                            orders_.symbol_of(order.instrument)});
             }
-        }
+        });
     }
     
     // Actually cancel orders via adapter
     if (oms_adapter_ && !orders_to_cancel.empty()) {
         logger.info("Cancelling " + std::to_string(orders_to_cancel.size()) + " pending orders");
-        for (const auto& cl_ord_id : orders_to_cancel) {
-            logger.debug("Cancelling order: " + cl_ord_id);
-            // Extract exchange from order info if available
-            std::string exchange = "";
-            {
-                std::lock_guard<std::mutex> lock(orders_mutex_);
-                auto it = orders_.find(cl_ord_id);
-                if (it != orders_.end()) {
-                    exchange = it->second.exch;
-                }
-            }
-            oms_adapter_->cancel_order(cl_ord_id, exchange);
+        oms_adapter_->begin_batch();
+        for (const auto& order : orders_to_cancel) {
+            logger.debug("Cancelling order: " + order.cl_ord_id);
+            oms_adapter_->cancel_order(order.cl_ord_id, order.exchange, order.symbol);
         }
+        oms_adapter_->flush_batch();
     } else if (orders_to_cancel.empty()) {
         logger.debug("No pending orders to cancel");
     } else {
@@ -84,48 +99,83 @@ bool MiniOMS::send_order(const std::string& cl_ord_id,
                         proto::OrderType type,
                         double qty,
                         double price) {
+    return submit(&cl_ord_id, symbol, side, type, qty, price) != kInvalidOrderId;
+}
+
+MiniOMS::OrderId MiniOMS::place_order(const std::string& symbol,
+                                      proto::Side side,
+                                      proto::OrderType type,
+                                      double qty,
+                                      double price) {
+    return submit(nullptr, symbol, side, type, qty, price);
+}
+
+MiniOMS::OrderId MiniOMS::submit(const std::string* cl_ord_id,
+                                 const std::string& symbol,
+                                 proto::Side side,
+                                 proto::OrderType type,
+                                 double qty,
+                                 double price) {
     if (!running_.load()) {
-        return false;
+        return kInvalidOrderId;
     }
     
-    logging::Logger logger("MINI_OMS");
-    
     // Validate parameters
     if (qty <= 0.0) {
+        logging::Logger logger("MINI_OMS");
         logger.error("Invalid order quantity: " + std::to_string(qty));
-        return false;
+        return kInvalidOrderId;
     }
     
     if (type == proto::LIMIT && price <= 0.0) {
+        logging::Logger logger("MINI_OMS");
         logger.error("Invalid price for limit order: " + std::to_string(price));
-        return false;
+        return kInvalidOrderId;
     }
     
-    // Validate order parameters using exchange symbol registry
-    // Note: Strategy should have already rounded prices/sizes, so we only validate here
-    auto& registry = ExchangeSymbolRegistry::get_instance();
-    if (!registry.validate_only(exchange_name_, symbol, qty, price)) {
-        logger.error("Order validation failed for: " + cl_ord_id);
-        return false;
-    }
-    
-    // Create order state info
-    OrderStateInfo order_info;
-    order_info.cl_ord_id = cl_ord_id;
-    order_info.symbol = symbol;
-    order_info.side = (side == proto::BUY) ? Side::Buy : Side::Sell;
-    order_info.qty = qty;
-    order_info.price = price;
-    order_info.is_market = (type == proto::MARKET);
-    order_info.state = OrderState::PENDING;
-    order_info.exch = exchange_name_; // Store exchange name
-    order_info.created_time = std::chrono::system_clock::now();
-    order_info.last_update_time = order_info.created_time;
-    
-    // Store order
+    OrderId order_id = kInvalidOrderId;
+    char generated_id[OrderRecord::kMaxClOrdIdLength + 1];
+    std::string_view wire_id;
     {
         std::lock_guard<std::mutex> lock(orders_mutex_);
-        orders_[cl_ord_id] = order_info;
+        uint32_t instrument = orders_.intern_instrument(exchange_name_, symbol);
+        if (instrument == OrderStore::kNoInstrument) {
+            logging::Logger logger("MINI_OMS");
+            logger.error("Too many instruments - cannot track orders for " + symbol);
+            return kInvalidOrderId;
+        }
+        
+        // Validate order parameters using exchange symbol registry
+        // Note: Strategy should have already rounded prices/sizes, so we only validate here
+        auto& registry = ExchangeSymbolRegistry::get_instance();
+        ExchangeSymbolRegistry::InstrumentHandle& handle = registry_handles_[instrument];
+        if (handle == ExchangeSymbolRegistry::kInvalidInstrument) {
+            handle = registry.find_instrument(exchange_name_, symbol);
+        }
+        bool valid = handle != ExchangeSymbolRegistry::kInvalidInstrument
+                         ? registry.validate_only(handle, qty, price)
+                         : registry.validate_only(exchange_name_, symbol, qty, price);
+        if (!valid) {
+            logging::Logger logger("MINI_OMS");
+            logger.error("Order validation failed for: " + (cl_ord_id ? *cl_ord_id : symbol));
+            return kInvalidOrderId;
+        }
+        
+        OrderRecord* order = orders_.insert(cl_ord_id ? std::string_view(*cl_ord_id) : std::string_view(),
+                                            instrument, side == proto::BUY ? Side::Buy : Side::Sell,
+                                            type == proto::MARKET, qty, price, now_ns());
+        if (!order) {
+            logging::Logger logger("MINI_OMS");
+            logger.error("Cannot store order " + (cl_ord_id ? *cl_ord_id : symbol) +
+                         ": cl_ord_id live or too long, or all " + std::to_string(orders_.capacity()) +
+                         " slots hold live orders");
+            return kInvalidOrderId;
+        }
+        order_id = order->id;
+        if (!cl_ord_id) {
+            order->cl_ord_id().copy(generated_id, order->cl_ord_id().size());
+            wire_id = std::string_view(generated_id, order->cl_ord_id().size());
+        }
     }
     
     // Update statistics
@@ -134,82 +184,110 @@ bool MiniOMS::send_order(const std::string& cl_ord_id,
     
     // Send order via ZMQ adapter
     if (oms_adapter_) {
-        std::stringstream ss;
-        ss << "Sending order: " << cl_ord_id << " " << symbol 
-           << " " << (side == proto::BUY ? "BUY" : "SELL")
-           << " " << qty << " @ " << price;
-        logger.debug(ss.str());
+        // Generated ids fit std::string's small buffer, so this does not allocate
+        const std::string generated = cl_ord_id ? std::string() : std::string(wire_id);
+        const std::string& wire_cl_ord_id = cl_ord_id ? *cl_ord_id : generated;
+        FAST_LOG_DEBUG("MINI_OMS", "Sending order: {} {} {} {} @ {}", wire_cl_ord_id, symbol,
+                       side == proto::BUY ? "BUY" : "SELL", qty, price);
         
         // Actually send order via adapter
-        bool sent = oms_adapter_->send_order(cl_ord_id, exchange_name_, symbol, 
+        bool sent = oms_adapter_->send_order(wire_cl_ord_id, exchange_name_, symbol, 
                                             (side == proto::BUY ? 0 : 1), 
                                             (type == proto::MARKET ? 1 : 0), 
                                             qty, price);
         if (!sent) {
-            logger.error("Failed to send order via ZMQ adapter: " + cl_ord_id);
+            logging::Logger logger("MINI_OMS");
+            logger.error("Failed to send order via ZMQ adapter: " + wire_cl_ord_id);
             // Update state to REJECTED on failure
-            update_order_state(cl_ord_id, OrderState::REJECTED, "Failed to send via ZMQ");
-            statistics_.rejected_orders.fetch_add(1);
-            statistics_.pending_orders.fetch_sub(1);
-            return false;
+            bool rejected = false;
+            {
+                std::lock_guard<std::mutex> lock(orders_mutex_);
+                OrderRecord* order = orders_.find(order_id);
+                rejected = order && apply_state(*order, OrderState::REJECTED, "Failed to send via ZMQ", 0.0, 0.0, now_ns());
+            }
+            if (rejected) {
+                notify_order_state_change(order_id);
+            }
+            return kInvalidOrderId;
         }
         
         // Notify state change
-        notify_order_state_change(order_info);
-        return true;
+        notify_order_state_change(order_id);
+        return order_id;
     }
     
+    logging::Logger logger("MINI_OMS");
     logger.error("No OMS adapter available");
     // Update state to REJECTED if no adapter
-    update_order_state(cl_ord_id, OrderState::REJECTED, "No OMS adapter available");
-    statistics_.rejected_orders.fetch_add(1);
-    statistics_.pending_orders.fetch_sub(1);
-    return false;
+    {
+        std::lock_guard<std::mutex> lock(orders_mutex_);
+        OrderRecord* order = orders_.find(order_id);
+        if (order) {
+            apply_state(*order, OrderState::REJECTED, "No OMS adapter available", 0.0, 0.0, now_ns());
+        }
+    }
+    notify_order_state_change(order_id);
+    return kInvalidOrderId;
 }
 
 bool MiniOMS::cancel_order(const std::string& cl_ord_id) {
+    return cancel(&cl_ord_id, kInvalidOrderId);
+}
+
+bool MiniOMS::cancel_order(OrderId order_id) {
+    return cancel(nullptr, order_id);
+}
+
+bool MiniOMS::cancel(const std::string* cl_ord_id, OrderId order_id) {
     if (!running_.load()) {
         return false;
     }
     
-    std::string exchange;
+    char generated_id[OrderRecord::kMaxClOrdIdLength + 1];
+    size_t generated_length = 0;
+    const std::string* exchange = nullptr;
+    const std::string* symbol = nullptr;
     {
         std::lock_guard<std::mutex> lock(orders_mutex_);
-        auto it = orders_.find(cl_ord_id);
-        if (it == orders_.end()) {
+        OrderRecord* order = find_locked(cl_ord_id, order_id);
+        if (!order) {
             logging::Logger logger("MINI_OMS");
-            logger.error("Order not found: " + cl_ord_id);
+            logger.error("Order not found: " + (cl_ord_id ? *cl_ord_id : std::to_string(order_id)));
             return false;
         }
         
-        OrderStateInfo& order_info = it->second;
-        
         // Check if order can be cancelled
-        if (!is_valid_order_transition(cl_ord_id, OrderState::CANCELLED)) {
+        if (!OrderStateMachine::isValidTransition(order->state, OrderState::CANCELLED)) {
             logging::Logger logger("MINI_OMS");
             std::stringstream ss;
-            ss << "Cannot cancel order in state: " << to_string(order_info.state);
+            ss << "Cannot cancel order in state: " << to_string(order->state);
             logger.warn(ss.str());
             return false;
         }
         
-        // Get exchange name from order info
-        exchange = order_info.exch;
-        if (exchange.empty()) {
-            exchange = exchange_name_; // Fallback to default exchange name
+        // Get exchange name and symbol from order info (instrument names never move)
+        exchange = &orders_.exchange_of(order->instrument);
+        symbol = &orders_.symbol_of(order->instrument);
+        if (exchange->empty()) {
+            exchange = &exchange_name_; // Fallback to default exchange name
+        }
+        if (!cl_ord_id) {
+            generated_length = order->cl_ord_id().copy(generated_id, order->cl_ord_id().size());
         }
         // lock automatically unlocks when it goes out of scope
     }
     
     // Send cancel request via ZMQ adapter
     if (oms_adapter_) {
-        logging::Logger logger("MINI_OMS");
-        logger.debug("Cancelling order: " + cl_ord_id + " on exchange: " + exchange);
+        const std::string generated = cl_ord_id ? std::string() : std::string(generated_id, generated_length);
+        const std::string& wire_cl_ord_id = cl_ord_id ? *cl_ord_id : generated;
+        FAST_LOG_DEBUG("MINI_OMS", "Cancelling order: {} on exchange: {}", wire_cl_ord_id, *exchange);
         
         // Actually send cancel via adapter
-        bool cancelled = oms_adapter_->cancel_order(cl_ord_id, exchange);
+        bool cancelled = oms_adapter_->cancel_order(wire_cl_ord_id, *exchange, *symbol);
         if (!cancelled) {
-            logger.error("Failed to send cancel request via ZMQ adapter: " + cl_ord_id);
+            logging::Logger logger("MINI_OMS");
+            logger.error("Failed to send cancel request via ZMQ adapter: " + wire_cl_ord_id);
             // Don't update state if cancel request failed
             return false;
         }
@@ -217,7 +295,6 @@ bool MiniOMS::cancel_order(const std::string& cl_ord_id) {
         // Don't update state to CANCELLED yet - wait for exchange confirmation via order event
         // This prevents race conditions where cancel fails but state is already CANCELLED
         // The order event will update the state when exchange confirms cancellation
-        logger.debug("Cancel request sent successfully - waiting for exchange confirmation");
         return true;
     }
     
@@ -227,6 +304,14 @@ bool MiniOMS::cancel_order(const std::string& cl_ord_id) {
 }
 
 bool MiniOMS::modify_order(const std::string& cl_ord_id, double new_price, double new_qty) {
+    return modify(&cl_ord_id, kInvalidOrderId, new_price, new_qty);
+}
+
+bool MiniOMS::modify_order(OrderId order_id, double new_price, double new_qty) {
+    return modify(nullptr, order_id, new_price, new_qty);
+}
+
+bool MiniOMS::modify(const std::string* cl_ord_id, OrderId order_id, double new_price, double new_qty) {
     if (!running_.load()) {
         return false;
     }
@@ -244,56 +329,73 @@ bool MiniOMS::modify_order(const std::string& cl_ord_id, double new_price, doubl
         return false;
     }
     
-    std::string exchange;
+    char generated_id[OrderRecord::kMaxClOrdIdLength + 1];
+    size_t generated_length = 0;
+    const std::string* exchange = nullptr;
+    const std::string* symbol = nullptr;
+    uint32_t side = 0;
     {
         std::lock_guard<std::mutex> lock(orders_mutex_);
-        auto it = orders_.find(cl_ord_id);
-        if (it == orders_.end()) {
+        OrderRecord* order = find_locked(cl_ord_id, order_id);
+        if (!order) {
             logging::Logger logger("MINI_OMS");
-            logger.error("Order not found: " + cl_ord_id);
+            logger.error("Order not found: " + (cl_ord_id ? *cl_ord_id : std::to_string(order_id)));
             return false;
         }
         
-        OrderStateInfo& order_info = it->second;
-        
         // Check if order can be modified
-        if (order_info.state != OrderState::ACKNOWLEDGED && 
-            order_info.state != OrderState::PARTIALLY_FILLED) {
+        if (order->state != OrderState::ACKNOWLEDGED && 
+            order->state != OrderState::PARTIALLY_FILLED) {
             logging::Logger logger("MINI_OMS");
             std::stringstream ss;
-            ss << "Cannot modify order in state: " << to_string(order_info.state);
+            ss << "Cannot modify order in state: " << to_string(order->state);
             logger.warn(ss.str());
             return false;
         }
         
-        exchange = order_info.exch;
-        if (exchange.empty()) {
-            exchange = exchange_name_; // Fallback to default exchange name
+        // new_qty is the new total size, fills included; it has to leave something
+        // open, or a live order would be taken for FILLED on its next fill
+        if (order->filled_qty >= new_qty * (1.0 - 1e-9)) {
+            logging::Logger logger("MINI_OMS");
+            logger.warn("Modify to " + std::to_string(new_qty) + " does not exceed filled quantity " +
+                        std::to_string(order->filled_qty) + "; cancel the order instead");
+            return false;
+        }
+        
+        order_id = order->id;
+        side = order->side == Side::Buy ? 0 : 1;
+        exchange = &orders_.exchange_of(order->instrument);
+        symbol = &orders_.symbol_of(order->instrument);
+        if (exchange->empty()) {
+            exchange = &exchange_name_; // Fallback to default exchange name
+        }
+        if (!cl_ord_id) {
+            generated_length = order->cl_ord_id().copy(generated_id, order->cl_ord_id().size());
         }
     }
     
     // Send modify request via ZMQ adapter
     if (oms_adapter_) {
-        logging::Logger logger("MINI_OMS");
-        std::stringstream ss;
-        ss << "Modifying order: " << cl_ord_id << " new_price=" << new_price << " new_qty=" << new_qty;
-        logger.debug(ss.str());
+        const std::string generated = cl_ord_id ? std::string() : std::string(generated_id, generated_length);
+        const std::string& wire_cl_ord_id = cl_ord_id ? *cl_ord_id : generated;
+        FAST_LOG_DEBUG("MINI_OMS", "Modifying order: {} new_price={} new_qty={}", wire_cl_ord_id, new_price, new_qty);
         
         // Actually send modify via adapter
-        bool modified = oms_adapter_->modify_order(cl_ord_id, exchange, new_price, new_qty);
+        bool modified = oms_adapter_->modify_order(wire_cl_ord_id, *exchange, side, new_price, new_qty, *symbol);
         if (!modified) {
-            logger.error("Failed to send modify request via ZMQ adapter: " + cl_ord_id);
+            logging::Logger logger("MINI_OMS");
+            logger.error("Failed to send modify request via ZMQ adapter: " + wire_cl_ord_id);
             return false;
         }
         
         // Update order details locally (actual modification confirmed via order event)
         {
             std::lock_guard<std::mutex> lock(orders_mutex_);
-            auto it = orders_.find(cl_ord_id);
-            if (it != orders_.end()) {
-                it->second.price = new_price;
-                it->second.qty = new_qty;
-                it->second.last_update_time = std::chrono::system_clock::now();
+            OrderRecord* order = orders_.find(order_id);
+            if (order) {
+                order->price = new_price;
+                order->qty = new_qty;
+                order->updated_ns = now_ns();
             }
         }
         
@@ -305,11 +407,21 @@ bool MiniOMS::modify_order(const std::string& cl_ord_id, double new_price, doubl
     return false;
 }
 
+MiniOMS::OrderId MiniOMS::find_order_id(const std::string& cl_ord_id) const {
+    std::lock_guard<std::mutex> lock(orders_mutex_);
+    const OrderRecord* order = orders_.find(std::string_view(cl_ord_id));
+    return order ? order->id : kInvalidOrderId;
+}
+
+OrderRecord* MiniOMS::find_locked(const std::string* cl_ord_id, OrderId order_id) {
+    return cl_ord_id ? orders_.find(std::string_view(*cl_ord_id)) : orders_.find(order_id);
+}
+
 OrderStateInfo MiniOMS::get_order_state(const std::string& cl_ord_id) {
     std::lock_guard<std::mutex> lock(orders_mutex_);
-    auto it = orders_.find(cl_ord_id);
-    if (it != orders_.end()) {
-        return it->second;
+    const OrderRecord* order = orders_.find(std::string_view(cl_ord_id));
+    if (order) {
+        return to_order_state_info(*order);
     }
     
     // Return empty state for non-existent order
@@ -321,14 +433,13 @@ OrderStateInfo MiniOMS::get_order_state(const std::string& cl_ord_id) {
 std::vector<OrderStateInfo> MiniOMS::get_active_orders() {
     std::lock_guard<std::mutex> lock(orders_mutex_);
     std::vector<OrderStateInfo> active_orders;
+    active_orders.reserve(orders_.live_count());
     
-    for (const auto& [cl_ord_id, order_info] : orders_) {
-        if (order_info.state == OrderState::PENDING || 
-            order_info.state == OrderState::ACKNOWLEDGED ||
-            order_info.state == OrderState::PARTIALLY_FILLED) {
-            active_orders.push_back(order_info);
+    orders_.for_each([&](const OrderRecord& order) {
+        if (order.is_live()) {
+            active_orders.push_back(to_order_state_info(order));
         }
-    }
+    });
     
     return active_orders;
 }
@@ -336,10 +447,11 @@ std::vector<OrderStateInfo> MiniOMS::get_active_orders() {
 std::vector<OrderStateInfo> MiniOMS::get_all_orders() {
     std::lock_guard<std::mutex> lock(orders_mutex_);
     std::vector<OrderStateInfo> all_orders;
+    all_orders.reserve(orders_.size());
     
-    for (const auto& [cl_ord_id, order_info] : orders_) {
-        all_orders.push_back(order_info);
-    }
+    orders_.for_each([&](const OrderRecord& order) {
+        all_orders.push_back(to_order_state_info(order));
+    });
     
     return all_orders;
 }
@@ -348,11 +460,11 @@ std::vector<OrderStateInfo> MiniOMS::get_orders_by_symbol(const std::string& sym
     std::lock_guard<std::mutex> lock(orders_mutex_);
     std::vector<OrderStateInfo> symbol_orders;
     
-    for (const auto& [cl_ord_id, order_info] : orders_) {
-        if (order_info.symbol == symbol) {
-            symbol_orders.push_back(order_info);
+    orders_.for_each([&](const OrderRecord& order) {
+        if (orders_.symbol_of(order.instrument) == symbol) {
+            symbol_orders.push_back(to_order_state_info(order));
         }
-    }
+    });
     
     return symbol_orders;
 }
@@ -361,11 +473,11 @@ std::vector<OrderStateInfo> MiniOMS::get_orders_by_state(OrderState state) {
     std::lock_guard<std::mutex> lock(orders_mutex_);
     std::vector<OrderStateInfo> state_orders;
     
-    for (const auto& [cl_ord_id, order_info] : orders_) {
-        if (order_info.state == state) {
-            state_orders.push_back(order_info);
+    orders_.for_each([&](const OrderRecord& order) {
+        if (order.state == state) {
+            state_orders.push_back(to_order_state_info(order));
         }
-    }
+    });
     
     return state_orders;
 }
@@ -375,7 +487,7 @@ void MiniOMS::on_order_event(const proto::OrderEvent& order_event) {
         return;
     }
     
-    std::string cl_ord_id = order_event.cl_ord_id();
+    const std::string& cl_ord_id = order_event.cl_ord_id();
     OrderState new_state;
     
     // Map proto event type to order state
@@ -384,7 +496,7 @@ void MiniOMS::on_order_event(const proto::OrderEvent& order_event) {
             new_state = OrderState::ACKNOWLEDGED;
             break;
         case proto::OrderEventType::FILL:
-            new_state = OrderState::PARTIALLY_FILLED; // Will be updated to FILLED if complete
+            new_state = OrderState::PARTIALLY_FILLED; // FILLED once the whole quantity has filled
             break;
         case proto::OrderEventType::CANCEL:
             new_state = OrderState::CANCELLED;
@@ -399,20 +511,29 @@ void MiniOMS::on_order_event(const proto::OrderEvent& order_event) {
     }
     
     // Update order state and store exchange_order_id if present
+    OrderId order_id = kInvalidOrderId;
     {
         std::lock_guard<std::mutex> lock(orders_mutex_);
-        auto it = orders_.find(cl_ord_id);
-        if (it != orders_.end()) {
+        OrderRecord* order = orders_.find(std::string_view(cl_ord_id));
+        if (!order) {
+            logging::Logger logger("MINI_OMS");
+            logger.error("Order not found for state update: " + cl_ord_id);
+        } else {
             // Store exchange_order_id when available (usually in ACK event)
             if (!order_event.exch_order_id().empty()) {
-                it->second.exchange_order_id = order_event.exch_order_id();
+                order->set_exchange_order_id(order_event.exch_order_id());
+            }
+            if (apply_state(*order, new_state, order_event.text(), order_event.fill_qty(),
+                            order_event.fill_price(), now_ns())) {
+                order_id = order->id;
             }
         }
     }
     
-    // Update order state
-    update_order_state(cl_ord_id, new_state, order_event.text(), 
-                      order_event.fill_qty(), order_event.fill_price());
+    // Notify callback AFTER releasing lock (prevents deadlock if callback calls back into MiniOMS)
+    if (order_id != kInvalidOrderId) {
+        notify_order_state_change(order_id);
+    }
     
     // Notify external callback with mutex protection
     {
@@ -449,124 +570,119 @@ void MiniOMS::on_trade_execution(const proto::Trade& trade) {
     double current_volume = statistics_.total_volume.load();
     statistics_.total_volume.store(current_volume + trade_value);
     
-    logging::Logger logger("MINI_OMS");
-    std::stringstream ss;
-    ss << "Trade execution: " << trade.symbol() << " " << trade.qty() << " @ " << trade.price();
-    logger.debug(ss.str());
+    FAST_LOG_DEBUG("MINI_OMS", "Trade execution: {} {} @ {}", trade.symbol(), trade.qty(), trade.price());
 }
 
-void MiniOMS::update_order_state(const std::string& cl_ord_id, OrderState new_state, 
-                                const std::string& reason, double fill_qty, double fill_price) {
-    OrderStateInfo order_info_copy;
-    OrderState old_state;
-    bool order_found = false;
+bool MiniOMS::apply_state(OrderRecord& order, OrderState new_state, const std::string& reason,
+                          double fill_qty, double fill_price, int64_t now_ns) {
+    const OrderState old_state = order.state;
     
-    {
-        std::lock_guard<std::mutex> lock(orders_mutex_);
-        auto it = orders_.find(cl_ord_id);
-        if (it == orders_.end()) {
-            logging::Logger logger("MINI_OMS");
-            logger.error("Order not found for state update: " + cl_ord_id);
-            return;
-        }
-        
-        OrderStateInfo& order_info = it->second;
-        old_state = order_info.state;
-        
-        // Validate transition
-        if (!OrderStateMachine::isValidTransition(old_state, new_state)) {
-            logging::Logger logger("MINI_OMS");
-            std::stringstream ss;
-            ss << "Invalid state transition from " << to_string(old_state) << " to " << to_string(new_state);
-            logger.error(ss.str());
-            return;
-        }
-        
-        // Update state
-        order_info.state = new_state;
-        order_info.last_update_time = std::chrono::system_clock::now();
-        
-        if (!reason.empty()) {
-            order_info.reject_reason = reason;
-        }
-        
-        if (fill_qty > 0.0) {
-            order_info.filled_qty += fill_qty;
-            if (fill_price > 0.0) {
-                // Update average fill price
-                double total_value = (order_info.avg_fill_price * (order_info.filled_qty - fill_qty)) + 
-                                   (fill_price * fill_qty);
-                order_info.avg_fill_price = total_value / order_info.filled_qty;
-            }
-        }
-        
-        // Update statistics
-        switch (new_state) {
-            case OrderState::ACKNOWLEDGED:
-                statistics_.pending_orders.fetch_sub(1);
-                statistics_.active_orders.fetch_add(1);
-                break;
-            case OrderState::FILLED:
-                statistics_.active_orders.fetch_sub(1);
-                statistics_.filled_orders.fetch_add(1);
-                break;
-            case OrderState::CANCELLED:
-                statistics_.active_orders.fetch_sub(1);
-                statistics_.cancelled_orders.fetch_add(1);
-                break;
-            case OrderState::REJECTED:
-                statistics_.pending_orders.fetch_sub(1);
-                statistics_.rejected_orders.fetch_add(1);
-                break;
-            default:
-                break;
+    // A replace is acknowledged again: a working order keeps its state
+    if (new_state == OrderState::ACKNOWLEDGED && order.is_live() && old_state != OrderState::PENDING) {
+        new_state = old_state;
+    }
+    if (new_state == OrderState::PARTIALLY_FILLED && fill_qty > 0.0 &&
+        order.filled_qty + fill_qty >= order.qty * (1.0 - 1e-9)) {
+        new_state = OrderState::FILLED;
+    }
+    
+    // Fills keep coming while partially filled; a fill that overtakes the ACK acknowledges the order
+    bool applied = true;
+    if (new_state == old_state) {
+        applied = order.is_live();
+    } else {
+        const bool implicit_ack = old_state == OrderState::PENDING &&
+                                  (new_state == OrderState::PARTIALLY_FILLED || new_state == OrderState::FILLED);
+        if (implicit_ack) {
+            applied = orders_.transition(order, OrderState::ACKNOWLEDGED, now_ns);
         }
-        
-        // Copy order info while holding lock (for callback)
-        order_info_copy = order_info;
-        order_found = true;
-        
+        applied = applied && orders_.transition(order, new_state, now_ns);
+    }
+    if (!applied) {
         logging::Logger logger("MINI_OMS");
         std::stringstream ss;
-        ss << "Order " << cl_ord_id << " state: " << to_string(old_state) << " -> " << to_string(new_state);
-        logger.debug(ss.str());
-    }  // Release orders_mutex_ BEFORE calling callback to prevent deadlock
+        ss << "Invalid state transition for " << order.cl_ord_id() << " from " << to_string(old_state)
+           << " to " << to_string(new_state);
+        logger.error(ss.str());
+        return false;
+    }
     
-    // Notify callback AFTER releasing lock (prevents deadlock if callback calls back into MiniOMS)
-    if (order_found) {
-        notify_order_state_change(order_info_copy);
+    order.updated_ns = now_ns;
+    if (!reason.empty()) {
+        order.set_reason(reason);
     }
-}
-
-void MiniOMS::notify_order_state_change(const OrderStateInfo& order_info) {
-    // Invoke callback with mutex protection
-    {
-        std::lock_guard<std::mutex> lock(callback_mutex_);
-        if (order_state_callback_) {
-            order_state_callback_(order_info);
+    if (fill_qty > 0.0) {
+        order.filled_qty += fill_qty;
+        if (fill_price > 0.0) {
+            // Update average fill price
+            double total_value = (order.avg_fill_price * (order.filled_qty - fill_qty)) + 
+                               (fill_price * fill_qty);
+            order.avg_fill_price = total_value / order.filled_qty;
         }
     }
-}
-
-bool MiniOMS::is_valid_order_transition(const std::string& cl_ord_id, OrderState new_state) {
-    std::lock_guard<std::mutex> lock(orders_mutex_);
-    auto it = orders_.find(cl_ord_id);
-    if (it == orders_.end()) {
-        return false;
+    
+    if (new_state == old_state) {
+        return true;
+    }
+    
+    // Update statistics: the order leaves the pending/active count it was in, then joins its new one
+    auto counter_of = [this](OrderState state) -> std::atomic<uint64_t>* {
+        switch (state) {
+            case OrderState::PENDING: return &statistics_.pending_orders;
+            case OrderState::ACKNOWLEDGED:
+            case OrderState::PARTIALLY_FILLED: return &statistics_.active_orders;
+            case OrderState::FILLED: return &statistics_.filled_orders;
+            case OrderState::CANCELLED: return &statistics_.cancelled_orders;
+            case OrderState::REJECTED: return &statistics_.rejected_orders;
+            default: return nullptr;
+        }
+    };
+    std::atomic<uint64_t>* from = counter_of(old_state);
+    std::atomic<uint64_t>* to = counter_of(new_state);
+    if (from != to) {
+        if (from) from->fetch_sub(1);
+        if (to) to->fetch_add(1);
     }
     
-    return OrderStateMachine::isValidTransition(it->second.state, new_state);
+    FAST_LOG_DEBUG("MINI_OMS", "Order {} state: {} -> {}", order.cl_ord_id(), to_string(old_state),
+                   to_string(new_state));
+    return true;
 }
 
-std::string MiniOMS::generate_order_id() const {
-    // Use atomic counter to ensure uniqueness across all instances
-    static std::atomic<uint64_t> order_id_counter_{0};
-    
-    uint64_t counter = order_id_counter_.fetch_add(1, std::memory_order_relaxed);
-    
-    std::ostringstream oss;
-    oss << "MM_" << std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::system_clock::now().time_since_epoch()).count()
-        << "_" << counter;
-    return oss.str();
+OrderStateInfo MiniOMS::to_order_state_info(const OrderRecord& order) const {
+    OrderStateInfo info;
+    info.cl_ord_id = std::string(order.cl_ord_id());
+    info.exch = orders_.exchange_of(order.instrument);
+    info.symbol = orders_.symbol_of(order.instrument);
+    info.side = order.side;
+    info.qty = order.qty;
+    info.price = order.price;
+    info.is_market = order.is_market;
+    info.state = order.state;
+    info.filled_qty = order.filled_qty;
+    info.avg_fill_price = order.avg_fill_price;
+    info.exchange_order_id = std::string(order.exchange_order_id());
+    info.created_time = std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(order.created_ns)));
+    info.last_update_time = std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(order.updated_ns)));
+    info.reject_reason = std::string(order.reason());
+    return info;
+}
+
+void MiniOMS::notify_order_state_change(OrderId order_id) {
+    // Invoke callback with mutex protection; OrderStateInfo is only built when someone listens
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    if (order_state_callback_) {
+        OrderStateInfo order_info;
+        {
+            std::lock_guard<std::mutex> orders_lock(orders_mutex_);
+            const OrderRecord* order = orders_.find(order_id);
+            if (!order) {
+                return;
+            }
+            order_info = to_order_state_info(*order);
+        }
+        order_state_callback_(order_info);
+    }
 }
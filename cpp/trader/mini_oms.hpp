@@ -1,20 +1,21 @@
 #pragma once
 #include <memory>
-#include <unordered_map>
 #include <mutex>
 #include <atomic>
 #include <functional>
 #include <vector>
 #include <string>
 #include <iostream>
+#include "../utils/exchange/exchange_symbol_registry.hpp"
 #include "../utils/oms/order_state.hpp"
 #include "../utils/oms/order.hpp"
 #include "../utils/oms/types.hpp"
 #include "../proto/order.pb.h"
 #include "../proto/market_data.pb.h"
+#include "i_order_gateway.hpp"
+#include "order_store.hpp"
 
 // Forward declarations
-class ZmqOMSAdapter;
 class ZmqMDSAdapter;
 class ZmqPMSAdapter;
 
@@ -23,17 +24,29 @@ class ZmqPMSAdapter;
  * 
  * Combines order state tracking, state machine, and ZMQ adapter routing.
  * Provides a complete order management system for the strategy container.
+ *
+ * Orders live in an OrderStore: a fixed slab addressed by OrderId, so
+ * sending, lookup and every state transition are O(1) without touching
+ * the heap. Orders can be sent with the caller's cl_ord_id (the strategy
+ * path) or by place_order(), which generates one from the OrderId into the
+ * order's fixed buffer; it only becomes a std::string for the gateway
+ * call. The OrderStateInfo queries copy and are meant for startup and
+ * tooling; visit_active_orders() reads records in place.
  */
 class MiniOMS {
 public:
     using OrderStateCallback = std::function<void(const OrderStateInfo& order_info)>;
     using OrderEventCallback = std::function<void(const OrderEvent& order_event)>;
     
-    MiniOMS();
+    using OrderId = OrderStore::OrderId;
+    static constexpr OrderId kInvalidOrderId = OrderStore::kInvalidOrderId;
+    
+    // capacity: orders held at once; terminal ones are recycled oldest first
+    explicit MiniOMS(size_t capacity = 4096);
     ~MiniOMS() = default;
     
-    // ZMQ adapter setup
-    void set_oms_adapter(std::shared_ptr<ZmqOMSAdapter> adapter);
+    // ZMQ adapter setup (the OMS side takes any order gateway: ZmqOMSAdapter, or a simulator's)
+    void set_oms_adapter(std::shared_ptr<IOrderGateway> adapter);
     void set_mds_adapter(std::shared_ptr<ZmqMDSAdapter> adapter);
     void set_pms_adapter(std::shared_ptr<ZmqPMSAdapter> adapter);
     
@@ -49,8 +62,23 @@ public:
                    double price = 0.0);
     
     bool cancel_order(const std::string& cl_ord_id);
+    // new_qty is the order's new total size including what has filled (open = new_qty - filled)
     bool modify_order(const std::string& cl_ord_id, double new_price, double new_qty);
     
+    // Same with a generated cl_ord_id; returns kInvalidOrderId if the order was not sent
+    OrderId place_order(const std::string& symbol,
+                        proto::Side side,
+                        proto::OrderType type,
+                        double qty,
+                        double price = 0.0);
+    bool cancel_order(OrderId order_id);
+    bool modify_order(OrderId order_id, double new_price, double new_qty);
+    OrderId find_order_id(const std::string& cl_ord_id) const;
+    
+    // Orders, cancels and modifies between these go to the trading engine as one batch
+    void begin_batch();
+    bool flush_batch();
+    
     // Order state queries
     OrderStateInfo get_order_state(const std::string& cl_ord_id);
     std::vector<OrderStateInfo> get_active_orders();
@@ -58,6 +86,33 @@ public:
     std::vector<OrderStateInfo> get_orders_by_symbol(const std::string& symbol);
     std::vector<OrderStateInfo> get_orders_by_state(OrderState state);
     
+    /**
+     * Calls fn(const OrderRecord&) for each live order of symbol and side,
+     * oldest first, under the OMS lock. fn must not call back into MiniOMS.
+     */
+    template <typename Fn>
+    void visit_active_orders(const std::string& symbol, proto::Side side, Fn&& fn) const {
+        std::lock_guard<std::mutex> lock(orders_mutex_);
+        orders_.for_each_live(orders_.find_instrument(exchange_name_, symbol),
+                              side == proto::BUY ? Side::Buy : Side::Sell, fn);
+    }
+    
+    // Same under the lock, for a single order; false if it is no longer held
+    template <typename Fn>
+    bool visit_order(OrderId order_id, Fn&& fn) const {
+        std::lock_guard<std::mutex> lock(orders_mutex_);
+        const OrderRecord* order = orders_.find(order_id);
+        if (order) {
+            fn(*order);
+        }
+        return order != nullptr;
+    }
+    
+    size_t active_order_count() const {
+        std::lock_guard<std::mutex> lock(orders_mutex_);
+        return orders_.live_count();
+    }
+    
     // Event handling
     void on_order_event(const proto::OrderEvent& order_event);
     void on_trade_execution(const proto::Trade& trade);
@@ -104,11 +159,13 @@ public:
 
 private:
     // Order tracking
-    std::unordered_map<std::string, OrderStateInfo> orders_;
+    OrderStore orders_;
+    // Symbol registry handle per OrderStore instrument, resolved once loaded
+    ExchangeSymbolRegistry::InstrumentHandle registry_handles_[OrderStore::kMaxInstruments];
     mutable std::mutex orders_mutex_;
     
     // ZMQ adapters
-    std::shared_ptr<ZmqOMSAdapter> oms_adapter_;
+    std::shared_ptr<IOrderGateway> oms_adapter_;
     std::shared_ptr<ZmqMDSAdapter> mds_adapter_;
     std::shared_ptr<ZmqPMSAdapter> pms_adapter_;
     
@@ -125,10 +182,17 @@ private:
     OrderEventCallback order_event_callback_;
     
     // Helper methods
-    void update_order_state(const std::string& cl_ord_id, OrderState new_state, 
-                           const std::string& reason = "", double fill_qty = 0.0, 
-                           double fill_price = 0.0);
-    void notify_order_state_change(const OrderStateInfo& order_info);
-    std::string generate_order_id() const;
-    bool is_valid_order_transition(const std::string& cl_ord_id, OrderState new_state);
+    // cl_ord_id: the caller's id, or nullptr to generate one
+    OrderId submit(const std::string* cl_ord_id, const std::string& symbol, proto::Side side,
+                   proto::OrderType type, double qty, double price);
+    // Looked up by cl_ord_id when given, else by order_id
+    bool cancel(const std::string* cl_ord_id, OrderId order_id);
+    bool modify(const std::string* cl_ord_id, OrderId order_id, double new_price, double new_qty);
+    OrderRecord* find_locked(const std::string* cl_ord_id, OrderId order_id);
+    // Applies an exchange event to an order; orders_mutex_ must be held
+    bool apply_state(OrderRecord& order, OrderState new_state, const std::string& reason,
+                     double fill_qty, double fill_price, int64_t now_ns);
+    // orders_mutex_ must be held
+    OrderStateInfo to_order_state_info(const OrderRecord& order) const;
+    void notify_order_state_change(OrderId order_id);
 };
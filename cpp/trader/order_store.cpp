@@ -0,0 +1,263 @@
+#include "order_store.hpp"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+
+OrderStore::OrderStore(size_t capacity) {
+    capacity = capacity == 0 ? 1 : (capacity > kMaxCapacity ? kMaxCapacity : capacity);
+    records_.resize(capacity);
+    generations_.assign(capacity, 1);
+    free_.reserve(capacity);
+    for (size_t slot = capacity; slot-- > 0;) {
+        free_.push_back(static_cast<uint32_t>(slot));
+    }
+    live_head_.assign(kMaxInstruments * 2, kNoSlot);
+    live_tail_.assign(kMaxInstruments * 2, kNoSlot);
+    instruments_.reserve(kMaxInstruments);
+
+    // At most half full, so probes stay short
+    size_t buckets = 16;
+    while (buckets < capacity * 2) {
+        buckets <<= 1;
+    }
+    index_.assign(buckets, kEmpty);
+
+    session_tag_ = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+uint32_t OrderStore::intern_instrument(std::string_view exchange, std::string_view symbol) {
+    uint32_t instrument = find_instrument(exchange, symbol);
+    if (instrument != kNoInstrument || instruments_.size() >= kMaxInstruments) {
+        return instrument;
+    }
+    instruments_.push_back({std::string(exchange), std::string(symbol)});
+    return static_cast<uint32_t>(instruments_.size() - 1);
+}
+
+uint32_t OrderStore::find_instrument(std::string_view exchange, std::string_view symbol) const {
+    for (size_t i = 0; i < instruments_.size(); ++i) {
+        if (instruments_[i].symbol == symbol && instruments_[i].exchange == exchange) {
+            return static_cast<uint32_t>(i);
+        }
+    }
+    return kNoInstrument;
+}
+
+OrderRecord* OrderStore::insert(std::string_view cl_ord_id, uint32_t instrument, Side side, bool is_market,
+                                double qty, double price, int64_t now_ns) {
+    if (instrument >= instruments_.size() || cl_ord_id.size() > OrderRecord::kMaxClOrdIdLength) {
+        return nullptr;
+    }
+    if (!cl_ord_id.empty()) {
+        uint32_t existing = index_find(cl_ord_id);
+        if (existing != kNoSlot) {
+            if (records_[existing].is_live()) {
+                return nullptr;
+            }
+            // A terminal order reusing the id gives up its slot
+            unlink(retired_head_, retired_tail_, existing);
+            records_[existing].occupied_ = false;
+            index_erase(existing);
+            ++generations_[existing];
+            free_.push_back(existing);
+            --size_;
+        }
+    }
+
+    uint32_t slot = take_slot();
+    if (slot == kNoSlot) {
+        return nullptr;
+    }
+
+    OrderRecord& order = records_[slot];
+    order = OrderRecord{};
+    order.id = (generations_[slot] << kSlotBits) | slot;
+    order.instrument = instrument;
+    order.side = side;
+    order.is_market = is_market;
+    order.state = OrderState::PENDING;
+    order.qty = qty;
+    order.price = price;
+    order.created_ns = now_ns;
+    order.updated_ns = now_ns;
+    order.occupied_ = true;
+    if (cl_ord_id.empty()) {
+        order.cl_ord_id_length_ = static_cast<uint8_t>(format_cl_ord_id(order.id, order.cl_ord_id_, sizeof(order.cl_ord_id_)));
+    } else {
+        order.cl_ord_id_length_ = OrderRecord::copy(order.cl_ord_id_, sizeof(order.cl_ord_id_), cl_ord_id);
+    }
+
+    const size_t list = list_of(instrument, side);
+    link(live_head_[list], live_tail_[list], slot);
+    index_insert(slot);
+    ++size_;
+    ++live_count_;
+    return &order;
+}
+
+OrderRecord* OrderStore::find(OrderId id) {
+    uint32_t slot = slot_of(id);
+    if (slot >= records_.size() || !records_[slot].occupied_ || records_[slot].id != id) {
+        return nullptr;
+    }
+    return &records_[slot];
+}
+
+const OrderRecord* OrderStore::find(OrderId id) const {
+    return const_cast<OrderStore*>(this)->find(id);
+}
+
+OrderRecord* OrderStore::find(std::string_view cl_ord_id) {
+    uint32_t slot = index_find(cl_ord_id);
+    return slot != kNoSlot ? &records_[slot] : nullptr;
+}
+
+const OrderRecord* OrderStore::find(std::string_view cl_ord_id) const {
+    return const_cast<OrderStore*>(this)->find(cl_ord_id);
+}
+
+bool OrderStore::transition(OrderRecord& order, OrderState state, int64_t now_ns) {
+    if (!OrderStateMachine::isValidTransition(order.state, state)) {
+        return false;
+    }
+    const bool was_live = order.is_live();
+    order.state = state;
+    order.updated_ns = now_ns;
+    if (was_live && !order.is_live()) {
+        uint32_t slot = slot_of(order.id);
+        const size_t list = list_of(order.instrument, order.side);
+        unlink(live_head_[list], live_tail_[list], slot);
+        link(retired_head_, retired_tail_, slot);
+        --live_count_;
+    }
+    return true;
+}
+
+size_t OrderStore::format_cl_ord_id(OrderId id, char* out, size_t size) const {
+    static constexpr char kDigits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+    // Both parts in base 36, most significant digit first; the tag is fixed width
+    char buffer[32];
+    size_t length = 0;
+    do {
+        buffer[length++] = kDigits[id % 36];
+        id /= 36;
+    } while (id != 0);
+    uint64_t tag = session_tag_;
+    for (int digit = 0; digit < 7; ++digit) {
+        buffer[length++] = kDigits[tag % 36];
+        tag /= 36;
+    }
+    if (size == 0) {
+        return 0;
+    }
+    if (length >= size) {
+        length = size - 1;
+    }
+    for (size_t i = 0; i < length; ++i) {
+        out[i] = buffer[length - 1 - i];
+    }
+    out[length] = '\0';
+    return length;
+}
+
+uint32_t OrderStore::take_slot() {
+    if (!free_.empty()) {
+        uint32_t slot = free_.back();
+        free_.pop_back();
+        return slot;
+    }
+    // Reuse the oldest terminal order
+    uint32_t slot = retired_head_;
+    if (slot == kNoSlot) {
+        return kNoSlot;
+    }
+    unlink(retired_head_, retired_tail_, slot);
+    records_[slot].occupied_ = false;
+    index_erase(slot);
+    ++generations_[slot];
+    --size_;
+    return slot;
+}
+
+void OrderStore::link(uint32_t& head, uint32_t& tail, uint32_t slot) {
+    OrderRecord& order = records_[slot];
+    order.prev_ = tail;
+    order.next_ = kNoSlot;
+    if (tail != kNoSlot) {
+        records_[tail].next_ = slot;
+    } else {
+        head = slot;
+    }
+    tail = slot;
+}
+
+void OrderStore::unlink(uint32_t& head, uint32_t& tail, uint32_t slot) {
+    OrderRecord& order = records_[slot];
+    if (order.prev_ != kNoSlot) {
+        records_[order.prev_].next_ = order.next_;
+    } else {
+        head = order.next_;
+    }
+    if (order.next_ != kNoSlot) {
+        records_[order.next_].prev_ = order.prev_;
+    } else {
+        tail = order.prev_;
+    }
+    order.prev_ = kNoSlot;
+    order.next_ = kNoSlot;
+}
+
+size_t OrderStore::index_bucket(std::string_view cl_ord_id) const {
+    return std::hash<std::string_view>{}(cl_ord_id) & (index_.size() - 1);
+}
+
+uint32_t OrderStore::index_find(std::string_view cl_ord_id) const {
+    const size_t mask = index_.size() - 1;
+    for (size_t bucket = index_bucket(cl_ord_id);; bucket = (bucket + 1) & mask) {
+        uint32_t slot = index_[bucket];
+        if (slot == kEmpty) {
+            return kNoSlot;
+        }
+        if (slot != kTombstone && records_[slot].cl_ord_id() == cl_ord_id) {
+            return slot;
+        }
+    }
+}
+
+void OrderStore::index_insert(uint32_t slot) {
+    const size_t mask = index_.size() - 1;
+    size_t bucket = index_bucket(records_[slot].cl_ord_id());
+    while (index_[bucket] != kEmpty && index_[bucket] != kTombstone) {
+        bucket = (bucket + 1) & mask;
+    }
+    if (index_[bucket] == kTombstone) {
+        --index_tombstones_;
+    }
+    index_[bucket] = slot;
+}
+
+void OrderStore::index_erase(uint32_t slot) {
+    const size_t mask = index_.size() - 1;
+    for (size_t bucket = index_bucket(records_[slot].cl_ord_id()); index_[bucket] != kEmpty;
+         bucket = (bucket + 1) & mask) {
+        if (index_[bucket] == slot) {
+            index_[bucket] = kTombstone;
+            // Tombstones lengthen probes for misses; clear them once they are a quarter of the table
+            if (++index_tombstones_ > index_.size() / 4) {
+                index_rebuild();
+            }
+            return;
+        }
+    }
+}
+
+void OrderStore::index_rebuild() {
+    std::fill(index_.begin(), index_.end(), kEmpty);
+    index_tombstones_ = 0;
+    for (size_t slot = 0; slot < records_.size(); ++slot) {
+        if (records_[slot].occupied_) {
+            index_insert(static_cast<uint32_t>(slot));
+        }
+    }
+}
@@ -0,0 +1,192 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../utils/oms/order_state.hpp"
+#include "../utils/oms/types.hpp"
+
+/**
+ * One order in an OrderStore
+ *
+ * Plain data with fixed-size text fields, so records live in one
+ * preallocated array and are updated in place. Text longer than a field is
+ * truncated, except cl_ord_id, which OrderStore refuses instead.
+ */
+struct OrderRecord {
+    static constexpr size_t kMaxClOrdIdLength = 47;
+    static constexpr size_t kMaxExchangeOrderIdLength = 79;
+    static constexpr size_t kMaxReasonLength = 63;
+
+    uint64_t id{0};                  // OrderStore::OrderId
+    uint32_t instrument{0};          // OrderStore instrument index
+    Side side{Side::Buy};
+    bool is_market{false};
+    OrderState state{OrderState::PENDING};
+    double qty{0.0};
+    double price{0.0};
+    double filled_qty{0.0};
+    double avg_fill_price{0.0};
+    int64_t created_ns{0};           // system_clock
+    int64_t updated_ns{0};
+
+    std::string_view cl_ord_id() const { return {cl_ord_id_, cl_ord_id_length_}; }
+    std::string_view exchange_order_id() const { return {exchange_order_id_, exchange_order_id_length_}; }
+    std::string_view reason() const { return {reason_, reason_length_}; }
+
+    void set_exchange_order_id(std::string_view text) { exchange_order_id_length_ = copy(exchange_order_id_, sizeof(exchange_order_id_), text); }
+    void set_reason(std::string_view text) { reason_length_ = copy(reason_, sizeof(reason_), text); }
+
+    bool is_live() const {
+        return state == OrderState::PENDING || state == OrderState::ACKNOWLEDGED ||
+               state == OrderState::PARTIALLY_FILLED;
+    }
+
+private:
+    friend class OrderStore;
+
+    static uint8_t copy(char* field, size_t size, std::string_view text) {
+        const size_t length = text.size() < size ? text.size() : size - 1;
+        text.copy(field, length);
+        field[length] = '\0';
+        return static_cast<uint8_t>(length);
+    }
+
+    // Live list of (instrument, side), or the retired queue once terminal
+    uint32_t prev_{UINT32_MAX};
+    uint32_t next_{UINT32_MAX};
+    uint8_t cl_ord_id_length_{0};
+    uint8_t exchange_order_id_length_{0};
+    uint8_t reason_length_{0};
+    bool occupied_{false};
+    char cl_ord_id_[kMaxClOrdIdLength + 1]{};
+    char exchange_order_id_[kMaxExchangeOrderIdLength + 1]{};
+    char reason_[kMaxReasonLength + 1]{};
+};
+
+/**
+ * Fixed-capacity order table
+ *
+ * Records sit in a slab sized once at construction. An OrderId packs the
+ * slot (low kSlotBits bits) with a per-slot generation that advances every
+ * time the slot is reused, so a stale id finds nothing instead of a newer
+ * order. Live orders (PENDING, ACKNOWLEDGED, PARTIALLY_FILLED) hang off an
+ * intrusive list per instrument and side, oldest first; terminal ones join
+ * a retired queue and stay readable until their slot is needed again,
+ * oldest first. Lookup by cl_ord_id goes through an open-addressed index
+ * over the slab. Nothing allocates after construction except the first
+ * sighting of an instrument.
+ *
+ * Not thread-safe; MiniOMS guards it with its own mutex.
+ */
+class OrderStore {
+public:
+    using OrderId = uint64_t;
+    static constexpr OrderId kInvalidOrderId = 0;
+    static constexpr uint32_t kNoInstrument = UINT32_MAX;
+    static constexpr size_t kMaxInstruments = 64;
+    static constexpr unsigned kSlotBits = 20;
+    static constexpr size_t kMaxCapacity = size_t(1) << kSlotBits;
+
+    explicit OrderStore(size_t capacity = 4096);
+
+    // Index for exchange:symbol, added on first use; kNoInstrument once kMaxInstruments are taken
+    uint32_t intern_instrument(std::string_view exchange, std::string_view symbol);
+    uint32_t find_instrument(std::string_view exchange, std::string_view symbol) const;
+    const std::string& exchange_of(uint32_t instrument) const { return instruments_[instrument].exchange; }
+    const std::string& symbol_of(uint32_t instrument) const { return instruments_[instrument].symbol; }
+
+    /**
+     * New PENDING order, or nullptr if the id is malformed or belongs to a
+     * live order, or every slot holds a live order. An empty cl_ord_id is
+     * generated from the OrderId (see format_cl_ord_id()); a terminal order
+     * with the same cl_ord_id is dropped.
+     */
+    OrderRecord* insert(std::string_view cl_ord_id, uint32_t instrument, Side side, bool is_market,
+                        double qty, double price, int64_t now_ns);
+
+    OrderRecord* find(OrderId id);
+    const OrderRecord* find(OrderId id) const;
+    OrderRecord* find(std::string_view cl_ord_id);
+    const OrderRecord* find(std::string_view cl_ord_id) const;
+
+    /**
+     * Moves an order to `state` if OrderStateMachine allows it, keeping the
+     * live lists in step. Returns false, changing nothing, otherwise.
+     */
+    bool transition(OrderRecord& order, OrderState state, int64_t now_ns);
+
+    // Live orders of one instrument and side, oldest first; fn must not insert or transition
+    template <typename Fn>
+    void for_each_live(uint32_t instrument, Side side, Fn&& fn) const {
+        if (instrument >= instruments_.size()) {
+            return;
+        }
+        for (uint32_t slot = live_head_[list_of(instrument, side)]; slot != kNoSlot; slot = records_[slot].next_) {
+            fn(static_cast<const OrderRecord&>(records_[slot]));
+        }
+    }
+
+    // Every order still held, live or retired, in slot order
+    template <typename Fn>
+    void for_each(Fn&& fn) const {
+        for (const OrderRecord& record : records_) {
+            if (record.occupied_) {
+                fn(record);
+            }
+        }
+    }
+
+    size_t capacity() const { return records_.size(); }
+    size_t size() const { return size_; }
+    size_t live_count() const { return live_count_; }
+
+    /**
+     * Wire cl_ord_id for a generated order: a 7-digit base-36 session tag
+     * and the base-36 OrderId, e.g. "q8k2m0x1fhsc" - short enough for
+     * std::string's small buffer. The tag is the wall clock in milliseconds
+     * at construction (wrapping every ~2.5 years), so ids do not repeat
+     * across restarts.
+     */
+    size_t format_cl_ord_id(OrderId id, char* out, size_t size) const;
+
+private:
+    static constexpr uint32_t kNoSlot = UINT32_MAX;
+    static constexpr uint32_t kEmpty = UINT32_MAX;
+    static constexpr uint32_t kTombstone = UINT32_MAX - 1;
+
+    struct Instrument {
+        std::string exchange;
+        std::string symbol;
+    };
+
+    static uint32_t slot_of(OrderId id) { return static_cast<uint32_t>(id & (kMaxCapacity - 1)); }
+    static size_t list_of(uint32_t instrument, Side side) { return instrument * 2 + (side == Side::Sell ? 1 : 0); }
+
+    uint32_t take_slot();
+    // Doubly linked through OrderRecord::prev_/next_, appended at the tail
+    void link(uint32_t& head, uint32_t& tail, uint32_t slot);
+    void unlink(uint32_t& head, uint32_t& tail, uint32_t slot);
+
+    // cl_ord_id index
+    size_t index_bucket(std::string_view cl_ord_id) const;
+    uint32_t index_find(std::string_view cl_ord_id) const;
+    void index_insert(uint32_t slot);
+    void index_erase(uint32_t slot);
+    void index_rebuild();
+
+    std::vector<OrderRecord> records_;       // Slab, sized once
+    std::vector<uint64_t> generations_;      // Per slot, starting at 1
+    std::vector<uint32_t> free_;             // Never-used or released slots
+    std::vector<uint32_t> live_head_;        // Per (instrument, side)
+    std::vector<uint32_t> live_tail_;
+    uint32_t retired_head_{kNoSlot};         // Terminal orders, oldest first
+    uint32_t retired_tail_{kNoSlot};
+    std::vector<uint32_t> index_;            // Open addressing, power-of-two size
+    size_t index_tombstones_{0};
+    std::vector<Instrument> instruments_;
+    size_t size_{0};
+    size_t live_count_{0};
+    uint64_t session_tag_{0};
+};
@@ -1,8 +1,10 @@
 #include "strategy_container.hpp"
+#include "zmq_oms_adapter.hpp"
 #include "../strategies/base_strategy/abstract_strategy.hpp"
 #include "../strategies/mm_strategy/market_making_strategy.hpp"
 #include "../utils/logging/log_helper.hpp"
 #include "../utils/constants.hpp"
+#include "../utils/metrics/latency_trace.hpp"
 #include <thread>
 #include <chrono>
 
@@ -19,23 +21,36 @@ StrategyContainer::StrategyContainer() {
 }
 
 StrategyContainer::~StrategyContainer() {
-    // Signal destruction to prevent use-after-free in timeout thread
-    destroyed_.store(true);
+    // No strategy callbacks while the members below go away
+    if (executor_) {
+        executor_->stop();
+    }
     
-    // Wait for timeout thread to complete (with timeout)
-    if (order_state_timeout_thread_ && order_state_timeout_thread_->joinable()) {
-        // Give thread a moment to check destroyed_ flag
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
-        if (order_state_timeout_thread_->joinable()) {
-            order_state_timeout_thread_->join();
+    // Wake the timeout threads and wait for them before the members they read go away
+    {
+        std::lock_guard<std::mutex> lock(timeout_mutex_);
+        destroyed_.store(true);
+    }
+    timeout_cv_.notify_all();
+    for (auto* thread : {&order_state_timeout_thread_, &balance_position_timeout_thread_}) {
+        if (*thread && (*thread)->joinable()) {
+            (*thread)->join();
         }
     }
 }
 
+bool StrategyContainer::wait_unless_destroyed(std::chrono::seconds timeout) {
+    std::unique_lock<std::mutex> lock(timeout_mutex_);
+    return !timeout_cv_.wait_for(lock, timeout, [this]() { return destroyed_.load(); });
+}
+
 // Set the strategy instance
 void StrategyContainer::set_strategy(std::shared_ptr<AbstractStrategy> strategy) {
     strategy_ = strategy;
     // Strategy doesn't know about adapters - it delegates to container
+    if (strategy_ && executor_) {
+        strategy_->set_single_threaded(true);
+    }
     
     // Set order placement callbacks so strategy can send orders
     if (strategy_) {
@@ -57,7 +72,32 @@ void StrategyContainer::set_strategy(std::shared_ptr<AbstractStrategy> strategy)
                                             double new_qty) -> bool {
             return this->modify_order(cl_ord_id, new_price, new_qty);
         });
+        
+        strategy_->set_order_batch_hooks(
+            [this]() { if (mini_oms_) mini_oms_->begin_batch(); },
+            [this]() { if (mini_oms_) mini_oms_->flush_batch(); });
+    }
+}
+
+void StrategyContainer::enable_executor(const StrategyExecutor::Config& config) {
+    if (running_.load()) {
+        LOG_ERROR_COMP("STRATEGY_CONTAINER", "Executor must be enabled before start()");
+        return;
     }
+    executor_ = std::make_unique<StrategyExecutor>(config, [this](StrategyEvent& event) { dispatch(event); });
+    if (strategy_) {
+        strategy_->set_single_threaded(true);
+    }
+    LOG_INFO_COMP("STRATEGY_CONTAINER", "Strategy runs on a single executor thread (core " +
+                  std::to_string(config.cpu_core) + ")");
+}
+
+bool StrategyContainer::post(std::function<void()> task) {
+    if (executor_) {
+        return executor_->post_task(std::move(task));
+    }
+    task();
+    return true;
 }
 
 // IStrategyContainer interface implementation
@@ -71,6 +111,9 @@ void StrategyContainer::start() {
     if (mini_pms_) {
         mini_pms_->start();
     }
+    if (executor_) {
+        executor_->start();
+    }
     
     // Mark that start was requested, but don't start strategy yet
     strategy_start_requested_.store(true);
@@ -114,14 +157,14 @@ void StrategyContainer::start() {
     // set a timeout to mark as queried (assuming no orders exist)
     // This prevents indefinite waiting if trading engine doesn't send events
     // Also set a timeout for balance and position if they don't arrive
-    if (!order_state_queried_.load() && mini_oms_) {
+    if (!order_state_queried_.load() && mini_oms_ && !order_state_timeout_thread_) {
         // Start a background thread to timeout after a few seconds
         // If no order events arrive, assume there are no open orders
         // Store thread as member to ensure proper cleanup
         order_state_timeout_thread_.reset(new std::thread([this]() {
-            std::this_thread::sleep_for(std::chrono::seconds(constants::timeout::ORDER_STATE_TIMEOUT_SECONDS));
-            // Check if object was destroyed before accessing members
-            if (!destroyed_.load() && !order_state_queried_.load()) {
+            // Returns early, without touching the rest, if the container is destroyed
+            if (wait_unless_destroyed(std::chrono::seconds(constants::timeout::ORDER_STATE_TIMEOUT_SECONDS)) &&
+                !order_state_queried_.load()) {
                 logging::Logger logger("STRATEGY_CONTAINER");
                 logger.info("Timeout waiting for order events - assuming no open orders exist");
                 order_state_queried_.store(true);
@@ -132,10 +175,10 @@ void StrategyContainer::start() {
     
     // Set timeout for balance and position if they don't arrive
     // This prevents strategy from never starting if exchange doesn't send updates
-    if ((!balance_received_.load() || !position_received_.load()) && strategy_) {
-        std::thread([this]() {
-            std::this_thread::sleep_for(std::chrono::seconds(constants::timeout::BALANCE_POSITION_TIMEOUT_SECONDS));
-            if (!destroyed_.load() && strategy_start_requested_.load() && !strategy_fully_started_.load()) {
+    if ((!balance_received_.load() || !position_received_.load()) && strategy_ && !balance_position_timeout_thread_) {
+        balance_position_timeout_thread_.reset(new std::thread([this]() {
+            if (wait_unless_destroyed(std::chrono::seconds(constants::timeout::BALANCE_POSITION_TIMEOUT_SECONDS)) &&
+                strategy_start_requested_.load() && !strategy_fully_started_.load()) {
                 logging::Logger logger("STRATEGY_CONTAINER");
                 bool balance_ok = balance_received_.load();
                 bool position_ok = position_received_.load();
@@ -151,12 +194,15 @@ void StrategyContainer::start() {
                 
                 check_and_start_strategy();
             }
-        }).detach();  // This timeout thread is short-lived and safe to detach
+        }));
     }
 }
 
 void StrategyContainer::stop() {
     running_.store(false);
+    if (executor_) {
+        executor_->stop();
+    }
     if (mini_oms_) {
         mini_oms_->stop();
     }
@@ -170,15 +216,81 @@ bool StrategyContainer::is_running() const {
     return running_.load();
 }
 
-// Event handlers - delegate to strategy
+// Event handlers - queue for the executor, or handle on the calling thread
 void StrategyContainer::on_market_data(const proto::OrderBookSnapshot& orderbook) {
+    if (executor_) {
+        executor_->post_market_data(orderbook);
+        return;
+    }
+    handle_market_data(orderbook);
+}
+
+void StrategyContainer::on_order_event(const proto::OrderEvent& order_event) {
+    if (executor_) {
+        executor_->post_order_event(order_event);
+        return;
+    }
+    handle_order_event(order_event);
+}
+
+void StrategyContainer::on_position_update(const proto::PositionUpdate& position) {
+    if (executor_) {
+        executor_->post_position_update(position);
+        return;
+    }
+    handle_position_update(position);
+}
+
+void StrategyContainer::on_trade_execution(const proto::Trade& trade) {
+    if (executor_) {
+        executor_->post_trade(trade);
+        return;
+    }
+    handle_trade_execution(trade);
+}
+
+void StrategyContainer::on_account_balance_update(const proto::AccountBalanceUpdate& balance_update) {
+    if (executor_) {
+        executor_->post_balance_update(balance_update);
+        return;
+    }
+    handle_account_balance_update(balance_update);
+}
+
+void StrategyContainer::dispatch(StrategyEvent& event) {
+    switch (event.type) {
+        case StrategyEvent::Type::MARKET_DATA: {
+            // Orders the strategy sends for this book inherit its trace, as on the adapter thread
+            metrics::LatencyTrace::Scope trace_scope(event.orderbook.has_trace() ? &event.orderbook.trace() : nullptr);
+            handle_market_data(event.orderbook);
+            break;
+        }
+        case StrategyEvent::Type::ORDER_EVENT:
+            handle_order_event(event.order_event);
+            break;
+        case StrategyEvent::Type::POSITION_UPDATE:
+            handle_position_update(event.position);
+            break;
+        case StrategyEvent::Type::TRADE:
+            handle_trade_execution(event.trade);
+            break;
+        case StrategyEvent::Type::BALANCE_UPDATE:
+            handle_account_balance_update(event.balance);
+            break;
+        case StrategyEvent::Type::TASK:
+            break;   // Run by the executor itself
+    }
+}
+
+// Event handling - delegate to strategy
+void StrategyContainer::handle_market_data(const proto::OrderBookSnapshot& orderbook) {
     // Only forward market data if strategy is fully started
     if (strategy_ && strategy_fully_started_.load()) {
         strategy_->on_market_data(orderbook);
     }
 }
 
-void StrategyContainer::on_order_event(const proto::OrderEvent& order_event) {
+void StrategyContainer::handle_order_event(const proto::OrderEvent& order_event) {
     logging::Logger logger("STRATEGY_CONTAINER");
     
     // Update MiniOMS first
@@ -201,7 +313,7 @@ void StrategyContainer::on_order_event(const proto::OrderEvent& order_event) {
     }
 }
 
-void StrategyContainer::on_position_update(const proto::PositionUpdate& position) {
+void StrategyContainer::handle_position_update(const proto::PositionUpdate& position) {
     logging::Logger logger("STRATEGY_CONTAINER");
     
     // Mark that we've received at least one position update
@@ -225,14 +337,14 @@ void StrategyContainer::on_position_update(const proto::PositionUpdate& position
     check_and_start_strategy();
 }
 
-void StrategyContainer::on_trade_execution(const proto::Trade& trade) {
+void StrategyContainer::handle_trade_execution(const proto::Trade& trade) {
     // Only forward trade executions if strategy is fully started
     if (strategy_ && strategy_fully_started_.load()) {
         strategy_->on_trade_execution(trade);
     }
 }
 
-void StrategyContainer::on_account_balance_update(const proto::AccountBalanceUpdate& balance_update) {
+void StrategyContainer::handle_account_balance_update(const proto::AccountBalanceUpdate& balance_update) {
     logging::Logger logger("STRATEGY_CONTAINER");
     
     // Mark that we've received balance update
@@ -285,6 +397,19 @@ const std::string& StrategyContainer::get_name() const {
 // ZMQ adapter setup
 void StrategyContainer::set_oms_adapter(std::shared_ptr<ZmqOMSAdapter> adapter) {
     oms_adapter_ = adapter;
+    // MiniOMS routes the strategy's orders through the adapter
+    set_order_gateway(adapter);
+}
+
+void StrategyContainer::set_order_gateway(std::shared_ptr<IOrderGateway> gateway) {
+    if (mini_oms_) {
+        mini_oms_->set_oms_adapter(std::move(gateway));
+    }
+}
+
+void StrategyContainer::mark_order_state_synced() {
+    order_state_queried_.store(true);
+    check_and_start_strategy();
 }
 
 void StrategyContainer::set_mds_adapter(std::shared_ptr<ZmqMDSAdapter> adapter) {
@@ -353,6 +478,28 @@ std::vector<trader::AccountBalanceInfo> StrategyContainer::get_account_balances_
     return {};
 }
 
+// Order state queries - delegate to MiniOMS
+std::optional<OrderStateInfo> StrategyContainer::get_order_state(const std::string& cl_ord_id) const {
+    if (mini_oms_ && mini_oms_->find_order_id(cl_ord_id) != MiniOMS::kInvalidOrderId) {
+        return mini_oms_->get_order_state(cl_ord_id);
+    }
+    return std::nullopt;
+}
+
+std::vector<OrderStateInfo> StrategyContainer::get_active_orders() const {
+    if (mini_oms_) {
+        return mini_oms_->get_active_orders();
+    }
+    return {};
+}
+
+std::vector<OrderStateInfo> StrategyContainer::get_all_orders() const {
+    if (mini_oms_) {
+        return mini_oms_->get_all_orders();
+    }
+    return {};
+}
+
 // Order placement - delegate to MiniOMS
 bool StrategyContainer::send_order(const std::string& cl_ord_id,
                                   const std::string& symbol,
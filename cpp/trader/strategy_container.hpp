@@ -2,13 +2,18 @@
 #include <memory>
 #include <string>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <thread>
+#include <functional>
 #include "../proto/order.pb.h"
 #include "../proto/market_data.pb.h"
 #include "../proto/position.pb.h"
 #include "../proto/acc_balance.pb.h"
 #include "mini_oms.hpp"
 #include "mini_pms.hpp"
+#include "strategy_executor.hpp"
 
 // Forward declarations
 class AbstractStrategy;
@@ -75,6 +80,33 @@ public:
     // Get the strategy instance (for testing)
     std::shared_ptr<AbstractStrategy> get_strategy() const { return strategy_; }
     
+    /**
+     * Run the strategy on a single executor thread
+     * 
+     * The event handlers then only queue their input; the executor's thread
+     * updates MiniOMS / MiniPMS and calls the strategy, one event at a time
+     * in arrival order, and the strategy's state locks are switched off.
+     * Call before start(); the executor starts and stops with the container.
+     */
+    void enable_executor(const StrategyExecutor::Config& config);
+    const StrategyExecutor* get_executor() const { return executor_.get(); }
+    
+    // Run `task` in order with the strategy's events (at once without an executor)
+    bool post(std::function<void()> task);
+    
+    /**
+     * Route the strategy's orders through `gateway` instead of a ZmqOMSAdapter
+     * (e.g. the backtester's simulated exchange)
+     */
+    void set_order_gateway(std::shared_ptr<IOrderGateway> gateway);
+    
+    /**
+     * Declare the venue's open orders known (none) so the strategy does not wait
+     * for the first order event. Call before start(); for a venue that starts
+     * empty, such as a simulated one.
+     */
+    void mark_order_state_synced();
+    
     // IStrategyContainer interface implementation
     void start() override;
     void stop() override;
@@ -111,6 +143,11 @@ public:
     std::vector<trader::AccountBalanceInfo> get_account_balances_by_exchange(const std::string& exchange) const override;
     std::vector<trader::AccountBalanceInfo> get_account_balances_by_instrument(const std::string& instrument) const override;
     
+    // Order state queries (delegated to MiniOMS)
+    std::optional<OrderStateInfo> get_order_state(const std::string& cl_ord_id) const;
+    std::vector<OrderStateInfo> get_active_orders() const;
+    std::vector<OrderStateInfo> get_all_orders() const;
+    
     // Order placement (delegated to MiniOMS for strategies)
     
     /**
@@ -171,9 +208,26 @@ private:
     std::atomic<bool> strategy_fully_started_{false};  // Track if strategy is fully started
     std::atomic<bool> destroyed_{false};  // Flag to prevent use-after-free in timeout thread
     
-    // Thread for order state timeout
+    // Startup timeout threads, woken early and joined by the destructor
+    std::mutex timeout_mutex_;
+    std::condition_variable timeout_cv_;
     std::unique_ptr<std::thread> order_state_timeout_thread_;
+    std::unique_ptr<std::thread> balance_position_timeout_thread_;
+    
+    // Single strategy thread (enable_executor); declared last so it stops first
+    std::unique_ptr<StrategyExecutor> executor_;
     
     // Helper method to check if ready to start strategy
     void check_and_start_strategy();
+    
+    // Sleep for `timeout`; false if the container is destroyed meanwhile
+    bool wait_unless_destroyed(std::chrono::seconds timeout);
+    
+    // Event handling proper, on the executor's thread when there is one
+    void dispatch(StrategyEvent& event);
+    void handle_market_data(const proto::OrderBookSnapshot& orderbook);
+    void handle_order_event(const proto::OrderEvent& order_event);
+    void handle_position_update(const proto::PositionUpdate& position);
+    void handle_trade_execution(const proto::Trade& trade);
+    void handle_account_balance_update(const proto::AccountBalanceUpdate& balance_update);
 };
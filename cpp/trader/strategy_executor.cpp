@@ -0,0 +1,149 @@
+#include "strategy_executor.hpp"
+#include "../utils/logging/log_helper.hpp"
+#include "../utils/metrics/latency_trace.hpp"
+#include "../utils/app_service/thread_placement.hpp"
+#include <chrono>
+#include <exception>
+
+namespace {
+
+constexpr int kSpinsBeforeYield = 64;
+
+} // namespace
+
+StrategyExecutor::StrategyExecutor(const Config& config, Handler handler)
+    : config_(config),
+      handler_(std::move(handler)),
+      queue_(std::make_unique<MpscRing<StrategyEvent>>(config.queue_capacity, config.wait_strategy)),
+      dropped_counter_(metrics::MetricsCollector::instance().counter("strategy.events_dropped")),
+      queue_delay_histogram_(metrics::MetricsCollector::instance().histogram("strategy.queue_delay_ns")) {
+}
+
+StrategyExecutor::~StrategyExecutor() {
+    stop();
+}
+
+void StrategyExecutor::start() {
+    if (running_.exchange(true)) {
+        return;
+    }
+    thread_ = std::thread([this]() { run(); });
+}
+
+void StrategyExecutor::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    queue_->wake_consumer();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+template <typename Fill>
+bool StrategyExecutor::post(StrategyEvent::Type type, bool may_drop, Fill&& fill) {
+    uint64_t ticket = 0;
+    StrategyEvent* event = queue_->claim(ticket);
+    if (!event && !may_drop && !on_executor_thread()) {
+        // Wait for the strategy thread to free a slot; never for ourselves or a stopped executor
+        statistics_.waited.fetch_add(1, std::memory_order_relaxed);
+        for (int spins = 0; !event && running_.load(std::memory_order_relaxed); ++spins) {
+            if (spins < kSpinsBeforeYield) {
+                RingWaiter::cpu_relax();
+            } else {
+                std::this_thread::yield();
+            }
+            event = queue_->claim(ticket);
+        }
+    }
+    if (!event) {
+        if (statistics_.dropped.fetch_add(1, std::memory_order_relaxed) == 0) {
+            LOG_WARN_COMP("STRATEGY_EXECUTOR", "Strategy queue full (" + std::to_string(queue_->capacity()) +
+                          " events); dropping events");
+        }
+        dropped_counter_.increment();
+        return false;
+    }
+
+    event->type = type;
+    event->sequence = ticket;
+    fill(*event);
+    event->enqueue_ns = metrics::LatencyTrace::now_ns();
+    queue_->publish(ticket);
+    return true;
+}
+
+bool StrategyExecutor::post_market_data(const proto::OrderBookSnapshot& orderbook) {
+    return post(StrategyEvent::Type::MARKET_DATA, true,
+                [&orderbook](StrategyEvent& event) { event.orderbook.CopyFrom(orderbook); });
+}
+
+bool StrategyExecutor::post_order_event(const proto::OrderEvent& order_event) {
+    return post(StrategyEvent::Type::ORDER_EVENT, false,
+                [&order_event](StrategyEvent& event) { event.order_event.CopyFrom(order_event); });
+}
+
+bool StrategyExecutor::post_position_update(const proto::PositionUpdate& position) {
+    return post(StrategyEvent::Type::POSITION_UPDATE, false,
+                [&position](StrategyEvent& event) { event.position.CopyFrom(position); });
+}
+
+bool StrategyExecutor::post_trade(const proto::Trade& trade) {
+    return post(StrategyEvent::Type::TRADE, false,
+                [&trade](StrategyEvent& event) { event.trade.CopyFrom(trade); });
+}
+
+bool StrategyExecutor::post_balance_update(const proto::AccountBalanceUpdate& balance) {
+    return post(StrategyEvent::Type::BALANCE_UPDATE, false,
+                [&balance](StrategyEvent& event) { event.balance.CopyFrom(balance); });
+}
+
+bool StrategyExecutor::post_task(std::function<void()> task) {
+    return post(StrategyEvent::Type::TASK, true,
+                [&task](StrategyEvent& event) { event.task = std::move(task); });
+}
+
+void StrategyExecutor::run() {
+    thread_id_.store(std::this_thread::get_id());
+    app_service::ThreadPlacement::instance().place_current_thread(config_.thread_name, config_.cpu_core);
+    LOG_INFO_COMP("STRATEGY_EXECUTOR", "Strategy thread started (queue: " + std::to_string(queue_->capacity()) +
+                  ", wait: " + wait_strategy_name(config_.wait_strategy) + ")");
+
+    while (running_.load(std::memory_order_relaxed)) {
+        StrategyEvent* event = queue_->wait_front(std::chrono::milliseconds(100));
+        if (!event) continue;
+        process(*event);
+        queue_->pop();
+    }
+
+    uint64_t discarded = 0;
+    while (StrategyEvent* event = queue_->front()) {
+        event->task = nullptr;
+        queue_->pop();
+        ++discarded;
+    }
+    thread_id_.store(std::thread::id());
+    LOG_INFO_COMP("STRATEGY_EXECUTOR", "Strategy thread stopped (" + std::to_string(discarded) + " queued events discarded)");
+}
+
+void StrategyExecutor::process(StrategyEvent& event) {
+    const uint64_t delay_ns = metrics::LatencyTrace::now_ns() - event.enqueue_ns;
+    statistics_.last_queue_delay_ns.store(delay_ns, std::memory_order_relaxed);
+    if (delay_ns > statistics_.max_queue_delay_ns.load(std::memory_order_relaxed)) {
+        statistics_.max_queue_delay_ns.store(delay_ns, std::memory_order_relaxed);
+    }
+    queue_delay_histogram_.record(delay_ns);
+
+    try {
+        if (event.type == StrategyEvent::Type::TASK) {
+            if (event.task) event.task();
+        } else {
+            handler_(event);
+        }
+    } catch (const std::exception& e) {
+        // The strategy thread must outlive a failing callback, or every later event is lost
+        LOG_ERROR_COMP("STRATEGY_EXECUTOR", "Event " + std::to_string(event.sequence) + " failed: " + e.what());
+    }
+    event.task = nullptr;   // Release captures now, not when the slot is reused
+    statistics_.processed.fetch_add(1, std::memory_order_relaxed);
+}
@@ -0,0 +1,118 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include "../proto/order.pb.h"
+#include "../proto/market_data.pb.h"
+#include "../proto/position.pb.h"
+#include "../proto/acc_balance.pb.h"
+#include "../utils/lockfree/mpsc_ring.hpp"
+#include "../utils/metrics/metrics_collector.hpp"
+
+/**
+ * One strategy input, filled in place in the executor's queue
+ *
+ * Only the field matching `type` is meaningful; the others keep their
+ * buffers from earlier events so steady-state copies do not allocate.
+ */
+struct StrategyEvent {
+    enum class Type : uint8_t {
+        MARKET_DATA,
+        ORDER_EVENT,
+        POSITION_UPDATE,
+        TRADE,
+        BALANCE_UPDATE,
+        TASK
+    };
+
+    Type type{Type::TASK};
+    uint64_t sequence{0};      // Arrival order across all producers
+    uint64_t enqueue_ns{0};
+    proto::OrderBookSnapshot orderbook;
+    proto::OrderEvent order_event;
+    proto::PositionUpdate position;
+    proto::Trade trade;
+    proto::AccountBalanceUpdate balance;
+    std::function<void()> task;
+};
+
+/**
+ * Single-threaded, run-to-completion strategy executor
+ *
+ * Adapter threads (market data, order events, positions, balances) post
+ * their inputs into one lock-free multi-producer queue; a single, optionally
+ * pinned thread takes them out in arrival order and runs the handler for
+ * each to completion before starting the next. Strategy state is therefore
+ * only ever touched from one thread, and the order in which a strategy
+ * sees its inputs is fixed by the queue, so a recorded event sequence
+ * replays identically.
+ *
+ * Back-pressure: market data is dropped (and counted) when the queue is
+ * full, since a newer book follows; order events, positions, balances and
+ * trades wait for room instead, as losing one would corrupt state.
+ */
+class StrategyExecutor {
+public:
+    using Handler = std::function<void(StrategyEvent& event)>;
+
+    struct Config {
+        size_t queue_capacity{4096};
+        int cpu_core{-1};                               // Pin the strategy thread; -1 leaves it unpinned ([THREADS] overrides)
+        WaitStrategy wait_strategy{WaitStrategy::FUTEX}; // How the idle strategy thread waits
+        std::string thread_name{"strategy"};
+    };
+
+    struct Statistics {
+        std::atomic<uint64_t> processed{0};
+        std::atomic<uint64_t> dropped{0};            // Market data or tasks refused on a full queue
+        std::atomic<uint64_t> waited{0};             // Posts that had to wait for room
+        std::atomic<uint64_t> last_queue_delay_ns{0};
+        std::atomic<uint64_t> max_queue_delay_ns{0};
+    };
+
+    StrategyExecutor(const Config& config, Handler handler);
+    ~StrategyExecutor();
+
+    // Non-copyable
+    StrategyExecutor(const StrategyExecutor&) = delete;
+    StrategyExecutor& operator=(const StrategyExecutor&) = delete;
+
+    void start();
+    // Joins the strategy thread; events still queued are discarded
+    void stop();
+    bool is_running() const { return running_.load(); }
+
+    // Producers (any thread). Events posted before start() wait in the queue.
+    bool post_market_data(const proto::OrderBookSnapshot& orderbook);
+    bool post_order_event(const proto::OrderEvent& order_event);
+    bool post_position_update(const proto::PositionUpdate& position);
+    bool post_trade(const proto::Trade& trade);
+    bool post_balance_update(const proto::AccountBalanceUpdate& balance);
+    // Run `task` on the strategy thread, in order with the events; dropped when the queue is full
+    bool post_task(std::function<void()> task);
+
+    // True on the strategy thread itself
+    bool on_executor_thread() const { return std::this_thread::get_id() == thread_id_.load(); }
+
+    const Config& get_config() const { return config_; }
+    const Statistics& get_statistics() const { return statistics_; }
+
+private:
+    template <typename Fill>
+    bool post(StrategyEvent::Type type, bool may_drop, Fill&& fill);
+    void run();
+    void process(StrategyEvent& event);
+
+    Config config_;
+    Handler handler_;
+    std::unique_ptr<MpscRing<StrategyEvent>> queue_;
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+    std::atomic<std::thread::id> thread_id_{};
+    Statistics statistics_;
+    metrics::Counter& dropped_counter_;
+    metrics::Histogram& queue_delay_histogram_;
+};
@@ -2,11 +2,16 @@
 #include "../utils/config/process_config_manager.hpp"
 #include "../utils/logging/logger.hpp"
 #include "../utils/constants.hpp"
+#include "../utils/mds/market_data_topics.hpp"
+#include "../utils/app_service/thread_placement.hpp"
+#include <algorithm>
 #include <mutex>
 
 namespace trader {
 
 TraderLib::TraderLib() : running_(false), oms_event_running_(false) {
+    // A strategy can be set before initialize(), which carries it over to the configured container
+    strategy_container_ = std::make_unique<StrategyContainer>();
     logging::Logger logger("TRADER_LIB");
     logger.info("Initializing Trader Library");
 }
@@ -21,6 +26,13 @@ bool TraderLib::initialize(const std::string& config_file) {
     logging::Logger logger("TRADER_LIB");
     logger.info("Initializing with config: " + config_file);
     
+    if (running_.load()) {
+        logger.error("Cannot initialize while running; stop() first");
+        return false;
+    }
+    // A strategy set before a re-initialize is carried over to the new container and adapters
+    std::shared_ptr<AbstractStrategy> strategy = get_strategy();
+    
     // Initialize configuration manager
     config_manager_ = std::make_unique<config::ProcessConfigManager>();
     if (!config_file.empty()) {
@@ -29,10 +41,45 @@ bool TraderLib::initialize(const std::string& config_file) {
             return false;
         }
     }
+    app_service::ThreadPlacement::instance().configure(*config_manager_);
+    app_service::ThreadPlacement::instance().apply_process_settings();
     
     // Create strategy container
     strategy_container_ = std::make_unique<StrategyContainer>();
     
+    // EXECUTION_MODE=executor runs the strategy on one (optionally pinned) thread fed by a lock-free
+    // queue, in arrival order and without strategy locks; inline (default) calls it on the adapter threads
+    std::string execution_mode = config_manager_ ?
+        config_manager_->get_string("STRATEGY", "EXECUTION_MODE", "inline") : "inline";
+    if (execution_mode == "executor") {
+        StrategyExecutor::Config executor_config;
+        executor_config.cpu_core = config_manager_->get_int("STRATEGY", "EXECUTOR_CPU", -1);
+        executor_config.queue_capacity = static_cast<size_t>(
+            std::max(2, config_manager_->get_int("STRATEGY", "EXECUTOR_QUEUE_SIZE", 4096)));
+        executor_config.wait_strategy = parse_wait_strategy(
+            config_manager_->get_string("STRATEGY", "EXECUTOR_WAIT", "futex"));
+        strategy_container_->enable_executor(executor_config);
+    } else if (execution_mode != "inline") {
+        logger.warn("Unknown EXECUTION_MODE '" + execution_mode + "'; using inline");
+    }
+    
+    // EVENT_LOOP=reactor (default) reads the MDS, PMS and OMS sockets on one zmq_poll thread and
+    // dispatches each message as it arrives; EVENT_LOOP=threads keeps a receiving thread per adapter
+    std::string event_loop = config_manager_ ?
+        config_manager_->get_string("SUBSCRIBERS", "EVENT_LOOP", "reactor") : "reactor";
+    if (event_loop != "reactor" && event_loop != "threads") {
+        logger.warn("Unknown EVENT_LOOP '" + event_loop + "'; using reactor");
+    }
+    reactor_.reset();
+    if (event_loop != "threads") {
+        reactor_ = std::make_unique<ZmqReactor>();
+    }
+    
+    // Release adapters from a previous run before their endpoints are bound again
+    oms_adapter_.reset();
+    mds_adapter_.reset();
+    pms_adapter_.reset();
+    
     // Create ZMQ adapters based on configuration
     // Load endpoints from config with sensible defaults
     std::string mds_endpoint = config_manager_ ? 
@@ -47,18 +94,65 @@ bool TraderLib::initialize(const std::string& config_file) {
     std::string oms_subscribe_endpoint = config_manager_ ?
         config_manager_->get_string("SUBSCRIBERS", "TRADING_ENGINE_SUB_ENDPOINT", "tcp://127.0.0.1:5558") :
         "tcp://127.0.0.1:5558";
-    // Create MDS adapter
-    mds_adapter_ = std::make_shared<ZmqMDSAdapter>(mds_endpoint, "market_data", exchange_);
+    // Create MDS adapter, filtered to this instrument when exchange and symbol are known
+    // (market_server multiplexes every venue and symbol on one endpoint)
+    std::string mds_topic = (!exchange_.empty() && !symbol_.empty()) ?
+        md_topics::make_topic(md_topics::ORDERBOOK, exchange_, symbol_) : md_topics::ORDERBOOK;
+    // MD_WIRE_FORMAT=binary asks for fixed-layout books (market_server MD_WIRE_FORMAT=binary|both);
+    // the adapter stays on protobuf until the first binary book arrives.
+    // MD_TRANSPORT=shm reads the same-host shared-memory bus instead (market_server MD_TRANSPORT=shm|both).
+    std::string wire_format = config_manager_ ?
+        config_manager_->get_string("SUBSCRIBERS", "MD_WIRE_FORMAT", "protobuf") : "protobuf";
+    std::string transport = config_manager_ ?
+        config_manager_->get_string("SUBSCRIBERS", "MD_TRANSPORT", "zmq") : "zmq";
+    const bool instrument_known = !exchange_.empty() && !symbol_.empty();
+    ZmqMDSAdapter::Options mds_options;
+    mds_options.reactor = reactor_.get();
+    // MD_CONFLATE=true hands the strategy only the newest book per instrument (skips are counted)
+    mds_options.conflate = config_manager_ && config_manager_->get_bool("SUBSCRIBERS", "MD_CONFLATE", false);
+    if (transport == "shm" && instrument_known) {
+        mds_options.shm_name = config_manager_->get_string("SUBSCRIBERS", "MD_SHM_NAME", shm_md::kDefaultBusName);
+        mds_options.instrument_id = md_binary::InstrumentRegistry::instance().intern(exchange_, symbol_);
+        mds_options.shm_wait = parse_wait_strategy(config_manager_->get_string("SUBSCRIBERS", "MD_SHM_WAIT", "futex"));
+    } else if (transport == "shm") {
+        logger.warn("MD_TRANSPORT=shm needs exchange and symbol; using zmq");
+    } else if (transport != "zmq") {
+        logger.warn("Unknown MD_TRANSPORT '" + transport + "'; using zmq");
+    }
+    if (mds_options.shm_name.empty() && wire_format == "binary") {
+        if (instrument_known) {
+            md_binary::InstrumentRegistry::instance().intern(exchange_, symbol_);
+            mds_options.binary_topic = md_topics::make_topic(md_topics::ORDERBOOK_BINARY, exchange_, symbol_);
+        } else {
+            logger.warn("MD_WIRE_FORMAT=binary needs exchange and symbol; using protobuf");
+        }
+    } else if (wire_format != "binary" && wire_format != "protobuf") {
+        logger.warn("Unknown MD_WIRE_FORMAT '" + wire_format + "'; using protobuf");
+    }
+    mds_adapter_ = std::make_shared<ZmqMDSAdapter>(mds_endpoint, mds_topic, exchange_, mds_options);
     logger.debug("Created MDS adapter for endpoint: " + mds_endpoint);
     
     // Create PMS adapter
-    pms_adapter_ = std::make_shared<ZmqPMSAdapter>(pms_endpoint, "position_updates");
+    pms_adapter_ = std::make_shared<ZmqPMSAdapter>(pms_endpoint, "position_updates", reactor_.get());
     logger.debug("Created PMS adapter for endpoint: " + pms_endpoint);
     
     // Create OMS adapter
     oms_adapter_ = std::make_shared<ZmqOMSAdapter>(oms_publish_endpoint, "orders", oms_subscribe_endpoint, "order_events");
+    strategy_container_->set_oms_adapter(oms_adapter_);
     logger.debug("Created OMS adapter for endpoints: " + oms_publish_endpoint + " / " + oms_subscribe_endpoint);
     
+    if (reactor_) {
+        oms_adapter_->attach(*reactor_);
+        reactor_oms_adapter_ = oms_adapter_;
+        reactor_mds_adapter_ = mds_adapter_;
+        reactor_pms_adapter_ = pms_adapter_;
+        logger.debug("Event loop has " + std::to_string(reactor_->source_count()) + " sources");
+    }
+    
+    needs_initialize_ = false;
+    if (strategy) {
+        set_strategy(strategy);
+    }
     return true;
 }
 
@@ -71,16 +165,31 @@ void TraderLib::start() {
         return;
     }
     
+    // stop() closed the MDS and PMS adapters and dropped the event loop; they only come back with initialize()
+    if (needs_initialize_) {
+        logger.error("Cannot restart after stop() without initialize()");
+        return;
+    }
+    
     // Start strategy container
     if (strategy_container_) {
         strategy_container_->start();
     }
     
-    // Start OMS adapter polling
-    if (oms_adapter_) {
+    if (reactor_) {
+        logger.debug("Starting event loop");
+        reactor_thread_ = std::thread([this]() {
+            app_service::ThreadPlacement::instance().place_current_thread("zmq_reactor");
+            reactor_->run();
+        });
+    }
+    
+    // Poll an OMS adapter the event loop does not serve
+    if (oms_adapter_ && oms_adapter_ != reactor_oms_adapter_) {
         logger.debug("Starting OMS adapter polling");
         oms_event_running_.store(true);
         oms_event_thread_ = std::thread([this]() {
+            app_service::ThreadPlacement::instance().place_current_thread("oms_events");
             logging::Logger thread_logger("TRADER_LIB");
             thread_logger.debug("OMS event polling thread started");
             int poll_count = 0;
@@ -90,7 +199,6 @@ void TraderLib::start() {
                 if (poll_count % constants::polling::OMS_LOG_INTERVAL == 0) {
                     thread_logger.debug("OMS polling count: " + std::to_string(poll_count));
                 }
-                std::this_thread::sleep_for(std::chrono::milliseconds(constants::polling::OMS_EVENT_POLL_INTERVAL_MS));
             }
             thread_logger.debug("OMS event polling thread stopped");
         });
@@ -114,6 +222,17 @@ void TraderLib::stop() {
         strategy_container_->stop();
     }
     
+    // Stop the event loop before the adapters close its sockets
+    if (reactor_thread_.joinable()) {
+        logger.debug("Stopping event loop");
+        reactor_->stop();
+        reactor_thread_.join();
+    }
+    reactor_.reset();
+    reactor_oms_adapter_.reset();
+    reactor_mds_adapter_.reset();
+    reactor_pms_adapter_.reset();
+    
     // Stop OMS event polling thread
     if (oms_event_running_.load()) {
         logger.debug("Stopping OMS event polling");
@@ -135,6 +254,7 @@ void TraderLib::stop() {
         logger.debug("Stopping PMS adapter");
         pms_adapter_->stop();
     }
+    needs_initialize_ = true;
     
     running_.store(false);
     logger.info("Stopped successfully");
@@ -222,6 +342,86 @@ std::shared_ptr<AbstractStrategy> TraderLib::get_strategy() const {
     return strategy_container_->get_strategy();
 }
 
+bool TraderLib::has_strategy() const {
+    return get_strategy() != nullptr;
+}
+
+// Order management - delegate to the strategy container's MiniOMS
+bool TraderLib::send_order(const std::string& cl_ord_id, const std::string& symbol,
+                           proto::Side side, proto::OrderType type, double qty, double price) {
+    if (!strategy_container_ || !strategy_container_->send_order(cl_ord_id, symbol, side, type, qty, price)) {
+        return false;
+    }
+    statistics_.orders_sent.fetch_add(1);
+    return true;
+}
+
+bool TraderLib::cancel_order(const std::string& cl_ord_id) {
+    if (!strategy_container_ || !strategy_container_->cancel_order(cl_ord_id)) {
+        return false;
+    }
+    statistics_.orders_cancelled.fetch_add(1);
+    return true;
+}
+
+bool TraderLib::modify_order(const std::string& cl_ord_id, double new_price, double new_qty) {
+    if (!strategy_container_ || !strategy_container_->modify_order(cl_ord_id, new_price, new_qty)) {
+        return false;
+    }
+    statistics_.orders_modified.fetch_add(1);
+    return true;
+}
+
+// Order state queries
+std::optional<OrderStateInfo> TraderLib::get_order_state(const std::string& cl_ord_id) const {
+    return strategy_container_ ? strategy_container_->get_order_state(cl_ord_id) : std::nullopt;
+}
+
+std::vector<OrderStateInfo> TraderLib::get_active_orders() const {
+    return strategy_container_ ? strategy_container_->get_active_orders() : std::vector<OrderStateInfo>{};
+}
+
+std::vector<OrderStateInfo> TraderLib::get_all_orders() const {
+    return strategy_container_ ? strategy_container_->get_all_orders() : std::vector<OrderStateInfo>{};
+}
+
+// Position queries
+std::optional<PositionInfo> TraderLib::get_position(const std::string& exchange, const std::string& symbol) const {
+    return strategy_container_ ? strategy_container_->get_position(exchange, symbol) : std::nullopt;
+}
+
+std::vector<PositionInfo> TraderLib::get_all_positions() const {
+    return strategy_container_ ? strategy_container_->get_all_positions() : std::vector<PositionInfo>{};
+}
+
+std::vector<PositionInfo> TraderLib::get_positions_by_exchange(const std::string& exchange) const {
+    return strategy_container_ ? strategy_container_->get_positions_by_exchange(exchange) : std::vector<PositionInfo>{};
+}
+
+std::vector<PositionInfo> TraderLib::get_positions_by_symbol(const std::string& symbol) const {
+    return strategy_container_ ? strategy_container_->get_positions_by_symbol(symbol) : std::vector<PositionInfo>{};
+}
+
+// Balance queries
+std::optional<AccountBalanceInfo> TraderLib::get_account_balance(const std::string& exchange,
+                                                                 const std::string& instrument) const {
+    return strategy_container_ ? strategy_container_->get_account_balance(exchange, instrument) : std::nullopt;
+}
+
+std::vector<AccountBalanceInfo> TraderLib::get_all_account_balances() const {
+    return strategy_container_ ? strategy_container_->get_all_account_balances() : std::vector<AccountBalanceInfo>{};
+}
+
+std::vector<AccountBalanceInfo> TraderLib::get_account_balances_by_exchange(const std::string& exchange) const {
+    return strategy_container_ ? strategy_container_->get_account_balances_by_exchange(exchange)
+                               : std::vector<AccountBalanceInfo>{};
+}
+
+std::vector<AccountBalanceInfo> TraderLib::get_account_balances_by_instrument(const std::string& instrument) const {
+    return strategy_container_ ? strategy_container_->get_account_balances_by_instrument(instrument)
+                               : std::vector<AccountBalanceInfo>{};
+}
+
 void TraderLib::handle_order_event(const proto::OrderEvent& order_event) {
     // Invoke callback with mutex protection
     {
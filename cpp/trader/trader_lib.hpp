@@ -16,6 +16,7 @@
 #include "../trader/zmq_pms_adapter.hpp"
 #include "../utils/zmq/zmq_subscriber.hpp"
 #include "../utils/zmq/zmq_publisher.hpp"
+#include "../utils/zmq/zmq_reactor.hpp"
 #include "../utils/config/process_config_manager.hpp"
 
 namespace trader {
@@ -39,7 +40,7 @@ public:
     TraderLib();
     ~TraderLib();
 
-    // Library lifecycle
+    // Library lifecycle; start() after stop() needs initialize() again, which keeps the strategy
     bool initialize(const std::string& config_file = "");
     void start();
     void stop();
@@ -51,7 +52,10 @@ public:
     void set_exchange(const std::string& exchange) { exchange_ = exchange; }
 
     // ZMQ adapter setup
-    void set_oms_adapter(std::shared_ptr<ZmqOMSAdapter> adapter) { oms_adapter_ = adapter; }
+    void set_oms_adapter(std::shared_ptr<ZmqOMSAdapter> adapter) {
+        oms_adapter_ = adapter;
+        if (strategy_container_) strategy_container_->set_oms_adapter(adapter);
+    }
     void set_mds_adapter(std::shared_ptr<ZmqMDSAdapter> adapter) { mds_adapter_ = adapter; }
     void set_pms_adapter(std::shared_ptr<ZmqPMSAdapter> adapter) { pms_adapter_ = adapter; }
 
@@ -169,9 +173,19 @@ private:
     std::shared_ptr<ZmqMDSAdapter> mds_adapter_;
     std::shared_ptr<ZmqPMSAdapter> pms_adapter_;
     
-    // OMS event polling thread
+    // Event loop for the MDS, PMS and OMS sockets ([SUBSCRIBERS] EVENT_LOOP=reactor)
+    std::unique_ptr<ZmqReactor> reactor_;
+    std::thread reactor_thread_;
+    // Adapters registered with reactor_, kept alive while it may dispatch to them
+    std::shared_ptr<ZmqOMSAdapter> reactor_oms_adapter_;
+    std::shared_ptr<ZmqMDSAdapter> reactor_mds_adapter_;
+    std::shared_ptr<ZmqPMSAdapter> reactor_pms_adapter_;
+    
+    // OMS event polling thread (EVENT_LOOP=threads, or an OMS adapter set after initialize)
     std::atomic<bool> oms_event_running_;
     std::thread oms_event_thread_;
+    // Set by stop(): the adapters are closed until initialize() builds new ones
+    bool needs_initialize_{false};
     
     // Strategy
     std::shared_ptr<AbstractStrategy> strategy_;
@@ -11,6 +11,8 @@
 #include "../trader/zmq_mds_adapter.hpp"
 #include "../trader/zmq_pms_adapter.hpp"
 #include "../utils/config/process_config_manager.hpp"
+#include "../utils/metrics/latency_trace.hpp"
+#include "../utils/mds/market_data_topics.hpp"
 #include "../utils/logging/log_helper.hpp"
 
 using namespace trader;
@@ -79,10 +81,17 @@ int main(int argc, char** argv) {
         LOG_INFO_COMP("TRADER", "MDS subscribe endpoint: " + mds_subscribe_endpoint);
         LOG_INFO_COMP("TRADER", "PMS subscribe endpoint: " + pms_subscribe_endpoint);
         
+        if (config_manager->get_bool("METRICS", "LATENCY_TRACE", false)) {
+            metrics::LatencyTrace::set_enabled(true);
+            LOG_INFO_COMP("TRADER", "Tick-to-trade latency tracing enabled");
+        }
+        
         // Initialize ZMQ adapters
         auto oms_adapter = std::make_shared<ZmqOMSAdapter>(oms_publish_endpoint, "orders", oms_subscribe_endpoint, "order_events");
         
-        auto mds_adapter = std::make_shared<ZmqMDSAdapter>(mds_subscribe_endpoint, "market_data", "binance");
+        // Only this instrument's books: market_server multiplexes venues and symbols on one endpoint
+        auto mds_adapter = std::make_shared<ZmqMDSAdapter>(mds_subscribe_endpoint,
+            md_topics::make_topic(md_topics::ORDERBOOK, exchange, symbol), exchange);
         
         auto pms_adapter = std::make_shared<ZmqPMSAdapter>(pms_subscribe_endpoint, "position_updates");
         
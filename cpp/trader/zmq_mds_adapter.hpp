@@ -3,22 +3,106 @@
 #include <string>
 #include <thread>
 #include <atomic>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <memory>
 #include "../utils/mds/market_data.hpp"
+#include "../utils/mds/orderbook_binary.hpp"
+#include "../utils/lockfree/latest_value_slot.hpp"
+#include "../utils/app_service/thread_placement.hpp"
+#include "../utils/shm/shm_md_bus.hpp"
+#include "../utils/zmq/zmq_reactor.hpp"
 #include "../utils/zmq/zmq_subscriber.hpp"
 #include "../utils/logging/log_helper.hpp"
+#include "../utils/metrics/latency_trace.hpp"
+#include "../utils/metrics/metrics_collector.hpp"
 #include "../proto/market_data.pb.h"
 
+/**
+ * Market data consumer for market_server's book channels
+ *
+ * Reads protobuf OrderBookSnapshot payloads from `topic`. When a
+ * `binary_topic` is given it also subscribes there and, on the first valid
+ * md_binary book, drops the protobuf subscription, so a publisher without
+ * binary support keeps working unchanged. Payload format is detected per
+ * message (binary books start with a zero byte, which protobuf never does).
+ *
+ * Binary books are read in place from an aligned receive buffer: on_book
+ * gets the message itself, on_snapshot gets a snapshot reused across ticks.
+ *
+ * With a `shm_name` the adapter reads the same-host shared-memory bus
+ * (shm_md) instead of ZMQ: it follows one instrument's latest-book slot and
+ * the trade ring, waiting per `shm_wait` between updates.
+ *
+ * With `conflate` the receiving thread only stores each book in its
+ * instrument's latest-value slot, and a separate delivery thread runs the
+ * callbacks on the newest book per instrument. A slow strategy then skips
+ * stale books instead of working through a backlog; skipped books and the
+ * age of each book when delivered are counted (ConflationStatistics and
+ * the md.conflation.* metrics).
+ *
+ * With a `reactor` the ZMQ socket is registered there instead of getting
+ * its own receiving thread: books are dispatched on the reactor thread as
+ * soon as they are readable. The reactor must be stopped before stop().
+ *
+ * Threads are placed through ThreadPlacement as `mds` (ZMQ receive),
+ * `mds_shm` (shared-memory reader) and `mds_delivery` (conflated delivery).
+ */
+struct ZmqMDSAdapterOptions {
+  std::string binary_topic;                     // Also accept md_binary books on this topic
+  std::string shm_name;                         // Read this shared-memory bus instead of ZMQ
+  uint32_t instrument_id{0};                    // Instrument to follow on the bus
+  WaitStrategy shm_wait{WaitStrategy::FUTEX};
+  bool conflate{false};                         // Deliver only the newest book per instrument (ZMQ)
+  ZmqReactor* reactor{nullptr};                 // Receive on this event loop instead of a thread (ZMQ)
+};
+
 class ZmqMDSAdapter : public IExchangeMD {
 public:
-  ZmqMDSAdapter(const std::string& endpoint, const std::string& topic, const std::string& exch)
-      : endpoint_(endpoint), topic_(topic), exch_(exch) {
+  using BookCodec = md_binary::DefaultBookCodec;
+  using Instrument = md_binary::InstrumentRegistry::Instrument;
+  using Options = ZmqMDSAdapterOptions;
+
+  static constexpr size_t kMaxConflatedInstruments = 64;
+  // Messages read per reactor dispatch before other sockets get a turn
+  static constexpr int kReactorBurst = 64;
+
+  struct ConflationStatistics {
+    std::atomic<uint64_t> received{0};      // Books stored in the slots
+    std::atomic<uint64_t> delivered{0};     // Books handed to the callbacks
+    std::atomic<uint64_t> skipped{0};       // Replaced before delivery
+    std::atomic<uint64_t> dropped{0};       // No slot left for the instrument
+    std::atomic<uint64_t> last_age_ns{0};   // Receive-to-delivery time of the last book
+    std::atomic<uint64_t> max_age_ns{0};
+  };
+
+  ZmqMDSAdapter(const std::string& endpoint, const std::string& topic, const std::string& exch,
+                const Options& options = Options())
+      : endpoint_(endpoint), topic_(topic), exch_(exch), options_(options),
+        conflate_(options.conflate && options.shm_name.empty()),
+        buffer_(std::make_unique<ReceiveBuffer>()) {
+    if (conflate_) {
+      skipped_counter_ = &metrics::MetricsCollector::instance().counter("md.conflation.skipped");
+      age_histogram_ = &metrics::MetricsCollector::instance().histogram("md.conflation.book_age_ns");
+    }
     running_.store(true);
-    worker_ = std::thread([this]() { this->run(); });
+    if (options_.reactor && options_.shm_name.empty()) {
+      open_subscriber();
+      options_.reactor->add_socket(subscriber_->socket_handle(), [this]() { this->on_readable(); });
+    } else {
+      worker_ = std::thread([this]() { this->run(); });
+    }
+    if (conflate_) {
+      delivery_ = std::thread([this]() { this->run_delivery(); });
+    }
   }
 
   ~ZmqMDSAdapter() {
     running_.store(false);
     if (worker_.joinable()) worker_.join();
+    if (delivery_.joinable()) delivery_.join();
   }
 
   void subscribe(const std::string& symbol) override {
@@ -34,6 +118,10 @@ public:
       worker_.join();
       LOG_INFO_COMP("MDS_ADAPTER", "MDS adapter thread joined");
     }
+    if (delivery_.joinable()) {
+      delivery_waiter_.notify();
+      delivery_.join();
+    }
     
     // Now safe to destroy subscriber after thread has exited
     if (subscriber_) {
@@ -42,44 +130,315 @@ public:
     }
   }
 
+  // True once binary books are arriving and the protobuf subscription is dropped
+  bool binary_active() const { return binary_active_.load(std::memory_order_relaxed); }
+
+  const ConflationStatistics& get_conflation_statistics() const { return conflation_stats_; }
+
   std::function<void(const proto::OrderBookSnapshot&)> on_snapshot;
+  // Binary books only; the message is valid for the duration of the call
+  std::function<void(const md_binary::DefaultBookMessage&, const Instrument&)> on_book;
+  // Shared-memory bus only: trades of the followed instrument
+  std::function<void(const shm_md::TradeRecord&, const Instrument&)> on_trade;
 
 private:
-  void run() {
+  static constexpr size_t kReceiveCapacity = 64 * 1024;
+
+  struct alignas(md_binary::kCacheLineSize) ReceiveBuffer {
+    unsigned char data[kReceiveCapacity];
+  };
+
+  // One conflated book: either a binary message or a parsed protobuf snapshot
+  struct ConflatedBook {
+    md_binary::DefaultBookMessage book;
+    proto::OrderBookSnapshot snapshot;
+    bool binary{false};
+    uint64_t received_ns{0};
+  };
+
+  struct InstrumentSlot {
+    uint32_t instrument_id{0};
+    LatestValueSlot<ConflatedBook> latest;
+  };
+
+  void open_subscriber() {
     subscriber_ = std::make_unique<ZmqSubscriber>(endpoint_, topic_);
-    LOG_INFO_COMP("MDS_ADAPTER", "Starting to listen on " + endpoint_ + " topic: " + topic_);
-    
+    if (!options_.binary_topic.empty()) {
+      subscriber_->subscribe(options_.binary_topic);
+    }
+    LOG_INFO_COMP("MDS_ADAPTER", "Starting to listen on " + endpoint_ + " topic: " + topic_ +
+                  (options_.binary_topic.empty() ? "" : " binary topic: " + options_.binary_topic));
+  }
+
+  void run() {
+    if (!options_.shm_name.empty()) {
+      app_service::ThreadPlacement::instance().place_current_thread("mds_shm");
+      run_shared_memory();
+      return;
+    }
+
+    app_service::ThreadPlacement::instance().place_current_thread("mds");
+    open_subscriber();
     while (running_.load()) {
       // Use blocking receive with timeout so thread can check running_ flag
-      auto msg = subscriber_->receive_blocking(100); // 100ms timeout
-      if (!msg) continue;
-      
-      LOG_INFO_COMP("MDS_ADAPTER", "Received message of size: " + std::to_string(msg->size()) + " bytes");
-      
-      // Deserialize protobuf OrderBookSnapshot
-      proto::OrderBookSnapshot proto_orderbook;
-      if (!proto_orderbook.ParseFromString(*msg)) {
-        LOG_ERROR_COMP("MDS_ADAPTER", "Failed to parse protobuf message");
+      size_t size = 0;
+      if (!subscriber_->receive_into(buffer_->data, kReceiveCapacity, size, 100)) continue; // 100ms timeout
+      process_message(size);
+    }
+  }
+
+  // Reactor thread: the socket is readable, take what is queued without blocking
+  void on_readable() {
+    size_t size = 0;
+    for (int i = 0; i < kReactorBurst && subscriber_->receive_into(buffer_->data, kReceiveCapacity, size, 0); ++i) {
+      process_message(size);
+    }
+  }
+
+  void process_message(size_t size) {
+    if (size > kReceiveCapacity) {
+      LOG_ERROR_COMP("MDS_ADAPTER", "Dropping oversized message of " + std::to_string(size) + " bytes");
+      return;
+    }
+
+    if (const md_binary::DefaultBookMessage* book = BookCodec::view(buffer_->data, size)) {
+      activate_binary();
+      if (conflate_) {
+        stash_binary(*book);
+      } else {
+        handle_book(*book);
+      }
+      return;
+    }
+
+    // Until binary books arrive the protobuf channel is authoritative
+    if (!receive_snapshot_.ParseFromArray(buffer_->data, static_cast<int>(size))) {
+      LOG_ERROR_COMP("MDS_ADAPTER", "Failed to parse protobuf message");
+      return;
+    }
+    
+    LOG_DEBUG_COMP("MDS_ADAPTER", "Parsed protobuf: " + receive_snapshot_.symbol() +
+                   " bids: " + std::to_string(receive_snapshot_.bids_size()) +
+                   " asks: " + std::to_string(receive_snapshot_.asks_size()));
+    if (conflate_) {
+      stash_snapshot();
+    } else {
+      deliver_snapshot(receive_snapshot_);
+    }
+  }
+
+  // Receiving thread: binary books flow, so the protobuf copies of the same books are redundant
+  void activate_binary() {
+    if (binary_active_.load(std::memory_order_relaxed)) return;
+    if (subscriber_) {
+      subscriber_->unsubscribe(topic_);
+      LOG_INFO_COMP("MDS_ADAPTER", "Binary book format active, unsubscribed from " + topic_);
+    }
+    binary_active_.store(true, std::memory_order_relaxed);
+  }
+
+  // ---- Conflation (receiving thread -> delivery thread) -----------------
+
+  // Receiving thread only creates slots; the delivery thread sees the first slot_count_ of them
+  InstrumentSlot* conflation_slot(uint32_t instrument_id) {
+    const size_t count = slot_count_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < count; ++i) {
+      if (slots_[i]->instrument_id == instrument_id) return slots_[i].get();
+    }
+    if (count == kMaxConflatedInstruments) return nullptr;
+    slots_[count] = std::make_unique<InstrumentSlot>();
+    slots_[count]->instrument_id = instrument_id;
+    slot_count_.store(count + 1, std::memory_order_release);
+    return slots_[count].get();
+  }
+
+  template <typename Fill>
+  void stash(uint32_t instrument_id, Fill&& fill) {
+    InstrumentSlot* slot = conflation_slot(instrument_id);
+    if (!slot) {
+      if (conflation_stats_.dropped.fetch_add(1, std::memory_order_relaxed) == 0) {
+        LOG_ERROR_COMP("MDS_ADAPTER", "More than " + std::to_string(kMaxConflatedInstruments) +
+                       " instruments on one adapter; dropping books of the rest");
+      }
+      return;
+    }
+    ConflatedBook& entry = slot->latest.back();
+    fill(entry);
+    entry.received_ns = metrics::LatencyTrace::now_ns();
+    conflation_stats_.received.fetch_add(1, std::memory_order_relaxed);
+    if (slot->latest.publish()) {
+      conflation_stats_.skipped.fetch_add(1, std::memory_order_relaxed);
+      skipped_counter_->increment();
+    }
+    delivery_waiter_.notify();
+  }
+
+  void stash_binary(const md_binary::DefaultBookMessage& book) {
+    stash(book.instrument_id, [&book](ConflatedBook& entry) {
+      std::memcpy(static_cast<void*>(&entry.book), &book, sizeof(book));
+      entry.binary = true;
+    });
+  }
+
+  void stash_snapshot() {
+    const uint32_t id = md_binary::InstrumentRegistry::make_id(receive_snapshot_.exch(), receive_snapshot_.symbol());
+    stash(id, [this](ConflatedBook& entry) {
+      entry.snapshot.Swap(&receive_snapshot_);   // Slot keeps its buffers, receiver gets the old ones
+      entry.binary = false;
+    });
+  }
+
+  bool any_fresh() const {
+    const size_t count = slot_count_.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; ++i) {
+      if (slots_[i]->latest.has_fresh()) return true;
+    }
+    return false;
+  }
+
+  void run_delivery() {
+    app_service::ThreadPlacement::instance().place_current_thread("mds_delivery");
+    LOG_INFO_COMP("MDS_ADAPTER", "Conflated delivery thread started");
+    while (running_.load()) {
+      if (!delivery_waiter_.wait([this]() { return any_fresh(); }, std::chrono::milliseconds(100))) continue;
+
+      const size_t count = slot_count_.load(std::memory_order_acquire);
+      for (size_t i = 0; i < count; ++i) {
+        ConflatedBook* entry = slots_[i]->latest.consume();
+        if (!entry) continue;
+
+        const uint64_t age_ns = metrics::LatencyTrace::now_ns() - entry->received_ns;
+        conflation_stats_.last_age_ns.store(age_ns, std::memory_order_relaxed);
+        if (age_ns > conflation_stats_.max_age_ns.load(std::memory_order_relaxed)) {
+          conflation_stats_.max_age_ns.store(age_ns, std::memory_order_relaxed);
+        }
+        age_histogram_->record(age_ns);
+        conflation_stats_.delivered.fetch_add(1, std::memory_order_relaxed);
+
+        if (entry->binary) {
+          handle_book(entry->book);
+        } else {
+          deliver_snapshot(entry->snapshot);
+        }
+      }
+    }
+  }
+
+  void run_shared_memory() {
+    // market_server creates the segment; wait for it rather than failing the trader
+    std::unique_ptr<shm_md::ShmMdSubscriber> bus;
+    bool warned = false;
+    while (running_.load()) {
+      try {
+        bus = std::make_unique<shm_md::ShmMdSubscriber>(options_.shm_name);
+      } catch (const std::exception& e) {
+        if (!warned) {
+          LOG_WARN_COMP("MDS_ADAPTER", std::string("Waiting for shared-memory bus: ") + e.what());
+          warned = true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
         continue;
       }
-      
-      std::string log_msg = "Parsed protobuf: " + proto_orderbook.symbol() + 
-                            " bids: " + std::to_string(proto_orderbook.bids_size()) + 
-                            " asks: " + std::to_string(proto_orderbook.asks_size());
-      LOG_DEBUG_COMP("MDS_ADAPTER", log_msg);
-      
-      if (on_snapshot) {
-        LOG_DEBUG_COMP("MDS_ADAPTER", "Calling on_snapshot callback");
-        on_snapshot(proto_orderbook);
+      LOG_INFO_COMP("MDS_ADAPTER", "Reading shared-memory bus " + options_.shm_name + " (wait: " +
+                    wait_strategy_name(options_.shm_wait) + ")");
+      read_shared_memory(*bus);
+      bus.reset();
+      warned = false;
+    }
+  }
+
+  // Returns on stop, or when market_server replaced the segment (different layout)
+  void read_shared_memory(shm_md::ShmMdSubscriber& bus) {
+    auto book = std::make_unique<md_binary::DefaultBookMessage>();
+    shm_md::TradeRecord trade;
+    uint64_t version = 0;
+    uint32_t epoch = bus.current_epoch();
+    while (running_.load()) {
+      if (bus.read_book(options_.instrument_id, *book, version)) {
+        activate_binary();
+        handle_book(*book);
+      }
+      while (bus.next_trade(trade)) {
+        if (on_trade && trade.instrument_id == options_.instrument_id && last_instrument_) {
+          on_trade(trade, *last_instrument_);
+        }
+      }
+      // Epoch was taken before the reads above, so an update in between returns at once
+      if (!bus.wait(epoch, options_.shm_wait, std::chrono::milliseconds(100)) && bus.is_replaced()) {
+        LOG_WARN_COMP("MDS_ADAPTER", "Shared-memory bus " + options_.shm_name + " was replaced, reopening");
+        return;
       }
     }
   }
 
+  void handle_book(const md_binary::DefaultBookMessage& book) {
+    const Instrument* instrument = last_instrument_;
+    if (!instrument || instrument->id != book.instrument_id) {
+      instrument = md_binary::InstrumentRegistry::instance().find(book.instrument_id);
+      if (!instrument) {
+        LOG_ERROR_COMP("MDS_ADAPTER", "Dropping book for unknown instrument id " + std::to_string(book.instrument_id));
+        return;
+      }
+      last_instrument_ = instrument;
+    }
+
+    // Conflation (here or in the shared-memory slot) skips books on purpose
+    const bool conflated = conflate_ || !options_.shm_name.empty();
+    if (!conflated && book.instrument_id == last_book_id_ && book.sequence != last_sequence_ + 1) {
+      LOG_WARN_COMP("MDS_ADAPTER", "Book sequence gap on " + instrument->symbol + ": " +
+                    std::to_string(last_sequence_) + " -> " + std::to_string(book.sequence));
+    }
+    last_book_id_ = book.instrument_id;
+    last_sequence_ = book.sequence;
+
+    if (on_book) {
+      on_book(book, *instrument);
+    }
+    if (on_snapshot) {
+      BookCodec::decode(book, instrument->exchange, instrument->symbol, snapshot_);
+      deliver_snapshot(snapshot_);
+    }
+  }
+
+  void deliver_snapshot(proto::OrderBookSnapshot& snapshot) {
+    // Orders the strategy sends from this callback inherit the snapshot's trace
+    const proto::TraceContext* trace = nullptr;
+    if (snapshot.has_trace() && metrics::LatencyTrace::enabled()) {
+      proto::TraceContext* stamped = snapshot.mutable_trace();
+      stamped->set_trader_recv_ns(metrics::LatencyTrace::now_ns());
+      metrics::LatencyTrace::record(metrics::LatencyTrace::MD_TRANSIT, stamped->md_publish_ns(), stamped->trader_recv_ns());
+      trace = stamped;
+    }
+    metrics::LatencyTrace::Scope trace_scope(trace);
+    
+    if (on_snapshot) {
+      on_snapshot(snapshot);
+    }
+  }
 
   std::string endpoint_;
   std::string topic_;
   std::string exch_;
+  Options options_;
+  const bool conflate_;
   std::atomic<bool> running_{false};
+  std::atomic<bool> binary_active_{false};
   std::thread worker_;
+  std::thread delivery_;
   std::unique_ptr<ZmqSubscriber> subscriber_;
+  // Receiving-thread state, reused across messages
+  std::unique_ptr<ReceiveBuffer> buffer_;
+  proto::OrderBookSnapshot receive_snapshot_;
+  // Conflation slots, filled by the receiving thread and drained by the delivery thread
+  std::unique_ptr<InstrumentSlot> slots_[kMaxConflatedInstruments];
+  std::atomic<size_t> slot_count_{0};
+  RingWaiter delivery_waiter_{WaitStrategy::FUTEX};
+  ConflationStatistics conflation_stats_;
+  metrics::Counter* skipped_counter_{nullptr};
+  metrics::Histogram* age_histogram_{nullptr};
+  // Delivering-thread state (the receiving thread when not conflating)
+  proto::OrderBookSnapshot snapshot_;
+  const Instrument* last_instrument_{nullptr};
+  uint32_t last_book_id_{0};
+  uint64_t last_sequence_{0};
 };
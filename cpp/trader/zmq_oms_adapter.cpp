@@ -1,15 +1,22 @@
 #include "zmq_oms_adapter.hpp"
 #include "../utils/logging/log_helper.hpp"
-#ifdef PROTO_ENABLED
-#include "../proto/order.pb.h"
-#endif
+#include "../utils/metrics/latency_trace.hpp"
+#include <chrono>
+
+namespace {
+
+uint64_t now_us() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
 
 ZmqOMSAdapter::ZmqOMSAdapter(const std::string& order_pub_endpoint,
                const std::string& order_topic,
                const std::string& event_sub_endpoint,
                const std::string& event_topic)
-    : order_topic_(order_topic), event_topic_(event_topic),
-      cancel_topic_("cancel_orders"), modify_topic_("modify_orders") {
+    : order_topic_(order_topic), event_topic_(event_topic) {
   order_publisher_ = std::make_unique<ZmqPublisher>(order_pub_endpoint);
   event_subscriber_ = std::make_unique<ZmqSubscriber>(event_sub_endpoint, event_topic);
   LOG_INFO_COMP("ZmqOMSAdapter", "Created OMS adapter - subscribing to: " + event_sub_endpoint + 
@@ -26,6 +33,9 @@ bool ZmqOMSAdapter::send_order(const std::string& cl_ord_id,
                        double qty,
                        double price) {
 #ifdef PROTO_ENABLED
+  const proto::TraceContext* md_trace = metrics::LatencyTrace::enabled() ? metrics::LatencyTrace::current() : nullptr;
+  uint64_t decision_ns = md_trace ? metrics::LatencyTrace::now_ns() : 0;
+  
   proto::OrderRequest req;
   req.set_cl_ord_id(cl_ord_id);
   req.set_exch(exch);
@@ -34,9 +44,17 @@ bool ZmqOMSAdapter::send_order(const std::string& cl_ord_id,
   req.set_type(is_market ? proto::MARKET : proto::LIMIT);
   req.set_qty(qty);
   req.set_price(price);
-  std::string payload;
-  req.SerializeToString(&payload);
-  return order_publisher_->publish(order_topic_, payload);
+  if (md_trace) {
+    proto::TraceContext* trace = req.mutable_trace();
+    *trace = *md_trace;
+    trace->set_decision_ns(decision_ns);
+    trace->set_order_send_ns(metrics::LatencyTrace::now_ns());
+    metrics::LatencyTrace::record(metrics::LatencyTrace::STRATEGY, trace->trader_recv_ns(), decision_ns);
+    metrics::LatencyTrace::record(metrics::LatencyTrace::ORDER_ENCODE, decision_ns, trace->order_send_ns());
+    metrics::LatencyTrace::record(metrics::LatencyTrace::TICK_TO_ORDER, trace->md_recv_ns(), trace->order_send_ns());
+  }
+  req.set_timestamp_us(now_us());
+  return submit_action(proto::NEW_ORDER, req);
 #else
   char buffer[OrderBinaryHelper::ORDER_SIZE];
   OrderBinaryHelper::serialize_order(cl_ord_id, exch, symbol, side, is_market, qty, price, buffer);
@@ -45,36 +63,22 @@ bool ZmqOMSAdapter::send_order(const std::string& cl_ord_id,
 }
 
 bool ZmqOMSAdapter::cancel_order(const std::string& cl_ord_id,
-                          const std::string& exch) {
+                          const std::string& exch,
+                          const std::string& symbol) {
 #ifdef PROTO_ENABLED
-  // Create cancel request message
   proto::OrderRequest cancel_req;
   cancel_req.set_cl_ord_id(cl_ord_id);
   cancel_req.set_exch(exch);
-  // Use a special symbol to indicate cancel request
-  cancel_req.set_symbol("__CANCEL__");
-  cancel_req.set_side(proto::BUY); // Dummy value
-  cancel_req.set_type(proto::LIMIT); // Dummy value
-  cancel_req.set_qty(0.0); // Zero quantity indicates cancel
-  cancel_req.set_price(0.0);
-  cancel_req.set_timestamp_us(std::chrono::duration_cast<std::chrono::microseconds>(
-      std::chrono::system_clock::now().time_since_epoch()).count());
+  cancel_req.set_symbol(symbol);
+  cancel_req.set_timestamp_us(now_us());
   
-  std::string payload;
-  if (cancel_req.SerializeToString(&payload)) {
-    // Publish to order_topic_ instead of cancel_topic_ so TradingEngine can process it
-    // TradingEngineLib::handle_order_request() checks for "__CANCEL__" symbol
-    bool success = order_publisher_->publish(order_topic_, payload);
-    if (success) {
-      LOG_DEBUG_COMP("ZmqOMSAdapter", "Cancel order request sent: " + cl_ord_id + " on " + exch);
-    } else {
-      LOG_ERROR_COMP("ZmqOMSAdapter", "Failed to publish cancel order: " + cl_ord_id);
-    }
-    return success;
+  bool success = submit_action(proto::CANCEL_ORDER, cancel_req);
+  if (success) {
+    LOG_DEBUG_COMP("ZmqOMSAdapter", "Cancel order request sent: " + cl_ord_id + " on " + exch);
   } else {
-    LOG_ERROR_COMP("ZmqOMSAdapter", "Failed to serialize cancel order request");
-    return false;
+    LOG_ERROR_COMP("ZmqOMSAdapter", "Failed to publish cancel order: " + cl_ord_id);
   }
+  return success;
 #else
   // Binary format - create cancel message
   // For binary format, we'd need to extend OrderBinaryHelper
@@ -85,45 +89,100 @@ bool ZmqOMSAdapter::cancel_order(const std::string& cl_ord_id,
 
 bool ZmqOMSAdapter::modify_order(const std::string& cl_ord_id,
                                   const std::string& exch,
+                                  uint32_t side,
                                   double new_price,
-                                  double new_qty) {
+                                  double new_qty,
+                                  const std::string& symbol) {
 #ifdef PROTO_ENABLED
-  // Create modify request message
   proto::OrderRequest modify_req;
   modify_req.set_cl_ord_id(cl_ord_id);
   modify_req.set_exch(exch);
-  // Use a special symbol to indicate modify request
-  modify_req.set_symbol("__MODIFY__");
-  modify_req.set_side(proto::BUY); // Dummy value
+  modify_req.set_symbol(symbol);
+  modify_req.set_side(side == 0 ? proto::BUY : proto::SELL);
   modify_req.set_type(proto::LIMIT);
   modify_req.set_qty(new_qty);
   modify_req.set_price(new_price);
-  modify_req.set_timestamp_us(std::chrono::duration_cast<std::chrono::microseconds>(
-      std::chrono::system_clock::now().time_since_epoch()).count());
+  modify_req.set_timestamp_us(now_us());
   
-  std::string payload;
-  if (modify_req.SerializeToString(&payload)) {
-    // Publish to order_topic_ instead of modify_topic_ so TradingEngine can process it
-    // TradingEngineLib::handle_order_request() checks for "__MODIFY__" symbol
-    bool success = order_publisher_->publish(order_topic_, payload);
-    if (success) {
-      LOG_DEBUG_COMP("ZmqOMSAdapter", "Modify order request sent: " + cl_ord_id + 
-                    " new_price=" + std::to_string(new_price) + 
-                    " new_qty=" + std::to_string(new_qty));
-    } else {
-      LOG_ERROR_COMP("ZmqOMSAdapter", "Failed to publish modify order: " + cl_ord_id);
-    }
-    return success;
+  bool success = submit_action(proto::REPLACE_ORDER, modify_req);
+  if (success) {
+    LOG_DEBUG_COMP("ZmqOMSAdapter", "Modify order request sent: " + cl_ord_id + 
+                  " new_price=" + std::to_string(new_price) + 
+                  " new_qty=" + std::to_string(new_qty));
   } else {
-    LOG_ERROR_COMP("ZmqOMSAdapter", "Failed to serialize modify order request");
-    return false;
+    LOG_ERROR_COMP("ZmqOMSAdapter", "Failed to publish modify order: " + cl_ord_id);
   }
+  return success;
 #else
   LOG_WARN_COMP("ZmqOMSAdapter", "Modify order not fully implemented for binary format");
   return false;
 #endif
 }
 
+void ZmqOMSAdapter::begin_batch() {
+  std::lock_guard<std::mutex> lock(batch_mutex_);
+  if (batch_depth_ == 0) {
+    batch_owner_ = std::this_thread::get_id();
+    pending_batch_.Clear();
+  } else if (batch_owner_ != std::this_thread::get_id()) {
+    return;  // Another thread's batch is open; this thread's calls go out unbatched
+  }
+  ++batch_depth_;
+}
+
+bool ZmqOMSAdapter::flush_batch() {
+#ifdef PROTO_ENABLED
+  std::lock_guard<std::mutex> lock(batch_mutex_);
+  if (batch_depth_ == 0 || batch_owner_ != std::this_thread::get_id() || --batch_depth_ > 0) {
+    return true;
+  }
+  if (pending_batch_.actions_size() == 0) {
+    return true;
+  }
+  size_t actions = static_cast<size_t>(pending_batch_.actions_size());
+  bool success = publish_batch(pending_batch_);
+  if (success) {
+    LOG_DEBUG_COMP("ZmqOMSAdapter", "Order batch sent: " + std::to_string(actions) + " actions");
+  } else {
+    LOG_ERROR_COMP("ZmqOMSAdapter", "Failed to publish order batch of " + std::to_string(actions) + " actions");
+  }
+  pending_batch_.Clear();
+  return success;
+#else
+  return true;
+#endif
+}
+
+#ifdef PROTO_ENABLED
+bool ZmqOMSAdapter::submit_action(proto::OrderActionType action_type, proto::OrderRequest& order) {
+  {
+    std::lock_guard<std::mutex> lock(batch_mutex_);
+    if (batch_depth_ > 0 && batch_owner_ == std::this_thread::get_id()) {
+      proto::OrderAction* action = pending_batch_.add_actions();
+      action->set_action(action_type);
+      action->mutable_order()->Swap(&order);
+      return true;
+    }
+  }
+  
+  proto::OrderBatchRequest batch;
+  proto::OrderAction* action = batch.add_actions();
+  action->set_action(action_type);
+  action->mutable_order()->Swap(&order);
+  return publish_batch(batch);
+}
+
+bool ZmqOMSAdapter::publish_batch(proto::OrderBatchRequest& batch) {
+  batch.set_timestamp_us(now_us());
+  std::string payload;
+  if (!batch.SerializeToString(&payload)) {
+    LOG_ERROR_COMP("ZmqOMSAdapter", "Failed to serialize order batch");
+    return false;
+  }
+  return order_publisher_->publish(order_topic_, payload);
+}
+#endif
+
 void ZmqOMSAdapter::poll_events() {
   auto msg = event_subscriber_->receive_blocking(100); // 100ms timeout
   if (msg) {
@@ -132,11 +191,27 @@ void ZmqOMSAdapter::poll_events() {
   }
 }
 
+bool ZmqOMSAdapter::attach(ZmqReactor& reactor) {
+  // Bounded burst so a flood of events cannot starve market data on the same loop
+  constexpr int kReactorBurst = 64;
+  return reactor.add_socket(event_subscriber_->socket_handle(), [this]() {
+    for (int i = 0; i < kReactorBurst && event_subscriber_->receive_into(event_msg_, 0); ++i) {
+      process_event_message(event_msg_);
+    }
+  });
+}
+
 void ZmqOMSAdapter::process_event_message(const std::string& msg) {
 #ifdef PROTO_ENABLED
   // Try to parse as protobuf first
   proto::OrderEvent order_event;
   if (order_event.ParseFromString(msg)) {
+    if (order_event.has_trace()) {
+      uint64_t now_ns = metrics::LatencyTrace::now_ns();
+      const proto::TraceContext& trace = order_event.trace();
+      metrics::LatencyTrace::record(metrics::LatencyTrace::EVENT_TRANSIT, trace.event_publish_ns(), now_ns);
+      metrics::LatencyTrace::record(metrics::LatencyTrace::ORDER_ACK_ROUNDTRIP, trace.order_send_ns(), now_ns);
+    }
     LOG_DEBUG_COMP("ZmqOMSAdapter", "Successfully parsed protobuf order event: " + 
                   order_event.cl_ord_id() + " " + order_event.symbol());
     if (event_callback_) {
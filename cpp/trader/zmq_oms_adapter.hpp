@@ -3,12 +3,19 @@
 #include <functional>
 #include <memory>
 #include <atomic>
+#include <mutex>
+#include <thread>
+#include "i_order_gateway.hpp"
 #include "../utils/oms/order_binary.hpp"
 #include "../utils/zmq/zmq_publisher.hpp"
+#include "../utils/zmq/zmq_reactor.hpp"
 #include "../utils/zmq/zmq_subscriber.hpp"
+#include "../proto/order.pb.h"
 
-// Order Management System that publishes orders via ZMQ and receives events
-class ZmqOMSAdapter {
+// Order Management System that publishes orders via ZMQ and receives events.
+// Orders, cancels and modifies travel as proto::OrderBatchRequest; outside a
+// batch scope each call is published at once as a batch of one.
+class ZmqOMSAdapter : public IOrderGateway {
 public:
   using OrderEventCallback = std::function<void(const std::string& cl_ord_id,
                                                const std::string& exch,
@@ -36,30 +43,51 @@ public:
                   uint32_t side,  // 0=Buy, 1=Sell
                   uint32_t is_market,  // 0=Limit, 1=Market
                   double qty,
-                  double price);
+                  double price) override;
   
-  // Cancel order
+  // Cancel order (symbol lets the engine use per-symbol batch cancel endpoints)
   bool cancel_order(const std::string& cl_ord_id,
-                    const std::string& exch);
+                    const std::string& exch,
+                    const std::string& symbol = "") override;
   
   // Modify order (replace with new price/quantity)
   bool modify_order(const std::string& cl_ord_id,
                     const std::string& exch,
+                    uint32_t side,
                     double new_price,
-                    double new_qty);
+                    double new_qty,
+                    const std::string& symbol = "") override;
+  
+  // Batch scope: between begin_batch() and flush_batch() the calling thread's
+  // send/cancel/modify calls are collected and published as one message.
+  // Scopes nest; the outermost flush publishes. Calls from other threads are
+  // not held back.
+  void begin_batch() override;
+  bool flush_batch() override;
   
-  // Poll for events (non-blocking)
+  // Poll for events (blocks up to 100ms)
   void poll_events();
+  
+  // Deliver events from the reactor's thread as soon as they arrive,
+  // instead of through poll_events(); call before the reactor runs
+  bool attach(ZmqReactor& reactor);
 
 private:
   void process_event_message(const std::string& msg);
+  // Adds the action to the open batch, or publishes it as a batch of one
+  bool submit_action(proto::OrderActionType action_type, proto::OrderRequest& order);
+  bool publish_batch(proto::OrderBatchRequest& batch);
   
   std::unique_ptr<ZmqPublisher> order_publisher_;
   std::unique_ptr<ZmqSubscriber> event_subscriber_;
   std::string order_topic_;
   std::string event_topic_;
-  std::string cancel_topic_;  // Topic for cancel requests
-  std::string modify_topic_;  // Topic for modify requests
+  std::string event_msg_;     // Reactor receive buffer, reused across events
   OrderEventCallback event_callback_;
   std::atomic<uint32_t> sequence_{0};
+  
+  std::mutex batch_mutex_;
+  proto::OrderBatchRequest pending_batch_;
+  std::thread::id batch_owner_;
+  int batch_depth_{0};
 };
@@ -5,21 +5,45 @@
 #include <atomic>
 #include <functional>
 #include <memory>
+#include "../utils/app_service/thread_placement.hpp"
+#include "../utils/zmq/zmq_reactor.hpp"
 #include "../utils/zmq/zmq_subscriber.hpp"
 #include "../utils/logging/log_helper.hpp"
 #include "../proto/position.pb.h"
 #include "../proto/acc_balance.pb.h"
 
 // Position Management System ZMQ Adapter
-// Connects trader to Position Server via ZMQ
+// Connects trader to Position Server via ZMQ. With a reactor both
+// subscriptions are read on its event loop instead of two worker threads;
+// the reactor must be stopped before stop(). Without one the workers are
+// placed as pms_positions and pms_balances ([THREADS]).
 class ZmqPMSAdapter {
 public:
   using PositionUpdateCallback = std::function<void(const proto::PositionUpdate& position)>;
   using BalanceUpdateCallback = std::function<void(const proto::AccountBalanceUpdate& balance)>;
   
-  ZmqPMSAdapter(const std::string& endpoint, const std::string& topic)
+  // Messages read per reactor dispatch before other sockets get a turn
+  static constexpr int kReactorBurst = 64;
+
+  ZmqPMSAdapter(const std::string& endpoint, const std::string& topic, ZmqReactor* reactor = nullptr)
       : endpoint_(endpoint), topic_(topic) {
     running_.store(true);
+    if (reactor) {
+      subscriber_ = std::make_unique<ZmqSubscriber>(endpoint_, topic_);
+      balance_subscriber_ = std::make_unique<ZmqSubscriber>(endpoint_, "balance_updates");
+      reactor->add_socket(subscriber_->socket_handle(), [this]() {
+        for (int i = 0; i < kReactorBurst && subscriber_->receive_into(position_msg_, 0); ++i) {
+          handle_position(position_msg_);
+        }
+      });
+      reactor->add_socket(balance_subscriber_->socket_handle(), [this]() {
+        for (int i = 0; i < kReactorBurst && balance_subscriber_->receive_into(balance_msg_, 0); ++i) {
+          handle_balance(balance_msg_);
+        }
+      });
+      LOG_INFO_COMP("PMS_ADAPTER", "Listening on " + endpoint_ + " topics: " + topic_ + ", balance_updates (reactor)");
+      return;
+    }
     worker_ = std::thread([this]() { this->run(); });
     // Start balance subscriber thread
     balance_worker_ = std::thread([this]() { this->run_balance_subscriber(); });
@@ -67,48 +91,58 @@ public:
 
 private:
   void run() {
+    app_service::ThreadPlacement::instance().place_current_thread("pms_positions");
     LOG_INFO_COMP("PMS_ADAPTER", "Starting to listen on " + endpoint_ + " topic: " + topic_);
     subscriber_ = std::make_unique<ZmqSubscriber>(endpoint_, topic_);
     while (running_.load()) {
-      auto msg = subscriber_->receive_blocking(100); // 100ms timeout to allow checking running_ flag
-      if (!msg) continue;
-      
-      LOG_DEBUG_COMP("PMS_ADAPTER", "Received message of size: " + std::to_string(msg->size()) + " bytes");
-      
-      // Parse protobuf position update
-      proto::PositionUpdate position;
-      if (position.ParseFromString(*msg)) {
-        LOG_DEBUG_COMP("PMS_ADAPTER", "Parsed protobuf: " + position.symbol() + " qty: " + std::to_string(position.qty()));
-        if (position_callback_) {
-          LOG_DEBUG_COMP("PMS_ADAPTER", "Calling position callback");
-          position_callback_(position);
-        }
-      } else {
-        LOG_ERROR_COMP("PMS_ADAPTER", "Failed to parse protobuf message");
+      // 100ms timeout to allow checking running_ flag
+      if (subscriber_->receive_into(position_msg_, 100)) {
+        handle_position(position_msg_);
       }
     }
   }
 
   void run_balance_subscriber() {
+    app_service::ThreadPlacement::instance().place_current_thread("pms_balances");
     LOG_INFO_COMP("PMS_ADAPTER", "Starting balance subscriber on " + endpoint_ + " topic: balance_updates");
     balance_subscriber_ = std::make_unique<ZmqSubscriber>(endpoint_, "balance_updates");
     while (running_.load()) {
-      auto msg = balance_subscriber_->receive_blocking(100); // 100ms timeout to allow checking running_ flag
-      if (!msg) continue;
-      
-      LOG_DEBUG_COMP("PMS_ADAPTER", "Received balance message of size: " + std::to_string(msg->size()) + " bytes");
-      
-      // Parse protobuf balance update
-      proto::AccountBalanceUpdate balance;
-      if (balance.ParseFromString(*msg)) {
-        LOG_DEBUG_COMP("PMS_ADAPTER", "Parsed balance update: " + std::to_string(balance.balances_size()) + " balances");
-        if (balance_callback_) {
-          LOG_DEBUG_COMP("PMS_ADAPTER", "Calling balance callback");
-          balance_callback_(balance);
-        }
-      } else {
-        LOG_ERROR_COMP("PMS_ADAPTER", "Failed to parse balance protobuf message");
+      // 100ms timeout to allow checking running_ flag
+      if (balance_subscriber_->receive_into(balance_msg_, 100)) {
+        handle_balance(balance_msg_);
+      }
+    }
+  }
+
+  void handle_position(const std::string& msg) {
+    LOG_DEBUG_COMP("PMS_ADAPTER", "Received message of size: " + std::to_string(msg.size()) + " bytes");
+    
+    // Parse protobuf position update
+    proto::PositionUpdate position;
+    if (position.ParseFromString(msg)) {
+      LOG_DEBUG_COMP("PMS_ADAPTER", "Parsed protobuf: " + position.symbol() + " qty: " + std::to_string(position.qty()));
+      if (position_callback_) {
+        LOG_DEBUG_COMP("PMS_ADAPTER", "Calling position callback");
+        position_callback_(position);
+      }
+    } else {
+      LOG_ERROR_COMP("PMS_ADAPTER", "Failed to parse protobuf message");
+    }
+  }
+
+  void handle_balance(const std::string& msg) {
+    LOG_DEBUG_COMP("PMS_ADAPTER", "Received balance message of size: " + std::to_string(msg.size()) + " bytes");
+    
+    // Parse protobuf balance update
+    proto::AccountBalanceUpdate balance;
+    if (balance.ParseFromString(msg)) {
+      LOG_DEBUG_COMP("PMS_ADAPTER", "Parsed balance update: " + std::to_string(balance.balances_size()) + " balances");
+      if (balance_callback_) {
+        LOG_DEBUG_COMP("PMS_ADAPTER", "Calling balance callback");
+        balance_callback_(balance);
       }
+    } else {
+      LOG_ERROR_COMP("PMS_ADAPTER", "Failed to parse balance protobuf message");
     }
   }
 
@@ -119,6 +153,8 @@ private:
   std::thread balance_worker_;
   std::unique_ptr<ZmqSubscriber> subscriber_;
   std::unique_ptr<ZmqSubscriber> balance_subscriber_;  // Separate subscriber for balance updates
+  std::string position_msg_;  // Receive buffers, reused across messages
+  std::string balance_msg_;
   PositionUpdateCallback position_callback_;
   BalanceUpdateCallback balance_callback_;
 };
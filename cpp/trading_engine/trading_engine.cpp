@@ -196,9 +196,9 @@ void TradingEngine::process_order_queue_item(const OrderRequest& request) {
             std::string order_type = request.order_type == "MARKET" ? "MARKET" : "LIMIT";
             
             if (order_type == "MARKET") {
-                order_sent = oms_->place_market_order(request.symbol, side, request.qty);
+                order_sent = oms_->place_market_order(request.symbol, side, request.qty, request.cl_ord_id);
             } else {
-                order_sent = oms_->place_limit_order(request.symbol, side, request.qty, request.price);
+                order_sent = oms_->place_limit_order(request.symbol, side, request.qty, request.price, request.cl_ord_id);
             }
             
             if (order_sent) {
@@ -4,7 +4,9 @@
 #include "../utils/constants.hpp"
 #include "../utils/error_handling.hpp"
 #include "../utils/metrics/metrics_collector.hpp"
+#include "../utils/metrics/latency_trace.hpp"
 #include "../utils/exchange/exchange_symbol_registry.hpp"
+#include "../utils/app_service/thread_placement.hpp"
 #include <chrono>
 #include <thread>
 #include <algorithm>
@@ -12,6 +14,30 @@
 
 namespace trading_engine {
 
+namespace {
+
+// Looked up once; updates on the order path are then lock-free
+struct EngineMetrics {
+    metrics::Timer& order_request_processing = METRICS_TIMER("trading_engine.order_request_processing_us");
+    metrics::Timer& order_event_processing = METRICS_TIMER("trading_engine.order_event_processing_us");
+    metrics::Counter& orders_received = METRICS_COUNTER("trading_engine.orders_received");
+    metrics::Counter& orders_sent_to_exchange = METRICS_COUNTER("trading_engine.orders_sent_to_exchange");
+    metrics::Counter& order_send_failures = METRICS_COUNTER("trading_engine.order_send_failures");
+    metrics::Counter& parse_errors = METRICS_COUNTER("trading_engine.parse_errors");
+    metrics::Counter& orders_acked = METRICS_COUNTER("trading_engine.orders_acked");
+    metrics::Counter& orders_filled = METRICS_COUNTER("trading_engine.orders_filled");
+    metrics::Counter& orders_cancelled = METRICS_COUNTER("trading_engine.orders_cancelled");
+    metrics::Counter& orders_rejected = METRICS_COUNTER("trading_engine.orders_rejected");
+    metrics::Gauge& total_filled_volume = METRICS_GAUGE("trading_engine.total_filled_volume");
+};
+
+EngineMetrics& engine_metrics() {
+    static EngineMetrics instance;
+    return instance;
+}
+
+} // namespace
+
 TradingEngineLib::TradingEngineLib() {
     logging::Logger logger("TRADING_ENGINE");
     logger.info("Initializing Trading Engine Library");
@@ -63,6 +89,14 @@ bool TradingEngineLib::initialize(const std::string& config_file) {
                 logger.warn("Invalid MAX_ORDERS_PER_SECOND config, using default: 10");
             }
             
+            // Inbound order request queue
+            int queue_capacity = config_manager_->get_int("TRADING_ENGINE", "MESSAGE_QUEUE_CAPACITY", 4096);
+            if (queue_capacity > 0) {
+                message_queue_capacity_ = static_cast<size_t>(queue_capacity);
+            }
+            message_queue_wait_ = parse_wait_strategy(
+                config_manager_->get_string("TRADING_ENGINE", "MESSAGE_QUEUE_WAIT_STRATEGY", "futex"));
+            
             // Load exchange symbol configuration
             std::string symbol_config_path = config_manager_->get_string("TRADING_ENGINE", "EXCHANGE_INSTR_CONFIG", "exchange_instr_config.ini");
             if (!symbol_config_path.empty()) {
@@ -95,9 +129,17 @@ void TradingEngineLib::start() {
     
     running_.store(true);
     
-    // Start message processing thread
+    // Start message processing thread, fed from ZMQ through a lock-free ring
+    message_queue_ = std::make_unique<SpscRing<std::string>>(
+        message_queue_capacity_, message_queue_wait_, [](std::string& slot) { slot.reserve(512); });
+    logger.debug("Message queue: " + std::to_string(message_queue_->capacity()) + " slots, " +
+                 wait_strategy_name(message_queue_->wait_strategy()) + " wait");
+    
     message_processing_running_.store(true);
     message_processing_thread_ = std::thread(&TradingEngineLib::message_processing_loop, this);
+    if (subscriber_) {
+        zmq_receive_thread_ = std::thread(&TradingEngineLib::zmq_receive_loop, this);
+    }
     
     // Connect to exchange OMS
     if (exchange_oms_) {
@@ -127,13 +169,15 @@ void TradingEngineLib::stop() {
     
     running_.store(false);
     
-    // Stop message processing thread
+    // Stop message processing threads
     message_processing_running_.store(false);
-    {
-        std::lock_guard<std::mutex> lock(message_queue_mutex_);
-        message_cv_.notify_all();
+    if (message_queue_) {
+        message_queue_->wake_consumer();
     }
     
+    if (zmq_receive_thread_.joinable()) {
+        zmq_receive_thread_.join();
+    }
     if (message_processing_thread_.joinable()) {
         message_processing_thread_.join();
     }
@@ -205,10 +249,10 @@ bool TradingEngineLib::send_order(const std::string& cl_ord_id, const std::strin
     bool success = false;
     if (type == proto::OrderType::MARKET) {
         success = exchange_oms_->place_market_order(symbol, 
-            (side == proto::Side::BUY ? "BUY" : "SELL"), qty);
+            (side == proto::Side::BUY ? "BUY" : "SELL"), qty, cl_ord_id);
     } else if (type == proto::OrderType::LIMIT) {
         success = exchange_oms_->place_limit_order(symbol, 
-            (side == proto::Side::BUY ? "BUY" : "SELL"), qty, price);
+            (side == proto::Side::BUY ? "BUY" : "SELL"), qty, price, cl_ord_id);
     }
     
     if (success) {
@@ -265,8 +309,20 @@ bool TradingEngineLib::cancel_order(const std::string& cl_ord_id) {
     
     logger.debug("Cancelling order: " + cl_ord_id);
     
+    // Venues need the symbol (and take the exchange order id when known) of the order being cancelled
+    std::string exch_ord_id;
+    std::string symbol;
+    {
+        std::lock_guard<std::mutex> lock(order_states_mutex_);
+        auto it = order_states_.find(cl_ord_id);
+        if (it != order_states_.end()) {
+            exch_ord_id = it->second.exchange_order_id;
+            symbol = it->second.symbol;
+        }
+    }
+    
     // Send to exchange OMS
-    bool success = exchange_oms_->cancel_order(cl_ord_id, "");
+    bool success = exchange_oms_->cancel_order(cl_ord_id, exch_ord_id, symbol);
     
     if (success) {
         logger.debug("Cancel request sent successfully");
@@ -292,8 +348,18 @@ bool TradingEngineLib::modify_order(const std::string& cl_ord_id, double new_pri
     // Create modify request
     proto::OrderRequest modify_request;
     modify_request.set_cl_ord_id(cl_ord_id);
+    modify_request.set_type(proto::OrderType::LIMIT);
     modify_request.set_price(new_price);
     modify_request.set_qty(new_qty);
+    {
+        // Venues need the side and symbol of the order being modified
+        std::lock_guard<std::mutex> lock(order_states_mutex_);
+        auto it = order_states_.find(cl_ord_id);
+        if (it != order_states_.end()) {
+            modify_request.set_symbol(it->second.symbol);
+            modify_request.set_side(it->second.side == Side::Buy ? proto::Side::BUY : proto::Side::SELL);
+        }
+    }
     
     // Send to exchange OMS
     bool success = exchange_oms_->replace_order(cl_ord_id, modify_request);
@@ -538,95 +604,151 @@ void TradingEngineLib::query_open_orders_at_startup() {
 }
 
 void TradingEngineLib::message_processing_loop() {
+    app_service::ThreadPlacement::instance().place_current_thread("order_process");
     logging::Logger logger("TRADING_ENGINE");
     logger.debug("Starting message processing loop");
     
     while (message_processing_running_.load()) {
-        std::unique_lock<std::mutex> lock(message_queue_mutex_);
-        
-        if (message_queue_.empty()) {
-            message_cv_.wait(lock, [this] { 
-                return !message_queue_.empty() || !message_processing_running_.load(); 
-            });
-        }
-        
-        if (!message_processing_running_.load()) {
-            break;
+        std::string* message = message_queue_->wait_front(std::chrono::milliseconds(100));
+        if (!message) {
+            continue;
         }
         
-        while (!message_queue_.empty()) {
-            std::string message = message_queue_.front();
-            message_queue_.pop();
-            lock.unlock();
-            
-            // Process message
-            try {
-                proto::OrderRequest order_request;
-                if (order_request.ParseFromString(message)) {
-                    handle_order_request(order_request);
-                    statistics_.zmq_messages_received.fetch_add(1);
-                } else {
-                    logging::Logger logger("TRADING_ENGINE");
-                    logger.error("Failed to parse order request message");
-                    statistics_.parse_errors.fetch_add(1);
-                }
-            } catch (const std::exception& e) {
-                logging::Logger logger("TRADING_ENGINE");
-                logger.error("Error processing message: " + std::string(e.what()));
+        // Process message in place; the slot goes back to the receiver afterwards
+        try {
+            order_batch_.Clear();
+            if (order_batch_.ParseFromString(*message)) {
+                handle_order_batch(order_batch_);
+                statistics_.zmq_messages_received.fetch_add(1);
+            } else {
+                logger.error("Failed to parse order batch message");
                 statistics_.parse_errors.fetch_add(1);
             }
-            
-            lock.lock();
+        } catch (const std::exception& e) {
+            logger.error("Error processing message: " + std::string(e.what()));
+            statistics_.parse_errors.fetch_add(1);
         }
+        
+        message_queue_->pop();
     }
     
     logger.debug("Message processing loop stopped");
 }
 
-void TradingEngineLib::handle_order_request(const proto::OrderRequest& order_request) {
+void TradingEngineLib::zmq_receive_loop() {
+    app_service::ThreadPlacement::instance().place_current_thread("order_receive");
+    logging::Logger logger("TRADING_ENGINE");
+    logger.debug("Starting ZMQ receive loop");
+    
+    while (message_processing_running_.load()) {
+        std::string* slot = message_queue_->claim();
+        if (!slot) {
+            // Ring full: leave requests in the ZMQ socket until the processor frees a slot
+            message_queue_->wait_claim(std::chrono::milliseconds(100));
+            continue;
+        }
+        
+        // Receive straight into the ring slot; short timeout so stop() is honoured
+        if (subscriber_->receive_into(*slot, 100)) {
+            message_queue_->publish();
+        }
+    }
+    
+    logger.debug("ZMQ receive loop stopped");
+}
+
+void TradingEngineLib::handle_order_batch(const proto::OrderBatchRequest& order_batch) {
+    using metrics::LatencyTrace;
     logging::Logger logger("TRADING_ENGINE");
     
     // Use metrics timer for performance tracking
-    auto timer = METRICS_TIMER("trading_engine.order_request_processing_us").start();
+    auto timer = engine_metrics().order_request_processing.start();
     
-    // Check if this is a cancel request (symbol == "__CANCEL__")
-    if (order_request.symbol() == "__CANCEL__") {
-        logger.debug("Handling cancel request: " + order_request.cl_ord_id());
-        cancel_order(order_request.cl_ord_id());
+    if (!exchange_oms_) {
+        logger.error("Cannot handle order batch: no exchange OMS");
         return;
     }
     
-    // Check if this is a modify request (symbol == "__MODIFY__")
-    if (order_request.symbol() == "__MODIFY__") {
-        logger.debug("Handling modify request: " + order_request.cl_ord_id() + 
-                    " new_price=" + std::to_string(order_request.price()) + 
-                    " new_qty=" + std::to_string(order_request.qty()));
-        modify_order(order_request.cl_ord_id(), order_request.price(), order_request.qty());
-        return;
-    }
+    const int action_count = order_batch.actions_size();
+    logger.debug("Handling order batch: " + std::to_string(action_count) + " actions");
     
-    // Only log at DEBUG level for normal operations
-    logger.debug("Handling order request: " + order_request.cl_ord_id());
+    // Stamp traced new orders before anything goes to the venue
+    uint64_t recv_ns = LatencyTrace::enabled() ? LatencyTrace::now_ns() : 0;
+    batch_traces_.resize(static_cast<size_t>(action_count));
+    for (int i = 0; i < action_count; ++i) {
+        const proto::OrderAction& action = order_batch.actions(i);
+        if (action.action() != proto::NEW_ORDER) {
+            continue;
+        }
+        logger.debug("Handling order request: " + action.order().cl_ord_id());
+        statistics_.orders_received.fetch_add(1);
+        engine_metrics().orders_received.increment();
+        
+        proto::TraceContext& trace = batch_traces_[i];
+        trace.Clear();
+        if (recv_ns && action.order().has_trace()) {
+            trace = action.order().trace();
+            trace.set_engine_recv_ns(recv_ns);
+            trace.set_exchange_send_ns(LatencyTrace::now_ns());
+            LatencyTrace::record(LatencyTrace::ORDER_TRANSIT, trace.order_send_ns(), recv_ns);
+            LatencyTrace::record(LatencyTrace::ENGINE_DISPATCH, recv_ns, trace.exchange_send_ns());
+            LatencyTrace::record(LatencyTrace::TICK_TO_TRADE, trace.md_recv_ns(), trace.exchange_send_ns());
+        }
+    }
     
-    statistics_.orders_received.fetch_add(1);
-    METRICS_COUNTER("trading_engine.orders_received").increment();
+    // One submission: batch endpoints where the venue has them, pipelined singles otherwise
+    exchange_oms_->submit_batch(order_batch, batch_results_);
+    uint64_t submitted_ns = recv_ns ? LatencyTrace::now_ns() : 0;
     
-    // Send order to exchange
-    if (exchange_oms_) {
-        bool success = false;
-        if (order_request.type() == proto::OrderType::MARKET) {
-            success = exchange_oms_->place_market_order(order_request.symbol(), 
-                (order_request.side() == proto::Side::BUY ? "BUY" : "SELL"), order_request.qty());
-        } else if (order_request.type() == proto::OrderType::LIMIT) {
-            success = exchange_oms_->place_limit_order(order_request.symbol(), 
-                (order_request.side() == proto::Side::BUY ? "BUY" : "SELL"), order_request.qty(), order_request.price());
-        }
-        if (success) {
-            statistics_.orders_sent_to_exchange.fetch_add(1);
-            METRICS_COUNTER("trading_engine.orders_sent_to_exchange").increment();
-        } else {
-            METRICS_COUNTER("trading_engine.order_send_failures").increment();
-            logger.error("Failed to send order: " + order_request.cl_ord_id());
+    for (int i = 0; i < action_count; ++i) {
+        const proto::OrderAction& action = order_batch.actions(i);
+        const std::string& cl_ord_id = action.order().cl_ord_id();
+        const bool success = static_cast<size_t>(i) < batch_results_.size() && batch_results_[i];
+        
+        switch (action.action()) {
+            case proto::NEW_ORDER: {
+                const proto::TraceContext& trace = batch_traces_[i];
+                const bool traced = trace.engine_recv_ns() != 0;
+                if (traced) {
+                    LatencyTrace::record(LatencyTrace::EXCHANGE_SUBMIT, trace.exchange_send_ns(), submitted_ns);
+                }
+                if (success) {
+                    statistics_.orders_sent_to_exchange.fetch_add(1);
+                    engine_metrics().orders_sent_to_exchange.increment();
+                    if (traced) {
+                        std::lock_guard<std::mutex> lock(pending_traces_mutex_);
+                        if (pending_traces_.size() >= MAX_PENDING_TRACES) {
+                            evict_stale_traces(submitted_ns);
+                        }
+                        if (pending_traces_.size() < MAX_PENDING_TRACES) {
+                            pending_traces_[cl_ord_id] = trace;
+                        }
+                    }
+                } else {
+                    engine_metrics().order_send_failures.increment();
+                    logger.error("Failed to send order: " + cl_ord_id);
+                }
+                break;
+            }
+            case proto::CANCEL_ORDER:
+                if (success) {
+                    logger.debug("Cancel request sent successfully: " + cl_ord_id);
+                } else {
+                    logger.error("Failed to send cancel request: " + cl_ord_id);
+                    handle_error("Failed to send cancel request to exchange");
+                }
+                break;
+            case proto::REPLACE_ORDER:
+                if (success) {
+                    logger.debug("Modify request sent successfully: " + cl_ord_id);
+                } else {
+                    logger.error("Failed to send modify request: " + cl_ord_id);
+                    handle_error("Failed to send modify request to exchange");
+                }
+                break;
+            default:
+                logger.warn("Ignoring unknown order action for: " + cl_ord_id);
+                break;
         }
     }
 }
@@ -635,7 +757,7 @@ void TradingEngineLib::handle_order_event(const proto::OrderEvent& order_event)
     logging::Logger logger("TRADING_ENGINE");
     
     // Use metrics timer for performance tracking
-    auto timer = METRICS_TIMER("trading_engine.order_event_processing_us").start();
+    auto timer = engine_metrics().order_event_processing.start();
     
     // Only log at DEBUG level for normal operations (reduces verbosity)
     logger.debug("Handling order event: " + order_event.cl_ord_id() + 
@@ -645,7 +767,7 @@ void TradingEngineLib::handle_order_event(const proto::OrderEvent& order_event)
     if (order_event.cl_ord_id().empty()) {
         logger.error("Received order event with empty cl_ord_id - ignoring");
         statistics_.parse_errors.fetch_add(1);
-        METRICS_COUNTER("trading_engine.parse_errors").increment();
+        engine_metrics().parse_errors.increment();
         return;
     }
     
@@ -682,30 +804,42 @@ void TradingEngineLib::handle_order_event(const proto::OrderEvent& order_event)
     switch (order_event.event_type()) {
         case proto::OrderEventType::ACK:
             statistics_.orders_acked.fetch_add(1);
-            METRICS_COUNTER("trading_engine.orders_acked").increment();
+            engine_metrics().orders_acked.increment();
             break;
         case proto::OrderEventType::FILL:
             statistics_.orders_filled.fetch_add(1);
-            METRICS_COUNTER("trading_engine.orders_filled").increment();
+            engine_metrics().orders_filled.increment();
             if (order_event.fill_qty() > 0.0) {
-                METRICS_GAUGE("trading_engine.total_filled_volume").increment(order_event.fill_qty());
+                engine_metrics().total_filled_volume.increment(order_event.fill_qty());
             }
             break;
         case proto::OrderEventType::CANCEL:
             statistics_.orders_cancelled.fetch_add(1);
-            METRICS_COUNTER("trading_engine.orders_cancelled").increment();
+            engine_metrics().orders_cancelled.increment();
             break;
         case proto::OrderEventType::REJECT:
             statistics_.orders_rejected.fetch_add(1);
-            METRICS_COUNTER("trading_engine.orders_rejected").increment();
+            engine_metrics().orders_rejected.increment();
             logger.warn("Order rejected: " + order_event.cl_ord_id());  // WARN level for rejections
             break;
         default:
             break;
     }
     
-    // Publish order event
-    publish_order_event(order_event);
+    // Publish order event, with the order's latency trace on its ACK/REJECT
+    proto::TraceContext trace;
+    if (take_pending_trace(order_event, trace)) {
+        uint64_t ack_ns = metrics::LatencyTrace::now_ns();
+        trace.set_exchange_ack_ns(ack_ns);
+        metrics::LatencyTrace::record(metrics::LatencyTrace::EXCHANGE_ACK, trace.exchange_send_ns(), ack_ns);
+        
+        proto::OrderEvent traced_event = order_event;
+        trace.set_event_publish_ns(metrics::LatencyTrace::now_ns());
+        *traced_event.mutable_trace() = trace;
+        publish_order_event(traced_event);
+    } else {
+        publish_order_event(order_event);
+    }
     
     // Call user callback with exception handling
     error_handling::safe_callback(order_event_callback_, "TRADING_ENGINE", 
@@ -714,6 +848,44 @@ void TradingEngineLib::handle_order_event(const proto::OrderEvent& order_event)
     // Note: We could enhance safe_callback to return error status if needed
 }
 
+bool TradingEngineLib::take_pending_trace(const proto::OrderEvent& order_event, proto::TraceContext& trace) {
+    if (!metrics::LatencyTrace::enabled() ||
+        (order_event.event_type() != proto::OrderEventType::ACK &&
+         order_event.event_type() != proto::OrderEventType::REJECT)) {
+        return false;
+    }
+    
+    std::lock_guard<std::mutex> lock(pending_traces_mutex_);
+    if (pending_traces_.empty()) {
+        return false;
+    }
+    auto it = pending_traces_.find(order_event.cl_ord_id());
+    if (it == pending_traces_.end()) {
+        return false;
+    }
+    trace = it->second;
+    pending_traces_.erase(it);
+    return true;
+}
+
+void TradingEngineLib::evict_stale_traces(uint64_t now_ns) {
+    if (now_ns < next_trace_eviction_ns_ || now_ns < PENDING_TRACE_MAX_AGE_NS) {
+        return;
+    }
+    const uint64_t cutoff_ns = now_ns - PENDING_TRACE_MAX_AGE_NS;
+    uint64_t oldest_ns = now_ns;
+    for (auto it = pending_traces_.begin(); it != pending_traces_.end();) {
+        const uint64_t sent_ns = it->second.exchange_send_ns();
+        if (sent_ns < cutoff_ns) {
+            it = pending_traces_.erase(it);
+        } else {
+            oldest_ns = std::min(oldest_ns, sent_ns);
+            ++it;
+        }
+    }
+    next_trace_eviction_ns_ = oldest_ns + PENDING_TRACE_MAX_AGE_NS;
+}
+
 void TradingEngineLib::handle_error(const std::string& error_message) {
     logging::Logger logger("TRADING_ENGINE");
     logger.error("Error: " + error_message);
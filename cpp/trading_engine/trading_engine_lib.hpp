@@ -5,15 +5,15 @@
 #include <functional>
 #include <thread>
 #include <mutex>
-#include <condition_variable>
-#include <queue>
 #include <map>
+#include <unordered_map>
 #include "../exchanges/i_exchange_oms.hpp"
 #include "../exchanges/i_exchange_data_fetcher.hpp"
 #include "../exchanges/oms_factory.hpp"
 #include "../exchanges/data_fetcher_factory.hpp"
 #include "../utils/zmq/zmq_subscriber.hpp"
 #include "../utils/zmq/zmq_publisher.hpp"
+#include "../utils/lockfree/spsc_ring.hpp"
 #include "../utils/config/process_config_manager.hpp"
 #include "../utils/oms/order_state.hpp"
 #include "../exchanges/websocket/i_websocket_transport.hpp"
@@ -220,13 +220,28 @@ private:
     std::map<std::string, OrderStateInfo> order_states_;
     mutable std::mutex order_states_mutex_;
     
+    // Latency traces of orders sent to the exchange, attached to their ACK/REJECT
+    // event. Only populated while tracing is enabled; bounded so unmatched
+    // orders cannot grow it without limit. Entries whose ACK never came are
+    // dropped once older than PENDING_TRACE_MAX_AGE_NS and the map is full.
+    static constexpr size_t MAX_PENDING_TRACES = 4096;
+    static constexpr uint64_t PENDING_TRACE_MAX_AGE_NS = 30'000'000'000ULL;
+    std::unordered_map<std::string, proto::TraceContext> pending_traces_;
+    uint64_t next_trace_eviction_ns_{0};   // When the oldest remaining entry goes stale
+    std::mutex pending_traces_mutex_;
     
-    // Message processing
+    
+    // Message processing: ZMQ receive thread -> SPSC ring -> processing thread.
+    // Slots are reused string buffers; order_batch_ is reused per message.
     std::thread message_processing_thread_;
+    std::thread zmq_receive_thread_;
     std::atomic<bool> message_processing_running_{false};
-    std::queue<std::string> message_queue_;
-    std::mutex message_queue_mutex_;
-    std::condition_variable message_cv_;
+    std::unique_ptr<SpscRing<std::string>> message_queue_;
+    size_t message_queue_capacity_{4096};        // TRADING_ENGINE.MESSAGE_QUEUE_CAPACITY
+    WaitStrategy message_queue_wait_{WaitStrategy::FUTEX};  // TRADING_ENGINE.MESSAGE_QUEUE_WAIT_STRATEGY
+    proto::OrderBatchRequest order_batch_;
+    std::vector<bool> batch_results_;
+    std::vector<proto::TraceContext> batch_traces_;
     
     // Callbacks
     OrderEventCallback order_event_callback_;
@@ -255,12 +270,19 @@ private:
     void setup_exchange_oms();
     void query_open_orders_at_startup();
     void message_processing_loop();
-    void handle_order_request(const proto::OrderRequest& order_request);
+    void zmq_receive_loop();
+    void handle_order_batch(const proto::OrderBatchRequest& order_batch);
     void handle_order_event(const proto::OrderEvent& order_event);
     void handle_error(const std::string& error_message);
     void publish_order_event(const proto::OrderEvent& order_event);
     void update_order_state(const std::string& cl_ord_id, proto::OrderEventType event_type);
     
+    // Remove and return the latency trace waiting for this ACK/REJECT, if any
+    bool take_pending_trace(const proto::OrderEvent& order_event, proto::TraceContext& trace);
+    // Drop traces sent more than PENDING_TRACE_MAX_AGE_NS before now_ns. Sweeps only
+    // once the oldest entry can have gone stale. Caller holds pending_traces_mutex_
+    void evict_stale_traces(uint64_t now_ns);
+    
     // Internal helper that assumes lock is already held (prevents double locking)
     void update_order_state_internal(std::map<std::string, OrderStateInfo>::iterator it, 
                                      proto::OrderEventType event_type);
@@ -1,5 +1,7 @@
 #include "app_service.hpp"
+#include "thread_placement.hpp"
 #include "../logging/log_helper.hpp"
+#include "../metrics/latency_trace.hpp"
 #include <iomanip>
 #include <sstream>
 #include <unistd.h>
@@ -66,6 +68,10 @@ bool AppService::initialize(int argc, char** argv) {
         return false;
     }
 
+    // Thread placement and memory locking ([THREADS]) before any worker thread exists
+    ThreadPlacement::instance().configure(*config_manager_);
+    ThreadPlacement::instance().apply_process_settings();
+
     // Setup signal handlers
     setup_signal_handlers();
 
@@ -123,6 +129,7 @@ void AppService::start() {
     // Start statistics reporting thread
     stats_running_.store(true);
     stats_thread_ = std::thread(&AppService::stats_reporting_loop, this);
+    start_metrics_exporter();
 
     // Start the specific service
     if (!start_service()) {
@@ -135,6 +142,7 @@ void AppService::start() {
     statistics_.start_time = std::chrono::system_clock::now();
     
     LOG_INFO_COMP("APP_SERVICE", "Service started successfully");
+    ThreadPlacement::instance().log_report();
 
     // Main processing loop
     while (running_.load()) {
@@ -161,6 +169,7 @@ void AppService::stop() {
     if (stats_thread_.joinable()) {
         stats_thread_.join();
     }
+    metrics_exporter_.stop();
     
     // Stop the specific service
     stop_service();
@@ -179,6 +188,7 @@ void AppService::setup_signal_handlers() {
 }
 
 void AppService::stats_reporting_loop() {
+    ThreadPlacement::instance().place_current_thread("stats");
     while (stats_running_.load()) {
         std::this_thread::sleep_for(std::chrono::seconds(stats_interval_seconds_));
         
@@ -192,6 +202,25 @@ void AppService::stats_reporting_loop() {
     }
 }
 
+void AppService::start_metrics_exporter() {
+    if (config_manager_->get_bool("METRICS", "LATENCY_TRACE", false)) {
+        metrics::LatencyTrace::set_enabled(true);
+        LOG_INFO_COMP("APP_SERVICE", "Tick-to-trade latency tracing enabled");
+    }
+    
+    metrics::MetricsExporterConfig config;
+    config.prometheus_file = config_manager_->get_string("METRICS", "PROMETHEUS_FILE");
+    config.publish_endpoint = config_manager_->get_string("METRICS", "PUB_ENDPOINT");
+    config.interval_ms = config_manager_->get_int("METRICS", "EXPORT_INTERVAL_MS", 1000);
+    if (config.prometheus_file.empty() && config.publish_endpoint.empty()) {
+        return;
+    }
+
+    if (!metrics_exporter_.start(config)) {
+        LOG_WARN_COMP("APP_SERVICE", "Metrics exporter failed to start; continuing without it");
+    }
+}
+
 void AppService::signal_handler(int signal) {
     AppService* instance = g_instance.load();
     if (instance) {
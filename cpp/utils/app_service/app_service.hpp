@@ -9,6 +9,7 @@
 #include <vector>
 #include <map>
 #include "../utils/config/process_config_manager.hpp"
+#include "../metrics/metrics_exporter.hpp"
 
 namespace app_service {
 
@@ -20,6 +21,8 @@ namespace app_service {
  * - Signal handling (SIGINT, SIGTERM, SIGHUP)
  * - Configuration loading
  * - Statistics reporting
+ * - Optional periodic metrics export ([METRICS] section: PROMETHEUS_FILE,
+ *   PUB_ENDPOINT, EXPORT_INTERVAL_MS) and latency tracing (LATENCY_TRACE)
  * - Graceful shutdown
  * - Daemonization support
  */
@@ -95,6 +98,7 @@ private:
     std::unique_ptr<config::ProcessConfigManager> config_manager_;
     std::thread stats_thread_;
     std::atomic<bool> stats_running_{false};
+    metrics::MetricsExporter metrics_exporter_;
     
     Statistics statistics_;
     
@@ -104,6 +108,7 @@ private:
     // Internal methods
     void setup_signal_handlers();
     void stats_reporting_loop();
+    void start_metrics_exporter();
     void handle_signal(int signal);
     void print_startup_banner();
     void print_shutdown_banner();
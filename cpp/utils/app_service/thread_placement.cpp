@@ -0,0 +1,261 @@
+#include "thread_placement.hpp"
+#include "../config/process_config_manager.hpp"
+#include "../logging/log_helper.hpp"
+#include <algorithm>
+#include <alloca.h>
+#include <cctype>
+#include <cstring>
+#include <pthread.h>
+#include <sched.h>
+#include <sstream>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <zmq.h>
+
+namespace app_service {
+
+namespace {
+
+constexpr const char* kSection = "THREADS";
+constexpr size_t kMaxPrefaultStackKb = 4096;   // Well inside the default 8 MB thread stack
+constexpr size_t kPageSize = 4096;
+
+// Touch `bytes` of stack below the caller so later growth does not fault
+__attribute__((noinline)) void prefault_stack(size_t bytes) {
+    volatile char* stack = static_cast<volatile char*>(alloca(bytes));
+    for (size_t offset = 0; offset < bytes; offset += kPageSize) {
+        stack[offset] = 0;
+    }
+}
+
+std::string format_cpus(const std::vector<int>& cpus) {
+    if (cpus.empty()) {
+        return "any";
+    }
+    std::string text;
+    for (int cpu : cpus) {
+        if (!text.empty()) text += ",";
+        text += std::to_string(cpu);
+    }
+    return text;
+}
+
+} // namespace
+
+ThreadPlacement& ThreadPlacement::instance() {
+    static ThreadPlacement placement;
+    return placement;
+}
+
+void ThreadPlacement::configure(const config::ProcessConfigManager& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    settings_.clear();
+    for (const auto& key : config.get_keys(kSection)) {
+        settings_[key] = config.get_string(kSection, key);
+    }
+    lock_memory_ = config.get_bool(kSection, "MLOCK", false);
+    int prefault_kb = config.get_int(kSection, "PREFAULT_STACK_KB", 0);
+    prefault_stack_kb_ = std::min(static_cast<size_t>(std::max(0, prefault_kb)), kMaxPrefaultStackKb);
+    zmq_io_threads_ = std::max(0, config.get_int(kSection, "ZMQ_IO_THREADS", 0));
+    zmq_io_cpus_ = parse_cpu_list(config.get_string(kSection, "ZMQ_IO_CPUS", ""));
+    zmq_io_priority_ = std::max(0, config.get_int(kSection, "ZMQ_IO_PRIORITY", 0));
+}
+
+bool ThreadPlacement::apply_process_settings() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!lock_memory_ || memory_locked_) {
+        return true;
+    }
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        LOG_WARN_COMP("THREAD_PLACEMENT", std::string("mlockall failed (raise RLIMIT_MEMLOCK or grant CAP_IPC_LOCK): ") +
+                      std::strerror(errno));
+        return false;
+    }
+    memory_locked_ = true;
+    LOG_INFO_COMP("THREAD_PLACEMENT", "Process memory locked");
+    return true;
+}
+
+ThreadPlacement::Placement ThreadPlacement::placement_for(const std::string& name, int default_cpu,
+                                                          int default_priority) const {
+    Placement placement;
+    if (default_cpu >= 0) {
+        placement.cpus.push_back(default_cpu);
+    }
+    placement.priority = std::max(0, default_priority);
+
+    const std::string key = config_key(name);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto cpu = settings_.find(key + "_CPU");
+    if (cpu != settings_.end()) {
+        placement.cpus = parse_cpu_list(cpu->second);
+    }
+    auto priority = settings_.find(key + "_PRIORITY");
+    if (priority != settings_.end()) {
+        try {
+            placement.priority = std::max(0, std::stoi(priority->second));
+        } catch (const std::exception&) {
+            LOG_WARN_COMP("THREAD_PLACEMENT", "Ignoring invalid " + key + "_PRIORITY: " + priority->second);
+        }
+    }
+    return placement;
+}
+
+ThreadPlacement::Placement ThreadPlacement::place_current_thread(const std::string& name, int default_cpu,
+                                                                 int default_priority) {
+    Placement placement = placement_for(name, default_cpu, default_priority);
+    pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+
+    Record record;
+    record.name = name;
+    record.tid = static_cast<long>(syscall(SYS_gettid));
+    record.cpus = placement.cpus;
+    record.priority = placement.priority;
+
+    // Threads this one spawns inherit the mask and policy
+    if (!placement.cpus.empty()) {
+        cpu_set_t cpuset;
+        CPU_ZERO(&cpuset);
+        for (int cpu : placement.cpus) {
+            CPU_SET(cpu, &cpuset);
+        }
+        int rc = pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+        if (rc != 0) {
+            LOG_WARN_COMP("THREAD_PLACEMENT", "Failed to pin " + name + " to core " + format_cpus(placement.cpus) +
+                          ": " + std::strerror(rc));
+        } else {
+            record.pinned = true;
+        }
+    }
+
+    if (placement.priority > 0) {
+        sched_param param{};
+        param.sched_priority = std::min(placement.priority, sched_get_priority_max(SCHED_FIFO));
+        int rc = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (rc != 0) {
+            LOG_WARN_COMP("THREAD_PLACEMENT", "Failed to set SCHED_FIFO " + std::to_string(param.sched_priority) +
+                          " for " + name + " (needs CAP_SYS_NICE): " + std::strerror(rc));
+        } else {
+            record.realtime = true;
+        }
+    }
+
+    size_t prefault_kb = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        prefault_kb = prefault_stack_kb_;
+        auto existing = std::find_if(records_.begin(), records_.end(),
+                                     [&name](const Record& r) { return r.name == name; });
+        if (existing != records_.end()) {
+            *existing = record;
+        } else {
+            records_.push_back(record);
+        }
+    }
+    if (prefault_kb > 0) {
+        prefault_stack(prefault_kb * 1024);
+    }
+
+    if (record.pinned || record.realtime) {
+        LOG_INFO_COMP("THREAD_PLACEMENT", "Placed " + name + " (tid " + std::to_string(record.tid) + ") on core " +
+                      (record.pinned ? format_cpus(record.cpus) : std::string("any")) +
+                      (record.realtime ? ", SCHED_FIFO " + std::to_string(record.priority) : std::string()));
+    }
+    return placement;
+}
+
+void ThreadPlacement::configure_zmq_context(void* ctx) const {
+    if (!ctx) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (zmq_io_threads_ > 0 && zmq_ctx_set(ctx, ZMQ_IO_THREADS, zmq_io_threads_) != 0) {
+        LOG_WARN_COMP("THREAD_PLACEMENT", std::string("Failed to set ZMQ_IO_THREADS: ") + zmq_strerror(zmq_errno()));
+    }
+#ifdef ZMQ_THREAD_AFFINITY_CPU_ADD
+    for (int cpu : zmq_io_cpus_) {
+        if (zmq_ctx_set(ctx, ZMQ_THREAD_AFFINITY_CPU_ADD, cpu) != 0) {
+            LOG_WARN_COMP("THREAD_PLACEMENT", "Failed to add core " + std::to_string(cpu) + " to ZMQ I/O affinity: " +
+                          zmq_strerror(zmq_errno()));
+        }
+    }
+#endif
+#if defined(ZMQ_THREAD_SCHED_POLICY) && defined(ZMQ_THREAD_PRIORITY)
+    if (zmq_io_priority_ > 0) {
+        if (zmq_ctx_set(ctx, ZMQ_THREAD_SCHED_POLICY, SCHED_FIFO) != 0 ||
+            zmq_ctx_set(ctx, ZMQ_THREAD_PRIORITY, zmq_io_priority_) != 0) {
+            LOG_WARN_COMP("THREAD_PLACEMENT", std::string("Failed to set ZMQ I/O thread priority: ") +
+                          zmq_strerror(zmq_errno()));
+        }
+    }
+#endif
+}
+
+std::vector<ThreadPlacement::Record> ThreadPlacement::records() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return records_;
+}
+
+void ThreadPlacement::log_report() const {
+    std::vector<Record> placed;
+    bool memory_locked = false;
+    size_t prefault_kb = 0;
+    int zmq_io_threads = 0;
+    std::vector<int> zmq_io_cpus;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        placed = records_;
+        memory_locked = memory_locked_;
+        prefault_kb = prefault_stack_kb_;
+        zmq_io_threads = zmq_io_threads_;
+        zmq_io_cpus = zmq_io_cpus_;
+    }
+
+    LOG_INFO_COMP("THREAD_PLACEMENT", "Thread placement (memory " + std::string(memory_locked ? "locked" : "unlocked") +
+                  ", stack prefault " + std::to_string(prefault_kb) + " KB, ZMQ I/O threads " +
+                  (zmq_io_threads > 0 ? std::to_string(zmq_io_threads) : std::string("default")) +
+                  " on core " + format_cpus(zmq_io_cpus) + "):");
+    for (const auto& record : placed) {
+        std::ostringstream line;
+        line << "  " << record.name << " tid=" << record.tid
+             << " cpu=" << (record.pinned ? format_cpus(record.cpus) : std::string("any"))
+             << " sched=" << (record.realtime ? "FIFO/" + std::to_string(record.priority) : std::string("OTHER"));
+        LOG_INFO_COMP("THREAD_PLACEMENT", line.str());
+    }
+}
+
+std::vector<int> ThreadPlacement::parse_cpu_list(const std::string& value) {
+    std::vector<int> cpus;
+    std::stringstream ss(value);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        size_t begin = item.find_first_not_of(" \t");
+        if (begin == std::string::npos) continue;
+        item = item.substr(begin, item.find_last_not_of(" \t") - begin + 1);
+        try {
+            // A leading '-' is a sign ("-1" = unpinned), any later one a range
+            size_t dash = item.find('-', 1);
+            int first = std::stoi(item.substr(0, dash));
+            int last = dash == std::string::npos ? first : std::stoi(item.substr(dash + 1));
+            for (int cpu = first; first >= 0 && cpu <= last && cpu < CPU_SETSIZE; ++cpu) {
+                cpus.push_back(cpu);
+            }
+        } catch (const std::exception&) {
+            // Malformed entry; skip it
+        }
+    }
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    return cpus;
+}
+
+std::string ThreadPlacement::config_key(const std::string& name) {
+    std::string key = name;
+    for (char& c : key) {
+        c = std::isalnum(static_cast<unsigned char>(c)) ? static_cast<char>(std::toupper(static_cast<unsigned char>(c))) : '_';
+    }
+    return key;
+}
+
+} // namespace app_service
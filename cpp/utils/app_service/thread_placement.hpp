@@ -0,0 +1,90 @@
+#pragma once
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace config {
+class ProcessConfigManager;
+}
+
+namespace app_service {
+
+/**
+ * Process-wide thread placement
+ *
+ * Reads the [THREADS] section once per process and applies it:
+ * - Per thread, keyed by the upper-cased thread name (non-alphanumerics
+ *   become '_', so "md_binance" -> MD_BINANCE):
+ *     <NAME>_CPU       core list to pin to, e.g. "3" or "2,4-5" (-1 = unpinned)
+ *     <NAME>_PRIORITY  SCHED_FIFO priority 1-99 (0 = normal scheduling)
+ *   A configured value overrides the default the caller passes in.
+ * - Process-wide:
+ *     MLOCK            mlockall(MCL_CURRENT | MCL_FUTURE) to avoid page faults
+ *     PREFAULT_STACK_KB  stack touched by every placed thread before it runs
+ *     ZMQ_IO_THREADS   I/O threads per ZMQ context (libzmq default 1)
+ *     ZMQ_IO_CPUS      core list for ZMQ I/O threads
+ *     ZMQ_IO_PRIORITY  SCHED_FIFO priority for ZMQ I/O threads
+ *
+ * Threads call place_current_thread() as they start; each placement is
+ * logged and recorded, and log_report() prints the table at startup.
+ * Failures (e.g. no CAP_SYS_NICE for SCHED_FIFO) are logged and the thread
+ * keeps running where it is.
+ */
+class ThreadPlacement {
+public:
+    struct Placement {
+        std::vector<int> cpus;   // Empty = unpinned
+        int priority{0};         // SCHED_FIFO priority, 0 = SCHED_OTHER
+    };
+
+    struct Record {
+        std::string name;
+        long tid{0};
+        std::vector<int> cpus;
+        int priority{0};
+        bool pinned{false};
+        bool realtime{false};
+    };
+
+    static ThreadPlacement& instance();
+
+    // Load [THREADS]; later calls replace the settings (threads already placed keep theirs)
+    void configure(const config::ProcessConfigManager& config);
+
+    // Lock current and future memory if MLOCK is set; returns false when that fails
+    bool apply_process_settings();
+
+    // Name the calling thread and apply its configured (or default) placement
+    Placement place_current_thread(const std::string& name, int default_cpu = -1, int default_priority = 0);
+
+    // Placement configured for `name`, falling back to the defaults
+    Placement placement_for(const std::string& name, int default_cpu = -1, int default_priority = 0) const;
+
+    // Apply ZMQ_IO_* to a context; call right after zmq_ctx_new(), before any socket
+    void configure_zmq_context(void* ctx) const;
+
+    std::vector<Record> records() const;
+    void log_report() const;
+
+    // "2,4-6" -> {2, 4, 5, 6}; negative or malformed entries are skipped
+    static std::vector<int> parse_cpu_list(const std::string& value);
+
+private:
+    ThreadPlacement() = default;
+
+    static std::string config_key(const std::string& name);
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::string> settings_;   // [THREADS] key -> value
+    bool lock_memory_{false};
+    size_t prefault_stack_kb_{0};
+    int zmq_io_threads_{0};                                    // 0 = libzmq default
+    std::vector<int> zmq_io_cpus_;
+    int zmq_io_priority_{0};
+    bool memory_locked_{false};
+    std::vector<Record> records_;
+};
+
+} // namespace app_service
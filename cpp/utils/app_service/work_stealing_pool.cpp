@@ -0,0 +1,165 @@
+#include "work_stealing_pool.hpp"
+#include "thread_placement.hpp"
+#include <algorithm>
+
+namespace app_service {
+
+WorkStealingPool::WorkStealingPool() : WorkStealingPool(Config{}) {}
+
+WorkStealingPool::WorkStealingPool(const Config& config) : config_(config) {
+    size_t threads = config_.threads;
+    if (threads == 0) {
+        threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+    range_storage_.reset(new Range[threads]);
+    for (size_t i = 0; i < threads; ++i) {
+        ranges_.push_back(&range_storage_[i]);
+    }
+    // Worker 0 is whichever thread calls parallel_for()
+    threads_.reserve(threads - 1);
+    for (size_t worker = 1; worker < threads; ++worker) {
+        threads_.emplace_back(&WorkStealingPool::worker_main, this, worker);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    start_cv_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+void WorkStealingPool::parallel_for(size_t count, size_t grain, const RangeBody& body) {
+    if (count == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> loop_lock(loop_mutex_);
+
+    // Contiguous, near-equal initial ranges
+    const size_t workers = ranges_.size();
+    for (size_t worker = 0; worker < workers; ++worker) {
+        Range& range = *ranges_[worker];
+        std::lock_guard<std::mutex> lock(range.mutex);
+        range.begin = count * worker / workers;
+        range.end = count * (worker + 1) / workers;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        body_ = &body;
+        grain_ = std::max<size_t>(1, grain);
+        failed_.store(false, std::memory_order_relaxed);
+        error_ = nullptr;
+        busy_workers_ = threads_.size();
+        ++generation_;
+    }
+    start_cv_.notify_all();
+    statistics_.loops.fetch_add(1, std::memory_order_relaxed);
+
+    run_loop(0);
+
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_cv_.wait(lock, [this] { return busy_workers_ == 0; });
+        body_ = nullptr;
+        error = error_;
+        error_ = nullptr;
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void WorkStealingPool::worker_main(size_t worker) {
+    ThreadPlacement::instance().place_current_thread(config_.thread_name + "_" + std::to_string(worker));
+
+    uint64_t seen_generation = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            start_cv_.wait(lock, [&] { return stopping_ || generation_ != seen_generation; });
+            if (stopping_) {
+                return;
+            }
+            seen_generation = generation_;
+        }
+
+        run_loop(worker);
+
+        bool last;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            last = --busy_workers_ == 0;
+        }
+        if (last) {
+            done_cv_.notify_one();
+        }
+    }
+}
+
+void WorkStealingPool::run_loop(size_t worker) {
+    size_t begin = 0;
+    size_t end = 0;
+    while (!failed_.load(std::memory_order_relaxed)) {
+        if (!take_chunk(worker, begin, end) && !(steal(worker) && take_chunk(worker, begin, end))) {
+            return;
+        }
+        try {
+            (*body_)(begin, end, worker);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!error_) {
+                error_ = std::current_exception();
+            }
+            failed_.store(true, std::memory_order_relaxed);
+            return;
+        }
+        statistics_.chunks.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+bool WorkStealingPool::take_chunk(size_t worker, size_t& begin, size_t& end) {
+    Range& range = *ranges_[worker];
+    std::lock_guard<std::mutex> lock(range.mutex);
+    if (range.begin == range.end) {
+        return false;
+    }
+    begin = range.begin;
+    end = std::min(range.end, range.begin + grain_);
+    range.begin = end;
+    return true;
+}
+
+// Moves the back half of the first non-empty range after ours into ours
+bool WorkStealingPool::steal(size_t worker) {
+    const size_t workers = ranges_.size();
+    for (size_t offset = 1; offset < workers; ++offset) {
+        Range& victim = *ranges_[(worker + offset) % workers];
+        size_t begin;
+        size_t end;
+        {
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            const size_t remaining = victim.end - victim.begin;
+            if (remaining == 0) {
+                continue;
+            }
+            end = victim.end;
+            begin = end - (remaining + 1) / 2;
+            victim.end = begin;
+        }
+        Range& own = *ranges_[worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        own.begin = begin;
+        own.end = end;
+        statistics_.steals.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+} // namespace app_service
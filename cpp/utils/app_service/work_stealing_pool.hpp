@@ -0,0 +1,96 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace app_service {
+
+/**
+ * Fixed pool of worker threads for data-parallel loops
+ *
+ * parallel_for() splits [0, count) into one contiguous range per worker.
+ * Each worker takes `grain`-sized chunks from the front of its own range;
+ * once that is empty it steals the back half of another worker's range, so
+ * uneven chunk costs even out without a shared queue. The calling thread
+ * takes part as worker 0, and `worker` passed to the body is stable for a
+ * chunk, so per-worker scratch buffers need no locking.
+ *
+ * Workers are started once and reused; each is placed through
+ * ThreadPlacement as "<thread_name>_<n>" ([THREADS] POOL_1_CPU etc.).
+ * The first exception thrown by the body stops the remaining chunks and
+ * is rethrown from parallel_for(). One loop runs at a time; the body must
+ * not call parallel_for() on the same pool.
+ */
+class WorkStealingPool {
+public:
+    // Runs items [begin, end) on `worker`
+    using RangeBody = std::function<void(size_t begin, size_t end, size_t worker)>;
+
+    struct Config {
+        size_t threads{0};                 // Workers including the caller; 0 = hardware concurrency
+        std::string thread_name{"pool"};
+    };
+
+    struct Statistics {
+        std::atomic<uint64_t> loops{0};
+        std::atomic<uint64_t> chunks{0};
+        std::atomic<uint64_t> steals{0};
+    };
+
+    WorkStealingPool();
+    explicit WorkStealingPool(const Config& config);
+    ~WorkStealingPool();
+
+    // Non-copyable
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // Blocks until every item has run (or the body threw); grain 0 is taken as 1
+    void parallel_for(size_t count, size_t grain, const RangeBody& body);
+
+    size_t size() const { return ranges_.size(); }
+    const Statistics& get_statistics() const { return statistics_; }
+
+private:
+    // Unclaimed items of one worker; a cache line each so neighbours do not contend
+    struct alignas(64) Range {
+        std::mutex mutex;
+        size_t begin{0};
+        size_t end{0};
+    };
+
+    void worker_main(size_t worker);
+    void run_loop(size_t worker);
+    bool take_chunk(size_t worker, size_t& begin, size_t& end);
+    bool steal(size_t worker);
+
+    Config config_;
+    std::unique_ptr<Range[]> range_storage_;
+    std::vector<Range*> ranges_;
+    std::vector<std::thread> threads_;
+
+    // Current loop, published under mutex_ by bumping generation_
+    std::mutex loop_mutex_;                // One parallel_for at a time
+    std::mutex mutex_;
+    std::condition_variable start_cv_;
+    std::condition_variable done_cv_;
+    uint64_t generation_{0};
+    size_t busy_workers_{0};
+    bool stopping_{false};
+    const RangeBody* body_{nullptr};
+    size_t grain_{1};
+    std::atomic<bool> failed_{false};
+    std::exception_ptr error_;
+
+    Statistics statistics_;
+};
+
+} // namespace app_service
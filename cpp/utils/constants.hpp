@@ -28,7 +28,6 @@ namespace retry {
 
 // Polling intervals (in milliseconds)
 namespace polling {
-    constexpr int OMS_EVENT_POLL_INTERVAL_MS = 50;        // 50ms for responsive event handling
     constexpr int OMS_LOG_INTERVAL = 100;                 // Log every 100 iterations
     constexpr int STATUS_LOG_INTERVAL_SECONDS = 300;      // 5 minutes
 }
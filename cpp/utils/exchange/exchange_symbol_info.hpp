@@ -1,4 +1,5 @@
 #pragma once
+#include <cmath>
 #include <string>
 #include <map>
 
@@ -41,3 +42,111 @@ struct ExchangeSymbolInfo {
           price_precision(price_prec), qty_precision(qty_prec), is_valid(true) {}
 };
 
+
+/**
+ * Hot-path view of an ExchangeSymbolInfo
+ *
+ * Reciprocals, decimal scales and the contract multiplier are computed once
+ * when the symbol is loaded, so rounding is a multiply and a floor and
+ * contract conversion is a multiply, with no strings touched.
+ */
+struct InstrumentSpec {
+    enum class Denomination { NONE, BASE, QUOTE };
+
+    double tick_size{0.0};
+    double inv_tick_size{0.0};
+    double price_scale{1.0};      // 10^price_precision
+    double step_size{0.0};
+    double inv_step_size{0.0};
+    double qty_scale{1.0};        // 10^qty_precision
+    double min_order_size{0.0};
+    double max_order_size{0.0};
+
+    // Contracts -> tokens: contracts * contract_multiplier, then / price when
+    // the contract is quote-denominated (USD, USDC, USDT)
+    Denomination denomination{Denomination::NONE};
+    double contract_multiplier{0.0};
+    double inv_contract_multiplier{0.0};
+
+    bool is_valid{false};
+
+    InstrumentSpec() = default;
+
+    explicit InstrumentSpec(const ExchangeSymbolInfo& info)
+        : tick_size(info.tick_size), step_size(info.step_size),
+          min_order_size(info.min_order_size), max_order_size(info.max_order_size),
+          is_valid(info.is_valid) {
+        inv_tick_size = tick_size > 0.0 ? 1.0 / tick_size : 0.0;
+        inv_step_size = step_size > 0.0 ? 1.0 / step_size : 0.0;
+        price_scale = std::pow(10.0, info.price_precision);
+        qty_scale = std::pow(10.0, info.qty_precision);
+
+        const std::string& unit = info.contract_size_denomination;
+        if (unit == "BTC" || unit == "ETH" || unit == "SOL") {
+            denomination = Denomination::BASE;
+        } else if (unit == "USDC" || unit == "USDT" || unit == "USD") {
+            denomination = Denomination::QUOTE;
+        }
+        if (info.contract_size > 0.0 && denomination != Denomination::NONE) {
+            contract_multiplier = info.contract_size;
+            inv_contract_multiplier = 1.0 / info.contract_size;
+        } else {
+            denomination = Denomination::NONE;
+        }
+    }
+
+    // Down to the tick, then to price_precision decimals
+    double round_price(double price) const {
+        if (!is_valid || tick_size <= 0.0) {
+            return price;
+        }
+        double rounded = std::floor(price * inv_tick_size + 1e-9) * tick_size;
+        return std::round(rounded * price_scale) / price_scale;
+    }
+
+    // Down to the step, then to qty_precision decimals
+    double round_qty(double qty) const {
+        if (!is_valid || step_size <= 0.0) {
+            return qty;
+        }
+        double rounded = std::floor(qty * inv_step_size + 1e-9) * step_size;
+        return std::round(rounded * qty_scale) / qty_scale;
+    }
+
+    // Size limits and tick/step alignment (to within 1e-10)
+    bool accepts(double qty, double price) const {
+        if (!is_valid || qty <= 0.0 || price <= 0.0) {
+            return false;
+        }
+        if ((min_order_size > 0.0 && qty < min_order_size) ||
+            (max_order_size > 0.0 && qty > max_order_size)) {
+            return false;
+        }
+        if (tick_size > 0.0) {
+            double ticks = price * inv_tick_size;
+            if (std::abs(ticks - std::nearbyint(ticks)) * tick_size > 1e-10) {
+                return false;
+            }
+        }
+        if (step_size > 0.0) {
+            double steps = qty * inv_step_size;
+            if (std::abs(steps - std::nearbyint(steps)) * step_size > 1e-10) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool can_convert() const { return is_valid && denomination != Denomination::NONE; }
+
+    // Callers check can_convert() and price > 0
+    double contracts_to_tokens(double contracts, double price) const {
+        double tokens = contracts * contract_multiplier;
+        return denomination == Denomination::QUOTE ? tokens / price : tokens;
+    }
+
+    double tokens_to_contracts(double tokens, double price) const {
+        double contracts = tokens * inv_contract_multiplier;
+        return denomination == Denomination::QUOTE ? contracts * price : contracts;
+    }
+};
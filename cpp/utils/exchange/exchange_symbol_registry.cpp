@@ -7,14 +7,44 @@
 #include <cmath>
 #include <iomanip>
 
+namespace {
+
+const ExchangeSymbolInfo kUnknownSymbolInfo;
+const InstrumentSpec kUnknownInstrumentSpec;
+
+} // namespace
+
+ExchangeSymbolRegistry::ExchangeSymbolRegistry() {
+    snapshots_.push_back(std::make_unique<const Snapshot>());
+    current_.store(snapshots_.back().get(), std::memory_order_release);
+}
+
+ExchangeSymbolRegistry::InstrumentHandle ExchangeSymbolRegistry::find_instrument(
+    const std::string& exchange, const std::string& symbol) const {
+    const Snapshot& current = snapshot();
+    auto it = current.handles.find(make_key(exchange, symbol));
+    return it != current.handles.end() ? it->second : kInvalidInstrument;
+}
+
+const ExchangeSymbolInfo& ExchangeSymbolRegistry::symbol_info(InstrumentHandle handle) const {
+    const Snapshot& current = snapshot();
+    return handle < current.infos.size() ? current.infos[handle] : kUnknownSymbolInfo;
+}
+
+const InstrumentSpec& ExchangeSymbolRegistry::instrument_spec(InstrumentHandle handle) const {
+    const Snapshot& current = snapshot();
+    return handle < current.specs.size() ? current.specs[handle] : kUnknownInstrumentSpec;
+}
+
+size_t ExchangeSymbolRegistry::instrument_count() const {
+    return snapshot().specs.size();
+}
+
 ExchangeSymbolInfo ExchangeSymbolRegistry::get_symbol_info(
     const std::string& exchange, const std::string& symbol) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    std::string key = make_key(exchange, symbol);
-    auto it = symbol_info_map_.find(key);
-    if (it != symbol_info_map_.end()) {
-        return it->second;
+    InstrumentHandle handle = find_instrument(exchange, symbol);
+    if (handle != kInvalidInstrument) {
+        return symbol_info(handle);
     }
     
     // Return invalid info if not found
@@ -27,150 +57,101 @@ ExchangeSymbolInfo ExchangeSymbolRegistry::get_symbol_info(
 
 bool ExchangeSymbolRegistry::has_symbol_info(
     const std::string& exchange, const std::string& symbol) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    std::string key = make_key(exchange, symbol);
-    return symbol_info_map_.find(key) != symbol_info_map_.end();
+    return find_instrument(exchange, symbol) != kInvalidInstrument;
 }
 
 double ExchangeSymbolRegistry::round_to_tick(
     double price, const ExchangeSymbolInfo& info) const {
-    if (!info.is_valid || info.tick_size <= 0.0) {
-        return price; // Cannot round without valid tick size
-    }
-    
-    // Round down to nearest tick
-    double rounded = std::floor(price / info.tick_size) * info.tick_size;
-    
-    // Round to precision to avoid floating point issues
-    double multiplier = std::pow(10.0, info.price_precision);
-    return std::round(rounded * multiplier) / multiplier;
+    return InstrumentSpec(info).round_price(price);
 }
 
 double ExchangeSymbolRegistry::round_to_step(
     double qty, const ExchangeSymbolInfo& info) const {
-    if (!info.is_valid || info.step_size <= 0.0) {
-        return qty; // Cannot round without valid step size
-    }
-    
-    // Round down to nearest step
-    double rounded = std::floor(qty / info.step_size) * info.step_size;
-    
-    // Round to precision to avoid floating point issues
-    double multiplier = std::pow(10.0, info.qty_precision);
-    return std::round(rounded * multiplier) / multiplier;
+    return InstrumentSpec(info).round_qty(qty);
 }
 
 bool ExchangeSymbolRegistry::validate_order_params(
     const ExchangeSymbolInfo& info, double qty, double price) const {
-    if (!info.is_valid) {
-        return false; // Cannot validate without symbol info
-    }
-    
-    // Validate quantity
-    if (qty <= 0.0) {
-        return false;
-    }
-    
-    if (info.min_order_size > 0.0 && qty < info.min_order_size) {
-        return false;
-    }
-    
-    if (info.max_order_size > 0.0 && qty > info.max_order_size) {
-        return false;
-    }
-    
-    // Validate price
-    if (price <= 0.0) {
-        return false;
-    }
-    
-    // Validate tick size alignment
-    if (info.tick_size > 0.0) {
-        double remainder = std::fmod(price, info.tick_size);
-        // Allow small floating point errors
-        if (remainder > 1e-10 && remainder < (info.tick_size - 1e-10)) {
-            return false;
-        }
-    }
-    
-    // Validate step size alignment
-    if (info.step_size > 0.0) {
-        double remainder = std::fmod(qty, info.step_size);
-        // Allow small floating point errors
-        if (remainder > 1e-10 && remainder < (info.step_size - 1e-10)) {
-            return false;
-        }
-    }
-    
-    return true;
+    return InstrumentSpec(info).accepts(qty, price);
 }
 
 bool ExchangeSymbolRegistry::validate_and_round(
     const std::string& exchange, const std::string& symbol,
     double& qty, double& price) const {
-    ExchangeSymbolInfo info = get_symbol_info(exchange, symbol);
-    
-    if (!info.is_valid) {
+    InstrumentHandle handle = find_instrument(exchange, symbol);
+    if (handle == kInvalidInstrument) {
         // If no symbol info, allow order but log warning
         LOG_WARN_COMP("SYMBOL_REGISTRY", 
                      "No symbol info for " + exchange + ":" + symbol + 
                      " - skipping validation");
         return true; // Allow order if no config
     }
+    return validate_and_round(handle, qty, price);
+}
+
+bool ExchangeSymbolRegistry::validate_and_round(
+    InstrumentHandle handle, double& qty, double& price) const {
+    const InstrumentSpec& spec = instrument_spec(handle);
+    if (!spec.is_valid) {
+        LOG_WARN_COMP("SYMBOL_REGISTRY", 
+                     "No symbol info for instrument " + std::to_string(handle) + 
+                     " - skipping validation");
+        return true; // Allow order if no config
+    }
     
-    // Round quantities and prices
     double original_qty = qty;
     double original_price = price;
-    
-    qty = round_to_step(qty, info);
-    price = round_to_tick(price, info);
+    qty = spec.round_qty(qty);
+    price = spec.round_price(price);
     
     // Validate after rounding
-    if (!validate_order_params(info, qty, price)) {
+    if (!spec.accepts(qty, price)) {
+        const ExchangeSymbolInfo& info = symbol_info(handle);
         LOG_ERROR_COMP("SYMBOL_REGISTRY",
-                      "Order validation failed for " + exchange + ":" + symbol +
+                      "Order validation failed for " + info.exchange + ":" + info.symbol +
                       " qty=" + std::to_string(original_qty) + "->" + std::to_string(qty) +
                       " price=" + std::to_string(original_price) + "->" + std::to_string(price));
         return false;
     }
-    
-    // Log if rounding occurred
-    if (std::abs(original_qty - qty) > 1e-10 || std::abs(original_price - price) > 1e-10) {
-        LOG_DEBUG_COMP("SYMBOL_REGISTRY",
-                      "Rounded order params for " + exchange + ":" + symbol +
-                      " qty: " + std::to_string(original_qty) + " -> " + std::to_string(qty) +
-                      " price: " + std::to_string(original_price) + " -> " + std::to_string(price));
-    }
-    
     return true;
 }
 
 bool ExchangeSymbolRegistry::validate_only(const std::string& exchange,
                                            const std::string& symbol,
                                            double qty, double price) const {
-    ExchangeSymbolInfo info = get_symbol_info(exchange, symbol);
-    
-    if (!info.is_valid) {
+    InstrumentHandle handle = find_instrument(exchange, symbol);
+    if (handle == kInvalidInstrument) {
         // If no symbol info, allow order but log warning
         LOG_WARN_COMP("SYMBOL_REGISTRY", 
                      "No symbol info for " + exchange + ":" + symbol + 
                      " - skipping validation");
         return true; // Allow order if no config
     }
+    return validate_only(handle, qty, price);
+}
+
+bool ExchangeSymbolRegistry::validate_only(InstrumentHandle handle, double qty, double price) const {
+    const InstrumentSpec& spec = instrument_spec(handle);
+    if (!spec.is_valid) {
+        LOG_WARN_COMP("SYMBOL_REGISTRY", 
+                     "No symbol info for instrument " + std::to_string(handle) + 
+                     " - skipping validation");
+        return true; // Allow order if no config
+    }
     
     // Validate against exchange-specific constraints (assume already rounded)
-    if (!validate_order_params(info, qty, price)) {
+    if (!spec.accepts(qty, price)) {
+        const ExchangeSymbolInfo& info = symbol_info(handle);
         LOG_ERROR_COMP("SYMBOL_REGISTRY",
-                      "Order validation failed for " + exchange + ":" + symbol +
+                      "Order validation failed for " + info.exchange + ":" + info.symbol +
                       " qty=" + std::to_string(qty) + " price=" + std::to_string(price));
         return false;
     }
-    
     return true;
 }
 
 bool ExchangeSymbolRegistry::load_from_config(const std::string& config_file_path) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<std::mutex> lock(writer_mutex_);
     
     LOG_INFO_COMP("SYMBOL_REGISTRY", "Loading symbol info from: " + config_file_path);
     
@@ -184,6 +165,9 @@ bool ExchangeSymbolRegistry::load_from_config(const std::string& config_file_pat
     // Format: [EXCHANGE:SYMBOL] or [SYMBOL] (default exchange)
     std::vector<std::string> sections = config_manager.get_sections();
     
+    // New symbols are merged into a copy of the current snapshot; existing
+    // ones keep their handles
+    auto next = std::make_unique<Snapshot>(snapshot());
     int loaded_count = 0;
     for (const auto& section : sections) {
         // Parse section name - could be "EXCHANGE:SYMBOL" or just "SYMBOL"
@@ -229,7 +213,15 @@ bool ExchangeSymbolRegistry::load_from_config(const std::string& config_file_pat
         info.contract_size_denomination = contract_size_denomination;
         
         std::string key = make_key(exchange, symbol);
-        symbol_info_map_[key] = info;
+        auto handle_it = next->handles.find(key);
+        if (handle_it == next->handles.end()) {
+            handle_it = next->handles.emplace(key, static_cast<InstrumentHandle>(next->infos.size())).first;
+            next->infos.push_back(info);
+            next->specs.emplace_back(info);
+        } else {
+            next->infos[handle_it->second] = info;
+            next->specs[handle_it->second] = InstrumentSpec(info);
+        }
         loaded_count++;
         
         std::string log_msg = "Loaded " + exchange + ":" + symbol +
@@ -244,6 +236,11 @@ bool ExchangeSymbolRegistry::load_from_config(const std::string& config_file_pat
         LOG_DEBUG_COMP("SYMBOL_REGISTRY", log_msg);
     }
     
+    if (loaded_count > 0) {
+        snapshots_.push_back(std::move(next));
+        current_.store(snapshots_.back().get(), std::memory_order_release);
+    }
+    
     LOG_INFO_COMP("SYMBOL_REGISTRY", 
                  "Loaded " + std::to_string(loaded_count) + " symbol configurations");
     
@@ -260,75 +257,14 @@ double ExchangeSymbolRegistry::token_qty_to_contracts(
     const std::string& symbol,
     double token_qty,
     double price) const {
-    
-    ExchangeSymbolInfo info = get_symbol_info(exchange, symbol);
-    
-    if (!info.is_valid) {
+    InstrumentHandle handle = find_instrument(exchange, symbol);
+    if (handle == kInvalidInstrument) {
         LOG_ERROR_COMP("SYMBOL_REGISTRY",
                       "Cannot convert token_qty to contracts: no symbol info for " +
                       exchange + ":" + symbol);
         return 0.0;
     }
-    
-    if (info.contract_size <= 0.0 || info.contract_size_denomination.empty()) {
-        LOG_ERROR_COMP("SYMBOL_REGISTRY",
-                      "Cannot convert token_qty to contracts: contract_size not configured for " +
-                      exchange + ":" + symbol);
-        return 0.0;
-    }
-    
-    if (price <= 0.0) {
-        LOG_ERROR_COMP("SYMBOL_REGISTRY",
-                      "Cannot convert token_qty to contracts: invalid price " +
-                      std::to_string(price) + " for " + exchange + ":" + symbol);
-        return 0.0;
-    }
-    
-    // Calculate notional USD value of the token quantity
-    double notional_usd = token_qty * price;
-    
-    // Calculate contract size in USD
-    double contract_size_usd = 0.0;
-    
-    if (info.contract_size_denomination == "BTC" || 
-        info.contract_size_denomination == "ETH" ||
-        info.contract_size_denomination == "SOL") {
-        // Contract size is in base token (BTC, ETH, etc.)
-        // Need to convert to USD using the same price
-        contract_size_usd = info.contract_size * price;
-    } else if (info.contract_size_denomination == "USDC" ||
-               info.contract_size_denomination == "USDT" ||
-               info.contract_size_denomination == "USD") {
-        // Contract size is already in USD terms
-        contract_size_usd = info.contract_size;
-    } else {
-        LOG_ERROR_COMP("SYMBOL_REGISTRY",
-                      "Unknown contract_size_denomination: " + info.contract_size_denomination +
-                      " for " + exchange + ":" + symbol);
-        return 0.0;
-    }
-    
-    if (contract_size_usd <= 0.0) {
-        LOG_ERROR_COMP("SYMBOL_REGISTRY",
-                      "Invalid contract_size_usd calculated: " +
-                      std::to_string(contract_size_usd) + " for " + exchange + ":" + symbol);
-        return 0.0;
-    }
-    
-    // Calculate number of contracts
-    double contracts = notional_usd / contract_size_usd;
-    
-    LOG_DEBUG_COMP("SYMBOL_REGISTRY",
-                  "token_qty_to_contracts: " + exchange + ":" + symbol +
-                  " token_qty=" + std::to_string(token_qty) +
-                  " price=" + std::to_string(price) +
-                  " notional_usd=" + std::to_string(notional_usd) +
-                  " contract_size=" + std::to_string(info.contract_size) +
-                  " " + info.contract_size_denomination +
-                  " contract_size_usd=" + std::to_string(contract_size_usd) +
-                  " contracts=" + std::to_string(contracts));
-    
-    return contracts;
+    return token_qty_to_contracts(handle, token_qty, price);
 }
 
 double ExchangeSymbolRegistry::contracts_to_token_qty(
@@ -336,73 +272,51 @@ double ExchangeSymbolRegistry::contracts_to_token_qty(
     const std::string& symbol,
     double contracts,
     double price) const {
-    
-    ExchangeSymbolInfo info = get_symbol_info(exchange, symbol);
-    
-    if (!info.is_valid) {
+    InstrumentHandle handle = find_instrument(exchange, symbol);
+    if (handle == kInvalidInstrument) {
         LOG_ERROR_COMP("SYMBOL_REGISTRY",
                       "Cannot convert contracts to token_qty: no symbol info for " +
                       exchange + ":" + symbol);
         return 0.0;
     }
-    
-    if (info.contract_size <= 0.0 || info.contract_size_denomination.empty()) {
-        LOG_ERROR_COMP("SYMBOL_REGISTRY",
-                      "Cannot convert contracts to token_qty: contract_size not configured for " +
-                      exchange + ":" + symbol);
+    return contracts_to_token_qty(handle, contracts, price);
+}
+
+double ExchangeSymbolRegistry::token_qty_to_contracts(
+    InstrumentHandle handle, double token_qty, double price) const {
+    const InstrumentSpec& spec = instrument_spec(handle);
+    if (!spec.can_convert() || price <= 0.0) {
+        log_conversion_failure("token_qty to contracts", handle, price);
         return 0.0;
     }
-    
-    if (price <= 0.0) {
-        LOG_ERROR_COMP("SYMBOL_REGISTRY",
-                      "Cannot convert contracts to token_qty: invalid price " +
-                      std::to_string(price) + " for " + exchange + ":" + symbol);
+    return spec.tokens_to_contracts(token_qty, price);
+}
+
+double ExchangeSymbolRegistry::contracts_to_token_qty(
+    InstrumentHandle handle, double contracts, double price) const {
+    const InstrumentSpec& spec = instrument_spec(handle);
+    if (!spec.can_convert() || price <= 0.0) {
+        log_conversion_failure("contracts to token_qty", handle, price);
         return 0.0;
     }
-    
-    // Calculate contract size in USD
-    double contract_size_usd = 0.0;
-    
-    if (info.contract_size_denomination == "BTC" || 
-        info.contract_size_denomination == "ETH" ||
-        info.contract_size_denomination == "SOL") {
-        // Contract size is in base token (BTC, ETH, etc.)
-        contract_size_usd = info.contract_size * price;
-    } else if (info.contract_size_denomination == "USDC" ||
-               info.contract_size_denomination == "USDT" ||
-               info.contract_size_denomination == "USD") {
-        // Contract size is already in USD terms
-        contract_size_usd = info.contract_size;
+    return spec.contracts_to_tokens(contracts, price);
+}
+
+void ExchangeSymbolRegistry::log_conversion_failure(
+    const char* direction, InstrumentHandle handle, double price) const {
+    const ExchangeSymbolInfo& info = symbol_info(handle);
+    const InstrumentSpec& spec = instrument_spec(handle);
+    std::string name = spec.is_valid ? info.exchange + ":" + info.symbol
+                                     : "instrument " + std::to_string(handle);
+    std::string reason;
+    if (!spec.is_valid) {
+        reason = "no symbol info for " + name;
+    } else if (info.contract_size <= 0.0 || info.contract_size_denomination.empty()) {
+        reason = "contract_size not configured for " + name;
+    } else if (spec.denomination == InstrumentSpec::Denomination::NONE) {
+        reason = "unknown contract_size_denomination " + info.contract_size_denomination + " for " + name;
     } else {
-        LOG_ERROR_COMP("SYMBOL_REGISTRY",
-                      "Unknown contract_size_denomination: " + info.contract_size_denomination +
-                      " for " + exchange + ":" + symbol);
-        return 0.0;
-    }
-    
-    if (contract_size_usd <= 0.0) {
-        LOG_ERROR_COMP("SYMBOL_REGISTRY",
-                      "Invalid contract_size_usd calculated: " +
-                      std::to_string(contract_size_usd) + " for " + exchange + ":" + symbol);
-        return 0.0;
+        reason = "invalid price " + std::to_string(price) + " for " + name;
     }
-    
-    // Calculate notional USD value
-    double notional_usd = contracts * contract_size_usd;
-    
-    // Convert notional USD to token quantity
-    double token_qty = notional_usd / price;
-    
-    LOG_DEBUG_COMP("SYMBOL_REGISTRY",
-                  "contracts_to_token_qty: " + exchange + ":" + symbol +
-                  " contracts=" + std::to_string(contracts) +
-                  " contract_size=" + std::to_string(info.contract_size) +
-                  " " + info.contract_size_denomination +
-                  " contract_size_usd=" + std::to_string(contract_size_usd) +
-                  " notional_usd=" + std::to_string(notional_usd) +
-                  " price=" + std::to_string(price) +
-                  " token_qty=" + std::to_string(token_qty));
-    
-    return token_qty;
+    LOG_ERROR_COMP("SYMBOL_REGISTRY", "Cannot convert " + std::string(direction) + ": " + reason);
 }
-
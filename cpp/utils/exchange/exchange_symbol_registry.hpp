@@ -1,18 +1,35 @@
 #pragma once
 #include "exchange_symbol_info.hpp"
-#include <map>
-#include <mutex>
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 /**
  * Exchange Symbol Registry
  * 
  * Manages exchange-specific symbol information for order validation.
  * Loads symbol info from configuration files and provides validation utilities.
+ *
+ * Every loaded "exchange:symbol" gets an InstrumentHandle, a small integer
+ * that stays the same for the life of the process, reloads included. Readers
+ * go through an immutable snapshot published with one atomic pointer store:
+ * a load copies the current snapshot, merges the new symbols and publishes
+ * the copy. Old snapshots are kept until the registry is destroyed, so a
+ * reference obtained from one never dangles and readers take no lock.
+ * Symbol info changes about once a day, which makes keeping them cheap.
+ *
+ * Hot paths resolve a handle once and then call the handle overloads, which
+ * neither lock nor allocate.
  */
 class ExchangeSymbolRegistry {
 public:
+    using InstrumentHandle = uint32_t;
+    static constexpr InstrumentHandle kInvalidInstrument = UINT32_MAX;
+
     static ExchangeSymbolRegistry& get_instance() {
         static ExchangeSymbolRegistry instance;
         return instance;
@@ -21,6 +38,18 @@ public:
     // Load symbol info from config file
     bool load_from_config(const std::string& config_file_path);
     
+    // Handle for a loaded symbol, or kInvalidInstrument
+    InstrumentHandle find_instrument(const std::string& exchange,
+                                     const std::string& symbol) const;
+    
+    // Symbol info and precomputed spec by handle; an unknown handle gets an
+    // invalid entry. References stay valid for the life of the registry.
+    const ExchangeSymbolInfo& symbol_info(InstrumentHandle handle) const;
+    const InstrumentSpec& instrument_spec(InstrumentHandle handle) const;
+    
+    // Number of handles handed out so far
+    size_t instrument_count() const;
+    
     // Get symbol info (returns empty/invalid info if not found)
     ExchangeSymbolInfo get_symbol_info(const std::string& exchange, 
                                       const std::string& symbol) const;
@@ -73,16 +102,34 @@ public:
                                  double contracts,
                                  double price) const;
     
+    // Handle overloads of the above: no lock, no allocation on success
+    bool validate_and_round(InstrumentHandle handle, double& qty, double& price) const;
+    bool validate_only(InstrumentHandle handle, double qty, double price) const;
+    double token_qty_to_contracts(InstrumentHandle handle, double token_qty, double price) const;
+    double contracts_to_token_qty(InstrumentHandle handle, double contracts, double price) const;
+    
 private:
-    ExchangeSymbolRegistry() = default;
+    ExchangeSymbolRegistry();
     ~ExchangeSymbolRegistry() = default;
     ExchangeSymbolRegistry(const ExchangeSymbolRegistry&) = delete;
     ExchangeSymbolRegistry& operator=(const ExchangeSymbolRegistry&) = delete;
     
-    // Key format: "exchange:symbol"
-    std::map<std::string, ExchangeSymbolInfo> symbol_info_map_;
-    mutable std::mutex mutex_;
+    // Immutable once published; both vectors are indexed by handle
+    struct Snapshot {
+        std::vector<ExchangeSymbolInfo> infos;
+        std::vector<InstrumentSpec> specs;
+        std::unordered_map<std::string, InstrumentHandle> handles;   // "exchange:symbol"
+    };
+    
+    const Snapshot& snapshot() const { return *current_.load(std::memory_order_acquire); }
+    
+    std::atomic<const Snapshot*> current_{nullptr};
+    // Every snapshot ever published, freed with the registry
+    std::vector<std::unique_ptr<const Snapshot>> snapshots_;
+    // Serializes loads only; readers never take it
+    std::mutex writer_mutex_;
     
     std::string make_key(const std::string& exchange, const std::string& symbol) const;
+    void log_conversion_failure(const char* direction, InstrumentHandle handle, double price) const;
 };
 
@@ -1,5 +1,6 @@
 #pragma once
 #include "i_http_handler.hpp"
+#include "http_connection_pool.hpp"
 #include <iostream>
 #include <stdexcept>
 #include <string>
@@ -7,14 +8,10 @@
 #include <memory>
 #include <thread>
 
-#ifdef CURL_FOUND
-#include <curl/curl.h>
-#else
-// Forward declaration for when CURL is not available
-struct CURL;
-#endif
-
 // CURL-based HTTP handler implementation
+//
+// Requests run on a shared keep-alive HttpConnectionPool, so connections
+// are reused and concurrent requests no longer serialise on one handle.
 class CurlHttpHandler : public IHttpHandler {
 public:
     CurlHttpHandler();
@@ -32,25 +29,15 @@ public:
     void set_verify_ssl(bool verify) override { verify_ssl_ = verify; }
 
 private:
-    struct WriteCallbackData {
-        std::string* buffer;
-        HttpResponse* response;
-    };
-    
-    static size_t WriteCallback(void* contents, size_t size, size_t nmemb, WriteCallbackData* data);
-    static size_t HeaderCallback(void* contents, size_t size, size_t nmemb, WriteCallbackData* data);
-    
-    void setup_curl_options(CURL* curl, const HttpRequest& request, WriteCallbackData& data);
-    void add_headers_to_curl(CURL* curl, const std::map<std::string, std::string>& headers);
+    // Apply handler defaults to a request before it is queued
+    HttpRequest with_defaults(const HttpRequest& request) const;
     
     bool initialized_{false};
     int default_timeout_ms_{5000};
     std::map<std::string, std::string> default_headers_;
     bool verify_ssl_{true};
     
-#ifdef CURL_FOUND
-    CURL* curl_{nullptr};
-#endif
+    std::shared_ptr<HttpConnectionPool> pool_;
 };
 
 // Factory implementation
@@ -0,0 +1,61 @@
+#pragma once
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+
+/**
+ * HMAC-SHA256 request signer
+ *
+ * The digest and its hex encoding go into caller-provided stack buffers:
+ * no heap allocation, no sprintf, and, unlike HMAC() with a null output
+ * buffer, safe to call from several threads at once.
+ */
+class HmacSha256Signer {
+public:
+    static constexpr size_t kHexLength = 64;
+
+    HmacSha256Signer() = default;
+    explicit HmacSha256Signer(std::string secret) : secret_(std::move(secret)) {}
+
+    void set_secret(std::string secret) { secret_ = std::move(secret); }
+    bool has_secret() const { return !secret_.empty(); }
+
+    /**
+     * Sign data as lowercase hex
+     *
+     * @param out Receives exactly kHexLength characters (not null-terminated)
+     * @return false if OpenSSL failed
+     */
+    bool sign_hex(std::string_view data, char (&out)[kHexLength]) const {
+        unsigned char digest[EVP_MAX_MD_SIZE];
+        unsigned int digest_length = 0;
+        if (!HMAC(EVP_sha256(), secret_.data(), static_cast<int>(secret_.size()),
+                  reinterpret_cast<const unsigned char*>(data.data()), data.size(),
+                  digest, &digest_length) || digest_length * 2 != kHexLength) {
+            return false;
+        }
+
+        static constexpr char kHex[] = "0123456789abcdef";
+        for (unsigned int i = 0; i < digest_length; ++i) {
+            out[2 * i] = kHex[digest[i] >> 4];
+            out[2 * i + 1] = kHex[digest[i] & 0x0F];
+        }
+        return true;
+    }
+
+    // Append "&signature=<hex>" (or another parameter prefix) to query in place
+    bool append_signature(std::string& query, std::string_view prefix = "&signature=") const {
+        char signature[kHexLength];
+        if (!sign_hex(query, signature)) {
+            return false;
+        }
+        query.append(prefix.data(), prefix.size()).append(signature, kHexLength);
+        return true;
+    }
+
+private:
+    std::string secret_;
+};
@@ -0,0 +1,368 @@
+#include "http_connection_pool.hpp"
+#include <algorithm>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#ifdef CURL_FOUND
+#include <curl/curl.h>
+#endif
+
+// In-flight request; owned by the pool from submit until delivery
+struct HttpConnectionPool::Transfer {
+    HttpRequest request;
+    std::shared_ptr<const HttpRequestTemplate> request_template;
+    HttpResponseCallback callback;
+    std::promise<HttpResponse> promise;
+    bool has_promise{false};
+
+    HttpResponse response;
+    std::string url;
+    curl_slist* extra_headers{nullptr};   // Per-request headers, freed on completion
+    bool warm_up{false};
+};
+
+HttpRequestTemplate::HttpRequestTemplate(std::string base_url, const std::map<std::string, std::string>& static_headers)
+    : base_url_(std::move(base_url)) {
+#ifdef CURL_FOUND
+    for (const auto& [key, value] : static_headers) {
+        std::string header = key + ": " + value;
+        header_list_ = curl_slist_append(header_list_, header.c_str());
+    }
+#else
+    (void)static_headers;
+#endif
+}
+
+HttpRequestTemplate::~HttpRequestTemplate() {
+#ifdef CURL_FOUND
+    curl_slist_free_all(header_list_);
+#endif
+}
+
+HttpConnectionPool::HttpConnectionPool(const HttpConnectionPoolConfig& config)
+    // The worker is woken with curl_multi_wakeup(), not the ring's waiter
+    : config_(config), pending_(config.queue_capacity, WaitStrategy::BUSY_SPIN) {
+#ifdef CURL_FOUND
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+
+    CURLM* multi = curl_multi_init();
+    if (!multi) {
+        std::cerr << "[HTTP_POOL] Failed to initialize CURL multi handle" << std::endl;
+        return;
+    }
+    if (config_.http2) {
+        curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+    }
+    curl_multi_setopt(multi, CURLMOPT_MAX_HOST_CONNECTIONS, config_.max_host_connections);
+    curl_multi_setopt(multi, CURLMOPT_MAX_TOTAL_CONNECTIONS, config_.max_total_connections);
+    curl_multi_setopt(multi, CURLMOPT_MAXCONNECTS, config_.max_total_connections);
+    multi_ = multi;
+
+    running_.store(true);
+    worker_ = std::thread(&HttpConnectionPool::worker_loop, this);
+#endif
+}
+
+HttpConnectionPool::~HttpConnectionPool() {
+#ifdef CURL_FOUND
+    if (running_.exchange(false)) {
+        curl_multi_wakeup(static_cast<CURLM*>(multi_));
+    }
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+
+    for (void* easy : idle_handles_) {
+        curl_easy_cleanup(static_cast<CURL*>(easy));
+    }
+    if (multi_) {
+        curl_multi_cleanup(static_cast<CURLM*>(multi_));
+    }
+    curl_global_cleanup();
+#endif
+}
+
+std::shared_ptr<HttpConnectionPool> HttpConnectionPool::shared(const HttpConnectionPoolConfig& config) {
+    static std::mutex mutex;
+    static std::weak_ptr<HttpConnectionPool> instance;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::shared_ptr<HttpConnectionPool> pool = instance.lock();
+    if (!pool) {
+        pool = std::make_shared<HttpConnectionPool>(config);
+        instance = pool;
+    }
+    return pool;
+}
+
+void HttpConnectionPool::submit_async(HttpRequest request, HttpResponseCallback callback,
+                                      std::shared_ptr<const HttpRequestTemplate> request_template) {
+    Transfer* transfer = new Transfer();
+    transfer->request = std::move(request);
+    transfer->request_template = std::move(request_template);
+    transfer->callback = std::move(callback);
+    enqueue(transfer);
+}
+
+std::future<HttpResponse> HttpConnectionPool::submit(HttpRequest request,
+                                                     std::shared_ptr<const HttpRequestTemplate> request_template) {
+    Transfer* transfer = new Transfer();
+    transfer->request = std::move(request);
+    transfer->request_template = std::move(request_template);
+    transfer->has_promise = true;
+    std::future<HttpResponse> future = transfer->promise.get_future();
+    enqueue(transfer);
+    return future;
+}
+
+HttpResponse HttpConnectionPool::perform(HttpRequest request,
+                                         std::shared_ptr<const HttpRequestTemplate> request_template) {
+    return submit(std::move(request), std::move(request_template)).get();
+}
+
+void HttpConnectionPool::warm_up(const std::string& url) {
+    Transfer* transfer = new Transfer();
+    transfer->request.method = "HEAD";
+    transfer->request.url = url;
+    transfer->warm_up = true;
+    enqueue(transfer);
+}
+
+void HttpConnectionPool::enqueue(Transfer* transfer) {
+#ifdef CURL_FOUND
+    if (!running_.load()) {
+        fail_transfer(transfer, "HTTP connection pool not running");
+        return;
+    }
+    if (!pending_.try_push(transfer)) {
+        rejected_.fetch_add(1, std::memory_order_relaxed);
+        fail_transfer(transfer, "HTTP request queue full");
+        return;
+    }
+    curl_multi_wakeup(static_cast<CURLM*>(multi_));
+#else
+    fail_transfer(transfer, "CURL not available");
+#endif
+}
+
+void HttpConnectionPool::worker_loop() {
+#ifdef CURL_FOUND
+    CURLM* multi = static_cast<CURLM*>(multi_);
+
+    while (running_.load(std::memory_order_relaxed)) {
+        attach_pending();
+
+        int still_running = 0;
+        curl_multi_perform(multi, &still_running);
+
+        int messages_left = 0;
+        while (CURLMsg* message = curl_multi_info_read(multi, &messages_left)) {
+            if (message->msg == CURLMSG_DONE) {
+                complete_transfer(message->easy_handle, message->data.result);
+            }
+        }
+
+        // Sleeps until socket activity, a curl timeout or curl_multi_wakeup()
+        curl_multi_poll(multi, nullptr, 0, 1000, nullptr);
+    }
+
+    // Fail whatever is still in flight or queued so no caller waits forever
+    Transfer* transfer = nullptr;
+    while (pending_.try_pop(transfer)) {
+        fail_transfer(transfer, "HTTP connection pool stopped");
+    }
+    while (!active_handles_.empty()) {
+        complete_transfer(active_handles_.back(), CURLE_ABORTED_BY_CALLBACK);
+    }
+#endif
+}
+
+void HttpConnectionPool::attach_pending() {
+    Transfer* transfer = nullptr;
+    while (pending_.try_pop(transfer)) {
+        start_transfer(transfer);
+    }
+}
+
+void HttpConnectionPool::start_transfer(Transfer* transfer) {
+#ifdef CURL_FOUND
+    CURL* easy;
+    if (idle_handles_.empty()) {
+        easy = curl_easy_init();
+        if (!easy) {
+            fail_transfer(transfer, "Failed to initialize CURL");
+            return;
+        }
+    } else {
+        easy = static_cast<CURL*>(idle_handles_.back());
+        idle_handles_.pop_back();
+    }
+
+    const HttpRequest& request = transfer->request;
+    const HttpRequestTemplate* request_template = transfer->request_template.get();
+    if (request_template) {
+        transfer->url.reserve(request_template->base_url().size() + request.url.size());
+        transfer->url.assign(request_template->base_url()).append(request.url);
+    } else {
+        transfer->url = request.url;
+    }
+    curl_easy_setopt(easy, CURLOPT_URL, transfer->url.c_str());
+    curl_easy_setopt(easy, CURLOPT_PRIVATE, transfer);
+
+    // Method
+    if (request.method == "POST") {
+        curl_easy_setopt(easy, CURLOPT_POST, 1L);
+        curl_easy_setopt(easy, CURLOPT_POSTFIELDS, request.body.c_str());
+        curl_easy_setopt(easy, CURLOPT_POSTFIELDSIZE, static_cast<long>(request.body.size()));
+    } else if (request.method == "PUT" || request.method == "DELETE") {
+        curl_easy_setopt(easy, CURLOPT_CUSTOMREQUEST, request.method.c_str());
+        if (!request.body.empty()) {
+            curl_easy_setopt(easy, CURLOPT_POSTFIELDS, request.body.c_str());
+            curl_easy_setopt(easy, CURLOPT_POSTFIELDSIZE, static_cast<long>(request.body.size()));
+        }
+    } else if (request.method == "HEAD") {
+        curl_easy_setopt(easy, CURLOPT_NOBODY, 1L);
+    }
+
+    // Headers: the template's list is used as-is unless the request adds its own
+    if (request.headers.empty() && request_template) {
+        curl_easy_setopt(easy, CURLOPT_HTTPHEADER, request_template->header_list());
+    } else if (!request.headers.empty() || request_template) {
+        if (request_template) {
+            for (curl_slist* item = request_template->header_list(); item; item = item->next) {
+                transfer->extra_headers = curl_slist_append(transfer->extra_headers, item->data);
+            }
+        }
+        for (const auto& [key, value] : request.headers) {
+            std::string header = key + ": " + value;
+            transfer->extra_headers = curl_slist_append(transfer->extra_headers, header.c_str());
+        }
+        curl_easy_setopt(easy, CURLOPT_HTTPHEADER, transfer->extra_headers);
+    }
+
+    // Connection reuse
+    if (config_.http2) {
+        curl_easy_setopt(easy, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+        curl_easy_setopt(easy, CURLOPT_PIPEWAIT, 1L);
+    }
+    curl_easy_setopt(easy, CURLOPT_TCP_NODELAY, 1L);
+    curl_easy_setopt(easy, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(easy, CURLOPT_TCP_KEEPIDLE, config_.keepalive_idle_s);
+    curl_easy_setopt(easy, CURLOPT_TCP_KEEPINTVL, config_.keepalive_interval_s);
+    curl_easy_setopt(easy, CURLOPT_NOSIGNAL, 1L);
+
+    int timeout = request.timeout_ms > 0 ? request.timeout_ms : config_.default_timeout_ms;
+    curl_easy_setopt(easy, CURLOPT_TIMEOUT_MS, static_cast<long>(timeout));
+    curl_easy_setopt(easy, CURLOPT_SSL_VERIFYPEER, request.verify_ssl ? 1L : 0L);
+    curl_easy_setopt(easy, CURLOPT_SSL_VERIFYHOST, request.verify_ssl ? 2L : 0L);
+
+    curl_easy_setopt(easy, CURLOPT_WRITEFUNCTION, write_callback);
+    curl_easy_setopt(easy, CURLOPT_WRITEDATA, transfer);
+    curl_easy_setopt(easy, CURLOPT_HEADERFUNCTION, header_callback);
+    curl_easy_setopt(easy, CURLOPT_HEADERDATA, transfer);
+
+    CURLMcode rc = curl_multi_add_handle(static_cast<CURLM*>(multi_), easy);
+    if (rc != CURLM_OK) {
+        curl_easy_reset(easy);
+        idle_handles_.push_back(easy);
+        fail_transfer(transfer, "CURL multi error: " + std::string(curl_multi_strerror(rc)));
+        return;
+    }
+    active_handles_.push_back(easy);
+#else
+    fail_transfer(transfer, "CURL not available");
+#endif
+}
+
+void HttpConnectionPool::complete_transfer(void* handle, int result) {
+#ifdef CURL_FOUND
+    CURL* easy = static_cast<CURL*>(handle);
+    Transfer* transfer = nullptr;
+    curl_easy_getinfo(easy, CURLINFO_PRIVATE, &transfer);
+
+    long response_code = 0;
+    long connects = 0;
+    curl_easy_getinfo(easy, CURLINFO_RESPONSE_CODE, &response_code);
+    curl_easy_getinfo(easy, CURLINFO_NUM_CONNECTS, &connects);
+    new_connections_.fetch_add(static_cast<uint64_t>(connects), std::memory_order_relaxed);
+
+    HttpResponse& response = transfer->response;
+    CURLcode code = static_cast<CURLcode>(result);
+    if (code != CURLE_OK) {
+        response.error_message = "CURL error: " + std::string(curl_easy_strerror(code));
+    }
+    response.status_code = static_cast<int>(response_code);
+    response.success = code == CURLE_OK && response_code >= 200 && response_code < 300;
+
+    // Handle goes back to the pool; its connection stays in the multi cache
+    curl_multi_remove_handle(static_cast<CURLM*>(multi_), easy);
+    active_handles_.erase(std::find(active_handles_.begin(), active_handles_.end(), handle));
+    curl_easy_reset(easy);
+    idle_handles_.push_back(easy);
+
+    curl_slist_free_all(transfer->extra_headers);
+    transfer->extra_headers = nullptr;
+
+    completed_.fetch_add(1, std::memory_order_relaxed);
+    deliver(transfer);
+#else
+    (void)handle;
+    (void)result;
+#endif
+}
+
+void HttpConnectionPool::fail_transfer(Transfer* transfer, const std::string& error) {
+    transfer->response.error_message = error;
+    transfer->response.success = false;
+    deliver(transfer);
+}
+
+void HttpConnectionPool::deliver(Transfer* transfer) {
+    if (transfer->warm_up) {
+        if (!transfer->response.error_message.empty()) {
+            std::cerr << "[HTTP_POOL] Warm-up of " << transfer->request.url << " failed: "
+                      << transfer->response.error_message << std::endl;
+        }
+    } else if (transfer->has_promise) {
+        transfer->promise.set_value(std::move(transfer->response));
+    } else if (transfer->callback) {
+        try {
+            transfer->callback(transfer->response);
+        } catch (const std::exception& e) {
+            std::cerr << "[HTTP_POOL] Response callback error: " << e.what() << std::endl;
+        }
+    }
+    delete transfer;
+}
+
+size_t HttpConnectionPool::write_callback(char* contents, size_t size, size_t nmemb, void* userdata) {
+    Transfer* transfer = static_cast<Transfer*>(userdata);
+    size_t total_size = size * nmemb;
+    transfer->response.body.append(contents, total_size);
+    return total_size;
+}
+
+size_t HttpConnectionPool::header_callback(char* contents, size_t size, size_t nmemb, void* userdata) {
+    Transfer* transfer = static_cast<Transfer*>(userdata);
+    size_t total_size = size * nmemb;
+
+    std::string_view line(contents, total_size);
+    while (!line.empty() && (line.back() == '\n' || line.back() == '\r')) {
+        line.remove_suffix(1);
+    }
+
+    // "Key: Value"; status lines and the blank terminator have no colon
+    size_t colon_pos = line.find(':');
+    if (colon_pos != std::string_view::npos) {
+        std::string_view key = line.substr(0, colon_pos);
+        std::string_view value = line.substr(colon_pos + 1);
+        while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) {
+            value.remove_prefix(1);
+        }
+        transfer->response.headers[std::string(key)] = std::string(value);
+    }
+
+    return total_size;
+}
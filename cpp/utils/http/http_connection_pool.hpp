@@ -0,0 +1,132 @@
+#pragma once
+#include "i_http_handler.hpp"
+#include "../lockfree/mpsc_ring.hpp"
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct curl_slist;
+
+// Connection pool settings
+struct HttpConnectionPoolConfig {
+    long max_host_connections{4};     // Per host; HTTP/2 requests multiplex over these
+    long max_total_connections{16};
+    bool http2{true};                 // Negotiate h2 over TLS, fall back to HTTP/1.1
+    long keepalive_idle_s{30};        // TCP keep-alive so idle order connections stay up
+    long keepalive_interval_s{15};
+    int default_timeout_ms{5000};
+    size_t queue_capacity{1024};      // Submitted requests not yet picked up by the worker
+};
+
+/**
+ * Static parts of a venue's REST requests, formatted once
+ *
+ * Holds the base URL and a ready-made curl header list (API key, content
+ * type, ...). Requests built from a template only carry their path and
+ * query; the header list is handed to curl as-is, not rebuilt per request.
+ */
+class HttpRequestTemplate {
+public:
+    HttpRequestTemplate(std::string base_url, const std::map<std::string, std::string>& static_headers);
+    ~HttpRequestTemplate();
+
+    // Non-copyable (owns the header list)
+    HttpRequestTemplate(const HttpRequestTemplate&) = delete;
+    HttpRequestTemplate& operator=(const HttpRequestTemplate&) = delete;
+
+    const std::string& base_url() const { return base_url_; }
+    curl_slist* header_list() const { return header_list_; }
+
+private:
+    std::string base_url_;
+    curl_slist* header_list_{nullptr};
+};
+
+/**
+ * Keep-alive HTTP client driven by curl_multi
+ *
+ * One worker thread owns a curl multi handle and a pool of easy handles.
+ * Connections stay in the multi handle's cache between requests, so only
+ * the first request to a host pays the TCP + TLS handshake. Over HTTP/2,
+ * concurrent requests are multiplexed on one connection (PIPEWAIT) instead
+ * of opening new ones.
+ *
+ * Any thread may submit: requests go through a lock-free MPSC ring and
+ * curl_multi_wakeup(). Results come back as a future or on a callback,
+ * which runs on the worker thread and must not block.
+ */
+class HttpConnectionPool {
+public:
+    explicit HttpConnectionPool(const HttpConnectionPoolConfig& config = HttpConnectionPoolConfig());
+    ~HttpConnectionPool();
+
+    // Non-copyable
+    HttpConnectionPool(const HttpConnectionPool&) = delete;
+    HttpConnectionPool& operator=(const HttpConnectionPool&) = delete;
+
+    /**
+     * Process-wide pool, created on first use and destroyed with its last user
+     *
+     * Venues share it so connections and the worker thread are not duplicated.
+     * The config only applies when the pool is created.
+     */
+    static std::shared_ptr<HttpConnectionPool> shared(const HttpConnectionPoolConfig& config = HttpConnectionPoolConfig());
+
+    /**
+     * Queue a request
+     *
+     * @param request With a template, request.url is the path and query
+     *                appended to the template's base URL, and the template's
+     *                headers are sent ahead of request.headers
+     * @param callback Runs on the worker thread once the request completes
+     */
+    void submit_async(HttpRequest request, HttpResponseCallback callback,
+                      std::shared_ptr<const HttpRequestTemplate> request_template = nullptr);
+
+    std::future<HttpResponse> submit(HttpRequest request,
+                                     std::shared_ptr<const HttpRequestTemplate> request_template = nullptr);
+
+    // Blocking convenience wrapper around submit()
+    HttpResponse perform(HttpRequest request,
+                         std::shared_ptr<const HttpRequestTemplate> request_template = nullptr);
+
+    // Open a connection to url's host ahead of the first real request
+    void warm_up(const std::string& url);
+
+    // Statistics
+    uint64_t get_completed_count() const { return completed_.load(std::memory_order_relaxed); }
+    uint64_t get_new_connection_count() const { return new_connections_.load(std::memory_order_relaxed); }
+    uint64_t get_rejected_count() const { return rejected_.load(std::memory_order_relaxed); }
+
+private:
+    struct Transfer;
+
+    void enqueue(Transfer* transfer);
+    void worker_loop();
+    void attach_pending();
+    void start_transfer(Transfer* transfer);
+    void complete_transfer(void* easy, int result);
+    void fail_transfer(Transfer* transfer, const std::string& error);
+    static void deliver(Transfer* transfer);
+
+    static size_t write_callback(char* contents, size_t size, size_t nmemb, void* userdata);
+    static size_t header_callback(char* contents, size_t size, size_t nmemb, void* userdata);
+
+    HttpConnectionPoolConfig config_;
+    void* multi_{nullptr};                 // CURLM*
+    std::vector<void*> idle_handles_;      // CURL*, worker thread only
+    std::vector<void*> active_handles_;    // CURL* attached to the multi handle
+    MpscRing<Transfer*> pending_;
+
+    std::thread worker_;
+    std::atomic<bool> running_{false};
+
+    std::atomic<uint64_t> completed_{0};
+    std::atomic<uint64_t> new_connections_{0};
+    std::atomic<uint64_t> rejected_{0};
+};
@@ -0,0 +1,76 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+/**
+ * Lock-free single-producer / single-consumer latest-value slot
+ *
+ * A triple buffer: the producer fills back() in place and publish()es it,
+ * the consumer takes the newest published value with consume(). Values the
+ * consumer never got to are overwritten, not queued, so a slow consumer
+ * always sees the freshest value and never a backlog; publish() reports
+ * each such overwrite so callers can count skipped updates.
+ *
+ * Buffers rotate between the two sides instead of being copied, and keep
+ * their capacity (std::string, proto messages) across reuse.
+ *
+ * @note Exactly one producer thread and one consumer thread.
+ */
+template <typename T>
+class LatestValueSlot {
+public:
+  // init is called once per buffer, e.g. to reserve() capacity
+  explicit LatestValueSlot(const std::function<void(T&)>& init = {}) {
+    if (init) {
+      for (T& buffer : buffers_) init(buffer);
+    }
+  }
+
+  // Non-copyable
+  LatestValueSlot(const LatestValueSlot&) = delete;
+  LatestValueSlot& operator=(const LatestValueSlot&) = delete;
+
+  // ---- Producer ---------------------------------------------------------
+
+  // Buffer to fill; invisible to the consumer until publish()
+  T& back() { return buffers_[back_]; }
+
+  /**
+   * Make back() the newest value
+   *
+   * @return true if this replaced a value the consumer had not taken yet
+   */
+  bool publish() {
+    const uint8_t previous = middle_.exchange(static_cast<uint8_t>(back_ | kFresh), std::memory_order_acq_rel);
+    back_ = previous & kIndexMask;
+    return (previous & kFresh) != 0;
+  }
+
+  // ---- Consumer ---------------------------------------------------------
+
+  bool has_fresh() const { return (middle_.load(std::memory_order_acquire) & kFresh) != 0; }
+
+  /**
+   * Newest value published since the last consume(), or nullptr
+   *
+   * The value stays valid (and untouched by the producer) until the next
+   * consume().
+   */
+  T* consume() {
+    if (!has_fresh()) return nullptr;
+    const uint8_t previous = middle_.exchange(front_, std::memory_order_acq_rel);
+    front_ = previous & kIndexMask;
+    return &buffers_[front_];
+  }
+
+private:
+  static constexpr uint8_t kIndexMask = 0x3;
+  static constexpr uint8_t kFresh = 0x4;
+
+  // Index of the buffer in the middle, plus kFresh while it holds an unconsumed value
+  alignas(64) std::atomic<uint8_t> middle_{1};
+  alignas(64) uint8_t back_{0};    // Producer-owned
+  alignas(64) uint8_t front_{2};   // Consumer-owned
+  T buffers_[3];
+};
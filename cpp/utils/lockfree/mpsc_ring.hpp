@@ -0,0 +1,158 @@
+#pragma once
+#include "wait_strategy.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+
+/**
+ * Bounded lock-free multi-producer / single-consumer ring
+ *
+ * Vyukov-style: every slot carries a sequence number, producers reserve a
+ * ticket with one CAS on the tail and publish by bumping the slot's
+ * sequence, so a slow producer never blocks the others from claiming.
+ * Slots are constructed once and filled / read in place, as in SpscRing.
+ *
+ * @note Any number of producer threads, exactly one consumer thread. A
+ *       claimed ticket must always be published.
+ */
+template <typename T>
+class MpscRing {
+public:
+  /**
+   * @param capacity Slot count, rounded up to a power of two
+   * @param strategy How wait_front() waits when the ring is empty
+   * @param init Called once per slot, e.g. to reserve() buffer capacity
+   */
+  explicit MpscRing(size_t capacity, WaitStrategy strategy = WaitStrategy::FUTEX,
+                    const std::function<void(T&)>& init = {})
+    : capacity_(round_up(capacity)), mask_(capacity_ - 1),
+      slots_(new Slot[capacity_]), waiter_(strategy) {
+    for (size_t i = 0; i < capacity_; ++i) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+      if (init) init(slots_[i].value);
+    }
+  }
+
+  // Non-copyable
+  MpscRing(const MpscRing&) = delete;
+  MpscRing& operator=(const MpscRing&) = delete;
+
+  // ---- Producers --------------------------------------------------------
+
+  /**
+   * Reserve the next slot to fill in place
+   *
+   * @param ticket Set to the reservation to pass to publish()
+   * @return Slot, or nullptr if the ring is full
+   */
+  T* claim(uint64_t& ticket) {
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    for (;;) {
+      Slot& slot = slots_[tail & mask_];
+      const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+      const int64_t diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(tail);
+      if (diff == 0) {
+        if (tail_.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed)) {
+          ticket = tail;
+          return &slot.value;
+        }
+      } else if (diff < 0) {
+        return nullptr;   // Consumer has not released this slot yet
+      } else {
+        tail = tail_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Make a claimed slot visible to the consumer
+  void publish(uint64_t ticket) {
+    slots_[ticket & mask_].sequence.store(ticket + 1, std::memory_order_release);
+    waiter_.notify();
+  }
+
+  template <typename U>
+  bool try_push(U&& value) {
+    uint64_t ticket = 0;
+    T* slot = claim(ticket);
+    if (!slot) {
+      full_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    *slot = std::forward<U>(value);
+    publish(ticket);
+    return true;
+  }
+
+  // ---- Consumer ---------------------------------------------------------
+
+  // Oldest published slot, or nullptr if it is empty or still being filled
+  T* front() {
+    Slot& slot = slots_[head_ & mask_];
+    if (slot.sequence.load(std::memory_order_acquire) != head_ + 1) return nullptr;
+    return &slot.value;
+  }
+
+  // Release the slot returned by front() back to the producers
+  void pop() {
+    slots_[head_ & mask_].sequence.store(head_ + capacity_, std::memory_order_release);
+    ++head_;
+  }
+
+  bool try_pop(T& out) {
+    T* slot = front();
+    if (!slot) return false;
+    std::swap(out, *slot);
+    pop();
+    return true;
+  }
+
+  /**
+   * Wait (per the ring's WaitStrategy) for a published slot
+   *
+   * @return front(), or nullptr on timeout
+   */
+  T* wait_front(std::chrono::microseconds timeout) {
+    T* slot = front();
+    if (slot) return slot;
+    waiter_.wait([this] { return front() != nullptr; }, timeout);
+    return front();
+  }
+
+  // Wake a consumer blocked in wait_front() (e.g. on shutdown)
+  void wake_consumer() { waiter_.notify(); }
+
+  size_t capacity() const { return capacity_; }
+  WaitStrategy wait_strategy() const { return waiter_.strategy(); }
+
+  // Statistics
+  uint64_t get_full_count() const { return full_.load(std::memory_order_relaxed); }
+
+private:
+  struct Slot {
+    std::atomic<uint64_t> sequence{0};
+    T value{};
+  };
+
+  static size_t round_up(size_t n) {
+    size_t capacity = 2;
+    while (capacity < n) capacity <<= 1;
+    return capacity;
+  }
+
+  const size_t capacity_;
+  const size_t mask_;
+  std::unique_ptr<Slot[]> slots_;
+
+  // Shared by producers
+  alignas(64) std::atomic<uint64_t> tail_{0};
+  std::atomic<uint64_t> full_{0};
+
+  // Consumer-owned
+  alignas(64) uint64_t head_{0};
+
+  alignas(64) RingWaiter waiter_;
+};
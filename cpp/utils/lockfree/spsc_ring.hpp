@@ -0,0 +1,169 @@
+#pragma once
+#include "wait_strategy.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+
+/**
+ * Bounded lock-free single-producer / single-consumer ring
+ *
+ * Slots are constructed once, up front, and reused for the lifetime of the
+ * ring: the producer fills a slot in place (claim() / publish()) and the
+ * consumer reads it in place (front() / pop()). With T = std::string or a
+ * proto message, a slot keeps its capacity across reuse, so once the ring
+ * has warmed up nothing on either side allocates.
+ *
+ * Head and tail live on separate cache lines and each side caches the
+ * other's index, so the hot path touches shared lines only when the ring
+ * looks full (producer) or empty (consumer).
+ *
+ * @note Exactly one producer thread and one consumer thread.
+ */
+template <typename T>
+class SpscRing {
+public:
+  /**
+   * @param capacity Slot count, rounded up to a power of two
+   * @param strategy How wait_front() waits when the ring is empty, and
+   *                 wait_claim() when it is full
+   * @param init Called once per slot, e.g. to reserve() buffer capacity
+   */
+  explicit SpscRing(size_t capacity, WaitStrategy strategy = WaitStrategy::FUTEX,
+                    const std::function<void(T&)>& init = {})
+    : capacity_(round_up(capacity)), mask_(capacity_ - 1),
+      slots_(new T[capacity_]), waiter_(strategy), space_waiter_(strategy) {
+    if (init) {
+      for (size_t i = 0; i < capacity_; ++i) init(slots_[i]);
+    }
+  }
+
+  // Non-copyable
+  SpscRing(const SpscRing&) = delete;
+  SpscRing& operator=(const SpscRing&) = delete;
+
+  // ---- Producer ---------------------------------------------------------
+
+  /**
+   * Next free slot to fill in place, or nullptr if the ring is full
+   *
+   * Nothing is visible to the consumer until publish().
+   */
+  T* claim() {
+    const uint64_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_cache_ >= capacity_) {
+      head_cache_ = head_.load(std::memory_order_acquire);
+      if (tail - head_cache_ >= capacity_) return nullptr;
+    }
+    return &slots_[tail & mask_];
+  }
+
+  /**
+   * Wait (per the ring's WaitStrategy) for a free slot
+   *
+   * @return claim(), or nullptr on timeout
+   */
+  T* wait_claim(std::chrono::microseconds timeout) {
+    T* slot = claim();
+    if (slot) return slot;
+    space_waiter_.wait([this] { return claim() != nullptr; }, timeout);
+    return claim();
+  }
+
+  // Make the slot returned by the last claim() visible to the consumer
+  void publish() {
+    tail_.store(tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    waiter_.notify();
+  }
+
+  template <typename U>
+  bool try_push(U&& value) {
+    T* slot = claim();
+    if (!slot) {
+      full_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    *slot = std::forward<U>(value);
+    publish();
+    return true;
+  }
+
+  // ---- Consumer ---------------------------------------------------------
+
+  // Oldest published slot, or nullptr if the ring is empty
+  T* front() {
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_cache_) {
+      tail_cache_ = tail_.load(std::memory_order_acquire);
+      if (head == tail_cache_) return nullptr;
+    }
+    return &slots_[head & mask_];
+  }
+
+  // Release the slot returned by front() back to the producer
+  void pop() {
+    head_.store(head_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    space_waiter_.notify();
+  }
+
+  bool try_pop(T& out) {
+    T* slot = front();
+    if (!slot) return false;
+    std::swap(out, *slot);   // hand over the buffer, keep the slot's old one for reuse
+    pop();
+    return true;
+  }
+
+  /**
+   * Wait (per the ring's WaitStrategy) for a published slot
+   *
+   * @return front(), or nullptr on timeout
+   */
+  T* wait_front(std::chrono::microseconds timeout) {
+    T* slot = front();
+    if (slot) return slot;
+    waiter_.wait([this] { return front() != nullptr; }, timeout);
+    return front();
+  }
+
+  // Wake a consumer blocked in wait_front() (e.g. on shutdown)
+  void wake_consumer() { waiter_.notify(); }
+
+  // ---- Either side (approximate while the other side is running) ---------
+
+  size_t size() const {
+    return static_cast<size_t>(tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire));
+  }
+  bool empty() const { return size() == 0; }
+  size_t capacity() const { return capacity_; }
+  WaitStrategy wait_strategy() const { return waiter_.strategy(); }
+
+  // Statistics
+  uint64_t get_full_count() const { return full_.load(std::memory_order_relaxed); }
+
+private:
+  static size_t round_up(size_t n) {
+    size_t capacity = 2;
+    while (capacity < n) capacity <<= 1;
+    return capacity;
+  }
+
+  const size_t capacity_;
+  const size_t mask_;
+  std::unique_ptr<T[]> slots_;
+
+  // Consumer-owned line
+  alignas(64) std::atomic<uint64_t> head_{0};
+  uint64_t tail_cache_{0};
+
+  // Producer-owned line
+  alignas(64) std::atomic<uint64_t> tail_{0};
+  uint64_t head_cache_{0};
+  std::atomic<uint64_t> full_{0};
+
+  alignas(64) RingWaiter waiter_;         // Consumer waiting for data
+  alignas(64) RingWaiter space_waiter_;   // Producer waiting for a free slot
+};
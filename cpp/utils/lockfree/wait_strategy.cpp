@@ -0,0 +1,52 @@
+#include "wait_strategy.hpp"
+#include <algorithm>
+#include <cctype>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+WaitStrategy parse_wait_strategy(const std::string& name) {
+  std::string lower = name;
+  std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+  if (lower == "busy_spin" || lower == "spin") {
+    return WaitStrategy::BUSY_SPIN;
+  }
+  if (lower == "yield") {
+    return WaitStrategy::YIELD;
+  }
+  return WaitStrategy::FUTEX;
+}
+
+const char* wait_strategy_name(WaitStrategy strategy) {
+  switch (strategy) {
+    case WaitStrategy::BUSY_SPIN: return "busy_spin";
+    case WaitStrategy::YIELD: return "yield";
+    case WaitStrategy::FUTEX: return "futex";
+  }
+  return "futex";
+}
+
+void RingWaiter::park(uint32_t epoch, std::chrono::microseconds timeout) {
+#ifdef __linux__
+  static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word must be 32 bits");
+  struct timespec ts;
+  ts.tv_sec = static_cast<time_t>(timeout.count() / 1000000);
+  ts.tv_nsec = static_cast<long>((timeout.count() % 1000000) * 1000);
+  // Returns immediately (EAGAIN) if a producer already bumped the epoch
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(&epoch_), FUTEX_WAIT_PRIVATE, epoch, &ts, nullptr, 0);
+#else
+  (void)epoch;
+  (void)timeout;
+  std::this_thread::yield();
+#endif
+}
+
+void RingWaiter::wake() {
+#ifdef __linux__
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(&epoch_), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#endif
+}
@@ -0,0 +1,109 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+/**
+ * How a ring consumer waits for data
+ *
+ * BUSY_SPIN  Never leaves the CPU; lowest wake-up latency, burns a core.
+ * YIELD      Spins briefly, then std::this_thread::yield() between polls.
+ * FUTEX      Spins briefly, then parks on a futex; producers only pay for
+ *            a syscall when the consumer is actually parked.
+ */
+enum class WaitStrategy : uint8_t {
+  BUSY_SPIN,
+  YIELD,
+  FUTEX
+};
+
+// "busy_spin" / "spin", "yield", "futex" / "block" (case-insensitive); FUTEX otherwise
+WaitStrategy parse_wait_strategy(const std::string& name);
+const char* wait_strategy_name(WaitStrategy strategy);
+
+/**
+ * Consumer-side parking for the lock-free rings
+ *
+ * The producer publishes its data and then calls notify(); the consumer
+ * calls wait() with a predicate that checks for data. Only one thread may
+ * wait at a time (the rings are single-consumer).
+ */
+class RingWaiter {
+public:
+  explicit RingWaiter(WaitStrategy strategy = WaitStrategy::FUTEX) : strategy_(strategy) {}
+
+  WaitStrategy strategy() const { return strategy_; }
+
+  /**
+   * Wait until ready() returns true or the timeout expires
+   *
+   * @return Result of the last ready() check
+   */
+  template <typename Ready>
+  bool wait(Ready&& ready, std::chrono::microseconds timeout) {
+    for (int i = 0; i < kSpinIterations; ++i) {
+      if (ready()) return true;
+      cpu_relax();
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!ready()) {
+      auto now = std::chrono::steady_clock::now();
+      if (now >= deadline) return false;
+
+      switch (strategy_) {
+        case WaitStrategy::BUSY_SPIN:
+          cpu_relax();
+          break;
+        case WaitStrategy::YIELD:
+          std::this_thread::yield();
+          break;
+        case WaitStrategy::FUTEX: {
+          // Announce the sleeper before the final check; pairs with the
+          // fence in notify() so a publish cannot slip between the two
+          uint32_t epoch = epoch_.load(std::memory_order_acquire);
+          parked_.store(true, std::memory_order_seq_cst);
+          if (!ready()) {
+            park(epoch, std::chrono::duration_cast<std::chrono::microseconds>(deadline - now));
+          }
+          parked_.store(false, std::memory_order_relaxed);
+          break;
+        }
+      }
+    }
+    return true;
+  }
+
+  /**
+   * Wake the consumer if it is parked; call after publishing
+   */
+  void notify() {
+    if (strategy_ != WaitStrategy::FUTEX) return;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (parked_.load(std::memory_order_relaxed)) {
+      epoch_.fetch_add(1, std::memory_order_release);
+      wake();
+    }
+  }
+
+  static void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#endif
+  }
+
+private:
+  static constexpr int kSpinIterations = 128;
+
+  // Futex wait on epoch_ while it still equals `epoch` (yield where futexes are unavailable)
+  void park(uint32_t epoch, std::chrono::microseconds timeout);
+  void wake();
+
+  WaitStrategy strategy_;
+  std::atomic<uint32_t> epoch_{0};
+  std::atomic<bool> parked_{false};
+};
@@ -0,0 +1,331 @@
+#include "binary_logger.hpp"
+#include "../app_service/thread_placement.hpp"
+#include <algorithm>
+#include <charconv>
+#include <ctime>
+#include <iostream>
+
+namespace logging {
+
+namespace {
+
+constexpr size_t kBatchBytes = 64 * 1024;
+
+const char* level_name(LogLevel level) {
+    switch (level) {
+        case LogLevel::DEBUG: return "DEBUG";
+        case LogLevel::INFO: return "INFO";
+        case LogLevel::WARN: return "WARN";
+        case LogLevel::ERROR: return "ERROR";
+        default: return "UNKNOWN";
+    }
+}
+
+template <typename T>
+void append_number(std::string& out, T value) {
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+// Decode the next argument at pos and append it; returns false at the end
+bool append_arg(const unsigned char*& pos, const unsigned char* end, std::string& out) {
+    if (pos >= end) {
+        return false;
+    }
+    LogArgTag tag = static_cast<LogArgTag>(*pos++);
+    switch (tag) {
+        case LogArgTag::INT: {
+            int64_t value;
+            std::memcpy(&value, pos, sizeof(value));
+            pos += sizeof(value);
+            append_number(out, value);
+            return true;
+        }
+        case LogArgTag::UINT: {
+            uint64_t value;
+            std::memcpy(&value, pos, sizeof(value));
+            pos += sizeof(value);
+            append_number(out, value);
+            return true;
+        }
+        case LogArgTag::DOUBLE: {
+            double value;
+            std::memcpy(&value, pos, sizeof(value));
+            pos += sizeof(value);
+            append_number(out, value);
+            return true;
+        }
+        case LogArgTag::BOOL:
+            out.append(*pos++ ? "true" : "false");
+            return true;
+        case LogArgTag::CHAR:
+            out.push_back(static_cast<char>(*pos++));
+            return true;
+        case LogArgTag::STRING: {
+            uint16_t length;
+            std::memcpy(&length, pos, sizeof(length));
+            pos += sizeof(length);
+            out.append(reinterpret_cast<const char*>(pos), length);
+            pos += length;
+            return true;
+        }
+    }
+    pos = end;
+    return false;
+}
+
+// "YYYY-MM-DD HH:MM:SS", recomputed only when the second changes (per formatting thread)
+void append_timestamp(std::string& out, uint64_t timestamp_ns) {
+    thread_local time_t cached_second = -1;
+    thread_local char cached_text[32];
+    thread_local size_t cached_length = 0;
+
+    time_t second = static_cast<time_t>(timestamp_ns / 1000000000ULL);
+    if (second != cached_second) {
+        struct tm tm;
+        localtime_r(&second, &tm);
+        cached_length = std::strftime(cached_text, sizeof(cached_text), "%Y-%m-%d %H:%M:%S", &tm);
+        cached_second = second;
+    }
+    out.append(cached_text, cached_length);
+
+    char micros[8];
+    uint32_t us = static_cast<uint32_t>((timestamp_ns / 1000) % 1000000);
+    micros[0] = '.';
+    for (int i = 6; i >= 1; --i) {
+        micros[i] = static_cast<char>('0' + us % 10);
+        us /= 10;
+    }
+    out.append(micros, 7);
+}
+
+} // namespace
+
+// Marks the calling thread's buffer retired when the thread exits
+struct ThreadBufferHandle {
+    std::shared_ptr<BinaryLogger::ThreadBuffer> buffer;
+
+    ~ThreadBufferHandle() {
+        if (buffer) {
+            buffer->retired.store(true, std::memory_order_release);
+            BinaryLogger::tls_buffer_ = nullptr;
+        }
+    }
+};
+
+BinaryLogger& BinaryLogger::get_instance() {
+    static BinaryLogger instance;
+    return instance;
+}
+
+BinaryLogger::~BinaryLogger() {
+    stop();
+}
+
+void BinaryLogger::start(const BinaryLoggerConfig& config) {
+    if (running_.load()) {
+        return;
+    }
+
+    config_ = config;
+    if (config_.file_sink) {
+        file_ = config_.file_sink;
+    } else if (!config_.log_file.empty()) {
+        file_ = std::make_shared<LogFileSink>(config_.log_file);
+        if (!file_->is_open()) {
+            std::cerr << "[BINARY_LOGGER] Failed to open log file: " << config_.log_file << std::endl;
+            file_.reset();
+        }
+    }
+    out_batch_.reserve(kBatchBytes * 2);
+    err_batch_.reserve(kBatchBytes);
+
+    running_.store(true);
+    worker_ = std::thread(&BinaryLogger::worker_loop, this);
+    min_level_.store(static_cast<int>(config_.min_level), std::memory_order_relaxed);
+}
+
+void BinaryLogger::stop() {
+    min_level_.store(kDisabled, std::memory_order_relaxed);
+    if (!running_.exchange(false)) {
+        return;
+    }
+
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+    file_.reset();
+    config_.file_sink.reset();
+}
+
+void BinaryLogger::flush() {
+    if (!running_.load()) {
+        return;
+    }
+
+    uint64_t ticket = flush_requested_.fetch_add(1) + 1;
+    while (flush_completed_.load() < ticket && running_.load()) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+}
+
+void BinaryLogger::set_level(LogLevel level) {
+    config_.min_level = level;
+    if (running_.load()) {
+        min_level_.store(static_cast<int>(level), std::memory_order_relaxed);
+    }
+}
+
+uint64_t BinaryLogger::get_dropped_count() const {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    uint64_t dropped = retired_dropped_.load(std::memory_order_relaxed);
+    for (const auto& buffer : buffers_) {
+        dropped += buffer->dropped.load(std::memory_order_relaxed);
+    }
+    return dropped;
+}
+
+BinaryLogger::ThreadBuffer* BinaryLogger::acquire_thread_buffer() {
+    thread_local ThreadBufferHandle handle;
+
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    handle.buffer = std::make_shared<ThreadBuffer>(config_.ring_capacity, next_thread_index_++);
+    buffers_.push_back(handle.buffer);
+    registry_version_.fetch_add(1, std::memory_order_release);
+
+    tls_buffer_ = handle.buffer.get();
+    return tls_buffer_;
+}
+
+void BinaryLogger::worker_loop() {
+    app_service::ThreadPlacement::instance().place_current_thread("fast_log");
+    for (;;) {
+        // Read the flush ticket before draining so everything published before it is covered
+        uint64_t flush_ticket = flush_requested_.load();
+        bool stopping = !running_.load();
+
+        size_t drained = drain_all();
+        if (drained == 0 || stopping) {
+            write_batches(true);
+            flush_completed_.store(flush_ticket);
+            if (stopping) {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        } else {
+            write_batches(false);
+        }
+    }
+}
+
+size_t BinaryLogger::drain_all() {
+    uint64_t version = registry_version_.load(std::memory_order_acquire);
+    if (version != worker_version_) {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        worker_buffers_ = buffers_;
+        worker_version_ = registry_version_.load(std::memory_order_relaxed);
+    }
+
+    size_t drained = 0;
+    bool prune = false;
+    for (const auto& buffer : worker_buffers_) {
+        // Check retirement before draining so records written just before exit are not lost
+        bool retired = buffer->retired.load(std::memory_order_acquire);
+        while (LogRecord* record = buffer->ring.front()) {
+            std::string& batch = record->site->level >= LogLevel::ERROR && config_.console ? err_batch_ : out_batch_;
+            format_record(*record, buffer->index, batch);
+            buffer->ring.pop();
+            ++drained;
+            if (out_batch_.size() >= kBatchBytes || err_batch_.size() >= kBatchBytes) {
+                write_batches(false);
+            }
+        }
+        prune = prune || retired;
+    }
+    written_.fetch_add(drained, std::memory_order_relaxed);
+
+    if (prune) {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        auto retired = [](const std::shared_ptr<ThreadBuffer>& buffer) {
+            return buffer->retired.load(std::memory_order_acquire) && buffer->ring.front() == nullptr;
+        };
+        for (const auto& buffer : buffers_) {
+            if (retired(buffer)) {
+                retired_dropped_.fetch_add(buffer->dropped.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            }
+        }
+        buffers_.erase(std::remove_if(buffers_.begin(), buffers_.end(), retired), buffers_.end());
+        worker_buffers_ = buffers_;
+        worker_version_ = registry_version_.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+    return drained;
+}
+
+void BinaryLogger::write_batches(bool flush_streams) {
+    // ERROR lines are only split out when they go to stderr
+    if (!out_batch_.empty()) {
+        if (config_.console) {
+            std::fwrite(out_batch_.data(), 1, out_batch_.size(), stdout);
+        }
+        if (file_) {
+            file_->write(out_batch_.data(), out_batch_.size(), false);
+        }
+        out_batch_.clear();
+    }
+    if (!err_batch_.empty()) {
+        std::fwrite(err_batch_.data(), 1, err_batch_.size(), stderr);
+        if (file_) {
+            file_->write(err_batch_.data(), err_batch_.size(), false);
+        }
+        err_batch_.clear();
+    }
+
+    if (flush_streams) {
+        if (config_.console) {
+            std::fflush(stdout);
+        }
+        if (file_) {
+            file_->flush();
+        }
+    }
+}
+
+void BinaryLogger::format_record(const LogRecord& record, uint32_t thread_index, std::string& out) {
+    const LogSite& site = *record.site;
+
+    append_timestamp(out, record.timestamp_ns);
+    out.append(" [").append(level_name(site.level)).append("]");
+    if (site.component && *site.component) {
+        out.append(" [").append(site.component).append("]");
+    }
+    out.append(" [T");
+    append_number(out, thread_index);
+    out.append("] ");
+
+    // Substitute "{}" placeholders in order
+    const unsigned char* pos = record.args;
+    const unsigned char* end = record.args + record.arg_bytes;
+    for (const char* f = site.format; *f; ++f) {
+        if (f[0] == '{' && f[1] == '}') {
+            if (!append_arg(pos, end, out)) {
+                out.append("{}");
+            }
+            ++f;
+        } else {
+            out.push_back(*f);
+        }
+    }
+
+    // Arguments without a placeholder are appended rather than lost
+    while (pos < end) {
+        out.push_back(' ');
+        append_arg(pos, end, out);
+    }
+    if (record.truncated) {
+        out.append(" [truncated]");
+    }
+    out.push_back('\n');
+}
+
+} // namespace logging
@@ -0,0 +1,275 @@
+#pragma once
+#include "logger.hpp"
+#include "../lockfree/spsc_ring.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Compile-time log level floor for the FAST_LOG_* macros
+ *
+ * Calls below it compile to nothing. Set with -DFAST_LOG_ACTIVE_LEVEL=<n>
+ * (0 = DEBUG, 1 = INFO, 2 = WARN, 3 = ERROR), e.g. via the LOG_COMPILE_LEVEL
+ * CMake cache variable.
+ */
+#ifndef FAST_LOG_ACTIVE_LEVEL
+#define FAST_LOG_ACTIVE_LEVEL 0
+#endif
+
+namespace logging {
+
+/**
+ * Static description of one FAST_LOG_* call site
+ *
+ * Built at compile time; its address is the format ID written to the ring,
+ * so the hot path never copies the format string or component name.
+ */
+struct LogSite {
+    LogLevel level;
+    const char* component;
+    const char* format;   // "{}" placeholders, filled in order
+};
+
+// Type tag preceding each encoded argument
+enum class LogArgTag : uint8_t {
+    INT,
+    UINT,
+    DOUBLE,
+    BOOL,
+    CHAR,
+    STRING
+};
+
+// Fixed-size ring slot: format ID, timestamp and raw argument bytes
+struct LogRecord {
+    static constexpr size_t kArgBytes = 232;
+
+    const LogSite* site{nullptr};
+    uint64_t timestamp_ns{0};
+    uint16_t arg_bytes{0};
+    bool truncated{false};
+    unsigned char args[kArgBytes];
+};
+
+/**
+ * Writes raw arguments into a LogRecord
+ *
+ * Strings are copied (the caller's buffer may not outlive the call) and cut
+ * short if the record runs out of room; everything else is stored as-is.
+ */
+class LogArgEncoder {
+public:
+    LogArgEncoder(unsigned char* buffer, size_t capacity) : pos_(buffer), begin_(buffer), end_(buffer + capacity) {}
+
+    template <typename T>
+    void put(const T& value) {
+        using U = std::decay_t<T>;
+        if constexpr (std::is_same_v<U, bool>) {
+            put_scalar(LogArgTag::BOOL, static_cast<uint8_t>(value));
+        } else if constexpr (std::is_same_v<U, char>) {
+            put_scalar(LogArgTag::CHAR, value);
+        } else if constexpr (std::is_enum_v<U>) {
+            put(static_cast<std::underlying_type_t<U>>(value));
+        } else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>) {
+            put_scalar(LogArgTag::INT, static_cast<int64_t>(value));
+        } else if constexpr (std::is_integral_v<U>) {
+            put_scalar(LogArgTag::UINT, static_cast<uint64_t>(value));
+        } else if constexpr (std::is_floating_point_v<U>) {
+            put_scalar(LogArgTag::DOUBLE, static_cast<double>(value));
+        } else if constexpr (std::is_same_v<U, const char*> || std::is_same_v<U, char*>) {
+            put_string(value ? std::string_view(value) : std::string_view("(null)"));
+        } else if constexpr (std::is_convertible_v<const U&, std::string_view>) {
+            put_string(std::string_view(value));
+        } else {
+            static_assert(sizeof(U) == 0, "FAST_LOG argument type not supported");
+        }
+    }
+
+    size_t size() const { return static_cast<size_t>(pos_ - begin_); }
+    bool truncated() const { return truncated_; }
+
+private:
+    template <typename T>
+    void put_scalar(LogArgTag tag, T value) {
+        if (static_cast<size_t>(end_ - pos_) < 1 + sizeof(T)) {
+            truncated_ = true;
+            return;
+        }
+        *pos_++ = static_cast<unsigned char>(tag);
+        std::memcpy(pos_, &value, sizeof(T));
+        pos_ += sizeof(T);
+    }
+
+    void put_string(std::string_view value) {
+        size_t room = static_cast<size_t>(end_ - pos_);
+        if (room < 1 + sizeof(uint16_t)) {
+            truncated_ = true;
+            return;
+        }
+        size_t length = std::min(value.size(), room - 1 - sizeof(uint16_t));
+        truncated_ = truncated_ || length < value.size();
+        uint16_t stored = static_cast<uint16_t>(length);
+        *pos_++ = static_cast<unsigned char>(LogArgTag::STRING);
+        std::memcpy(pos_, &stored, sizeof(stored));
+        pos_ += sizeof(stored);
+        std::memcpy(pos_, value.data(), length);
+        pos_ += length;
+    }
+
+    unsigned char* pos_;
+    unsigned char* begin_;
+    unsigned char* end_;
+    bool truncated_{false};
+};
+
+// Binary logger settings
+struct BinaryLoggerConfig {
+    std::string log_file;                 // Appended to; empty for console only
+    std::shared_ptr<LogFileSink> file_sink;   // Already-open file (LogManager's); used instead of log_file
+    LogLevel min_level{LogLevel::INFO};
+    bool console{true};                   // Also write to stdout (ERROR to stderr)
+    size_t ring_capacity{8192};           // Records per producer thread
+};
+
+/**
+ * Low-latency logging backend with deferred formatting
+ *
+ * A FAST_LOG_* call checks the level (one relaxed load), then writes the
+ * call site's address, a timestamp and the raw arguments into a lock-free
+ * ring owned by the calling thread. Nothing is formatted, allocated or
+ * locked on that thread; if its ring is full the record is dropped and
+ * counted rather than blocking.
+ *
+ * A background thread drains every ring, formats lines in the same layout
+ * as LogManager and writes them in batches, flushing only when it runs out
+ * of work instead of after every line. It is placed as `fast_log`
+ * ([THREADS] FAST_LOG_CPU), read when start() runs.
+ *
+ * @note Lines from one thread stay in order; lines from different threads
+ *       are interleaved per batch, each carrying its own timestamp.
+ */
+class BinaryLogger {
+public:
+    static BinaryLogger& get_instance();
+
+    void start(const BinaryLoggerConfig& config = BinaryLoggerConfig());
+
+    // Drain and write everything logged so far, then stop
+    void stop();
+
+    // Block until everything logged before the call has been written
+    void flush();
+
+    // Hot-path level check; false for every level while stopped
+    static bool is_enabled(LogLevel level) {
+        return static_cast<int>(level) >= min_level_.load(std::memory_order_relaxed);
+    }
+
+    void set_level(LogLevel level);
+
+    template <typename... Args>
+    void write(const LogSite& site, const Args&... args) {
+        ThreadBuffer* buffer = tls_buffer_ ? tls_buffer_ : acquire_thread_buffer();
+        LogRecord* record = buffer->ring.claim();
+        if (!record) {
+            buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        record->site = &site;
+        record->timestamp_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+        LogArgEncoder encoder(record->args, LogRecord::kArgBytes);
+        (encoder.put(args), ...);
+        record->arg_bytes = static_cast<uint16_t>(encoder.size());
+        record->truncated = encoder.truncated();
+        buffer->ring.publish();
+    }
+
+    // Statistics
+    uint64_t get_written_count() const { return written_.load(std::memory_order_relaxed); }
+    uint64_t get_dropped_count() const;
+
+    // Format one record the way the background thread does (exposed for tests)
+    static void format_record(const LogRecord& record, uint32_t thread_index, std::string& out);
+
+private:
+    struct ThreadBuffer {
+        ThreadBuffer(size_t capacity, uint32_t thread_index)
+            : ring(capacity, WaitStrategy::BUSY_SPIN), index(thread_index) {}
+
+        SpscRing<LogRecord> ring;
+        const uint32_t index;
+        std::atomic<bool> retired{false};
+        std::atomic<uint64_t> dropped{0};
+    };
+
+    friend struct ThreadBufferHandle;
+
+    BinaryLogger() = default;
+    ~BinaryLogger();
+
+    ThreadBuffer* acquire_thread_buffer();
+    void worker_loop();
+    size_t drain_all();
+    void write_batches(bool flush_streams);
+
+    static constexpr int kDisabled = static_cast<int>(LogLevel::ERROR) + 1;
+    static inline std::atomic<int> min_level_{kDisabled};
+    static inline thread_local ThreadBuffer* tls_buffer_{nullptr};
+
+    BinaryLoggerConfig config_;
+    std::shared_ptr<LogFileSink> file_;
+
+    mutable std::mutex registry_mutex_;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers_;   // Guarded by registry_mutex_
+    std::atomic<uint64_t> registry_version_{0};
+    std::vector<std::shared_ptr<ThreadBuffer>> worker_buffers_;   // Worker's snapshot
+    uint64_t worker_version_{0};
+    uint32_t next_thread_index_{0};
+
+    std::string out_batch_;
+    std::string err_batch_;
+
+    std::thread worker_;
+    std::atomic<bool> running_{false};
+    std::atomic<uint64_t> flush_requested_{0};
+    std::atomic<uint64_t> flush_completed_{0};
+    std::atomic<uint64_t> written_{0};
+    std::atomic<uint64_t> retired_dropped_{0};
+};
+
+} // namespace logging
+
+/**
+ * Deferred-formatting log macros
+ *
+ * Usage: FAST_LOG_DEBUG("MARKET_SERVER", "Orderbook update: {} bids: {}", symbol, count);
+ * Arguments are not evaluated unless the level is compiled in and enabled.
+ * Supported arguments: integers, floating point, bool, char, enums, C
+ * strings, std::string and std::string_view.
+ */
+#define FAST_LOG(level, component, format, ...) \
+    do { \
+        if constexpr (static_cast<int>(level) >= FAST_LOG_ACTIVE_LEVEL) { \
+            if (logging::BinaryLogger::is_enabled(level)) { \
+                static constexpr logging::LogSite fast_log_site{level, component, format}; \
+                logging::BinaryLogger::get_instance().write(fast_log_site, ##__VA_ARGS__); \
+            } \
+        } \
+    } while (0)
+
+#define FAST_LOG_DEBUG(component, format, ...) FAST_LOG(logging::LogLevel::DEBUG, component, format, ##__VA_ARGS__)
+#define FAST_LOG_INFO(component, format, ...) FAST_LOG(logging::LogLevel::INFO, component, format, ##__VA_ARGS__)
+#define FAST_LOG_WARN(component, format, ...) FAST_LOG(logging::LogLevel::WARN, component, format, ##__VA_ARGS__)
+#define FAST_LOG_ERROR(component, format, ...) FAST_LOG(logging::LogLevel::ERROR, component, format, ##__VA_ARGS__)
@@ -1,4 +1,5 @@
 #include "logger.hpp"
+#include "binary_logger.hpp"
 #include <iostream>
 
 namespace logging {
@@ -10,11 +11,18 @@ void initialize_logging(const std::string& log_file, LogLevel min_level) {
     
     LogManager::get_instance().initialize(log_file, min_level);
     
+    // FAST_LOG_* backend shares the level and writes through LogManager's open file
+    BinaryLoggerConfig fast_config;
+    fast_config.file_sink = LogManager::get_instance().get_file_sink();
+    fast_config.min_level = min_level;
+    BinaryLogger::get_instance().start(fast_config);
+    
     std::cout << "[LOGGING] Logging system initialized" << std::endl;
 }
 
 void cleanup_logging() {
     std::cout << "[LOGGING] Cleaning up logging system..." << std::endl;
+    BinaryLogger::get_instance().stop();
     LogManager::get_instance().shutdown();
 }
 
@@ -8,6 +8,7 @@
 #include <queue>
 #include <mutex>
 #include <condition_variable>
+#include <cstdio>
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -42,6 +43,52 @@ struct LogEntry {
     }
 };
 
+/**
+ * Append-only log file shared by LogManager and BinaryLogger
+ *
+ * Opened once so both backends write through one FILE* and one lock; each
+ * write() is a whole line or batch of lines, so output never splits mid-line.
+ */
+class LogFileSink {
+public:
+    explicit LogFileSink(const std::string& path) : path_(path), file_(std::fopen(path.c_str(), "a")) {}
+    ~LogFileSink() {
+        if (file_) {
+            std::fclose(file_);
+        }
+    }
+    
+    LogFileSink(const LogFileSink&) = delete;
+    LogFileSink& operator=(const LogFileSink&) = delete;
+    
+    bool is_open() const { return file_ != nullptr; }
+    const std::string& path() const { return path_; }
+    
+    void write(const char* data, size_t size, bool flush_now) {
+        if (!file_) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::fwrite(data, 1, size, file_);
+        if (flush_now) {
+            std::fflush(file_);
+        }
+    }
+    
+    void flush() {
+        if (!file_) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::fflush(file_);
+    }
+    
+private:
+    std::string path_;
+    std::FILE* file_;
+    std::mutex mutex_;
+};
+
 class LogManager {
 public:
     static LogManager& get_instance() {
@@ -54,9 +101,10 @@ public:
         
         if (!log_file.empty()) {
             log_file_ = log_file;
-            file_stream_.open(log_file, std::ios::app);
-            if (!file_stream_.is_open()) {
+            file_sink_ = std::make_shared<LogFileSink>(log_file);
+            if (!file_sink_->is_open()) {
                 std::cerr << "[LOG_MANAGER] Failed to open log file: " << log_file << std::endl;
+                file_sink_.reset();
             }
         }
         
@@ -74,9 +122,8 @@ public:
             log_thread_.join();
         }
         
-        if (file_stream_.is_open()) {
-            file_stream_.close();
-        }
+        // Closes the file once BinaryLogger has let go of it too
+        file_sink_.reset();
         
         std::cout << "[LOG_MANAGER] Shutdown complete" << std::endl;
     }
@@ -98,6 +145,9 @@ public:
         min_level_ = level;
     }
     
+    // The open log file, for other backends to write into; null without one
+    std::shared_ptr<LogFileSink> get_file_sink() const { return file_sink_; }
+    
 private:
     LogManager() = default;
     ~LogManager() {
@@ -132,9 +182,9 @@ private:
         }
         
         // Write to file
-        if (file_stream_.is_open()) {
-            file_stream_ << formatted << std::endl;
-            file_stream_.flush();
+        if (file_sink_) {
+            formatted.push_back('\n');
+            file_sink_->write(formatted.data(), formatted.size(), true);
         }
     }
     
@@ -190,7 +240,7 @@ private:
     
     LogLevel min_level_ = LogLevel::INFO;
     std::string log_file_;
-    std::ofstream file_stream_;
+    std::shared_ptr<LogFileSink> file_sink_;
     
     std::atomic<bool> running_{false};
     std::thread log_thread_;
@@ -0,0 +1,218 @@
+#include "local_order_book.hpp"
+
+LocalOrderBook::LocalOrderBook(const std::string& symbol, size_t max_levels)
+  : symbol_(symbol), max_levels_(max_levels == 0 ? DEFAULT_MAX_LEVELS : max_levels) {
+  bids_.reserve(max_levels_);
+  asks_.reserve(max_levels_);
+}
+
+void LocalOrderBook::begin_snapshot(uint64_t last_update_id) {
+  bids_.clear();
+  asks_.clear();
+  synced_ = false;
+  awaiting_bridge_ = false;
+  last_update_id_ = last_update_id;
+  mode_ = Mode::IDLE;
+}
+
+void LocalOrderBook::add_snapshot_level(Side side, double price, double qty) {
+  if (qty <= 0.0) return;
+  (side == Side::BID ? bids_ : asks_).push_back({price, qty});
+}
+
+bool LocalOrderBook::end_snapshot() {
+  std::sort(bids_.begin(), bids_.end(), [](const Level& a, const Level& b) { return a.price < b.price; });
+  std::sort(asks_.begin(), asks_.end(), [](const Level& a, const Level& b) { return a.price > b.price; });
+
+  // Keep the best max_levels_ per side (the back of each array)
+  if (bids_.size() > max_levels_) bids_.erase(bids_.begin(), bids_.end() - max_levels_);
+  if (asks_.size() > max_levels_) asks_.erase(asks_.begin(), asks_.end() - max_levels_);
+
+  synced_ = true;
+  awaiting_bridge_ = true;
+  return replay_buffered();
+}
+
+LocalOrderBook::UpdateResult LocalOrderBook::begin_update(uint64_t first_id, uint64_t last_id, uint64_t prev_id) {
+  if (!synced_) {
+    if (first_id == NO_ID) {
+      // Nothing to order it against once a snapshot arrives
+      ++stale_;
+      mode_ = Mode::DROP;
+      return UpdateResult::STALE;
+    }
+    buffer_update(first_id, last_id, prev_id);
+    mode_ = Mode::BUFFER;
+    return UpdateResult::BUFFERED;
+  }
+
+  if (first_id == NO_ID) {
+    pending_last_id_ = last_update_id_;
+    mode_ = Mode::APPLY;
+    return UpdateResult::APPLIED;
+  }
+
+  bool contiguous;
+  if (awaiting_bridge_) {
+    if (last_id < last_update_id_) {
+      ++stale_;
+      mode_ = Mode::DROP;
+      return UpdateResult::STALE;
+    }
+    contiguous = first_id <= last_update_id_ + 1;
+  } else {
+    if (last_id <= last_update_id_) {
+      ++stale_;
+      mode_ = Mode::DROP;
+      return UpdateResult::STALE;
+    }
+    contiguous = is_contiguous(first_id, prev_id);
+  }
+
+  if (!contiguous) {
+    ++gaps_;
+    invalidate();
+    buffer_update(first_id, last_id, prev_id);
+    mode_ = Mode::BUFFER;
+    return UpdateResult::GAP;
+  }
+
+  awaiting_bridge_ = false;
+  pending_last_id_ = last_id;
+  mode_ = Mode::APPLY;
+  return UpdateResult::APPLIED;
+}
+
+void LocalOrderBook::apply_level(Side side, double price, double qty) {
+  switch (mode_) {
+    case Mode::APPLY:
+      set_level(side, price, qty);
+      break;
+    case Mode::BUFFER:
+      buffered_levels_.push_back({side, price, qty});
+      ++buffered_updates_.back().count;
+      break;
+    case Mode::IDLE:
+    case Mode::DROP:
+      break;
+  }
+}
+
+void LocalOrderBook::end_update() {
+  if (mode_ == Mode::APPLY) {
+    last_update_id_ = pending_last_id_;
+  }
+  mode_ = Mode::IDLE;
+}
+
+bool LocalOrderBook::resync() {
+  if (!resync_handler_) return false;
+
+  auto now = std::chrono::steady_clock::now();
+  if (resyncs_ > 0 && now - last_resync_attempt_ < min_resync_interval_) {
+    return false;
+  }
+  last_resync_attempt_ = now;
+  ++resyncs_;
+
+  bool ok = resync_handler_(*this);
+  if (!ok) ++resync_failures_;
+  return ok;
+}
+
+void LocalOrderBook::invalidate() {
+  bids_.clear();
+  asks_.clear();
+  buffered_updates_.clear();
+  buffered_levels_.clear();
+  synced_ = false;
+  awaiting_bridge_ = false;
+  mode_ = Mode::IDLE;
+}
+
+bool LocalOrderBook::is_contiguous(uint64_t first_id, uint64_t prev_id) const {
+  return prev_id != NO_ID ? prev_id == last_update_id_ : first_id == last_update_id_ + 1;
+}
+
+void LocalOrderBook::buffer_update(uint64_t first_id, uint64_t last_id, uint64_t prev_id) {
+  if (buffered_levels_.size() >= DEFAULT_MAX_BUFFERED_LEVELS) {
+    // Resync has been failing for a long time; start over from this diff
+    ++buffer_overflows_;
+    buffered_updates_.clear();
+    buffered_levels_.clear();
+  }
+  buffered_updates_.push_back({first_id, last_id, prev_id,
+                               static_cast<uint32_t>(buffered_levels_.size()), 0});
+}
+
+bool LocalOrderBook::replay_buffered() {
+  for (size_t i = 0; i < buffered_updates_.size(); ++i) {
+    const BufferedUpdate& update = buffered_updates_[i];
+
+    bool contiguous;
+    if (awaiting_bridge_) {
+      if (update.last_id < last_update_id_) continue;
+      contiguous = update.first_id <= last_update_id_ + 1;
+    } else {
+      if (update.last_id <= last_update_id_) continue;
+      contiguous = is_contiguous(update.first_id, update.prev_id);
+    }
+
+    if (!contiguous) {
+      if (!awaiting_bridge_) {
+        // Break inside the buffer: everything before it can never be bridged
+        uint32_t base = update.begin;
+        buffered_levels_.erase(buffered_levels_.begin(), buffered_levels_.begin() + base);
+        buffered_updates_.erase(buffered_updates_.begin(), buffered_updates_.begin() + i);
+        for (auto& remaining : buffered_updates_) remaining.begin -= base;
+      }
+      // Otherwise the snapshot predates the buffer; keep it for the next attempt
+      bids_.clear();
+      asks_.clear();
+      synced_ = false;
+      awaiting_bridge_ = false;
+      return false;
+    }
+
+    for (uint32_t j = 0; j < update.count; ++j) {
+      const BufferedLevel& level = buffered_levels_[update.begin + j];
+      set_level(level.side, level.price, level.qty);
+    }
+    last_update_id_ = update.last_id;
+    awaiting_bridge_ = false;
+  }
+
+  buffered_updates_.clear();
+  buffered_levels_.clear();
+  return true;
+}
+
+void LocalOrderBook::set_level(Side side, double price, double qty) {
+  std::vector<Level>& levels = side == Side::BID ? bids_ : asks_;
+
+  // Arrays run worst-to-best: ascending for bids, descending for asks
+  auto it = side == Side::BID
+    ? std::lower_bound(levels.begin(), levels.end(), price,
+                       [](const Level& level, double p) { return level.price < p; })
+    : std::lower_bound(levels.begin(), levels.end(), price,
+                       [](const Level& level, double p) { return level.price > p; });
+
+  if (it != levels.end() && it->price == price) {
+    if (qty <= 0.0) {
+      levels.erase(it);
+    } else {
+      it->qty = qty;
+    }
+    return;
+  }
+  if (qty <= 0.0) return;
+
+  size_t pos = static_cast<size_t>(it - levels.begin());
+  if (levels.size() >= max_levels_) {
+    // Full: the new level displaces the worst one, unless it is worse still
+    if (pos == 0) return;
+    levels.erase(levels.begin());
+    --pos;
+  }
+  levels.insert(levels.begin() + pos, {price, qty});
+}
@@ -0,0 +1,162 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * LocalOrderBook - L2 book for one instrument maintained from a diff stream
+ *
+ * Each side is a flat array sorted worst-to-best, so the best price sits at
+ * the back and the updates that dominate a diff stream (near the touch)
+ * only shift a handful of levels. Diffs carry absolute level quantities;
+ * a quantity of 0 removes the level.
+ *
+ * Every diff is bracketed by begin_update()/end_update() with the venue's
+ * update ids. A diff is contiguous when its prev id equals the last applied
+ * id or, without a prev id, when it starts at last id + 1. The first diff
+ * after a snapshot only has to bridge it (first_id <= id + 1 <= last_id).
+ * A break invalidates the book and switches it to buffering; resync() then
+ * runs the installed handler, which reloads a snapshot through
+ * begin_snapshot()/add_snapshot_level()/end_snapshot(). Buffered diffs
+ * newer than the snapshot are replayed on top of it.
+ *
+ * This covers the Binance U/u/pu procedure as well as plain
+ * sequence-numbered delta feeds. Not thread-safe: drive it from the
+ * thread that receives the venue's messages.
+ */
+class LocalOrderBook {
+public:
+  struct Level {
+    double price;
+    double qty;
+  };
+
+  enum class Side : uint8_t { BID, ASK };
+
+  enum class UpdateResult : uint8_t {
+    APPLIED,    // Contiguous; levels go straight into the book
+    BUFFERED,   // Book not synced; levels are kept for replay after the next snapshot
+    STALE,      // Already covered by the book; levels are dropped
+    GAP         // Sequence break; book invalidated, levels buffered, resync() required
+  };
+
+  // Marks a missing update id. Diffs without ids are applied unchecked when synced.
+  static constexpr uint64_t NO_ID = UINT64_MAX;
+  static constexpr size_t DEFAULT_MAX_LEVELS = 5000;
+  static constexpr size_t DEFAULT_MAX_BUFFERED_LEVELS = 100000;
+  static constexpr int DEFAULT_MIN_RESYNC_INTERVAL_MS = 1000;
+
+  // Reloads the book via begin_snapshot()/add_snapshot_level()/end_snapshot(),
+  // or arranges for that to happen (e.g. by re-subscribing to a feed that opens
+  // with a snapshot). Returns false if the resync could not be carried out.
+  using ResyncHandler = std::function<bool(LocalOrderBook&)>;
+
+  explicit LocalOrderBook(const std::string& symbol, size_t max_levels = DEFAULT_MAX_LEVELS);
+
+  // Snapshot loading; levels may be added in any order
+  void begin_snapshot(uint64_t last_update_id);
+  void add_snapshot_level(Side side, double price, double qty);
+  bool end_snapshot();
+
+  // Diff application
+  UpdateResult begin_update(uint64_t first_id, uint64_t last_id, uint64_t prev_id = NO_ID);
+  void apply_level(Side side, double price, double qty);
+  void end_update();
+
+  // Resynchronisation
+  void set_resync_handler(ResyncHandler handler) { resync_handler_ = std::move(handler); }
+  void set_min_resync_interval_ms(int interval_ms) { min_resync_interval_ = std::chrono::milliseconds(interval_ms); }
+  bool needs_resync() const { return !synced_; }
+  bool resync();
+  void invalidate();
+
+  // Book state
+  const std::string& symbol() const { return symbol_; }
+  bool is_synced() const { return synced_; }
+  uint64_t last_update_id() const { return last_update_id_; }
+  size_t bid_depth() const { return bids_.size(); }
+  size_t ask_depth() const { return asks_.size(); }
+  const Level* best_bid() const { return bids_.empty() ? nullptr : &bids_.back(); }
+  const Level* best_ask() const { return asks_.empty() ? nullptr : &asks_.back(); }
+  const Level& bid(size_t i) const { return bids_[bids_.size() - 1 - i]; }   // 0 = best
+  const Level& ask(size_t i) const { return asks_[asks_.size() - 1 - i]; }   // 0 = best
+
+  // Writes the top `depth` levels per side, best first, into a proto-style
+  // snapshot (clear_bids()/add_bids()/set_price()/set_qty()). Clearing keeps
+  // the repeated fields' allocations, so a reused snapshot does not allocate.
+  template <typename Snapshot>
+  void write_snapshot(Snapshot& out, size_t depth) const {
+    out.clear_bids();
+    out.clear_asks();
+    const size_t bid_count = std::min(depth, bids_.size());
+    for (size_t i = 0; i < bid_count; ++i) {
+      auto* level = out.add_bids();
+      level->set_price(bid(i).price);
+      level->set_qty(bid(i).qty);
+    }
+    const size_t ask_count = std::min(depth, asks_.size());
+    for (size_t i = 0; i < ask_count; ++i) {
+      auto* level = out.add_asks();
+      level->set_price(ask(i).price);
+      level->set_qty(ask(i).qty);
+    }
+  }
+
+  // Statistics
+  uint64_t get_gap_count() const { return gaps_; }
+  uint64_t get_stale_count() const { return stale_; }
+  uint64_t get_resync_count() const { return resyncs_; }
+  uint64_t get_resync_failures() const { return resync_failures_; }
+  uint64_t get_buffer_overflows() const { return buffer_overflows_; }
+
+private:
+  enum class Mode : uint8_t { IDLE, APPLY, BUFFER, DROP };
+
+  struct BufferedUpdate {
+    uint64_t first_id;
+    uint64_t last_id;
+    uint64_t prev_id;
+    uint32_t begin;    // index of the first level in buffered_levels_
+    uint32_t count;
+  };
+
+  struct BufferedLevel {
+    Side side;
+    double price;
+    double qty;
+  };
+
+  std::string symbol_;
+  size_t max_levels_;
+  std::vector<Level> bids_;   // ascending price: best bid at the back
+  std::vector<Level> asks_;   // descending price: best ask at the back
+
+  bool synced_{false};
+  bool awaiting_bridge_{false};
+  uint64_t last_update_id_{0};
+
+  Mode mode_{Mode::IDLE};
+  uint64_t pending_last_id_{0};
+
+  std::vector<BufferedUpdate> buffered_updates_;
+  std::vector<BufferedLevel> buffered_levels_;
+
+  ResyncHandler resync_handler_;
+  std::chrono::milliseconds min_resync_interval_{DEFAULT_MIN_RESYNC_INTERVAL_MS};
+  std::chrono::steady_clock::time_point last_resync_attempt_{};
+
+  uint64_t gaps_{0};
+  uint64_t stale_{0};
+  uint64_t resyncs_{0};
+  uint64_t resync_failures_{0};
+  uint64_t buffer_overflows_{0};
+
+  bool is_contiguous(uint64_t first_id, uint64_t prev_id) const;
+  void buffer_update(uint64_t first_id, uint64_t last_id, uint64_t prev_id);
+  bool replay_buffered();
+  void set_level(Side side, double price, double qty);
+};
@@ -0,0 +1,79 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+/**
+ * Zero-allocation market data parsing for public websocket feeds
+ *
+ * An IMarketDataParser turns one raw message into a ParsedMarketData that
+ * the caller owns and reuses for every message. Levels and trades are
+ * appended to vectors that are cleared, never freed, so once they reach
+ * their high-water mark a parse allocates nothing and builds no DOM.
+ *
+ * String fields are views into the message or into parser-owned storage
+ * and stay valid until the next parse() on the same parser. Numeric
+ * fields keep the venue's units (e.g. Binance ms, GRVT ms or ns); the
+ * subscriber normalises them as it always has.
+ */
+
+struct MdLevel {
+  double price;
+  double qty;
+};
+
+struct MdTrade {
+  double price{0.0};
+  double qty{0.0};
+  bool is_buyer_maker{false};
+  uint64_t exchange_time{0};
+  std::string_view trade_id;   // empty when the venue sends a numeric id
+  uint64_t trade_seq{0};       // numeric trade id / sequence
+};
+
+enum class MdMessageType : uint8_t {
+  UNKNOWN,         // parsed, but not a message the subscribers act on (e.g. ticker)
+  BOOK_SNAPSHOT,   // full top-N book
+  BOOK_DELTA,      // incremental level changes, see first_id/last_id/prev_id
+  TRADE,
+  CONTROL          // subscription responses and errors
+};
+
+struct ParsedMarketData {
+  static constexpr uint64_t NO_ID = UINT64_MAX;
+
+  MdMessageType type{MdMessageType::UNKNOWN};
+  bool is_error{false};
+  std::string_view channel;      // stream / channel / method as sent by the venue
+  std::string_view symbol;
+  uint64_t exchange_time{0};     // event time in the venue's unit, 0 if absent
+
+  // Book update ids (Binance U/u/pu, GRVT sequence numbers, Deribit change ids)
+  uint64_t first_id{NO_ID};
+  uint64_t last_id{NO_ID};
+  uint64_t prev_id{NO_ID};
+
+  std::vector<MdLevel> bids;     // venue order
+  std::vector<MdLevel> asks;
+  std::vector<MdTrade> trades;
+
+  void reset() {
+    type = MdMessageType::UNKNOWN;
+    is_error = false;
+    channel = {};
+    symbol = {};
+    exchange_time = 0;
+    first_id = last_id = prev_id = NO_ID;
+    bids.clear();
+    asks.clear();
+    trades.clear();
+  }
+};
+
+class IMarketDataParser {
+public:
+  virtual ~IMarketDataParser() = default;
+
+  // Resets `out` and fills it from `message`; false if the message is malformed
+  virtual bool parse(std::string_view message, ParsedMarketData& out) = 0;
+};
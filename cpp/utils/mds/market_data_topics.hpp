@@ -0,0 +1,41 @@
+#pragma once
+#include <algorithm>
+#include <cctype>
+#include <string>
+
+/**
+ * ZMQ topic layout for data published by market_server
+ *
+ *   <channel>.<EXCHANGE>.<SYMBOL>|    e.g. "market_data.BINANCE.BTCUSDT|"
+ *
+ * ZMQ filters subscriptions by prefix, so consumers can subscribe to a
+ * whole channel ("market_data"), one venue ("market_data.BINANCE.") or a
+ * single instrument (the full topic). The trailing '|' ends the symbol, so
+ * subscribing to "BTCUSDT" does not also deliver "BTCUSDT_PERP". Exchange
+ * names are upper-cased so "binance" and "BINANCE" map to the same topic.
+ */
+namespace md_topics {
+
+constexpr const char* ORDERBOOK = "market_data";
+constexpr const char* ORDERBOOK_BINARY = "book_bin";   // md_binary::BookMessage payloads
+constexpr const char* TRADES = "trades";
+constexpr char SYMBOL_END = '|';
+
+inline std::string venue_prefix(const std::string& channel, const std::string& exchange) {
+  std::string topic;
+  topic.reserve(channel.size() + exchange.size() + 2);
+  topic.append(channel).push_back('.');
+  for (char c : exchange) {
+    topic.push_back(static_cast<char>(std::toupper(static_cast<unsigned char>(c))));
+  }
+  topic.push_back('.');
+  return topic;
+}
+
+inline std::string make_topic(const std::string& channel, const std::string& exchange, const std::string& symbol) {
+  std::string topic = venue_prefix(channel, exchange);
+  topic.append(symbol).push_back(SYMBOL_END);
+  return topic;
+}
+
+} // namespace md_topics
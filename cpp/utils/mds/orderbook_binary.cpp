@@ -1,78 +1,60 @@
 #include "orderbook_binary.hpp"
-#include <cstring>
 #include <algorithm>
+#include <cctype>
+#include <stdexcept>
 
-void OrderBookBinaryHelper::serialize(const std::string& symbol, 
-                                     const std::vector<std::pair<double, double>>& bids,
-                                     const std::vector<std::pair<double, double>>& asks,
-                                     uint64_t timestamp_us,
-                                     uint32_t sequence,
-                                     char* buffer,
-                                     size_t buffer_size) {
-  if (!buffer || buffer_size < calculate_size(symbol.length(), bids.size(), asks.size())) {
-    return;
-  }
-  
-  OrderBookBinary* ob = reinterpret_cast<OrderBookBinary*>(buffer);
-  ob->timestamp_us = timestamp_us;
-  ob->sequence = sequence;
-  ob->symbol_len = symbol.length();
-  
-  // Copy symbol (null-padded)
-  std::memset(ob->symbol, 0, 32);
-  std::strncpy(ob->symbol, symbol.c_str(), std::min(symbol.length(), size_t(31)));
-  
-  ob->bid_count = bids.size();
-  ob->ask_count = asks.size();
-  
-  // Copy bid levels (highest to lowest)
-  double* level_ptr = ob->levels;
-  for (const auto& bid : bids) {
-    *level_ptr++ = bid.first;   // price
-    *level_ptr++ = bid.second;  // size
-  }
-  
-  // Copy ask levels (lowest to highest)
-  for (const auto& ask : asks) {
-    *level_ptr++ = ask.first;   // price
-    *level_ptr++ = ask.second; // size
-  }
+namespace md_binary {
+
+namespace {
+
+bool same_exchange(const std::string& a, const std::string& b) {
+  return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+    return std::toupper(static_cast<unsigned char>(x)) == std::toupper(static_cast<unsigned char>(y));
+  });
+}
+
+} // namespace
+
+InstrumentRegistry& InstrumentRegistry::instance() {
+  static InstrumentRegistry registry;
+  return registry;
 }
 
-bool OrderBookBinaryHelper::deserialize(const char* buffer, 
-                                       size_t buffer_size,
-                                       std::string& symbol,
-                                       std::vector<std::pair<double, double>>& bids,
-                                       std::vector<std::pair<double, double>>& asks,
-                                       uint64_t& timestamp_us,
-                                       uint32_t& sequence) {
-  if (!buffer || buffer_size < 16) return false;
-  
-  const OrderBookBinary* ob = reinterpret_cast<const OrderBookBinary*>(buffer);
-  
-  if (buffer_size < calculate_size(ob->symbol_len, ob->bid_count, ob->ask_count)) {
-    return false;
+uint32_t InstrumentRegistry::make_id(const std::string& exchange, const std::string& symbol) {
+  uint32_t hash = 2166136261u;
+  auto mix = [&hash](unsigned char c) {
+    hash ^= c;
+    hash *= 16777619u;
+  };
+  for (char c : exchange) {
+    mix(static_cast<unsigned char>(std::toupper(static_cast<unsigned char>(c))));
   }
-  
-  timestamp_us = ob->timestamp_us;
-  sequence = ob->sequence;
-  
-  symbol.assign(ob->symbol, ob->symbol_len);
-  
-  bids.clear();
-  asks.clear();
-  
-  const double* level_ptr = ob->levels;
-  
-  // Read bid levels
-  for (uint32_t i = 0; i < ob->bid_count; ++i) {
-    bids.emplace_back(*level_ptr++, *level_ptr++);
+  mix(':');
+  for (char c : symbol) {
+    mix(static_cast<unsigned char>(c));
   }
-  
-  // Read ask levels
-  for (uint32_t i = 0; i < ob->ask_count; ++i) {
-    asks.emplace_back(*level_ptr++, *level_ptr++);
+  return hash;
+}
+
+uint32_t InstrumentRegistry::intern(const std::string& exchange, const std::string& symbol) {
+  const uint32_t id = make_id(exchange, symbol);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = instruments_.find(id);
+  if (it == instruments_.end()) {
+    // Keeps the exchange spelling of the first caller ("binance" stays "binance")
+    instruments_.emplace(id, std::make_unique<Instrument>(Instrument{id, exchange, symbol}));
+  } else if (!same_exchange(it->second->exchange, exchange) || it->second->symbol != symbol) {
+    throw std::runtime_error("Instrument id collision: " + exchange + ":" + symbol + " and " +
+                             it->second->exchange + ":" + it->second->symbol);
   }
-  
-  return true;
+  return id;
 }
+
+const InstrumentRegistry::Instrument* InstrumentRegistry::find(uint32_t id) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = instruments_.find(id);
+  return it == instruments_.end() ? nullptr : it->second.get();
+}
+
+} // namespace md_binary
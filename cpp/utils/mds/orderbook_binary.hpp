@@ -1,50 +1,206 @@
 #pragma once
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
 #include <string>
-#include <vector>
-
-// Fast binary orderbook format for same-host communication
-// All fields are little-endian for x86_64 compatibility
-struct OrderBookBinary {
-  // Header (16 bytes)
-  uint64_t timestamp_us;    // microsecond timestamp
-  uint32_t sequence;        // sequence number for gap detection
-  uint32_t symbol_len;      // length of symbol string
-  
-  // Symbol (variable length, null-terminated)
-  char symbol[32];          // fixed 32 chars max, null-padded
-  
-  // Price levels (variable count)
-  uint32_t bid_count;       // number of bid levels
-  uint32_t ask_count;       // number of ask levels
-  
-  // Level data: [price(8), size(8)] pairs
-  // Bids first (highest to lowest), then asks (lowest to highest)
-  double levels[];           // flexible array: 2 * (bid_count + ask_count) doubles
-  
-  // Total size = 16 + symbol_len + 4 + 4 + 8 * 2 * (bid_count + ask_count)
+#include <unordered_map>
+
+/**
+ * Fixed-layout binary order book message for same-host market data
+ *
+ * A book is one fixed-size, cache-line-aligned struct: a 64-byte header
+ * followed by Depth bid and Depth ask levels. Consumers validate it with
+ * BookCodec::view() and read it in place; there is no decode step and no
+ * allocation. Instruments are numeric ids (InstrumentRegistry) instead of
+ * exchange/symbol strings.
+ *
+ * The first byte of every message is zero. Protobuf field number 0 is
+ * invalid, so a payload starting with it can never be a protobuf message;
+ * receivers use that to tell the two formats apart and fall back to
+ * protobuf for anything else. All fields are little-endian (x86_64).
+ */
+namespace md_binary {
+
+constexpr size_t kCacheLineSize = 64;
+constexpr uint32_t kBookMagic = 0x4B4F4200;   // "\0BOK" on the wire
+constexpr uint16_t kBookVersion = 1;
+constexpr size_t kDefaultBookDepth = 20;      // market_server MAX_DEPTH default
+
+struct BookLevel {
+  double price;
+  double qty;
 };
 
-// Helper functions for binary orderbook
-class OrderBookBinaryHelper {
-public:
-  static size_t calculate_size(uint32_t symbol_len, uint32_t bid_count, uint32_t ask_count) {
-    return 16 + symbol_len + 4 + 4 + 8 * 2 * (bid_count + ask_count);
+template <size_t Depth>
+struct alignas(kCacheLineSize) BookMessage {
+  // Header: one cache line
+  uint32_t magic;
+  uint16_t version;
+  uint16_t depth;             // Levels per side this layout holds (Depth)
+  uint32_t instrument_id;
+  uint16_t bid_count;
+  uint16_t ask_count;
+  uint64_t sequence;          // Per instrument, for gap detection
+  uint64_t timestamp_us;
+  // Latency trace stamps (CLOCK_MONOTONIC ns, 0 when tracing is off)
+  uint64_t md_recv_ns;
+  uint64_t md_parsed_ns;
+  uint64_t md_publish_ns;
+  uint8_t reserved[8];
+
+  // Bids best (highest) first, asks best (lowest) first
+  BookLevel bids[Depth];
+  BookLevel asks[Depth];
+};
+
+/**
+ * Encodes and validates BookMessage<Depth>
+ *
+ * encode() and decode() are templated on the snapshot type so they work on
+ * proto::OrderBookSnapshot (or anything with the same accessors) without
+ * this header depending on protobuf.
+ */
+template <size_t Depth>
+class BookCodec {
+ public:
+  using Message = BookMessage<Depth>;
+  static constexpr size_t kSize = sizeof(Message);
+
+  static_assert(offsetof(Message, bids) == kCacheLineSize, "header must fill exactly one cache line");
+  static_assert(sizeof(Message) % kCacheLineSize == 0, "message must be a whole number of cache lines");
+
+  /**
+   * Writes snapshot into buffer; levels beyond Depth are dropped.
+   *
+   * @param buffer Destination, aligned to kCacheLineSize
+   * @return Bytes written (kSize), or 0 if the buffer is too small or misaligned
+   */
+  template <typename Snapshot>
+  static size_t encode(const Snapshot& snapshot, uint32_t instrument_id, uint64_t sequence,
+                       void* buffer, size_t capacity) {
+    if (capacity < kSize || reinterpret_cast<uintptr_t>(buffer) % alignof(Message) != 0) {
+      return 0;
+    }
+    Message* message = static_cast<Message*>(buffer);
+    message->magic = kBookMagic;
+    message->version = kBookVersion;
+    message->depth = static_cast<uint16_t>(Depth);
+    message->instrument_id = instrument_id;
+    message->sequence = sequence;
+    message->timestamp_us = snapshot.timestamp_us();
+    message->md_recv_ns = snapshot.trace().md_recv_ns();
+    message->md_parsed_ns = snapshot.trace().md_parsed_ns();
+    message->md_publish_ns = snapshot.trace().md_publish_ns();
+    std::memset(message->reserved, 0, sizeof(message->reserved));
+    message->bid_count = copy_levels(snapshot.bids(), message->bids);
+    message->ask_count = copy_levels(snapshot.asks(), message->asks);
+    return kSize;
+  }
+
+  /**
+   * Validated in-place view of a received payload
+   *
+   * @return The message, or nullptr if data is not a version-matching book of
+   *         this depth (or is misaligned); callers then try protobuf
+   */
+  static const Message* view(const void* data, size_t size) {
+    if (size != kSize || reinterpret_cast<uintptr_t>(data) % alignof(Message) != 0) {
+      return nullptr;
+    }
+    const Message* message = static_cast<const Message*>(data);
+    if (message->magic != kBookMagic || message->version != kBookVersion || message->depth != Depth ||
+        message->bid_count > Depth || message->ask_count > Depth) {
+      return nullptr;
+    }
+    return message;
   }
-  
-  static void serialize(const std::string& symbol, 
-                       const std::vector<std::pair<double, double>>& bids,
-                       const std::vector<std::pair<double, double>>& asks,
-                       uint64_t timestamp_us,
-                       uint32_t sequence,
-                       char* buffer,
-                       size_t buffer_size);
-                       
-  static bool deserialize(const char* buffer, 
-                         size_t buffer_size,
-                         std::string& symbol,
-                         std::vector<std::pair<double, double>>& bids,
-                         std::vector<std::pair<double, double>>& asks,
-                         uint64_t& timestamp_us,
-                         uint32_t& sequence);
+
+  /**
+   * Fills a protobuf-style snapshot for consumers that want one. Reuses the
+   * snapshot's existing level objects and string capacity, so a snapshot
+   * kept across ticks stops allocating once it has seen the deepest book.
+   */
+  template <typename Snapshot>
+  static void decode(const Message& message, const std::string& exchange, const std::string& symbol,
+                     Snapshot& snapshot) {
+    snapshot.set_exch(exchange);
+    snapshot.set_symbol(symbol);
+    snapshot.set_timestamp_us(message.timestamp_us);
+    assign_levels(message.bids, message.bid_count, *snapshot.mutable_bids());
+    assign_levels(message.asks, message.ask_count, *snapshot.mutable_asks());
+    if (message.md_recv_ns != 0) {
+      auto* trace = snapshot.mutable_trace();
+      trace->Clear();
+      trace->set_md_recv_ns(message.md_recv_ns);
+      trace->set_md_parsed_ns(message.md_parsed_ns);
+      trace->set_md_publish_ns(message.md_publish_ns);
+    } else {
+      snapshot.clear_trace();
+    }
+  }
+
+ private:
+  template <typename Levels>
+  static uint16_t copy_levels(const Levels& levels, BookLevel* out) {
+    const size_t count = std::min(static_cast<size_t>(levels.size()), Depth);
+    for (size_t i = 0; i < count; ++i) {
+      out[i].price = levels[static_cast<int>(i)].price();
+      out[i].qty = levels[static_cast<int>(i)].qty();
+    }
+    std::memset(out + count, 0, (Depth - count) * sizeof(BookLevel));
+    return static_cast<uint16_t>(count);
+  }
+
+  template <typename Repeated>
+  static void assign_levels(const BookLevel* levels, uint16_t count, Repeated& out) {
+    // Drop surplus from the tail (RepeatedPtrField keeps cleared elements for reuse)
+    while (out.size() > count) {
+      out.RemoveLast();
+    }
+    for (uint16_t i = 0; i < count; ++i) {
+      auto* level = i < out.size() ? out.Mutable(i) : out.Add();
+      level->set_price(levels[i].price);
+      level->set_qty(levels[i].qty);
+    }
+  }
+};
+
+using DefaultBookMessage = BookMessage<kDefaultBookDepth>;
+using DefaultBookCodec = BookCodec<kDefaultBookDepth>;
+
+/**
+ * Interned instrument ids
+ *
+ * An id is a 32-bit FNV-1a hash of "EXCHANGE:SYMBOL" (exchange upper-cased,
+ * as in md_topics), so publisher and consumers derive the same id without
+ * exchanging a table. Each process interns the instruments it handles;
+ * intern() rejects the (unlikely) case of two instruments hashing to the
+ * same id.
+ */
+class InstrumentRegistry {
+ public:
+  struct Instrument {
+    uint32_t id;
+    std::string exchange;
+    std::string symbol;
+  };
+
+  static InstrumentRegistry& instance();
+
+  static uint32_t make_id(const std::string& exchange, const std::string& symbol);
+
+  // Registers the instrument (idempotent); throws std::runtime_error on an id collision
+  uint32_t intern(const std::string& exchange, const std::string& symbol);
+
+  // nullptr if the id was never interned in this process; pointers stay valid
+  const Instrument* find(uint32_t id) const;
+
+ private:
+  mutable std::mutex mutex_;
+  std::unordered_map<uint32_t, std::unique_ptr<Instrument>> instruments_;
 };
+
+} // namespace md_binary
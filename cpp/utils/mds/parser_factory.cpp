@@ -1,4 +1,5 @@
 #include "parser_factory.hpp"
+#include "simdjson_market_data_parsers.hpp"
 #include "../logging/log_helper.hpp"
 #include <algorithm>
 
@@ -18,4 +19,19 @@ std::unique_ptr<IExchangeParser> create_exchange_parser(const std::string& parse
   return nullptr;
 }
 
+std::unique_ptr<IMarketDataParser> create_market_data_parser(const std::string& exchange_name) {
+  std::string name = exchange_name;
+  std::transform(name.begin(), name.end(), name.begin(), ::toupper);
+  if (name == "BINANCE") {
+    return std::make_unique<BinanceJsonParser>();
+  }
+  if (name == "GRVT") {
+    return std::make_unique<GrvtJsonParser>();
+  }
+  if (name == "DERIBIT") {
+    return std::make_unique<DeribitJsonParser>();
+  }
 
+  LOG_ERROR_COMP("PARSER_FACTORY", "Unsupported market data parser: " + exchange_name);
+  return nullptr;
+}
@@ -2,9 +2,14 @@
 #include <memory>
 #include <string>
 #include "market_data_normalizer.hpp"
+#include "market_data_parser.hpp"
 
 // Factory to create exchange parsers by name
 std::unique_ptr<IExchangeParser> create_exchange_parser(const std::string& parser_name,
                                                         const std::string& symbol_for_mock);
 
 
+
+// Factory for the zero-allocation websocket parsers (BINANCE, GRVT, DERIBIT);
+// returns nullptr for unsupported exchanges
+std::unique_ptr<IMarketDataParser> create_market_data_parser(const std::string& exchange_name);
@@ -0,0 +1,441 @@
+#include "simdjson_market_data_parsers.hpp"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <utility>
+
+using simdjson::ondemand::json_type;
+
+namespace {
+
+bool contains(std::string_view text, std::string_view token) {
+  return text.find(token) != std::string_view::npos;
+}
+
+bool starts_with(std::string_view text, std::string_view prefix) {
+  return text.substr(0, prefix.size()) == prefix;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// SimdJsonMarketDataParser
+// ---------------------------------------------------------------------------
+
+simdjson::error_code SimdJsonMarketDataParser::iterate(std::string_view message,
+                                                       simdjson::ondemand::document& doc) {
+  const size_t required = message.size() + simdjson::SIMDJSON_PADDING;
+  if (required > buffer_capacity_) {
+    buffer_capacity_ = std::max(required, buffer_capacity_ * 2);
+    buffer_.reset(new char[buffer_capacity_]);
+  }
+  std::memcpy(buffer_.get(), message.data(), message.size());
+  std::memset(buffer_.get() + message.size(), 0, simdjson::SIMDJSON_PADDING);
+  end_ = buffer_.get() + message.size();
+  return parser_.iterate(buffer_.get(), message.size(), buffer_capacity_).get(doc);
+}
+
+bool SimdJsonMarketDataParser::read_double(value& val, double& out) const {
+  json_type type;
+  if (val.type().get(type)) return false;
+  if (type != json_type::string) return !val.get_double().get(out);
+
+  // Quoted number: convert straight from the input, no unescaped copy
+  simdjson::ondemand::raw_json_string raw;
+  if (val.get_raw_json_string().get(raw)) return false;
+  const char* first = raw.raw();
+  auto result = std::from_chars(first, end_, out);
+  return result.ec == std::errc() && result.ptr != first && *result.ptr == '"';
+}
+
+bool SimdJsonMarketDataParser::read_uint64(value& val, uint64_t& out) const {
+  json_type type;
+  if (val.type().get(type)) return false;
+  if (type != json_type::string) return !val.get_uint64().get(out);
+
+  simdjson::ondemand::raw_json_string raw;
+  if (val.get_raw_json_string().get(raw)) return false;
+  const char* first = raw.raw();
+  auto result = std::from_chars(first, end_, out);
+  return result.ec == std::errc() && result.ptr != first && *result.ptr == '"';
+}
+
+bool SimdJsonMarketDataParser::read_levels(value& val, std::vector<MdLevel>& out) const {
+  simdjson::ondemand::array levels;
+  if (val.get_array().get(levels)) return false;
+
+  for (auto level_result : levels) {
+    value level;
+    json_type type;
+    if (std::move(level_result).get(level) || level.type().get(type)) return false;
+
+    if (type == json_type::object) {
+      MdLevel parsed{0.0, 0.0};
+      if (!read_level_object(level, parsed)) return false;
+      out.push_back(parsed);
+      continue;
+    }
+    if (type != json_type::array) return false;
+
+    simdjson::ondemand::array elements;
+    if (level.get_array().get(elements)) return false;
+
+    double numbers[2] = {0.0, 0.0};
+    size_t count = 0;
+    bool deleted = false;
+    for (auto element_result : elements) {
+      value element;
+      json_type element_type;
+      if (std::move(element_result).get(element) || element.type().get(element_type)) return false;
+
+      if (element_type == json_type::string) {
+        simdjson::ondemand::raw_json_string raw;
+        if (element.get_raw_json_string().get(raw)) return false;
+        const char* first = raw.raw();
+        if (std::isalpha(static_cast<unsigned char>(*first))) {
+          // Deribit action: "new" / "change" / "delete"
+          deleted = raw.unsafe_is_equal("delete");
+          continue;
+        }
+        if (count == 2) continue;
+        auto result = std::from_chars(first, end_, numbers[count]);
+        if (result.ec != std::errc() || result.ptr == first) return false;
+        ++count;
+      } else if (count < 2) {
+        if (element.get_double().get(numbers[count])) return false;
+        ++count;
+      }
+    }
+    if (count < 2) return false;
+    out.push_back({numbers[0], deleted ? 0.0 : numbers[1]});
+  }
+  return true;
+}
+
+bool SimdJsonMarketDataParser::read_level_object(value& val, MdLevel& out) const {
+  simdjson::ondemand::object object;
+  if (val.get_object().get(object)) return false;
+
+  for (auto field_result : object) {
+    simdjson::ondemand::field field;
+    std::string_view key;
+    if (std::move(field_result).get(field) || field.unescaped_key().get(key)) return false;
+    value& field_value = field.value();
+    if (key == "price" || key == "p") {
+      if (!read_double(field_value, out.price)) return false;
+    } else if (key == "size" || key == "s" || key == "qty" || key == "amount") {
+      if (!read_double(field_value, out.qty)) return false;
+    }
+  }
+  return true;
+}
+
+// ---------------------------------------------------------------------------
+// BinanceJsonParser
+// ---------------------------------------------------------------------------
+
+bool BinanceJsonParser::is_partial_depth_stream(std::string_view stream) {
+  size_t pos = stream.find("@depth");
+  return pos != std::string_view::npos && pos + 6 < stream.size() &&
+         std::isdigit(static_cast<unsigned char>(stream[pos + 6]));
+}
+
+bool BinanceJsonParser::parse(std::string_view message, ParsedMarketData& out) {
+  out.reset();
+
+  simdjson::ondemand::document doc;
+  simdjson::ondemand::object root;
+  if (iterate(message, doc) || doc.get_object().get(root)) return false;
+
+  std::string_view event;
+  MdTrade trade;
+  for (auto field_result : root) {
+    simdjson::ondemand::field field;
+    std::string_view key;
+    if (std::move(field_result).get(field) || field.unescaped_key().get(key)) return false;
+    value& field_value = field.value();
+
+    if (key == "stream") {
+      if (field_value.get_string().get(out.channel)) return false;
+    } else if (key == "data") {
+      simdjson::ondemand::object data;
+      if (field_value.get_object().get(data)) return false;
+      for (auto data_result : data) {
+        simdjson::ondemand::field data_field;
+        std::string_view data_key;
+        if (std::move(data_result).get(data_field) || data_field.unescaped_key().get(data_key)) return false;
+        if (!read_event_field(data_key, data_field.value(), event, trade, out)) return false;
+      }
+    } else if (key == "result" || key == "id") {
+      out.type = MdMessageType::CONTROL;
+    } else if (key == "error") {
+      out.type = MdMessageType::CONTROL;
+      out.is_error = true;
+    } else if (!read_event_field(key, field_value, event, trade, out)) {
+      // Raw (non-combined) streams put the event fields at the root
+      return false;
+    }
+  }
+
+  if (event.empty()) {
+    // Some streams omit "e"; fall back to the stream name
+    if (contains(out.channel, "@depth")) event = "depthUpdate";
+    else if (contains(out.channel, "@trade")) event = "trade";
+  }
+
+  if (event == "depthUpdate") {
+    out.type = is_partial_depth_stream(out.channel) ? MdMessageType::BOOK_SNAPSHOT : MdMessageType::BOOK_DELTA;
+  } else if (event == "trade") {
+    out.type = MdMessageType::TRADE;
+    out.trades.push_back(trade);
+  }
+  return true;
+}
+
+bool BinanceJsonParser::read_event_field(std::string_view key, value& val, std::string_view& event,
+                                         MdTrade& trade, ParsedMarketData& out) {
+  if (key.size() > 2) return true;
+
+  if (key == "e") return !val.get_string().get(event);
+  if (key == "E") return read_uint64(val, out.exchange_time);
+  if (key == "s") return !val.get_string().get(out.symbol);
+  if (key == "U") return read_uint64(val, out.first_id);
+  if (key == "u") return read_uint64(val, out.last_id);
+  if (key == "pu") return read_uint64(val, out.prev_id);
+  if (key == "b" || key == "a") {
+    // Levels in depth events; buyer/seller order ids in trade events
+    json_type type;
+    if (val.type().get(type)) return false;
+    if (type != json_type::array) return true;
+    return read_levels(val, key == "b" ? out.bids : out.asks);
+  }
+  if (key == "t") return read_uint64(val, trade.trade_seq);
+  if (key == "p") return read_double(val, trade.price);
+  if (key == "q") return read_double(val, trade.qty);
+  if (key == "T") return read_uint64(val, trade.exchange_time);
+  if (key == "m") return !val.get_bool().get(trade.is_buyer_maker);
+  return true;
+}
+
+// ---------------------------------------------------------------------------
+// GrvtJsonParser
+// ---------------------------------------------------------------------------
+
+bool GrvtJsonParser::parse(std::string_view message, ParsedMarketData& out) {
+  out.reset();
+
+  simdjson::ondemand::document doc;
+  simdjson::ondemand::object root;
+  if (iterate(message, doc) || doc.get_object().get(root)) return false;
+
+  std::string_view method;
+  std::string_view params_channel;
+  bool control = false;
+  MdTrade trade;
+  for (auto field_result : root) {
+    simdjson::ondemand::field field;
+    std::string_view key;
+    if (std::move(field_result).get(field) || field.unescaped_key().get(key)) return false;
+    value& field_value = field.value();
+
+    if (key == "method" || key == "m") {
+      if (field_value.get_string().get(method)) return false;
+    } else if (key == "params" || key == "p") {
+      // [channel, instrument, data]
+      json_type type;
+      if (field_value.type().get(type)) return false;
+      if (type != json_type::array) continue;
+
+      simdjson::ondemand::array params;
+      if (field_value.get_array().get(params)) return false;
+      size_t index = 0;
+      for (auto param_result : params) {
+        value param;
+        if (std::move(param_result).get(param)) return false;
+        if (index == 0) {
+          if (param.get_string().get(params_channel)) return false;
+        } else if (index == 1) {
+          if (param.get_string().get(out.symbol)) return false;
+        } else if (index == 2) {
+          simdjson::ondemand::object data;
+          if (param.get_object().get(data)) return false;
+          for (auto data_result : data) {
+            simdjson::ondemand::field data_field;
+            std::string_view data_key;
+            if (std::move(data_result).get(data_field) || data_field.unescaped_key().get(data_key)) return false;
+            if (!read_data_field(data_key, data_field.value(), trade, out)) return false;
+          }
+        }
+        ++index;
+      }
+    } else if (key == "result" || key == "r") {
+      control = true;
+    } else if (key == "error" || key == "e") {
+      control = true;
+      out.is_error = true;
+    }
+  }
+
+  out.channel = method.empty() ? params_channel : method;
+  if (control) {
+    out.type = MdMessageType::CONTROL;
+  } else if (contains(out.channel, "orderbook.d")) {
+    out.type = MdMessageType::BOOK_DELTA;
+  } else if (contains(out.channel, "orderbook")) {
+    out.type = MdMessageType::BOOK_SNAPSHOT;
+  } else if (contains(out.channel, "trade")) {
+    out.type = MdMessageType::TRADE;
+    trade.exchange_time = out.exchange_time;
+    out.trades.push_back(trade);
+  }
+  return true;
+}
+
+bool GrvtJsonParser::read_data_field(std::string_view key, value& val, MdTrade& trade, ParsedMarketData& out) {
+  if (key == "bids" || key == "b") return read_levels(val, out.bids);
+  if (key == "asks" || key == "a") return read_levels(val, out.asks);
+  if (key == "timestamp" || key == "t" || key == "event_time" || key == "et") {
+    return read_uint64(val, out.exchange_time);
+  }
+  if (key == "sequence_number" || key == "sn") {
+    if (!read_uint64(val, out.first_id)) return false;
+    out.last_id = out.first_id;
+    return true;
+  }
+  if (key == "prev_sequence_number" || key == "psn") return read_uint64(val, out.prev_id);
+  if (key == "price" || key == "p") return read_double(val, trade.price);
+  if (key == "quantity" || key == "q" || key == "size") return read_double(val, trade.qty);
+  if (key == "side" || key == "s") {
+    std::string_view side;
+    if (val.get_string().get(side)) return false;
+    trade.is_buyer_maker = side == "sell" || side == "SELL";
+    return true;
+  }
+  if (key == "tradeId" || key == "ti" || key == "trade_id") {
+    json_type type;
+    if (val.type().get(type)) return false;
+    if (type == json_type::string) return !val.get_string().get(trade.trade_id);
+    return read_uint64(val, trade.trade_seq);
+  }
+  return true;
+}
+
+// ---------------------------------------------------------------------------
+// DeribitJsonParser
+// ---------------------------------------------------------------------------
+
+bool DeribitJsonParser::parse(std::string_view message, ParsedMarketData& out) {
+  out.reset();
+
+  simdjson::ondemand::document doc;
+  simdjson::ondemand::object root;
+  if (iterate(message, doc) || doc.get_object().get(root)) return false;
+
+  bool control = false;
+  for (auto field_result : root) {
+    simdjson::ondemand::field field;
+    std::string_view key;
+    if (std::move(field_result).get(field) || field.unescaped_key().get(key)) return false;
+    value& field_value = field.value();
+
+    if (key == "params") {
+      // {"channel": "book.BTC-PERPETUAL.raw", "data": {...} | [...]}
+      simdjson::ondemand::object params;
+      if (field_value.get_object().get(params)) return false;
+      for (auto param_result : params) {
+        simdjson::ondemand::field param;
+        std::string_view param_key;
+        if (std::move(param_result).get(param) || param.unescaped_key().get(param_key)) return false;
+        value& param_value = param.value();
+
+        if (param_key == "channel") {
+          if (param_value.get_string().get(out.channel)) return false;
+        } else if (param_key == "data") {
+          json_type type;
+          if (param_value.type().get(type)) return false;
+          if (type == json_type::array) {
+            simdjson::ondemand::array trades;
+            if (param_value.get_array().get(trades)) return false;
+            for (auto trade_result : trades) {
+              value trade;
+              if (std::move(trade_result).get(trade) || !read_trade(trade, out)) return false;
+            }
+          } else if (type == json_type::object && starts_with(out.channel, "trades.")) {
+            if (!read_trade(param_value, out)) return false;
+          } else if (type == json_type::object) {
+            simdjson::ondemand::object data;
+            if (param_value.get_object().get(data)) return false;
+            for (auto data_result : data) {
+              simdjson::ondemand::field data_field;
+              std::string_view data_key;
+              if (std::move(data_result).get(data_field) || data_field.unescaped_key().get(data_key)) return false;
+              value& data_value = data_field.value();
+              bool ok = true;
+              if (data_key == "bids") ok = read_levels(data_value, out.bids);
+              else if (data_key == "asks") ok = read_levels(data_value, out.asks);
+              else if (data_key == "timestamp") ok = read_uint64(data_value, out.exchange_time);
+              else if (data_key == "change_id") ok = read_uint64(data_value, out.last_id);
+              else if (data_key == "prev_change_id") ok = read_uint64(data_value, out.prev_id);
+              else if (data_key == "instrument_name") ok = !data_value.get_string().get(out.symbol);
+              if (!ok) return false;
+            }
+          }
+        }
+      }
+    } else if (key == "result") {
+      control = true;
+    } else if (key == "error") {
+      control = true;
+      out.is_error = true;
+    }
+  }
+
+  // Symbol is the middle part of the channel: "book.BTC-PERPETUAL.raw"
+  if (out.symbol.empty()) {
+    size_t first_dot = out.channel.find('.');
+    size_t second_dot = out.channel.find('.', first_dot + 1);
+    if (first_dot != std::string_view::npos && second_dot != std::string_view::npos) {
+      out.symbol = out.channel.substr(first_dot + 1, second_dot - first_dot - 1);
+    }
+  }
+
+  if (control) {
+    out.type = MdMessageType::CONTROL;
+  } else if (starts_with(out.channel, "book.")) {
+    out.first_id = out.last_id;
+    out.type = out.prev_id == ParsedMarketData::NO_ID ? MdMessageType::BOOK_SNAPSHOT : MdMessageType::BOOK_DELTA;
+  } else if (starts_with(out.channel, "trades.")) {
+    out.type = MdMessageType::TRADE;
+  }
+  return true;
+}
+
+bool DeribitJsonParser::read_trade(value& val, ParsedMarketData& out) {
+  simdjson::ondemand::object object;
+  if (val.get_object().get(object)) return false;
+
+  MdTrade trade;
+  for (auto field_result : object) {
+    simdjson::ondemand::field field;
+    std::string_view key;
+    if (std::move(field_result).get(field) || field.unescaped_key().get(key)) return false;
+    value& field_value = field.value();
+
+    bool ok = true;
+    if (key == "price") ok = read_double(field_value, trade.price);
+    else if (key == "amount") ok = read_double(field_value, trade.qty);
+    else if (key == "timestamp") ok = read_uint64(field_value, trade.exchange_time);
+    else if (key == "trade_id") ok = !field_value.get_string().get(trade.trade_id);
+    else if (key == "trade_seq") ok = read_uint64(field_value, trade.trade_seq);
+    else if (key == "direction") {
+      // Taker side: a "sell" taker means the buyer was the maker
+      std::string_view direction;
+      ok = !field_value.get_string().get(direction);
+      trade.is_buyer_maker = direction == "sell";
+    }
+    if (!ok) return false;
+  }
+  out.trades.push_back(trade);
+  return true;
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include "market_data_parser.hpp"
+#include <simdjson.h>
+#include <memory>
+
+/**
+ * simdjson on-demand implementations of IMarketDataParser
+ *
+ * Fields are visited once, in document order, straight from the SIMD
+ * structural index: no DOM is built and numbers (quoted or bare) are
+ * converted in place with std::from_chars. The padded input buffer and
+ * simdjson's internal buffers grow to the largest message seen and are
+ * then reused. One instance per connection; not thread-safe.
+ */
+class SimdJsonMarketDataParser : public IMarketDataParser {
+protected:
+  using value = simdjson::ondemand::value;
+
+  // Copies the message into the reusable padded buffer and starts iteration
+  simdjson::error_code iterate(std::string_view message, simdjson::ondemand::document& doc);
+
+  // Numbers that venues send either quoted ("50000.10") or bare
+  bool read_double(value& val, double& out) const;
+  bool read_uint64(value& val, uint64_t& out) const;
+
+  // [[price, qty], ...], Deribit [action, price, qty] triplets ("delete" -> qty 0)
+  // or GRVT-style {"price": .., "size": ..} objects
+  bool read_levels(value& val, std::vector<MdLevel>& out) const;
+
+private:
+  simdjson::ondemand::parser parser_;
+  std::unique_ptr<char[]> buffer_;
+  size_t buffer_capacity_{0};
+  const char* end_{nullptr};
+
+  bool read_level_object(value& val, MdLevel& out) const;
+};
+
+// Binance combined ({"stream", "data"}) and raw streams: depthUpdate and trade events
+class BinanceJsonParser : public SimdJsonMarketDataParser {
+public:
+  bool parse(std::string_view message, ParsedMarketData& out) override;
+
+  // "btcusdt@depth20@100ms" carries top-N snapshots, "btcusdt@depth@100ms" diffs
+  static bool is_partial_depth_stream(std::string_view stream);
+
+private:
+  bool read_event_field(std::string_view key, value& val, std::string_view& event,
+                        MdTrade& trade, ParsedMarketData& out);
+};
+
+// GRVT JSON-RPC feeds, full and lite field names: orderbook.s/.d and trades
+class GrvtJsonParser : public SimdJsonMarketDataParser {
+public:
+  bool parse(std::string_view message, ParsedMarketData& out) override;
+
+private:
+  bool read_data_field(std::string_view key, value& val, MdTrade& trade, ParsedMarketData& out);
+};
+
+// Deribit JSON-RPC subscriptions: book.* and trades.* channels
+class DeribitJsonParser : public SimdJsonMarketDataParser {
+public:
+  bool parse(std::string_view message, ParsedMarketData& out) override;
+
+private:
+  bool read_trade(value& val, ParsedMarketData& out);
+};
@@ -0,0 +1,131 @@
+#pragma once
+#include "metrics_collector.hpp"
+#include "../../proto/trace.pb.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace metrics {
+
+/**
+ * Opt-in tick-to-trade latency tracing
+ *
+ * When enabled, each process stamps monotonic timestamps into the
+ * proto::TraceContext carried on OrderBookSnapshot, OrderRequest and
+ * OrderEvent, and records the hops it can see into "trace.<hop>_ns"
+ * histograms in MetricsCollector:
+ *
+ *   market_server   md_parse, md_publish
+ *   trader          md_transit, strategy, order_encode, tick_to_order,
+ *                   event_transit, order_ack_roundtrip
+ *   trading_engine  order_transit, engine_dispatch, exchange_submit,
+ *                   exchange_ack, tick_to_trade
+ *
+ * The trader links an order to the snapshot that caused it through the
+ * thread's current trace (Scope), set around the strategy callback; orders
+ * emitted synchronously from that callback inherit it.
+ *
+ * When disabled the trace field is never set, so messages are unchanged on
+ * the wire and the only cost is one relaxed load per message.
+ *
+ * @note Timestamps are steady_clock (CLOCK_MONOTONIC on Linux), so hops are
+ *       only meaningful between processes on the same host.
+ */
+class LatencyTrace {
+public:
+    enum Hop {
+        MD_PARSE,             // md_recv -> md_parsed
+        MD_PUBLISH,           // md_parsed -> md_publish
+        MD_TRANSIT,           // md_publish -> trader_recv
+        STRATEGY,             // trader_recv -> decision
+        ORDER_ENCODE,         // decision -> order_send
+        ORDER_TRANSIT,        // order_send -> engine_recv
+        ENGINE_DISPATCH,      // engine_recv -> exchange_send
+        EXCHANGE_SUBMIT,      // exchange_send -> exchange OMS call returned
+        EXCHANGE_ACK,         // exchange_send -> exchange_ack
+        EVENT_TRANSIT,        // event_publish -> trader receipt
+        TICK_TO_ORDER,        // md_recv -> order_send
+        TICK_TO_TRADE,        // md_recv -> exchange_send
+        ORDER_ACK_ROUNDTRIP,  // order_send -> trader receipt of the ACK
+        HOP_COUNT
+    };
+
+    static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+    static void set_enabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+
+    static uint64_t now_ns() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    // Record to_ns - from_ns; skipped if either stage was not stamped
+    static void record(Hop hop, uint64_t from_ns, uint64_t to_ns) {
+        if (from_ns != 0 && to_ns >= from_ns) {
+            histogram(hop).record(to_ns - from_ns);
+        }
+    }
+
+    static Histogram& histogram(Hop hop) {
+        static Histogram* const* table = []() {
+            static Histogram* hops[HOP_COUNT];
+            for (int i = 0; i < HOP_COUNT; ++i) {
+                hops[i] = &MetricsCollector::instance().histogram(
+                    std::string("trace.") + hop_name(static_cast<Hop>(i)) + "_ns");
+            }
+            return hops;
+        }();
+        return *table[hop];
+    }
+
+    static const char* hop_name(Hop hop) {
+        switch (hop) {
+            case MD_PARSE: return "md_parse";
+            case MD_PUBLISH: return "md_publish";
+            case MD_TRANSIT: return "md_transit";
+            case STRATEGY: return "strategy";
+            case ORDER_ENCODE: return "order_encode";
+            case ORDER_TRANSIT: return "order_transit";
+            case ENGINE_DISPATCH: return "engine_dispatch";
+            case EXCHANGE_SUBMIT: return "exchange_submit";
+            case EXCHANGE_ACK: return "exchange_ack";
+            case EVENT_TRANSIT: return "event_transit";
+            case TICK_TO_ORDER: return "tick_to_order";
+            case TICK_TO_TRADE: return "tick_to_trade";
+            case ORDER_ACK_ROUNDTRIP: return "order_ack_roundtrip";
+            default: return "unknown";
+        }
+    }
+
+    // market_server: stamp an outgoing snapshot or trade; no-op unless recv_ns was stamped
+    template <typename Message>
+    static void stamp_market_data(Message& message, uint64_t recv_ns, uint64_t parsed_ns) {
+        if (recv_ns == 0) {
+            return;
+        }
+        proto::TraceContext* trace = message.mutable_trace();
+        trace->set_md_recv_ns(recv_ns);
+        trace->set_md_parsed_ns(parsed_ns);
+        trace->set_md_publish_ns(now_ns());
+    }
+
+    // Trace of the market data being handled on this thread, if any
+    static const proto::TraceContext* current() { return current_; }
+
+    // Makes trace the thread's current trace for the scope's lifetime
+    class Scope {
+    public:
+        explicit Scope(const proto::TraceContext* trace) : previous_(current_) { current_ = trace; }
+        ~Scope() { current_ = previous_; }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const proto::TraceContext* previous_;
+    };
+
+private:
+    static inline std::atomic<bool> enabled_{false};
+    static inline thread_local const proto::TraceContext* current_{nullptr};
+};
+
+} // namespace metrics
@@ -6,6 +6,11 @@
  * Provides a centralized, thread-safe metrics collection interface
  * for all system components. Supports counters, gauges, histograms,
  * and timers.
+ *
+ * Looking a metric up by name takes the collector's lock; hot paths should
+ * look it up once and keep the reference (metrics are never removed), after
+ * which updates are lock-free. See metrics_exporter.hpp for periodic
+ * Prometheus / binary export.
  */
 
 #include <string>
@@ -15,6 +20,9 @@
 #include <chrono>
 #include <vector>
 #include <memory>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include "../logging/log_helper.hpp"
 
 namespace metrics {
@@ -73,34 +81,38 @@ private:
 
 /**
  * Gauge metric - can increase or decrease
+ *
+ * increment()/decrement() are atomic read-modify-writes, so concurrent
+ * updates are never lost.
  */
 class Gauge : public IMetric {
 public:
     Gauge(const std::string& name) : name_(name), value_(0) {}
     
     void set(double value) {
-        value_.store(value);
+        value_.store(value, std::memory_order_relaxed);
     }
     
     void increment(double delta = 1.0) {
-        double current = value_.load();
-        value_.store(current + delta);
+        // No fetch_add for atomic<double> before C++20
+        double current = value_.load(std::memory_order_relaxed);
+        while (!value_.compare_exchange_weak(current, current + delta, std::memory_order_relaxed)) {
+        }
     }
     
     void decrement(double delta = 1.0) {
-        double current = value_.load();
-        value_.store(current - delta);
+        increment(-delta);
     }
     
     double get() const {
-        return value_.load();
+        return value_.load(std::memory_order_relaxed);
     }
     
     MetricType get_type() const override { return MetricType::GAUGE; }
     std::string get_name() const override { return name_; }
     
     std::string to_string() const override {
-        return name_ + ": " + std::to_string(value_.load());
+        return name_ + ": " + std::to_string(get());
     }
     
 private:
@@ -109,58 +121,192 @@ private:
 };
 
 /**
- * Histogram metric - tracks distribution of values
+ * Point-in-time view of a Histogram
+ *
+ * Percentiles are the highest value equivalent to the bucket they fall in,
+ * so they never understate a latency; max is exact.
+ */
+struct HistogramSnapshot {
+    uint64_t count{0};
+    uint64_t sum{0};
+    uint64_t max{0};
+    uint64_t p50{0};
+    uint64_t p90{0};
+    uint64_t p99{0};
+    uint64_t p999{0};
+
+    double mean() const { return count > 0 ? static_cast<double>(sum) / count : 0.0; }
+};
+
+/**
+ * Histogram metric - log-linear (HDR-style) distribution of integer values
+ *
+ * Values below 2^kSubBucketBits get their own bucket; above that each power
+ * of two is split into 2^kSubBucketBits linear buckets, giving a relative
+ * error under 1/32 across the full uint64 range in a fixed 1920-bucket table.
+ *
+ * Buckets are sharded by recording thread so threads on different shards
+ * never share a cache line. record() is a handful of relaxed fetch_adds with
+ * no lock, no allocation and no loop (apart from a CAS when it raises the
+ * shard's max); snapshot() merges the shards and may be called from any
+ * thread while recording continues.
+ *
+ * @note Record latencies in a fixed unit (e.g. nanoseconds); fractional
+ *       values are truncated.
  */
 class Histogram : public IMetric {
 public:
-    Histogram(const std::string& name, size_t buckets = 10) 
-        : name_(name), count_(0), sum_(0.0), buckets_(buckets) {}
+    static constexpr int kSubBucketBits = 5;
+    static constexpr size_t kSubBucketCount = size_t{1} << kSubBucketBits;
+    static constexpr size_t kBucketCount = (64 - kSubBucketBits + 1) * kSubBucketCount;
+    static constexpr size_t kShardCount = 8;
+
+    // buckets is unused; kept for source compatibility with the old sampling histogram
+    Histogram(const std::string& name, size_t buckets = 10)
+        : name_(name), shards_(new Shard[kShardCount]()) {
+        (void)buckets;
+    }
     
-    void record(double value) {
-        count_.fetch_add(1);
-        double current_sum = sum_.load();
-        sum_.store(current_sum + value);
-        
-        // Simple bucket tracking (can be enhanced)
-        std::lock_guard<std::mutex> lock(mutex_);
-        values_.push_back(value);
-        if (values_.size() > buckets_ * 100) {  // Keep last N samples
-            values_.erase(values_.begin(), values_.begin() + buckets_ * 50);
+    void record(uint64_t value) {
+        Shard& shard = shards_[thread_shard()];
+        shard.counts[bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+        shard.count.fetch_add(1, std::memory_order_relaxed);
+        shard.sum.fetch_add(value, std::memory_order_relaxed);
+        uint64_t max = shard.max.load(std::memory_order_relaxed);
+        while (value > max && !shard.max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
         }
     }
     
-    size_t get_count() const { return count_.load(); }
-    double get_sum() const { return sum_.load(); }
+    HistogramSnapshot snapshot() const {
+        HistogramSnapshot snap;
+        std::vector<uint64_t> merged(kBucketCount, 0);
+        for (size_t s = 0; s < kShardCount; ++s) {
+            const Shard& shard = shards_[s];
+            for (size_t i = 0; i < kBucketCount; ++i) {
+                merged[i] += shard.counts[i].load(std::memory_order_relaxed);
+            }
+            snap.sum += shard.sum.load(std::memory_order_relaxed);
+            snap.max = std::max(snap.max, shard.max.load(std::memory_order_relaxed));
+        }
+        // Count from the buckets so percentiles are consistent with them
+        for (uint64_t c : merged) {
+            snap.count += c;
+        }
+        if (snap.count == 0) {
+            return snap;
+        }
+
+        const double quantiles[] = {0.50, 0.90, 0.99, 0.999};
+        uint64_t* outputs[] = {&snap.p50, &snap.p90, &snap.p99, &snap.p999};
+        size_t q = 0;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < kBucketCount && q < 4; ++i) {
+            seen += merged[i];
+            while (q < 4 && seen >= rank(quantiles[q], snap.count)) {
+                *outputs[q++] = std::min(bucket_upper_bound(i), snap.max);
+            }
+        }
+        return snap;
+    }
+    
+    // Not atomic with respect to concurrent record() calls
+    void reset() {
+        for (size_t s = 0; s < kShardCount; ++s) {
+            Shard& shard = shards_[s];
+            for (auto& c : shard.counts) {
+                c.store(0, std::memory_order_relaxed);
+            }
+            shard.count.store(0, std::memory_order_relaxed);
+            shard.sum.store(0, std::memory_order_relaxed);
+            shard.max.store(0, std::memory_order_relaxed);
+        }
+    }
+    
+    size_t get_count() const {
+        uint64_t total = 0;
+        for (size_t s = 0; s < kShardCount; ++s) {
+            total += shards_[s].count.load(std::memory_order_relaxed);
+        }
+        return static_cast<size_t>(total);
+    }
+    double get_sum() const {
+        uint64_t total = 0;
+        for (size_t s = 0; s < kShardCount; ++s) {
+            total += shards_[s].sum.load(std::memory_order_relaxed);
+        }
+        return static_cast<double>(total);
+    }
     double get_mean() const {
-        size_t cnt = count_.load();
-        return cnt > 0 ? sum_.load() / cnt : 0.0;
+        size_t cnt = get_count();
+        return cnt > 0 ? get_sum() / cnt : 0.0;
     }
     
     MetricType get_type() const override { return MetricType::HISTOGRAM; }
     std::string get_name() const override { return name_; }
     
     std::string to_string() const override {
-        size_t cnt = count_.load();
-        return name_ + ": count=" + std::to_string(cnt) + 
-               " sum=" + std::to_string(sum_.load()) +
-               " mean=" + std::to_string(cnt > 0 ? sum_.load() / cnt : 0.0);
+        HistogramSnapshot snap = snapshot();
+        return name_ + ": count=" + std::to_string(snap.count) +
+               " mean=" + std::to_string(snap.mean()) +
+               " p50=" + std::to_string(snap.p50) +
+               " p99=" + std::to_string(snap.p99) +
+               " p99.9=" + std::to_string(snap.p999) +
+               " max=" + std::to_string(snap.max);
+    }
+    
+    static size_t bucket_index(uint64_t value) {
+        if (value < kSubBucketCount) {
+            return static_cast<size_t>(value);
+        }
+        int msb = 63 - __builtin_clzll(value);
+        int shift = msb - kSubBucketBits;
+        size_t sub = static_cast<size_t>(value >> shift) & (kSubBucketCount - 1);
+        return (static_cast<size_t>(shift) + 1) * kSubBucketCount + sub;
+    }
+    
+    // Highest value that lands in bucket index
+    static uint64_t bucket_upper_bound(size_t index) {
+        if (index < kSubBucketCount) {
+            return index;
+        }
+        int shift = static_cast<int>(index / kSubBucketCount) - 1;
+        uint64_t low = static_cast<uint64_t>(kSubBucketCount + index % kSubBucketCount) << shift;
+        return low + ((uint64_t{1} << shift) - 1);
     }
     
 private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> counts[kBucketCount];
+        std::atomic<uint64_t> count;
+        std::atomic<uint64_t> sum;
+        std::atomic<uint64_t> max;
+    };
+    
+    static uint64_t rank(double quantile, uint64_t count) {
+        uint64_t r = static_cast<uint64_t>(std::ceil(quantile * static_cast<double>(count)));
+        return r > 0 ? r : 1;
+    }
+    
+    // Threads are dealt shards round-robin on first use
+    static size_t thread_shard() {
+        static std::atomic<size_t> next_shard{0};
+        thread_local size_t shard = next_shard.fetch_add(1, std::memory_order_relaxed) % kShardCount;
+        return shard;
+    }
+    
     std::string name_;
-    std::atomic<size_t> count_;
-    std::atomic<double> sum_;
-    size_t buckets_;
-    mutable std::mutex mutex_;
-    std::vector<double> values_;
+    std::unique_ptr<Shard[]> shards_;   // Value-initialised, so all counters start at zero
 };
 
 /**
  * Timer metric - measures durations
+ *
+ * Durations are kept in nanoseconds in a Histogram so timers report
+ * percentiles as well as the mean; the *_us accessors convert.
  */
 class Timer : public IMetric {
 public:
-    Timer(const std::string& name) : name_(name), count_(0), total_us_(0) {}
+    Timer(const std::string& name) : name_(name), histogram_(name) {}
     
     class ScopedTimer {
     public:
@@ -168,8 +314,7 @@ public:
         
         ~ScopedTimer() {
             auto end = std::chrono::steady_clock::now();
-            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start_);
-            timer_.record(duration.count());
+            timer_.record_ns(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start_).count());
         }
         
     private:
@@ -178,35 +323,53 @@ public:
     };
     
     void record(int64_t microseconds) {
-        count_.fetch_add(1);
-        total_us_.fetch_add(microseconds);
+        record_ns(microseconds * 1000);
+    }
+    
+    void record_ns(int64_t nanoseconds) {
+        histogram_.record(nanoseconds > 0 ? static_cast<uint64_t>(nanoseconds) : 0);
     }
     
     ScopedTimer start() {
         return ScopedTimer(*this);
     }
     
-    size_t get_count() const { return count_.load(); }
-    int64_t get_total_us() const { return total_us_.load(); }
-    double get_mean_us() const {
-        size_t cnt = count_.load();
-        return cnt > 0 ? static_cast<double>(total_us_.load()) / cnt : 0.0;
-    }
+    // Percentiles and max in nanoseconds
+    HistogramSnapshot snapshot() const { return histogram_.snapshot(); }
+    
+    size_t get_count() const { return histogram_.get_count(); }
+    int64_t get_total_us() const { return static_cast<int64_t>(histogram_.get_sum() / 1000.0); }
+    double get_mean_us() const { return histogram_.get_mean() / 1000.0; }
     
     MetricType get_type() const override { return MetricType::TIMER; }
     std::string get_name() const override { return name_; }
     
     std::string to_string() const override {
-        size_t cnt = count_.load();
-        return name_ + ": count=" + std::to_string(cnt) + 
-               " total_us=" + std::to_string(total_us_.load()) +
-               " mean_us=" + std::to_string(cnt > 0 ? static_cast<double>(total_us_.load()) / cnt : 0.0);
+        HistogramSnapshot snap = snapshot();
+        return name_ + ": count=" + std::to_string(snap.count) +
+               " mean_us=" + std::to_string(snap.mean() / 1000.0) +
+               " p50_us=" + std::to_string(snap.p50 / 1000.0) +
+               " p99_us=" + std::to_string(snap.p99 / 1000.0) +
+               " p99.9_us=" + std::to_string(snap.p999 / 1000.0) +
+               " max_us=" + std::to_string(snap.max / 1000.0);
     }
     
 private:
     std::string name_;
-    std::atomic<size_t> count_;
-    std::atomic<int64_t> total_us_;
+    Histogram histogram_;
+};
+
+/**
+ * One exported metric value (see MetricsCollector::collect)
+ *
+ * Counters and gauges use value; histograms and timers use the snapshot,
+ * timers in nanoseconds.
+ */
+struct MetricSample {
+    std::string name;
+    MetricType type{MetricType::COUNTER};
+    double value{0.0};
+    HistogramSnapshot histogram;
 };
 
 /**
@@ -293,6 +456,28 @@ public:
         return result;
     }
     
+    // Snapshot every metric for export, sorted by type then name
+    std::vector<MetricSample> collect() const {
+        std::vector<MetricSample> result;
+        std::lock_guard<std::mutex> lock(mutex_);
+        result.reserve(counters_.size() + gauges_.size() + histograms_.size() + timers_.size());
+        
+        for (const auto& [name, counter] : counters_) {
+            result.push_back({name, MetricType::COUNTER, static_cast<double>(counter->get()), {}});
+        }
+        for (const auto& [name, gauge] : gauges_) {
+            result.push_back({name, MetricType::GAUGE, gauge->get(), {}});
+        }
+        for (const auto& [name, hist] : histograms_) {
+            result.push_back({name, MetricType::HISTOGRAM, 0.0, hist->snapshot()});
+        }
+        for (const auto& [name, timer] : timers_) {
+            result.push_back({name, MetricType::TIMER, 0.0, timer->snapshot()});
+        }
+        
+        return result;
+    }
+    
     // Print all metrics
     void print_all_metrics() const {
         auto metrics = get_all_metrics();
@@ -0,0 +1,270 @@
+#include "metrics_exporter.hpp"
+#include "../zmq/zmq_publisher.hpp"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+namespace metrics {
+
+namespace {
+
+constexpr size_t kHeaderBytes = sizeof(uint32_t) + 2 * sizeof(uint16_t) + sizeof(uint64_t);
+
+// Prometheus metric names allow [a-zA-Z0-9_:] only
+std::string prometheus_name(const std::string& name) {
+    std::string out = name;
+    for (char& c : out) {
+        bool ok = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == ':';
+        if (!ok) {
+            c = '_';
+        }
+    }
+    if (!out.empty() && out[0] >= '0' && out[0] <= '9') {
+        out.insert(out.begin(), '_');
+    }
+    return out;
+}
+
+void append_value(std::string& out, double value) {
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+template <typename T>
+void put(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool get(const unsigned char*& pos, const unsigned char* end, T& value) {
+    if (static_cast<size_t>(end - pos) < sizeof(T)) {
+        return false;
+    }
+    std::memcpy(&value, pos, sizeof(T));
+    pos += sizeof(T);
+    return true;
+}
+
+uint64_t now_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+} // namespace
+
+MetricsExporter::MetricsExporter(MetricsCollector& collector) : collector_(collector) {}
+
+MetricsExporter::~MetricsExporter() {
+    stop();
+}
+
+bool MetricsExporter::start(const MetricsExporterConfig& config) {
+    if (running_.load()) {
+        return true;
+    }
+    if (config.prometheus_file.empty() && config.publish_endpoint.empty()) {
+        LOG_WARN_COMP("METRICS", "Metrics exporter has no sink configured");
+        return false;
+    }
+
+    config_ = config;
+    if (config_.interval_ms <= 0) {
+        config_.interval_ms = 1000;
+    }
+    if (!config_.publish_endpoint.empty()) {
+        try {
+            // A low HWM bounds the backlog of stale snapshots; ZMQ_CONFLATE would break the topic + payload multipart
+            publisher_ = std::make_unique<ZmqPublisher>(config_.publish_endpoint, 16, false);
+        } catch (const std::exception& e) {
+            LOG_ERROR_COMP("METRICS", "Failed to bind metrics publisher on " + config_.publish_endpoint + ": " + e.what());
+            return false;
+        }
+    }
+
+    running_.store(true);
+    thread_ = std::thread(&MetricsExporter::export_loop, this);
+    LOG_INFO_COMP("METRICS", "Metrics exporter started (interval " + std::to_string(config_.interval_ms) + "ms)");
+    return true;
+}
+
+void MetricsExporter::stop() {
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        if (!running_.exchange(false)) {
+            return;
+        }
+    }
+    wake_cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    publisher_.reset();
+}
+
+void MetricsExporter::export_loop() {
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    while (running_.load()) {
+        wake_cv_.wait_for(lock, std::chrono::milliseconds(config_.interval_ms), [this]() { return !running_.load(); });
+        lock.unlock();
+        // Final export on stop so the last interval is not lost
+        export_once();
+        lock.lock();
+    }
+}
+
+bool MetricsExporter::export_once() {
+    std::lock_guard<std::mutex> lock(export_mutex_);
+    std::vector<MetricSample> samples = collector_.collect();
+    bool ok = true;
+
+    if (!config_.prometheus_file.empty()) {
+        ok = write_prometheus_file(to_prometheus(samples)) && ok;
+    }
+    if (publisher_) {
+        encode_binary(samples, now_ns(), binary_buffer_);
+        ok = publisher_->send(config_.topic, binary_buffer_.data(), binary_buffer_.size()) && ok;
+    }
+
+    export_count_.fetch_add(1, std::memory_order_relaxed);
+    if (!ok) {
+        export_failures_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return ok;
+}
+
+bool MetricsExporter::write_prometheus_file(const std::string& text) {
+    // Scrapers must never see a half-written file
+    std::string tmp_path = config_.prometheus_file + ".tmp";
+    std::FILE* file = std::fopen(tmp_path.c_str(), "w");
+    if (!file) {
+        return false;
+    }
+    bool written = std::fwrite(text.data(), 1, text.size(), file) == text.size();
+    written = std::fclose(file) == 0 && written;
+    return written && std::rename(tmp_path.c_str(), config_.prometheus_file.c_str()) == 0;
+}
+
+std::string MetricsExporter::to_prometheus(const std::vector<MetricSample>& samples) {
+    static const struct {
+        const char* label;
+        uint64_t HistogramSnapshot::*field;
+    } kQuantiles[] = {
+        {"0.5", &HistogramSnapshot::p50},
+        {"0.9", &HistogramSnapshot::p90},
+        {"0.99", &HistogramSnapshot::p99},
+        {"0.999", &HistogramSnapshot::p999},
+    };
+
+    std::string out;
+    out.reserve(samples.size() * 160);
+    for (const auto& sample : samples) {
+        std::string name = prometheus_name(sample.name);
+        switch (sample.type) {
+            case MetricType::COUNTER:
+            case MetricType::GAUGE:
+                out.append("# TYPE ").append(name).append(sample.type == MetricType::COUNTER ? " counter\n" : " gauge\n");
+                out.append(name).push_back(' ');
+                append_value(out, sample.value);
+                out.push_back('\n');
+                break;
+            case MetricType::HISTOGRAM:
+            case MetricType::TIMER: {
+                const HistogramSnapshot& h = sample.histogram;
+                double unit = sample.type == MetricType::TIMER ? 1000.0 : 1.0;   // Timers: ns -> us
+                out.append("# TYPE ").append(name).append(" summary\n");
+                for (const auto& q : kQuantiles) {
+                    out.append(name).append("{quantile=\"").append(q.label).append("\"} ");
+                    append_value(out, static_cast<double>(h.*q.field) / unit);
+                    out.push_back('\n');
+                }
+                out.append(name).append("_sum ");
+                append_value(out, static_cast<double>(h.sum) / unit);
+                out.append("\n").append(name).append("_count ");
+                append_value(out, static_cast<double>(h.count));
+                out.append("\n# TYPE ").append(name).append("_max gauge\n").append(name).append("_max ");
+                append_value(out, static_cast<double>(h.max) / unit);
+                out.push_back('\n');
+                break;
+            }
+        }
+    }
+    return out;
+}
+
+void MetricsExporter::encode_binary(const std::vector<MetricSample>& samples, uint64_t timestamp_ns, std::string& out) {
+    out.clear();
+    uint16_t count = static_cast<uint16_t>(std::min<size_t>(samples.size(), UINT16_MAX));
+    put(out, kBinaryMagic);
+    put(out, kBinaryVersion);
+    put(out, count);
+    put(out, timestamp_ns);
+
+    for (size_t i = 0; i < count; ++i) {
+        const MetricSample& sample = samples[i];
+        uint8_t name_length = static_cast<uint8_t>(std::min<size_t>(sample.name.size(), UINT8_MAX));
+        put(out, static_cast<uint8_t>(sample.type));
+        put(out, name_length);
+        out.append(sample.name.data(), name_length);
+        if (sample.type == MetricType::COUNTER || sample.type == MetricType::GAUGE) {
+            put(out, sample.value);
+        } else {
+            const HistogramSnapshot& h = sample.histogram;
+            for (uint64_t field : {h.count, h.sum, h.max, h.p50, h.p90, h.p99, h.p999}) {
+                put(out, field);
+            }
+        }
+    }
+}
+
+bool MetricsExporter::decode_binary(const void* data, size_t size, std::vector<MetricSample>& samples,
+                                    uint64_t* timestamp_ns) {
+    samples.clear();
+    const unsigned char* pos = static_cast<const unsigned char*>(data);
+    const unsigned char* end = pos + size;
+
+    uint32_t magic = 0;
+    uint16_t version = 0;
+    uint16_t count = 0;
+    uint64_t timestamp = 0;
+    if (size < kHeaderBytes || !get(pos, end, magic) || !get(pos, end, version) || !get(pos, end, count) ||
+        !get(pos, end, timestamp) || magic != kBinaryMagic || version != kBinaryVersion) {
+        return false;
+    }
+    if (timestamp_ns) {
+        *timestamp_ns = timestamp;
+    }
+
+    samples.reserve(count);
+    for (uint16_t i = 0; i < count; ++i) {
+        uint8_t type = 0;
+        uint8_t name_length = 0;
+        if (!get(pos, end, type) || !get(pos, end, name_length) || type > static_cast<uint8_t>(MetricType::TIMER) ||
+            static_cast<size_t>(end - pos) < name_length) {
+            return false;
+        }
+        MetricSample sample;
+        sample.type = static_cast<MetricType>(type);
+        sample.name.assign(reinterpret_cast<const char*>(pos), name_length);
+        pos += name_length;
+
+        bool ok;
+        if (sample.type == MetricType::COUNTER || sample.type == MetricType::GAUGE) {
+            ok = get(pos, end, sample.value);
+        } else {
+            HistogramSnapshot& h = sample.histogram;
+            ok = get(pos, end, h.count) && get(pos, end, h.sum) && get(pos, end, h.max) && get(pos, end, h.p50) &&
+                 get(pos, end, h.p90) && get(pos, end, h.p99) && get(pos, end, h.p999);
+        }
+        if (!ok) {
+            return false;
+        }
+        samples.push_back(std::move(sample));
+    }
+    return pos == end;
+}
+
+} // namespace metrics
@@ -0,0 +1,88 @@
+#pragma once
+#include "metrics_collector.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class ZmqPublisher;
+
+namespace metrics {
+
+// Exporter settings; each sink is enabled by giving it a destination
+struct MetricsExporterConfig {
+    int interval_ms{1000};
+    std::string prometheus_file;    // Prometheus text, replaced atomically each interval
+    std::string publish_endpoint;   // ZMQ PUB bind endpoint for binary snapshots
+    std::string topic{"metrics"};
+};
+
+/**
+ * Periodic metrics exporter
+ *
+ * Every interval a background thread snapshots the collector and writes it
+ * to the enabled sinks:
+ * - Prometheus text exposition format to a file (write-then-rename, for the
+ *   node_exporter textfile collector or any scraper sidecar)
+ * - A compact binary snapshot published over ZMQ
+ *
+ * Histograms and timers are exported as summaries with p50/p90/p99/p99.9
+ * quantiles plus a _max gauge; timers in microseconds, matching their names.
+ *
+ * Binary snapshot layout (host byte order):
+ *   header:  u32 magic 'MTRC' | u16 version | u16 entry count | u64 timestamp ns
+ *   entry:   u8 MetricType | u8 name length | name bytes | payload
+ *   payload: counter/gauge f64 value;
+ *            histogram/timer u64 count, sum, max, p50, p90, p99, p99.9
+ */
+class MetricsExporter {
+public:
+    static constexpr uint32_t kBinaryMagic = 0x4D545243;   // "MTRC"
+    static constexpr uint16_t kBinaryVersion = 1;
+
+    explicit MetricsExporter(MetricsCollector& collector = MetricsCollector::instance());
+    ~MetricsExporter();
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    // Returns false if no sink is configured or the publisher cannot bind
+    bool start(const MetricsExporterConfig& config);
+    void stop();
+    bool is_running() const { return running_.load(); }
+
+    // Snapshot and write to every sink now; false if any sink failed
+    bool export_once();
+
+    uint64_t get_export_count() const { return export_count_.load(std::memory_order_relaxed); }
+    uint64_t get_export_failures() const { return export_failures_.load(std::memory_order_relaxed); }
+
+    static std::string to_prometheus(const std::vector<MetricSample>& samples);
+    static void encode_binary(const std::vector<MetricSample>& samples, uint64_t timestamp_ns, std::string& out);
+    static bool decode_binary(const void* data, size_t size, std::vector<MetricSample>& samples,
+                              uint64_t* timestamp_ns = nullptr);
+
+private:
+    void export_loop();
+    bool write_prometheus_file(const std::string& text);
+
+    MetricsCollector& collector_;
+    MetricsExporterConfig config_;
+    std::unique_ptr<ZmqPublisher> publisher_;
+    std::mutex export_mutex_;   // export_once() may be called while the thread runs
+    std::string binary_buffer_;
+
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    std::mutex wake_mutex_;
+    std::condition_variable wake_cv_;
+
+    std::atomic<uint64_t> export_count_{0};
+    std::atomic<uint64_t> export_failures_{0};
+};
+
+} // namespace metrics
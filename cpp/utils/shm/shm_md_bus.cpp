@@ -0,0 +1,397 @@
+#include "shm_md_bus.hpp"
+#include "../logging/log_helper.hpp"
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#endif
+
+namespace shm_md {
+
+namespace {
+
+constexpr uint64_t kKeyTag = uint64_t{1} << 32;
+constexpr int kSeqlockRetries = 64;
+constexpr int kSpinIterations = 128;
+
+size_t round_up(size_t value) {
+  size_t result = 1;
+  while (result < value) result <<= 1;
+  return result;
+}
+
+size_t align_up(size_t value) {
+  return (value + md_binary::kCacheLineSize - 1) & ~(md_binary::kCacheLineSize - 1);
+}
+
+size_t books_offset() {
+  return align_up(sizeof(BusHeader));
+}
+
+size_t trades_offset(size_t book_slots) {
+  return books_offset() + align_up(book_slots * sizeof(BookSlot));
+}
+
+std::string errno_message(const std::string& what, const std::string& name) {
+  return what + " " + name + ": " + std::strerror(errno);
+}
+
+// Process-shared futex on the header's epoch word (no FUTEX_PRIVATE_FLAG)
+void futex_wait(std::atomic<uint32_t>& word, uint32_t expected, std::chrono::microseconds timeout) {
+#ifdef __linux__
+  struct timespec ts;
+  ts.tv_sec = static_cast<time_t>(timeout.count() / 1000000);
+  ts.tv_nsec = static_cast<long>((timeout.count() % 1000000) * 1000);
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, expected, &ts, nullptr, 0);
+#else
+  (void)word;
+  (void)expected;
+  (void)timeout;
+  std::this_thread::yield();
+#endif
+}
+
+void futex_wake_all(std::atomic<uint32_t>& word) {
+#ifdef __linux__
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+#else
+  (void)word;
+#endif
+}
+
+bool layout_matches(const BusHeader& header, size_t book_slots, size_t trade_capacity) {
+  return header.magic == kBusMagic && header.version == kBusVersion && header.book_slots == book_slots &&
+         header.trade_capacity == trade_capacity && header.book_size == sizeof(BookMessage);
+}
+
+} // namespace
+
+size_t segment_size(size_t book_slots, size_t trade_capacity) {
+  return trades_offset(book_slots) + trade_capacity * sizeof(TradeSlot);
+}
+
+// ---- ShmMdPublisher -------------------------------------------------------
+
+ShmMdPublisher::ShmMdPublisher(const std::string& name, size_t book_slots, size_t trade_capacity)
+  : name_(name) {
+  book_slots = round_up(book_slots);
+  trade_capacity = round_up(trade_capacity);
+  size_ = segment_size(book_slots, trade_capacity);
+
+  if (reopen(book_slots, trade_capacity)) {
+    LOG_INFO_COMP("ShmMdPublisher", "Reopened shared-memory bus " + name);
+    return;
+  }
+  create(book_slots, trade_capacity);
+  LOG_INFO_COMP("ShmMdPublisher", "Created shared-memory bus " + name + " (" + std::to_string(size_) + " bytes)");
+}
+
+bool ShmMdPublisher::reopen(size_t book_slots, size_t trade_capacity) {
+  int fd = shm_open(name_.c_str(), O_RDWR, 0);
+  if (fd < 0) {
+    if (errno == ENOENT) {
+      return false;
+    }
+    throw std::runtime_error(errno_message("shm_open failed for", name_));
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) != size_) {
+    close(fd);
+    return false;
+  }
+  void* base = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+  close(fd);
+  if (base == MAP_FAILED) {
+    throw std::runtime_error(errno_message("mmap failed for", name_));
+  }
+  if (!layout_matches(*static_cast<const BusHeader*>(base), book_slots, trade_capacity)) {
+    munmap(base, size_);
+    return false;
+  }
+  base_ = base;
+  set_layout(book_slots, trade_capacity);
+
+  // A previous market_server's segment: keep it, readers may still have it mapped.
+  // A writer that died mid-publish left its slot's seqlock odd, which would put
+  // every later write under an even sequence. Round those up to even; the torn
+  // book loses its magic, so it fails decoding until the slot is published again.
+  for (size_t i = 0; i < book_slots; ++i) {
+    const uint64_t version = books_[i].sequence.load(std::memory_order_relaxed);
+    if (version & 1) {
+      books_[i].book.magic = 0;
+      books_[i].sequence.store(version + 1, std::memory_order_release);
+    }
+  }
+  // Likewise a torn trade (2 * index + 1) would stall readers at its index until
+  // the ring wraps: complete it as a record they skip
+  for (size_t i = 0; i < trade_capacity; ++i) {
+    const uint64_t sequence = trades_[i].sequence.load(std::memory_order_relaxed);
+    if (sequence & 1) {
+      trades_[i].record.flags = kTradeTorn;
+      trades_[i].sequence.store(sequence + 1, std::memory_order_release);
+    }
+  }
+  return true;
+}
+
+void ShmMdPublisher::create(size_t book_slots, size_t trade_capacity) {
+  int fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0660);
+  if (fd < 0 && errno == EEXIST) {
+    // Another layout (or never initialized). Readers may still map it, so it is
+    // neither resized nor cleared: the name moves to a fresh segment instead.
+    LOG_WARN_COMP("ShmMdPublisher", "Shared-memory bus " + name_ + " has a different layout; replacing it");
+    if (shm_unlink(name_.c_str()) != 0 && errno != ENOENT) {
+      throw std::runtime_error(errno_message("shm_unlink failed for", name_));
+    }
+    fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0660);
+  }
+  if (fd < 0) {
+    throw std::runtime_error(errno_message("shm_open failed for", name_));
+  }
+  if (ftruncate(fd, static_cast<off_t>(size_)) != 0) {
+    close(fd);
+    throw std::runtime_error(errno_message("ftruncate failed for", name_));
+  }
+  base_ = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+  close(fd);
+  if (base_ == MAP_FAILED) {
+    base_ = nullptr;
+    throw std::runtime_error(errno_message("mmap failed for", name_));
+  }
+  set_layout(book_slots, trade_capacity);
+
+  // ftruncate zero-filled the new segment
+  new (header_) BusHeader();
+  for (size_t i = 0; i < book_slots; ++i) new (&books_[i]) BookSlot();
+  for (size_t i = 0; i < trade_capacity; ++i) new (&trades_[i]) TradeSlot();
+  header_->version = kBusVersion;
+  header_->book_slots = static_cast<uint32_t>(book_slots);
+  header_->trade_capacity = static_cast<uint32_t>(trade_capacity);
+  header_->book_size = static_cast<uint32_t>(sizeof(BookMessage));
+  std::atomic_thread_fence(std::memory_order_release);
+  header_->magic = kBusMagic;   // Last, so readers never accept a half-built header
+}
+
+void ShmMdPublisher::set_layout(size_t book_slots, size_t trade_capacity) {
+  char* base = static_cast<char*>(base_);
+  header_ = reinterpret_cast<BusHeader*>(base);
+  books_ = reinterpret_cast<BookSlot*>(base + books_offset());
+  trades_ = reinterpret_cast<TradeSlot*>(base + trades_offset(book_slots));
+  book_mask_ = book_slots - 1;
+  trade_mask_ = trade_capacity - 1;
+}
+
+ShmMdPublisher::~ShmMdPublisher() {
+  if (base_) {
+    munmap(base_, size_);
+    base_ = nullptr;
+  }
+}
+
+BookSlot* ShmMdPublisher::claim_slot(uint32_t instrument_id) {
+  const uint64_t key = kKeyTag | instrument_id;
+  for (size_t probe = 0; probe <= book_mask_; ++probe) {
+    BookSlot& slot = books_[(instrument_id + probe) & book_mask_];
+    uint64_t current = slot.key.load(std::memory_order_acquire);
+    if (current == 0 && slot.key.compare_exchange_strong(current, key, std::memory_order_acq_rel)) {
+      return &slot;
+    }
+    if (current == key) {
+      return &slot;
+    }
+  }
+  return nullptr;
+}
+
+void ShmMdPublisher::notify() {
+  header_->epoch.fetch_add(1, std::memory_order_release);
+  // Pairs with the waiter's increment: either it sees the new epoch or we see it parked
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (header_->waiters.load(std::memory_order_relaxed) != 0) {
+    futex_wake_all(header_->epoch);
+  }
+}
+
+// ---- ShmMdSubscriber ------------------------------------------------------
+
+ShmMdSubscriber::ShmMdSubscriber(const std::string& name) : name_(name) {
+  // Read-write: parked readers register in the header's waiter count
+  int fd = shm_open(name.c_str(), O_RDWR, 0);
+  if (fd < 0) {
+    throw std::runtime_error(errno_message("shm_open failed for", name));
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(BusHeader)) {
+    close(fd);
+    throw std::runtime_error("Shared-memory bus " + name + " is not initialized");
+  }
+  device_ = static_cast<uint64_t>(st.st_dev);
+  inode_ = static_cast<uint64_t>(st.st_ino);
+  size_ = static_cast<size_t>(st.st_size);
+  base_ = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (base_ == MAP_FAILED) {
+    base_ = nullptr;
+    throw std::runtime_error(errno_message("mmap failed for", name));
+  }
+
+  char* base = static_cast<char*>(base_);
+  header_ = reinterpret_cast<BusHeader*>(base);
+  const size_t book_slots = header_->book_slots;
+  const size_t trade_capacity = header_->trade_capacity;
+  if (!layout_matches(*header_, book_slots, trade_capacity) || book_slots == 0 || trade_capacity == 0 ||
+      (book_slots & (book_slots - 1)) != 0 || (trade_capacity & (trade_capacity - 1)) != 0 ||
+      segment_size(book_slots, trade_capacity) > size_) {
+    munmap(base_, size_);
+    base_ = nullptr;
+    throw std::runtime_error("Shared-memory bus " + name + " has an incompatible layout");
+  }
+  books_ = reinterpret_cast<const BookSlot*>(base + books_offset());
+  trades_ = reinterpret_cast<const TradeSlot*>(base + trades_offset(book_slots));
+  book_mask_ = book_slots - 1;
+  trade_mask_ = trade_capacity - 1;
+  trade_position_ = header_->trade_cursor.load(std::memory_order_acquire);
+}
+
+ShmMdSubscriber::~ShmMdSubscriber() {
+  if (base_) {
+    munmap(base_, size_);
+    base_ = nullptr;
+  }
+}
+
+bool ShmMdSubscriber::is_replaced() const {
+  int fd = shm_open(name_.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    return false;   // Unlinked but not recreated yet: nothing to switch to
+  }
+  struct stat st;
+  const bool replaced = fstat(fd, &st) == 0 && (static_cast<uint64_t>(st.st_dev) != device_ ||
+                                                static_cast<uint64_t>(st.st_ino) != inode_);
+  close(fd);
+  return replaced;
+}
+
+const BookSlot* ShmMdSubscriber::find_slot(uint32_t instrument_id) {
+  if (last_slot_ && last_instrument_id_ == instrument_id) {
+    return last_slot_;
+  }
+  const uint64_t key = kKeyTag | instrument_id;
+  for (size_t probe = 0; probe <= book_mask_; ++probe) {
+    const BookSlot& slot = books_[(instrument_id + probe) & book_mask_];
+    const uint64_t current = slot.key.load(std::memory_order_acquire);
+    if (current == key) {
+      // Slots are never released, so the mapping can be cached
+      last_slot_ = &slot;
+      last_instrument_id_ = instrument_id;
+      return last_slot_;
+    }
+    if (current == 0) {
+      return nullptr;   // Not published yet
+    }
+  }
+  return nullptr;
+}
+
+bool ShmMdSubscriber::read_book(uint32_t instrument_id, BookMessage& out, uint64_t& version) {
+  const BookSlot* slot = find_slot(instrument_id);
+  if (!slot) {
+    return false;
+  }
+  for (int attempt = 0; attempt < kSeqlockRetries; ++attempt) {
+    const uint64_t before = slot->sequence.load(std::memory_order_acquire);
+    if (before == version) {
+      return false;
+    }
+    if (before & 1) {
+      RingWaiter::cpu_relax();   // Writer mid-update
+      continue;
+    }
+    std::memcpy(static_cast<void*>(&out), &slot->book, sizeof(out));
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot->sequence.load(std::memory_order_relaxed) == before) {
+      version = before;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ShmMdSubscriber::next_trade(TradeRecord& out) {
+  const uint64_t capacity = trade_mask_ + 1;
+  for (;;) {
+    const TradeSlot& slot = trades_[trade_position_ & trade_mask_];
+    const uint64_t expected = 2 * trade_position_ + 2;
+    const uint64_t before = slot.sequence.load(std::memory_order_acquire);
+    if (before < expected) {
+      return false;   // Not written yet, or still being written
+    }
+    if (before == expected) {
+      std::memcpy(&out, &slot.record, sizeof(out));
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.sequence.load(std::memory_order_relaxed) == expected) {
+        ++trade_position_;
+        if (out.flags & kTradeTorn) {
+          ++trades_overrun_;
+          continue;
+        }
+        return true;
+      }
+    }
+    // Lapped by the writers: resume half a ring behind them
+    const uint64_t cursor = header_->trade_cursor.load(std::memory_order_acquire);
+    const uint64_t resume = std::max(trade_position_ + 1, cursor > capacity / 2 ? cursor - capacity / 2 : 0);
+    trades_overrun_ += resume - trade_position_;
+    trade_position_ = resume;
+  }
+}
+
+bool ShmMdSubscriber::wait(uint32_t& epoch, WaitStrategy strategy, std::chrono::microseconds timeout) {
+  auto changed = [this, &epoch]() {
+    const uint32_t current = header_->epoch.load(std::memory_order_acquire);
+    if (current == epoch) return false;
+    epoch = current;
+    return true;
+  };
+
+  for (int i = 0; i < kSpinIterations; ++i) {
+    if (changed()) return true;
+    RingWaiter::cpu_relax();
+  }
+
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  while (!changed()) {
+    const auto now = std::chrono::steady_clock::now();
+    if (now >= deadline) return false;
+
+    switch (strategy) {
+      case WaitStrategy::BUSY_SPIN:
+        RingWaiter::cpu_relax();
+        break;
+      case WaitStrategy::YIELD:
+        std::this_thread::yield();
+        break;
+      case WaitStrategy::FUTEX:
+        header_->waiters.fetch_add(1, std::memory_order_seq_cst);
+        if (header_->epoch.load(std::memory_order_seq_cst) == epoch) {
+          futex_wait(header_->epoch, epoch, std::chrono::duration_cast<std::chrono::microseconds>(deadline - now));
+        }
+        header_->waiters.fetch_sub(1, std::memory_order_relaxed);
+        break;
+    }
+  }
+  return true;
+}
+
+} // namespace shm_md
@@ -0,0 +1,267 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include "../lockfree/wait_strategy.hpp"
+#include "../mds/orderbook_binary.hpp"
+
+/**
+ * Shared-memory market data bus for consumers on the market_server's host
+ *
+ * One POSIX shared-memory segment (shm_open) holds:
+ *
+ * - A table of book slots, one per instrument id, each holding the latest
+ *   md_binary book behind a seqlock. Readers copy a book out without any
+ *   syscall and retry if the writer was mid-update; they only ever see the
+ *   newest book (intermediate ones are conflated away).
+ * - A broadcast ring of fixed-size trade records. Every reader keeps its own
+ *   cursor; a reader that falls a full ring behind skips ahead and counts
+ *   the lost records instead of blocking the publisher.
+ * - An update epoch bumped after every write, with a waiter count, so an
+ *   idle reader can park on a (process-shared) futex; the publisher only
+ *   pays for a wake syscall while somebody is parked.
+ *
+ * The segment outlives the publisher: a restarted market_server reopens it
+ * (if the layout matches) so mapped readers keep working. A segment with a
+ * different layout is never resized or cleared in place, since readers may
+ * still map it: the publisher unlinks the name and creates a fresh segment,
+ * and readers notice (is_replaced()) and reopen.
+ *
+ * @note Each instrument's book must be written by one thread at a time
+ *       (market_server writes a symbol only from its venue thread). Trades
+ *       may be published from any number of threads.
+ */
+namespace shm_md {
+
+constexpr uint32_t kBusMagic = 0x53554253;   // "SBUS"
+constexpr uint32_t kBusVersion = 1;
+constexpr size_t kDefaultBookSlots = 256;
+constexpr size_t kDefaultTradeCapacity = 4096;
+constexpr const char* kDefaultBusName = "/market_maker_md";
+
+// TradeRecord::flags: the writer died mid-record; readers skip it
+constexpr uint16_t kTradeTorn = 1;
+
+using BookMessage = md_binary::DefaultBookMessage;
+
+struct TradeRecord {
+  uint32_t instrument_id;
+  uint8_t is_buyer_maker;
+  uint8_t trade_id_size;
+  uint16_t flags;   // kTradeTorn
+  uint64_t timestamp_us;
+  double price;
+  double qty;
+  char trade_id[24];   // Truncated to 24 bytes; not NUL-terminated when full
+};
+
+struct alignas(md_binary::kCacheLineSize) BusHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t book_slots;
+  uint32_t trade_capacity;
+  uint32_t book_size;
+  uint32_t reserved;
+  alignas(md_binary::kCacheLineSize) std::atomic<uint64_t> trade_cursor;   // Next trade index to claim
+  alignas(md_binary::kCacheLineSize) std::atomic<uint32_t> epoch;          // Futex word, bumped per write
+  std::atomic<uint32_t> waiters;
+};
+
+struct alignas(md_binary::kCacheLineSize) BookSlot {
+  std::atomic<uint64_t> key;        // 0 = free, else kKeyTag | instrument id
+  std::atomic<uint64_t> sequence;   // Seqlock: odd while the book is being written
+  BookMessage book;
+};
+
+struct alignas(md_binary::kCacheLineSize) TradeSlot {
+  std::atomic<uint64_t> sequence;   // 2 * index + 2 once record `index` is complete
+  TradeRecord record;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared-memory atomics must be address-free");
+static_assert(sizeof(TradeSlot) == md_binary::kCacheLineSize, "trade slot must be one cache line");
+
+// Byte size of a segment with this layout
+size_t segment_size(size_t book_slots, size_t trade_capacity);
+
+/**
+ * Writer side, owned by market_server
+ */
+class ShmMdPublisher {
+ public:
+  /**
+   * Create (or reopen) the segment
+   *
+   * @param name shm_open name, e.g. "/market_maker_md"
+   * @param book_slots Instruments the segment can hold (rounded up to a power of two)
+   * @param trade_capacity Trade ring size (rounded up to a power of two)
+   * @throws std::runtime_error if the segment cannot be created or mapped
+   */
+  explicit ShmMdPublisher(const std::string& name, size_t book_slots = kDefaultBookSlots,
+                          size_t trade_capacity = kDefaultTradeCapacity);
+  ~ShmMdPublisher();
+
+  // Non-copyable
+  ShmMdPublisher(const ShmMdPublisher&) = delete;
+  ShmMdPublisher& operator=(const ShmMdPublisher&) = delete;
+
+  /**
+   * Replace the instrument's latest book
+   *
+   * @return false if the slot table is full (the book is dropped)
+   */
+  template <typename Snapshot>
+  bool publish_book(const Snapshot& snapshot, uint32_t instrument_id, uint64_t sequence) {
+    BookSlot* slot = claim_slot(instrument_id);
+    if (!slot) {
+      books_dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    const uint64_t version = slot->sequence.load(std::memory_order_relaxed);
+    slot->sequence.store(version + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    md_binary::DefaultBookCodec::encode(snapshot, instrument_id, sequence, &slot->book, sizeof(slot->book));
+    slot->sequence.store(version + 2, std::memory_order_release);
+    books_published_.fetch_add(1, std::memory_order_relaxed);
+    notify();
+    return true;
+  }
+
+  // Append a trade to the broadcast ring (never blocks; slow readers lose records)
+  template <typename Trade>
+  void publish_trade(const Trade& trade, uint32_t instrument_id) {
+    const uint64_t index = header_->trade_cursor.fetch_add(1, std::memory_order_relaxed);
+    TradeSlot& slot = trades_[index & trade_mask_];
+    slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    TradeRecord& record = slot.record;
+    record.instrument_id = instrument_id;
+    record.is_buyer_maker = trade.is_buyer_maker() ? 1 : 0;
+    record.flags = 0;
+    record.timestamp_us = trade.timestamp_us();
+    record.price = trade.price();
+    record.qty = trade.qty();
+    const size_t id_size = std::min(trade.trade_id().size(), sizeof(record.trade_id));
+    std::memcpy(record.trade_id, trade.trade_id().data(), id_size);
+    record.trade_id_size = static_cast<uint8_t>(id_size);
+
+    slot.sequence.store(2 * index + 2, std::memory_order_release);
+    trades_published_.fetch_add(1, std::memory_order_relaxed);
+    notify();
+  }
+
+  const std::string& name() const { return name_; }
+
+  // Statistics
+  uint64_t get_books_published() const { return books_published_.load(); }
+  uint64_t get_books_dropped() const { return books_dropped_.load(); }
+  uint64_t get_trades_published() const { return trades_published_.load(); }
+
+ private:
+  BookSlot* claim_slot(uint32_t instrument_id);
+  void notify();
+
+  // Map an existing segment if its layout matches; false leaves it untouched
+  bool reopen(size_t book_slots, size_t trade_capacity);
+  void create(size_t book_slots, size_t trade_capacity);
+  void set_layout(size_t book_slots, size_t trade_capacity);
+
+  std::string name_;
+  void* base_{nullptr};
+  size_t size_{0};
+  BusHeader* header_{nullptr};
+  BookSlot* books_{nullptr};
+  TradeSlot* trades_{nullptr};
+  size_t book_mask_{0};
+  size_t trade_mask_{0};
+
+  std::atomic<uint64_t> books_published_{0};
+  std::atomic<uint64_t> books_dropped_{0};
+  std::atomic<uint64_t> trades_published_{0};
+};
+
+/**
+ * Reader side; one per consuming thread
+ *
+ * read_book() and next_trade() are plain loads from the mapping: no
+ * syscalls, no allocation.
+ */
+class ShmMdSubscriber {
+ public:
+  /**
+   * Map an existing segment
+   *
+   * @throws std::runtime_error if it does not exist (publisher not started
+   *         yet) or its layout does not match this build
+   */
+  explicit ShmMdSubscriber(const std::string& name);
+  ~ShmMdSubscriber();
+
+  // Non-copyable
+  ShmMdSubscriber(const ShmMdSubscriber&) = delete;
+  ShmMdSubscriber& operator=(const ShmMdSubscriber&) = delete;
+
+  /**
+   * Copy the instrument's latest book into `out` if it changed since `version`
+   *
+   * @param version In: version last read (0 initially). Out: version copied.
+   * @return true if `out` now holds a newer book
+   */
+  bool read_book(uint32_t instrument_id, BookMessage& out, uint64_t& version);
+
+  /**
+   * Next trade after this reader's cursor (the cursor starts at the ring's
+   * head when the subscriber is created)
+   *
+   * @return false if there is none yet
+   */
+  bool next_trade(TradeRecord& out);
+
+  /**
+   * Wait until something is published after `epoch`, per `strategy`
+   * (FUTEX parks on the shared epoch word)
+   *
+   * @param epoch In: epoch last seen (from current_epoch()). Out: current epoch.
+   * @return false on timeout
+   */
+  bool wait(uint32_t& epoch, WaitStrategy strategy, std::chrono::microseconds timeout);
+
+  uint32_t current_epoch() const { return header_->epoch.load(std::memory_order_acquire); }
+
+  /**
+   * True once the bus name refers to another segment (a publisher with a
+   * different layout replaced it); nothing more arrives here, reopen instead
+   *
+   * @note Makes syscalls: check it while idle, e.g. after wait() times out
+   */
+  bool is_replaced() const;
+
+  // Trades lost: this reader fell a full ring behind, or a writer died mid-record
+  uint64_t get_trades_overrun() const { return trades_overrun_; }
+
+ private:
+  const BookSlot* find_slot(uint32_t instrument_id);
+
+  std::string name_;
+  uint64_t device_{0};   // Identity of the mapped segment, for is_replaced()
+  uint64_t inode_{0};
+  void* base_{nullptr};
+  size_t size_{0};
+  BusHeader* header_{nullptr};
+  const BookSlot* books_{nullptr};
+  const TradeSlot* trades_{nullptr};
+  size_t book_mask_{0};
+  size_t trade_mask_{0};
+
+  const BookSlot* last_slot_{nullptr};
+  uint32_t last_instrument_id_{0};
+  uint64_t trade_position_{0};
+  uint64_t trades_overrun_{0};
+};
+
+} // namespace shm_md
@@ -27,12 +27,12 @@ struct WebSocketFrame {
     std::vector<uint8_t> payload;
     
     // Opcode constants
-    static const uint8_t OPCODE_CONTINUATION = 0x0;
-    static const uint8_t OPCODE_TEXT = 0x1;
-    static const uint8_t OPCODE_BINARY = 0x2;
-    static const uint8_t OPCODE_CLOSE = 0x8;
-    static const uint8_t OPCODE_PING = 0x9;
-    static const uint8_t OPCODE_PONG = 0xA;
+    static constexpr uint8_t OPCODE_CONTINUATION = 0x0;
+    static constexpr uint8_t OPCODE_TEXT = 0x1;
+    static constexpr uint8_t OPCODE_BINARY = 0x2;
+    static constexpr uint8_t OPCODE_CLOSE = 0x8;
+    static constexpr uint8_t OPCODE_PING = 0x9;
+    static constexpr uint8_t OPCODE_PONG = 0xA;
 };
 
 // WebSocket event callbacks
@@ -36,6 +36,9 @@ bool LibuvWebSocketHandler::initialize() {
     // Initialize WebSocket data
     ws_data_ = std::make_unique<WebSocketData>();
     ws_data_->handler = this;
+    decoder_.set_frame_callback([this](uint8_t opcode, std::string_view payload) {
+        handle_frame(opcode, payload);
+    });
     
     running_.store(true);
     return true;
@@ -70,12 +73,8 @@ bool LibuvWebSocketHandler::connect(const std::string& url) {
     
     std::cout << "[LIBUV-WS] Connecting to: " << url_ << std::endl;
     
-    // Parse URL
-    std::string host, path;
-    int port;
-    bool ssl;
-    
-    if (!parse_url(url_, host, port, path, ssl)) {
+    // Parse URL (host_/port_/path_ are also used by the handshake)
+    if (!parse_url(url_, host_, port_, path_, ssl_)) {
         std::cerr << "[LIBUV-WS] Failed to parse URL: " << url_ << std::endl;
         update_state(WebSocketState::ERROR);
         return false;
@@ -83,6 +82,8 @@ bool LibuvWebSocketHandler::connect(const std::string& url) {
     
     // Initialize TCP connection
     uv_tcp_init(loop_, &ws_data_->tcp);
+    ws_data_->tcp.data = ws_data_.get();
+    decoder_.reset();
     
     // Set up connection request
     ws_data_->connect_req.data = ws_data_.get();
@@ -94,9 +95,9 @@ bool LibuvWebSocketHandler::connect(const std::string& url) {
     hints.ai_socktype = SOCK_STREAM;
     
     struct addrinfo* res;
-    int err = getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &res);
+    int err = getaddrinfo(host_.c_str(), std::to_string(port_).c_str(), &hints, &res);
     if (err != 0) {
-        std::cerr << "[LIBUV-WS] Failed to resolve hostname: " << host << std::endl;
+        std::cerr << "[LIBUV-WS] Failed to resolve hostname: " << host_ << std::endl;
         update_state(WebSocketState::ERROR);
         return false;
     }
@@ -140,39 +141,8 @@ bool LibuvWebSocketHandler::send_message(const std::string& message, bool binary
         return false;
     }
     
-    std::lock_guard<std::mutex> lock(send_mutex_);
-    
-    // Create WebSocket frame
-    WebSocketFrame frame;
-    frame.fin = true;
-    frame.rsv1 = frame.rsv2 = frame.rsv3 = false;
-    frame.opcode = binary ? WebSocketFrame::OPCODE_BINARY : WebSocketFrame::OPCODE_TEXT;
-    frame.mask = true; // Client must mask frames
-    frame.payload_length = message.length();
-    frame.masking_key.resize(4);
-    for (int i = 0; i < 4; i++) {
-        frame.masking_key[i] = rand() & 0xFF;
-    }
-    frame.payload.assign(message.begin(), message.end());
-    
-    // Apply masking
-    for (size_t i = 0; i < frame.payload.size(); ++i) {
-        frame.payload[i] ^= ((uint8_t*)&frame.masking_key)[i % 4];
-    }
-    
-    // Serialize frame
-    std::vector<uint8_t> frame_data = serialize_frame(frame);
-    
-    // Send via libuv
-    uv_buf_t buf = uv_buf_init((char*)frame_data.data(), frame_data.size());
-    int err = uv_write(&ws_data_->write_req, (uv_stream_t*)&ws_data_->tcp, &buf, 1, on_write);
-    
-    if (err != 0) {
-        std::cerr << "[LIBUV-WS] Failed to send message: " << uv_strerror(err) << std::endl;
-        return false;
-    }
-    
-    return true;
+    uint8_t opcode = binary ? WebSocketFrame::OPCODE_BINARY : WebSocketFrame::OPCODE_TEXT;
+    return send_frame(opcode, message.data(), message.size());
 }
 
 bool LibuvWebSocketHandler::send_binary(const std::vector<uint8_t>& data) {
@@ -181,39 +151,57 @@ bool LibuvWebSocketHandler::send_binary(const std::vector<uint8_t>& data) {
         return false;
     }
     
-    std::lock_guard<std::mutex> lock(send_mutex_);
-    
-    // Create WebSocket frame
-    WebSocketFrame frame;
-    frame.fin = true;
-    frame.rsv1 = frame.rsv2 = frame.rsv3 = false;
-    frame.opcode = WebSocketFrame::OPCODE_BINARY;
-    frame.mask = true;
-    frame.payload_length = data.size();
-    frame.masking_key.resize(4);
-    for (int i = 0; i < 4; i++) {
-        frame.masking_key[i] = rand() & 0xFF;
-    }
-    frame.payload = data;
-    
-    // Apply masking
-    for (size_t i = 0; i < frame.payload.size(); ++i) {
-        frame.payload[i] ^= ((uint8_t*)&frame.masking_key)[i % 4];
-    }
-    
-    // Serialize and send
-    std::vector<uint8_t> frame_data = serialize_frame(frame);
-    uv_buf_t buf = uv_buf_init((char*)frame_data.data(), frame_data.size());
-    int err = uv_write(&ws_data_->write_req, (uv_stream_t*)&ws_data_->tcp, &buf, 1, on_write);
+    return send_frame(WebSocketFrame::OPCODE_BINARY, data.data(), data.size());
+}
+
+bool LibuvWebSocketHandler::send_frame(uint8_t opcode, const void* payload, size_t length) {
+    WriteRequest* request;
+    {
+        std::lock_guard<std::mutex> lock(send_mutex_);
+        request = acquire_write_request();
+        
+        // Client frames are always masked; header and payload go out in one buffer
+        uint8_t mask_key[4];
+        mask_keys_.next(mask_key);
+        websocket_codec::encode_frame(request->buffer, opcode, payload, length, mask_key);
+    }
+    
+    return write_buffer(request);
+}
+
+bool LibuvWebSocketHandler::write_buffer(WriteRequest* request) {
+    uv_buf_t buf = uv_buf_init(&request->buffer[0], static_cast<unsigned int>(request->buffer.size()));
+    int err = uv_write(&request->req, (uv_stream_t*)&ws_data_->tcp, &buf, 1, on_write);
     
     if (err != 0) {
-        std::cerr << "[LIBUV-WS] Failed to send binary data: " << uv_strerror(err) << std::endl;
+        std::cerr << "[LIBUV-WS] Failed to send frame: " << uv_strerror(err) << std::endl;
+        release_write_request(request);
         return false;
     }
     
     return true;
 }
 
+LibuvWebSocketHandler::WriteRequest* LibuvWebSocketHandler::acquire_write_request() {
+    // Caller holds send_mutex_
+    if (free_write_requests_.empty()) {
+        write_requests_.push_back(std::make_unique<WriteRequest>());
+        WriteRequest* request = write_requests_.back().get();
+        request->req.data = request;
+        request->handler = this;
+        return request;
+    }
+    WriteRequest* request = free_write_requests_.back();
+    free_write_requests_.pop_back();
+    return request;
+}
+
+void LibuvWebSocketHandler::release_write_request(WriteRequest* request) {
+    // The buffer keeps its capacity for the next frame
+    std::lock_guard<std::mutex> lock(send_mutex_);
+    free_write_requests_.push_back(request);
+}
+
 // Static callback implementations
 void LibuvWebSocketHandler::on_connect(uv_connect_t* req, int status) {
     WebSocketData* data = static_cast<WebSocketData*>(req->data);
@@ -258,7 +246,7 @@ void LibuvWebSocketHandler::on_connect(uv_connect_t* req, int status) {
                    handler->ping_interval_seconds_ * 1000);
 }
 
-void LibuvWebSocketHandler::on_read(uv_stream_t* stream, ssize_t nread, const uv_buf_t* buf) {
+void LibuvWebSocketHandler::on_read(uv_stream_t* stream, ssize_t nread, const uv_buf_t* /*buf*/) {
     WebSocketData* data = static_cast<WebSocketData*>(stream->data);
     LibuvWebSocketHandler* handler = data->handler;
     
@@ -274,21 +262,19 @@ void LibuvWebSocketHandler::on_read(uv_stream_t* stream, ssize_t nread, const uv
     }
     
     if (nread > 0) {
-        // Process received data
-        std::string received_data(buf->base, nread);
-        handler->process_received_data(received_data);
-    }
-    
-    if (buf->base) {
-        free(buf->base);
+        // The read landed in the decoder's own buffer (alloc_buffer), so there is nothing to copy or free
+        handler->decoder_.commit(static_cast<size_t>(nread));
+        handler->process_received_data();
     }
 }
 
 void LibuvWebSocketHandler::on_write(uv_write_t* req, int status) {
+    WriteRequest* request = static_cast<WriteRequest*>(req->data);
+    LibuvWebSocketHandler* handler = request->handler;
+    handler->release_write_request(request);
+    
     if (status < 0) {
         std::cerr << "[LIBUV-WS] Write error: " << uv_strerror(status) << std::endl;
-        WebSocketData* data = static_cast<WebSocketData*>(req->data);
-        LibuvWebSocketHandler* handler = data->handler;
         handler->update_state(WebSocketState::ERROR);
         if (handler->error_callback_) {
             handler->error_callback_("Write error: " + std::string(uv_strerror(status)));
@@ -331,8 +317,10 @@ void LibuvWebSocketHandler::on_close(uv_handle_t* handle) {
 }
 
 void LibuvWebSocketHandler::alloc_buffer(uv_handle_t* handle, size_t suggested_size, uv_buf_t* buf) {
-    buf->base = static_cast<char*>(malloc(suggested_size));
-    buf->len = suggested_size;
+    WebSocketData* data = static_cast<WebSocketData*>(handle->data);
+    auto space = data->handler->decoder_.prepare(suggested_size);
+    buf->base = space.first;
+    buf->len = space.second;
 }
 
 // Internal method implementations
@@ -371,20 +359,7 @@ void LibuvWebSocketHandler::send_ping() {
         return;
     }
     
-    WebSocketFrame frame;
-    frame.fin = true;
-    frame.rsv1 = frame.rsv2 = frame.rsv3 = false;
-    frame.opcode = WebSocketFrame::OPCODE_PING;
-    frame.mask = true;
-    frame.payload_length = 0;
-    frame.masking_key.resize(4);
-    for (int i = 0; i < 4; i++) {
-        frame.masking_key[i] = rand() & 0xFF;
-    }
-    
-    std::vector<uint8_t> frame_data = serialize_frame(frame);
-    uv_buf_t buf = uv_buf_init((char*)frame_data.data(), frame_data.size());
-    uv_write(&ws_data_->write_req, (uv_stream_t*)&ws_data_->tcp, &buf, 1, on_write);
+    send_frame(WebSocketFrame::OPCODE_PING, nullptr, 0);
 }
 
 void LibuvWebSocketHandler::attempt_reconnect() {
@@ -457,13 +432,16 @@ bool LibuvWebSocketHandler::perform_websocket_handshake() {
     request << "Sec-WebSocket-Version: 13\r\n";
     request << "\r\n";
     
-    std::string handshake = request.str();
-    
-    // Send handshake
-    uv_buf_t buf = uv_buf_init((char*)handshake.c_str(), handshake.length());
-    int err = uv_write(&ws_data_->write_req, (uv_stream_t*)&ws_data_->tcp, &buf, 1, on_write);
+    WriteRequest* write_request;
+    {
+        std::lock_guard<std::mutex> lock(send_mutex_);
+        write_request = acquire_write_request();
+        write_request->buffer = request.str();
+    }
     
-    return err == 0;
+    // The upgrade response arrives ahead of the first frame; see process_received_data
+    handshake_pending_ = true;
+    return write_buffer(write_request);
 }
 
 std::string LibuvWebSocketHandler::generate_websocket_key() {
@@ -494,55 +472,50 @@ std::string LibuvWebSocketHandler::base64_encode(const std::vector<uint8_t>& dat
     return result;
 }
 
-void LibuvWebSocketHandler::process_received_data(const std::string& data) {
-    // Simple WebSocket frame parsing
-    if (data.length() < 2) {
-        return;
-    }
-    
-    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data.c_str());
-    
-    bool fin = (bytes[0] & 0x80) != 0;
-    uint8_t opcode = bytes[0] & 0x0F;
-    bool mask = (bytes[1] & 0x80) != 0;
-    uint64_t payload_length = bytes[1] & 0x7F;
-    
-    size_t header_size = 2;
-    if (payload_length == 126) {
-        if (data.length() < 4) return;
-        payload_length = (bytes[2] << 8) | bytes[3];
-        header_size = 4;
-    } else if (payload_length == 127) {
-        if (data.length() < 10) return;
-        payload_length = 0;
-        for (int i = 0; i < 8; ++i) {
-            payload_length = (payload_length << 8) | bytes[2 + i];
+void LibuvWebSocketHandler::process_received_data() {
+    if (handshake_pending_) {
+        std::string_view buffered = decoder_.buffered();
+        size_t end = buffered.find("\r\n\r\n");
+        if (end == std::string_view::npos) {
+            return; // Upgrade response incomplete
         }
-        header_size = 10;
-    }
-    
-    if (mask) {
-        header_size += 4; // masking key
+        if (buffered.compare(0, 12, "HTTP/1.1 101") != 0) {
+            std::cerr << "[LIBUV-WS] WebSocket upgrade rejected: " << buffered.substr(0, buffered.find("\r\n")) << std::endl;
+            update_state(WebSocketState::ERROR);
+            return;
+        }
+        decoder_.consume(end + 4);
+        handshake_pending_ = false;
     }
     
-    if (data.length() < header_size + payload_length) {
-        return; // Incomplete frame
+    auto status = decoder_.process();
+    if (status != websocket_codec::WebSocketFrameDecoder::Status::OK) {
+        const char* reason = status == websocket_codec::WebSocketFrameDecoder::Status::MESSAGE_TOO_BIG
+            ? "message too big" : "protocol error";
+        std::cerr << "[LIBUV-WS] Invalid frame: " << reason << std::endl;
+        update_state(WebSocketState::ERROR);
+        if (error_callback_) {
+            error_callback_(std::string("Invalid frame: ") + reason);
+        }
+        decoder_.reset();
+        disconnect();
     }
-    
-    // Extract payload
-    std::string payload = data.substr(header_size, payload_length);
-    
+}
+
+void LibuvWebSocketHandler::handle_frame(uint8_t opcode, std::string_view payload) {
     // Handle different frame types
     switch (opcode) {
         case WebSocketFrame::OPCODE_TEXT:
         case WebSocketFrame::OPCODE_BINARY: {
-            WebSocketMessage msg;
-            msg.data = payload;
-            msg.is_binary = (opcode == WebSocketFrame::OPCODE_BINARY);
-            msg.timestamp_us = std::chrono::duration_cast<std::chrono::microseconds>(
-                std::chrono::system_clock::now().time_since_epoch()).count();
-            
-            if (message_callback_) {
+            bool is_binary = (opcode == WebSocketFrame::OPCODE_BINARY);
+            if (message_view_callback_) {
+                message_view_callback_(payload, is_binary);
+            } else if (message_callback_) {
+                WebSocketMessage msg;
+                msg.data.assign(payload.data(), payload.size());
+                msg.is_binary = is_binary;
+                msg.timestamp_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()).count();
                 message_callback_(msg);
             }
             break;
@@ -561,70 +534,6 @@ void LibuvWebSocketHandler::process_received_data(const std::string& data) {
     }
 }
 
-void LibuvWebSocketHandler::send_pong(const std::string& payload) {
-    WebSocketFrame frame;
-    frame.fin = true;
-    frame.rsv1 = frame.rsv2 = frame.rsv3 = false;
-    frame.opcode = WebSocketFrame::OPCODE_PONG;
-    frame.mask = true;
-    frame.payload_length = payload.length();
-    frame.masking_key.resize(4);
-    for (int i = 0; i < 4; i++) {
-        frame.masking_key[i] = rand() & 0xFF;
-    }
-    frame.payload.assign(payload.begin(), payload.end());
-    
-    // Apply masking
-    for (size_t i = 0; i < frame.payload.size(); ++i) {
-        frame.payload[i] ^= ((uint8_t*)&frame.masking_key)[i % 4];
-    }
-    
-    std::vector<uint8_t> frame_data = serialize_frame(frame);
-    uv_buf_t buf = uv_buf_init((char*)frame_data.data(), frame_data.size());
-    uv_write(&ws_data_->write_req, (uv_stream_t*)&ws_data_->tcp, &buf, 1, on_write);
-}
-
-std::vector<uint8_t> LibuvWebSocketHandler::serialize_frame(const WebSocketFrame& frame) {
-    std::vector<uint8_t> result;
-    
-    // First byte
-    uint8_t first_byte = 0;
-    if (frame.fin) first_byte |= 0x80;
-    if (frame.rsv1) first_byte |= 0x40;
-    if (frame.rsv2) first_byte |= 0x20;
-    if (frame.rsv3) first_byte |= 0x10;
-    first_byte |= (frame.opcode & 0x0F);
-    result.push_back(first_byte);
-    
-    // Second byte
-    uint8_t second_byte = 0;
-    if (frame.mask) second_byte |= 0x80;
-    
-    if (frame.payload_length < 126) {
-        second_byte |= frame.payload_length;
-        result.push_back(second_byte);
-    } else if (frame.payload_length < 65536) {
-        second_byte |= 126;
-        result.push_back(second_byte);
-        result.push_back((frame.payload_length >> 8) & 0xFF);
-        result.push_back(frame.payload_length & 0xFF);
-    } else {
-        second_byte |= 127;
-        result.push_back(second_byte);
-        for (int i = 7; i >= 0; --i) {
-            result.push_back((frame.payload_length >> (i * 8)) & 0xFF);
-        }
-    }
-    
-    // Masking key
-    if (frame.mask) {
-        for (size_t i = 0; i < frame.masking_key.size() && i < 4; i++) {
-            result.push_back(frame.masking_key[i]);
-        }
-    }
-    
-    // Payload
-    result.insert(result.end(), frame.payload.begin(), frame.payload.end());
-    
-    return result;
+void LibuvWebSocketHandler::send_pong(std::string_view payload) {
+    send_frame(WebSocketFrame::OPCODE_PONG, payload.data(), payload.size());
 }
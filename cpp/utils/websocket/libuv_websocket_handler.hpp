@@ -1,14 +1,18 @@
 #pragma once
 #include "i_websocket_handler.hpp"
+#include "websocket_frame_codec.hpp"
 #include <uv.h>
 #include <string>
+#include <string_view>
 #include <atomic>
 #include <thread>
 #include <mutex>
-#include <queue>
 #include <memory>
 #include <vector>
 
+// Zero-copy delivery: data points into the receive buffer and is only valid during the call
+using WebSocketMessageViewCallback = std::function<void(std::string_view data, bool is_binary)>;
+
 // libuv-based WebSocket handler implementation
 class LibuvWebSocketHandler : public IWebSocketHandler {
 public:
@@ -24,6 +28,8 @@ public:
     bool send_binary(const std::vector<uint8_t>& data) override;
     
     void set_message_callback(WebSocketMessageCallback callback) override { message_callback_ = callback; }
+    // Takes precedence over the message callback, which copies each message into a WebSocketMessage
+    void set_message_view_callback(WebSocketMessageViewCallback callback) { message_view_callback_ = callback; }
     void set_error_callback(WebSocketErrorCallback callback) override { error_callback_ = callback; }
     void set_connect_callback(WebSocketConnectCallback callback) override { connect_callback_ = callback; }
     
@@ -39,11 +45,17 @@ private:
     struct WebSocketData {
         uv_tcp_t tcp;
         uv_connect_t connect_req;
-        uv_write_t write_req;
         uv_timer_t ping_timer;
         uv_timer_t reconnect_timer;
         LibuvWebSocketHandler* handler;
     };
+
+    // Pooled write: libuv needs the request and the bytes alive until on_write
+    struct WriteRequest {
+        uv_write_t req;
+        std::string buffer;
+        LibuvWebSocketHandler* handler;
+    };
     
     // libuv callbacks
     static void on_connect(uv_connect_t* req, int status);
@@ -65,9 +77,13 @@ private:
     bool perform_websocket_handshake();
     std::string generate_websocket_key();
     std::string base64_encode(const std::vector<uint8_t>& data);
-    void process_received_data(const std::string& data);
-    void send_pong(const std::string& payload);
-    std::vector<uint8_t> serialize_frame(const WebSocketFrame& frame);
+    void process_received_data();
+    void handle_frame(uint8_t opcode, std::string_view payload);
+    void send_pong(std::string_view payload);
+    bool send_frame(uint8_t opcode, const void* payload, size_t length);
+    bool write_buffer(WriteRequest* request);
+    WriteRequest* acquire_write_request();
+    void release_write_request(WriteRequest* request);
     
     // Configuration
     std::string url_;
@@ -90,14 +106,21 @@ private:
     std::unique_ptr<WebSocketData> ws_data_;
     std::thread event_loop_thread_;
     
+    // Receive path: reads land directly in the decoder's buffer
+    websocket_codec::WebSocketFrameDecoder decoder_;
+    bool handshake_pending_{false};
+
     // Callbacks
     WebSocketMessageCallback message_callback_;
+    WebSocketMessageViewCallback message_view_callback_;
     WebSocketErrorCallback error_callback_;
     WebSocketConnectCallback connect_callback_;
     
-    // Thread safety
+    // Thread safety: senders encode under send_mutex_, on_write returns requests to the pool
     std::mutex send_mutex_;
-    std::queue<std::string> send_queue_;
+    websocket_codec::WebSocketMaskKeyGenerator mask_keys_;
+    std::vector<std::unique_ptr<WriteRequest>> write_requests_;   // Owns every request
+    std::vector<WriteRequest*> free_write_requests_;
 };
 
 // Factory implementation
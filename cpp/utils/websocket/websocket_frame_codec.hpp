@@ -0,0 +1,376 @@
+#pragma once
+#include "i_websocket_handler.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * RFC 6455 frame codec
+ *
+ * Allocation-free building blocks for the websocket hot path:
+ * - mask_payload / mask_copy: XOR masking 32 (AVX2) or 16 (SSE2) bytes per
+ *   step, with a 64-bit word loop for targets without either
+ * - WebSocketMaskKeyGenerator: xorshift64* masking keys, seeded once
+ * - encode_header / encode_frame: header and masked payload into a reused buffer
+ * - WebSocketFrameDecoder: incremental receive buffer that reassembles partial
+ *   and fragmented frames and delivers payloads as string_view
+ *
+ * The vector width is chosen at compile time; SSE2 is the x86-64 baseline,
+ * AVX2 is used when the build enables it (-mavx2 / -march=native).
+ */
+namespace websocket_codec {
+
+// 2 bytes + 64-bit extended length + masking key
+static constexpr size_t kMaxHeaderSize = 14;
+
+namespace detail {
+
+// Key bytes starting at offset, as a 32-bit lane in memory order
+inline uint32_t rotated_key(const uint8_t key[4], size_t offset) {
+    uint8_t bytes[4];
+    for (size_t i = 0; i < 4; ++i) {
+        bytes[i] = key[(offset + i) & 3];
+    }
+    uint32_t lane;
+    std::memcpy(&lane, bytes, sizeof(lane));
+    return lane;
+}
+
+} // namespace detail
+
+/**
+ * dst[i] = src[i] ^ key[(offset + i) % 4]; dst may equal src.
+ *
+ * offset is the position of src[0] within the frame payload, so a payload can
+ * be masked in pieces.
+ */
+inline void mask_copy(uint8_t* dst, const uint8_t* src, size_t length, const uint8_t key[4], size_t offset = 0) {
+    const uint32_t lane = detail::rotated_key(key, offset);
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    const __m256i key256 = _mm256_set1_epi32(static_cast<int>(lane));
+    for (; i + 32 <= length; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_xor_si256(v, key256));
+    }
+#endif
+#if defined(__AVX2__) || defined(__SSE2__)
+    const __m128i key128 = _mm_set1_epi32(static_cast<int>(lane));
+    for (; i + 16 <= length; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_xor_si128(v, key128));
+    }
+#endif
+    const uint64_t key64 = (static_cast<uint64_t>(lane) << 32) | lane;
+    for (; i + 8 <= length; i += 8) {
+        uint64_t v;
+        std::memcpy(&v, src + i, sizeof(v));
+        v ^= key64;
+        std::memcpy(dst + i, &v, sizeof(v));
+    }
+    // Every step above is a multiple of 4 bytes, so the tail starts at key[offset % 4]
+    for (; i < length; ++i) {
+        dst[i] = src[i] ^ key[(offset + i) & 3];
+    }
+}
+
+inline void mask_payload(uint8_t* data, size_t length, const uint8_t key[4], size_t offset = 0) {
+    mask_copy(data, data, length, key, offset);
+}
+
+/**
+ * Masking key source for client frames
+ *
+ * RFC 6455 only requires keys the peer cannot predict from earlier frames;
+ * xorshift64* seeded from std::random_device meets that without a syscall or
+ * lock per frame. Not thread-safe: one generator per sending thread.
+ */
+class WebSocketMaskKeyGenerator {
+public:
+    WebSocketMaskKeyGenerator() {
+        std::random_device device;
+        state_ = (static_cast<uint64_t>(device()) << 32) | device();
+        if (state_ == 0) {
+            state_ = 0x9E3779B97F4A7C15ULL;
+        }
+    }
+
+    void next(uint8_t key[4]) {
+        state_ ^= state_ >> 12;
+        state_ ^= state_ << 25;
+        state_ ^= state_ >> 27;
+        uint32_t value = static_cast<uint32_t>((state_ * 0x2545F4914F6CDD1DULL) >> 32);
+        std::memcpy(key, &value, sizeof(value));
+    }
+
+private:
+    uint64_t state_;
+};
+
+// Writes a frame header to out (at least kMaxHeaderSize bytes); returns its size
+inline size_t encode_header(uint8_t* out, uint8_t opcode, bool fin, uint64_t payload_length,
+                            const uint8_t* mask_key) {
+    size_t pos = 0;
+    out[pos++] = static_cast<uint8_t>((fin ? 0x80 : 0x00) | (opcode & 0x0F));
+    const uint8_t mask_bit = mask_key ? 0x80 : 0x00;
+    if (payload_length < 126) {
+        out[pos++] = static_cast<uint8_t>(mask_bit | payload_length);
+    } else if (payload_length <= 0xFFFF) {
+        out[pos++] = static_cast<uint8_t>(mask_bit | 126);
+        out[pos++] = static_cast<uint8_t>(payload_length >> 8);
+        out[pos++] = static_cast<uint8_t>(payload_length);
+    } else {
+        out[pos++] = static_cast<uint8_t>(mask_bit | 127);
+        for (int shift = 56; shift >= 0; shift -= 8) {
+            out[pos++] = static_cast<uint8_t>(payload_length >> shift);
+        }
+    }
+    if (mask_key) {
+        std::memcpy(out + pos, mask_key, 4);
+        pos += 4;
+    }
+    return pos;
+}
+
+/**
+ * Replaces out with one complete frame: header plus payload masked with
+ * mask_key (unmasked if null). out's capacity is reused, so a buffer that has
+ * reached its working size never allocates again.
+ */
+inline void encode_frame(std::string& out, uint8_t opcode, const void* payload, size_t length,
+                         const uint8_t* mask_key, bool fin = true) {
+    out.resize(kMaxHeaderSize + length);
+    uint8_t* base = reinterpret_cast<uint8_t*>(&out[0]);
+    size_t header = encode_header(base, opcode, fin, length, mask_key);
+    const uint8_t* src = static_cast<const uint8_t*>(payload);
+    if (mask_key) {
+        mask_copy(base + header, src, length, mask_key);
+    } else if (length > 0) {
+        std::memcpy(base + header, src, length);
+    }
+    out.resize(header + length);
+}
+
+/**
+ * Incremental frame decoder over a reusable receive buffer
+ *
+ * The socket reads straight into the buffer (prepare/commit), and process()
+ * parses every complete frame in it:
+ * - partial frames and headers stay buffered until the rest arrives
+ * - masked frames are unmasked in place
+ * - unfragmented messages and control frames are delivered as a view into the
+ *   receive buffer, with no copy
+ * - fragmented messages are reassembled in a second buffer whose capacity is
+ *   kept between messages; control frames may arrive between fragments
+ *
+ * Consumed bytes are reclaimed by moving the unparsed tail to the front, so
+ * every frame stays contiguous. Both buffers only grow (up to the frame size
+ * limit), so steady-state decoding does not allocate.
+ *
+ * Views passed to the callback are valid until it returns. The callback must
+ * not call back into the decoder.
+ */
+class WebSocketFrameDecoder {
+public:
+    enum class Status {
+        OK,
+        PROTOCOL_ERROR,     // Reserved bits, unknown opcode, bad control frame or continuation
+        MESSAGE_TOO_BIG     // Frame or reassembled message exceeds max_message_size
+    };
+
+    // opcode is TEXT or BINARY for data messages (never CONTINUATION), or a control opcode
+    using FrameCallback = std::function<void(uint8_t opcode, std::string_view payload)>;
+
+    explicit WebSocketFrameDecoder(size_t initial_capacity = 64 * 1024, size_t max_message_size = 16 * 1024 * 1024)
+        : buffer_(initial_capacity), max_message_size_(max_message_size) {}
+
+    void set_frame_callback(FrameCallback callback) { callback_ = std::move(callback); }
+
+    // Writable space of at least min_size bytes at the end of the buffered data
+    std::pair<char*, size_t> prepare(size_t min_size = 4096) {
+        min_size = std::max(min_size, needed_);
+        if (buffer_.size() - end_ < min_size) {
+            compact();
+            if (buffer_.size() - end_ < min_size) {
+                buffer_.resize(std::max(buffer_.size() * 2, end_ + min_size));
+            }
+        }
+        return {buffer_.data() + end_, buffer_.size() - end_};
+    }
+
+    // Marks bytes written into the prepare()d space as received
+    void commit(size_t length) { end_ += length; }
+
+    // Copies data in and processes it; for callers that do not own the read buffer
+    Status feed(const void* data, size_t length) {
+        auto space = prepare(length);
+        std::memcpy(space.first, data, length);
+        commit(length);
+        return process();
+    }
+
+    // Received bytes not yet consumed as frames (e.g. an HTTP upgrade response)
+    std::string_view buffered() const { return std::string_view(buffer_.data() + begin_, end_ - begin_); }
+
+    // Drops length bytes from the front of buffered()
+    void consume(size_t length) {
+        begin_ += std::min(length, end_ - begin_);
+        if (begin_ == end_) {
+            begin_ = end_ = 0;
+        }
+    }
+
+    // Delivers every complete frame in the buffer
+    Status process() {
+        while (end_ - begin_ >= 2) {
+            uint8_t* frame = reinterpret_cast<uint8_t*>(buffer_.data() + begin_);
+            const size_t available = end_ - begin_;
+
+            const bool fin = (frame[0] & 0x80) != 0;
+            const uint8_t opcode = frame[0] & 0x0F;
+            const bool masked = (frame[1] & 0x80) != 0;
+            uint64_t length = frame[1] & 0x7F;
+            size_t header = 2;
+
+            // No extensions are negotiated, so reserved bits must be clear
+            if (frame[0] & 0x70) {
+                return Status::PROTOCOL_ERROR;
+            }
+            if (opcode >= 0x8) {
+                if (!fin || length > 125 ||
+                    (opcode != WebSocketFrame::OPCODE_CLOSE && opcode != WebSocketFrame::OPCODE_PING && opcode != WebSocketFrame::OPCODE_PONG)) {
+                    return Status::PROTOCOL_ERROR;
+                }
+            } else if (opcode > WebSocketFrame::OPCODE_BINARY) {
+                return Status::PROTOCOL_ERROR;
+            }
+
+            if (length == 126) {
+                if (available < 4) break;
+                length = (static_cast<uint64_t>(frame[2]) << 8) | frame[3];
+                header = 4;
+            } else if (length == 127) {
+                if (available < 10) break;
+                length = 0;
+                for (int i = 0; i < 8; ++i) {
+                    length = (length << 8) | frame[2 + i];
+                }
+                header = 10;
+            }
+            if (length > max_message_size_) {
+                return Status::MESSAGE_TOO_BIG;
+            }
+            const size_t key_offset = header;
+            if (masked) {
+                header += 4;
+            }
+            if (available < header + length) {
+                // Make the next prepare() leave room for the whole frame
+                needed_ = header + static_cast<size_t>(length) - available;
+                break;
+            }
+            needed_ = 0;
+
+            uint8_t* payload = frame + header;
+            if (masked) {
+                mask_payload(payload, static_cast<size_t>(length), frame + key_offset);
+            }
+            Status status = dispatch(fin, opcode, std::string_view(reinterpret_cast<const char*>(payload),
+                                                                 static_cast<size_t>(length)));
+            begin_ += header + static_cast<size_t>(length);
+            if (status != Status::OK) {
+                return status;
+            }
+        }
+        if (begin_ == end_) {
+            begin_ = end_ = 0;
+        }
+        return Status::OK;
+    }
+
+    // Drops buffered data and any partial message; capacity is kept
+    void reset() {
+        begin_ = end_ = needed_ = 0;
+        in_message_ = false;
+        message_.clear();
+    }
+
+    size_t capacity() const { return buffer_.size(); }
+
+private:
+    Status dispatch(bool fin, uint8_t opcode, std::string_view payload) {
+        if (opcode >= 0x8) {
+            deliver(opcode, payload);
+            return Status::OK;
+        }
+        if (opcode != WebSocketFrame::OPCODE_CONTINUATION) {
+            if (in_message_) {
+                return Status::PROTOCOL_ERROR;   // New message before the last one finished
+            }
+            if (fin) {
+                deliver(opcode, payload);
+                return Status::OK;
+            }
+            in_message_ = true;
+            message_opcode_ = opcode;
+            message_.assign(payload.data(), payload.size());
+            return Status::OK;
+        }
+        if (!in_message_) {
+            return Status::PROTOCOL_ERROR;
+        }
+        if (message_.size() + payload.size() > max_message_size_) {
+            return Status::MESSAGE_TOO_BIG;
+        }
+        message_.append(payload.data(), payload.size());
+        if (fin) {
+            in_message_ = false;
+            deliver(message_opcode_, message_);
+            message_.clear();
+        }
+        return Status::OK;
+    }
+
+    void deliver(uint8_t opcode, std::string_view payload) {
+        if (callback_) {
+            callback_(opcode, payload);
+        }
+    }
+
+    void compact() {
+        if (begin_ == 0) {
+            return;
+        }
+        std::memmove(buffer_.data(), buffer_.data() + begin_, end_ - begin_);
+        end_ -= begin_;
+        begin_ = 0;
+    }
+
+    std::vector<char> buffer_;
+    size_t begin_{0};
+    size_t end_{0};
+    size_t needed_{0};      // Bytes still missing from the frame at begin_
+    size_t max_message_size_;
+
+    std::string message_;   // Fragment reassembly
+    uint8_t message_opcode_{0};
+    bool in_message_{false};
+
+    FrameCallback callback_;
+};
+
+} // namespace websocket_codec
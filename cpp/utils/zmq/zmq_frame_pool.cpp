@@ -0,0 +1,83 @@
+#include "zmq_frame_pool.hpp"
+#include <new>
+#include <stdexcept>
+
+namespace {
+constexpr size_t kCacheLine = 64;
+
+size_t round_up_to_cache_line(size_t size) {
+  return (size + kCacheLine - 1) & ~(kCacheLine - 1);
+}
+}
+
+void ZmqFrame::release() {
+  if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    pool_->recycle(this);
+  }
+}
+
+void ZmqFrame::zmq_release(void* /*data*/, void* hint) {
+  static_cast<ZmqFrame*>(hint)->release();
+}
+
+ZmqFramePool::ZmqFramePool(size_t frame_count, size_t frame_size)
+  : frame_count_(frame_count), frame_size_(round_up_to_cache_line(frame_size)) {
+  if (frame_count_ == 0 || frame_count_ >= kNil || frame_size_ == 0) {
+    throw std::invalid_argument("ZmqFramePool requires a non-zero frame count and size");
+  }
+
+  storage_ = static_cast<char*>(::operator new(frame_count_ * frame_size_, std::align_val_t(kCacheLine)));
+  frames_.reset(new ZmqFrame[frame_count_]);
+
+  // Thread every frame onto the free list in index order
+  for (size_t i = 0; i < frame_count_; ++i) {
+    ZmqFrame& frame = frames_[i];
+    frame.pool_ = this;
+    frame.data_ = storage_ + i * frame_size_;
+    frame.capacity_ = frame_size_;
+    frame.index_ = static_cast<uint32_t>(i);
+    frame.next_free_.store(i + 1 < frame_count_ ? static_cast<uint32_t>(i + 1) : kNil,
+                           std::memory_order_relaxed);
+  }
+  free_head_.store(pack(0, 0), std::memory_order_release);
+  available_.store(frame_count_, std::memory_order_relaxed);
+}
+
+ZmqFramePool::~ZmqFramePool() {
+  frames_.reset();
+  ::operator delete(storage_, std::align_val_t(kCacheLine));
+}
+
+ZmqFrame* ZmqFramePool::acquire() {
+  uint64_t head = free_head_.load(std::memory_order_acquire);
+  for (;;) {
+    uint32_t index = static_cast<uint32_t>(head);
+    if (index == kNil) {
+      exhausted_.fetch_add(1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    uint32_t next = frames_[index].next_free_.load(std::memory_order_relaxed);
+    uint64_t new_head = pack(static_cast<uint32_t>(head >> 32) + 1, next);
+    if (free_head_.compare_exchange_weak(head, new_head, std::memory_order_acq_rel,
+                                         std::memory_order_acquire)) {
+      ZmqFrame* frame = &frames_[index];
+      frame->size_ = 0;
+      frame->refs_.store(1, std::memory_order_relaxed);
+      available_.fetch_sub(1, std::memory_order_relaxed);
+      return frame;
+    }
+  }
+}
+
+void ZmqFramePool::recycle(ZmqFrame* frame) {
+  uint64_t head = free_head_.load(std::memory_order_acquire);
+  for (;;) {
+    frame->next_free_.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+    uint64_t new_head = pack(static_cast<uint32_t>(head >> 32) + 1, frame->index_);
+    if (free_head_.compare_exchange_weak(head, new_head, std::memory_order_acq_rel,
+                                         std::memory_order_acquire)) {
+      available_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+  }
+}
@@ -0,0 +1,110 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+class ZmqFramePool;
+
+/**
+ * Pooled, reference-counted payload buffer for zero-copy ZMQ sends
+ *
+ * A frame is handed to zmq_msg_init_data() together with a release
+ * callback; ZMQ drops its reference once the message has been written to
+ * every subscriber pipe, and the frame returns to its pool when the last
+ * reference goes away.
+ *
+ * @note Frames are never allocated individually; they are owned by a
+ *       ZmqFramePool and must not outlive it.
+ */
+class ZmqFrame {
+public:
+  char* data() { return data_; }
+  const char* data() const { return data_; }
+  size_t capacity() const { return capacity_; }
+
+  size_t size() const { return size_; }
+  void set_size(size_t size) { size_ = size; }
+
+  /**
+   * Take an additional reference (e.g. to send the same frame on several sockets)
+   */
+  void add_ref() { refs_.fetch_add(1, std::memory_order_relaxed); }
+
+  /**
+   * Drop a reference; the frame is recycled into its pool on the last one
+   *
+   * @note Safe to call from the ZMQ I/O thread.
+   */
+  void release();
+
+  /**
+   * zmq_free_fn compatible release hook (hint is the ZmqFrame*)
+   */
+  static void zmq_release(void* data, void* hint);
+
+private:
+  friend class ZmqFramePool;
+  ZmqFrame() = default;
+
+  ZmqFramePool* pool_{nullptr};
+  char* data_{nullptr};
+  size_t capacity_{0};
+  size_t size_{0};
+  uint32_t index_{0};
+  std::atomic<uint32_t> refs_{0};
+  std::atomic<uint32_t> next_free_{0};
+};
+
+/**
+ * Fixed-capacity pool of ZmqFrame buffers
+ *
+ * All buffers are carved out of a single cache-line aligned allocation made
+ * at construction. acquire() and recycling are lock-free (tagged Treiber
+ * stack) so frames can be taken on the publishing thread and returned from
+ * the ZMQ I/O thread without contention.
+ */
+class ZmqFramePool {
+public:
+  /**
+   * @param frame_count Number of preallocated frames
+   * @param frame_size Capacity of each frame in bytes
+   */
+  ZmqFramePool(size_t frame_count, size_t frame_size);
+  ~ZmqFramePool();
+
+  // Non-copyable
+  ZmqFramePool(const ZmqFramePool&) = delete;
+  ZmqFramePool& operator=(const ZmqFramePool&) = delete;
+
+  /**
+   * Take a frame from the pool holding a single reference
+   *
+   * @return Frame with size() == 0, or nullptr if the pool is exhausted
+   */
+  ZmqFrame* acquire();
+
+  size_t frame_size() const { return frame_size_; }
+  size_t frame_count() const { return frame_count_; }
+  size_t available() const { return available_.load(std::memory_order_relaxed); }
+
+  // Statistics
+  uint64_t get_exhausted_count() const { return exhausted_.load(std::memory_order_relaxed); }
+
+private:
+  friend class ZmqFrame;
+  void recycle(ZmqFrame* frame);
+
+  static constexpr uint32_t kNil = 0xFFFFFFFFu;
+  static uint64_t pack(uint32_t tag, uint32_t index) { return (static_cast<uint64_t>(tag) << 32) | index; }
+
+  size_t frame_count_;
+  size_t frame_size_;
+  std::unique_ptr<ZmqFrame[]> frames_;
+  char* storage_{nullptr};
+
+  // Free list head: (ABA tag << 32) | frame index
+  alignas(64) std::atomic<uint64_t> free_head_{0};
+  std::atomic<size_t> available_{0};
+  std::atomic<uint64_t> exhausted_{0};
+};
@@ -1,16 +1,21 @@
 #include "zmq_publisher.hpp"
 #include "../logging/log_helper.hpp"
+#include "../app_service/thread_placement.hpp"
 #include <cstring>
 #include <cerrno>
 
-ZmqPublisher::ZmqPublisher(const std::string& bind_endpoint, int hwm, bool conflate)
+ZmqPublisher::ZmqPublisher(const std::string& bind_endpoint, int hwm, bool conflate,
+                           size_t frame_pool_size, size_t frame_size)
   : ctx_(nullptr), pub_(nullptr), endpoint_(bind_endpoint), hwm_(hwm), bound_(false),
-    conflate_(conflate), messages_sent_(0), messages_dropped_(0) {
+    conflate_(conflate), frame_size_(frame_size),
+    frame_pool_(frame_pool_size > 0 ? std::make_unique<ZmqFramePool>(frame_pool_size, frame_size) : nullptr),
+    messages_sent_(0), messages_dropped_(0) {
   // Create ZMQ context first
   ctx_ = zmq_ctx_new();
   if (!ctx_) {
     throw std::runtime_error("Failed to create ZMQ context");
   }
+  app_service::ThreadPlacement::instance().configure_zmq_context(ctx_);
   
   // Create socket with proper error handling
   try {
@@ -124,6 +129,66 @@ bool ZmqPublisher::send(const std::string& topic, const void* data, size_t size,
   return ok;
 }
 
+const std::string& ZmqPublisher::cached_topic(const std::string& topic) {
+  // Node-based set: element addresses stay valid across rehashes, so the
+  // topic bytes can back constant zmq_msg_init_data() frames
+  return *topic_cache_.insert(topic).first;
+}
+
+bool ZmqPublisher::send_frame(const std::string& topic, ZmqFrame* frame, int flags) {
+  if (!frame) return false;
+  if (!pub_ || !bound_) {
+    frame->release();
+    return false;
+  }
+
+  const std::string& cached = cached_topic(topic);
+  zmq_msg_t msg_topic;
+  zmq_msg_init_data(&msg_topic, const_cast<char*>(cached.data()), cached.size(), nullptr, nullptr);
+
+  if (zmq_msg_send(&msg_topic, pub_, ZMQ_SNDMORE) == -1) {
+    int err = zmq_errno();
+    zmq_msg_close(&msg_topic);
+    frame->release();
+    if (err == EAGAIN) {
+      messages_dropped_.fetch_add(1);
+      LOG_WARN_COMP("ZmqPublisher", "Send buffer full - topic frame dropped for topic: " + topic);
+    }
+    return false;
+  }
+  zmq_msg_close(&msg_topic);
+
+  // Payload frame borrows the pooled buffer; ZMQ calls ZmqFrame::zmq_release
+  // once it no longer needs the bytes
+  zmq_msg_t msg_payload;
+  if (zmq_msg_init_data(&msg_payload, frame->data(), frame->size(), &ZmqFrame::zmq_release, frame) != 0) {
+    frame->release();
+    messages_dropped_.fetch_add(1);
+    return false;
+  }
+
+  int rc = zmq_msg_send(&msg_payload, pub_, flags);
+  bool ok = (rc != -1);
+
+  if (ok) {
+    messages_sent_.fetch_add(1);
+  } else {
+    int err = zmq_errno();
+    if (err == EAGAIN) {
+      messages_dropped_.fetch_add(1);
+      LOG_WARN_COMP("ZmqPublisher", "Send buffer full - message dropped for topic: " + topic +
+                    " size: " + std::to_string(frame->size()) + " bytes");
+    } else {
+      LOG_ERROR_COMP("ZmqPublisher", "Failed to send message: " + std::string(zmq_strerror(err)));
+    }
+  }
+
+  // On success ZMQ has taken over the message; on failure closing it invokes
+  // the release callback. Either way the caller's reference is consumed.
+  zmq_msg_close(&msg_payload);
+  return ok;
+}
+
 bool ZmqPublisher::send_string(const std::string& topic, const std::string& payload, int flags) {
   LOG_DEBUG_COMP("ZmqPublisher", "Publishing to topic: " + topic + " payload size: " + std::to_string(payload.size()) + " bytes");
   bool result = send(topic, payload.data(), payload.size(), flags);
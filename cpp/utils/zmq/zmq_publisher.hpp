@@ -2,7 +2,9 @@
 #include <string>
 #include <memory>
 #include <atomic>
+#include <unordered_set>
 #include <zmq.h>
+#include "zmq_frame_pool.hpp"
 
 /**
  * ZeroMQ Publisher for high-performance message publishing
@@ -12,6 +14,8 @@
  * - Non-blocking sends (drops messages if buffer full)
  * - Message conflation (keeps only latest message per topic)
  * - High water mark configuration
+ * - Zero-copy sends from a pool of preallocated, reference-counted frames
+ *   (opt-in: only high-rate publishers such as market data size a pool)
  * 
  * @note Default behavior is non-blocking to prevent publisher stalling.
  *       Messages are dropped if send buffer is full (ZMQ_DONTWAIT).
@@ -24,10 +28,19 @@ public:
    * @param bind_endpoint ZMQ endpoint to bind to (e.g., "tcp://127.0.0.1:5555")
    * @param hwm High water mark (maximum queued messages)
    * @param conflate If true, keep only latest message per topic (for state updates)
+   * @param frame_pool_size Number of preallocated frames for zero-copy sends;
+   *                        0 (default) allocates none and sends by copy
+   * @param frame_size Capacity in bytes of each pooled frame
    * 
    * @throws std::runtime_error if ZMQ context or socket creation fails
    */
-  ZmqPublisher(const std::string& bind_endpoint, int hwm = 1000, bool conflate = false);
+  ZmqPublisher(const std::string& bind_endpoint, int hwm = 1000, bool conflate = false,
+               size_t frame_pool_size = 0, size_t frame_size = DEFAULT_FRAME_SIZE);
+
+  // Pool for the market data publisher (2048 x 4 KB = 8 MB); control-plane publishers use none
+  static constexpr size_t MARKET_DATA_FRAME_POOL_SIZE = 2048;
+  static constexpr size_t DEFAULT_FRAME_SIZE = 4096;
+  static constexpr size_t WRITE_FAILED = static_cast<size_t>(-1);
   
   /**
    * Destructor - properly cleans up ZMQ resources
@@ -86,10 +99,94 @@ public:
   bool publish(const std::string& topic, const std::string& payload) { 
     return send_string(topic, payload, ZMQ_DONTWAIT); 
   }
+
+  /**
+   * Take an empty frame from the publisher's pool
+   * 
+   * @return Frame holding one reference, or nullptr if the pool is exhausted
+   *         or the publisher has no pool
+   */
+  ZmqFrame* acquire_frame() { return frame_pool_ ? frame_pool_->acquire() : nullptr; }
+
+  /**
+   * Send a pooled frame without copying it
+   * 
+   * @param topic Message topic (topic frame is built once and cached)
+   * @param frame Frame from acquire_frame() with size() set; ownership of the
+   *              caller's reference passes to ZMQ whether or not the send succeeds
+   * @param flags ZMQ send flags (default: ZMQ_DONTWAIT for non-blocking)
+   * @return true if message was sent, false if dropped or error occurred
+   */
+  bool send_frame(const std::string& topic, ZmqFrame* frame, int flags = ZMQ_DONTWAIT);
+
+  /**
+   * Serialize straight into a pooled frame and send it without copying
+   * 
+   * @param topic Message topic
+   * @param writer Callable size_t(char* buffer, size_t capacity) returning the
+   *               number of bytes written, or WRITE_FAILED if the payload does not fit
+   * @param flags ZMQ send flags (default: ZMQ_DONTWAIT for non-blocking)
+   * @return true if message was sent, false if dropped or error occurred
+   * 
+   * @note Falls back to a dropped message (counted) if the pool is exhausted
+   *       or the writer reports the payload does not fit. Without a pool the
+   *       writer fills a temporary buffer of frame_size bytes that is copied.
+   */
+  template <typename Writer>
+  bool send_serialized(const std::string& topic, Writer&& writer, int flags = ZMQ_DONTWAIT) {
+    if (!frame_pool_) {
+      std::string buffer(frame_size_, '\0');
+      size_t written = writer(buffer.data(), buffer.size());
+      if (written > buffer.size()) {
+        messages_dropped_.fetch_add(1);
+        return false;
+      }
+      return send(topic, buffer.data(), written, flags);
+    }
+    ZmqFrame* frame = frame_pool_->acquire();
+    if (!frame) {
+      messages_dropped_.fetch_add(1);
+      return false;
+    }
+    size_t written = writer(frame->data(), frame->capacity());
+    if (written > frame->capacity()) {
+      frame->release();
+      messages_dropped_.fetch_add(1);
+      return false;
+    }
+    frame->set_size(written);
+    return send_frame(topic, frame, flags);
+  }
+
+  /**
+   * Serialize a protobuf message straight into a pooled frame and send it
+   * 
+   * @param topic Message topic
+   * @param message Any protobuf message (ByteSizeLong/SerializeWithCachedSizesToArray)
+   * @param flags ZMQ send flags (default: ZMQ_DONTWAIT for non-blocking)
+   * @return true if message was sent, false if dropped or error occurred
+   * 
+   * @note Messages larger than the frame size, and every message of a
+   *       publisher without a pool, use the copying send() path.
+   */
+  template <typename Message>
+  bool send_message(const std::string& topic, const Message& message, int flags = ZMQ_DONTWAIT) {
+    const size_t size = message.ByteSizeLong();
+    if (!frame_pool_ || size > frame_pool_->frame_size()) {
+      std::string payload = message.SerializeAsString();
+      return send(topic, payload.data(), payload.size(), flags);
+    }
+    return send_serialized(topic, [&message, size](char* buffer, size_t) {
+      message.SerializeWithCachedSizesToArray(reinterpret_cast<uint8_t*>(buffer));
+      return size;
+    }, flags);
+  }
   
   // Statistics
   uint64_t get_messages_sent() const { return messages_sent_.load(); }
   uint64_t get_messages_dropped() const { return messages_dropped_.load(); }
+  uint64_t get_frame_pool_exhausted() const { return frame_pool_ ? frame_pool_->get_exhausted_count() : 0; }
+  size_t get_frames_available() const { return frame_pool_ ? frame_pool_->available() : 0; }
   
   // Check if send buffer is approaching full (for monitoring)
   bool is_buffer_available() const;
@@ -102,6 +199,15 @@ private:
   bool bound_;
   bool conflate_;
   
+  // Zero-copy payload frames (null without a pool) and interned topic frames.
+  // Both outlive the context: the destructor body terminates it, which waits
+  // for ZMQ to release every in-flight frame before members are destroyed.
+  size_t frame_size_;
+  std::unique_ptr<ZmqFramePool> frame_pool_;
+  std::unordered_set<std::string> topic_cache_;
+  
+  const std::string& cached_topic(const std::string& topic);
+  
   // Statistics tracking
   std::atomic<uint64_t> messages_sent_{0};
   std::atomic<uint64_t> messages_dropped_{0};
@@ -0,0 +1,107 @@
+#include "zmq_reactor.hpp"
+#include "../logging/log_helper.hpp"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+ZmqReactor::ZmqReactor() {
+  wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (wake_fd_ < 0) {
+    throw std::runtime_error(std::string("Failed to create reactor eventfd: ") + std::strerror(errno));
+  }
+  zmq_pollitem_t wake_item{};
+  wake_item.socket = nullptr;
+  wake_item.fd = wake_fd_;
+  wake_item.events = ZMQ_POLLIN;
+  items_.push_back(wake_item);
+}
+
+ZmqReactor::~ZmqReactor() {
+  if (wake_fd_ >= 0) {
+    close(wake_fd_);
+    wake_fd_ = -1;
+  }
+}
+
+bool ZmqReactor::add_socket(void* socket, Handler handler) {
+  if (running_.load(std::memory_order_acquire) || !socket || !handler) {
+    LOG_ERROR_COMP("ZmqReactor", "Cannot register socket (null, no handler, or loop already running)");
+    return false;
+  }
+  zmq_pollitem_t item{};
+  item.socket = socket;
+  item.events = ZMQ_POLLIN;
+  items_.push_back(item);
+  handlers_.push_back(std::move(handler));
+  return true;
+}
+
+bool ZmqReactor::add_fd(int fd, Handler handler) {
+  if (running_.load(std::memory_order_acquire) || fd < 0 || !handler) {
+    LOG_ERROR_COMP("ZmqReactor", "Cannot register fd (invalid, no handler, or loop already running)");
+    return false;
+  }
+  zmq_pollitem_t item{};
+  item.socket = nullptr;
+  item.fd = fd;
+  item.events = ZMQ_POLLIN;
+  items_.push_back(item);
+  handlers_.push_back(std::move(handler));
+  return true;
+}
+
+void ZmqReactor::run() {
+  running_.store(true, std::memory_order_release);
+  LOG_INFO_COMP("ZmqReactor", "Event loop started with " + std::to_string(handlers_.size()) + " sources");
+  while (!stop_requested_.load(std::memory_order_acquire)) {
+    if (poll_once(-1) < 0) {
+      break;
+    }
+  }
+  running_.store(false, std::memory_order_release);
+  LOG_INFO_COMP("ZmqReactor", "Event loop stopped");
+}
+
+int ZmqReactor::poll_once(long timeout_ms) {
+  int ready = zmq_poll(items_.data(), static_cast<int>(items_.size()), timeout_ms);
+  if (ready < 0) {
+    if (zmq_errno() == EINTR) {
+      return 0;
+    }
+    LOG_ERROR_COMP("ZmqReactor", std::string("zmq_poll failed: ") + zmq_strerror(zmq_errno()));
+    return -1;
+  }
+
+  if (items_[0].revents & ZMQ_POLLIN) {
+    drain_wake_fd();
+  }
+  int dispatched = 0;
+  for (size_t i = 1; i < items_.size(); ++i) {
+    if (items_[i].revents & ZMQ_POLLIN) {
+      handlers_[i - 1]();
+      ++dispatched;
+    }
+  }
+  dispatches_.fetch_add(static_cast<uint64_t>(dispatched), std::memory_order_relaxed);
+  return dispatched;
+}
+
+void ZmqReactor::stop() {
+  stop_requested_.store(true, std::memory_order_release);
+  wake();
+}
+
+void ZmqReactor::wake() {
+  uint64_t one = 1;
+  ssize_t written = write(wake_fd_, &one, sizeof(one));
+  (void)written;   // EAGAIN only when the counter is saturated, i.e. a wake-up is already pending
+}
+
+void ZmqReactor::drain_wake_fd() {
+  uint64_t count = 0;
+  if (read(wake_fd_, &count, sizeof(count)) == static_cast<ssize_t>(sizeof(count))) {
+    wakeups_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include <zmq.h>
+
+/**
+ * Single-threaded zmq_poll event loop
+ *
+ * Multiplexes any number of ZMQ sockets and plain file descriptors on one
+ * thread: run() blocks in zmq_poll until something is readable and calls
+ * that source's handler at once, so events are dispatched with no polling
+ * interval and no thread per source. An eventfd registered alongside the
+ * sources lets other threads wake the loop (stop(), wake()).
+ *
+ * Handlers run on the loop thread and must not block; they should drain
+ * their source with non-blocking receives (see ZmqSubscriber::receive_into
+ * with timeout 0), reading at most a burst per call so one busy source
+ * cannot starve the others.
+ *
+ * @note Register every source before run(); sockets are then used only
+ *       from the loop thread.
+ */
+class ZmqReactor {
+ public:
+  using Handler = std::function<void()>;
+
+  // @throws std::runtime_error if the wake-up eventfd cannot be created
+  ZmqReactor();
+  ~ZmqReactor();
+
+  // Non-copyable
+  ZmqReactor(const ZmqReactor&) = delete;
+  ZmqReactor& operator=(const ZmqReactor&) = delete;
+
+  // Registration; false once the loop is running
+  bool add_socket(void* socket, Handler handler);
+  bool add_fd(int fd, Handler handler);
+
+  // Dispatch until stop(); returns at once if stop() came first
+  void run();
+
+  /**
+   * One zmq_poll round
+   *
+   * @param timeout_ms -1 blocks until a source is readable or wake() is called
+   * @return Number of handlers called
+   */
+  int poll_once(long timeout_ms);
+
+  // Thread-safe: make run() return for good / interrupt a blocked poll_once()
+  void stop();
+  void wake();
+
+  bool is_running() const { return running_.load(std::memory_order_acquire); }
+  size_t source_count() const { return handlers_.size(); }
+
+  // Statistics
+  uint64_t get_dispatch_count() const { return dispatches_.load(std::memory_order_relaxed); }
+  uint64_t get_wakeup_count() const { return wakeups_.load(std::memory_order_relaxed); }
+
+ private:
+  void drain_wake_fd();
+
+  int wake_fd_{-1};
+  std::vector<zmq_pollitem_t> items_;   // items_[0] is the wake-up eventfd
+  std::vector<Handler> handlers_;       // handlers_[i] serves items_[i + 1]
+  std::atomic<bool> running_{false};
+  std::atomic<bool> stop_requested_{false};
+  std::atomic<uint64_t> dispatches_{0};
+  std::atomic<uint64_t> wakeups_{0};
+};
@@ -1,11 +1,13 @@
 #include "zmq_subscriber.hpp"
 #include "../logging/log_helper.hpp"
+#include "../app_service/thread_placement.hpp"
 #include <zmq.h>
 #include <cstring>
 
 ZmqSubscriber::ZmqSubscriber(const std::string& endpoint, const std::string& topic)
     : topic_(topic) {
   ctx_ = zmq_ctx_new();
+  app_service::ThreadPlacement::instance().configure_zmq_context(ctx_);
   sub_ = zmq_socket(ctx_, ZMQ_SUB);
   zmq_setsockopt(sub_, ZMQ_SUBSCRIBE, topic_.data(), topic_.size());
   if (zmq_connect(sub_, endpoint.c_str()) != 0) {
@@ -50,6 +52,7 @@ std::optional<std::string> ZmqSubscriber::receive() {
 std::optional<std::string> ZmqSubscriber::receive_blocking(int timeout_ms) {
   // Set receive timeout
   zmq_setsockopt(sub_, ZMQ_RCVTIMEO, &timeout_ms, sizeof(timeout_ms));
+  rcv_timeout_ms_ = timeout_ms;
   
   zmq_msg_t topic;
   zmq_msg_init(&topic);
@@ -74,4 +77,57 @@ std::optional<std::string> ZmqSubscriber::receive_blocking(int timeout_ms) {
   return payload;
 }
 
+bool ZmqSubscriber::receive_into(void* buffer, size_t capacity, size_t& size, int timeout_ms) {
+  if (timeout_ms != rcv_timeout_ms_) {
+    zmq_setsockopt(sub_, ZMQ_RCVTIMEO, &timeout_ms, sizeof(timeout_ms));
+    rcv_timeout_ms_ = timeout_ms;
+  }
+
+  zmq_msg_t topic;
+  zmq_msg_init(&topic);
+  if (zmq_msg_recv(&topic, sub_, 0) == -1) {
+    zmq_msg_close(&topic);
+    return false;
+  }
+  zmq_msg_close(&topic);
+
+  int rc = zmq_recv(sub_, buffer, capacity, 0);
+  if (rc == -1) {
+    return false;
+  }
+  size = static_cast<size_t>(rc);
+  return true;
+}
+
+void ZmqSubscriber::subscribe(const std::string& topic) {
+  zmq_setsockopt(sub_, ZMQ_SUBSCRIBE, topic.data(), topic.size());
+}
+
+void ZmqSubscriber::unsubscribe(const std::string& topic) {
+  zmq_setsockopt(sub_, ZMQ_UNSUBSCRIBE, topic.data(), topic.size());
+}
 
+bool ZmqSubscriber::receive_into(std::string& payload, int timeout_ms) {
+  if (timeout_ms != rcv_timeout_ms_) {
+    zmq_setsockopt(sub_, ZMQ_RCVTIMEO, &timeout_ms, sizeof(timeout_ms));
+    rcv_timeout_ms_ = timeout_ms;
+  }
+
+  zmq_msg_t topic;
+  zmq_msg_init(&topic);
+  if (zmq_msg_recv(&topic, sub_, 0) == -1) {
+    zmq_msg_close(&topic);
+    return false;
+  }
+  zmq_msg_close(&topic);
+
+  zmq_msg_t msg;
+  zmq_msg_init(&msg);
+  if (zmq_msg_recv(&msg, sub_, 0) == -1) {
+    zmq_msg_close(&msg);
+    return false;
+  }
+  payload.assign(static_cast<const char*>(zmq_msg_data(&msg)), zmq_msg_size(&msg));
+  zmq_msg_close(&msg);
+  return true;
+}
@@ -8,10 +8,22 @@ class ZmqSubscriber {
   ~ZmqSubscriber();
   std::optional<std::string> receive();
   std::optional<std::string> receive_blocking(int timeout_ms = 1000);
+  // Receives into `payload`, reusing its capacity; false on timeout or error
+  bool receive_into(std::string& payload, int timeout_ms = 1000);
+  // Receives into a caller-owned buffer (e.g. an aligned one for in-place reads).
+  // `size` is the full message size; a message larger than capacity is
+  // truncated and reported by size > capacity.
+  bool receive_into(void* buffer, size_t capacity, size_t& size, int timeout_ms = 1000);
+  // Adds or drops a topic prefix on the same socket
+  void subscribe(const std::string& topic);
+  void unsubscribe(const std::string& topic);
+  // Raw socket for zmq_poll (ZmqReactor); receive from the polling thread only
+  void* socket_handle() const { return sub_; }
  private:
   void* ctx_{};
   void* sub_{};
   std::string topic_;
+  int rcv_timeout_ms_{-1};
 };
 
 